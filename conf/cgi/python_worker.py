@@ -0,0 +1,176 @@
+#!/usr/bin/env python3
+"""
+Persistent CGI worker bootstrap
+
+Started by webserv as `<interpreter> python_worker.py` when a location sets
+`cgi_workers`. Requests arrive on stdin as FastCGI records (BEGIN_REQUEST,
+PARAMS, STDIN) and each script runs in this interpreter with runpy, so
+imported modules stay warm between requests. As with a forked CGI process,
+the script runs from its own directory; the worker's directory is restored
+afterwards. Output goes back on stdout as
+STDOUT, STDERR and END_REQUEST records; the script's exit code is the
+application status.
+"""
+
+import io
+import os
+import runpy
+import struct
+import sys
+import traceback
+
+VERSION = 1
+BEGIN_REQUEST = 1
+ABORT_REQUEST = 2
+END_REQUEST = 3
+PARAMS = 4
+STDIN = 5
+STDOUT = 6
+STDERR = 7
+
+HEADER = struct.Struct('>BBHHBx')
+MAX_CONTENT = 65535
+
+
+def read_exact(stream, length):
+    data = b''
+    while len(data) < length:
+        chunk = stream.read(length - len(data))
+        if not chunk:
+            return None
+        data += chunk
+    return data
+
+
+def read_record(stream):
+    header = read_exact(stream, HEADER.size)
+    if header is None:
+        return None
+    version, kind, request_id, length, padding = HEADER.unpack(header)
+    if version != VERSION:
+        raise ValueError('unsupported record version %d' % version)
+    content = read_exact(stream, length + padding)
+    if content is None:
+        return None
+    return kind, request_id, content[:length]
+
+
+def write_record(stream, kind, request_id, content=b''):
+    padding = -len(content) % 8
+    stream.write(HEADER.pack(VERSION, kind, request_id, len(content), padding))
+    stream.write(content)
+    stream.write(b'\0' * padding)
+
+
+def write_stream(stream, kind, request_id, data):
+    for offset in range(0, len(data), MAX_CONTENT):
+        write_record(stream, kind, request_id, data[offset:offset + MAX_CONTENT])
+    write_record(stream, kind, request_id)
+
+
+def read_length(data, offset):
+    if data[offset] < 0x80:
+        return data[offset], offset + 1
+    value = struct.unpack('>I', data[offset:offset + 4])[0] & 0x7FFFFFFF
+    return value, offset + 4
+
+
+def parse_params(data):
+    params = {}
+    offset = 0
+    while offset < len(data):
+        name_length, offset = read_length(data, offset)
+        value_length, offset = read_length(data, offset)
+        name = data[offset:offset + name_length]
+        offset += name_length
+        value = data[offset:offset + value_length]
+        offset += value_length
+        params[name.decode('latin-1')] = value.decode('latin-1')
+    return params
+
+
+def run_script(params, body):
+    stdout = io.BytesIO()
+    stderr = io.BytesIO()
+    saved = (sys.stdin, sys.stdout, sys.stderr, sys.argv, dict(os.environ))
+    cwd = os.getcwd()
+    status = 0
+
+    # The wrappers close their buffers when collected, so keep them alive
+    # until the captured bytes have been read back.
+    text_in = io.TextIOWrapper(io.BytesIO(body), encoding='utf-8')
+    text_out = io.TextIOWrapper(stdout, encoding='utf-8', write_through=True)
+    text_err = io.TextIOWrapper(stderr, encoding='utf-8', write_through=True)
+    sys.stdin, sys.stdout, sys.stderr = text_in, text_out, text_err
+    script = params.get('SCRIPT_FILENAME', '')
+    sys.argv = [script]
+    os.environ.clear()
+    os.environ.update(params)
+
+    try:
+        os.chdir(os.path.dirname(os.path.abspath(script)))
+        runpy.run_path(script, run_name='__main__')
+    except SystemExit as exit_request:
+        code = exit_request.code
+        if isinstance(code, int):
+            status = code
+        elif code is not None:
+            sys.stderr.write('%s\n' % code)
+            status = 1
+    except BaseException:
+        traceback.print_exc()
+        status = 1
+    finally:
+        text_out.flush()
+        text_err.flush()
+        os.chdir(cwd)
+        sys.stdin, sys.stdout, sys.stderr, sys.argv, environ = saved
+        os.environ.clear()
+        os.environ.update(environ)
+
+    return stdout.getvalue(), stderr.getvalue(), status & 0xFFFFFFFF
+
+
+def serve(channel_in, channel_out):
+    pending = {}
+    while True:
+        record = read_record(channel_in)
+        if record is None:
+            return
+        kind, request_id, content = record
+
+        if kind == BEGIN_REQUEST:
+            pending[request_id] = [bytearray(), bytearray()]
+        elif kind == ABORT_REQUEST:
+            pending.pop(request_id, None)
+        elif kind == PARAMS and request_id in pending:
+            pending[request_id][0] += content
+        elif kind == STDIN and request_id in pending:
+            if content:
+                pending[request_id][1] += content
+                continue
+            params, body = pending.pop(request_id)
+            output, errors, status = run_script(parse_params(bytes(params)),
+                                                bytes(body))
+            write_stream(channel_out, STDOUT, request_id, output)
+            if errors:
+                write_stream(channel_out, STDERR, request_id, errors)
+            write_record(channel_out, END_REQUEST, request_id,
+                         struct.pack('>IB3x', status, 0))
+            channel_out.flush()
+
+
+def main():
+    # Keep the protocol channel private: anything a script writes straight to
+    # file descriptor 1 lands in /dev/null instead of corrupting the framing.
+    channel_in = os.fdopen(os.dup(0), 'rb', buffering=0)
+    channel_out = os.fdopen(os.dup(1), 'wb')
+    devnull = os.open(os.devnull, os.O_RDWR)
+    os.dup2(devnull, 0)
+    os.dup2(devnull, 1)
+    os.close(devnull)
+    serve(channel_in, channel_out)
+
+
+if __name__ == '__main__':
+    main()
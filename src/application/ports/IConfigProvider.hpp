@@ -13,6 +13,7 @@
 #ifndef ICONFIG_PROVIDER_HPP
 #define ICONFIG_PROVIDER_HPP
 
+#include "domain/configuration/entities/ConfigSnapshot.hpp"
 #include "domain/configuration/entities/HttpConfig.hpp"
 #include "domain/configuration/entities/LocationConfig.hpp"
 #include "domain/configuration/entities/ServerConfig.hpp"
@@ -31,6 +32,9 @@ class IConfigProvider {
   virtual const domain::configuration::entities::HttpConfig& getConfiguration()
       const = 0;
 
+  virtual domain::configuration::entities::ConfigSnapshot& getSnapshot()
+      const = 0;
+
   virtual const domain::configuration::entities::ServerConfig* findServer(
       const std::string& host, unsigned int port) const = 0;
 
@@ -43,6 +47,9 @@ class IConfigProvider {
   getAllServers() const = 0;
 
   virtual void reload() = 0;
+  virtual domain::configuration::entities::ConfigSnapshot* prepareReload() = 0;
+  virtual void publish(
+      domain::configuration::entities::ConfigSnapshot* snapshot) = 0;
   virtual bool isValid() const = 0;
 };
 
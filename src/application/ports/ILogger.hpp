@@ -13,10 +13,41 @@
 #ifndef ILOGGER_HPP
 #define ILOGGER_HPP
 
+#include <sstream>
 #include <string>
 
 enum LogLevel { DEBUG, INFO, WARN, ERROR };
 
+// Build the message only when the logger would keep it:
+//   WEBSERV_LOG_DEBUG(m_logger, "Read " << bytes << " bytes");
+// Building with WEBSERV_NO_DEBUG_LOG compiles debug messages out entirely;
+// they stay in a dead branch so their operands are still type-checked.
+#define WEBSERV_LOG(logger, level, method, message)   \
+  do {                                                \
+    if ((logger).isEnabled(level)) {                  \
+      std::ostringstream webservLogMessage;           \
+      webservLogMessage << message;                   \
+      (logger).method(webservLogMessage.str());       \
+    }                                                 \
+  } while (0)
+
+#ifdef WEBSERV_NO_DEBUG_LOG
+#define WEBSERV_LOG_DEBUG(logger, message)     \
+  do {                                         \
+    if (false) {                               \
+      std::ostringstream webservLogMessage;    \
+      webservLogMessage << message;            \
+      (logger).debug(webservLogMessage.str()); \
+    }                                          \
+  } while (0)
+#else
+#define WEBSERV_LOG_DEBUG(logger, message) \
+  WEBSERV_LOG(logger, DEBUG, debug, message)
+#endif
+
+#define WEBSERV_LOG_INFO(logger, message) \
+  WEBSERV_LOG(logger, INFO, info, message)
+
 namespace application {
 namespace ports {
 
@@ -29,6 +60,9 @@ class ILogger {
   virtual void warn(const std::string& msg) = 0;
   virtual void error(const std::string& msg) = 0;
 
+  virtual bool isEnabled(LogLevel level) const = 0;
+  virtual void setLevel(LogLevel level) = 0;
+
 private:
   virtual void log(LogLevel level, const std::string& msg) = 0;
 };
@@ -0,0 +1,73 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ConfigSnapshot.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 23:05:12 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 23:05:12 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "domain/configuration/entities/ConfigSnapshot.hpp"
+#include "domain/configuration/exceptions/HttpConfigException.hpp"
+
+namespace domain {
+namespace configuration {
+namespace entities {
+
+ConfigSnapshot* ConfigSnapshot::create(HttpConfig* httpConfig,
+                                       unsigned long generation) {
+  if (httpConfig == NULL) {
+    throw exceptions::HttpConfigException(
+        "Snapshot requires a loaded configuration",
+        exceptions::HttpConfigException::EMPTY_CONFIGURATION);
+  }
+  return new ConfigSnapshot(httpConfig, generation);
+}
+
+ConfigSnapshot::ConfigSnapshot(HttpConfig* httpConfig, unsigned long generation)
+    : m_httpConfig(httpConfig), m_generation(generation), m_referenceCount(1) {
+  m_httpConfig->indexServers();
+  m_httpConfig->compileRequestPlans();
+  const HttpConfig::ServerConfigs& servers = m_httpConfig->getServerConfigs();
+  m_servers.reserve(servers.size());
+  for (HttpConfig::ServerConfigs::const_iterator it = servers.begin();
+       it != servers.end(); ++it) {
+    m_servers.push_back(*it);
+  }
+}
+
+ConfigSnapshot::~ConfigSnapshot() {
+  delete m_httpConfig;
+  m_httpConfig = NULL;
+}
+
+void ConfigSnapshot::acquire() { ++m_referenceCount; }
+
+bool ConfigSnapshot::release() {
+  if (--m_referenceCount > 0) {
+    return false;
+  }
+  delete this;
+  return true;
+}
+
+const HttpConfig& ConfigSnapshot::getConfiguration() const {
+  return *m_httpConfig;
+}
+
+const ConfigSnapshot::Servers& ConfigSnapshot::getServers() const {
+  return m_servers;
+}
+
+unsigned long ConfigSnapshot::getGeneration() const { return m_generation; }
+
+std::size_t ConfigSnapshot::getReferenceCount() const {
+  return m_referenceCount;
+}
+
+}  // namespace entities
+}  // namespace configuration
+}  // namespace domain
@@ -0,0 +1,61 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ConfigSnapshot.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 23:05:12 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 23:05:12 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef CONFIG_SNAPSHOT_HPP
+#define CONFIG_SNAPSHOT_HPP
+
+#include "domain/configuration/entities/HttpConfig.hpp"
+#include "domain/configuration/entities/ServerConfig.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace domain {
+namespace configuration {
+namespace entities {
+
+// One loaded generation of the configuration. Listeners and connections hold
+// a reference for as long as they point into it, so a reload can publish a
+// new generation while in-flight requests finish on the old one. The snapshot
+// deletes itself, and the HttpConfig it owns, when the last reference goes.
+class ConfigSnapshot {
+ public:
+  typedef std::vector<const ServerConfig*> Servers;
+
+  static ConfigSnapshot* create(HttpConfig* httpConfig,
+                                unsigned long generation);
+
+  void acquire();
+  bool release();
+
+  const HttpConfig& getConfiguration() const;
+  const Servers& getServers() const;
+  unsigned long getGeneration() const;
+  std::size_t getReferenceCount() const;
+
+ private:
+  ConfigSnapshot(HttpConfig* httpConfig, unsigned long generation);
+  ~ConfigSnapshot();
+  ConfigSnapshot(const ConfigSnapshot&);
+  ConfigSnapshot& operator=(const ConfigSnapshot&);
+
+  HttpConfig* m_httpConfig;
+  Servers m_servers;
+  unsigned long m_generation;
+  std::size_t m_referenceCount;
+};
+
+}  // namespace entities
+}  // namespace configuration
+}  // namespace domain
+
+#endif  // CONFIG_SNAPSHOT_HPP
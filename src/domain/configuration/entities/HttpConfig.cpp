@@ -11,7 +11,10 @@
 /* ************************************************************************** */
 
 #include "domain/configuration/entities/HttpConfig.hpp"
+#include "domain/configuration/exceptions/CacheConfigException.hpp"
+#include "domain/configuration/exceptions/LimitConfigException.hpp"
 #include "domain/configuration/exceptions/HttpConfigException.hpp"
+#include "domain/configuration/exceptions/UpstreamConfigException.hpp"
 #include "domain/shared/utils/StringUtils.hpp"
 
 #include <fstream>
@@ -25,23 +28,36 @@ namespace entities {
 const std::string HttpConfig::DEFAULT_MIME_TYPES_PATH = "/etc/mime.types";
 const std::string HttpConfig::DEFAULT_ERROR_LOG_PATH =
     "/var/log/webserv_error.log";
+const std::string HttpConfig::DEFAULT_ERROR_LOG_LEVEL = "debug";
 const std::string HttpConfig::DEFAULT_ACCESS_LOG_PATH =
     "/var/log/webserv_access.log";
+const std::string HttpConfig::DEFAULT_LOG_FORMAT_NAME = "combined";
+const std::string HttpConfig::COMBINED_LOG_FORMAT =
+    "$remote_addr - - [$time_local] \"$request\" $status $body_bytes_sent "
+    "\"$http_referer\" \"$http_user_agent\"";
 
 HttpConfig::HttpConfig()
     : m_workerProcesses(DEFAULT_WORKER_PROCESSES),
       m_workerConnections(DEFAULT_WORKER_CONNECTIONS),
       m_keepaliveTimeout(DEFAULT_KEEPALIVE_TIMEOUT),
       m_sendTimeout(DEFAULT_SEND_TIMEOUT),
+      m_keepaliveRequests(DEFAULT_KEEPALIVE_REQUESTS),
+      m_clientHeaderTimeout(DEFAULT_CLIENT_HEADER_TIMEOUT),
+      m_clientBodyTimeout(DEFAULT_CLIENT_BODY_TIMEOUT),
+      m_tcpNoDelay(true),
+      m_tcpNoPush(false),
       m_errorLogPath(filesystem::value_objects::Path::fromString(
           DEFAULT_ERROR_LOG_PATH, true)),
+      m_errorLogLevel(DEFAULT_ERROR_LOG_LEVEL),
       m_accessLogPath(filesystem::value_objects::Path::fromString(
           DEFAULT_ACCESS_LOG_PATH, true)),
+      m_accessLogEnabled(false),
+      m_accessLogFormat(DEFAULT_LOG_FORMAT_NAME),
+      m_slowRequestThreshold(DEFAULT_SLOW_REQUEST_THRESHOLD_MS),
       m_mimeTypesPath(filesystem::value_objects::Path::fromString(
           DEFAULT_MIME_TYPES_PATH, true)),
       m_clientMaxBodySize(filesystem::value_objects::Size::fromMegabytes(
-          MAX_CLIENT_BODY_SIZE_GB)),
-      m_mimeTypesLoaded(false) {}
+          MAX_CLIENT_BODY_SIZE_GB)) {}
 
 HttpConfig::HttpConfig(const std::string& configFilePath) {
   initializeDefaults();
@@ -65,13 +81,26 @@ void HttpConfig::copyFrom(const HttpConfig& other) {
   m_workerConnections = other.m_workerConnections;
   m_keepaliveTimeout = other.m_keepaliveTimeout;
   m_sendTimeout = other.m_sendTimeout;
+  m_keepaliveRequests = other.m_keepaliveRequests;
+  m_clientHeaderTimeout = other.m_clientHeaderTimeout;
+  m_clientBodyTimeout = other.m_clientBodyTimeout;
+  m_tcpNoDelay = other.m_tcpNoDelay;
+  m_tcpNoPush = other.m_tcpNoPush;
   m_errorLogPath = other.m_errorLogPath;
+  m_errorLogLevel = other.m_errorLogLevel;
   m_accessLogPath = other.m_accessLogPath;
+  m_accessLogEnabled = other.m_accessLogEnabled;
+  m_accessLogFormat = other.m_accessLogFormat;
+  m_logFormats = other.m_logFormats;
+  m_slowRequestThreshold = other.m_slowRequestThreshold;
   m_mimeTypesPath = other.m_mimeTypesPath;
   m_clientMaxBodySize = other.m_clientMaxBodySize;
   m_mimeTypes = other.m_mimeTypes;
-  m_mimeTypesLoaded = other.m_mimeTypesLoaded;
   m_errorPages = other.m_errorPages;
+  m_sourceFiles = other.m_sourceFiles;
+  m_upstreams = other.m_upstreams;
+  m_cacheZones = other.m_cacheZones;
+  m_limitZones = other.m_limitZones;
 
   for (ServerConfigs::const_iterator it = other.m_serverConfigs.begin();
        it != other.m_serverConfigs.end(); ++it) {
@@ -82,6 +111,7 @@ void HttpConfig::copyFrom(const HttpConfig& other) {
 }
 
 void HttpConfig::clearServerConfigs() {
+  m_serverSelector.clear();
   for (ServerConfigs::iterator it = m_serverConfigs.begin();
        it != m_serverConfigs.end(); ++it) {
     delete *it;
@@ -94,15 +124,25 @@ void HttpConfig::initializeDefaults() {
   m_workerConnections = DEFAULT_WORKER_CONNECTIONS;
   m_keepaliveTimeout = DEFAULT_KEEPALIVE_TIMEOUT;
   m_sendTimeout = DEFAULT_SEND_TIMEOUT;
+  m_keepaliveRequests = DEFAULT_KEEPALIVE_REQUESTS;
+  m_clientHeaderTimeout = DEFAULT_CLIENT_HEADER_TIMEOUT;
+  m_clientBodyTimeout = DEFAULT_CLIENT_BODY_TIMEOUT;
+  m_tcpNoDelay = true;
+  m_tcpNoPush = false;
   m_errorLogPath =
       filesystem::value_objects::Path::fromString(DEFAULT_ERROR_LOG_PATH, true);
+  m_errorLogLevel = DEFAULT_ERROR_LOG_LEVEL;
   m_accessLogPath = filesystem::value_objects::Path::fromString(
       DEFAULT_ACCESS_LOG_PATH, true);
+  m_accessLogEnabled = false;
+  m_accessLogFormat = DEFAULT_LOG_FORMAT_NAME;
+  m_logFormats.clear();
+  m_slowRequestThreshold = DEFAULT_SLOW_REQUEST_THRESHOLD_MS;
   m_mimeTypesPath = filesystem::value_objects::Path::fromString(
       DEFAULT_MIME_TYPES_PATH, true);
   m_clientMaxBodySize =
       filesystem::value_objects::Size::fromMegabytes(MAX_CLIENT_BODY_SIZE_GB);
-  m_mimeTypesLoaded = false;
+  m_mimeTypes.clear();
 }
 
 unsigned int HttpConfig::getWorkerProcesses() const {
@@ -119,14 +159,54 @@ unsigned int HttpConfig::getKeepaliveTimeout() const {
 
 unsigned int HttpConfig::getSendTimeout() const { return m_sendTimeout; }
 
+unsigned int HttpConfig::getKeepaliveRequests() const {
+  return m_keepaliveRequests;
+}
+
+unsigned int HttpConfig::getClientHeaderTimeout() const {
+  return m_clientHeaderTimeout;
+}
+
+unsigned int HttpConfig::getClientBodyTimeout() const {
+  return m_clientBodyTimeout;
+}
+
+bool HttpConfig::isTcpNoDelay() const { return m_tcpNoDelay; }
+
+bool HttpConfig::isTcpNoPush() const { return m_tcpNoPush; }
+
 const filesystem::value_objects::Path& HttpConfig::getErrorLogPath() const {
   return m_errorLogPath;
 }
 
+const std::string& HttpConfig::getErrorLogLevel() const {
+  return m_errorLogLevel;
+}
+
 const filesystem::value_objects::Path& HttpConfig::getAccessLogPath() const {
   return m_accessLogPath;
 }
 
+bool HttpConfig::isAccessLogEnabled() const { return m_accessLogEnabled; }
+
+const std::string& HttpConfig::getAccessLogFormat() const {
+  return m_accessLogFormat;
+}
+
+// "combined" is predefined, as in nginx, unless a log_format redefines it.
+const std::string& HttpConfig::getAccessLogPattern() const {
+  LogFormats::const_iterator it = m_logFormats.find(m_accessLogFormat);
+  return it != m_logFormats.end() ? it->second : COMBINED_LOG_FORMAT;
+}
+
+const HttpConfig::LogFormats& HttpConfig::getLogFormats() const {
+  return m_logFormats;
+}
+
+unsigned int HttpConfig::getSlowRequestThreshold() const {
+  return m_slowRequestThreshold;
+}
+
 const filesystem::value_objects::Path& HttpConfig::getMimeTypesPath() const {
   return m_mimeTypesPath;
 }
@@ -140,8 +220,46 @@ const HttpConfig::ServerConfigs& HttpConfig::getServerConfigs() const {
   return m_serverConfigs;
 }
 
+const HttpConfig::Upstreams& HttpConfig::getUpstreams() const {
+  return m_upstreams;
+}
+
+const value_objects::UpstreamConfig* HttpConfig::findUpstream(
+    const std::string& name) const {
+  Upstreams::const_iterator it = m_upstreams.find(name);
+  return it != m_upstreams.end() ? &it->second : NULL;
+}
+
+const HttpConfig::CacheZones& HttpConfig::getCacheZones() const {
+  return m_cacheZones;
+}
+
+const value_objects::CacheZoneConfig* HttpConfig::findCacheZone(
+    const std::string& name) const {
+  CacheZones::const_iterator it = m_cacheZones.find(name);
+  return it != m_cacheZones.end() ? &it->second : NULL;
+}
+
+const HttpConfig::LimitZones& HttpConfig::getLimitZones() const {
+  return m_limitZones;
+}
+
+const value_objects::LimitZoneConfig* HttpConfig::findLimitZone(
+    const std::string& name) const {
+  LimitZones::const_iterator it = m_limitZones.find(name);
+  return it != m_limitZones.end() ? &it->second : NULL;
+}
+
 const entities::ServerConfig* HttpConfig::selectServer(
     const std::string& host, unsigned int port) const {
+  if (m_serverSelector.isBuilt()) {
+    const entities::ServerConfig* server = m_serverSelector.select(host, port);
+    if (server == NULL) {
+      throwServerNotFound(host, port);
+    }
+    return server;
+  }
+
   http::value_objects::Host hostObj =
       http::value_objects::Host::fromString(host);
   http::value_objects::Port portObj(port);
@@ -151,6 +269,69 @@ const entities::ServerConfig* HttpConfig::selectServer(
 const entities::ServerConfig* HttpConfig::selectServer(
     const http::value_objects::Host& host,
     const http::value_objects::Port& port) const {
+  if (m_serverSelector.isBuilt()) {
+    return selectServer(host.getValue(), port.getValue());
+  }
+
+  const entities::ServerConfig* server = scanServers(host, port);
+  if (server == NULL) {
+    throwServerNotFound(host.getValue(), port.getValue());
+  }
+  return server;
+}
+
+// Routing for a connection accepted on address:port; NULL when no server on
+// that socket takes the host, leaving the choice to the caller.
+const entities::ServerConfig* HttpConfig::findServer(
+    const std::string& host, const std::string& address,
+    unsigned int port) const {
+  if (m_serverSelector.isBuilt()) {
+    return m_serverSelector.select(host, address, port);
+  }
+
+  const entities::ServerConfig* defaultServer = NULL;
+  for (ServerConfigs::const_iterator it = m_serverConfigs.begin();
+       it != m_serverConfigs.end(); ++it) {
+    if (*it == NULL || !(*it)->hasListenDirective(address, port)) {
+      continue;
+    }
+    const ServerConfig::ServerNames& names = (*it)->getServerNames();
+    bool matches = names.empty();
+    for (std::size_t i = 0; i < names.size() && !matches; ++i) {
+      matches = ServerConfig::matchesServerName(names[i], host);
+    }
+    if (!matches) {
+      continue;
+    }
+    if (!(*it)->isDefaultServer()) {
+      return *it;
+    }
+    defaultServer = *it;
+  }
+  return defaultServer;
+}
+
+// Published configurations no longer change, so ConfigSnapshot indexes them;
+// any later change to the server list drops the index and selection falls
+// back to scanning.
+void HttpConfig::indexServers() { m_serverSelector.build(m_serverConfigs); }
+
+bool HttpConfig::isServerIndexBuilt() const {
+  return m_serverSelector.isBuilt();
+}
+
+void HttpConfig::compileRequestPlans() {
+  for (ServerConfigs::iterator it = m_serverConfigs.begin();
+       it != m_serverConfigs.end(); ++it) {
+    if (*it != NULL) {
+      (*it)->compileRequestPlans();
+    }
+  }
+}
+
+const entities::ServerConfig* HttpConfig::scanServers(
+    const http::value_objects::Host& host,
+    const http::value_objects::Port& port) const {
   const entities::ServerConfig* selectedServer = NULL;
   const entities::ServerConfig* defaultServer = NULL;
 
@@ -170,82 +351,43 @@ const entities::ServerConfig* HttpConfig::selectServer(
     }
   }
 
-  if (selectedServer != NULL) {
-    return selectedServer;
-  }
-
-  if (defaultServer != NULL) {
-    return defaultServer;
-  }
+  return selectedServer != NULL ? selectedServer : defaultServer;
+}
 
+void HttpConfig::throwServerNotFound(const std::string& host,
+                                     unsigned int port) {
   std::ostringstream oss;
-  oss << "No server found for host: " << host.getValue()
-      << " and port: " << port.getValue();
+  oss << "No server found for host: " << host << " and port: " << port;
   throw exceptions::HttpConfigException(
       oss.str(), exceptions::HttpConfigException::SERVER_SELECTION_FAILED);
 }
 
-std::string HttpConfig::getMimeType(const std::string& extension) const {
-  if (!m_mimeTypesLoaded) {
-    const_cast<HttpConfig*>(this)->loadMimeTypes();
-  }
-
-  std::string ext = shared::utils::StringUtils::toLowerCase(
-      shared::utils::StringUtils::trim(extension));
-
-  if (!ext.empty() && ext[0] != '.') {
-    ext = "." + ext;
-  }
-
-  MimeTypesMap::const_iterator iter = m_mimeTypes.find(ext);
-  if (iter != m_mimeTypes.end()) {
-    return iter->second;
-  }
+const value_objects::MimeTypes& HttpConfig::getMimeTypes() const {
+  return m_mimeTypes;
+}
 
-  return "application/octet-stream";
+const std::string& HttpConfig::getMimeType(const std::string& extension) const {
+  return m_mimeTypes.lookup(extension);
 }
 
 void HttpConfig::loadMimeTypes() {
-  if (m_mimeTypesLoaded) {
-    return;
-  }
-
   try {
     loadMimeTypesFromFile();
-    m_mimeTypesLoaded = true;
   } catch (const std::exception& e) {
-    m_mimeTypes[".html"] = "text/html";
-    m_mimeTypes[".htm"] = "text/html";
-    m_mimeTypes[".css"] = "text/css";
-    m_mimeTypes[".js"] = "application/javascript";
-    m_mimeTypes[".json"] = "application/json";
-    m_mimeTypes[".xml"] = "application/xml";
-    m_mimeTypes[".txt"] = "text/plain";
-    m_mimeTypes[".jpg"] = "image/jpeg";
-    m_mimeTypes[".jpeg"] = "image/jpeg";
-    m_mimeTypes[".png"] = "image/png";
-    m_mimeTypes[".gif"] = "image/gif";
-    m_mimeTypes[".pdf"] = "application/pdf";
-    m_mimeTypes[".zip"] = "application/zip";
-    m_mimeTypes[".tar"] = "application/x-tar";
-    m_mimeTypes[".gz"] = "application/gzip";
-    m_mimeTypesLoaded = true;
+    m_mimeTypes.merge(value_objects::MimeTypes::builtin());
   }
 }
 
-bool HttpConfig::hasMimeType(const std::string& extension) const {
-  if (!m_mimeTypesLoaded) {
-    const_cast<HttpConfig*>(this)->loadMimeTypes();
-  }
-
-  std::string ext = shared::utils::StringUtils::toLowerCase(
-      shared::utils::StringUtils::trim(extension));
-
-  if (!ext.empty() && ext[0] != '.') {
-    ext = "." + ext;
+// Called once the configuration is parsed: a config without any `types`
+// block serves the built-in table rather than an empty one.
+void HttpConfig::compileMimeTypes() {
+  if (m_mimeTypes.empty()) {
+    m_mimeTypes.merge(value_objects::MimeTypes::builtin());
   }
+}
 
-  return m_mimeTypes.find(ext) != m_mimeTypes.end();
+bool HttpConfig::hasMimeType(const std::string& extension) const {
+  return m_mimeTypes.contains(extension);
 }
 
 const HttpConfig::ErrorPagesMap& HttpConfig::getErrorPages() const {
@@ -276,6 +418,12 @@ void HttpConfig::addServerConfig(entities::ServerConfig* serverConfig) {
             exceptions::HttpConfigException::DUPLICATE_SERVER);
       }
 
+      if (hasSslMismatch(*it, serverConfig)) {
+        throw exceptions::HttpConfigException(
+            "ssl and plain servers cannot share a listen address",
+            exceptions::HttpConfigException::PORT_CONFLICT);
+      }
+
       if (hasAddressConflict(*it, serverConfig)) {
         throw exceptions::HttpConfigException(
             "Server name conflict with existing server configuration",
@@ -284,6 +432,7 @@ void HttpConfig::addServerConfig(entities::ServerConfig* serverConfig) {
     }
   }
 
+  m_serverSelector.clear();
   m_serverConfigs.push_back(serverConfig);
 }
 
@@ -331,6 +480,43 @@ void HttpConfig::setSendTimeout(unsigned int timeout) {
   m_sendTimeout = timeout;
 }
 
+void HttpConfig::setKeepaliveRequests(unsigned int requests) {
+  if (requests == 0 || requests > MAX_KEEPALIVE_REQUESTS) {
+    std::ostringstream oss;
+    oss << "Invalid keepalive requests: " << requests
+        << " (must be between 1 and " << MAX_KEEPALIVE_REQUESTS << ")";
+    throw exceptions::HttpConfigException(
+        oss.str(), exceptions::HttpConfigException::INVALID_KEEPALIVE_REQUESTS);
+  }
+  m_keepaliveRequests = requests;
+}
+
+void HttpConfig::setClientHeaderTimeout(unsigned int timeout) {
+  if (timeout > MAX_CLIENT_TIMEOUT) {
+    std::ostringstream oss;
+    oss << "Invalid client header timeout: " << timeout << " (must be between "
+        << MIN_TIMEOUT << " and " << MAX_CLIENT_TIMEOUT << " seconds)";
+    throw exceptions::HttpConfigException(
+        oss.str(), exceptions::HttpConfigException::INVALID_CLIENT_TIMEOUT);
+  }
+  m_clientHeaderTimeout = timeout;
+}
+
+void HttpConfig::setClientBodyTimeout(unsigned int timeout) {
+  if (timeout > MAX_CLIENT_TIMEOUT) {
+    std::ostringstream oss;
+    oss << "Invalid client body timeout: " << timeout << " (must be between "
+        << MIN_TIMEOUT << " and " << MAX_CLIENT_TIMEOUT << " seconds)";
+    throw exceptions::HttpConfigException(
+        oss.str(), exceptions::HttpConfigException::INVALID_CLIENT_TIMEOUT);
+  }
+  m_clientBodyTimeout = timeout;
+}
+
+void HttpConfig::setTcpNoDelay(bool enabled) { m_tcpNoDelay = enabled; }
+
+void HttpConfig::setTcpNoPush(bool enabled) { m_tcpNoPush = enabled; }
+
 void HttpConfig::setErrorLogPath(const filesystem::value_objects::Path& path) {
   m_errorLogPath = path;
 }
@@ -348,6 +534,16 @@ void HttpConfig::setErrorLogPath(const std::string& path) {
   }
 }
 
+void HttpConfig::setErrorLogLevel(const std::string& level) {
+  if (!isValidLogLevel(level)) {
+    throw exceptions::HttpConfigException(
+        "Invalid error log level '" + level +
+            "' (expected debug, info, warn or error)",
+        exceptions::HttpConfigException::INVALID_ERROR_LOG_PATH);
+  }
+  m_errorLogLevel = level;
+}
+
 void HttpConfig::setAccessLogPath(const filesystem::value_objects::Path& path) {
   m_accessLogPath = path;
 }
@@ -365,6 +561,33 @@ void HttpConfig::setAccessLogPath(const std::string& path) {
   }
 }
 
+void HttpConfig::setAccessLogEnabled(bool enabled) {
+  m_accessLogEnabled = enabled;
+}
+
+void HttpConfig::setAccessLogFormat(const std::string& name) {
+  if (name.empty()) {
+    throw exceptions::HttpConfigException(
+        "Access log format name cannot be empty",
+        exceptions::HttpConfigException::INVALID_ACCESS_LOG_PATH);
+  }
+  m_accessLogFormat = name;
+}
+
+void HttpConfig::addLogFormat(const std::string& name,
+                              const std::string& pattern) {
+  if (name.empty() || pattern.empty()) {
+    throw exceptions::HttpConfigException(
+        "log_format requires a name and a non-empty pattern",
+        exceptions::HttpConfigException::INVALID_ACCESS_LOG_PATH);
+  }
+  m_logFormats[name] = pattern;
+}
+
+void HttpConfig::setSlowRequestThreshold(unsigned int milliseconds) {
+  m_slowRequestThreshold = milliseconds;
+}
+
 void HttpConfig::setErrorPage(const shared::value_objects::ErrorCode& code,
                                const std::string& uri) {
   if (uri.empty()) {
@@ -414,6 +637,19 @@ void HttpConfig::setMimeTypesPath(const std::string& path) {
   }
 }
 
+void HttpConfig::addMimeType(const std::string& type,
+                             const std::string& extension) {
+  m_mimeTypes.add(type, extension);
+}
+
+void HttpConfig::addMimeTypes(const value_objects::MimeTypes& mimeTypes) {
+  m_mimeTypes.merge(mimeTypes);
+}
+
+void HttpConfig::setDefaultType(const std::string& type) {
+  m_mimeTypes.setDefaultType(type);
+}
+
 void HttpConfig::setClientMaxBodySize(
     const filesystem::value_objects::Size& size) {
   const filesystem::value_objects::Size MAX_SIZE =
@@ -444,6 +680,47 @@ void HttpConfig::setClientMaxBodySize(const std::string& sizeString) {
   }
 }
 
+void HttpConfig::addUpstream(const value_objects::UpstreamConfig& upstream) {
+  upstream.validate();
+  if (m_upstreams.find(upstream.getName()) != m_upstreams.end()) {
+    throw exceptions::UpstreamConfigException(
+        "Duplicate upstream '" + upstream.getName() + "'",
+        exceptions::UpstreamConfigException::DUPLICATE_UPSTREAM);
+  }
+  m_upstreams[upstream.getName()] = upstream;
+}
+
+void HttpConfig::addCacheZone(const value_objects::CacheZoneConfig& zone) {
+  zone.validate();
+  if (m_cacheZones.find(zone.getName()) != m_cacheZones.end()) {
+    throw exceptions::CacheConfigException(
+        "'" + zone.getName() + "'",
+        exceptions::CacheConfigException::DUPLICATE_ZONE);
+  }
+  for (CacheZones::const_iterator it = m_cacheZones.begin();
+       it != m_cacheZones.end(); ++it) {
+    if (it->second.getPath() == zone.getPath()) {
+      throw exceptions::CacheConfigException(
+          "'" + zone.getPath() + "' is already used by zone '" +
+              it->first + "'",
+          exceptions::CacheConfigException::INVALID_PATH);
+    }
+  }
+  m_cacheZones[zone.getName()] = zone;
+}
+
+// limit_req_zone and limit_conn_zone share one namespace, as in nginx where
+// both are shared memory zones.
+void HttpConfig::addLimitZone(const value_objects::LimitZoneConfig& zone) {
+  zone.validate();
+  if (m_limitZones.find(zone.getName()) != m_limitZones.end()) {
+    throw exceptions::LimitConfigException(
+        "'" + zone.getName() + "'",
+        exceptions::LimitConfigException::DUPLICATE_ZONE);
+  }
+  m_limitZones[zone.getName()] = zone;
+}
+
 bool HttpConfig::isValid() const {
   try {
     validate();
@@ -459,6 +736,8 @@ void HttpConfig::validate() const {
   validateNoPortConflicts();
   validateNoAddressConflicts();
   validateDefaultServers();
+  validateCacheReferences();
+  validateLimitReferences();
 }
 
 void HttpConfig::validateGlobalConfig() const {
@@ -498,11 +777,33 @@ void HttpConfig::validateGlobalConfig() const {
         exceptions::HttpConfigException::INVALID_ACCESS_LOG_PATH);
   }
 
+  if (m_accessLogFormat != DEFAULT_LOG_FORMAT_NAME &&
+      m_logFormats.find(m_accessLogFormat) == m_logFormats.end()) {
+    throw exceptions::HttpConfigException(
+        "Unknown log format '" + m_accessLogFormat + "' for access_log",
+        exceptions::HttpConfigException::INVALID_ACCESS_LOG_PATH);
+  }
+
   if (m_mimeTypesPath.isEmpty()) {
     throw exceptions::HttpConfigException(
         "MIME types path cannot be empty",
         exceptions::HttpConfigException::INVALID_MIME_TYPES_PATH);
   }
+
+  for (Upstreams::const_iterator it = m_upstreams.begin();
+       it != m_upstreams.end(); ++it) {
+    it->second.validate();
+  }
+
+  for (CacheZones::const_iterator it = m_cacheZones.begin();
+       it != m_cacheZones.end(); ++it) {
+    it->second.validate();
+  }
+
+  for (LimitZones::const_iterator it = m_limitZones.begin();
+       it != m_limitZones.end(); ++it) {
+    it->second.validate();
+  }
 }
 
 void HttpConfig::validateServerConfigs() const {
@@ -530,6 +831,68 @@ void HttpConfig::validateServerConfigs() const {
   }
 }
 
+// proxy_cache names a zone declared with proxy_cache_path; locations are
+// parsed before the whole http block is known, so this is checked here.
+void HttpConfig::validateCacheReferences() const {
+  for (ServerConfigs::const_iterator server = m_serverConfigs.begin();
+       server != m_serverConfigs.end(); ++server) {
+    const ServerConfig::Locations& locations = (*server)->getLocations();
+    for (ServerConfig::Locations::const_iterator it = locations.begin();
+         it != locations.end(); ++it) {
+      const std::string& zone = (*it)->getProxyCache().getZone();
+      if (!zone.empty() && findCacheZone(zone) == NULL) {
+        throw exceptions::CacheConfigException(
+            "'" + zone + "' in location " + (*it)->getPath(),
+            exceptions::CacheConfigException::UNKNOWN_ZONE);
+      }
+    }
+  }
+}
+
+// limit_req must name a limit_req_zone and limit_conn a limit_conn_zone.
+void HttpConfig::validateLimitReferences() const {
+  for (ServerConfigs::const_iterator server = m_serverConfigs.begin();
+       server != m_serverConfigs.end(); ++server) {
+    const ServerConfig::Locations& locations = (*server)->getLocations();
+    for (ServerConfig::Locations::const_iterator it = locations.begin();
+         it != locations.end(); ++it) {
+      const value_objects::RequestLimitConfig& limits =
+          (*it)->getRequestLimits();
+      for (value_objects::RequestLimitConfig::RequestRules::const_iterator
+               rule = limits.getRequestRules().begin();
+           rule != limits.getRequestRules().end(); ++rule) {
+        validateLimitReference(rule->zone,
+                               value_objects::LimitZoneConfig::TYPE_REQUEST,
+                               (*it)->getPath());
+      }
+      for (value_objects::RequestLimitConfig::ConnectionRules::const_iterator
+               rule = limits.getConnectionRules().begin();
+           rule != limits.getConnectionRules().end(); ++rule) {
+        validateLimitReference(
+            rule->zone, value_objects::LimitZoneConfig::TYPE_CONNECTION,
+            (*it)->getPath());
+      }
+    }
+  }
+}
+
+void HttpConfig::validateLimitReference(
+    const std::string& zone, value_objects::LimitZoneConfig::Type type,
+    const std::string& locationPath) const {
+  const value_objects::LimitZoneConfig* config = findLimitZone(zone);
+  if (config == NULL) {
+    throw exceptions::LimitConfigException(
+        "'" + zone + "' in location " + locationPath,
+        exceptions::LimitConfigException::UNKNOWN_ZONE);
+  }
+  if (config->getType() != type) {
+    throw exceptions::LimitConfigException(
+        "'" + zone + "' in location " + locationPath + " is a " +
+            value_objects::LimitZoneConfig::typeName(config->getType()),
+        exceptions::LimitConfigException::ZONE_TYPE_MISMATCH);
+  }
+}
+
 void HttpConfig::validateNoPortConflicts() const {
   for (size_t i = 0; i < m_serverConfigs.size(); ++i) {
     for (size_t j = i + 1; j < m_serverConfigs.size(); ++j) {
@@ -538,6 +901,11 @@ void HttpConfig::validateNoPortConflicts() const {
             "Port conflict detected between servers",
             exceptions::HttpConfigException::PORT_CONFLICT);
       }
+      if (hasSslMismatch(m_serverConfigs[i], m_serverConfigs[j])) {
+        throw exceptions::HttpConfigException(
+            "ssl and plain servers cannot share a listen address",
+            exceptions::HttpConfigException::PORT_CONFLICT);
+      }
     }
   }
 }
@@ -585,17 +953,30 @@ void HttpConfig::clear() {
   m_workerConnections = DEFAULT_WORKER_CONNECTIONS;
   m_keepaliveTimeout = DEFAULT_KEEPALIVE_TIMEOUT;
   m_sendTimeout = DEFAULT_SEND_TIMEOUT;
+  m_keepaliveRequests = DEFAULT_KEEPALIVE_REQUESTS;
+  m_clientHeaderTimeout = DEFAULT_CLIENT_HEADER_TIMEOUT;
+  m_clientBodyTimeout = DEFAULT_CLIENT_BODY_TIMEOUT;
+  m_tcpNoDelay = true;
+  m_tcpNoPush = false;
   m_errorLogPath =
       filesystem::value_objects::Path::fromString(DEFAULT_ERROR_LOG_PATH, true);
+  m_errorLogLevel = DEFAULT_ERROR_LOG_LEVEL;
   m_accessLogPath = filesystem::value_objects::Path::fromString(
       DEFAULT_ACCESS_LOG_PATH, true);
+  m_accessLogEnabled = false;
+  m_accessLogFormat = DEFAULT_LOG_FORMAT_NAME;
+  m_logFormats.clear();
+  m_slowRequestThreshold = DEFAULT_SLOW_REQUEST_THRESHOLD_MS;
   m_mimeTypesPath = filesystem::value_objects::Path::fromString(
       DEFAULT_MIME_TYPES_PATH, true);
   m_clientMaxBodySize =
       filesystem::value_objects::Size::fromMegabytes(MAX_CLIENT_BODY_SIZE_GB);
   m_mimeTypes.clear();
-  m_mimeTypesLoaded = false;
   m_errorPages.clear();
+  m_sourceFiles.clear();
+  m_upstreams.clear();
+  m_cacheZones.clear();
+  m_limitZones.clear();
   clearServerConfigs();
 }
 
@@ -606,10 +987,24 @@ std::string HttpConfig::toString() const {
   oss << "  WorkerConnections: " << m_workerConnections << "\n";
   oss << "  KeepaliveTimeout: " << m_keepaliveTimeout << "s\n";
   oss << "  SendTimeout: " << m_sendTimeout << "s\n";
-  oss << "  ErrorLogPath: " << m_errorLogPath.toString() << "\n";
-  oss << "  AccessLogPath: " << m_accessLogPath.toString() << "\n";
+  oss << "  KeepaliveRequests: " << m_keepaliveRequests << "\n";
+  oss << "  ClientHeaderTimeout: " << m_clientHeaderTimeout << "s\n";
+  oss << "  ClientBodyTimeout: " << m_clientBodyTimeout << "s\n";
+  oss << "  TcpNoDelay: " << (m_tcpNoDelay ? "on" : "off") << "\n";
+  oss << "  TcpNoPush: " << (m_tcpNoPush ? "on" : "off") << "\n";
+  oss << "  ErrorLogPath: " << m_errorLogPath.toString() << " ("
+      << m_errorLogLevel << ")\n";
+  oss << "  AccessLogPath: "
+      << (m_accessLogEnabled ? m_accessLogPath.toString() : "off") << " ("
+      << m_accessLogFormat << ")\n";
+  oss << "  SlowRequestThreshold: " << m_slowRequestThreshold << "ms\n";
   oss << "  MimeTypesPath: " << m_mimeTypesPath.toString() << "\n";
+  oss << "  MimeTypes: " << m_mimeTypes.size() << " (default "
+      << m_mimeTypes.getDefaultType() << ")\n";
   oss << "  ClientMaxBodySize: " << m_clientMaxBodySize.toString() << "\n";
+  oss << "  Upstreams: " << m_upstreams.size() << "\n";
+  oss << "  CacheZones: " << m_cacheZones.size() << "\n";
+  oss << "  LimitZones: " << m_limitZones.size() << "\n";
   oss << "  ServerConfigs: " << m_serverConfigs.size() << "\n";
   for (size_t i = 0; i < m_serverConfigs.size(); ++i) {
     oss << "    Server[" << i << "]: " << m_serverConfigs[i]->toString()
@@ -650,7 +1045,7 @@ void HttpConfig::loadMimeTypesFromFile() {
 
     std::string extension;
     while ((iss >> extension) != 0) {
-      m_mimeTypes[extension] = mimeType;
+      m_mimeTypes.add(mimeType, extension);
     }
   }
 
@@ -661,6 +1056,11 @@ bool HttpConfig::isValidTimeout(unsigned int timeout) {
   return timeout <= MAX_KEEPALIVE_TIMEOUT;
 }
 
+bool HttpConfig::isValidLogLevel(const std::string& level) {
+  return level == "debug" || level == "info" || level == "warn" ||
+         level == "error";
+}
+
 bool HttpConfig::isValidWorkerCount(unsigned int count) {
   return count >= MIN_WORKER_PROCESSES && count <= MAX_WORKER_PROCESSES;
 }
@@ -669,21 +1069,30 @@ bool HttpConfig::isValidConnectionCount(unsigned int count) {
   return count >= MIN_WORKER_CONNECTIONS && count <= MAX_WORKER_CONNECTIONS;
 }
 
+// Servers that both carry server_name may share one listen socket, and the
+// Host header picks between them; overlapping names are caught by
+// hasAddressConflict. Different addresses on one port would need separate
+// sockets that cannot both be bound.
 bool HttpConfig::hasPortConflict(const entities::ServerConfig* config1,
                                  const entities::ServerConfig* config2) {
   const entities::ServerConfig::ListenDirectives& dir1 =
       config1->getListenDirectives();
   const entities::ServerConfig::ListenDirectives& dir2 =
       config2->getListenDirectives();
+  const bool namedHosts = !config1->getServerNames().empty() &&
+                          !config2->getServerNames().empty();
 
   for (size_t dir1Index = 0; dir1Index < dir1.size(); ++dir1Index) {
     for (size_t dir2Index = 0; dir2Index < dir2.size(); ++dir2Index) {
       if (dir1[dir1Index].getPort() == dir2[dir2Index].getPort()) {
-        if (dir1[dir1Index].isWildcard() || dir2[dir2Index].isWildcard()) {
-          return true;
+        if (dir1[dir1Index].getHost() == dir2[dir2Index].getHost()) {
+          if (!namedHosts) {
+            return true;
+          }
+          continue;
         }
 
-        if (dir1[dir1Index].getHost() == dir2[dir2Index].getHost()) {
+        if (dir1[dir1Index].isWildcard() || dir2[dir2Index].isWildcard()) {
           return true;
         }
 
@@ -697,6 +1106,28 @@ bool HttpConfig::hasPortConflict(const entities::ServerConfig* config1,
   return false;
 }
 
+// A listen socket either speaks TLS or it does not, so every server sharing
+// one has to agree on the ssl parameter.
+bool HttpConfig::hasSslMismatch(const entities::ServerConfig* config1,
+                                const entities::ServerConfig* config2) {
+  const entities::ServerConfig::ListenDirectives& dir1 =
+      config1->getListenDirectives();
+  const entities::ServerConfig::ListenDirectives& dir2 =
+      config2->getListenDirectives();
+
+  for (size_t dir1Index = 0; dir1Index < dir1.size(); ++dir1Index) {
+    for (size_t dir2Index = 0; dir2Index < dir2.size(); ++dir2Index) {
+      if (dir1[dir1Index].getPort() == dir2[dir2Index].getPort() &&
+          dir1[dir1Index].getHost() == dir2[dir2Index].getHost() &&
+          dir1[dir1Index].isSsl() != dir2[dir2Index].isSsl()) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
 bool HttpConfig::hasAddressConflict(const entities::ServerConfig* config1,
                                     const entities::ServerConfig* config2) {
   const entities::ServerConfig::ServerNames& names1 = config1->getServerNames();
@@ -732,6 +1163,136 @@ bool HttpConfig::hasAddressConflict(const entities::ServerConfig* config1,
   return false;
 }
 
+const HttpConfig::SourceFiles& HttpConfig::getSourceFiles() const {
+  return m_sourceFiles;
+}
+
+void HttpConfig::addSourceFile(const std::string& path) {
+  for (SourceFiles::const_iterator it = m_sourceFiles.begin();
+       it != m_sourceFiles.end(); ++it) {
+    if (*it == path) {
+      return;
+    }
+  }
+  m_sourceFiles.push_back(path);
+}
+
+// Source files are not part of the tree: the compiled form records them in
+// its own header so it can be checked for staleness before decoding.
+void HttpConfig::serialize(shared::utils::BinaryWriter& writer) const {
+  writer.writeU32(m_workerProcesses);
+  writer.writeU32(m_workerConnections);
+  writer.writeU32(m_keepaliveTimeout);
+  writer.writeU32(m_sendTimeout);
+  writer.writeU32(m_keepaliveRequests);
+  writer.writeU32(m_clientHeaderTimeout);
+  writer.writeU32(m_clientBodyTimeout);
+  writer.writeBool(m_tcpNoDelay);
+  writer.writeBool(m_tcpNoPush);
+  m_errorLogPath.serialize(writer);
+  writer.writeString(m_errorLogLevel);
+  m_accessLogPath.serialize(writer);
+  writer.writeBool(m_accessLogEnabled);
+  writer.writeString(m_accessLogFormat);
+  writer.writeSize(m_logFormats.size());
+  for (LogFormats::const_iterator it = m_logFormats.begin();
+       it != m_logFormats.end(); ++it) {
+    writer.writeString(it->first);
+    writer.writeString(it->second);
+  }
+  writer.writeU32(m_slowRequestThreshold);
+  writer.writeSize(m_errorPages.size());
+  for (ErrorPagesMap::const_iterator it = m_errorPages.begin();
+       it != m_errorPages.end(); ++it) {
+    writer.writeU32(it->first);
+    writer.writeString(it->second);
+  }
+  m_mimeTypesPath.serialize(writer);
+  writer.writeSize(m_clientMaxBodySize.getBytes());
+  m_mimeTypes.serialize(writer);
+  writer.writeSize(m_upstreams.size());
+  for (Upstreams::const_iterator it = m_upstreams.begin();
+       it != m_upstreams.end(); ++it) {
+    it->second.serialize(writer);
+  }
+  writer.writeSize(m_cacheZones.size());
+  for (CacheZones::const_iterator it = m_cacheZones.begin();
+       it != m_cacheZones.end(); ++it) {
+    it->second.serialize(writer);
+  }
+  writer.writeSize(m_limitZones.size());
+  for (LimitZones::const_iterator it = m_limitZones.begin();
+       it != m_limitZones.end(); ++it) {
+    it->second.serialize(writer);
+  }
+  writer.writeSize(m_serverConfigs.size());
+  for (ServerConfigs::const_iterator it = m_serverConfigs.begin();
+       it != m_serverConfigs.end(); ++it) {
+    (*it)->serialize(writer);
+  }
+}
+
+void HttpConfig::deserialize(shared::utils::BinaryReader& reader) {
+  m_workerProcesses = static_cast<unsigned int>(reader.readU32());
+  m_workerConnections = static_cast<unsigned int>(reader.readU32());
+  m_keepaliveTimeout = static_cast<unsigned int>(reader.readU32());
+  m_sendTimeout = static_cast<unsigned int>(reader.readU32());
+  m_keepaliveRequests = static_cast<unsigned int>(reader.readU32());
+  m_clientHeaderTimeout = static_cast<unsigned int>(reader.readU32());
+  m_clientBodyTimeout = static_cast<unsigned int>(reader.readU32());
+  m_tcpNoDelay = reader.readBool();
+  m_tcpNoPush = reader.readBool();
+  m_errorLogPath.deserialize(reader);
+  m_errorLogLevel = reader.readString();
+  m_accessLogPath.deserialize(reader);
+  m_accessLogEnabled = reader.readBool();
+  m_accessLogFormat = reader.readString();
+  m_logFormats.clear();
+  const std::size_t formatCount = reader.readSize();
+  for (std::size_t i = 0; i < formatCount; ++i) {
+    const std::string name = reader.readString();
+    m_logFormats[name] = reader.readString();
+  }
+  m_slowRequestThreshold = static_cast<unsigned int>(reader.readU32());
+  m_errorPages.clear();
+  const std::size_t pageCount = reader.readSize();
+  for (std::size_t i = 0; i < pageCount; ++i) {
+    const unsigned int code = static_cast<unsigned int>(reader.readU32());
+    m_errorPages[code] = reader.readString();
+  }
+  m_mimeTypesPath.deserialize(reader);
+  m_clientMaxBodySize = filesystem::value_objects::Size(reader.readSize());
+  m_mimeTypes.deserialize(reader);
+  m_upstreams.clear();
+  const std::size_t upstreamCount = reader.readSize();
+  for (std::size_t i = 0; i < upstreamCount; ++i) {
+    value_objects::UpstreamConfig upstream;
+    upstream.deserialize(reader);
+    m_upstreams[upstream.getName()] = upstream;
+  }
+  m_cacheZones.clear();
+  const std::size_t zoneCount = reader.readSize();
+  for (std::size_t i = 0; i < zoneCount; ++i) {
+    value_objects::CacheZoneConfig zone;
+    zone.deserialize(reader);
+    m_cacheZones[zone.getName()] = zone;
+  }
+  m_limitZones.clear();
+  const std::size_t limitZoneCount = reader.readSize();
+  for (std::size_t i = 0; i < limitZoneCount; ++i) {
+    value_objects::LimitZoneConfig zone;
+    zone.deserialize(reader);
+    m_limitZones[zone.getName()] = zone;
+  }
+  clearServerConfigs();
+  const std::size_t serverCount = reader.readSize();
+  for (std::size_t i = 0; i < serverCount; ++i) {
+    ServerConfig* server = new ServerConfig();
+    m_serverConfigs.push_back(server);
+    server->deserialize(reader);
+  }
+}
+
 }  // namespace entities
 }  // namespace configuration
 }  // namespace domain
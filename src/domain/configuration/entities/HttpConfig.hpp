@@ -14,10 +14,17 @@
 #define HTTP_CONFIG_HPP
 
 #include "domain/configuration/entities/ServerConfig.hpp"
+#include "domain/configuration/entities/ServerSelector.hpp"
+#include "domain/configuration/value_objects/CacheZoneConfig.hpp"
+#include "domain/configuration/value_objects/LimitZoneConfig.hpp"
+#include "domain/configuration/value_objects/MimeTypes.hpp"
+#include "domain/configuration/value_objects/UpstreamConfig.hpp"
 #include "domain/filesystem/value_objects/Path.hpp"
 #include "domain/filesystem/value_objects/Size.hpp"
 #include "domain/http/value_objects/Host.hpp"
 #include "domain/http/value_objects/Port.hpp"
+#include "domain/shared/utils/BinaryReader.hpp"
+#include "domain/shared/utils/BinaryWriter.hpp"
 
 #include <map>
 #include <string>
@@ -33,9 +40,16 @@ class HttpConfig {
   static const unsigned int DEFAULT_WORKER_CONNECTIONS = 1024;
   static const unsigned int DEFAULT_KEEPALIVE_TIMEOUT = 75;
   static const unsigned int DEFAULT_SEND_TIMEOUT = 60;
+  static const unsigned int DEFAULT_KEEPALIVE_REQUESTS = 1000;
+  static const unsigned int DEFAULT_CLIENT_HEADER_TIMEOUT = 60;
+  static const unsigned int DEFAULT_CLIENT_BODY_TIMEOUT = 60;
   static const std::string DEFAULT_MIME_TYPES_PATH;
   static const std::string DEFAULT_ERROR_LOG_PATH;
+  static const std::string DEFAULT_ERROR_LOG_LEVEL;
   static const std::string DEFAULT_ACCESS_LOG_PATH;
+  static const std::string DEFAULT_LOG_FORMAT_NAME;
+  static const std::string COMBINED_LOG_FORMAT;
+  static const unsigned int DEFAULT_SLOW_REQUEST_THRESHOLD_MS = 0;
 
   static const unsigned int MIN_WORKER_PROCESSES = 1;
   static const unsigned int MAX_WORKER_PROCESSES = 64;
@@ -46,12 +60,18 @@ class HttpConfig {
   static const unsigned int MIN_TIMEOUT = 0;
   static const unsigned int MAX_KEEPALIVE_TIMEOUT = 300;
   static const unsigned int MAX_SEND_TIMEOUT = 300;
+  static const unsigned int MAX_CLIENT_TIMEOUT = 300;
+  static const unsigned int MAX_KEEPALIVE_REQUESTS = 100000;
 
   static const unsigned int MAX_CLIENT_BODY_SIZE_GB = 1;
 
   typedef std::vector<entities::ServerConfig*> ServerConfigs;
-  typedef std::map<std::string, std::string> MimeTypesMap;
   typedef std::map<unsigned int, std::string> ErrorPagesMap;
+  typedef std::vector<std::string> SourceFiles;
+  typedef std::map<std::string, std::string> LogFormats;
+  typedef std::map<std::string, value_objects::UpstreamConfig> Upstreams;
+  typedef std::map<std::string, value_objects::CacheZoneConfig> CacheZones;
+  typedef std::map<std::string, value_objects::LimitZoneConfig> LimitZones;
 
   HttpConfig();
   explicit HttpConfig(const std::string& configFilePath);
@@ -64,45 +84,95 @@ class HttpConfig {
   unsigned int getWorkerConnections() const;
   unsigned int getKeepaliveTimeout() const;
   unsigned int getSendTimeout() const;
+  unsigned int getKeepaliveRequests() const;
+  unsigned int getClientHeaderTimeout() const;
+  unsigned int getClientBodyTimeout() const;
+  bool isTcpNoDelay() const;
+  bool isTcpNoPush() const;
   const filesystem::value_objects::Path& getErrorLogPath() const;
+  const std::string& getErrorLogLevel() const;
   const filesystem::value_objects::Path& getAccessLogPath() const;
+  bool isAccessLogEnabled() const;
+  const std::string& getAccessLogFormat() const;
+  const std::string& getAccessLogPattern() const;
+  const LogFormats& getLogFormats() const;
+  unsigned int getSlowRequestThreshold() const;
   const filesystem::value_objects::Path& getMimeTypesPath() const;
   const filesystem::value_objects::Size& getClientMaxBodySize() const;
   const ServerConfigs& getServerConfigs() const;
+  const Upstreams& getUpstreams() const;
+  const value_objects::UpstreamConfig* findUpstream(
+      const std::string& name) const;
+  const CacheZones& getCacheZones() const;
+  const value_objects::CacheZoneConfig* findCacheZone(
+      const std::string& name) const;
+  const LimitZones& getLimitZones() const;
+  const value_objects::LimitZoneConfig* findLimitZone(
+      const std::string& name) const;
 
   const entities::ServerConfig* selectServer(const std::string& host,
                                              unsigned int port) const;
   const entities::ServerConfig* selectServer(
       const http::value_objects::Host& host,
       const http::value_objects::Port& port) const;
-
-  std::string getMimeType(const std::string& extension) const;
+  const entities::ServerConfig* findServer(const std::string& host,
+                                           const std::string& address,
+                                           unsigned int port) const;
+  void indexServers();
+  bool isServerIndexBuilt() const;
+  void compileRequestPlans();
+
+  const value_objects::MimeTypes& getMimeTypes() const;
+  const std::string& getMimeType(const std::string& extension) const;
   void loadMimeTypes();
+  void compileMimeTypes();
   bool hasMimeType(const std::string& extension) const;
 
   const ErrorPagesMap& getErrorPages() const;
 
+  const SourceFiles& getSourceFiles() const;
+  void addSourceFile(const std::string& path);
+
   void addServerConfig(entities::ServerConfig* serverConfig);
   void setWorkerProcesses(unsigned int processes);
   void setWorkerConnections(unsigned int connections);
   void setKeepaliveTimeout(unsigned int timeout);
   void setSendTimeout(unsigned int timeout);
+  void setKeepaliveRequests(unsigned int requests);
+  void setClientHeaderTimeout(unsigned int timeout);
+  void setClientBodyTimeout(unsigned int timeout);
+  void setTcpNoDelay(bool enabled);
+  void setTcpNoPush(bool enabled);
   void setErrorLogPath(const filesystem::value_objects::Path& path);
   void setErrorLogPath(const std::string& path);
+  void setErrorLogLevel(const std::string& level);
   void setAccessLogPath(const filesystem::value_objects::Path& path);
   void setAccessLogPath(const std::string& path);
+  void setAccessLogEnabled(bool enabled);
+  void setAccessLogFormat(const std::string& name);
+  void addLogFormat(const std::string& name, const std::string& pattern);
+  void setSlowRequestThreshold(unsigned int milliseconds);
   void setErrorPage(const shared::value_objects::ErrorCode& code,
                     const std::string& uri);
   void setMimeTypesPath(const filesystem::value_objects::Path& path);
   void setMimeTypesPath(const std::string& path);
+  void addMimeType(const std::string& type, const std::string& extension);
+  void addMimeTypes(const value_objects::MimeTypes& mimeTypes);
+  void setDefaultType(const std::string& type);
   void setClientMaxBodySize(const filesystem::value_objects::Size& size);
   void setClientMaxBodySize(const std::string& sizeString);
+  void addUpstream(const value_objects::UpstreamConfig& upstream);
+  void addCacheZone(const value_objects::CacheZoneConfig& zone);
+  void addLimitZone(const value_objects::LimitZoneConfig& zone);
 
   bool isValid() const;
   void validate() const;
 
   void clear();
   std::string toString() const;
+
+  void serialize(shared::utils::BinaryWriter& writer) const;
+  void deserialize(shared::utils::BinaryReader& reader);
   static HttpConfig fromFile(const std::string& configFilePath);
 
  private:
@@ -110,14 +180,28 @@ class HttpConfig {
   unsigned int m_workerConnections;
   unsigned int m_keepaliveTimeout;
   unsigned int m_sendTimeout;
+  unsigned int m_keepaliveRequests;
+  unsigned int m_clientHeaderTimeout;
+  unsigned int m_clientBodyTimeout;
+  bool m_tcpNoDelay;
+  bool m_tcpNoPush;
   filesystem::value_objects::Path m_errorLogPath;
+  std::string m_errorLogLevel;
   filesystem::value_objects::Path m_accessLogPath;
+  bool m_accessLogEnabled;
+  std::string m_accessLogFormat;
+  LogFormats m_logFormats;
+  unsigned int m_slowRequestThreshold;
   ErrorPagesMap m_errorPages;
   filesystem::value_objects::Path m_mimeTypesPath;
   filesystem::value_objects::Size m_clientMaxBodySize;
   ServerConfigs m_serverConfigs;
-  MimeTypesMap m_mimeTypes;
-  bool m_mimeTypesLoaded;
+  Upstreams m_upstreams;
+  CacheZones m_cacheZones;
+  LimitZones m_limitZones;
+  value_objects::MimeTypes m_mimeTypes;
+  SourceFiles m_sourceFiles;
+  ServerSelector m_serverSelector;
 
   void copyFrom(const HttpConfig& other);
   void clearServerConfigs();
@@ -128,14 +212,27 @@ class HttpConfig {
   void validateNoPortConflicts() const;
   void validateNoAddressConflicts() const;
   void validateDefaultServers() const;
+  void validateCacheReferences() const;
+  void validateLimitReferences() const;
+  void validateLimitReference(const std::string& zone,
+                              value_objects::LimitZoneConfig::Type type,
+                              const std::string& locationPath) const;
 
   void loadMimeTypesFromFile();
   static bool isValidTimeout(unsigned int timeout);
+  static bool isValidLogLevel(const std::string& level);
   static bool isValidWorkerCount(unsigned int count);
   static bool isValidConnectionCount(unsigned int count);
 
+  const entities::ServerConfig* scanServers(
+      const http::value_objects::Host& host,
+      const http::value_objects::Port& port) const;
+  static void throwServerNotFound(const std::string& host, unsigned int port);
+
   static bool hasPortConflict(const entities::ServerConfig* config1,
                               const entities::ServerConfig* config2);
+  static bool hasSslMismatch(const entities::ServerConfig* config1,
+                             const entities::ServerConfig* config2);
   static bool hasAddressConflict(const entities::ServerConfig* config1,
                                  const entities::ServerConfig* config2);
 };
@@ -11,7 +11,9 @@
 /* ************************************************************************** */
 
 #include "domain/configuration/entities/LocationConfig.hpp"
+#include "domain/configuration/entities/RequestPlan.hpp"
 #include "domain/configuration/exceptions/LocationConfigException.hpp"
+#include "domain/shared/exceptions/BinaryFormatException.hpp"
 #include "domain/shared/utils/StringUtils.hpp"
 
 #include <cctype>
@@ -27,6 +29,7 @@ LocationConfig::LocationConfig()
     : m_path("/"),
       m_matchType(MATCH_PREFIX),
       m_root(filesystem::value_objects::Path::rootDirectory()),
+      m_allowedMethodMask(http::value_objects::HttpMethod::NO_METHODS),
       m_autoIndex(false),
       m_returnCode(shared::value_objects::ErrorCode::movedPermanently()),
       m_hasReturnContent(false),
@@ -34,14 +37,15 @@ LocationConfig::LocationConfig()
       m_hasUploadConfig(false),
       m_clientMaxBodySize(filesystem::value_objects::Size::fromMegabytes(
           DEFAULT_CLIENT_MAX_BODY_SIZE)),
+      m_proxyConnectTimeout(DEFAULT_PROXY_TIMEOUT),
+      m_proxyReadTimeout(DEFAULT_PROXY_TIMEOUT),
       m_clientBodyBufferSize(filesystem::value_objects::Size::fromKilobytes(
           DEFAULT_CLIENT_BODY_BUFFER_SIZE)),
       m_clientBodyBufferSizeSet(false),
-      m_regexPatternValid(false) {
-  m_allowedMethods.insert(http::value_objects::HttpMethod::get());
-  m_allowedMethods.insert(http::value_objects::HttpMethod::post());
-  m_allowedMethods.insert(http::value_objects::HttpMethod::deleteMethod());
-  m_allowedMethods.insert(http::value_objects::HttpMethod::head());
+      m_statusFormat(STATUS_NONE),
+      m_regexPatternValid(false),
+      m_requestPlan(NULL) {
+  allowDefaultMethods();
 
   m_indexFiles.push_back("index.html");
   m_indexFiles.push_back("index.htm");
@@ -52,6 +56,7 @@ LocationConfig::LocationConfig(const std::string& path,
     : m_path(path),
       m_matchType(matchType),
       m_root(filesystem::value_objects::Path::rootDirectory()),
+      m_allowedMethodMask(http::value_objects::HttpMethod::NO_METHODS),
       m_autoIndex(false),
       m_returnCode(shared::value_objects::ErrorCode::movedPermanently()),
       m_hasReturnContent(false),
@@ -59,16 +64,17 @@ LocationConfig::LocationConfig(const std::string& path,
       m_hasUploadConfig(false),
       m_clientMaxBodySize(filesystem::value_objects::Size::fromMegabytes(
           DEFAULT_CLIENT_MAX_BODY_SIZE)),
+      m_proxyConnectTimeout(DEFAULT_PROXY_TIMEOUT),
+      m_proxyReadTimeout(DEFAULT_PROXY_TIMEOUT),
       m_clientBodyBufferSize(filesystem::value_objects::Size::fromKilobytes(
           DEFAULT_CLIENT_BODY_BUFFER_SIZE)),
       m_clientBodyBufferSizeSet(false),
-      m_regexPatternValid(false) {
+      m_statusFormat(STATUS_NONE),
+      m_regexPatternValid(false),
+      m_requestPlan(NULL) {
   validatePath();
 
-  m_allowedMethods.insert(http::value_objects::HttpMethod::get());
-  m_allowedMethods.insert(http::value_objects::HttpMethod::post());
-  m_allowedMethods.insert(http::value_objects::HttpMethod::deleteMethod());
-  m_allowedMethods.insert(http::value_objects::HttpMethod::head());
+  allowDefaultMethods();
 
   m_indexFiles.push_back("index.html");
   m_indexFiles.push_back("index.htm");
@@ -80,6 +86,7 @@ LocationConfig::LocationConfig(const LocationConfig& other)
       m_root(other.m_root),
       m_indexFiles(other.m_indexFiles),
       m_allowedMethods(other.m_allowedMethods),
+      m_allowedMethodMask(other.m_allowedMethodMask),
       m_autoIndex(other.m_autoIndex),
       m_tryFiles(other.m_tryFiles),
       m_returnRedirect(other.m_returnRedirect),
@@ -92,14 +99,20 @@ LocationConfig::LocationConfig(const LocationConfig& other)
       m_errorPages(other.m_errorPages),
       m_clientMaxBodySize(other.m_clientMaxBodySize),
       m_proxyPass(other.m_proxyPass),
+      m_proxyConnectTimeout(other.m_proxyConnectTimeout),
+      m_proxyReadTimeout(other.m_proxyReadTimeout),
+      m_proxyCache(other.m_proxyCache),
+      m_requestLimits(other.m_requestLimits),
       m_alias(other.m_alias),
       m_clientBodyBufferSize(other.m_clientBodyBufferSize),
       m_clientBodyBufferSizeSet(other.m_clientBodyBufferSizeSet),
-      m_customHeaders(other.m_customHeaders) {
+      m_customHeaders(other.m_customHeaders),
+      m_statusFormat(other.m_statusFormat),
+      m_requestPlan(NULL) {
   m_regexPatternValid = false;
 }
 
-LocationConfig::~LocationConfig() {}
+LocationConfig::~LocationConfig() { delete m_requestPlan; }
 
 LocationConfig& LocationConfig::operator=(const LocationConfig& other) {
   if (this != &other) {
@@ -109,6 +122,7 @@ LocationConfig& LocationConfig::operator=(const LocationConfig& other) {
     m_root = other.m_root;
     m_indexFiles = other.m_indexFiles;
     m_allowedMethods = other.m_allowedMethods;
+    m_allowedMethodMask = other.m_allowedMethodMask;
     m_autoIndex = other.m_autoIndex;
     m_tryFiles = other.m_tryFiles;
     m_returnRedirect = other.m_returnRedirect;
@@ -121,10 +135,15 @@ LocationConfig& LocationConfig::operator=(const LocationConfig& other) {
     m_errorPages = other.m_errorPages;
     m_clientMaxBodySize = other.m_clientMaxBodySize;
     m_proxyPass = other.m_proxyPass;
+    m_proxyConnectTimeout = other.m_proxyConnectTimeout;
+    m_proxyReadTimeout = other.m_proxyReadTimeout;
+    m_proxyCache = other.m_proxyCache;
+    m_requestLimits = other.m_requestLimits;
     m_alias = other.m_alias;
     m_clientBodyBufferSize = other.m_clientBodyBufferSize;
     m_clientBodyBufferSizeSet = other.m_clientBodyBufferSizeSet;
     m_customHeaders = other.m_customHeaders;
+    m_statusFormat = other.m_statusFormat;
     m_regexPatternValid = false;
   }
   return *this;
@@ -149,6 +168,11 @@ const LocationConfig::AllowedMethods& LocationConfig::getAllowedMethods()
   return m_allowedMethods;
 }
 
+http::value_objects::HttpMethod::MethodMask
+LocationConfig::getAllowedMethodMask() const {
+  return m_allowedMethodMask;
+}
+
 bool LocationConfig::getAutoIndex() const { return m_autoIndex; }
 
 const LocationConfig::TryFiles& LocationConfig::getTryFiles() const {
@@ -196,6 +220,23 @@ const http::value_objects::Uri& LocationConfig::getProxyPass() const {
   return m_proxyPass;
 }
 
+unsigned int LocationConfig::getProxyConnectTimeout() const {
+  return m_proxyConnectTimeout;
+}
+
+unsigned int LocationConfig::getProxyReadTimeout() const {
+  return m_proxyReadTimeout;
+}
+
+const value_objects::ProxyCacheConfig& LocationConfig::getProxyCache() const {
+  return m_proxyCache;
+}
+
+const value_objects::RequestLimitConfig& LocationConfig::getRequestLimits()
+    const {
+  return m_requestLimits;
+}
+
 const filesystem::value_objects::Path& LocationConfig::getAlias() const {
   return m_alias;
 }
@@ -211,6 +252,7 @@ const filesystem::value_objects::Size& LocationConfig::getClientBodyBufferSize()
 
 void LocationConfig::clearAllowedMethods() {
   m_allowedMethods.clear();
+  m_allowedMethodMask = http::value_objects::HttpMethod::NO_METHODS;
 }
 
 void LocationConfig::setPath(const std::string& path,
@@ -260,11 +302,13 @@ void LocationConfig::clearIndexFiles() { m_indexFiles.clear(); }
 void LocationConfig::addAllowedMethod(
     const http::value_objects::HttpMethod& method) {
   m_allowedMethods.insert(method);
+  m_allowedMethodMask |= method.toMask();
 }
 
 void LocationConfig::removeAllowedMethod(
     const http::value_objects::HttpMethod& method) {
   m_allowedMethods.erase(method);
+  m_allowedMethodMask &= ~method.toMask();
 }
 
 void LocationConfig::setAutoIndex(bool autoIndex) { m_autoIndex = autoIndex; }
@@ -530,6 +574,34 @@ void LocationConfig::clearProxyPass() {
   m_proxyPass = http::value_objects::Uri();
 }
 
+void LocationConfig::setProxyConnectTimeout(unsigned int seconds) {
+  if (seconds == 0) {
+    throw exceptions::LocationConfigException(
+        "proxy_connect_timeout must be positive",
+        exceptions::LocationConfigException::INVALID_PROXY_TIMEOUT);
+  }
+  m_proxyConnectTimeout = seconds;
+}
+
+void LocationConfig::setProxyReadTimeout(unsigned int seconds) {
+  if (seconds == 0) {
+    throw exceptions::LocationConfigException(
+        "proxy_read_timeout must be positive",
+        exceptions::LocationConfigException::INVALID_PROXY_TIMEOUT);
+  }
+  m_proxyReadTimeout = seconds;
+}
+
+void LocationConfig::setProxyCache(
+    const value_objects::ProxyCacheConfig& proxyCache) {
+  m_proxyCache = proxyCache;
+}
+
+void LocationConfig::setRequestLimits(
+    const value_objects::RequestLimitConfig& limits) {
+  m_requestLimits = limits;
+}
+
 void LocationConfig::setAlias(const filesystem::value_objects::Path& alias) {
   if (!alias.isEmpty() && !alias.isAbsolute()) {
     throw exceptions::LocationConfigException(
@@ -654,7 +726,8 @@ void LocationConfig::validate() const {
   if (m_clientBodyBufferSizeSet) validateClientBodyBufferSize();
 
   if (hasProxyPass() &&
-      (isUploadEnabled() || hasCgiConfig() || hasReturnRedirect())) {
+      (isUploadEnabled() || !m_cgiConfig.getScriptPath().empty() ||
+       m_cgiConfig.hasFastcgiPass() || hasReturnRedirect())) {
     throw exceptions::LocationConfigException(
         "Proxy pass cannot be combined with upload, CGI, or return directives",
         exceptions::LocationConfigException::CONFLICTING_DIRECTIVES);
@@ -916,6 +989,18 @@ void LocationConfig::removeCustomHeader(const std::string& name) {
 
 void LocationConfig::clearCustomHeaders() { m_customHeaders.clear(); }
 
+LocationConfig::StatusFormat LocationConfig::getStatusFormat() const {
+  return m_statusFormat;
+}
+
+bool LocationConfig::hasStatusEndpoint() const {
+  return m_statusFormat != STATUS_NONE;
+}
+
+void LocationConfig::setStatusFormat(StatusFormat format) {
+  m_statusFormat = format;
+}
+
 bool LocationConfig::matchesPath(const std::string& requestPath) const {
   switch (m_matchType) {
     case MATCH_EXACT:
@@ -938,7 +1023,7 @@ bool LocationConfig::matchesPath(const std::string& requestPath) const {
 
 bool LocationConfig::isMethodAllowed(
     const http::value_objects::HttpMethod& method) const {
-  return m_allowedMethods.find(method) != m_allowedMethods.end();
+  return (m_allowedMethodMask & method.toMask()) != 0;
 }
 
 bool LocationConfig::isUploadEnabled() const { return m_hasUploadConfig; }
@@ -1085,12 +1170,33 @@ value_objects::Route LocationConfig::toRoute() const {
   return route;
 }
 
+const RequestPlan* LocationConfig::getRequestPlan() const {
+  return m_requestPlan;
+}
+
+// Built by ServerConfig when a configuration is published; copies and
+// clear() drop it, so it never outlives the settings it was derived from.
+void LocationConfig::compileRequestPlan(
+    const filesystem::value_objects::Path& serverRoot,
+    const ErrorPageMap& serverErrorPages) {
+  RequestPlan* plan = new RequestPlan(*this, serverRoot, serverErrorPages);
+  delete m_requestPlan;
+  m_requestPlan = plan;
+}
+
+void LocationConfig::allowDefaultMethods() {
+  addAllowedMethod(http::value_objects::HttpMethod::get());
+  addAllowedMethod(http::value_objects::HttpMethod::post());
+  addAllowedMethod(http::value_objects::HttpMethod::deleteMethod());
+  addAllowedMethod(http::value_objects::HttpMethod::head());
+}
+
 void LocationConfig::clear() {
   m_path = "/";
   m_matchType = MATCH_PREFIX;
   m_root = filesystem::value_objects::Path::rootDirectory();
   m_indexFiles.clear();
-  m_allowedMethods.clear();
+  clearAllowedMethods();
   m_autoIndex = false;
   m_tryFiles.clear();
   m_returnRedirect = http::value_objects::Uri();
@@ -1103,20 +1209,24 @@ void LocationConfig::clear() {
   m_clientMaxBodySize = filesystem::value_objects::Size::fromMegabytes(
       DEFAULT_CLIENT_MAX_BODY_SIZE);
   m_proxyPass = http::value_objects::Uri();
+  m_proxyConnectTimeout = DEFAULT_PROXY_TIMEOUT;
+  m_proxyReadTimeout = DEFAULT_PROXY_TIMEOUT;
+  m_proxyCache = value_objects::ProxyCacheConfig();
+  m_requestLimits = value_objects::RequestLimitConfig();
   m_alias = filesystem::value_objects::Path();
   m_clientBodyBufferSize = filesystem::value_objects::Size::fromKilobytes(
       DEFAULT_CLIENT_BODY_BUFFER_SIZE);
   m_clientBodyBufferSizeSet = false;
   m_customHeaders.clear();
+  m_statusFormat = STATUS_NONE;
   m_regexPatternValid = false;
+  delete m_requestPlan;
+  m_requestPlan = NULL;
 
   m_indexFiles.push_back("index.html");
   m_indexFiles.push_back("index.htm");
 
-  m_allowedMethods.insert(http::value_objects::HttpMethod::get());
-  m_allowedMethods.insert(http::value_objects::HttpMethod::post());
-  m_allowedMethods.insert(http::value_objects::HttpMethod::deleteMethod());
-  m_allowedMethods.insert(http::value_objects::HttpMethod::head());
+  allowDefaultMethods();
 }
 
 void LocationConfig::compileRegexPattern() const {
@@ -1197,6 +1307,106 @@ std::string LocationConfig::stripMatchPrefix(const std::string& path) {
   }
 }
 
+void LocationConfig::serialize(shared::utils::BinaryWriter& writer) const {
+  writer.writeString(m_path);
+  writer.writeU8(static_cast<unsigned char>(m_matchType));
+  m_root.serialize(writer);
+  writer.writeStrings(m_indexFiles);
+  writer.writeU32(m_allowedMethodMask);
+  writer.writeBool(m_autoIndex);
+  writer.writeStrings(m_tryFiles);
+  m_returnRedirect.serialize(writer);
+  writer.writeU32(m_returnCode.getValue());
+  writer.writeString(m_returnContent);
+  writer.writeBool(m_hasReturnContent);
+  m_uploadConfig.serialize(writer);
+  writer.writeBool(m_hasUploadConfig);
+  m_cgiConfig.serialize(writer);
+  writer.writeSize(m_errorPages.size());
+  for (ErrorPageMap::const_iterator it = m_errorPages.begin();
+       it != m_errorPages.end(); ++it) {
+    writer.writeU32(it->first.getValue());
+    writer.writeString(it->second);
+  }
+  writer.writeSize(m_clientMaxBodySize.getBytes());
+  m_proxyPass.serialize(writer);
+  writer.writeU32(m_proxyConnectTimeout);
+  writer.writeU32(m_proxyReadTimeout);
+  m_proxyCache.serialize(writer);
+  m_requestLimits.serialize(writer);
+  m_alias.serialize(writer);
+  writer.writeSize(m_clientBodyBufferSize.getBytes());
+  writer.writeBool(m_clientBodyBufferSizeSet);
+  writer.writeStringMap(m_customHeaders);
+  writer.writeU8(static_cast<unsigned char>(m_statusFormat));
+}
+
+void LocationConfig::deserialize(shared::utils::BinaryReader& reader) {
+  m_path = reader.readString();
+  const unsigned char matchType = reader.readU8();
+  if (matchType > MATCH_REGEX_CASE_INSENSITIVE) {
+    throw shared::exceptions::BinaryFormatException(
+        "unknown location match type",
+        shared::exceptions::BinaryFormatException::INVALID_VALUE);
+  }
+  m_matchType = static_cast<LocationMatchType>(matchType);
+  m_root.deserialize(reader);
+  m_indexFiles = reader.readStrings();
+  const unsigned long methodMask = reader.readU32();
+  if ((methodMask & ~static_cast<unsigned long>(
+                        http::value_objects::HttpMethod::ALL_METHODS)) != 0) {
+    throw shared::exceptions::BinaryFormatException(
+        "unknown method in allow-list",
+        shared::exceptions::BinaryFormatException::INVALID_VALUE);
+  }
+  clearAllowedMethods();
+  for (int method = http::value_objects::HttpMethod::METHOD_GET;
+       method < http::value_objects::HttpMethod::METHOD_UNKNOWN; ++method) {
+    const http::value_objects::HttpMethod allowed(
+        static_cast<http::value_objects::HttpMethod::Method>(method));
+    if ((methodMask & allowed.toMask()) != 0) {
+      addAllowedMethod(allowed);
+    }
+  }
+  m_autoIndex = reader.readBool();
+  m_tryFiles = reader.readStrings();
+  m_returnRedirect.deserialize(reader);
+  m_returnCode = shared::value_objects::ErrorCode(
+      static_cast<unsigned int>(reader.readU32()));
+  m_returnContent = reader.readString();
+  m_hasReturnContent = reader.readBool();
+  m_uploadConfig.deserialize(reader);
+  m_hasUploadConfig = reader.readBool();
+  m_cgiConfig.deserialize(reader);
+  m_errorPages.clear();
+  const std::size_t pageCount = reader.readSize();
+  for (std::size_t i = 0; i < pageCount; ++i) {
+    const shared::value_objects::ErrorCode code(
+        static_cast<unsigned int>(reader.readU32()));
+    m_errorPages[code] = reader.readString();
+  }
+  m_clientMaxBodySize = filesystem::value_objects::Size(reader.readSize());
+  m_proxyPass.deserialize(reader);
+  m_proxyConnectTimeout = static_cast<unsigned int>(reader.readU32());
+  m_proxyReadTimeout = static_cast<unsigned int>(reader.readU32());
+  m_proxyCache.deserialize(reader);
+  m_requestLimits.deserialize(reader);
+  m_alias.deserialize(reader);
+  m_clientBodyBufferSize = filesystem::value_objects::Size(reader.readSize());
+  m_clientBodyBufferSizeSet = reader.readBool();
+  m_customHeaders = reader.readStringMap();
+  const unsigned char statusFormat = reader.readU8();
+  if (statusFormat > STATUS_PROMETHEUS) {
+    throw shared::exceptions::BinaryFormatException(
+        "unknown stub_status format",
+        shared::exceptions::BinaryFormatException::INVALID_VALUE);
+  }
+  m_statusFormat = static_cast<StatusFormat>(statusFormat);
+  m_regexPatternValid = false;
+  delete m_requestPlan;
+  m_requestPlan = NULL;
+}
+
 }  // namespace entities
 }  // namespace configuration
 }  // namespace domain
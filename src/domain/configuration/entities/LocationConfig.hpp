@@ -14,12 +14,16 @@
 #define LOCATION_CONFIG_HPP
 
 #include "domain/configuration/value_objects/CgiConfig.hpp"
+#include "domain/configuration/value_objects/ProxyCacheConfig.hpp"
+#include "domain/configuration/value_objects/RequestLimitConfig.hpp"
 #include "domain/configuration/value_objects/Route.hpp"
 #include "domain/configuration/value_objects/UploadConfig.hpp"
 #include "domain/filesystem/value_objects/Path.hpp"
 #include "domain/filesystem/value_objects/Size.hpp"
 #include "domain/http/value_objects/HttpMethod.hpp"
 #include "domain/http/value_objects/Uri.hpp"
+#include "domain/shared/utils/BinaryReader.hpp"
+#include "domain/shared/utils/BinaryWriter.hpp"
 #include "domain/shared/value_objects/ErrorCode.hpp"
 #include "domain/shared/value_objects/RegexPattern.hpp"
 
@@ -32,6 +36,8 @@ namespace domain {
 namespace configuration {
 namespace entities {
 
+class RequestPlan;
+
 class LocationConfig {
  public:
   typedef std::set<http::value_objects::HttpMethod> AllowedMethods;
@@ -46,6 +52,8 @@ class LocationConfig {
     MATCH_REGEX_CASE_INSENSITIVE
   };
 
+  enum StatusFormat { STATUS_NONE, STATUS_TEXT, STATUS_PROMETHEUS };
+
   LocationConfig();
   explicit LocationConfig(const std::string& path,
                           LocationMatchType matchType = MATCH_PREFIX);
@@ -60,6 +68,7 @@ class LocationConfig {
   const filesystem::value_objects::Path& getRoot() const;
   const std::vector<std::string>& getIndexFiles() const;
   const AllowedMethods& getAllowedMethods() const;
+  http::value_objects::HttpMethod::MethodMask getAllowedMethodMask() const;
   bool getAutoIndex() const;
   const TryFiles& getTryFiles() const;
   bool hasReturnRedirect() const;
@@ -73,6 +82,10 @@ class LocationConfig {
   const filesystem::value_objects::Size& getClientMaxBodySize() const;
   bool hasProxyPass() const;
   const http::value_objects::Uri& getProxyPass() const;
+  unsigned int getProxyConnectTimeout() const;
+  unsigned int getProxyReadTimeout() const;
+  const value_objects::ProxyCacheConfig& getProxyCache() const;
+  const value_objects::RequestLimitConfig& getRequestLimits() const;
   const filesystem::value_objects::Path& getAlias() const;
   bool getClientBodyBufferSizeSet() const;
   const filesystem::value_objects::Size& getClientBodyBufferSize() const;
@@ -112,6 +125,10 @@ class LocationConfig {
   void setProxyPass(const http::value_objects::Uri& proxyPass);
   void setProxyPass(const std::string& proxyPass);
   void clearProxyPass();
+  void setProxyConnectTimeout(unsigned int seconds);
+  void setProxyReadTimeout(unsigned int seconds);
+  void setProxyCache(const value_objects::ProxyCacheConfig& proxyCache);
+  void setRequestLimits(const value_objects::RequestLimitConfig& limits);
   void setAlias(const filesystem::value_objects::Path& alias);
   void setAlias(const std::string& alias);
   void setClientBodyBufferSize(const filesystem::value_objects::Size& size);
@@ -125,6 +142,9 @@ class LocationConfig {
 
   const CustomHeaderMap& getCustomHeaders() const;
   bool hasCustomHeaders() const;
+  StatusFormat getStatusFormat() const;
+  bool hasStatusEndpoint() const;
+  void setStatusFormat(StatusFormat format);
   void addCustomHeader(const std::string& name, const std::string& value);
   void removeCustomHeader(const std::string& name);
   void clearCustomHeaders();
@@ -156,14 +176,22 @@ class LocationConfig {
 
   value_objects::Route toRoute() const;
 
+  const RequestPlan* getRequestPlan() const;
+  void compileRequestPlan(const filesystem::value_objects::Path& serverRoot,
+                          const ErrorPageMap& serverErrorPages);
+
   void clear();
 
+  void serialize(shared::utils::BinaryWriter& writer) const;
+  void deserialize(shared::utils::BinaryReader& reader);
+
  private:
   std::string m_path;
   LocationMatchType m_matchType;
   filesystem::value_objects::Path m_root;
   std::vector<std::string> m_indexFiles;
   AllowedMethods m_allowedMethods;
+  http::value_objects::HttpMethod::MethodMask m_allowedMethodMask;
   bool m_autoIndex;
   TryFiles m_tryFiles;
   http::value_objects::Uri m_returnRedirect;
@@ -176,18 +204,26 @@ class LocationConfig {
   ErrorPageMap m_errorPages;
   filesystem::value_objects::Size m_clientMaxBodySize;
   http::value_objects::Uri m_proxyPass;
+  unsigned int m_proxyConnectTimeout;
+  unsigned int m_proxyReadTimeout;
+  value_objects::ProxyCacheConfig m_proxyCache;
+  value_objects::RequestLimitConfig m_requestLimits;
   filesystem::value_objects::Path m_alias;
   filesystem::value_objects::Size m_clientBodyBufferSize;
   bool m_clientBodyBufferSizeSet;
   CustomHeaderMap m_customHeaders;
+  StatusFormat m_statusFormat;
 
   mutable shared::value_objects::RegexPattern m_regexPattern;
   mutable bool m_regexPatternValid;
 
+  RequestPlan* m_requestPlan;
+
   static const size_t DEFAULT_CLIENT_BODY_BUFFER_SIZE = 8;
   static const size_t DEFAULT_CLIENT_MAX_BODY_SIZE = 1;
   static const size_t MAX_ALLOWED_CLIENT_BODY_SIZE = 100;
   static const size_t MAX_ALLOWED_BUFFER_SIZE = 10;
+  static const unsigned int DEFAULT_PROXY_TIMEOUT = 60;
 
   void validatePath() const;
   void validateRoot() const;
@@ -202,6 +238,7 @@ class LocationConfig {
   void validateAlias() const;
   void validateClientBodyBufferSize() const;
 
+  void allowDefaultMethods();
   void compileRegexPattern() const;
   bool shouldUseAlias() const;
 
@@ -0,0 +1,192 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RequestPlan.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 02:31:07 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 02:31:07 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "domain/configuration/entities/RequestPlan.hpp"
+
+namespace domain {
+namespace configuration {
+namespace entities {
+
+RequestPlan::RequestPlan()
+    : m_handlerKind(HANDLER_STATIC),
+      m_isRegexLocation(false),
+      m_hasCgi(false),
+      m_isUploadRoute(false),
+      m_allowedMethodMask(http::value_objects::HttpMethod::NO_METHODS),
+      m_maxBodyBytes(0),
+      m_rootKind(ROOT_FALLBACK) {}
+
+RequestPlan::RequestPlan(const LocationConfig& location,
+                         const filesystem::value_objects::Path& serverRoot,
+                         const ErrorPageMap& serverErrorPages)
+    : m_handlerKind(HANDLER_STATIC),
+      m_isRegexLocation(
+          location.getMatchType() ==
+              LocationConfig::MATCH_REGEX_CASE_SENSITIVE ||
+          location.getMatchType() ==
+              LocationConfig::MATCH_REGEX_CASE_INSENSITIVE),
+      m_hasCgi(location.hasCgiConfig()),
+      m_isUploadRoute(location.isUploadRoute()),
+      m_allowedMethodMask(location.getAllowedMethodMask()),
+      m_maxBodyBytes(location.getClientMaxBodySize().getBytes()),
+      m_rootKind(ROOT_FALLBACK),
+      m_locationPath(location.getPath()),
+      m_fallbackRoot(serverRoot),
+      m_indexFiles(location.getIndexFiles()),
+      m_tryFiles(location.getTryFiles()),
+      m_errorPages(serverErrorPages) {
+  if (location.hasReturnRedirect()) {
+    m_handlerKind = HANDLER_REDIRECT;
+  } else if (location.hasReturnContent()) {
+    m_handlerKind = HANDLER_RETURN_CONTENT;
+  } else if (location.hasStatusEndpoint()) {
+    m_handlerKind = HANDLER_STATUS;
+  } else if (location.hasProxyPass()) {
+    m_handlerKind = HANDLER_PROXY;
+  } else if (m_isUploadRoute) {
+    m_handlerKind = HANDLER_UPLOAD;
+  } else if (m_hasCgi) {
+    m_handlerKind = HANDLER_CGI;
+  }
+
+  const LocationConfig::ErrorPageMap& pages = location.getErrorPages();
+  for (LocationConfig::ErrorPageMap::const_iterator it = pages.begin();
+       it != pages.end(); ++it) {
+    m_errorPages[it->first] = it->second;
+  }
+
+  const LocationConfig::CustomHeaderMap& headers = location.getCustomHeaders();
+  m_headers.reserve(headers.size());
+  for (LocationConfig::CustomHeaderMap::const_iterator it = headers.begin();
+       it != headers.end(); ++it) {
+    m_headers.push_back(*it);
+  }
+
+  planRoot(location);
+}
+
+RequestPlan::HandlerKind RequestPlan::getHandlerKind() const {
+  return m_handlerKind;
+}
+
+bool RequestPlan::isRegexLocation() const { return m_isRegexLocation; }
+
+bool RequestPlan::hasCgi() const { return m_hasCgi; }
+
+bool RequestPlan::isUploadRoute() const { return m_isUploadRoute; }
+
+bool RequestPlan::allowsMethod(
+    const http::value_objects::HttpMethod& method) const {
+  return (m_allowedMethodMask & method.toMask()) != 0;
+}
+
+http::value_objects::HttpMethod::MethodMask RequestPlan::getAllowedMethodMask()
+    const {
+  return m_allowedMethodMask;
+}
+
+std::size_t RequestPlan::getMaxBodyBytes() const { return m_maxBodyBytes; }
+
+const std::vector<std::string>& RequestPlan::getIndexFiles() const {
+  return m_indexFiles;
+}
+
+const LocationConfig::TryFiles& RequestPlan::getTryFiles() const {
+  return m_tryFiles;
+}
+
+const RequestPlan::HeaderBlock& RequestPlan::getHeaders() const {
+  return m_headers;
+}
+
+const std::string* RequestPlan::findErrorPage(
+    const shared::value_objects::ErrorCode& code) const {
+  ErrorPageMap::const_iterator it = m_errorPages.find(code);
+  if (it == m_errorPages.end()) {
+    return NULL;
+  }
+  return &it->second;
+}
+
+// May throw for a path the planned root rejects; callers then use
+// resolveFallbackPath(), as the per-request resolution always did.
+filesystem::value_objects::Path RequestPlan::resolvePath(
+    const std::string& requestPath) const {
+  if (m_rootKind == ROOT_ALIAS) {
+    return m_base.join(stripLeadingSlash(
+        requestPath.substr(m_locationPath.length())));
+  }
+  if (m_rootKind == ROOT_BASE) {
+    return m_base.join(stripLeadingSlash(requestPath));
+  }
+  return resolveFallbackPath(requestPath);
+}
+
+filesystem::value_objects::Path RequestPlan::resolveFallbackPath(
+    const std::string& requestPath) const {
+  if (!m_fallbackRoot.isEmpty()) {
+    return m_fallbackRoot.join(stripLeadingSlash(requestPath));
+  }
+  return filesystem::value_objects::Path::fromString(
+      "./" + stripLeadingSlash(requestPath), false);
+}
+
+// Regex locations serve from a literal cgi_root when there is one; other
+// locations use alias or root unless the root is "/" or still holds a
+// pattern. Anything else resolves against the server root.
+void RequestPlan::planRoot(const LocationConfig& location) {
+  if (m_isRegexLocation) {
+    if (!m_hasCgi) {
+      return;
+    }
+    const filesystem::value_objects::Path& cgiRoot =
+        location.getCgiConfig().getCgiRoot();
+    const std::string cgiRootStr = cgiRoot.toString();
+    if (!cgiRoot.isEmpty() && cgiRootStr != "/" &&
+        cgiRootStr.find('\\') == std::string::npos &&
+        cgiRootStr.find('$') == std::string::npos) {
+      m_rootKind = ROOT_BASE;
+      m_base = cgiRoot;
+    }
+    return;
+  }
+
+  const std::string rootStr = location.getRoot().toString();
+  if (looksLikePattern(rootStr) || rootStr == "/") {
+    return;
+  }
+  if (location.hasAlias()) {
+    m_rootKind = ROOT_ALIAS;
+    m_base = location.getAlias();
+  } else {
+    m_rootKind = ROOT_BASE;
+    m_base = location.getRoot();
+  }
+}
+
+bool RequestPlan::looksLikePattern(const std::string& root) {
+  return !root.empty() &&
+         (root[0] == '\\' || root.find('$') != std::string::npos ||
+          root.find('^') != std::string::npos ||
+          root.find('*') != std::string::npos);
+}
+
+std::string RequestPlan::stripLeadingSlash(const std::string& requestPath) {
+  if (!requestPath.empty() && requestPath[0] == '/') {
+    return requestPath.substr(1);
+  }
+  return requestPath;
+}
+
+}  // namespace entities
+}  // namespace configuration
+}  // namespace domain
@@ -0,0 +1,105 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RequestPlan.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 02:31:07 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 02:31:07 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef REQUEST_PLAN_HPP
+#define REQUEST_PLAN_HPP
+
+#include "domain/configuration/entities/LocationConfig.hpp"
+#include "domain/filesystem/value_objects/Path.hpp"
+#include "domain/http/value_objects/HttpMethod.hpp"
+#include "domain/shared/value_objects/ErrorCode.hpp"
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace domain {
+namespace configuration {
+namespace entities {
+
+// Everything the request path needs from a location, derived once from the
+// LocationConfig and its server when a configuration is published: the
+// handler to dispatch to, the root requests resolve against, the allowed
+// methods as a bitmask, the body limit, and the error pages and add_header
+// block with server values already merged in.
+class RequestPlan {
+ public:
+  enum HandlerKind {
+    HANDLER_REDIRECT,
+    HANDLER_RETURN_CONTENT,
+    HANDLER_STATUS,
+    HANDLER_UPLOAD,
+    HANDLER_CGI,
+    HANDLER_PROXY,
+    HANDLER_STATIC
+  };
+
+  typedef LocationConfig::ErrorPageMap ErrorPageMap;
+  typedef std::vector<std::pair<std::string, std::string> > HeaderBlock;
+
+  RequestPlan();
+  RequestPlan(const LocationConfig& location,
+              const filesystem::value_objects::Path& serverRoot,
+              const ErrorPageMap& serverErrorPages);
+
+  HandlerKind getHandlerKind() const;
+  bool isRegexLocation() const;
+  bool hasCgi() const;
+  bool isUploadRoute() const;
+
+  bool allowsMethod(const http::value_objects::HttpMethod& method) const;
+  http::value_objects::HttpMethod::MethodMask getAllowedMethodMask() const;
+  std::size_t getMaxBodyBytes() const;
+
+  const std::vector<std::string>& getIndexFiles() const;
+  const LocationConfig::TryFiles& getTryFiles() const;
+  const HeaderBlock& getHeaders() const;
+  const std::string* findErrorPage(
+      const shared::value_objects::ErrorCode& code) const;
+
+  filesystem::value_objects::Path resolvePath(
+      const std::string& requestPath) const;
+  filesystem::value_objects::Path resolveFallbackPath(
+      const std::string& requestPath) const;
+
+ private:
+  enum RootKind { ROOT_BASE, ROOT_ALIAS, ROOT_FALLBACK };
+
+  HandlerKind m_handlerKind;
+  bool m_isRegexLocation;
+  bool m_hasCgi;
+  bool m_isUploadRoute;
+  http::value_objects::HttpMethod::MethodMask m_allowedMethodMask;
+  std::size_t m_maxBodyBytes;
+
+  RootKind m_rootKind;
+  std::string m_locationPath;
+  filesystem::value_objects::Path m_base;
+  filesystem::value_objects::Path m_fallbackRoot;
+
+  std::vector<std::string> m_indexFiles;
+  LocationConfig::TryFiles m_tryFiles;
+  HeaderBlock m_headers;
+  ErrorPageMap m_errorPages;
+
+  void planRoot(const LocationConfig& location);
+
+  static bool looksLikePattern(const std::string& root);
+  static std::string stripLeadingSlash(const std::string& requestPath);
+};
+
+}  // namespace entities
+}  // namespace configuration
+}  // namespace domain
+
+#endif  // REQUEST_PLAN_HPP
@@ -12,6 +12,7 @@
 
 #include "domain/configuration/entities/ServerConfig.hpp"
 #include "domain/configuration/exceptions/ServerConfigException.hpp"
+#include "domain/configuration/exceptions/SslConfigException.hpp"
 #include "domain/shared/utils/StringUtils.hpp"
 
 #include <sstream>
@@ -27,14 +28,28 @@ ServerConfig::ServerConfig()
     : m_root(filesystem::value_objects::Path::fromString(DEFAULT_ROOT, true)),
       m_clientMaxBodySize(filesystem::value_objects::Size::fromMegabytes(
           DEFAULT_CLIENT_MAX_BODY_SIZE_MB)),
-      m_returnCode(shared::value_objects::ErrorCode::ok()) {}
+      m_returnCode(shared::value_objects::ErrorCode::ok()),
+      m_keepaliveTimeout(DEFAULT_KEEPALIVE_TIMEOUT),
+      m_keepaliveRequests(DEFAULT_KEEPALIVE_REQUESTS),
+      m_clientHeaderTimeout(DEFAULT_CLIENT_HEADER_TIMEOUT),
+      m_clientBodyTimeout(DEFAULT_CLIENT_BODY_TIMEOUT),
+      m_sendTimeout(DEFAULT_SEND_TIMEOUT),
+      m_tcpNoDelay(true),
+      m_tcpNoPush(false) {}
 
 ServerConfig::ServerConfig(const ListenDirectives& listenDirectives)
     : m_listenDirectives(listenDirectives),
       m_root(filesystem::value_objects::Path::fromString(DEFAULT_ROOT, true)),
       m_clientMaxBodySize(filesystem::value_objects::Size::fromMegabytes(
           DEFAULT_CLIENT_MAX_BODY_SIZE_MB)),
-      m_returnCode(shared::value_objects::ErrorCode::ok()) {}
+      m_returnCode(shared::value_objects::ErrorCode::ok()),
+      m_keepaliveTimeout(DEFAULT_KEEPALIVE_TIMEOUT),
+      m_keepaliveRequests(DEFAULT_KEEPALIVE_REQUESTS),
+      m_clientHeaderTimeout(DEFAULT_CLIENT_HEADER_TIMEOUT),
+      m_clientBodyTimeout(DEFAULT_CLIENT_BODY_TIMEOUT),
+      m_sendTimeout(DEFAULT_SEND_TIMEOUT),
+      m_tcpNoDelay(true),
+      m_tcpNoPush(false) {}
 
 ServerConfig::ServerConfig(const ServerConfig& other) { copyFrom(other); }
 
@@ -57,6 +72,14 @@ void ServerConfig::copyFrom(const ServerConfig& other) {
   m_clientMaxBodySize = other.m_clientMaxBodySize;
   m_returnRedirect = other.m_returnRedirect;
   m_returnCode = other.m_returnCode;
+  m_keepaliveTimeout = other.m_keepaliveTimeout;
+  m_keepaliveRequests = other.m_keepaliveRequests;
+  m_clientHeaderTimeout = other.m_clientHeaderTimeout;
+  m_clientBodyTimeout = other.m_clientBodyTimeout;
+  m_sendTimeout = other.m_sendTimeout;
+  m_tcpNoDelay = other.m_tcpNoDelay;
+  m_tcpNoPush = other.m_tcpNoPush;
+  m_ssl = other.m_ssl;
 
   for (std::size_t i = 0; i < other.m_locations.size(); ++i) {
     if (other.m_locations[i] != NULL) {
@@ -110,6 +133,42 @@ const shared::value_objects::ErrorCode& ServerConfig::getReturnCode() const {
   return m_returnCode;
 }
 
+unsigned int ServerConfig::getKeepaliveTimeout() const {
+  return m_keepaliveTimeout;
+}
+
+unsigned int ServerConfig::getKeepaliveRequests() const {
+  return m_keepaliveRequests;
+}
+
+unsigned int ServerConfig::getClientHeaderTimeout() const {
+  return m_clientHeaderTimeout;
+}
+
+unsigned int ServerConfig::getClientBodyTimeout() const {
+  return m_clientBodyTimeout;
+}
+
+unsigned int ServerConfig::getSendTimeout() const { return m_sendTimeout; }
+
+bool ServerConfig::isTcpNoDelay() const { return m_tcpNoDelay; }
+
+bool ServerConfig::isTcpNoPush() const { return m_tcpNoPush; }
+
+const value_objects::SslConfig& ServerConfig::getSslConfig() const {
+  return m_ssl;
+}
+
+bool ServerConfig::hasSslListen() const {
+  for (ListenDirectives::const_iterator it = m_listenDirectives.begin();
+       it != m_listenDirectives.end(); ++it) {
+    if (it->isSsl()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool ServerConfig::isDefaultServer() const {
   for (std::size_t i = 0; i < m_listenDirectives.size(); ++i) {
     if (m_listenDirectives[i].isWildcard() || m_serverNames.empty()) {
@@ -156,9 +215,18 @@ void ServerConfig::addListenDirective(const ListenDirective& directive) {
 }
 
 void ServerConfig::addListenDirective(const std::string& directiveString) {
+  addListenDirective(directiveString, std::vector<std::string>());
+}
+
+void ServerConfig::addListenDirective(
+    const std::string& directiveString,
+    const std::vector<std::string>& parameters) {
   try {
     std::string normalized = normalizeListenDirective(directiveString);
     ListenDirective directive = ListenDirective::fromString(normalized);
+    for (std::size_t i = 0; i < parameters.size(); ++i) {
+      directive.applyParameter(parameters[i]);
+    }
     addListenDirective(directive);
   } catch (const std::exception& e) {
     std::ostringstream oss;
@@ -332,6 +400,57 @@ void ServerConfig::setClientMaxBodySize(const std::string& sizeString) {
   }
 }
 
+void ServerConfig::setKeepaliveTimeout(unsigned int timeout) {
+  validateTimeout("keepalive timeout", timeout);
+  m_keepaliveTimeout = timeout;
+}
+
+void ServerConfig::setKeepaliveRequests(unsigned int requests) {
+  if (requests == 0 || requests > MAX_KEEPALIVE_REQUESTS) {
+    std::ostringstream oss;
+    oss << "Invalid keepalive requests: " << requests << " (must be between 1 "
+        << "and " << MAX_KEEPALIVE_REQUESTS << ")";
+    throw exceptions::ServerConfigException(
+        oss.str(),
+        exceptions::ServerConfigException::INVALID_KEEPALIVE_REQUESTS);
+  }
+  m_keepaliveRequests = requests;
+}
+
+void ServerConfig::setClientHeaderTimeout(unsigned int timeout) {
+  validateTimeout("client header timeout", timeout);
+  m_clientHeaderTimeout = timeout;
+}
+
+void ServerConfig::setClientBodyTimeout(unsigned int timeout) {
+  validateTimeout("client body timeout", timeout);
+  m_clientBodyTimeout = timeout;
+}
+
+void ServerConfig::setSendTimeout(unsigned int timeout) {
+  validateTimeout("send timeout", timeout);
+  m_sendTimeout = timeout;
+}
+
+void ServerConfig::setTcpNoDelay(bool enabled) { m_tcpNoDelay = enabled; }
+
+void ServerConfig::setTcpNoPush(bool enabled) { m_tcpNoPush = enabled; }
+
+void ServerConfig::setSslConfig(const value_objects::SslConfig& ssl) {
+  m_ssl = ssl;
+}
+
+void ServerConfig::validateTimeout(const std::string& name,
+                                   unsigned int timeout) {
+  if (timeout > MAX_TIMEOUT) {
+    std::ostringstream oss;
+    oss << "Invalid " << name << ": " << timeout << " (must be between 0 and "
+        << MAX_TIMEOUT << " seconds)";
+    throw exceptions::ServerConfigException(
+        oss.str(), exceptions::ServerConfigException::INVALID_TIMEOUT);
+  }
+}
+
 void ServerConfig::setReturnRedirect(
     const std::string& redirect, const shared::value_objects::ErrorCode& code) {
   std::string trimmedRedirect = shared::utils::StringUtils::trim(redirect);
@@ -436,6 +555,7 @@ void ServerConfig::validate() const {
   validateErrorPages();
   validateLocations();
   validateClientMaxBodySize();
+  validateSsl();
 
   if (m_locations.empty() && m_root.isEmpty() && m_returnRedirect.empty()) {
     throw exceptions::ServerConfigException(
@@ -444,6 +564,17 @@ void ServerConfig::validate() const {
   }
 }
 
+// As in nginx, an "ssl" listen needs a certificate in every server using
+// that listen; the files themselves are loaded when the listener opens.
+void ServerConfig::validateSsl() const {
+  m_ssl.validate();
+  if (hasSslListen() && !m_ssl.isConfigured()) {
+    throw exceptions::SslConfigException(
+        "no ssl_certificate is defined for a listen ... ssl directive",
+        exceptions::SslConfigException::MISSING_CERTIFICATE);
+  }
+}
+
 void ServerConfig::validateListenDirectives() const {
   if (m_listenDirectives.empty()) {
     throw exceptions::ServerConfigException(
@@ -597,6 +728,14 @@ const LocationConfig* ServerConfig::findLocation(
   return bestMatch;
 }
 
+void ServerConfig::compileRequestPlans() {
+  for (std::size_t i = 0; i < m_locations.size(); ++i) {
+    if (m_locations[i] != NULL) {
+      m_locations[i]->compileRequestPlan(m_root, m_errorPages);
+    }
+  }
+}
+
 bool ServerConfig::hasListenDirective(const std::string& address,
                                       unsigned int port) const {
   http::value_objects::Port portObj(port);
@@ -645,6 +784,14 @@ void ServerConfig::clear() {
       DEFAULT_CLIENT_MAX_BODY_SIZE_MB);
   m_returnRedirect.clear();
   m_returnCode = shared::value_objects::ErrorCode::ok();
+  m_keepaliveTimeout = DEFAULT_KEEPALIVE_TIMEOUT;
+  m_keepaliveRequests = DEFAULT_KEEPALIVE_REQUESTS;
+  m_clientHeaderTimeout = DEFAULT_CLIENT_HEADER_TIMEOUT;
+  m_clientBodyTimeout = DEFAULT_CLIENT_BODY_TIMEOUT;
+  m_sendTimeout = DEFAULT_SEND_TIMEOUT;
+  m_tcpNoDelay = true;
+  m_tcpNoPush = false;
+  m_ssl = value_objects::SslConfig();
 }
 
 std::string ServerConfig::toString() const {
@@ -670,6 +817,16 @@ std::string ServerConfig::toString() const {
   }
   oss << "\n";
   oss << "  ClientMaxBodySize: " << m_clientMaxBodySize.toString() << "\n";
+  oss << "  KeepaliveTimeout: " << m_keepaliveTimeout << "s\n";
+  oss << "  KeepaliveRequests: " << m_keepaliveRequests << "\n";
+  oss << "  ClientHeaderTimeout: " << m_clientHeaderTimeout << "s\n";
+  oss << "  ClientBodyTimeout: " << m_clientBodyTimeout << "s\n";
+  oss << "  SendTimeout: " << m_sendTimeout << "s\n";
+  oss << "  TcpNoDelay: " << (m_tcpNoDelay ? "on" : "off") << "\n";
+  oss << "  TcpNoPush: " << (m_tcpNoPush ? "on" : "off") << "\n";
+  if (m_ssl.isConfigured()) {
+    oss << "  SslCertificate: " << m_ssl.getCertificate() << "\n";
+  }
   if (hasReturnRedirect()) {
     oss << "  ReturnRedirect: " << m_returnCode.getValue() << " -> '"
         << m_returnRedirect << "'\n";
@@ -743,6 +900,80 @@ bool ServerConfig::matchesServerName(const std::string& configName,
   return false;
 }
 
+void ServerConfig::serialize(shared::utils::BinaryWriter& writer) const {
+  writer.writeSize(m_listenDirectives.size());
+  for (ListenDirectives::const_iterator it = m_listenDirectives.begin();
+       it != m_listenDirectives.end(); ++it) {
+    it->serialize(writer);
+  }
+  writer.writeStrings(m_serverNames);
+  m_root.serialize(writer);
+  writer.writeStrings(m_indexFiles);
+  writer.writeSize(m_errorPages.size());
+  for (ErrorPageMap::const_iterator it = m_errorPages.begin();
+       it != m_errorPages.end(); ++it) {
+    writer.writeU32(it->first.getValue());
+    writer.writeString(it->second);
+  }
+  writer.writeSize(m_locations.size());
+  for (Locations::const_iterator it = m_locations.begin();
+       it != m_locations.end(); ++it) {
+    (*it)->serialize(writer);
+  }
+  writer.writeSize(m_clientMaxBodySize.getBytes());
+  writer.writeString(m_returnRedirect);
+  writer.writeU32(m_returnCode.getValue());
+  writer.writeString(m_returnContent);
+  writer.writeU32(m_keepaliveTimeout);
+  writer.writeU32(m_keepaliveRequests);
+  writer.writeU32(m_clientHeaderTimeout);
+  writer.writeU32(m_clientBodyTimeout);
+  writer.writeU32(m_sendTimeout);
+  writer.writeBool(m_tcpNoDelay);
+  writer.writeBool(m_tcpNoPush);
+  m_ssl.serialize(writer);
+}
+
+void ServerConfig::deserialize(shared::utils::BinaryReader& reader) {
+  m_listenDirectives.clear();
+  const std::size_t listenCount = reader.readSize();
+  for (std::size_t i = 0; i < listenCount; ++i) {
+    ListenDirective directive;
+    directive.deserialize(reader);
+    m_listenDirectives.push_back(directive);
+  }
+  m_serverNames = reader.readStrings();
+  m_root.deserialize(reader);
+  m_indexFiles = reader.readStrings();
+  m_errorPages.clear();
+  const std::size_t pageCount = reader.readSize();
+  for (std::size_t i = 0; i < pageCount; ++i) {
+    const shared::value_objects::ErrorCode code(
+        static_cast<unsigned int>(reader.readU32()));
+    m_errorPages[code] = reader.readString();
+  }
+  clearLocations();
+  const std::size_t locationCount = reader.readSize();
+  for (std::size_t i = 0; i < locationCount; ++i) {
+    LocationConfig* location = new LocationConfig();
+    m_locations.push_back(location);
+    location->deserialize(reader);
+  }
+  m_clientMaxBodySize = filesystem::value_objects::Size(reader.readSize());
+  m_returnRedirect = reader.readString();
+  m_returnCode = shared::value_objects::ErrorCode(
+      static_cast<unsigned int>(reader.readU32()));
+  m_returnContent = reader.readString();
+  m_keepaliveTimeout = static_cast<unsigned int>(reader.readU32());
+  m_keepaliveRequests = static_cast<unsigned int>(reader.readU32());
+  m_clientHeaderTimeout = static_cast<unsigned int>(reader.readU32());
+  m_clientBodyTimeout = static_cast<unsigned int>(reader.readU32());
+  m_sendTimeout = static_cast<unsigned int>(reader.readU32());
+  m_tcpNoDelay = reader.readBool();
+  m_tcpNoPush = reader.readBool();
+  m_ssl.deserialize(reader);
+}
+
 }  // namespace entities
 }  // namespace configuration
 }  // namespace domain
@@ -15,10 +15,13 @@
 
 #include "domain/configuration/entities/LocationConfig.hpp"
 #include "domain/configuration/value_objects/ListenDirective.hpp"
+#include "domain/configuration/value_objects/SslConfig.hpp"
 #include "domain/filesystem/value_objects/Path.hpp"
 #include "domain/filesystem/value_objects/Size.hpp"
 #include "domain/http/value_objects/Host.hpp"
 #include "domain/http/value_objects/Port.hpp"
+#include "domain/shared/utils/BinaryReader.hpp"
+#include "domain/shared/utils/BinaryWriter.hpp"
 #include "domain/shared/value_objects/ErrorCode.hpp"
 
 #include <map>
@@ -38,6 +41,13 @@ class ServerConfig {
 
   static const std::size_t DEFAULT_CLIENT_MAX_BODY_SIZE_MB = 1;
   static const std::size_t MAX_CLIENT_MAX_BODY_SIZE_MB = 10;
+  static const unsigned int DEFAULT_KEEPALIVE_TIMEOUT = 75;
+  static const unsigned int DEFAULT_KEEPALIVE_REQUESTS = 1000;
+  static const unsigned int DEFAULT_CLIENT_HEADER_TIMEOUT = 60;
+  static const unsigned int DEFAULT_CLIENT_BODY_TIMEOUT = 60;
+  static const unsigned int DEFAULT_SEND_TIMEOUT = 60;
+  static const unsigned int MAX_TIMEOUT = 300;
+  static const unsigned int MAX_KEEPALIVE_REQUESTS = 100000;
   static const std::string DEFAULT_ROOT;
   static const std::string DEFAULT_INDEX;
 
@@ -57,10 +67,21 @@ class ServerConfig {
   const filesystem::value_objects::Size& getClientMaxBodySize() const;
   const std::string& getReturnRedirect() const;
   const shared::value_objects::ErrorCode& getReturnCode() const;
+  unsigned int getKeepaliveTimeout() const;
+  unsigned int getKeepaliveRequests() const;
+  unsigned int getClientHeaderTimeout() const;
+  unsigned int getClientBodyTimeout() const;
+  unsigned int getSendTimeout() const;
+  bool isTcpNoDelay() const;
+  bool isTcpNoPush() const;
+  const value_objects::SslConfig& getSslConfig() const;
+  bool hasSslListen() const;
   bool isDefaultServer() const;
 
   void addListenDirective(const ListenDirective& directive);
   void addListenDirective(const std::string& directiveString);
+  void addListenDirective(const std::string& directiveString,
+                          const std::vector<std::string>& parameters);
   void addServerName(const std::string& name);
   void setRoot(const filesystem::value_objects::Path& root);
   void setRoot(const std::string& root);
@@ -70,6 +91,14 @@ class ServerConfig {
   void addLocation(LocationConfig* location);
   void setClientMaxBodySize(const filesystem::value_objects::Size& size);
   void setClientMaxBodySize(const std::string& sizeString);
+  void setKeepaliveTimeout(unsigned int timeout);
+  void setKeepaliveRequests(unsigned int requests);
+  void setClientHeaderTimeout(unsigned int timeout);
+  void setClientBodyTimeout(unsigned int timeout);
+  void setSendTimeout(unsigned int timeout);
+  void setTcpNoDelay(bool enabled);
+  void setTcpNoPush(bool enabled);
+  void setSslConfig(const value_objects::SslConfig& ssl);
   void setReturnRedirect(const std::string& redirect,
                          const shared::value_objects::ErrorCode& code);
   void setReturnRedirect(const std::string& redirect, unsigned int code);
@@ -87,16 +116,24 @@ class ServerConfig {
   bool matchesRequest(const http::value_objects::Host& host,
                       const http::value_objects::Port& port) const;
   const LocationConfig* findLocation(const std::string& uriPath) const;
+  void compileRequestPlans();
   bool hasListenDirective(const std::string& address, unsigned int port) const;
   bool hasListenDirective(const http::value_objects::Host& host,
                           const http::value_objects::Port& port) const;
 
+  static bool isWildcardServerName(const std::string& name);
+  static bool matchesServerName(const std::string& configName,
+                                const std::string& requestName);
+
   void setListenDirectives(const std::vector<std::string>& directives);
   void setListenDirectives(const ListenDirectives& directives);
 
   void clear();
   std::string toString() const;
 
+  void serialize(shared::utils::BinaryWriter& writer) const;
+  void deserialize(shared::utils::BinaryReader& reader);
+
  private:
   ListenDirectives m_listenDirectives;
   ServerNames m_serverNames;
@@ -108,6 +145,14 @@ class ServerConfig {
   std::string m_returnRedirect;
   shared::value_objects::ErrorCode m_returnCode;
   std::string m_returnContent;
+  unsigned int m_keepaliveTimeout;
+  unsigned int m_keepaliveRequests;
+  unsigned int m_clientHeaderTimeout;
+  unsigned int m_clientBodyTimeout;
+  unsigned int m_sendTimeout;
+  bool m_tcpNoDelay;
+  bool m_tcpNoPush;
+  value_objects::SslConfig m_ssl;
 
   void copyFrom(const ServerConfig& other);
   void clearLocations();
@@ -118,12 +163,11 @@ class ServerConfig {
   void validateErrorPages() const;
   void validateLocations() const;
   void validateClientMaxBodySize() const;
+  void validateSsl() const;
 
   static std::string normalizeListenDirective(const std::string& directive);
+  static void validateTimeout(const std::string& name, unsigned int timeout);
   static bool isValidServerName(const std::string& name);
-  static bool isWildcardServerName(const std::string& name);
-  static bool matchesServerName(const std::string& configName,
-                                const std::string& requestName);
 };
 
 }  // namespace entities
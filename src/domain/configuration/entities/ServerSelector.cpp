@@ -0,0 +1,282 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ServerSelector.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 01:18:52 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 01:18:52 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "domain/configuration/entities/ServerSelector.hpp"
+
+namespace domain {
+namespace configuration {
+namespace entities {
+
+namespace {
+
+const std::size_t K_FNV_OFFSET_BASIS = 2166136261u;
+const std::size_t K_FNV_PRIME = 16777619u;
+const unsigned int K_BYTE_MASK = 0xFFu;
+
+}  // namespace
+
+const std::size_t ServerSelector::MIN_CAPACITY;
+const std::size_t ServerSelector::MAX_CACHED_HOSTS;
+
+ServerSelector::ServerSelector() : m_count(0), m_built(false) {}
+
+ServerSelector::~ServerSelector() {}
+
+void ServerSelector::build(const std::vector<ServerConfig*>& servers) {
+  build(std::vector<const ServerConfig*>(servers.begin(), servers.end()));
+}
+
+// Selection follows HttpConfig's scan: on each binding the first non-default
+// server whose name matches wins, otherwise the last matching default one.
+void ServerSelector::build(const std::vector<const ServerConfig*>& servers) {
+  clear();
+
+  for (std::size_t i = 0; i < servers.size(); ++i) {
+    if (servers[i] == NULL) {
+      continue;
+    }
+
+    Candidate candidate;
+    candidate.server = servers[i];
+    candidate.isDefault = servers[i]->isDefaultServer();
+    const ServerConfig::ServerNames& names = servers[i]->getServerNames();
+    for (std::size_t j = 0; j < names.size(); ++j) {
+      candidate.names.push_back(toLower(names[j]));
+    }
+
+    std::vector<Binding> seen;
+    const ServerConfig::ListenDirectives& listens =
+        servers[i]->getListenDirectives();
+    for (std::size_t j = 0; j < listens.size(); ++j) {
+      const unsigned int port = listens[j].getPort().getValue();
+      addCandidate(Binding("", port), candidate, seen);
+      addCandidate(Binding(listens[j].getHost().getValue(), port), candidate,
+                   seen);
+    }
+  }
+
+  for (BindingMap::iterator it = m_bindings.begin(); it != m_bindings.end();
+       ++it) {
+    BindingRoutes& routes = it->second;
+    routes.hasWildcardNames = false;
+    for (std::size_t i = 0; i < routes.candidates.size(); ++i) {
+      const std::vector<std::string>& names = routes.candidates[i].names;
+      for (std::size_t j = 0; j < names.size(); ++j) {
+        if (ServerConfig::isWildcardServerName(names[j])) {
+          routes.hasWildcardNames = true;
+        } else if (m_count == 0 ||
+                   m_slots[probe(it->first, names[j].data(), names[j].size())]
+                           .server == NULL) {
+          addRoute(it->first, names[j], resolve(routes, names[j]));
+        }
+      }
+    }
+    routes.unmatchedHost = resolve(routes, "");
+  }
+
+  m_built = true;
+}
+
+void ServerSelector::clear() {
+  m_bindings.clear();
+  m_slots.clear();
+  m_count = 0;
+  m_built = false;
+}
+
+bool ServerSelector::isBuilt() const { return m_built; }
+
+const ServerConfig* ServerSelector::select(const std::string& host,
+                                           unsigned int port) const {
+  return select(host, "", port);
+}
+
+const ServerConfig* ServerSelector::select(const std::string& host,
+                                           const std::string& address,
+                                           unsigned int port) const {
+  const Binding binding(address, port);
+  if (m_count != 0) {
+    const Route& route = m_slots[probe(binding, host.data(), host.size())];
+    if (route.server != NULL) {
+      return route.server;
+    }
+  }
+
+  BindingMap::const_iterator entry = m_bindings.find(binding);
+  if (entry == m_bindings.end()) {
+    return NULL;
+  }
+
+  const BindingRoutes& routes = entry->second;
+  if (!routes.hasWildcardNames) {
+    return routes.unmatchedHost;
+  }
+
+  const std::string folded = toLower(host);
+  std::map<std::string, const ServerConfig*>::const_iterator cached =
+      routes.wildcardCache.find(folded);
+  if (cached != routes.wildcardCache.end()) {
+    return cached->second;
+  }
+
+  if (routes.wildcardCache.size() >= MAX_CACHED_HOSTS) {
+    routes.wildcardCache.clear();
+  }
+  const ServerConfig* server = resolve(routes, folded);
+  routes.wildcardCache[folded] = server;
+  return server;
+}
+
+std::size_t ServerSelector::getExactRouteCount() const { return m_count; }
+
+std::size_t ServerSelector::getCachedHostCount() const {
+  std::size_t count = 0;
+  for (BindingMap::const_iterator it = m_bindings.begin();
+       it != m_bindings.end(); ++it) {
+    count += it->second.wildcardCache.size();
+  }
+  return count;
+}
+
+// A server listening twice on one binding is still a single candidate there.
+void ServerSelector::addCandidate(const Binding& binding,
+                                  const Candidate& candidate,
+                                  std::vector<Binding>& seen) {
+  for (std::size_t i = 0; i < seen.size(); ++i) {
+    if (seen[i] == binding) {
+      return;
+    }
+  }
+  seen.push_back(binding);
+  m_bindings[binding].candidates.push_back(candidate);
+}
+
+void ServerSelector::addRoute(const Binding& binding, const std::string& host,
+                              const ServerConfig* server) {
+  if (server == NULL) {
+    return;
+  }
+  if ((m_count + 1) * 2 > m_slots.size()) {
+    grow();
+  }
+
+  Route& route = m_slots[probe(binding, host.data(), host.size())];
+  route.binding = binding;
+  route.host = host;
+  route.server = server;
+  ++m_count;
+}
+
+// Linear probing over a table kept at most half full, as in MimeTypes.
+std::size_t ServerSelector::probe(const Binding& binding, const char* host,
+                                  std::size_t length) const {
+  const std::size_t mask = m_slots.size() - 1;
+  std::size_t index = hash(binding, host, length) & mask;
+
+  while (m_slots[index].server != NULL &&
+         (m_slots[index].binding != binding ||
+          !equalsFolded(m_slots[index].host, host, length))) {
+    index = (index + 1) & mask;
+  }
+  return index;
+}
+
+void ServerSelector::grow() {
+  std::vector<Route> previous;
+  previous.swap(m_slots);
+
+  const std::size_t capacity =
+      previous.empty() ? MIN_CAPACITY : previous.size() * 2;
+  m_slots.resize(capacity);
+
+  for (std::size_t i = 0; i < previous.size(); ++i) {
+    if (previous[i].server == NULL) {
+      continue;
+    }
+    Route& route = m_slots[probe(previous[i].binding, previous[i].host.data(),
+                                 previous[i].host.size())];
+    route.binding.first.swap(previous[i].binding.first);
+    route.binding.second = previous[i].binding.second;
+    route.host.swap(previous[i].host);
+    route.server = previous[i].server;
+  }
+}
+
+const ServerConfig* ServerSelector::resolve(const BindingRoutes& routes,
+                                            const std::string& host) {
+  const ServerConfig* defaultServer = NULL;
+
+  for (std::size_t i = 0; i < routes.candidates.size(); ++i) {
+    const Candidate& candidate = routes.candidates[i];
+    bool matches = candidate.names.empty();
+    for (std::size_t j = 0; j < candidate.names.size() && !matches; ++j) {
+      matches = ServerConfig::matchesServerName(candidate.names[j], host);
+    }
+    if (!matches) {
+      continue;
+    }
+    if (!candidate.isDefault) {
+      return candidate.server;
+    }
+    defaultServer = candidate.server;
+  }
+  return defaultServer;
+}
+
+std::size_t ServerSelector::hash(const Binding& binding, const char* host,
+                                 std::size_t length) {
+  std::size_t value = K_FNV_OFFSET_BASIS;
+  const std::string& address = binding.first;
+  for (std::size_t i = 0; i < address.size(); ++i) {
+    value ^= static_cast<unsigned char>(address[i]);
+    value *= K_FNV_PRIME;
+  }
+  for (int shift = 0; shift < 32; shift += 8) {
+    value ^= (binding.second >> shift) & K_BYTE_MASK;
+    value *= K_FNV_PRIME;
+  }
+  for (std::size_t i = 0; i < length; ++i) {
+    value ^= static_cast<unsigned char>(toLower(host[i]));
+    value *= K_FNV_PRIME;
+  }
+  return value;
+}
+
+bool ServerSelector::equalsFolded(const std::string& stored, const char* host,
+                                  std::size_t length) {
+  if (stored.size() != length) {
+    return false;
+  }
+  for (std::size_t i = 0; i < length; ++i) {
+    if (stored[i] != toLower(host[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string ServerSelector::toLower(const std::string& value) {
+  std::string folded(value);
+  for (std::size_t i = 0; i < folded.size(); ++i) {
+    folded[i] = toLower(folded[i]);
+  }
+  return folded;
+}
+
+char ServerSelector::toLower(char chr) {
+  return (chr >= 'A' && chr <= 'Z') ? static_cast<char>(chr - 'A' + 'a')
+                                    : chr;
+}
+
+}  // namespace entities
+}  // namespace configuration
+}  // namespace domain
@@ -0,0 +1,113 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ServerSelector.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 01:18:52 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 01:18:52 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef SERVER_SELECTOR_HPP
+#define SERVER_SELECTOR_HPP
+
+#include "domain/configuration/entities/ServerConfig.hpp"
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace domain {
+namespace configuration {
+namespace entities {
+
+// (listen address, port, Host) -> ServerConfig routing table, built once
+// when a configuration is published. A connection only sees the servers
+// whose listen directive names the socket that accepted it; the port-only
+// lookup pools every address on the port. Every exact server_name is
+// resolved ahead of time into an open-addressing table probed with the host
+// folded to lowercase while it is hashed; a host no name matches gets the
+// binding's precomputed default. Only bindings with wildcard names
+// ("*.example.com", "_") scan the servers, and those answers are kept in a
+// bounded cache.
+class ServerSelector {
+ public:
+  static const std::size_t MIN_CAPACITY = 16;
+  static const std::size_t MAX_CACHED_HOSTS = 256;
+
+  ServerSelector();
+  ~ServerSelector();
+
+  void build(const std::vector<ServerConfig*>& servers);
+  void build(const std::vector<const ServerConfig*>& servers);
+  void clear();
+  bool isBuilt() const;
+
+  const ServerConfig* select(const std::string& host, unsigned int port) const;
+  const ServerConfig* select(const std::string& host,
+                             const std::string& address,
+                             unsigned int port) const;
+
+  std::size_t getExactRouteCount() const;
+  std::size_t getCachedHostCount() const;
+
+ private:
+  ServerSelector(const ServerSelector&);
+  ServerSelector& operator=(const ServerSelector&);
+
+  // An empty address stands for every address the port is bound on.
+  typedef std::pair<std::string, unsigned int> Binding;
+
+  struct Candidate {
+    const ServerConfig* server;
+    std::vector<std::string> names;
+    bool isDefault;
+  };
+
+  struct BindingRoutes {
+    std::vector<Candidate> candidates;
+    const ServerConfig* unmatchedHost;
+    bool hasWildcardNames;
+    mutable std::map<std::string, const ServerConfig*> wildcardCache;
+  };
+
+  struct Route {
+    Binding binding;
+    std::string host;
+    const ServerConfig* server;
+  };
+
+  typedef std::map<Binding, BindingRoutes> BindingMap;
+
+  BindingMap m_bindings;
+  std::vector<Route> m_slots;
+  std::size_t m_count;
+  bool m_built;
+
+  void addCandidate(const Binding& binding, const Candidate& candidate,
+                    std::vector<Binding>& seen);
+  void addRoute(const Binding& binding, const std::string& host,
+                const ServerConfig* server);
+  std::size_t probe(const Binding& binding, const char* host,
+                    std::size_t length) const;
+  void grow();
+
+  static const ServerConfig* resolve(const BindingRoutes& routes,
+                                     const std::string& host);
+  static std::size_t hash(const Binding& binding, const char* host,
+                          std::size_t length);
+  static bool equalsFolded(const std::string& stored, const char* host,
+                           std::size_t length);
+  static std::string toLower(const std::string& value);
+  static char toLower(char chr);
+};
+
+}  // namespace entities
+}  // namespace configuration
+}  // namespace domain
+
+#endif  // SERVER_SELECTOR_HPP
@@ -0,0 +1,74 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CacheConfigException.cpp                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 10:48:12 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 10:48:12 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "domain/configuration/exceptions/CacheConfigException.hpp"
+
+#include <sstream>
+
+namespace domain {
+namespace configuration {
+namespace exceptions {
+
+const std::pair<CacheConfigException::ErrorCode, std::string>
+    CacheConfigException::K_CODE_MSGS[] = {
+        std::make_pair(CacheConfigException::INVALID_ZONE_NAME,
+                       "Invalid cache zone name"),
+        std::make_pair(CacheConfigException::INVALID_PATH,
+                       "Invalid cache path"),
+        std::make_pair(CacheConfigException::INVALID_LEVELS,
+                       "Invalid cache directory levels"),
+        std::make_pair(CacheConfigException::INVALID_PARAMETER,
+                       "Invalid cache parameter"),
+        std::make_pair(CacheConfigException::INVALID_KEY,
+                       "Invalid cache key"),
+        std::make_pair(CacheConfigException::INVALID_VALID_TIME,
+                       "Invalid cache validity"),
+        std::make_pair(CacheConfigException::DUPLICATE_ZONE,
+                       "Duplicate cache zone"),
+        std::make_pair(CacheConfigException::UNKNOWN_ZONE,
+                       "Unknown cache zone")};
+
+CacheConfigException::CacheConfigException(const std::string& msg,
+                                                 ErrorCode code)
+    : BaseException("", static_cast<int>(code)) {
+  std::ostringstream oss;
+  oss << getErrorMsg(code) << ": " << msg;
+  this->m_whatMsg = oss.str();
+}
+
+CacheConfigException::CacheConfigException(
+    const CacheConfigException& other)
+    : BaseException(other) {}
+
+CacheConfigException::~CacheConfigException() throw() {}
+
+CacheConfigException& CacheConfigException::operator=(
+    const CacheConfigException& other) {
+  if (this != &other) {
+    BaseException::operator=(other);
+  }
+  return *this;
+}
+
+std::string CacheConfigException::getErrorMsg(
+    CacheConfigException::ErrorCode code) {
+  for (int i = 0; i < CODE_COUNT; ++i) {
+    if (K_CODE_MSGS[i].first == code) {
+      return K_CODE_MSGS[i].second;
+    }
+  }
+  return "unknown cache configuration error";
+}
+
+}  // namespace exceptions
+}  // namespace configuration
+}  // namespace domain
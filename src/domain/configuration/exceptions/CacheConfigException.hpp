@@ -0,0 +1,52 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CacheConfigException.hpp                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 10:48:12 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 10:48:12 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef CACHE_CONFIG_EXCEPTION_HPP
+#define CACHE_CONFIG_EXCEPTION_HPP
+
+#include "shared/exceptions/BaseException.hpp"
+
+namespace domain {
+namespace configuration {
+namespace exceptions {
+
+class CacheConfigException : public ::shared::exceptions::BaseException {
+ public:
+  enum ErrorCode {
+    INVALID_ZONE_NAME,
+    INVALID_PATH,
+    INVALID_LEVELS,
+    INVALID_PARAMETER,
+    INVALID_KEY,
+    INVALID_VALID_TIME,
+    DUPLICATE_ZONE,
+    UNKNOWN_ZONE,
+    CODE_COUNT
+  };
+
+  explicit CacheConfigException(const std::string& msg, ErrorCode code);
+  CacheConfigException(const CacheConfigException& other);
+  virtual ~CacheConfigException() throw();
+
+  CacheConfigException& operator=(const CacheConfigException& other);
+
+ private:
+  static const std::pair<ErrorCode, std::string> K_CODE_MSGS[];
+
+  static std::string getErrorMsg(ErrorCode code);
+};
+
+}  // namespace exceptions
+}  // namespace configuration
+}  // namespace domain
+
+#endif  // CACHE_CONFIG_EXCEPTION_HPP
@@ -35,7 +35,11 @@ const std::pair<CgiConfigException::ErrorCode, std::string>
         std::make_pair(CgiConfigException::INVALID_CGI_PARAM,
                        "Invalid CGI parameter"),
         std::make_pair(CgiConfigException::MISSING_REQUIRED_PARAMS,
-                       "Missing required CGI parameters")};
+                       "Missing required CGI parameters"),
+        std::make_pair(CgiConfigException::INVALID_FASTCGI_PASS,
+                       "Invalid FastCGI server address"),
+        std::make_pair(CgiConfigException::INVALID_WORKER_POOL,
+                       "Invalid CGI worker pool settings")};
 
 CgiConfigException::CgiConfigException(const std::string& msg, ErrorCode code)
     : BaseException("", static_cast<int>(code)) {
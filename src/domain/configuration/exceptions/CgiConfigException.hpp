@@ -30,6 +30,8 @@ class CgiConfigException : public ::shared::exceptions::BaseException {
     DUPLICATE_CGI_PARAM,
     INVALID_CGI_PARAM,
     MISSING_REQUIRED_PARAMS,
+    INVALID_FASTCGI_PASS,
+    INVALID_WORKER_POOL,
     CODE_COUNT
   };
 
@@ -34,6 +34,9 @@ const std::pair<HttpConfigException::ErrorCode, std::string>
                        "Invalid number of worker connections"),
         std::make_pair(INVALID_KEEPALIVE_TIMEOUT, "Invalid keepalive timeout"),
         std::make_pair(INVALID_SEND_TIMEOUT, "Invalid send timeout"),
+        std::make_pair(INVALID_KEEPALIVE_REQUESTS,
+                       "Invalid keepalive requests"),
+        std::make_pair(INVALID_CLIENT_TIMEOUT, "Invalid client timeout"),
         std::make_pair(INVALID_CLIENT_MAX_BODY_SIZE,
                        "Invalid client max body size"),
         std::make_pair(INVALID_ERROR_LOG_PATH, "Invalid error log path"),
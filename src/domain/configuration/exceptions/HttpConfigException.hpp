@@ -31,6 +31,8 @@ class HttpConfigException : public ::shared::exceptions::BaseException {
     INVALID_WORKER_CONNECTIONS,
     INVALID_KEEPALIVE_TIMEOUT,
     INVALID_SEND_TIMEOUT,
+    INVALID_KEEPALIVE_REQUESTS,
+    INVALID_CLIENT_TIMEOUT,
     INVALID_CLIENT_MAX_BODY_SIZE,
     INVALID_ERROR_LOG_PATH,
     INVALID_ACCESS_LOG_PATH,
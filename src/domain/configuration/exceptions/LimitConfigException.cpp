@@ -0,0 +1,77 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   LimitConfigException.cpp                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:12:04 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:12:04 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "domain/configuration/exceptions/LimitConfigException.hpp"
+
+#include <sstream>
+
+namespace domain {
+namespace configuration {
+namespace exceptions {
+
+const std::pair<LimitConfigException::ErrorCode, std::string>
+    LimitConfigException::K_CODE_MSGS[] = {
+        std::make_pair(LimitConfigException::INVALID_ZONE_NAME,
+                       "Invalid limit zone name"),
+        std::make_pair(LimitConfigException::INVALID_KEY,
+                       "Invalid limit key"),
+        std::make_pair(LimitConfigException::INVALID_SIZE,
+                       "Invalid limit zone size"),
+        std::make_pair(LimitConfigException::INVALID_RATE,
+                       "Invalid request rate"),
+        std::make_pair(LimitConfigException::INVALID_PARAMETER,
+                       "Invalid limit parameter"),
+        std::make_pair(LimitConfigException::INVALID_STATUS,
+                       "Invalid limit status"),
+        std::make_pair(LimitConfigException::DUPLICATE_ZONE,
+                       "Duplicate limit zone"),
+        std::make_pair(LimitConfigException::DUPLICATE_RULE,
+                       "Duplicate limit rule"),
+        std::make_pair(LimitConfigException::UNKNOWN_ZONE,
+                       "Unknown limit zone"),
+        std::make_pair(LimitConfigException::ZONE_TYPE_MISMATCH,
+                       "Limit zone type mismatch")};
+
+LimitConfigException::LimitConfigException(const std::string& msg,
+                                           ErrorCode code)
+    : BaseException("", static_cast<int>(code)) {
+  std::ostringstream oss;
+  oss << getErrorMsg(code) << ": " << msg;
+  this->m_whatMsg = oss.str();
+}
+
+LimitConfigException::LimitConfigException(const LimitConfigException& other)
+    : BaseException(other) {}
+
+LimitConfigException::~LimitConfigException() throw() {}
+
+LimitConfigException& LimitConfigException::operator=(
+    const LimitConfigException& other) {
+  if (this != &other) {
+    BaseException::operator=(other);
+  }
+  return *this;
+}
+
+std::string LimitConfigException::getErrorMsg(
+    LimitConfigException::ErrorCode code) {
+  for (int i = 0; i < CODE_COUNT; ++i) {
+    if (K_CODE_MSGS[i].first == code) {
+      return K_CODE_MSGS[i].second;
+    }
+  }
+  return "unknown limit configuration error";
+}
+
+}  // namespace exceptions
+}  // namespace configuration
+}  // namespace domain
@@ -0,0 +1,54 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   LimitConfigException.hpp                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:12:04 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:12:04 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef LIMIT_CONFIG_EXCEPTION_HPP
+#define LIMIT_CONFIG_EXCEPTION_HPP
+
+#include "shared/exceptions/BaseException.hpp"
+
+namespace domain {
+namespace configuration {
+namespace exceptions {
+
+class LimitConfigException : public ::shared::exceptions::BaseException {
+ public:
+  enum ErrorCode {
+    INVALID_ZONE_NAME,
+    INVALID_KEY,
+    INVALID_SIZE,
+    INVALID_RATE,
+    INVALID_PARAMETER,
+    INVALID_STATUS,
+    DUPLICATE_ZONE,
+    DUPLICATE_RULE,
+    UNKNOWN_ZONE,
+    ZONE_TYPE_MISMATCH,
+    CODE_COUNT
+  };
+
+  explicit LimitConfigException(const std::string& msg, ErrorCode code);
+  LimitConfigException(const LimitConfigException& other);
+  virtual ~LimitConfigException() throw();
+
+  LimitConfigException& operator=(const LimitConfigException& other);
+
+ private:
+  static const std::pair<ErrorCode, std::string> K_CODE_MSGS[];
+
+  static std::string getErrorMsg(ErrorCode code);
+};
+
+}  // namespace exceptions
+}  // namespace configuration
+}  // namespace domain
+
+#endif  // LIMIT_CONFIG_EXCEPTION_HPP
@@ -31,7 +31,9 @@ const std::pair<ListenDirectiveException::ErrorCode, std::string>
         std::make_pair(ListenDirectiveException::EMPTY_STRING,
                        "Listen directive string is empty"),
         std::make_pair(ListenDirectiveException::DUPLICATE_DIRECTIVE,
-                       "Duplicate listen directive detected")};
+                       "Duplicate listen directive detected"),
+        std::make_pair(ListenDirectiveException::INVALID_PARAMETER,
+                       "Invalid listen directive parameter")};
 
 ListenDirectiveException::ListenDirectiveException(const std::string& msg,
                                                    ErrorCode code)
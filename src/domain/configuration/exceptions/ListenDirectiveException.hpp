@@ -28,6 +28,7 @@ class ListenDirectiveException : public ::shared::exceptions::BaseException {
     INVALID_PORT,
     EMPTY_STRING,
     DUPLICATE_DIRECTIVE,
+    INVALID_PARAMETER,
     CODE_COUNT
   };
 
@@ -67,7 +67,9 @@ const std::pair<LocationConfigException::ErrorCode, std::string>
         std::make_pair(LocationConfigException::INVALID_RETURN_CODE,
                        "Invalid return code"),
         std::make_pair(LocationConfigException::RESERVED_HEADER,
-                       "Cannot set reserved HTTP header")};
+                       "Cannot set reserved HTTP header"),
+        std::make_pair(LocationConfigException::INVALID_PROXY_TIMEOUT,
+                       "Invalid proxy timeout")};
 
 LocationConfigException::LocationConfigException(const std::string& msg,
                                                  ErrorCode code)
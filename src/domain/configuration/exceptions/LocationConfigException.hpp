@@ -46,6 +46,7 @@ class LocationConfigException : public ::shared::exceptions::BaseException {
     INVALID_CUSTOM_HEADER,
     INVALID_RETURN_CODE,
     RESERVED_HEADER,
+    INVALID_PROXY_TIMEOUT,
     CODE_COUNT
   };
 
@@ -69,7 +69,11 @@ const std::pair<ServerConfigException::ErrorCode, std::string>
         std::make_pair(ServerConfigException::INVALID_LISTEN_DIRECTIVE_FORMAT,
                        "Invalid listen directive format"),
         std::make_pair(ServerConfigException::LOCATION_VALIDATION_FAILED,
-                       "Location configuration validation failed")};
+                       "Location configuration validation failed"),
+        std::make_pair(ServerConfigException::INVALID_TIMEOUT,
+                       "Invalid timeout value"),
+        std::make_pair(ServerConfigException::INVALID_KEEPALIVE_REQUESTS,
+                       "Invalid keepalive requests value")};
 
 ServerConfigException::ServerConfigException(const std::string& msg,
                                              ErrorCode code)
@@ -47,6 +47,8 @@ class ServerConfigException : public ::shared::exceptions::BaseException {
     MISSING_CONFIGURATION,
     INVALID_LISTEN_DIRECTIVE_FORMAT,
     LOCATION_VALIDATION_FAILED,
+    INVALID_TIMEOUT,
+    INVALID_KEEPALIVE_REQUESTS,
     CODE_COUNT
   };
 
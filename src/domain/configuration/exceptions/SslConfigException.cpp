@@ -0,0 +1,67 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   SslConfigException.cpp                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:21:03 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:21:03 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "domain/configuration/exceptions/SslConfigException.hpp"
+
+#include <sstream>
+
+namespace domain {
+namespace configuration {
+namespace exceptions {
+
+const std::pair<SslConfigException::ErrorCode, std::string>
+    SslConfigException::K_CODE_MSGS[] = {
+        std::make_pair(SslConfigException::INVALID_CERTIFICATE,
+                       "Invalid ssl certificate"),
+        std::make_pair(SslConfigException::INVALID_CERTIFICATE_KEY,
+                       "Invalid ssl certificate key"),
+        std::make_pair(SslConfigException::INVALID_SESSION_CACHE,
+                       "Invalid ssl session cache"),
+        std::make_pair(SslConfigException::INVALID_SESSION_TIMEOUT,
+                       "Invalid ssl session timeout"),
+        std::make_pair(SslConfigException::MISSING_CERTIFICATE,
+                       "Missing ssl certificate")};
+
+SslConfigException::SslConfigException(const std::string& msg,
+                                       ErrorCode code)
+    : BaseException("", static_cast<int>(code)) {
+  std::ostringstream oss;
+  oss << getErrorMsg(code) << ": " << msg;
+  this->m_whatMsg = oss.str();
+}
+
+SslConfigException::SslConfigException(const SslConfigException& other)
+    : BaseException(other) {}
+
+SslConfigException::~SslConfigException() throw() {}
+
+SslConfigException& SslConfigException::operator=(
+    const SslConfigException& other) {
+  if (this != &other) {
+    BaseException::operator=(other);
+  }
+  return *this;
+}
+
+std::string SslConfigException::getErrorMsg(
+    SslConfigException::ErrorCode code) {
+  for (int i = 0; i < CODE_COUNT; ++i) {
+    if (K_CODE_MSGS[i].first == code) {
+      return K_CODE_MSGS[i].second;
+    }
+  }
+  return "unknown ssl configuration error";
+}
+
+}  // namespace exceptions
+}  // namespace configuration
+}  // namespace domain
@@ -0,0 +1,49 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   SslConfigException.hpp                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:21:03 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:21:03 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef SSL_CONFIG_EXCEPTION_HPP
+#define SSL_CONFIG_EXCEPTION_HPP
+
+#include "shared/exceptions/BaseException.hpp"
+
+namespace domain {
+namespace configuration {
+namespace exceptions {
+
+class SslConfigException : public ::shared::exceptions::BaseException {
+ public:
+  enum ErrorCode {
+    INVALID_CERTIFICATE,
+    INVALID_CERTIFICATE_KEY,
+    INVALID_SESSION_CACHE,
+    INVALID_SESSION_TIMEOUT,
+    MISSING_CERTIFICATE,
+    CODE_COUNT
+  };
+
+  explicit SslConfigException(const std::string& msg, ErrorCode code);
+  SslConfigException(const SslConfigException& other);
+  virtual ~SslConfigException() throw();
+
+  SslConfigException& operator=(const SslConfigException& other);
+
+ private:
+  static const std::pair<ErrorCode, std::string> K_CODE_MSGS[];
+
+  static std::string getErrorMsg(ErrorCode code);
+};
+
+}  // namespace exceptions
+}  // namespace configuration
+}  // namespace domain
+
+#endif  // SSL_CONFIG_EXCEPTION_HPP
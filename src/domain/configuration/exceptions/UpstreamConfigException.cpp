@@ -0,0 +1,70 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   UpstreamConfigException.cpp                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 09:12:40 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 09:12:40 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "domain/configuration/exceptions/UpstreamConfigException.hpp"
+
+#include <sstream>
+
+namespace domain {
+namespace configuration {
+namespace exceptions {
+
+const std::pair<UpstreamConfigException::ErrorCode, std::string>
+    UpstreamConfigException::K_CODE_MSGS[] = {
+        std::make_pair(UpstreamConfigException::INVALID_NAME,
+                       "Invalid upstream name"),
+        std::make_pair(UpstreamConfigException::INVALID_SERVER,
+                       "Invalid upstream server address"),
+        std::make_pair(UpstreamConfigException::INVALID_SERVER_PARAMETER,
+                       "Invalid upstream server parameter"),
+        std::make_pair(UpstreamConfigException::NO_SERVERS,
+                       "Upstream has no servers"),
+        std::make_pair(UpstreamConfigException::INVALID_HASH_KEY,
+                       "Invalid upstream hash key"),
+        std::make_pair(UpstreamConfigException::DUPLICATE_UPSTREAM,
+                       "Duplicate upstream")};
+
+UpstreamConfigException::UpstreamConfigException(const std::string& msg,
+                                                 ErrorCode code)
+    : BaseException("", static_cast<int>(code)) {
+  std::ostringstream oss;
+  oss << getErrorMsg(code) << ": " << msg;
+  this->m_whatMsg = oss.str();
+}
+
+UpstreamConfigException::UpstreamConfigException(
+    const UpstreamConfigException& other)
+    : BaseException(other) {}
+
+UpstreamConfigException::~UpstreamConfigException() throw() {}
+
+UpstreamConfigException& UpstreamConfigException::operator=(
+    const UpstreamConfigException& other) {
+  if (this != &other) {
+    BaseException::operator=(other);
+  }
+  return *this;
+}
+
+std::string UpstreamConfigException::getErrorMsg(
+    UpstreamConfigException::ErrorCode code) {
+  for (int i = 0; i < CODE_COUNT; ++i) {
+    if (K_CODE_MSGS[i].first == code) {
+      return K_CODE_MSGS[i].second;
+    }
+  }
+  return "unknown upstream configuration error";
+}
+
+}  // namespace exceptions
+}  // namespace configuration
+}  // namespace domain
@@ -0,0 +1,50 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   UpstreamConfigException.hpp                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 09:12:40 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 09:12:40 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef UPSTREAM_CONFIG_EXCEPTION_HPP
+#define UPSTREAM_CONFIG_EXCEPTION_HPP
+
+#include "shared/exceptions/BaseException.hpp"
+
+namespace domain {
+namespace configuration {
+namespace exceptions {
+
+class UpstreamConfigException : public ::shared::exceptions::BaseException {
+ public:
+  enum ErrorCode {
+    INVALID_NAME,
+    INVALID_SERVER,
+    INVALID_SERVER_PARAMETER,
+    NO_SERVERS,
+    INVALID_HASH_KEY,
+    DUPLICATE_UPSTREAM,
+    CODE_COUNT
+  };
+
+  explicit UpstreamConfigException(const std::string& msg, ErrorCode code);
+  UpstreamConfigException(const UpstreamConfigException& other);
+  virtual ~UpstreamConfigException() throw();
+
+  UpstreamConfigException& operator=(const UpstreamConfigException& other);
+
+ private:
+  static const std::pair<ErrorCode, std::string> K_CODE_MSGS[];
+
+  static std::string getErrorMsg(ErrorCode code);
+};
+
+}  // namespace exceptions
+}  // namespace configuration
+}  // namespace domain
+
+#endif  // UPSTREAM_CONFIG_EXCEPTION_HPP
@@ -0,0 +1,186 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CacheZoneConfig.cpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 10:49:37 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 10:49:37 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "domain/configuration/exceptions/CacheConfigException.hpp"
+#include "domain/configuration/value_objects/CacheZoneConfig.hpp"
+
+#include <cctype>
+#include <sstream>
+
+namespace domain {
+namespace configuration {
+namespace value_objects {
+
+namespace {
+
+const unsigned int K_DEFAULT_LEVELS[] = {1, 2};
+
+}  // namespace
+
+const unsigned int CacheZoneConfig::DEFAULT_INACTIVE;
+const std::size_t CacheZoneConfig::MAX_LEVELS;
+const unsigned int CacheZoneConfig::MAX_LEVEL_WIDTH;
+
+CacheZoneConfig::CacheZoneConfig()
+    : m_levels(K_DEFAULT_LEVELS,
+               K_DEFAULT_LEVELS +
+                   sizeof(K_DEFAULT_LEVELS) / sizeof(K_DEFAULT_LEVELS[0])),
+      m_maxSize(0),
+      m_inactive(DEFAULT_INACTIVE) {}
+
+CacheZoneConfig::CacheZoneConfig(const std::string& name,
+                                 const std::string& path)
+    : m_name(name),
+      m_path(path),
+      m_levels(K_DEFAULT_LEVELS,
+               K_DEFAULT_LEVELS +
+                   sizeof(K_DEFAULT_LEVELS) / sizeof(K_DEFAULT_LEVELS[0])),
+      m_maxSize(0),
+      m_inactive(DEFAULT_INACTIVE) {
+  if (!isValidName(name)) {
+    throw exceptions::CacheConfigException(
+        "'" + name + "'", exceptions::CacheConfigException::INVALID_ZONE_NAME);
+  }
+  if (m_path.empty() || m_path[0] != '/') {
+    throw exceptions::CacheConfigException(
+        "'" + path + "' must be absolute",
+        exceptions::CacheConfigException::INVALID_PATH);
+  }
+  while (m_path.size() > 1 && m_path[m_path.size() - 1] == '/') {
+    m_path.erase(m_path.size() - 1);
+  }
+}
+
+CacheZoneConfig::~CacheZoneConfig() {}
+
+const std::string& CacheZoneConfig::getName() const { return m_name; }
+
+const std::string& CacheZoneConfig::getPath() const { return m_path; }
+
+const CacheZoneConfig::Levels& CacheZoneConfig::getLevels() const {
+  return m_levels;
+}
+
+std::size_t CacheZoneConfig::getMaxSize() const { return m_maxSize; }
+
+unsigned int CacheZoneConfig::getInactive() const { return m_inactive; }
+
+// "1", "1:2" or "1:2:2": one to three directory levels named by one or two
+// hex digits each, taken from the end of the hashed key as nginx does.
+void CacheZoneConfig::setLevels(const std::string& spec) {
+  Levels levels;
+  std::size_t pos = 0;
+  while (pos <= spec.size()) {
+    const std::size_t colon = spec.find(':', pos);
+    const std::string part = spec.substr(
+        pos, colon == std::string::npos ? std::string::npos : colon - pos);
+    if (part.size() != 1 || part[0] < '1' ||
+        part[0] > static_cast<char>('0' + MAX_LEVEL_WIDTH)) {
+      throw exceptions::CacheConfigException(
+          "'" + spec + "'", exceptions::CacheConfigException::INVALID_LEVELS);
+    }
+    levels.push_back(static_cast<unsigned int>(part[0] - '0'));
+    if (colon == std::string::npos) {
+      break;
+    }
+    pos = colon + 1;
+  }
+  if (levels.size() > MAX_LEVELS) {
+    throw exceptions::CacheConfigException(
+        "'" + spec + "' has more than 3 levels",
+        exceptions::CacheConfigException::INVALID_LEVELS);
+  }
+  m_levels = levels;
+}
+
+void CacheZoneConfig::setMaxSize(std::size_t bytes) { m_maxSize = bytes; }
+
+void CacheZoneConfig::setInactive(unsigned int seconds) {
+  if (seconds == 0) {
+    throw exceptions::CacheConfigException(
+        "inactive must be positive",
+        exceptions::CacheConfigException::INVALID_PARAMETER);
+  }
+  m_inactive = seconds;
+}
+
+std::string CacheZoneConfig::formatLevels() const {
+  std::ostringstream oss;
+  for (std::size_t i = 0; i < m_levels.size(); ++i) {
+    oss << (i > 0 ? ":" : "") << m_levels[i];
+  }
+  return oss.str();
+}
+
+void CacheZoneConfig::validate() const {
+  if (!isValidName(m_name)) {
+    throw exceptions::CacheConfigException(
+        "'" + m_name + "'",
+        exceptions::CacheConfigException::INVALID_ZONE_NAME);
+  }
+  if (m_path.empty() || m_path[0] != '/') {
+    throw exceptions::CacheConfigException(
+        "'" + m_path + "' must be absolute",
+        exceptions::CacheConfigException::INVALID_PATH);
+  }
+}
+
+bool CacheZoneConfig::operator==(const CacheZoneConfig& other) const {
+  return m_name == other.m_name && m_path == other.m_path &&
+         m_levels == other.m_levels && m_maxSize == other.m_maxSize &&
+         m_inactive == other.m_inactive;
+}
+
+bool CacheZoneConfig::operator!=(const CacheZoneConfig& other) const {
+  return !(*this == other);
+}
+
+bool CacheZoneConfig::isValidName(const std::string& name) {
+  if (name.empty()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < name.size(); ++i) {
+    const unsigned char c = static_cast<unsigned char>(name[i]);
+    if (!std::isalnum(c) && c != '_' && c != '-') {
+      return false;
+    }
+  }
+  return true;
+}
+
+void CacheZoneConfig::serialize(shared::utils::BinaryWriter& writer) const {
+  writer.writeString(m_name);
+  writer.writeString(m_path);
+  writer.writeSize(m_levels.size());
+  for (Levels::const_iterator it = m_levels.begin(); it != m_levels.end();
+       ++it) {
+    writer.writeU32(*it);
+  }
+  writer.writeSize(m_maxSize);
+  writer.writeU32(m_inactive);
+}
+
+void CacheZoneConfig::deserialize(shared::utils::BinaryReader& reader) {
+  m_name = reader.readString();
+  m_path = reader.readString();
+  m_levels.clear();
+  const std::size_t levelCount = reader.readSize();
+  for (std::size_t i = 0; i < levelCount; ++i) {
+    m_levels.push_back(static_cast<unsigned int>(reader.readU32()));
+  }
+  m_maxSize = reader.readSize();
+  m_inactive = static_cast<unsigned int>(reader.readU32());
+}
+
+}  // namespace value_objects
+}  // namespace configuration
+}  // namespace domain
@@ -0,0 +1,76 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CacheZoneConfig.hpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 10:49:37 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 10:49:37 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef CACHE_ZONE_CONFIG_HPP
+#define CACHE_ZONE_CONFIG_HPP
+
+#include "domain/shared/utils/BinaryReader.hpp"
+#include "domain/shared/utils/BinaryWriter.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace domain {
+namespace configuration {
+namespace value_objects {
+
+// An http-level "proxy_cache_path" zone: where cached responses are stored,
+// how many directory levels the hashed file names are spread over, the size
+// cap the evictor keeps the zone under (0 is unlimited) and how long an
+// entry may go unused before it is dropped.
+class CacheZoneConfig {
+ public:
+  typedef std::vector<unsigned int> Levels;
+
+  static const unsigned int DEFAULT_INACTIVE = 600;
+  static const std::size_t MAX_LEVELS = 3;
+  static const unsigned int MAX_LEVEL_WIDTH = 2;
+
+  CacheZoneConfig();
+  CacheZoneConfig(const std::string& name, const std::string& path);
+  ~CacheZoneConfig();
+
+  const std::string& getName() const;
+  const std::string& getPath() const;
+  const Levels& getLevels() const;
+  std::size_t getMaxSize() const;
+  unsigned int getInactive() const;
+
+  void setLevels(const std::string& spec);
+  void setMaxSize(std::size_t bytes);
+  void setInactive(unsigned int seconds);
+
+  std::string formatLevels() const;
+  void validate() const;
+
+  bool operator==(const CacheZoneConfig& other) const;
+  bool operator!=(const CacheZoneConfig& other) const;
+
+  static bool isValidName(const std::string& name);
+
+  void serialize(shared::utils::BinaryWriter& writer) const;
+  void deserialize(shared::utils::BinaryReader& reader);
+
+ private:
+  std::string m_name;
+  std::string m_path;
+  Levels m_levels;
+  std::size_t m_maxSize;
+  unsigned int m_inactive;
+};
+
+}  // namespace value_objects
+}  // namespace configuration
+}  // namespace domain
+
+#endif  // CACHE_ZONE_CONFIG_HPP
@@ -37,9 +37,14 @@ const std::string CgiConfig::DEFAULT_REMOTE_ADDR = "REMOTE_ADDR";
 const std::string CgiConfig::DEFAULT_REMOTE_PORT = "REMOTE_PORT";
 const std::string CgiConfig::DEFAULT_REQUEST_URI = "REQUEST_URI";
 
+const std::size_t CgiConfig::DEFAULT_WORKER_MAX_REQUESTS;
+const std::size_t CgiConfig::MAX_WORKER_COUNT;
+
 CgiConfig::CgiConfig()
     : m_cgiRoot(filesystem::value_objects::Path::rootDirectory()),
-      m_extensionPattern(shared::value_objects::RegexPattern::phpExtension()) {
+      m_extensionPattern(shared::value_objects::RegexPattern::phpExtension()),
+      m_workerCount(0),
+      m_workerMaxRequests(DEFAULT_WORKER_MAX_REQUESTS) {
   initializeDefaultParameters();
 }
 
@@ -49,7 +54,9 @@ CgiConfig::CgiConfig(
     const shared::value_objects::RegexPattern& extensionPattern)
     : m_scriptPath(normalizeScriptPath(scriptPath)),
       m_cgiRoot(cgiRoot),
-      m_extensionPattern(extensionPattern) {
+      m_extensionPattern(extensionPattern),
+      m_workerCount(0),
+      m_workerMaxRequests(DEFAULT_WORKER_MAX_REQUESTS) {
   if (m_scriptPath.empty()) {
     throw exceptions::CgiConfigException(
         "CGI script path cannot be empty",
@@ -81,6 +88,10 @@ void CgiConfig::copyFrom(const CgiConfig& other) {
   m_cgiRoot = other.m_cgiRoot;
   m_extensionPattern = other.m_extensionPattern;
   m_parameters = other.m_parameters;
+  m_fastcgiPass = other.m_fastcgiPass;
+  m_workerCount = other.m_workerCount;
+  m_workerMaxRequests = other.m_workerMaxRequests;
+  m_workerBootstrap = other.m_workerBootstrap;
 }
 
 const std::string& CgiConfig::getScriptPath() const { return m_scriptPath; }
@@ -110,6 +121,24 @@ bool CgiConfig::hasParameter(const std::string& name) const {
   return m_parameters.find(name) != m_parameters.end();
 }
 
+const std::string& CgiConfig::getFastcgiPass() const { return m_fastcgiPass; }
+
+bool CgiConfig::hasFastcgiPass() const { return !m_fastcgiPass.empty(); }
+
+std::size_t CgiConfig::getWorkerCount() const { return m_workerCount; }
+
+std::size_t CgiConfig::getWorkerMaxRequests() const {
+  return m_workerMaxRequests;
+}
+
+const std::string& CgiConfig::getWorkerBootstrap() const {
+  return m_workerBootstrap;
+}
+
+bool CgiConfig::hasWorkerPool() const {
+  return m_workerCount > 0 && !m_workerBootstrap.empty();
+}
+
 void CgiConfig::setScriptPath(const std::string& scriptPath) {
   std::string normalizedPath = normalizeScriptPath(scriptPath);
 
@@ -205,6 +234,44 @@ void CgiConfig::setParameters(const ParameterMap& parameters) {
   m_parameters = parameters;
 }
 
+void CgiConfig::setFastcgiPass(const std::string& address) {
+  if (!isValidFastcgiAddress(address)) {
+    throw exceptions::CgiConfigException(
+        "FastCGI address must be 'unix:/path' or 'host:port': " + address,
+        exceptions::CgiConfigException::INVALID_FASTCGI_PASS);
+  }
+
+  m_fastcgiPass = address;
+}
+
+void CgiConfig::setWorkerPool(std::size_t count, std::size_t maxRequests) {
+  if (count > MAX_WORKER_COUNT) {
+    std::ostringstream oss;
+    oss << "CGI worker count " << count << " exceeds maximum "
+        << MAX_WORKER_COUNT;
+    throw exceptions::CgiConfigException(
+        oss.str(), exceptions::CgiConfigException::INVALID_WORKER_POOL);
+  }
+  if (maxRequests == 0) {
+    throw exceptions::CgiConfigException(
+        "CGI worker request limit must be positive",
+        exceptions::CgiConfigException::INVALID_WORKER_POOL);
+  }
+
+  m_workerCount = count;
+  m_workerMaxRequests = maxRequests;
+}
+
+void CgiConfig::setWorkerBootstrap(const std::string& bootstrapPath) {
+  if (bootstrapPath.empty()) {
+    throw exceptions::CgiConfigException(
+        "CGI worker bootstrap path cannot be empty",
+        exceptions::CgiConfigException::INVALID_WORKER_POOL);
+  }
+
+  m_workerBootstrap = bootstrapPath;
+}
+
 CgiConfig CgiConfig::createPhpCgi(const std::string& phpBinary) {
   CgiConfig config;
   config.setScriptPath(phpBinary);
@@ -262,6 +329,8 @@ void CgiConfig::validate() const {
 
   validateExtensionPattern();
   validateParameters();
+  validateFastcgiPass();
+  validateWorkerPool();
 
   if (!m_scriptPath.empty()) {
     static const std::string REQUIRED_PARAMS[] = {
@@ -328,6 +397,28 @@ void CgiConfig::validateParameters() const {
   }
 }
 
+void CgiConfig::validateFastcgiPass() const {
+  if (!m_fastcgiPass.empty() && !isValidFastcgiAddress(m_fastcgiPass)) {
+    throw exceptions::CgiConfigException(
+        "Invalid FastCGI address: " + m_fastcgiPass,
+        exceptions::CgiConfigException::INVALID_FASTCGI_PASS);
+  }
+}
+
+void CgiConfig::validateWorkerPool() const {
+  if (m_workerCount > MAX_WORKER_COUNT || m_workerMaxRequests == 0) {
+    throw exceptions::CgiConfigException(
+        "Invalid CGI worker pool settings",
+        exceptions::CgiConfigException::INVALID_WORKER_POOL);
+  }
+
+  if (m_workerCount > 0 && m_scriptPath.empty()) {
+    throw exceptions::CgiConfigException(
+        "CGI worker pool requires an interpreter (script directive)",
+        exceptions::CgiConfigException::INVALID_WORKER_POOL);
+  }
+}
+
 bool CgiConfig::matchesExtension(const std::string& filename) const {
   return m_extensionPattern.matches(filename);
 }
@@ -370,7 +461,11 @@ CgiConfig::ParameterMap CgiConfig::buildEnvironment(
 bool CgiConfig::operator==(const CgiConfig& other) const {
   return m_scriptPath == other.m_scriptPath && m_cgiRoot == other.m_cgiRoot &&
          m_extensionPattern == other.m_extensionPattern &&
-         m_parameters == other.m_parameters;
+         m_parameters == other.m_parameters &&
+         m_fastcgiPass == other.m_fastcgiPass &&
+         m_workerCount == other.m_workerCount &&
+         m_workerMaxRequests == other.m_workerMaxRequests &&
+         m_workerBootstrap == other.m_workerBootstrap;
 }
 
 bool CgiConfig::operator!=(const CgiConfig& other) const {
@@ -382,6 +477,10 @@ void CgiConfig::clear() {
   m_cgiRoot = filesystem::value_objects::Path::rootDirectory();
   m_extensionPattern = shared::value_objects::RegexPattern::phpExtension();
   m_parameters.clear();
+  m_fastcgiPass.clear();
+  m_workerCount = 0;
+  m_workerMaxRequests = DEFAULT_WORKER_MAX_REQUESTS;
+  m_workerBootstrap.clear();
   initializeDefaultParameters();
 }
 
@@ -430,6 +529,33 @@ bool CgiConfig::isValidParameterValue(const std::string& value) {
   return true;
 }
 
+bool CgiConfig::isValidFastcgiAddress(const std::string& address) {
+  static const std::string UNIX_PREFIX = "unix:";
+  static const unsigned long MAX_PORT = 65535;
+
+  if (address.compare(0, UNIX_PREFIX.size(), UNIX_PREFIX) == 0) {
+    return isAbsolutePath(address.substr(UNIX_PREFIX.size()));
+  }
+
+  const std::size_t colonPos = address.rfind(':');
+  if (colonPos == std::string::npos || colonPos == 0 ||
+      colonPos + 1 == address.size()) {
+    return false;
+  }
+
+  unsigned long port = 0;
+  for (std::size_t i = colonPos + 1; i < address.size(); ++i) {
+    if (std::isdigit(static_cast<unsigned char>(address[i])) == 0) {
+      return false;
+    }
+    port = port * 10 + static_cast<unsigned long>(address[i] - '0');
+    if (port > MAX_PORT) {
+      return false;
+    }
+  }
+  return port > 0;
+}
+
 std::string CgiConfig::normalizeScriptPath(const std::string& scriptPath) {
   std::string result = scriptPath;
 
@@ -448,6 +574,33 @@ bool CgiConfig::isAbsolutePath(const std::string& path) {
   return !path.empty() && path[0] == '/';
 }
 
+void CgiConfig::serialize(shared::utils::BinaryWriter& writer) const {
+  writer.writeString(m_scriptPath);
+  m_cgiRoot.serialize(writer);
+  writer.writeString(m_extensionPattern.getPattern());
+  writer.writeU32(static_cast<unsigned long>(m_extensionPattern.getFlags()));
+  writer.writeStringMap(m_parameters);
+  writer.writeString(m_fastcgiPass);
+  writer.writeSize(m_workerCount);
+  writer.writeSize(m_workerMaxRequests);
+  writer.writeString(m_workerBootstrap);
+}
+
+void CgiConfig::deserialize(shared::utils::BinaryReader& reader) {
+  m_scriptPath = reader.readString();
+  m_cgiRoot.deserialize(reader);
+  const std::string pattern = reader.readString();
+  const int flags = static_cast<int>(reader.readU32());
+  m_extensionPattern =
+      pattern.empty() ? shared::value_objects::RegexPattern()
+                      : shared::value_objects::RegexPattern(pattern, flags);
+  m_parameters = reader.readStringMap();
+  m_fastcgiPass = reader.readString();
+  m_workerCount = reader.readSize();
+  m_workerMaxRequests = reader.readSize();
+  m_workerBootstrap = reader.readString();
+}
+
 }  // namespace value_objects
 }  // namespace configuration
 }  // namespace domain
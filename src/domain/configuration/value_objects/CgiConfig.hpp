@@ -14,8 +14,11 @@
 #define CGI_CONFIG_HPP
 
 #include "domain/filesystem/value_objects/Path.hpp"
+#include "domain/shared/utils/BinaryReader.hpp"
+#include "domain/shared/utils/BinaryWriter.hpp"
 #include "domain/shared/value_objects/RegexPattern.hpp"
 
+#include <cstddef>
 #include <map>
 #include <string>
 
@@ -43,6 +46,9 @@ class CgiConfig {
   static const std::string DEFAULT_REMOTE_PORT;
   static const std::string DEFAULT_REQUEST_URI;
 
+  static const std::size_t DEFAULT_WORKER_MAX_REQUESTS = 1000;
+  static const std::size_t MAX_WORKER_COUNT = 64;
+
   CgiConfig();
 
   CgiConfig(const std::string& scriptPath,
@@ -61,6 +67,12 @@ class CgiConfig {
   const ParameterMap& getParameters() const;
   std::string getParameter(const std::string& name) const;
   bool hasParameter(const std::string& name) const;
+  const std::string& getFastcgiPass() const;
+  bool hasFastcgiPass() const;
+  std::size_t getWorkerCount() const;
+  std::size_t getWorkerMaxRequests() const;
+  const std::string& getWorkerBootstrap() const;
+  bool hasWorkerPool() const;
 
   void setScriptPath(const std::string& scriptPath);
   void setCgiRoot(const filesystem::value_objects::Path& cgiRoot);
@@ -68,6 +80,9 @@ class CgiConfig {
   void addParameter(const std::string& name, const std::string& value);
   void removeParameter(const std::string& name);
   void setParameters(const ParameterMap& parameters);
+  void setFastcgiPass(const std::string& address);
+  void setWorkerPool(std::size_t count, std::size_t maxRequests);
+  void setWorkerBootstrap(const std::string& bootstrapPath);
 
   static CgiConfig createPhpCgi(
       const std::string& phpBinary = "/usr/bin/php-cgi");
@@ -89,21 +104,31 @@ class CgiConfig {
 
   void clear();
 
+  void serialize(shared::utils::BinaryWriter& writer) const;
+  void deserialize(shared::utils::BinaryReader& reader);
+
  private:
   std::string m_scriptPath;
   filesystem::value_objects::Path m_cgiRoot;
   shared::value_objects::RegexPattern m_extensionPattern;
   ParameterMap m_parameters;
+  std::string m_fastcgiPass;
+  std::size_t m_workerCount;
+  std::size_t m_workerMaxRequests;
+  std::string m_workerBootstrap;
 
   void copyFrom(const CgiConfig& other);
   void validateScriptPath() const;
   void validateCgiRoot() const;
   void validateExtensionPattern() const;
   void validateParameters() const;
+  void validateFastcgiPass() const;
+  void validateWorkerPool() const;
 
   void initializeDefaultParameters();
   static bool isValidParameterName(const std::string& name);
   static bool isValidParameterValue(const std::string& value);
+  static bool isValidFastcgiAddress(const std::string& address);
 
   static std::string normalizeScriptPath(const std::string& scriptPath);
   static bool isAbsolutePath(const std::string& path);
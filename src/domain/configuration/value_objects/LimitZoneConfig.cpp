@@ -0,0 +1,160 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   LimitZoneConfig.cpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:13:26 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:13:26 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "domain/configuration/exceptions/LimitConfigException.hpp"
+#include "domain/configuration/value_objects/LimitZoneConfig.hpp"
+#include "domain/configuration/value_objects/ProxyCacheConfig.hpp"
+
+#include <cctype>
+#include <sstream>
+
+namespace domain {
+namespace configuration {
+namespace value_objects {
+
+namespace {
+
+const unsigned long K_RATE_SCALE = 1000;
+const unsigned long K_SECONDS_PER_MINUTE = 60;
+const unsigned long K_MAX_RATE = 1000000;
+
+}  // namespace
+
+const std::size_t LimitZoneConfig::MIN_SIZE;
+
+LimitZoneConfig::LimitZoneConfig()
+    : m_type(TYPE_REQUEST), m_size(MIN_SIZE), m_rate(K_RATE_SCALE) {}
+
+LimitZoneConfig::LimitZoneConfig(const std::string& name, Type type,
+                                 const std::string& key, std::size_t size)
+    : m_name(name),
+      m_type(type),
+      m_key(key),
+      m_size(size),
+      m_rate(K_RATE_SCALE) {
+  validate();
+}
+
+LimitZoneConfig::~LimitZoneConfig() {}
+
+const std::string& LimitZoneConfig::getName() const { return m_name; }
+
+LimitZoneConfig::Type LimitZoneConfig::getType() const { return m_type; }
+
+const std::string& LimitZoneConfig::getKey() const { return m_key; }
+
+std::size_t LimitZoneConfig::getSize() const { return m_size; }
+
+unsigned long LimitZoneConfig::getRate() const { return m_rate; }
+
+// "<n>r/s" or "<n>r/m". A per-minute rate keeps its fraction, so "1r/m"
+// leaks one request every sixty seconds rather than rounding to zero.
+void LimitZoneConfig::setRate(const std::string& spec) {
+  if (m_type != TYPE_REQUEST) {
+    throw exceptions::LimitConfigException(
+        "'" + m_name + "' is a connection zone",
+        exceptions::LimitConfigException::INVALID_RATE);
+  }
+  const std::string::size_type suffix = spec.find("r/");
+  if (suffix == 0 || suffix == std::string::npos ||
+      suffix + 3 != spec.size() ||
+      (spec[suffix + 2] != 's' && spec[suffix + 2] != 'm')) {
+    throw exceptions::LimitConfigException(
+        "'" + spec + "'", exceptions::LimitConfigException::INVALID_RATE);
+  }
+
+  unsigned long count = 0;
+  for (std::string::size_type i = 0; i < suffix; ++i) {
+    if (!std::isdigit(static_cast<unsigned char>(spec[i])) ||
+        count > K_MAX_RATE) {
+      throw exceptions::LimitConfigException(
+          "'" + spec + "'", exceptions::LimitConfigException::INVALID_RATE);
+    }
+    count = count * 10 + static_cast<unsigned long>(spec[i] - '0');
+  }
+  unsigned long rate = count * K_RATE_SCALE;
+  if (spec[suffix + 2] == 'm') {
+    rate /= K_SECONDS_PER_MINUTE;
+  }
+  if (rate == 0 || count > K_MAX_RATE) {
+    throw exceptions::LimitConfigException(
+        "'" + spec + "'", exceptions::LimitConfigException::INVALID_RATE);
+  }
+  m_rate = rate;
+}
+
+// The key uses the proxy_cache_key variables; a key that renders empty
+// for a request leaves that request unlimited, as in nginx.
+void LimitZoneConfig::validate() const {
+  if (!isValidName(m_name)) {
+    throw exceptions::LimitConfigException(
+        "'" + m_name + "'",
+        exceptions::LimitConfigException::INVALID_ZONE_NAME);
+  }
+  if (!ProxyCacheConfig::isValidKey(m_key)) {
+    throw exceptions::LimitConfigException(
+        "'" + m_key + "'", exceptions::LimitConfigException::INVALID_KEY);
+  }
+  if (m_size < MIN_SIZE) {
+    std::ostringstream oss;
+    oss << "zone '" << m_name << "' needs at least " << MIN_SIZE << " bytes";
+    throw exceptions::LimitConfigException(
+        oss.str(), exceptions::LimitConfigException::INVALID_SIZE);
+  }
+}
+
+bool LimitZoneConfig::operator==(const LimitZoneConfig& other) const {
+  return m_name == other.m_name && m_type == other.m_type &&
+         m_key == other.m_key && m_size == other.m_size &&
+         m_rate == other.m_rate;
+}
+
+bool LimitZoneConfig::operator!=(const LimitZoneConfig& other) const {
+  return !(*this == other);
+}
+
+bool LimitZoneConfig::isValidName(const std::string& name) {
+  if (name.empty()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < name.size(); ++i) {
+    const unsigned char c = static_cast<unsigned char>(name[i]);
+    if (!std::isalnum(c) && c != '_' && c != '-') {
+      return false;
+    }
+  }
+  return true;
+}
+
+const char* LimitZoneConfig::typeName(Type type) {
+  return type == TYPE_REQUEST ? "limit_req_zone" : "limit_conn_zone";
+}
+
+void LimitZoneConfig::serialize(shared::utils::BinaryWriter& writer) const {
+  writer.writeString(m_name);
+  writer.writeU32(static_cast<unsigned int>(m_type));
+  writer.writeString(m_key);
+  writer.writeSize(m_size);
+  writer.writeU32(m_rate);
+}
+
+void LimitZoneConfig::deserialize(shared::utils::BinaryReader& reader) {
+  m_name = reader.readString();
+  m_type = static_cast<Type>(reader.readU32());
+  m_key = reader.readString();
+  m_size = reader.readSize();
+  m_rate = reader.readU32();
+}
+
+}  // namespace value_objects
+}  // namespace configuration
+}  // namespace domain
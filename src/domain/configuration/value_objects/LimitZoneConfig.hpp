@@ -0,0 +1,72 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   LimitZoneConfig.hpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:13:26 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:13:26 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef LIMIT_ZONE_CONFIG_HPP
+#define LIMIT_ZONE_CONFIG_HPP
+
+#include "domain/shared/utils/BinaryReader.hpp"
+#include "domain/shared/utils/BinaryWriter.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace domain {
+namespace configuration {
+namespace value_objects {
+
+// An http-level "limit_req_zone" or "limit_conn_zone": the key template
+// clients are told apart by, the memory given to the zone's state table
+// and, for request zones, the rate in thousandths of a request per second
+// (nginx's own unit, so "30r/m" is 500).
+class LimitZoneConfig {
+ public:
+  enum Type { TYPE_REQUEST, TYPE_CONNECTION };
+
+  static const std::size_t MIN_SIZE = 32768;
+
+  LimitZoneConfig();
+  LimitZoneConfig(const std::string& name, Type type, const std::string& key,
+                  std::size_t size);
+  ~LimitZoneConfig();
+
+  const std::string& getName() const;
+  Type getType() const;
+  const std::string& getKey() const;
+  std::size_t getSize() const;
+  unsigned long getRate() const;
+
+  void setRate(const std::string& spec);
+
+  void validate() const;
+
+  bool operator==(const LimitZoneConfig& other) const;
+  bool operator!=(const LimitZoneConfig& other) const;
+
+  static bool isValidName(const std::string& name);
+  static const char* typeName(Type type);
+
+  void serialize(shared::utils::BinaryWriter& writer) const;
+  void deserialize(shared::utils::BinaryReader& reader);
+
+ private:
+  std::string m_name;
+  Type m_type;
+  std::string m_key;
+  std::size_t m_size;
+  unsigned long m_rate;
+};
+
+}  // namespace value_objects
+}  // namespace configuration
+}  // namespace domain
+
+#endif  // LIMIT_ZONE_CONFIG_HPP
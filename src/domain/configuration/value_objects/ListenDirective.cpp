@@ -12,12 +12,14 @@
 
 #include "domain/configuration/exceptions/ListenDirectiveException.hpp"
 #include "domain/configuration/value_objects/ListenDirective.hpp"
+#include "domain/filesystem/value_objects/Size.hpp"
 #include "domain/http/exceptions/HostException.hpp"
 #include "domain/http/exceptions/PortException.hpp"
 #include "domain/http/value_objects/Host.hpp"
 #include "domain/http/value_objects/Port.hpp"
 #include "domain/shared/utils/StringUtils.hpp"
 
+#include <climits>
 #include <cstdlib>
 #include <sstream>
 
@@ -30,16 +32,43 @@ const http::value_objects::Port ListenDirective::DEFAULT_PORT =
     http::value_objects::Port::httpPort();
 
 ListenDirective::ListenDirective()
-    : m_host(http::value_objects::Host::wildcard()), m_port(DEFAULT_PORT) {}
+    : m_host(http::value_objects::Host::wildcard()),
+      m_port(DEFAULT_PORT),
+      m_backlog(0),
+      m_receiveBufferSize(0),
+      m_sendBufferSize(0),
+      m_fastOpenQueueLength(0),
+      m_reusePort(false),
+      m_deferred(false),
+      m_ssl(false),
+      m_http2(false) {}
 
 ListenDirective::ListenDirective(const http::value_objects::Host& host,
                                  const http::value_objects::Port& port)
-    : m_host(host), m_port(port) {
+    : m_host(host),
+      m_port(port),
+      m_backlog(0),
+      m_receiveBufferSize(0),
+      m_sendBufferSize(0),
+      m_fastOpenQueueLength(0),
+      m_reusePort(false),
+      m_deferred(false),
+      m_ssl(false),
+      m_http2(false) {
   validate();
 }
 
 ListenDirective::ListenDirective(const std::string& directiveString)
-    : m_host(http::value_objects::Host::wildcard()), m_port(DEFAULT_PORT) {
+    : m_host(http::value_objects::Host::wildcard()),
+      m_port(DEFAULT_PORT),
+      m_backlog(0),
+      m_receiveBufferSize(0),
+      m_sendBufferSize(0),
+      m_fastOpenQueueLength(0),
+      m_reusePort(false),
+      m_deferred(false),
+      m_ssl(false),
+      m_http2(false) {
   validateDirectiveString(directiveString);
   validateDirectiveFormat(directiveString);
 
@@ -53,7 +82,16 @@ ListenDirective::ListenDirective(const std::string& directiveString)
 }
 
 ListenDirective::ListenDirective(const ListenDirective& other)
-    : m_host(other.m_host), m_port(other.m_port) {}
+    : m_host(other.m_host),
+      m_port(other.m_port),
+      m_backlog(other.m_backlog),
+      m_receiveBufferSize(other.m_receiveBufferSize),
+      m_sendBufferSize(other.m_sendBufferSize),
+      m_fastOpenQueueLength(other.m_fastOpenQueueLength),
+      m_reusePort(other.m_reusePort),
+      m_deferred(other.m_deferred),
+      m_ssl(other.m_ssl),
+      m_http2(other.m_http2) {}
 
 ListenDirective::~ListenDirective() {}
 
@@ -61,6 +99,14 @@ ListenDirective& ListenDirective::operator=(const ListenDirective& other) {
   if (this != &other) {
     m_host = other.m_host;
     m_port = other.m_port;
+    m_backlog = other.m_backlog;
+    m_receiveBufferSize = other.m_receiveBufferSize;
+    m_sendBufferSize = other.m_sendBufferSize;
+    m_fastOpenQueueLength = other.m_fastOpenQueueLength;
+    m_reusePort = other.m_reusePort;
+    m_deferred = other.m_deferred;
+    m_ssl = other.m_ssl;
+    m_http2 = other.m_http2;
   }
   return *this;
 }
@@ -103,6 +149,120 @@ std::string ListenDirective::toCanonicalString() const {
   return oss.str();
 }
 
+int ListenDirective::getBacklog() const { return m_backlog; }
+
+std::size_t ListenDirective::getReceiveBufferSize() const {
+  return m_receiveBufferSize;
+}
+
+std::size_t ListenDirective::getSendBufferSize() const {
+  return m_sendBufferSize;
+}
+
+unsigned int ListenDirective::getFastOpenQueueLength() const {
+  return m_fastOpenQueueLength;
+}
+
+bool ListenDirective::isReusePort() const { return m_reusePort; }
+
+bool ListenDirective::isDeferred() const { return m_deferred; }
+
+bool ListenDirective::isSsl() const { return m_ssl; }
+
+bool ListenDirective::isHttp2() const { return m_http2; }
+
+bool ListenDirective::hasSocketOptions() const {
+  return m_backlog > 0 || m_receiveBufferSize > 0 || m_sendBufferSize > 0 ||
+         m_fastOpenQueueLength > 0 || m_reusePort || m_deferred;
+}
+
+void ListenDirective::applyParameter(const std::string& parameter) {
+  const std::size_t equalsPos = parameter.find('=');
+  const std::string name = parameter.substr(0, equalsPos);
+  const std::string value =
+      (equalsPos == std::string::npos) ? "" : parameter.substr(equalsPos + 1);
+
+  if (name == "reuseport" && equalsPos == std::string::npos) {
+    m_reusePort = true;
+  } else if (name == "deferred" && equalsPos == std::string::npos) {
+    m_deferred = true;
+  } else if (name == "ssl" && equalsPos == std::string::npos) {
+    m_ssl = true;
+  } else if (name == "http2" && equalsPos == std::string::npos) {
+    m_http2 = true;
+  } else if (name == "backlog") {
+    m_backlog = static_cast<int>(parseParameterNumber(
+        name, value, static_cast<unsigned long>(MAX_BACKLOG)));
+  } else if (name == "fastopen") {
+    m_fastOpenQueueLength = static_cast<unsigned int>(
+        parseParameterNumber(name, value, MAX_FASTOPEN_QUEUE));
+  } else if (name == "rcvbuf") {
+    m_receiveBufferSize = parseBufferSize(name, value);
+  } else if (name == "sndbuf") {
+    m_sendBufferSize = parseBufferSize(name, value);
+  } else {
+    throw exceptions::ListenDirectiveException(
+        parameter, exceptions::ListenDirectiveException::INVALID_PARAMETER);
+  }
+}
+
+bool ListenDirective::isParameter(const std::string& token) {
+  if (token == "reuseport" || token == "deferred" || token == "ssl" ||
+      token == "http2") {
+    return true;
+  }
+
+  const std::size_t equalsPos = token.find('=');
+  if (equalsPos == std::string::npos) {
+    return false;
+  }
+
+  const std::string name = token.substr(0, equalsPos);
+  return name == "backlog" || name == "fastopen" || name == "rcvbuf" ||
+         name == "sndbuf";
+}
+
+std::size_t ListenDirective::parseBufferSize(const std::string& parameter,
+                                             const std::string& value) {
+  try {
+    const std::size_t bytes =
+        filesystem::value_objects::Size::fromString(value).getBytes();
+    if (bytes == 0 || bytes > static_cast<std::size_t>(INT_MAX)) {
+      throw exceptions::ListenDirectiveException(
+          parameter + "=" + value,
+          exceptions::ListenDirectiveException::INVALID_PARAMETER);
+    }
+    return bytes;
+  } catch (const exceptions::ListenDirectiveException&) {
+    throw;
+  } catch (const std::exception& e) {
+    throw exceptions::ListenDirectiveException(
+        parameter + "=" + value + " (" + e.what() + ")",
+        exceptions::ListenDirectiveException::INVALID_PARAMETER);
+  }
+}
+
+unsigned long ListenDirective::parseParameterNumber(
+    const std::string& parameter, const std::string& value,
+    unsigned long maxValue) {
+  if (value.empty() || !shared::utils::StringUtils::isAllDigits(value) ||
+      value.length() > K_MAX_PARAMETER_DIGITS) {
+    throw exceptions::ListenDirectiveException(
+        parameter + "=" + value,
+        exceptions::ListenDirectiveException::INVALID_PARAMETER);
+  }
+
+  const unsigned long number = std::strtoul(value.c_str(), NULL, 10);
+  if (number == 0 || number > maxValue) {
+    std::ostringstream oss;
+    oss << parameter << "=" << value << " (must be between 1 and " << maxValue
+        << ")";
+    throw exceptions::ListenDirectiveException(
+        oss.str(), exceptions::ListenDirectiveException::INVALID_PARAMETER);
+  }
+  return number;
+}
+
 bool ListenDirective::isValidDirective(const std::string& directiveString) {
   if (directiveString.empty()) {
     return false;
@@ -454,6 +614,35 @@ void ListenDirective::parseAndSetHostPort(const std::string& hostStr,
   }
 }
 
+void ListenDirective::serialize(shared::utils::BinaryWriter& writer) const {
+  writer.writeString(m_host.getValue());
+  writer.writeU32(m_port.getValue());
+  writer.writeU32(static_cast<unsigned long>(m_backlog));
+  writer.writeSize(m_receiveBufferSize);
+  writer.writeSize(m_sendBufferSize);
+  writer.writeU32(m_fastOpenQueueLength);
+  writer.writeBool(m_reusePort);
+  writer.writeBool(m_deferred);
+  writer.writeBool(m_ssl);
+  writer.writeBool(m_http2);
+}
+
+void ListenDirective::deserialize(shared::utils::BinaryReader& reader) {
+  const std::string host = reader.readString();
+  m_host = host.empty() ? http::value_objects::Host()
+                        : http::value_objects::Host(host);
+  m_port =
+      http::value_objects::Port(static_cast<unsigned int>(reader.readU32()));
+  m_backlog = static_cast<int>(reader.readU32());
+  m_receiveBufferSize = reader.readSize();
+  m_sendBufferSize = reader.readSize();
+  m_fastOpenQueueLength = static_cast<unsigned int>(reader.readU32());
+  m_reusePort = reader.readBool();
+  m_deferred = reader.readBool();
+  m_ssl = reader.readBool();
+  m_http2 = reader.readBool();
+}
+
 }  // namespace entities
 }  // namespace configuration
 }  // namespace domain
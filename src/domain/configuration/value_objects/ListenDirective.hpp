@@ -15,6 +15,8 @@
 
 #include "domain/http/value_objects/Host.hpp"
 #include "domain/http/value_objects/Port.hpp"
+#include "domain/shared/utils/BinaryReader.hpp"
+#include "domain/shared/utils/BinaryWriter.hpp"
 
 #include <string>
 
@@ -27,6 +29,8 @@ class ListenDirective {
  public:
   static const std::string DEFAULT_HOST;
   static const http::value_objects::Port DEFAULT_PORT;
+  static const int MAX_BACKLOG = 65535;
+  static const unsigned int MAX_FASTOPEN_QUEUE = 65535;
 
   ListenDirective();
   ListenDirective(const http::value_objects::Host& host,
@@ -42,6 +46,22 @@ class ListenDirective {
   std::string toString() const;
   std::string toCanonicalString() const;
 
+  void serialize(shared::utils::BinaryWriter& writer) const;
+  void deserialize(shared::utils::BinaryReader& reader);
+
+  int getBacklog() const;
+  std::size_t getReceiveBufferSize() const;
+  std::size_t getSendBufferSize() const;
+  unsigned int getFastOpenQueueLength() const;
+  bool isReusePort() const;
+  bool isDeferred() const;
+  bool isSsl() const;
+  bool isHttp2() const;
+  bool hasSocketOptions() const;
+
+  void applyParameter(const std::string& parameter);
+  static bool isParameter(const std::string& token);
+
   static bool isValidDirective(const std::string& directiveString);
   static bool isDefaultListen(const ListenDirective& directive);
 
@@ -63,8 +83,24 @@ class ListenDirective {
       const std::string& directiveString);
 
  private:
+  static const std::size_t K_MAX_PARAMETER_DIGITS = 10;
+
   http::value_objects::Host m_host;
   http::value_objects::Port m_port;
+  int m_backlog;
+  std::size_t m_receiveBufferSize;
+  std::size_t m_sendBufferSize;
+  unsigned int m_fastOpenQueueLength;
+  bool m_reusePort;
+  bool m_deferred;
+  bool m_ssl;
+  bool m_http2;
+
+  static std::size_t parseBufferSize(const std::string& parameter,
+                                     const std::string& value);
+  static unsigned long parseParameterNumber(const std::string& parameter,
+                                            const std::string& value,
+                                            unsigned long maxValue);
 
   void validate() const;
   void validateHostPortCombination() const;
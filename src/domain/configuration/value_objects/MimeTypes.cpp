@@ -0,0 +1,294 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   MimeTypes.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 22:10:44 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 22:10:44 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "domain/configuration/value_objects/MimeTypes.hpp"
+#include "domain/shared/exceptions/BinaryFormatException.hpp"
+
+namespace domain {
+namespace configuration {
+namespace value_objects {
+
+namespace {
+
+const std::size_t K_FNV_OFFSET_BASIS = 2166136261u;
+const std::size_t K_FNV_PRIME = 16777619u;
+
+struct BuiltinType {
+  const char* type;
+  const char* extension;
+};
+
+const BuiltinType K_BUILTIN_TYPES[] = {
+    {"text/html", "html"},
+    {"text/html", "htm"},
+    {"text/css", "css"},
+    {"text/plain", "txt"},
+    {"text/x-python", "py"},
+    {"text/x-c", "c"},
+    {"text/x-c++", "cpp"},
+    {"text/x-c++", "cc"},
+    {"text/x-c++", "cxx"},
+    {"text/x-c++hdr", "h"},
+    {"text/x-c++hdr", "hpp"},
+    {"application/javascript", "js"},
+    {"application/json", "json"},
+    {"application/xml", "xml"},
+    {"application/pdf", "pdf"},
+    {"application/zip", "zip"},
+    {"application/x-tar", "tar"},
+    {"application/gzip", "gz"},
+    {"application/x-httpd-php", "php"},
+    {"image/jpeg", "jpg"},
+    {"image/jpeg", "jpeg"},
+    {"image/png", "png"},
+    {"image/gif", "gif"},
+    {"image/bmp", "bmp"},
+    {"image/x-icon", "ico"},
+    {"image/svg+xml", "svg"},
+    {"audio/mpeg", "mp3"},
+    {"video/mp4", "mp4"},
+    {"video/x-msvideo", "avi"},
+    {"video/quicktime", "mov"},
+};
+
+}  // namespace
+
+const std::string MimeTypes::DEFAULT_TYPE = "application/octet-stream";
+
+MimeTypes::MimeTypes() : m_count(0), m_defaultType(DEFAULT_TYPE) {}
+
+MimeTypes::MimeTypes(const MimeTypes& other)
+    : m_slots(other.m_slots),
+      m_count(other.m_count),
+      m_defaultType(other.m_defaultType) {}
+
+MimeTypes::~MimeTypes() {}
+
+MimeTypes& MimeTypes::operator=(const MimeTypes& other) {
+  if (this != &other) {
+    m_slots = other.m_slots;
+    m_count = other.m_count;
+    m_defaultType = other.m_defaultType;
+  }
+  return *this;
+}
+
+void MimeTypes::add(const std::string& type, const std::string& extension) {
+  std::size_t start = 0;
+  while (start < extension.size() && extension[start] == '.') {
+    ++start;
+  }
+  if (type.empty() || start == extension.size()) {
+    return;
+  }
+
+  if ((m_count + 1) * 2 > m_slots.size()) {
+    grow();
+  }
+
+  const char* key = extension.data() + start;
+  const std::size_t length = extension.size() - start;
+  Entry& slot = m_slots[probe(key, length)];
+  if (slot.extension.empty()) {
+    slot.extension.reserve(length);
+    for (std::size_t i = 0; i < length; ++i) {
+      slot.extension += toLower(key[i]);
+    }
+    ++m_count;
+  }
+  slot.type = type;
+}
+
+void MimeTypes::merge(const MimeTypes& other) {
+  for (std::size_t i = 0; i < other.m_slots.size(); ++i) {
+    if (!other.m_slots[i].extension.empty()) {
+      add(other.m_slots[i].type, other.m_slots[i].extension);
+    }
+  }
+}
+
+void MimeTypes::clear() {
+  m_slots.clear();
+  m_count = 0;
+  m_defaultType = DEFAULT_TYPE;
+}
+
+void MimeTypes::setDefaultType(const std::string& type) {
+  m_defaultType = type;
+}
+
+const std::string& MimeTypes::getDefaultType() const { return m_defaultType; }
+
+const std::string* MimeTypes::find(const char* extension,
+                                   std::size_t length) const {
+  if (m_count == 0 || length == 0) {
+    return NULL;
+  }
+
+  const Entry& slot = m_slots[probe(extension, length)];
+  return slot.extension.empty() ? NULL : &slot.type;
+}
+
+const std::string& MimeTypes::lookup(const std::string& extension) const {
+  std::size_t start = 0;
+  if (!extension.empty() && extension[0] == '.') {
+    start = 1;
+  }
+
+  const std::string* type =
+      find(extension.data() + start, extension.size() - start);
+  return type != NULL ? *type : m_defaultType;
+}
+
+const std::string& MimeTypes::lookupFilename(
+    const std::string& filename) const {
+  const std::size_t dotPos = filename.rfind('.');
+  if (dotPos == std::string::npos ||
+      filename.find('/', dotPos) != std::string::npos) {
+    return m_defaultType;
+  }
+
+  const std::string* type =
+      find(filename.data() + dotPos + 1, filename.size() - dotPos - 1);
+  return type != NULL ? *type : m_defaultType;
+}
+
+bool MimeTypes::contains(const std::string& extension) const {
+  std::size_t start = 0;
+  if (!extension.empty() && extension[0] == '.') {
+    start = 1;
+  }
+  return find(extension.data() + start, extension.size() - start) != NULL;
+}
+
+std::size_t MimeTypes::size() const { return m_count; }
+
+bool MimeTypes::empty() const { return m_count == 0; }
+
+// The slot array is written as laid out, so a loaded table keeps its probe
+// sequences and needs no rehashing.
+void MimeTypes::serialize(shared::utils::BinaryWriter& writer) const {
+  writer.writeString(m_defaultType);
+  writer.writeSize(m_slots.size());
+  for (std::size_t i = 0; i < m_slots.size(); ++i) {
+    writer.writeString(m_slots[i].extension);
+    writer.writeString(m_slots[i].type);
+  }
+}
+
+void MimeTypes::deserialize(shared::utils::BinaryReader& reader) {
+  m_defaultType = reader.readString();
+  const std::size_t capacity = reader.readSize();
+  if ((capacity & (capacity - 1)) != 0 || capacity > reader.remaining()) {
+    throw shared::exceptions::BinaryFormatException(
+        "MIME table capacity is not a power of two",
+        shared::exceptions::BinaryFormatException::INVALID_VALUE);
+  }
+
+  m_slots.clear();
+  m_slots.resize(capacity);
+  m_count = 0;
+  for (std::size_t i = 0; i < capacity; ++i) {
+    m_slots[i].extension = reader.readString();
+    m_slots[i].type = reader.readString();
+    if (!m_slots[i].extension.empty()) {
+      ++m_count;
+    }
+  }
+  if (capacity != 0 && m_count * 2 > capacity) {
+    throw shared::exceptions::BinaryFormatException(
+        "MIME table is more than half full",
+        shared::exceptions::BinaryFormatException::INVALID_VALUE);
+  }
+}
+
+bool MimeTypes::isValidType(const std::string& type) {
+  const std::size_t slashPos = type.find('/');
+  return slashPos != std::string::npos && slashPos != 0 &&
+         slashPos + 1 < type.size() &&
+         type.find('/', slashPos + 1) == std::string::npos;
+}
+
+const MimeTypes& MimeTypes::builtin() {
+  static MimeTypes table;
+  if (table.empty()) {
+    const std::size_t count =
+        sizeof(K_BUILTIN_TYPES) / sizeof(K_BUILTIN_TYPES[0]);
+    for (std::size_t i = 0; i < count; ++i) {
+      table.add(K_BUILTIN_TYPES[i].type, K_BUILTIN_TYPES[i].extension);
+    }
+  }
+  return table;
+}
+
+// Linear probing; the table is kept at most half full so probes stay short
+// and always reach either the key or an empty slot.
+std::size_t MimeTypes::probe(const char* extension, std::size_t length) const {
+  const std::size_t mask = m_slots.size() - 1;
+  std::size_t index = hash(extension, length) & mask;
+
+  while (!m_slots[index].extension.empty() &&
+         !equalsFolded(m_slots[index].extension, extension, length)) {
+    index = (index + 1) & mask;
+  }
+  return index;
+}
+
+void MimeTypes::grow() {
+  std::vector<Entry> previous;
+  previous.swap(m_slots);
+
+  const std::size_t capacity =
+      previous.empty() ? MIN_CAPACITY : previous.size() * 2;
+  m_slots.resize(capacity);
+
+  for (std::size_t i = 0; i < previous.size(); ++i) {
+    if (previous[i].extension.empty()) {
+      continue;
+    }
+    Entry& slot = m_slots[probe(previous[i].extension.data(),
+                                previous[i].extension.size())];
+    slot.extension.swap(previous[i].extension);
+    slot.type.swap(previous[i].type);
+  }
+}
+
+std::size_t MimeTypes::hash(const char* extension, std::size_t length) {
+  std::size_t value = K_FNV_OFFSET_BASIS;
+  for (std::size_t i = 0; i < length; ++i) {
+    value ^= static_cast<unsigned char>(toLower(extension[i]));
+    value *= K_FNV_PRIME;
+  }
+  return value;
+}
+
+bool MimeTypes::equalsFolded(const std::string& stored, const char* extension,
+                             std::size_t length) {
+  if (stored.size() != length) {
+    return false;
+  }
+  for (std::size_t i = 0; i < length; ++i) {
+    if (stored[i] != toLower(extension[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+char MimeTypes::toLower(char chr) {
+  return (chr >= 'A' && chr <= 'Z') ? static_cast<char>(chr - 'A' + 'a')
+                                    : chr;
+}
+
+}  // namespace value_objects
+}  // namespace configuration
+}  // namespace domain
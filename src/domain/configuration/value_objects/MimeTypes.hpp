@@ -0,0 +1,85 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   MimeTypes.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 22:10:44 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 22:10:44 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef MIME_TYPES_HPP
+#define MIME_TYPES_HPP
+
+#include "domain/shared/utils/BinaryReader.hpp"
+#include "domain/shared/utils/BinaryWriter.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace domain {
+namespace configuration {
+namespace value_objects {
+
+// Extension -> Content-Type table built from `types {}` blocks. Extensions
+// are stored lowercased in an open-addressing hash table, so a lookup folds
+// case while hashing and never copies the extension.
+class MimeTypes {
+ public:
+  static const std::string DEFAULT_TYPE;
+  static const std::size_t MIN_CAPACITY = 64;
+
+  MimeTypes();
+  MimeTypes(const MimeTypes& other);
+  ~MimeTypes();
+
+  MimeTypes& operator=(const MimeTypes& other);
+
+  void add(const std::string& type, const std::string& extension);
+  void merge(const MimeTypes& other);
+  void clear();
+
+  void setDefaultType(const std::string& type);
+  const std::string& getDefaultType() const;
+
+  const std::string* find(const char* extension, std::size_t length) const;
+  const std::string& lookup(const std::string& extension) const;
+  const std::string& lookupFilename(const std::string& filename) const;
+  bool contains(const std::string& extension) const;
+
+  std::size_t size() const;
+  bool empty() const;
+
+  void serialize(shared::utils::BinaryWriter& writer) const;
+  void deserialize(shared::utils::BinaryReader& reader);
+
+  static bool isValidType(const std::string& type);
+  static const MimeTypes& builtin();
+
+ private:
+  struct Entry {
+    std::string extension;
+    std::string type;
+  };
+
+  std::vector<Entry> m_slots;
+  std::size_t m_count;
+  std::string m_defaultType;
+
+  std::size_t probe(const char* extension, std::size_t length) const;
+  void grow();
+
+  static std::size_t hash(const char* extension, std::size_t length);
+  static bool equalsFolded(const std::string& stored, const char* extension,
+                           std::size_t length);
+  static char toLower(char chr);
+};
+
+}  // namespace value_objects
+}  // namespace configuration
+}  // namespace domain
+
+#endif  // MIME_TYPES_HPP
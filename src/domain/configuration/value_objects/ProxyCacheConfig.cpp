@@ -0,0 +1,247 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ProxyCacheConfig.cpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 10:51:05 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 10:51:05 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "domain/configuration/exceptions/CacheConfigException.hpp"
+#include "domain/configuration/value_objects/CacheZoneConfig.hpp"
+#include "domain/configuration/value_objects/ProxyCacheConfig.hpp"
+
+#include <cctype>
+#include <sstream>
+
+namespace domain {
+namespace configuration {
+namespace value_objects {
+
+namespace {
+
+const char* const K_KEY_VARIABLES[] = {"scheme", "request_method", "host",
+                                       "request_uri", "uri", "args",
+                                       "remote_addr", "binary_remote_addr"};
+const char K_HEADER_VARIABLE_PREFIX[] = "http_";
+const unsigned int K_DEFAULT_VALID_STATUSES[] = {200, 301, 302};
+const unsigned int K_MAX_STATUS = 599;
+const unsigned int K_MIN_STATUS = 100;
+
+bool isNameChar(char c) {
+  return std::isalnum(static_cast<unsigned char>(c)) != 0 || c == '_';
+}
+
+}  // namespace
+
+const char ProxyCacheConfig::DEFAULT_KEY[] = "$scheme$host$request_uri";
+const unsigned int ProxyCacheConfig::ANY_STATUS;
+const unsigned int ProxyCacheConfig::DEFAULT_LOCK_TIMEOUT;
+
+ProxyCacheConfig::Validity::Validity() : status(ANY_STATUS), seconds(0) {}
+
+ProxyCacheConfig::Validity::Validity(unsigned int statusCode,
+                                     unsigned int validSeconds)
+    : status(statusCode), seconds(validSeconds) {}
+
+bool ProxyCacheConfig::Validity::operator==(const Validity& other) const {
+  return status == other.status && seconds == other.seconds;
+}
+
+ProxyCacheConfig::ProxyCacheConfig()
+    : m_key(DEFAULT_KEY),
+      m_lockEnabled(false),
+      m_lockTimeout(DEFAULT_LOCK_TIMEOUT) {}
+
+ProxyCacheConfig::~ProxyCacheConfig() {}
+
+bool ProxyCacheConfig::isEnabled() const { return !m_zone.empty(); }
+
+const std::string& ProxyCacheConfig::getZone() const { return m_zone; }
+
+const std::string& ProxyCacheConfig::getKey() const { return m_key; }
+
+const ProxyCacheConfig::ValidityList& ProxyCacheConfig::getValidities()
+    const {
+  return m_validities;
+}
+
+// Seconds a response with this status stays fresh when it carries no
+// caching headers of its own; 0 means it is not cached. A rule naming the
+// status wins over an "any" rule.
+unsigned int ProxyCacheConfig::getValidity(unsigned int status) const {
+  unsigned int any = 0;
+  for (ValidityList::const_iterator it = m_validities.begin();
+       it != m_validities.end(); ++it) {
+    if (it->status == status) {
+      return it->seconds;
+    }
+    if (it->status == ANY_STATUS) {
+      any = it->seconds;
+    }
+  }
+  return any;
+}
+
+bool ProxyCacheConfig::isLockEnabled() const { return m_lockEnabled; }
+
+unsigned int ProxyCacheConfig::getLockTimeout() const {
+  return m_lockTimeout;
+}
+
+void ProxyCacheConfig::setZone(const std::string& zone) {
+  if (!CacheZoneConfig::isValidName(zone)) {
+    throw exceptions::CacheConfigException(
+        "'" + zone + "'", exceptions::CacheConfigException::INVALID_ZONE_NAME);
+  }
+  m_zone = zone;
+}
+
+void ProxyCacheConfig::disable() { m_zone.clear(); }
+
+void ProxyCacheConfig::setKey(const std::string& key) {
+  if (!isValidKey(key)) {
+    throw exceptions::CacheConfigException(
+        "'" + key + "'", exceptions::CacheConfigException::INVALID_KEY);
+  }
+  m_key = key;
+}
+
+// No statuses means 200, 301 and 302, as "proxy_cache_valid 10m" does in
+// nginx; ANY_STATUS covers every status without a rule of its own.
+void ProxyCacheConfig::addValidity(const StatusList& statuses,
+                                   unsigned int seconds) {
+  if (seconds == 0) {
+    throw exceptions::CacheConfigException(
+        "valid time must be positive",
+        exceptions::CacheConfigException::INVALID_VALID_TIME);
+  }
+
+  StatusList codes = statuses;
+  if (codes.empty()) {
+    codes.assign(K_DEFAULT_VALID_STATUSES,
+                 K_DEFAULT_VALID_STATUSES +
+                     sizeof(K_DEFAULT_VALID_STATUSES) /
+                         sizeof(K_DEFAULT_VALID_STATUSES[0]));
+  }
+
+  for (StatusList::const_iterator code = codes.begin(); code != codes.end();
+       ++code) {
+    if (*code != ANY_STATUS &&
+        (*code < K_MIN_STATUS || *code > K_MAX_STATUS)) {
+      std::ostringstream oss;
+      oss << "status " << *code;
+      throw exceptions::CacheConfigException(
+          oss.str(), exceptions::CacheConfigException::INVALID_VALID_TIME);
+    }
+    bool replaced = false;
+    for (ValidityList::iterator it = m_validities.begin();
+         it != m_validities.end(); ++it) {
+      if (it->status == *code) {
+        it->seconds = seconds;
+        replaced = true;
+      }
+    }
+    if (!replaced) {
+      m_validities.push_back(Validity(*code, seconds));
+    }
+  }
+}
+
+void ProxyCacheConfig::setLockEnabled(bool enabled) {
+  m_lockEnabled = enabled;
+}
+
+void ProxyCacheConfig::setLockTimeout(unsigned int seconds) {
+  if (seconds == 0) {
+    throw exceptions::CacheConfigException(
+        "proxy_cache_lock_timeout must be positive",
+        exceptions::CacheConfigException::INVALID_PARAMETER);
+  }
+  m_lockTimeout = seconds;
+}
+
+bool ProxyCacheConfig::operator==(const ProxyCacheConfig& other) const {
+  return m_zone == other.m_zone && m_key == other.m_key &&
+         m_validities == other.m_validities &&
+         m_lockEnabled == other.m_lockEnabled &&
+         m_lockTimeout == other.m_lockTimeout;
+}
+
+bool ProxyCacheConfig::operator!=(const ProxyCacheConfig& other) const {
+  return !(*this == other);
+}
+
+// Literal text with "$name" or "${name}" variables, every one of which must
+// be supported; a key made only of literal text would put every request in
+// one entry and is rejected.
+bool ProxyCacheConfig::isValidKey(const std::string& key) {
+  std::size_t variables = 0;
+  std::size_t pos = 0;
+  while ((pos = key.find('$', pos)) != std::string::npos) {
+    const bool braced = pos + 1 < key.size() && key[pos + 1] == '{';
+    const std::size_t start = pos + (braced ? 2 : 1);
+    std::size_t end = start;
+    while (end < key.size() && isNameChar(key[end])) {
+      ++end;
+    }
+    if (end == start || (braced && (end >= key.size() || key[end] != '}')) ||
+        !isSupportedKeyVariable(key.substr(start, end - start))) {
+      return false;
+    }
+    ++variables;
+    pos = braced ? end + 1 : end;
+  }
+  return variables > 0;
+}
+
+bool ProxyCacheConfig::isSupportedKeyVariable(const std::string& name) {
+  const std::size_t prefixLength = sizeof(K_HEADER_VARIABLE_PREFIX) - 1;
+  if (name.size() > prefixLength &&
+      name.compare(0, prefixLength, K_HEADER_VARIABLE_PREFIX) == 0) {
+    return true;
+  }
+  const std::size_t count =
+      sizeof(K_KEY_VARIABLES) / sizeof(K_KEY_VARIABLES[0]);
+  for (std::size_t i = 0; i < count; ++i) {
+    if (name == K_KEY_VARIABLES[i]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ProxyCacheConfig::serialize(shared::utils::BinaryWriter& writer) const {
+  writer.writeString(m_zone);
+  writer.writeString(m_key);
+  writer.writeSize(m_validities.size());
+  for (ValidityList::const_iterator it = m_validities.begin();
+       it != m_validities.end(); ++it) {
+    writer.writeU32(it->status);
+    writer.writeU32(it->seconds);
+  }
+  writer.writeBool(m_lockEnabled);
+  writer.writeU32(m_lockTimeout);
+}
+
+void ProxyCacheConfig::deserialize(shared::utils::BinaryReader& reader) {
+  m_zone = reader.readString();
+  m_key = reader.readString();
+  m_validities.clear();
+  const std::size_t validityCount = reader.readSize();
+  for (std::size_t i = 0; i < validityCount; ++i) {
+    Validity validity;
+    validity.status = static_cast<unsigned int>(reader.readU32());
+    validity.seconds = static_cast<unsigned int>(reader.readU32());
+    m_validities.push_back(validity);
+  }
+  m_lockEnabled = reader.readBool();
+  m_lockTimeout = static_cast<unsigned int>(reader.readU32());
+}
+
+}  // namespace value_objects
+}  // namespace configuration
+}  // namespace domain
@@ -0,0 +1,88 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ProxyCacheConfig.hpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 10:51:05 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 10:51:05 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef PROXY_CACHE_CONFIG_HPP
+#define PROXY_CACHE_CONFIG_HPP
+
+#include "domain/shared/utils/BinaryReader.hpp"
+#include "domain/shared/utils/BinaryWriter.hpp"
+
+#include <string>
+#include <vector>
+
+namespace domain {
+namespace configuration {
+namespace value_objects {
+
+// The proxy_cache* settings of a location: the zone its proxied and CGI
+// responses are cached in, the key template, how long responses without
+// Cache-Control/Expires stay fresh per status (proxy_cache_valid), and
+// whether concurrent misses wait for the first one to fill the entry.
+class ProxyCacheConfig {
+ public:
+  struct Validity {
+    unsigned int status;
+    unsigned int seconds;
+
+    Validity();
+    Validity(unsigned int statusCode, unsigned int validSeconds);
+
+    bool operator==(const Validity& other) const;
+  };
+
+  typedef std::vector<Validity> ValidityList;
+  typedef std::vector<unsigned int> StatusList;
+
+  static const char DEFAULT_KEY[];
+  static const unsigned int ANY_STATUS = 0;
+  static const unsigned int DEFAULT_LOCK_TIMEOUT = 5;
+
+  ProxyCacheConfig();
+  ~ProxyCacheConfig();
+
+  bool isEnabled() const;
+  const std::string& getZone() const;
+  const std::string& getKey() const;
+  const ValidityList& getValidities() const;
+  unsigned int getValidity(unsigned int status) const;
+  bool isLockEnabled() const;
+  unsigned int getLockTimeout() const;
+
+  void setZone(const std::string& zone);
+  void disable();
+  void setKey(const std::string& key);
+  void addValidity(const StatusList& statuses, unsigned int seconds);
+  void setLockEnabled(bool enabled);
+  void setLockTimeout(unsigned int seconds);
+
+  bool operator==(const ProxyCacheConfig& other) const;
+  bool operator!=(const ProxyCacheConfig& other) const;
+
+  static bool isValidKey(const std::string& key);
+  static bool isSupportedKeyVariable(const std::string& name);
+
+  void serialize(shared::utils::BinaryWriter& writer) const;
+  void deserialize(shared::utils::BinaryReader& reader);
+
+ private:
+  std::string m_zone;
+  std::string m_key;
+  ValidityList m_validities;
+  bool m_lockEnabled;
+  unsigned int m_lockTimeout;
+};
+
+}  // namespace value_objects
+}  // namespace configuration
+}  // namespace domain
+
+#endif  // PROXY_CACHE_CONFIG_HPP
@@ -0,0 +1,186 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RequestLimitConfig.cpp                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:14:51 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:14:51 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "domain/configuration/exceptions/LimitConfigException.hpp"
+#include "domain/configuration/value_objects/RequestLimitConfig.hpp"
+
+#include <sstream>
+
+namespace domain {
+namespace configuration {
+namespace value_objects {
+
+namespace {
+
+const unsigned int K_MIN_STATUS = 400;
+const unsigned int K_MAX_STATUS = 599;
+
+}  // namespace
+
+const unsigned int RequestLimitConfig::DEFAULT_STATUS;
+
+RequestLimitConfig::RequestRule::RequestRule() : burst(0), nodelay(false) {}
+
+RequestLimitConfig::RequestRule::RequestRule(const std::string& zoneName,
+                                             unsigned int burstSize,
+                                             bool noDelay)
+    : zone(zoneName), burst(burstSize), nodelay(noDelay) {}
+
+bool RequestLimitConfig::RequestRule::operator==(
+    const RequestRule& other) const {
+  return zone == other.zone && burst == other.burst &&
+         nodelay == other.nodelay;
+}
+
+RequestLimitConfig::ConnectionRule::ConnectionRule() : limit(0) {}
+
+RequestLimitConfig::ConnectionRule::ConnectionRule(
+    const std::string& zoneName, unsigned int maxConnections)
+    : zone(zoneName), limit(maxConnections) {}
+
+bool RequestLimitConfig::ConnectionRule::operator==(
+    const ConnectionRule& other) const {
+  return zone == other.zone && limit == other.limit;
+}
+
+RequestLimitConfig::RequestLimitConfig()
+    : m_requestStatus(DEFAULT_STATUS), m_connectionStatus(DEFAULT_STATUS) {}
+
+RequestLimitConfig::~RequestLimitConfig() {}
+
+bool RequestLimitConfig::isEnabled() const {
+  return !m_requestRules.empty() || !m_connectionRules.empty();
+}
+
+const RequestLimitConfig::RequestRules& RequestLimitConfig::getRequestRules()
+    const {
+  return m_requestRules;
+}
+
+const RequestLimitConfig::ConnectionRules&
+RequestLimitConfig::getConnectionRules() const {
+  return m_connectionRules;
+}
+
+unsigned int RequestLimitConfig::getRequestStatus() const {
+  return m_requestStatus;
+}
+
+unsigned int RequestLimitConfig::getConnectionStatus() const {
+  return m_connectionStatus;
+}
+
+void RequestLimitConfig::addRequestRule(const RequestRule& rule) {
+  for (RequestRules::const_iterator it = m_requestRules.begin();
+       it != m_requestRules.end(); ++it) {
+    if (it->zone == rule.zone) {
+      throw exceptions::LimitConfigException(
+          "limit_req zone '" + rule.zone + "'",
+          exceptions::LimitConfigException::DUPLICATE_RULE);
+    }
+  }
+  m_requestRules.push_back(rule);
+}
+
+void RequestLimitConfig::addConnectionRule(const ConnectionRule& rule) {
+  if (rule.limit == 0) {
+    throw exceptions::LimitConfigException(
+        "limit_conn '" + rule.zone + "' must allow at least one connection",
+        exceptions::LimitConfigException::INVALID_PARAMETER);
+  }
+  for (ConnectionRules::const_iterator it = m_connectionRules.begin();
+       it != m_connectionRules.end(); ++it) {
+    if (it->zone == rule.zone) {
+      throw exceptions::LimitConfigException(
+          "limit_conn zone '" + rule.zone + "'",
+          exceptions::LimitConfigException::DUPLICATE_RULE);
+    }
+  }
+  m_connectionRules.push_back(rule);
+}
+
+void RequestLimitConfig::setRequestStatus(unsigned int status) {
+  validateStatus(status);
+  m_requestStatus = status;
+}
+
+void RequestLimitConfig::setConnectionStatus(unsigned int status) {
+  validateStatus(status);
+  m_connectionStatus = status;
+}
+
+bool RequestLimitConfig::operator==(const RequestLimitConfig& other) const {
+  return m_requestRules == other.m_requestRules &&
+         m_connectionRules == other.m_connectionRules &&
+         m_requestStatus == other.m_requestStatus &&
+         m_connectionStatus == other.m_connectionStatus;
+}
+
+bool RequestLimitConfig::operator!=(const RequestLimitConfig& other) const {
+  return !(*this == other);
+}
+
+void RequestLimitConfig::serialize(
+    shared::utils::BinaryWriter& writer) const {
+  writer.writeSize(m_requestRules.size());
+  for (RequestRules::const_iterator it = m_requestRules.begin();
+       it != m_requestRules.end(); ++it) {
+    writer.writeString(it->zone);
+    writer.writeU32(it->burst);
+    writer.writeBool(it->nodelay);
+  }
+  writer.writeSize(m_connectionRules.size());
+  for (ConnectionRules::const_iterator it = m_connectionRules.begin();
+       it != m_connectionRules.end(); ++it) {
+    writer.writeString(it->zone);
+    writer.writeU32(it->limit);
+  }
+  writer.writeU32(m_requestStatus);
+  writer.writeU32(m_connectionStatus);
+}
+
+void RequestLimitConfig::deserialize(shared::utils::BinaryReader& reader) {
+  m_requestRules.clear();
+  const std::size_t requestCount = reader.readSize();
+  for (std::size_t i = 0; i < requestCount; ++i) {
+    RequestRule rule;
+    rule.zone = reader.readString();
+    rule.burst = static_cast<unsigned int>(reader.readU32());
+    rule.nodelay = reader.readBool();
+    m_requestRules.push_back(rule);
+  }
+  m_connectionRules.clear();
+  const std::size_t connectionCount = reader.readSize();
+  for (std::size_t i = 0; i < connectionCount; ++i) {
+    ConnectionRule rule;
+    rule.zone = reader.readString();
+    rule.limit = static_cast<unsigned int>(reader.readU32());
+    m_connectionRules.push_back(rule);
+  }
+  m_requestStatus = static_cast<unsigned int>(reader.readU32());
+  m_connectionStatus = static_cast<unsigned int>(reader.readU32());
+}
+
+// nginx accepts only error statuses here, 400 through 599.
+void RequestLimitConfig::validateStatus(unsigned int status) {
+  if (status < K_MIN_STATUS || status > K_MAX_STATUS) {
+    std::ostringstream oss;
+    oss << status << " is not between " << K_MIN_STATUS << " and "
+        << K_MAX_STATUS;
+    throw exceptions::LimitConfigException(
+        oss.str(), exceptions::LimitConfigException::INVALID_STATUS);
+  }
+}
+
+}  // namespace value_objects
+}  // namespace configuration
+}  // namespace domain
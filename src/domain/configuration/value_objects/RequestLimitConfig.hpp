@@ -0,0 +1,92 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RequestLimitConfig.hpp                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:14:51 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:14:51 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef REQUEST_LIMIT_CONFIG_HPP
+#define REQUEST_LIMIT_CONFIG_HPP
+
+#include "domain/shared/utils/BinaryReader.hpp"
+#include "domain/shared/utils/BinaryWriter.hpp"
+
+#include <string>
+#include <vector>
+
+namespace domain {
+namespace configuration {
+namespace value_objects {
+
+// The limit_req and limit_conn rules of a location. Each rule names a zone
+// declared at http level; a request must pass every rule, and is answered
+// with the configured status (503 unless limit_req_status or
+// limit_conn_status say otherwise) when one of them refuses it.
+class RequestLimitConfig {
+ public:
+  struct RequestRule {
+    std::string zone;
+    unsigned int burst;
+    bool nodelay;
+
+    RequestRule();
+    RequestRule(const std::string& zoneName, unsigned int burstSize,
+                bool noDelay);
+
+    bool operator==(const RequestRule& other) const;
+  };
+
+  struct ConnectionRule {
+    std::string zone;
+    unsigned int limit;
+
+    ConnectionRule();
+    ConnectionRule(const std::string& zoneName, unsigned int maxConnections);
+
+    bool operator==(const ConnectionRule& other) const;
+  };
+
+  typedef std::vector<RequestRule> RequestRules;
+  typedef std::vector<ConnectionRule> ConnectionRules;
+
+  static const unsigned int DEFAULT_STATUS = 503;
+
+  RequestLimitConfig();
+  ~RequestLimitConfig();
+
+  bool isEnabled() const;
+  const RequestRules& getRequestRules() const;
+  const ConnectionRules& getConnectionRules() const;
+  unsigned int getRequestStatus() const;
+  unsigned int getConnectionStatus() const;
+
+  void addRequestRule(const RequestRule& rule);
+  void addConnectionRule(const ConnectionRule& rule);
+  void setRequestStatus(unsigned int status);
+  void setConnectionStatus(unsigned int status);
+
+  bool operator==(const RequestLimitConfig& other) const;
+  bool operator!=(const RequestLimitConfig& other) const;
+
+  void serialize(shared::utils::BinaryWriter& writer) const;
+  void deserialize(shared::utils::BinaryReader& reader);
+
+ private:
+  RequestRules m_requestRules;
+  ConnectionRules m_connectionRules;
+  unsigned int m_requestStatus;
+  unsigned int m_connectionStatus;
+
+  static void validateStatus(unsigned int status);
+};
+
+}  // namespace value_objects
+}  // namespace configuration
+}  // namespace domain
+
+#endif  // REQUEST_LIMIT_CONFIG_HPP
@@ -0,0 +1,224 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   SslConfig.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:22:17 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:22:17 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "domain/configuration/exceptions/SslConfigException.hpp"
+#include "domain/configuration/value_objects/LimitZoneConfig.hpp"
+#include "domain/configuration/value_objects/SslConfig.hpp"
+#include "domain/filesystem/value_objects/Size.hpp"
+
+#include <cctype>
+
+namespace domain {
+namespace configuration {
+namespace value_objects {
+
+namespace {
+
+const char K_BUILTIN_PREFIX[] = "builtin";
+const char K_SHARED_PREFIX[] = "shared:";
+const std::size_t K_MAX_SESSION_DIGITS = 9;
+
+exceptions::SslConfigException invalidSessionCache(const std::string& spec) {
+  return exceptions::SslConfigException(
+      "'" + spec + "'", exceptions::SslConfigException::INVALID_SESSION_CACHE);
+}
+
+}  // namespace
+
+const unsigned int SslConfig::DEFAULT_SESSION_TIMEOUT;
+const unsigned int SslConfig::MAX_SESSION_TIMEOUT;
+const std::size_t SslConfig::DEFAULT_BUILTIN_SESSIONS;
+const std::size_t SslConfig::BYTES_PER_SESSION;
+
+SslConfig::SslConfig()
+    : m_sessionCache(CACHE_NONE),
+      m_sessionCacheSessions(0),
+      m_sessionTimeout(DEFAULT_SESSION_TIMEOUT),
+      m_sessionTickets(true) {}
+
+SslConfig::~SslConfig() {}
+
+bool SslConfig::isConfigured() const { return !m_certificate.empty(); }
+
+const std::string& SslConfig::getCertificate() const { return m_certificate; }
+
+const std::string& SslConfig::getCertificateKey() const {
+  return m_certificateKey;
+}
+
+SslConfig::SessionCache SslConfig::getSessionCache() const {
+  return m_sessionCache;
+}
+
+const std::string& SslConfig::getSessionCacheName() const {
+  return m_sessionCacheName;
+}
+
+std::size_t SslConfig::getSessionCacheSessions() const {
+  return m_sessionCacheSessions;
+}
+
+unsigned int SslConfig::getSessionTimeout() const { return m_sessionTimeout; }
+
+bool SslConfig::isSessionTicketsEnabled() const { return m_sessionTickets; }
+
+void SslConfig::setCertificate(const std::string& path) {
+  if (path.empty()) {
+    throw exceptions::SslConfigException(
+        "path is empty", exceptions::SslConfigException::INVALID_CERTIFICATE);
+  }
+  m_certificate = path;
+}
+
+void SslConfig::setCertificateKey(const std::string& path) {
+  if (path.empty()) {
+    throw exceptions::SslConfigException(
+        "path is empty",
+        exceptions::SslConfigException::INVALID_CERTIFICATE_KEY);
+  }
+  m_certificateKey = path;
+}
+
+// "off", "none", "builtin[:sessions]" or "shared:name:size". nginx's
+// "none" lets clients believe a session may be resumed without storing
+// it; here both "none" and "off" leave resumption to session tickets.
+void SslConfig::setSessionCache(const std::string& spec) {
+  if (spec == "off" || spec == "none") {
+    m_sessionCache = spec == "off" ? CACHE_OFF : CACHE_NONE;
+    m_sessionCacheName.clear();
+    m_sessionCacheSessions = 0;
+    return;
+  }
+
+  if (spec.compare(0, sizeof(K_BUILTIN_PREFIX) - 1, K_BUILTIN_PREFIX) == 0) {
+    const std::string rest = spec.substr(sizeof(K_BUILTIN_PREFIX) - 1);
+    if (!rest.empty() && rest[0] != ':') {
+      throw invalidSessionCache(spec);
+    }
+    m_sessionCache = CACHE_BUILTIN;
+    m_sessionCacheName.clear();
+    m_sessionCacheSessions =
+        rest.empty() ? DEFAULT_BUILTIN_SESSIONS
+                     : parseSessionCount(spec, rest.substr(1));
+    return;
+  }
+
+  if (spec.compare(0, sizeof(K_SHARED_PREFIX) - 1, K_SHARED_PREFIX) != 0) {
+    throw invalidSessionCache(spec);
+  }
+  const std::string rest = spec.substr(sizeof(K_SHARED_PREFIX) - 1);
+  const std::string::size_type colon = rest.find(':');
+  if (colon == std::string::npos ||
+      !LimitZoneConfig::isValidName(rest.substr(0, colon))) {
+    throw invalidSessionCache(spec);
+  }
+
+  std::size_t bytes = 0;
+  try {
+    bytes = filesystem::value_objects::Size::fromString(rest.substr(colon + 1))
+                .getBytes();
+  } catch (const std::exception&) {
+    throw invalidSessionCache(spec);
+  }
+  if (bytes < BYTES_PER_SESSION) {
+    throw exceptions::SslConfigException(
+        "'" + spec + "' holds no session",
+        exceptions::SslConfigException::INVALID_SESSION_CACHE);
+  }
+  m_sessionCache = CACHE_SHARED;
+  m_sessionCacheName = rest.substr(0, colon);
+  m_sessionCacheSessions = bytes / BYTES_PER_SESSION;
+}
+
+void SslConfig::setSessionTimeout(unsigned int seconds) {
+  if (seconds == 0 || seconds > MAX_SESSION_TIMEOUT) {
+    throw exceptions::SslConfigException(
+        "must be between 1s and 1d",
+        exceptions::SslConfigException::INVALID_SESSION_TIMEOUT);
+  }
+  m_sessionTimeout = seconds;
+}
+
+void SslConfig::setSessionTicketsEnabled(bool enabled) {
+  m_sessionTickets = enabled;
+}
+
+// Only the pairing is checked here; loading the files is left to the TLS
+// layer, so a compiled configuration stays valid across certificate renewal.
+void SslConfig::validate() const {
+  if (!m_certificateKey.empty() && m_certificate.empty()) {
+    throw exceptions::SslConfigException(
+        "ssl_certificate_key is set without ssl_certificate",
+        exceptions::SslConfigException::MISSING_CERTIFICATE);
+  }
+  if (!m_certificate.empty() && m_certificateKey.empty()) {
+    throw exceptions::SslConfigException(
+        "no ssl_certificate_key for '" + m_certificate + "'",
+        exceptions::SslConfigException::INVALID_CERTIFICATE_KEY);
+  }
+}
+
+bool SslConfig::operator==(const SslConfig& other) const {
+  return m_certificate == other.m_certificate &&
+         m_certificateKey == other.m_certificateKey &&
+         m_sessionCache == other.m_sessionCache &&
+         m_sessionCacheName == other.m_sessionCacheName &&
+         m_sessionCacheSessions == other.m_sessionCacheSessions &&
+         m_sessionTimeout == other.m_sessionTimeout &&
+         m_sessionTickets == other.m_sessionTickets;
+}
+
+bool SslConfig::operator!=(const SslConfig& other) const {
+  return !(*this == other);
+}
+
+void SslConfig::serialize(shared::utils::BinaryWriter& writer) const {
+  writer.writeString(m_certificate);
+  writer.writeString(m_certificateKey);
+  writer.writeU32(static_cast<unsigned int>(m_sessionCache));
+  writer.writeString(m_sessionCacheName);
+  writer.writeSize(m_sessionCacheSessions);
+  writer.writeU32(m_sessionTimeout);
+  writer.writeBool(m_sessionTickets);
+}
+
+void SslConfig::deserialize(shared::utils::BinaryReader& reader) {
+  m_certificate = reader.readString();
+  m_certificateKey = reader.readString();
+  m_sessionCache = static_cast<SessionCache>(reader.readU32());
+  m_sessionCacheName = reader.readString();
+  m_sessionCacheSessions = reader.readSize();
+  m_sessionTimeout = static_cast<unsigned int>(reader.readU32());
+  m_sessionTickets = reader.readBool();
+}
+
+std::size_t SslConfig::parseSessionCount(const std::string& spec,
+                                         const std::string& count) {
+  if (count.empty() || count.size() > K_MAX_SESSION_DIGITS) {
+    throw invalidSessionCache(spec);
+  }
+  std::size_t sessions = 0;
+  for (std::size_t i = 0; i < count.size(); ++i) {
+    if (!std::isdigit(static_cast<unsigned char>(count[i]))) {
+      throw invalidSessionCache(spec);
+    }
+    sessions = sessions * 10 + static_cast<std::size_t>(count[i] - '0');
+  }
+  if (sessions == 0) {
+    throw invalidSessionCache(spec);
+  }
+  return sessions;
+}
+
+}  // namespace value_objects
+}  // namespace configuration
+}  // namespace domain
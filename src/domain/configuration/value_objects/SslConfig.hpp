@@ -0,0 +1,82 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   SslConfig.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:22:17 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:22:17 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef SSL_CONFIG_HPP
+#define SSL_CONFIG_HPP
+
+#include "domain/shared/utils/BinaryReader.hpp"
+#include "domain/shared/utils/BinaryWriter.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace domain {
+namespace configuration {
+namespace value_objects {
+
+// A server's TLS settings: "ssl_certificate", "ssl_certificate_key",
+// "ssl_session_cache", "ssl_session_timeout" and "ssl_session_tickets".
+// The session cache is kept as a session count; "shared:name:size" is
+// converted at nginx's density of about 4000 sessions per megabyte.
+class SslConfig {
+ public:
+  enum SessionCache { CACHE_NONE, CACHE_OFF, CACHE_BUILTIN, CACHE_SHARED };
+
+  static const unsigned int DEFAULT_SESSION_TIMEOUT = 300;
+  static const unsigned int MAX_SESSION_TIMEOUT = 86400;
+  static const std::size_t DEFAULT_BUILTIN_SESSIONS = 20480;
+  static const std::size_t BYTES_PER_SESSION = 256;
+
+  SslConfig();
+  ~SslConfig();
+
+  bool isConfigured() const;
+  const std::string& getCertificate() const;
+  const std::string& getCertificateKey() const;
+  SessionCache getSessionCache() const;
+  const std::string& getSessionCacheName() const;
+  std::size_t getSessionCacheSessions() const;
+  unsigned int getSessionTimeout() const;
+  bool isSessionTicketsEnabled() const;
+
+  void setCertificate(const std::string& path);
+  void setCertificateKey(const std::string& path);
+  void setSessionCache(const std::string& spec);
+  void setSessionTimeout(unsigned int seconds);
+  void setSessionTicketsEnabled(bool enabled);
+
+  void validate() const;
+
+  bool operator==(const SslConfig& other) const;
+  bool operator!=(const SslConfig& other) const;
+
+  void serialize(shared::utils::BinaryWriter& writer) const;
+  void deserialize(shared::utils::BinaryReader& reader);
+
+ private:
+  std::string m_certificate;
+  std::string m_certificateKey;
+  SessionCache m_sessionCache;
+  std::string m_sessionCacheName;
+  std::size_t m_sessionCacheSessions;
+  unsigned int m_sessionTimeout;
+  bool m_sessionTickets;
+
+  static std::size_t parseSessionCount(const std::string& spec,
+                                       const std::string& count);
+};
+
+}  // namespace value_objects
+}  // namespace configuration
+}  // namespace domain
+
+#endif  // SSL_CONFIG_HPP
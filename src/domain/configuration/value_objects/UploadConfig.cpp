@@ -1373,6 +1373,47 @@ bool UploadConfig::isArchiveFile(const std::string& filename) {
   return false;
 }
 
+void UploadConfig::serialize(shared::utils::BinaryWriter& writer) const {
+  m_uploadDirectory.serialize(writer);
+  writer.writeSize(m_maxFileSize.getBytes());
+  writer.writeSize(m_maxTotalSize.getBytes());
+  writer.writeSize(m_maxFilesPerUpload);
+  writer.writeSize(m_maxFilenameLength);
+  writer.writeSize(m_maxUploadsPerHour);
+  writer.writeBool(m_overwriteExisting);
+  writer.writeBool(m_generateThumbnails);
+  writer.writeBool(m_applyWatermark);
+  writer.writeBool(m_encryptFiles);
+  writer.writeBool(m_compressFiles);
+  writer.writeStrings(m_allowedExtensions);
+  writer.writeStrings(m_blockedExtensions);
+  writer.writeStrings(m_allowedMimeTypes);
+  writer.writeStrings(m_blockedMimeTypes);
+  writer.writeU32(m_permissions.getOctalValue());
+  writer.writeString(m_uploadAccess);
+}
+
+void UploadConfig::deserialize(shared::utils::BinaryReader& reader) {
+  m_uploadDirectory.deserialize(reader);
+  m_maxFileSize = domain::filesystem::value_objects::Size(reader.readSize());
+  m_maxTotalSize = domain::filesystem::value_objects::Size(reader.readSize());
+  m_maxFilesPerUpload = reader.readSize();
+  m_maxFilenameLength = reader.readSize();
+  m_maxUploadsPerHour = reader.readSize();
+  m_overwriteExisting = reader.readBool();
+  m_generateThumbnails = reader.readBool();
+  m_applyWatermark = reader.readBool();
+  m_encryptFiles = reader.readBool();
+  m_compressFiles = reader.readBool();
+  m_allowedExtensions = reader.readStrings();
+  m_blockedExtensions = reader.readStrings();
+  m_allowedMimeTypes = reader.readStrings();
+  m_blockedMimeTypes = reader.readStrings();
+  m_permissions = domain::filesystem::value_objects::Permission(
+      static_cast<unsigned int>(reader.readU32()));
+  m_uploadAccess = reader.readString();
+}
+
 }  // namespace value_objects
 }  // namespace configuration
 }  // namespace domain
@@ -15,6 +15,8 @@
 
 #include "domain/filesystem/value_objects/Path.hpp"
 #include "domain/filesystem/value_objects/Size.hpp"
+#include "domain/shared/utils/BinaryReader.hpp"
+#include "domain/shared/utils/BinaryWriter.hpp"
 #include "infrastructure/filesystem/adapters/DirectoryLister.hpp"
 #include "infrastructure/filesystem/adapters/FileHandler.hpp"
 #include "infrastructure/filesystem/adapters/PathResolver.hpp"
@@ -168,6 +170,9 @@ class UploadConfig {
   bool getEncryptFiles() const;
   bool getCompressFiles() const;
 
+  void serialize(shared::utils::BinaryWriter& writer) const;
+  void deserialize(shared::utils::BinaryReader& reader);
+
  private:
   domain::filesystem::value_objects::Path m_uploadDirectory;
   domain::filesystem::value_objects::Size m_maxFileSize;
@@ -0,0 +1,272 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   UpstreamConfig.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 09:14:03 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 09:14:03 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "domain/configuration/exceptions/UpstreamConfigException.hpp"
+#include "domain/configuration/value_objects/UpstreamConfig.hpp"
+#include "domain/shared/exceptions/BinaryFormatException.hpp"
+
+#include <cctype>
+#include <sstream>
+
+namespace domain {
+namespace configuration {
+namespace value_objects {
+
+namespace {
+
+const char* const K_HASH_KEYS[] = {"$remote_addr", "$request_uri", "$host"};
+
+}  // namespace
+
+const unsigned int UpstreamConfig::DEFAULT_PORT;
+const unsigned int UpstreamConfig::DEFAULT_WEIGHT;
+const unsigned int UpstreamConfig::DEFAULT_MAX_FAILS;
+const unsigned int UpstreamConfig::DEFAULT_FAIL_TIMEOUT;
+const std::size_t UpstreamConfig::DEFAULT_KEEPALIVE;
+const unsigned int UpstreamConfig::MAX_PORT;
+
+UpstreamConfig::Server::Server()
+    : port(DEFAULT_PORT),
+      weight(DEFAULT_WEIGHT),
+      maxFails(DEFAULT_MAX_FAILS),
+      failTimeout(DEFAULT_FAIL_TIMEOUT) {}
+
+UpstreamConfig::Server::Server(const std::string& serverHost,
+                               unsigned int serverPort)
+    : host(serverHost),
+      port(serverPort),
+      weight(DEFAULT_WEIGHT),
+      maxFails(DEFAULT_MAX_FAILS),
+      failTimeout(DEFAULT_FAIL_TIMEOUT) {}
+
+std::string UpstreamConfig::Server::getAddress() const {
+  std::ostringstream oss;
+  if (host.find(':') != std::string::npos) {
+    oss << "[" << host << "]:" << port;
+  } else {
+    oss << host << ":" << port;
+  }
+  return oss.str();
+}
+
+bool UpstreamConfig::Server::operator==(const Server& other) const {
+  return host == other.host && port == other.port && weight == other.weight &&
+         maxFails == other.maxFails && failTimeout == other.failTimeout;
+}
+
+UpstreamConfig::UpstreamConfig()
+    : m_balance(BALANCE_ROUND_ROBIN), m_keepalive(DEFAULT_KEEPALIVE) {}
+
+UpstreamConfig::UpstreamConfig(const std::string& name)
+    : m_name(name),
+      m_balance(BALANCE_ROUND_ROBIN),
+      m_keepalive(DEFAULT_KEEPALIVE) {
+  if (!isValidName(name)) {
+    throw exceptions::UpstreamConfigException(
+        "'" + name + "'", exceptions::UpstreamConfigException::INVALID_NAME);
+  }
+}
+
+UpstreamConfig::~UpstreamConfig() {}
+
+const std::string& UpstreamConfig::getName() const { return m_name; }
+
+const UpstreamConfig::ServerList& UpstreamConfig::getServers() const {
+  return m_servers;
+}
+
+UpstreamConfig::Balance UpstreamConfig::getBalance() const {
+  return m_balance;
+}
+
+const std::string& UpstreamConfig::getHashKey() const { return m_hashKey; }
+
+std::size_t UpstreamConfig::getKeepalive() const { return m_keepalive; }
+
+void UpstreamConfig::addServer(const Server& server) {
+  if (server.host.empty() || server.port == 0 || server.port > MAX_PORT) {
+    throw exceptions::UpstreamConfigException(
+        server.getAddress(),
+        exceptions::UpstreamConfigException::INVALID_SERVER);
+  }
+  if (server.weight == 0) {
+    throw exceptions::UpstreamConfigException(
+        "weight must be positive for " + server.getAddress(),
+        exceptions::UpstreamConfigException::INVALID_SERVER_PARAMETER);
+  }
+  m_servers.push_back(server);
+}
+
+void UpstreamConfig::setBalance(Balance balance) {
+  m_balance = balance;
+  if (balance != BALANCE_HASH) {
+    m_hashKey.clear();
+  }
+}
+
+void UpstreamConfig::setHashKey(const std::string& key) {
+  if (!isSupportedHashKey(key)) {
+    throw exceptions::UpstreamConfigException(
+        "'" + key + "' (expected $remote_addr, $request_uri or $host)",
+        exceptions::UpstreamConfigException::INVALID_HASH_KEY);
+  }
+  m_balance = BALANCE_HASH;
+  m_hashKey = key;
+}
+
+void UpstreamConfig::setKeepalive(std::size_t connections) {
+  m_keepalive = connections;
+}
+
+void UpstreamConfig::validate() const {
+  if (!isValidName(m_name)) {
+    throw exceptions::UpstreamConfigException(
+        "'" + m_name + "'", exceptions::UpstreamConfigException::INVALID_NAME);
+  }
+  if (m_servers.empty()) {
+    throw exceptions::UpstreamConfigException(
+        m_name, exceptions::UpstreamConfigException::NO_SERVERS);
+  }
+}
+
+bool UpstreamConfig::operator==(const UpstreamConfig& other) const {
+  return m_name == other.m_name && m_servers == other.m_servers &&
+         m_balance == other.m_balance && m_hashKey == other.m_hashKey &&
+         m_keepalive == other.m_keepalive;
+}
+
+bool UpstreamConfig::operator!=(const UpstreamConfig& other) const {
+  return !(*this == other);
+}
+
+// "host", "host:port" or "[v6]:port"; the port defaults to 80 as in nginx.
+UpstreamConfig::Server UpstreamConfig::parseServer(
+    const std::string& address) {
+  std::string host = address;
+  std::string port;
+
+  if (!address.empty() && address[0] == '[') {
+    const std::size_t close = address.find(']');
+    if (close == std::string::npos) {
+      throw exceptions::UpstreamConfigException(
+          address, exceptions::UpstreamConfigException::INVALID_SERVER);
+    }
+    host = address.substr(1, close - 1);
+    if (close + 1 < address.size()) {
+      if (address[close + 1] != ':') {
+        throw exceptions::UpstreamConfigException(
+            address, exceptions::UpstreamConfigException::INVALID_SERVER);
+      }
+      port = address.substr(close + 2);
+    }
+  } else {
+    const std::size_t colon = address.rfind(':');
+    if (colon != std::string::npos) {
+      host = address.substr(0, colon);
+      port = address.substr(colon + 1);
+      if (host.find(':') != std::string::npos) {
+        throw exceptions::UpstreamConfigException(
+            address + " (IPv6 addresses need brackets)",
+            exceptions::UpstreamConfigException::INVALID_SERVER);
+      }
+    }
+  }
+
+  unsigned long portValue = DEFAULT_PORT;
+  if (!port.empty() || address.find(':') != std::string::npos) {
+    if (port.empty() || port.size() > 5) {
+      throw exceptions::UpstreamConfigException(
+          address, exceptions::UpstreamConfigException::INVALID_SERVER);
+    }
+    portValue = 0;
+    for (std::size_t i = 0; i < port.size(); ++i) {
+      if (!std::isdigit(static_cast<unsigned char>(port[i]))) {
+        throw exceptions::UpstreamConfigException(
+            address, exceptions::UpstreamConfigException::INVALID_SERVER);
+      }
+      portValue = portValue * 10 + static_cast<unsigned long>(port[i] - '0');
+    }
+  }
+
+  if (host.empty() || portValue == 0 || portValue > MAX_PORT) {
+    throw exceptions::UpstreamConfigException(
+        address, exceptions::UpstreamConfigException::INVALID_SERVER);
+  }
+  return Server(host, static_cast<unsigned int>(portValue));
+}
+
+bool UpstreamConfig::isValidName(const std::string& name) {
+  if (name.empty()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < name.size(); ++i) {
+    const unsigned char c = static_cast<unsigned char>(name[i]);
+    if (!std::isalnum(c) && c != '_' && c != '-' && c != '.') {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool UpstreamConfig::isSupportedHashKey(const std::string& key) {
+  const std::size_t count = sizeof(K_HASH_KEYS) / sizeof(K_HASH_KEYS[0]);
+  for (std::size_t i = 0; i < count; ++i) {
+    if (key == K_HASH_KEYS[i]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void UpstreamConfig::serialize(shared::utils::BinaryWriter& writer) const {
+  writer.writeString(m_name);
+  writer.writeSize(m_servers.size());
+  for (ServerList::const_iterator it = m_servers.begin();
+       it != m_servers.end(); ++it) {
+    writer.writeString(it->host);
+    writer.writeU32(it->port);
+    writer.writeU32(it->weight);
+    writer.writeU32(it->maxFails);
+    writer.writeU32(it->failTimeout);
+  }
+  writer.writeU8(static_cast<unsigned char>(m_balance));
+  writer.writeString(m_hashKey);
+  writer.writeSize(m_keepalive);
+}
+
+void UpstreamConfig::deserialize(shared::utils::BinaryReader& reader) {
+  m_name = reader.readString();
+  m_servers.clear();
+  const std::size_t serverCount = reader.readSize();
+  for (std::size_t i = 0; i < serverCount; ++i) {
+    Server server;
+    server.host = reader.readString();
+    server.port = static_cast<unsigned int>(reader.readU32());
+    server.weight = static_cast<unsigned int>(reader.readU32());
+    server.maxFails = static_cast<unsigned int>(reader.readU32());
+    server.failTimeout = static_cast<unsigned int>(reader.readU32());
+    m_servers.push_back(server);
+  }
+  const unsigned char balance = reader.readU8();
+  if (balance > BALANCE_HASH) {
+    throw shared::exceptions::BinaryFormatException(
+        "unknown upstream balancing method",
+        shared::exceptions::BinaryFormatException::INVALID_VALUE);
+  }
+  m_balance = static_cast<Balance>(balance);
+  m_hashKey = reader.readString();
+  m_keepalive = reader.readSize();
+}
+
+}  // namespace value_objects
+}  // namespace configuration
+}  // namespace domain
@@ -0,0 +1,97 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   UpstreamConfig.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 09:14:03 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 09:14:03 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef UPSTREAM_CONFIG_HPP
+#define UPSTREAM_CONFIG_HPP
+
+#include "domain/shared/utils/BinaryReader.hpp"
+#include "domain/shared/utils/BinaryWriter.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace domain {
+namespace configuration {
+namespace value_objects {
+
+// An http-level "upstream name { ... }" block: the servers a proxy_pass to
+// that name balances over, how a server is picked, and how many idle
+// keep-alive connections are kept per server. A server that fails max_fails
+// times within fail_timeout seconds is skipped for fail_timeout seconds.
+class UpstreamConfig {
+ public:
+  enum Balance { BALANCE_ROUND_ROBIN, BALANCE_LEAST_CONN, BALANCE_HASH };
+
+  struct Server {
+    std::string host;
+    unsigned int port;
+    unsigned int weight;
+    unsigned int maxFails;
+    unsigned int failTimeout;
+
+    Server();
+    Server(const std::string& host, unsigned int port);
+
+    std::string getAddress() const;
+    bool operator==(const Server& other) const;
+  };
+
+  typedef std::vector<Server> ServerList;
+
+  static const unsigned int DEFAULT_PORT = 80;
+  static const unsigned int DEFAULT_WEIGHT = 1;
+  static const unsigned int DEFAULT_MAX_FAILS = 1;
+  static const unsigned int DEFAULT_FAIL_TIMEOUT = 10;
+  static const std::size_t DEFAULT_KEEPALIVE = 8;
+  static const unsigned int MAX_PORT = 65535;
+
+  UpstreamConfig();
+  explicit UpstreamConfig(const std::string& name);
+  ~UpstreamConfig();
+
+  const std::string& getName() const;
+  const ServerList& getServers() const;
+  Balance getBalance() const;
+  const std::string& getHashKey() const;
+  std::size_t getKeepalive() const;
+
+  void addServer(const Server& server);
+  void setBalance(Balance balance);
+  void setHashKey(const std::string& key);
+  void setKeepalive(std::size_t connections);
+
+  void validate() const;
+
+  bool operator==(const UpstreamConfig& other) const;
+  bool operator!=(const UpstreamConfig& other) const;
+
+  static Server parseServer(const std::string& address);
+  static bool isValidName(const std::string& name);
+  static bool isSupportedHashKey(const std::string& key);
+
+  void serialize(shared::utils::BinaryWriter& writer) const;
+  void deserialize(shared::utils::BinaryReader& reader);
+
+ private:
+  std::string m_name;
+  ServerList m_servers;
+  Balance m_balance;
+  std::string m_hashKey;
+  std::size_t m_keepalive;
+};
+
+}  // namespace value_objects
+}  // namespace configuration
+}  // namespace domain
+
+#endif  // UPSTREAM_CONFIG_HPP
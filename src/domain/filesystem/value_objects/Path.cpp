@@ -454,6 +454,15 @@ std::string Path::normalizeComponents(
   return joinComponents(normalized);
 }
 
+void Path::serialize(shared::utils::BinaryWriter& writer) const {
+  writer.writeString(m_path);
+}
+
+void Path::deserialize(shared::utils::BinaryReader& reader) {
+  m_path = reader.readString();
+  m_isAbsolute = (!m_path.empty() && m_path[0] == PATH_SEPARATOR);
+}
+
 }  // namespace value_objects
 }  // namespace filesystem
 }  // namespace domain
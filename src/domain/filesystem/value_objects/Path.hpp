@@ -13,6 +13,9 @@
 #ifndef PATH_HPP
 #define PATH_HPP
 
+#include "domain/shared/utils/BinaryReader.hpp"
+#include "domain/shared/utils/BinaryWriter.hpp"
+
 #include <string>
 #include <vector>
 
@@ -66,6 +69,9 @@ class Path {
   Path operator+(const std::string& suffix) const;
   Path operator+(const Path& suffix) const;
 
+  void serialize(shared::utils::BinaryWriter& writer) const;
+  void deserialize(shared::utils::BinaryReader& reader);
+
  private:
   std::string m_path;
   bool m_isAbsolute;
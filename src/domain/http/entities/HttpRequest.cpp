@@ -12,6 +12,7 @@
 
 #include "HttpRequest.hpp"
 #include "domain/http/exceptions/HttpRequestException.hpp"
+#include "domain/shared/utils/ByteScanner.hpp"
 
 #include <algorithm>
 #include <sstream>
@@ -24,7 +25,8 @@ HttpRequest::HttpRequest()
     : m_method(value_objects::HttpMethod::get()),
       m_uri(value_objects::Uri::fromString("/")),
       m_path(filesystem::value_objects::Path::fromString("/", true)),
-      m_version(value_objects::HttpVersion::http11()) {}
+      m_version(value_objects::HttpVersion::http11()),
+      m_knownHeaderMask(0) {}
 
 HttpRequest::HttpRequest(const HttpRequest& other)
     : m_method(other.m_method),
@@ -32,8 +34,11 @@ HttpRequest::HttpRequest(const HttpRequest& other)
       m_path(other.m_path),
       m_query(other.m_query),
       m_version(other.m_version),
+      m_knownHeaderMask(0),
       m_headers(other.m_headers),
-      m_body(other.m_body) {}
+      m_body(other.m_body) {
+  copyKnownHeaders(other);
+}
 
 HttpRequest::~HttpRequest() {}
 
@@ -44,6 +49,7 @@ HttpRequest& HttpRequest::operator=(const HttpRequest& other) {
     m_path = other.m_path;
     m_query = other.m_query;
     m_version = other.m_version;
+    copyKnownHeaders(other);
     m_headers = other.m_headers;
     m_body = other.m_body;
   }
@@ -62,8 +68,16 @@ value_objects::QueryStringBuilder HttpRequest::getQuery() const {
 
 value_objects::HttpVersion HttpRequest::getVersion() const { return m_version; }
 
-const HttpRequest::HeaderMap& HttpRequest::getHeaders() const {
-  return m_headers;
+HttpRequest::HeaderMap HttpRequest::getHeaders() const {
+  HeaderMap headers(m_headers);
+  for (std::size_t i = 0; i < value_objects::HttpHeader::KNOWN_HEADER_COUNT;
+       ++i) {
+    if ((m_knownHeaderMask & (1U << i)) != 0) {
+      headers[value_objects::HttpHeader::knownHeaderName(
+          static_cast<KnownHeader>(i))] = m_knownHeaders[i];
+    }
+  }
+  return headers;
 }
 
 const HttpRequest::Body& HttpRequest::getBody() const { return m_body; }
@@ -89,6 +103,11 @@ void HttpRequest::setVersion(const value_objects::HttpVersion& version) {
 void HttpRequest::setBody(const Body& body) { m_body = body; }
 
 std::string HttpRequest::getHeader(const std::string& name) const {
+  const KnownHeader header = value_objects::HttpHeader::lookupKnown(name);
+  if (header != value_objects::HttpHeader::HEADER_UNKNOWN) {
+    return getHeader(header);
+  }
+
   const std::string normalizedName = normalizeHeaderName(name);
   HeaderMap::const_iterator iter = m_headers.find(normalizedName);
   if (iter != m_headers.end()) {
@@ -97,25 +116,73 @@ std::string HttpRequest::getHeader(const std::string& name) const {
   return "";
 }
 
+std::string HttpRequest::getHeader(KnownHeader header) const {
+  if (!hasHeader(header)) {
+    return "";
+  }
+  return m_knownHeaders[header];
+}
+
 bool HttpRequest::hasHeader(const std::string& name) const {
+  const KnownHeader header = value_objects::HttpHeader::lookupKnown(name);
+  if (header != value_objects::HttpHeader::HEADER_UNKNOWN) {
+    return hasHeader(header);
+  }
+
   const std::string normalizedName = normalizeHeaderName(name);
   return m_headers.find(normalizedName) != m_headers.end();
 }
 
+bool HttpRequest::hasHeader(KnownHeader header) const {
+  if (header >= value_objects::HttpHeader::HEADER_UNKNOWN) {
+    return false;
+  }
+  return (m_knownHeaderMask & (1U << header)) != 0;
+}
+
 void HttpRequest::addHeader(const std::string& name, const std::string& value) {
+  const KnownHeader header = value_objects::HttpHeader::lookupKnown(name);
+  if (header != value_objects::HttpHeader::HEADER_UNKNOWN) {
+    addHeader(header, value);
+    return;
+  }
+
   const std::string normalizedName = normalizeHeaderName(name);
   m_headers[normalizedName] = value;
 }
 
+void HttpRequest::addHeader(KnownHeader header, const std::string& value) {
+  if (header >= value_objects::HttpHeader::HEADER_UNKNOWN) {
+    return;
+  }
+  m_knownHeaders[header] = value;
+  m_knownHeaderMask |= (1U << header);
+}
+
 void HttpRequest::removeHeader(const std::string& name) {
+  const KnownHeader header = value_objects::HttpHeader::lookupKnown(name);
+  if (header != value_objects::HttpHeader::HEADER_UNKNOWN) {
+    m_knownHeaders[header].clear();
+    m_knownHeaderMask &= ~(1U << header);
+    return;
+  }
+
   const std::string normalizedName = normalizeHeaderName(name);
   m_headers.erase(normalizedName);
 }
 
-void HttpRequest::clearHeaders() { m_headers.clear(); }
+void HttpRequest::clearHeaders() {
+  for (std::size_t i = 0; i < value_objects::HttpHeader::KNOWN_HEADER_COUNT;
+       ++i) {
+    m_knownHeaders[i].clear();
+  }
+  m_knownHeaderMask = 0;
+  m_headers.clear();
+}
 
 std::size_t HttpRequest::getContentLength() const {
-  const std::string contentLength = getHeader("content-length");
+  const std::string contentLength =
+      getHeader(value_objects::HttpHeader::HEADER_CONTENT_LENGTH);
   if (contentLength.empty()) {
     return 0;
   }
@@ -129,17 +196,19 @@ std::size_t HttpRequest::getContentLength() const {
 }
 
 std::string HttpRequest::getContentType() const {
-  return getHeader("content-type");
+  return getHeader(value_objects::HttpHeader::HEADER_CONTENT_TYPE);
 }
 
-std::string HttpRequest::getHost() const { return getHeader("host"); }
+std::string HttpRequest::getHost() const {
+  return getHeader(value_objects::HttpHeader::HEADER_HOST);
+}
 
 std::string HttpRequest::getConnection() const {
-  return getHeader("connection");
+  return getHeader(value_objects::HttpHeader::HEADER_CONNECTION);
 }
 
 std::string HttpRequest::getTransferEncoding() const {
-  return getHeader("transfer-encoding");
+  return getHeader(value_objects::HttpHeader::HEADER_TRANSFER_ENCODING);
 }
 
 bool HttpRequest::isChunked() const {
@@ -150,6 +219,9 @@ bool HttpRequest::isChunked() const {
 }
 
 bool HttpRequest::isKeepAlive() const {
+  if (m_version.isHttp20()) {
+    return true;
+  }
   if (m_version.isHttp11()) {
     std::string connection = getConnection();
     std::transform(connection.begin(), connection.end(), connection.begin(),
@@ -174,7 +246,8 @@ bool HttpRequest::isComplete() const {
     return false;
   }
 
-  if (!m_version.isHttp10() && !m_version.isHttp11()) {
+  if (!m_version.isHttp10() && !m_version.isHttp11() &&
+      !m_version.isHttp20()) {
     return false;
   }
 
@@ -206,7 +279,8 @@ void HttpRequest::validate() const {
         "Request path is empty", exceptions::HttpRequestException::INVALID_URI);
   }
 
-  if (!m_version.isHttp10() && !m_version.isHttp11()) {
+  if (!m_version.isHttp10() && !m_version.isHttp11() &&
+      !m_version.isHttp20()) {
     throw exceptions::HttpRequestException(
         "Unsupported HTTP version: " + m_version.toString(),
         exceptions::HttpRequestException::INVALID_VERSION);
@@ -223,7 +297,7 @@ void HttpRequest::validate() const {
 bool HttpRequest::operator==(const HttpRequest& other) const {
   return m_method == other.m_method && m_uri == other.m_uri &&
          m_path == other.m_path && m_version == other.m_version &&
-         m_headers == other.m_headers && m_body == other.m_body;
+         getHeaders() == other.getHeaders() && m_body == other.m_body;
 }
 
 bool HttpRequest::operator!=(const HttpRequest& other) const {
@@ -231,16 +305,22 @@ bool HttpRequest::operator!=(const HttpRequest& other) const {
 }
 
 std::string HttpRequest::normalizeHeaderName(const std::string& name) {
-  std::string normalized;
-  normalized.reserve(name.size());
-
-  for (std::size_t i = 0; i < name.size(); ++i) {
-    normalized += toLowerCase(name[i]);
+  std::string normalized(name);
+  if (!normalized.empty()) {
+    shared::utils::ByteScanner::toLowerAscii(&normalized[0],
+                                             normalized.size());
   }
-
   return normalized;
 }
 
+void HttpRequest::copyKnownHeaders(const HttpRequest& other) {
+  for (std::size_t i = 0; i < value_objects::HttpHeader::KNOWN_HEADER_COUNT;
+       ++i) {
+    m_knownHeaders[i] = other.m_knownHeaders[i];
+  }
+  m_knownHeaderMask = other.m_knownHeaderMask;
+}
+
 bool HttpRequest::isWhitespace(char chr) { return chr == ' ' || chr == '\t'; }
 
 char HttpRequest::toLowerCase(char chr) {
@@ -251,13 +331,14 @@ char HttpRequest::toLowerCase(char chr) {
 }
 
 void HttpRequest::validateContentLength() const {
-  if (!hasHeader("content-length")) {
+  if (!hasHeader(value_objects::HttpHeader::HEADER_CONTENT_LENGTH)) {
     return;
   }
 
   const std::size_t contentLength = getContentLength();
-  if (contentLength == 0 && !getHeader("content-length").empty()) {
-    const std::string value = getHeader("content-length");
+  const std::string value =
+      getHeader(value_objects::HttpHeader::HEADER_CONTENT_LENGTH);
+  if (contentLength == 0 && !value.empty()) {
     if (value != "0") {
       throw exceptions::HttpRequestException(
           "Invalid Content-Length value: '" + value + "'",
@@ -283,7 +364,7 @@ void HttpRequest::validateContentLength() const {
 }
 
 void HttpRequest::validateHostHeader() const {
-  if (!hasHeader("host")) {
+  if (!hasHeader(value_objects::HttpHeader::HEADER_HOST)) {
     throw exceptions::HttpRequestException(
         "HTTP/1.1 requests must include Host header",
         exceptions::HttpRequestException::MISSING_REQUIRED_HEADER);
@@ -298,7 +379,7 @@ void HttpRequest::validateHostHeader() const {
 }
 
 void HttpRequest::validateTransferEncoding() const {
-  if (!hasHeader("transfer-encoding")) {
+  if (!hasHeader(value_objects::HttpHeader::HEADER_TRANSFER_ENCODING)) {
     return;
   }
 
@@ -312,7 +393,7 @@ void HttpRequest::validateTransferEncoding() const {
         exceptions::HttpRequestException::UNSUPPORTED_TRANSFER_ENCODING);
   }
 
-  if (hasHeader("content-length")) {
+  if (hasHeader(value_objects::HttpHeader::HEADER_CONTENT_LENGTH)) {
     throw exceptions::HttpRequestException(
         "Request cannot have both Content-Length and Transfer-Encoding headers",
         exceptions::HttpRequestException::MALFORMED_REQUEST);
@@ -14,6 +14,7 @@
 #define HTTPREQUEST_HPP
 
 #include "domain/filesystem/value_objects/Path.hpp"
+#include "domain/http/value_objects/HttpHeader.hpp"
 #include "domain/http/value_objects/HttpMethod.hpp"
 #include "domain/http/value_objects/HttpVersion.hpp"
 #include "domain/http/value_objects/QueryStringBuilder.hpp"
@@ -31,6 +32,7 @@ class HttpRequest {
  public:
   typedef std::map<std::string, std::string> HeaderMap;
   typedef std::vector<char> Body;
+  typedef value_objects::HttpHeader::KnownHeader KnownHeader;
 
   static const std::size_t DEFAULT_MAX_BODY_SIZE = 10485760;
   static const std::size_t MAX_URI_LENGTH = 8192;
@@ -46,7 +48,7 @@ class HttpRequest {
   filesystem::value_objects::Path getPath() const;
   value_objects::QueryStringBuilder getQuery() const;
   value_objects::HttpVersion getVersion() const;
-  const HeaderMap& getHeaders() const;
+  HeaderMap getHeaders() const;
   const Body& getBody() const;
 
   void setMethod(const value_objects::HttpMethod& method);
@@ -57,8 +59,11 @@ class HttpRequest {
   void setBody(const Body& body);
 
   std::string getHeader(const std::string& name) const;
+  std::string getHeader(KnownHeader header) const;
   bool hasHeader(const std::string& name) const;
+  bool hasHeader(KnownHeader header) const;
   void addHeader(const std::string& name, const std::string& value);
+  void addHeader(KnownHeader header, const std::string& value);
   void removeHeader(const std::string& name);
   void clearHeaders();
 
@@ -85,9 +90,13 @@ class HttpRequest {
   filesystem::value_objects::Path m_path;
   value_objects::QueryStringBuilder m_query;
   value_objects::HttpVersion m_version;
+  std::string m_knownHeaders[value_objects::HttpHeader::KNOWN_HEADER_COUNT];
+  unsigned int m_knownHeaderMask;
   HeaderMap m_headers;
   Body m_body;
 
+  void copyKnownHeaders(const HttpRequest& other);
+
   static std::string normalizeHeaderName(const std::string& name);
   static bool isWhitespace(char chr);
   static char toLowerCase(char chr);
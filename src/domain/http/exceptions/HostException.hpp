@@ -19,7 +19,7 @@ namespace domain {
 namespace http {
 namespace exceptions {
 
-class HostException : public shared::exceptions::BaseException {
+class HostException : public ::shared::exceptions::BaseException {
  public:
   enum ErrorCode {
     EMPTY_HOST,
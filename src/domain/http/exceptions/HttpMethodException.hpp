@@ -19,7 +19,7 @@ namespace domain {
 namespace http {
 namespace exceptions {
 
-class HttpMethodException : public shared::exceptions::BaseException {
+class HttpMethodException : public ::shared::exceptions::BaseException {
  public:
   enum ErrorCode { EMPTY_STRING, INVALID_METHOD, UNKNOWN_METHOD, CODE_COUNT };
 
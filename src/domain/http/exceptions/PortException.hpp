@@ -19,7 +19,7 @@ namespace domain {
 namespace http {
 namespace exceptions {
 
-class PortException : public shared::exceptions::BaseException {
+class PortException : public ::shared::exceptions::BaseException {
  public:
   enum ErrorCode {
     INVALID_STRING,
@@ -19,7 +19,7 @@ namespace domain {
 namespace http {
 namespace exceptions {
 
-class QueryStringBuilderException : public shared::exceptions::BaseException {
+class QueryStringBuilderException : public ::shared::exceptions::BaseException {
  public:
   enum ErrorCode {
     EMPTY_URL,
@@ -38,6 +38,42 @@ const std::string HttpHeader::CONNECTION_CLOSE = "close";
 const std::string HttpHeader::CONNECTION_KEEP_ALIVE = "keep-alive";
 const std::string HttpHeader::TRANSFER_ENCODING_CHUNKED = "chunked";
 
+const std::size_t HttpHeader::KNOWN_HEADER_COUNT;
+
+const char* HttpHeader::K_KNOWN_HEADER_NAMES[] = {
+    "host",
+    "connection",
+    "content-length",
+    "content-type",
+    "transfer-encoding",
+    "accept",
+    "accept-encoding",
+    "accept-language",
+    "user-agent",
+    "cookie",
+    "referer",
+    "authorization",
+    "cache-control",
+    "if-modified-since",
+    "if-none-match",
+    "range",
+    "expect",
+    "origin",
+    "upgrade",
+    "x-forwarded-for",
+    "keep-alive",
+    "pragma"};
+
+// Perfect hash over K_KNOWN_HEADER_NAMES:
+//   slot = (length + first + 26 * last) & 63, on lowercased characters.
+// Regenerate this table if the list above changes; the unit tests check
+// that every name lands on its own slot.
+const signed char HttpHeader::K_KNOWN_HEADER_SLOTS[] = {
+    -1, 2,  -1, -1, -1, -1, 14, 8,  -1, -1, -1, -1, -1, 10, -1, -1,
+    21, -1, -1, -1, -1, -1, -1, -1, -1, 1,  11, 19, -1, -1, -1, -1,
+    -1, 17, -1, -1, -1, -1, 6,  -1, 12, -1, -1, 9,  -1, -1, -1, 5,
+    -1, 3,  7,  16, 0,  -1, -1, 20, -1, 15, -1, 4,  13, -1, 18, -1};
+
 HttpHeader::HttpHeader() {}
 
 HttpHeader::HttpHeader(const std::string& name, const std::string& value)
@@ -209,6 +245,48 @@ std::string HttpHeader::trimWhitespace(const std::string& str) {
   return str.substr(start, end - start + 1);
 }
 
+HttpHeader::KnownHeader HttpHeader::lookupKnown(const char* name,
+                                                std::size_t length) {
+  if (length == 0) {
+    return HEADER_UNKNOWN;
+  }
+
+  const std::size_t first =
+      static_cast<unsigned char>(toLowerCase(name[0]));
+  const std::size_t last =
+      static_cast<unsigned char>(toLowerCase(name[length - 1]));
+  const std::size_t slot =
+      (length + first + K_KNOWN_HEADER_LAST_CHAR_WEIGHT * last) &
+      K_KNOWN_HEADER_TABLE_MASK;
+
+  const int index = K_KNOWN_HEADER_SLOTS[slot];
+  if (index < 0) {
+    return HEADER_UNKNOWN;
+  }
+
+  const char* candidate = K_KNOWN_HEADER_NAMES[index];
+  for (std::size_t i = 0; i < length; ++i) {
+    if (candidate[i] == '\0' || candidate[i] != toLowerCase(name[i])) {
+      return HEADER_UNKNOWN;
+    }
+  }
+  if (candidate[length] != '\0') {
+    return HEADER_UNKNOWN;
+  }
+  return static_cast<KnownHeader>(index);
+}
+
+HttpHeader::KnownHeader HttpHeader::lookupKnown(const std::string& name) {
+  return lookupKnown(name.data(), name.size());
+}
+
+const char* HttpHeader::knownHeaderName(KnownHeader header) {
+  if (header >= HEADER_UNKNOWN) {
+    return "";
+  }
+  return K_KNOWN_HEADER_NAMES[header];
+}
+
 void HttpHeader::validate() const {
   if (m_name.empty()) {
     throw exceptions::HttpHeaderException(
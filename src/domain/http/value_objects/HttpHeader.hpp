@@ -21,6 +21,33 @@ namespace value_objects {
 
 class HttpHeader {
  public:
+  enum KnownHeader {
+    HEADER_HOST,
+    HEADER_CONNECTION,
+    HEADER_CONTENT_LENGTH,
+    HEADER_CONTENT_TYPE,
+    HEADER_TRANSFER_ENCODING,
+    HEADER_ACCEPT,
+    HEADER_ACCEPT_ENCODING,
+    HEADER_ACCEPT_LANGUAGE,
+    HEADER_USER_AGENT,
+    HEADER_COOKIE,
+    HEADER_REFERER,
+    HEADER_AUTHORIZATION,
+    HEADER_CACHE_CONTROL,
+    HEADER_IF_MODIFIED_SINCE,
+    HEADER_IF_NONE_MATCH,
+    HEADER_RANGE,
+    HEADER_EXPECT,
+    HEADER_ORIGIN,
+    HEADER_UPGRADE,
+    HEADER_X_FORWARDED_FOR,
+    HEADER_KEEP_ALIVE,
+    HEADER_PRAGMA,
+    HEADER_UNKNOWN
+  };
+
+  static const std::size_t KNOWN_HEADER_COUNT = HEADER_UNKNOWN;
   static const std::size_t MAX_HEADER_NAME_LENGTH = 256;
   static const std::size_t MAX_HEADER_VALUE_LENGTH = 8192;
 
@@ -74,6 +101,10 @@ class HttpHeader {
   static std::string normalizeName(const std::string& name);
   static std::string trimWhitespace(const std::string& str);
 
+  static KnownHeader lookupKnown(const char* name, std::size_t length);
+  static KnownHeader lookupKnown(const std::string& name);
+  static const char* knownHeaderName(KnownHeader header);
+
  private:
   std::string m_name;
   std::string m_value;
@@ -86,6 +117,11 @@ class HttpHeader {
   static bool isValidValueCharacter(char chr);
   static bool isWhitespace(char chr);
   static char toLowerCase(char chr);
+
+  static const char* K_KNOWN_HEADER_NAMES[];
+  static const signed char K_KNOWN_HEADER_SLOTS[];
+  static const std::size_t K_KNOWN_HEADER_TABLE_MASK = 63;
+  static const std::size_t K_KNOWN_HEADER_LAST_CHAR_WEIGHT = 26;
 };
 
 }  // namespace value_objects
@@ -13,7 +13,6 @@
 #include "domain/http/exceptions/HttpMethodException.hpp"
 #include "domain/http/value_objects/HttpMethod.hpp"
 
-#include <algorithm>
 #include <cctype>
 
 namespace domain {
@@ -24,6 +23,29 @@ const char* HttpMethod::METHOD_STRINGS[] = {
     "GET",     "POST",  "PUT",     "DELETE", "HEAD",
     "OPTIONS", "TRACE", "CONNECT", "PATCH",  "UNKNOWN"};
 
+const HttpMethod::MethodMask HttpMethod::NO_METHODS;
+const HttpMethod::MethodMask HttpMethod::ALL_METHODS;
+
+// Indexed by Method, in the order of METHOD_STRINGS.
+const unsigned char HttpMethod::K_METHOD_PROPERTIES[] = {
+    PROPERTY_SAFE | PROPERTY_IDEMPOTENT | PROPERTY_CACHEABLE |
+        PROPERTY_RESPONSE_BODY,
+    PROPERTY_CACHEABLE | PROPERTY_REQUEST_BODY | PROPERTY_RESPONSE_BODY,
+    PROPERTY_IDEMPOTENT | PROPERTY_REQUEST_BODY | PROPERTY_RESPONSE_BODY,
+    PROPERTY_IDEMPOTENT | PROPERTY_RESPONSE_BODY,
+    PROPERTY_SAFE | PROPERTY_IDEMPOTENT | PROPERTY_CACHEABLE,
+    PROPERTY_SAFE | PROPERTY_IDEMPOTENT | PROPERTY_RESPONSE_BODY,
+    PROPERTY_SAFE | PROPERTY_IDEMPOTENT | PROPERTY_RESPONSE_BODY,
+    PROPERTY_RESPONSE_BODY,
+    PROPERTY_REQUEST_BODY | PROPERTY_RESPONSE_BODY,
+    PROPERTY_RESPONSE_BODY};
+
+// Perfect hash over METHOD_STRINGS: slot = (length + 5 * first) & 31,
+// on the uppercased first character.
+const signed char HttpMethod::K_METHOD_SLOTS[] = {
+    -1, -1, -1, -1, -1, -1, 0, -1, -1, 6, -1, -1, 4, -1, -1, -1,
+    -1, -1, 5, 2, 1, 8, 7, -1, -1, -1, 3, -1, -1, -1, -1, -1};
+
 HttpMethod::HttpMethod() : m_method(METHOD_GET) {}
 
 HttpMethod::HttpMethod(Method method) : m_method(method) {}
@@ -46,6 +68,8 @@ HttpMethod& HttpMethod::operator=(const HttpMethod& other) {
 
 HttpMethod::Method HttpMethod::getMethod() const { return m_method; }
 
+HttpMethod::MethodMask HttpMethod::toMask() const { return maskOf(m_method); }
+
 std::string HttpMethod::toString() const {
   if (m_method >= METHOD_GET && m_method < METHOD_UNKNOWN) {
     return METHOD_STRINGS[m_method];
@@ -65,18 +89,30 @@ bool HttpMethod::isValidMethodString(const std::string& methodString) {
 }
 
 bool HttpMethod::isSafeMethod(Method method) {
-  return method == METHOD_GET || method == METHOD_HEAD ||
-         method == METHOD_OPTIONS || method == METHOD_TRACE;
+  return hasProperty(method, PROPERTY_SAFE);
 }
 
 bool HttpMethod::isIdempotentMethod(Method method) {
-  return method == METHOD_GET || method == METHOD_PUT ||
-         method == METHOD_DELETE || method == METHOD_HEAD ||
-         method == METHOD_OPTIONS || method == METHOD_TRACE;
+  return hasProperty(method, PROPERTY_IDEMPOTENT);
 }
 
 bool HttpMethod::isCacheableMethod(Method method) {
-  return method == METHOD_GET || method == METHOD_HEAD || method == METHOD_POST;
+  return hasProperty(method, PROPERTY_CACHEABLE);
+}
+
+bool HttpMethod::hasProperty(Method method, Property property) {
+  if (static_cast<unsigned int>(method) > METHOD_UNKNOWN) {
+    return false;
+  }
+  return (K_METHOD_PROPERTIES[method] & property) != 0;
+}
+
+// METHOD_UNKNOWN maps to no bit, so it is never in an allow-list.
+HttpMethod::MethodMask HttpMethod::maskOf(Method method) {
+  if (static_cast<unsigned int>(method) >= METHOD_UNKNOWN) {
+    return NO_METHODS;
+  }
+  return 1u << static_cast<unsigned int>(method);
 }
 
 void HttpMethod::validate() const {
@@ -112,11 +148,12 @@ bool HttpMethod::isIdempotent() const { return isIdempotentMethod(m_method); }
 bool HttpMethod::isCacheable() const { return isCacheableMethod(m_method); }
 
 bool HttpMethod::hasRequestBody() const {
-  return m_method == METHOD_POST || m_method == METHOD_PUT ||
-         m_method == METHOD_PATCH;
+  return hasProperty(m_method, PROPERTY_REQUEST_BODY);
 }
 
-bool HttpMethod::hasResponseBody() const { return m_method != METHOD_HEAD; }
+bool HttpMethod::hasResponseBody() const {
+  return hasProperty(m_method, PROPERTY_RESPONSE_BODY);
+}
 
 bool HttpMethod::operator==(const HttpMethod& other) const {
   return m_method == other.m_method;
@@ -169,12 +206,6 @@ HttpMethod::Method HttpMethod::parseMethodString(
   return stringToMethod(methodString);
 }
 
-std::string HttpMethod::toUpperCase(const std::string& input) {
-  std::string result = input;
-  std::transform(result.begin(), result.end(), result.begin(), ::toupper);
-  return result;
-}
-
 bool HttpMethod::isValidMethodFormat(const std::string& methodString) {
   for (std::size_t index = 0; index < methodString.size(); ++index) {
     char character = methodString[index];
@@ -185,18 +216,39 @@ bool HttpMethod::isValidMethodFormat(const std::string& methodString) {
   return !methodString.empty();
 }
 
+HttpMethod::Method HttpMethod::lookupMethod(const char* token,
+                                            std::size_t length) {
+  if (length == 0) {
+    return METHOD_UNKNOWN;
+  }
+
+  const std::size_t first = static_cast<unsigned char>(
+      std::toupper(static_cast<unsigned char>(token[0])));
+  const int index =
+      K_METHOD_SLOTS[(length + K_METHOD_FIRST_CHAR_WEIGHT * first) &
+                     K_METHOD_TABLE_MASK];
+  if (index < 0) {
+    return METHOD_UNKNOWN;
+  }
+
+  const char* candidate = METHOD_STRINGS[index];
+  for (std::size_t i = 0; i < length; ++i) {
+    if (candidate[i] == '\0' ||
+        candidate[i] != std::toupper(static_cast<unsigned char>(token[i]))) {
+      return METHOD_UNKNOWN;
+    }
+  }
+  if (candidate[length] != '\0') {
+    return METHOD_UNKNOWN;
+  }
+  return static_cast<Method>(index);
+}
+
 HttpMethod::Method HttpMethod::stringToMethod(const std::string& methodString) {
-  std::string upperMethod = toUpperCase(methodString);
-
-  if (upperMethod == "GET") return METHOD_GET;
-  if (upperMethod == "POST") return METHOD_POST;
-  if (upperMethod == "PUT") return METHOD_PUT;
-  if (upperMethod == "DELETE") return METHOD_DELETE;
-  if (upperMethod == "HEAD") return METHOD_HEAD;
-  if (upperMethod == "OPTIONS") return METHOD_OPTIONS;
-  if (upperMethod == "TRACE") return METHOD_TRACE;
-  if (upperMethod == "CONNECT") return METHOD_CONNECT;
-  if (upperMethod == "PATCH") return METHOD_PATCH;
+  const Method method = lookupMethod(methodString.data(), methodString.size());
+  if (method != METHOD_UNKNOWN) {
+    return method;
+  }
 
   throw exceptions::HttpMethodException(
       "Unknown HTTP method: '" + methodString + "'",
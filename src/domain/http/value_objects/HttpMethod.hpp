@@ -34,7 +34,19 @@ class HttpMethod {
     METHOD_UNKNOWN
   };
 
+  enum Property {
+    PROPERTY_SAFE = 1,
+    PROPERTY_IDEMPOTENT = 2,
+    PROPERTY_CACHEABLE = 4,
+    PROPERTY_REQUEST_BODY = 8,
+    PROPERTY_RESPONSE_BODY = 16
+  };
+
+  typedef unsigned int MethodMask;
+
   static const char* METHOD_STRINGS[];
+  static const MethodMask NO_METHODS = 0;
+  static const MethodMask ALL_METHODS = (1u << METHOD_UNKNOWN) - 1;
 
   HttpMethod();
   explicit HttpMethod(Method method);
@@ -45,6 +57,7 @@ class HttpMethod {
   HttpMethod& operator=(const HttpMethod& other);
 
   Method getMethod() const;
+  MethodMask toMask() const;
   std::string toString() const;
   std::string toUpperCaseString() const;
 
@@ -52,6 +65,8 @@ class HttpMethod {
   static bool isSafeMethod(Method method);
   static bool isIdempotentMethod(Method method);
   static bool isCacheableMethod(Method method);
+  static bool hasProperty(Method method, Property property);
+  static MethodMask maskOf(Method method);
 
   bool isGet() const;
   bool isPost() const;
@@ -86,15 +101,20 @@ class HttpMethod {
   static HttpMethod fromString(const std::string& methodString);
 
   static Method parseMethodString(const std::string& methodString);
+  static Method lookupMethod(const char* token, std::size_t length);
 
  private:
   Method m_method;
 
   void validate() const;
 
-  static std::string toUpperCase(const std::string& input);
   static bool isValidMethodFormat(const std::string& methodString);
   static Method stringToMethod(const std::string& methodString);
+
+  static const unsigned char K_METHOD_PROPERTIES[];
+  static const signed char K_METHOD_SLOTS[];
+  static const std::size_t K_METHOD_TABLE_MASK = 31;
+  static const std::size_t K_METHOD_FIRST_CHAR_WEIGHT = 5;
 };
 
 }  // namespace value_objects
@@ -1393,6 +1393,28 @@ std::string Uri::parseFragment(const std::string& uriString,
   return fragment;
 }
 
+void Uri::serialize(shared::utils::BinaryWriter& writer) const {
+  writer.writeString(m_scheme);
+  writer.writeString(m_host);
+  writer.writeU32(m_port.getValue());
+  writer.writeString(m_path);
+  writer.writeString(m_query);
+  writer.writeString(m_fragment);
+  writer.writeBool(m_isAbsolute);
+  writer.writeBool(m_hasExplicitPort);
+}
+
+void Uri::deserialize(shared::utils::BinaryReader& reader) {
+  m_scheme = reader.readString();
+  m_host = reader.readString();
+  m_port = Port(static_cast<unsigned int>(reader.readU32()));
+  m_path = reader.readString();
+  m_query = reader.readString();
+  m_fragment = reader.readString();
+  m_isAbsolute = reader.readBool();
+  m_hasExplicitPort = reader.readBool();
+}
+
 }  // namespace value_objects
 }  // namespace http
 }  // namespace domain
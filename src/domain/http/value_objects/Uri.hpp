@@ -14,6 +14,8 @@
 #define URI_HPP
 
 #include "domain/http/value_objects/Port.hpp"
+#include "domain/shared/utils/BinaryReader.hpp"
+#include "domain/shared/utils/BinaryWriter.hpp"
 
 #include <string>
 #include <vector>
@@ -98,6 +100,9 @@ class Uri {
   bool isSecureWebSocket() const;
   bool isFile() const;
 
+  void serialize(shared::utils::BinaryWriter& writer) const;
+  void deserialize(shared::utils::BinaryReader& reader);
+
   bool operator==(const Uri& other) const;
   bool operator!=(const Uri& other) const;
   bool operator<(const Uri& other) const;
@@ -0,0 +1,63 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   BinaryFormatException.cpp                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 00:12:40 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 00:12:40 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "domain/shared/exceptions/BinaryFormatException.hpp"
+
+#include <sstream>
+
+namespace domain {
+namespace shared {
+namespace exceptions {
+
+const std::pair<BinaryFormatException::ErrorCode, std::string>
+    BinaryFormatException::K_CODE_MSGS[] = {
+        std::make_pair(BinaryFormatException::TRUNCATED_INPUT,
+                       "Binary data ended unexpectedly"),
+        std::make_pair(BinaryFormatException::INVALID_VALUE,
+                       "Binary data holds an invalid value"),
+        std::make_pair(BinaryFormatException::LENGTH_OVERFLOW,
+                       "Binary field length exceeds the remaining data")};
+
+BinaryFormatException::BinaryFormatException(const std::string& msg,
+                                             ErrorCode code)
+    : BaseException("", static_cast<int>(code)) {
+  std::ostringstream oss;
+  oss << getErrorMsg(code) << ": " << msg;
+  this->m_whatMsg = oss.str();
+}
+
+BinaryFormatException::BinaryFormatException(const BinaryFormatException& other)
+    : BaseException(other) {}
+
+BinaryFormatException::~BinaryFormatException() throw() {}
+
+BinaryFormatException& BinaryFormatException::operator=(
+    const BinaryFormatException& other) {
+  if (this != &other) {
+    BaseException::operator=(other);
+  }
+  return *this;
+}
+
+std::string BinaryFormatException::getErrorMsg(
+    BinaryFormatException::ErrorCode code) {
+  for (int index = 0; index < CODE_COUNT; ++index) {
+    if (K_CODE_MSGS[index].first == code) {
+      return K_CODE_MSGS[index].second;
+    }
+  }
+  return "unknown binary format error";
+}
+
+}  // namespace exceptions
+}  // namespace shared
+}  // namespace domain
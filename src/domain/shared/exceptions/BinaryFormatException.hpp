@@ -0,0 +1,47 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   BinaryFormatException.hpp                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 00:12:40 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 00:12:40 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef BINARY_FORMAT_EXCEPTION_HPP
+#define BINARY_FORMAT_EXCEPTION_HPP
+
+#include "shared/exceptions/BaseException.hpp"
+
+namespace domain {
+namespace shared {
+namespace exceptions {
+
+class BinaryFormatException : public ::shared::exceptions::BaseException {
+ public:
+  enum ErrorCode {
+    TRUNCATED_INPUT,
+    INVALID_VALUE,
+    LENGTH_OVERFLOW,
+    CODE_COUNT
+  };
+
+  explicit BinaryFormatException(const std::string& msg, ErrorCode code);
+  BinaryFormatException(const BinaryFormatException& other);
+  virtual ~BinaryFormatException() throw();
+
+  BinaryFormatException& operator=(const BinaryFormatException& other);
+
+ private:
+  static const std::pair<ErrorCode, std::string> K_CODE_MSGS[];
+
+  static std::string getErrorMsg(ErrorCode code);
+};
+
+}  // namespace exceptions
+}  // namespace shared
+}  // namespace domain
+
+#endif  // BINARY_FORMAT_EXCEPTION_HPP
@@ -0,0 +1,125 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   BinaryReader.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 00:18:05 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 00:18:05 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "domain/shared/exceptions/BinaryFormatException.hpp"
+#include "domain/shared/utils/BinaryReader.hpp"
+#include "domain/shared/utils/BinaryWriter.hpp"
+
+#include <sstream>
+
+namespace domain {
+namespace shared {
+namespace utils {
+
+BinaryReader::BinaryReader(const char* data, std::size_t length)
+    : m_data(data), m_length(length), m_offset(0) {}
+
+BinaryReader::~BinaryReader() {}
+
+unsigned char BinaryReader::readU8() {
+  require(1);
+  return static_cast<unsigned char>(m_data[m_offset++]);
+}
+
+unsigned long BinaryReader::readU32() {
+  require(4);
+  unsigned long value = 0;
+  for (int shift = 0; shift < 32; shift += 8) {
+    value |= static_cast<unsigned long>(
+                 static_cast<unsigned char>(m_data[m_offset++]))
+             << shift;
+  }
+  return value;
+}
+
+std::size_t BinaryReader::readSize() {
+  require(BinaryWriter::K_SIZE_WIDTH);
+  std::size_t value = 0;
+  for (std::size_t byte = 0; byte < BinaryWriter::K_SIZE_WIDTH; ++byte) {
+    const std::size_t part =
+        static_cast<unsigned char>(m_data[m_offset + byte]);
+    if (byte >= sizeof(value)) {
+      if (part != 0) {
+        throw exceptions::BinaryFormatException(
+            "size does not fit this platform",
+            exceptions::BinaryFormatException::LENGTH_OVERFLOW);
+      }
+      continue;
+    }
+    value |= part << (byte * 8);
+  }
+  m_offset += BinaryWriter::K_SIZE_WIDTH;
+  return value;
+}
+
+bool BinaryReader::readBool() {
+  const unsigned char value = readU8();
+  if (value > 1) {
+    std::ostringstream oss;
+    oss << "boolean byte " << static_cast<unsigned int>(value) << " at offset "
+        << (m_offset - 1);
+    throw exceptions::BinaryFormatException(
+        oss.str(), exceptions::BinaryFormatException::INVALID_VALUE);
+  }
+  return value == 1;
+}
+
+std::string BinaryReader::readString() {
+  const std::size_t length = static_cast<std::size_t>(readU32());
+  return std::string(readBytes(length), length);
+}
+
+const char* BinaryReader::readBytes(std::size_t length) {
+  require(length);
+  const char* bytes = m_data + m_offset;
+  m_offset += length;
+  return bytes;
+}
+
+std::vector<std::string> BinaryReader::readStrings() {
+  const std::size_t count = readSize();
+  std::vector<std::string> values;
+  for (std::size_t i = 0; i < count; ++i) {
+    values.push_back(readString());
+  }
+  return values;
+}
+
+std::map<std::string, std::string> BinaryReader::readStringMap() {
+  const std::size_t count = readSize();
+  std::map<std::string, std::string> values;
+  for (std::size_t i = 0; i < count; ++i) {
+    const std::string key = readString();
+    values[key] = readString();
+  }
+  return values;
+}
+
+std::size_t BinaryReader::getOffset() const { return m_offset; }
+
+std::size_t BinaryReader::remaining() const { return m_length - m_offset; }
+
+bool BinaryReader::isAtEnd() const { return m_offset == m_length; }
+
+void BinaryReader::require(std::size_t length) const {
+  if (length > m_length - m_offset) {
+    std::ostringstream oss;
+    oss << length << " byte(s) requested at offset " << m_offset << " of "
+        << m_length;
+    throw exceptions::BinaryFormatException(
+        oss.str(), exceptions::BinaryFormatException::TRUNCATED_INPUT);
+  }
+}
+
+}  // namespace utils
+}  // namespace shared
+}  // namespace domain
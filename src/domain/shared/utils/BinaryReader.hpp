@@ -0,0 +1,61 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   BinaryReader.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 00:18:05 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 00:18:05 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef BINARY_READER_HPP
+#define BINARY_READER_HPP
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace domain {
+namespace shared {
+namespace utils {
+
+// Decodes the layout written by BinaryWriter from a caller-owned buffer.
+// Every read is bounds checked and throws BinaryFormatException on
+// truncated or malformed input.
+class BinaryReader {
+ public:
+  BinaryReader(const char* data, std::size_t length);
+  ~BinaryReader();
+
+  unsigned char readU8();
+  unsigned long readU32();
+  std::size_t readSize();
+  bool readBool();
+  std::string readString();
+  const char* readBytes(std::size_t length);
+  std::vector<std::string> readStrings();
+  std::map<std::string, std::string> readStringMap();
+
+  std::size_t getOffset() const;
+  std::size_t remaining() const;
+  bool isAtEnd() const;
+
+ private:
+  BinaryReader(const BinaryReader&);
+  BinaryReader& operator=(const BinaryReader&);
+
+  const char* m_data;
+  std::size_t m_length;
+  std::size_t m_offset;
+
+  void require(std::size_t length) const;
+};
+
+}  // namespace utils
+}  // namespace shared
+}  // namespace domain
+
+#endif  // BINARY_READER_HPP
@@ -0,0 +1,74 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   BinaryWriter.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 00:18:05 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 00:18:05 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "domain/shared/utils/BinaryWriter.hpp"
+
+namespace domain {
+namespace shared {
+namespace utils {
+
+BinaryWriter::BinaryWriter() {}
+
+BinaryWriter::~BinaryWriter() {}
+
+void BinaryWriter::writeU8(unsigned char value) {
+  m_buffer += static_cast<char>(value);
+}
+
+void BinaryWriter::writeU32(unsigned long value) {
+  for (int shift = 0; shift < 32; shift += 8) {
+    m_buffer += static_cast<char>((value >> shift) & 0xFF);
+  }
+}
+
+void BinaryWriter::writeSize(std::size_t value) {
+  for (std::size_t byte = 0; byte < K_SIZE_WIDTH; ++byte) {
+    m_buffer += static_cast<char>(value & 0xFF);
+    value >>= 8;
+  }
+}
+
+void BinaryWriter::writeBool(bool value) { writeU8(value ? 1 : 0); }
+
+void BinaryWriter::writeString(const std::string& value) {
+  writeU32(static_cast<unsigned long>(value.size()));
+  m_buffer.append(value);
+}
+
+void BinaryWriter::writeBytes(const char* data, std::size_t length) {
+  m_buffer.append(data, length);
+}
+
+void BinaryWriter::writeStrings(const std::vector<std::string>& values) {
+  writeSize(values.size());
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    writeString(values[i]);
+  }
+}
+
+void BinaryWriter::writeStringMap(
+    const std::map<std::string, std::string>& values) {
+  writeSize(values.size());
+  for (std::map<std::string, std::string>::const_iterator it = values.begin();
+       it != values.end(); ++it) {
+    writeString(it->first);
+    writeString(it->second);
+  }
+}
+
+const std::string& BinaryWriter::getBuffer() const { return m_buffer; }
+
+std::size_t BinaryWriter::size() const { return m_buffer.size(); }
+
+}  // namespace utils
+}  // namespace shared
+}  // namespace domain
@@ -0,0 +1,58 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   BinaryWriter.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 00:18:05 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 00:18:05 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef BINARY_WRITER_HPP
+#define BINARY_WRITER_HPP
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace domain {
+namespace shared {
+namespace utils {
+
+// Appends fixed-width little-endian integers and length-prefixed strings to a
+// byte buffer; sizes always take eight bytes whatever the platform width.
+// BinaryReader decodes the same layout.
+class BinaryWriter {
+ public:
+  static const std::size_t K_SIZE_WIDTH = 8;
+
+  BinaryWriter();
+  ~BinaryWriter();
+
+  void writeU8(unsigned char value);
+  void writeU32(unsigned long value);
+  void writeSize(std::size_t value);
+  void writeBool(bool value);
+  void writeString(const std::string& value);
+  void writeBytes(const char* data, std::size_t length);
+  void writeStrings(const std::vector<std::string>& values);
+  void writeStringMap(const std::map<std::string, std::string>& values);
+
+  const std::string& getBuffer() const;
+  std::size_t size() const;
+
+ private:
+  BinaryWriter(const BinaryWriter&);
+  BinaryWriter& operator=(const BinaryWriter&);
+
+  std::string m_buffer;
+};
+
+}  // namespace utils
+}  // namespace shared
+}  // namespace domain
+
+#endif  // BINARY_WRITER_HPP
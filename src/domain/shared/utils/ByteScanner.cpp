@@ -0,0 +1,279 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ByteScanner.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 12:20:05 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 12:20:05 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "domain/shared/utils/ByteScanner.hpp"
+
+#if !defined(WEBSERV_SCALAR_SCAN) && defined(__AVX2__)
+#include <immintrin.h>
+#define BYTE_SCANNER_AVX2
+#elif !defined(WEBSERV_SCALAR_SCAN) && defined(__SSE2__)
+#include <emmintrin.h>
+#define BYTE_SCANNER_SSE2
+#endif
+
+namespace domain {
+namespace shared {
+namespace utils {
+
+const std::size_t ByteScanner::NPOS;
+
+namespace {
+
+const char ASCII_CARRIAGE_RETURN = '\r';
+const char ASCII_LINE_FEED = '\n';
+const char ASCII_CASE_BIT = 0x20;
+const char ASCII_FIRST_VISIBLE = 0x21;
+const char ASCII_DELETE = 0x7F;
+
+#if defined(BYTE_SCANNER_AVX2)
+
+typedef __m256i Vector;
+const std::size_t K_VECTOR_WIDTH = 32;
+
+inline Vector loadVector(const char* ptr) {
+  return _mm256_loadu_si256(reinterpret_cast<const Vector*>(ptr));
+}
+inline void storeVector(char* ptr, Vector value) {
+  _mm256_storeu_si256(reinterpret_cast<Vector*>(ptr), value);
+}
+inline Vector splat(char chr) { return _mm256_set1_epi8(chr); }
+inline Vector equal(Vector lhs, Vector rhs) {
+  return _mm256_cmpeq_epi8(lhs, rhs);
+}
+inline Vector greater(Vector lhs, Vector rhs) {
+  return _mm256_cmpgt_epi8(lhs, rhs);
+}
+inline Vector bitAnd(Vector lhs, Vector rhs) {
+  return _mm256_and_si256(lhs, rhs);
+}
+inline Vector bitOr(Vector lhs, Vector rhs) {
+  return _mm256_or_si256(lhs, rhs);
+}
+inline unsigned int moveMask(Vector value) {
+  return static_cast<unsigned int>(_mm256_movemask_epi8(value));
+}
+
+#elif defined(BYTE_SCANNER_SSE2)
+
+typedef __m128i Vector;
+const std::size_t K_VECTOR_WIDTH = 16;
+
+inline Vector loadVector(const char* ptr) {
+  return _mm_loadu_si128(reinterpret_cast<const Vector*>(ptr));
+}
+inline void storeVector(char* ptr, Vector value) {
+  _mm_storeu_si128(reinterpret_cast<Vector*>(ptr), value);
+}
+inline Vector splat(char chr) { return _mm_set1_epi8(chr); }
+inline Vector equal(Vector lhs, Vector rhs) { return _mm_cmpeq_epi8(lhs, rhs); }
+inline Vector greater(Vector lhs, Vector rhs) {
+  return _mm_cmpgt_epi8(lhs, rhs);
+}
+inline Vector bitAnd(Vector lhs, Vector rhs) { return _mm_and_si128(lhs, rhs); }
+inline Vector bitOr(Vector lhs, Vector rhs) { return _mm_or_si128(lhs, rhs); }
+inline unsigned int moveMask(Vector value) {
+  return static_cast<unsigned int>(_mm_movemask_epi8(value));
+}
+
+#endif
+
+#if defined(BYTE_SCANNER_AVX2) || defined(BYTE_SCANNER_SSE2)
+
+// Signed byte compares: bytes >= 0x80 are negative and never fall inside
+// an ASCII range, which is what every caller wants.
+inline Vector inRange(Vector value, char low, char high) {
+  return bitAnd(greater(value, splat(static_cast<char>(low - 1))),
+                greater(splat(static_cast<char>(high + 1)), value));
+}
+
+inline std::size_t firstSetBit(unsigned int mask) {
+  return static_cast<std::size_t>(__builtin_ctz(mask));
+}
+
+inline Vector invalidTokenMask(Vector value) {
+  Vector invalid = greater(splat(ASCII_FIRST_VISIBLE), value);
+  invalid = bitOr(invalid, equal(value, splat(ASCII_DELETE)));
+  invalid = bitOr(invalid, equal(value, splat('"')));
+  invalid = bitOr(invalid, inRange(value, '(', ')'));
+  invalid = bitOr(invalid, equal(value, splat(',')));
+  invalid = bitOr(invalid, equal(value, splat('/')));
+  invalid = bitOr(invalid, inRange(value, ':', '@'));
+  invalid = bitOr(invalid, inRange(value, '[', ']'));
+  invalid = bitOr(invalid, equal(value, splat('{')));
+  invalid = bitOr(invalid, equal(value, splat('}')));
+  return invalid;
+}
+
+#endif
+
+}  // namespace
+
+std::size_t ByteScanner::findCrlf(const char* data, std::size_t length) {
+#if defined(BYTE_SCANNER_AVX2) || defined(BYTE_SCANNER_SSE2)
+  const Vector carriageReturn = splat(ASCII_CARRIAGE_RETURN);
+  const Vector lineFeed = splat(ASCII_LINE_FEED);
+  std::size_t index = 0;
+
+  for (; index + K_VECTOR_WIDTH < length; index += K_VECTOR_WIDTH) {
+    const unsigned int mask = moveMask(
+        bitAnd(equal(loadVector(data + index), carriageReturn),
+               equal(loadVector(data + index + 1), lineFeed)));
+    if (mask != 0) {
+      return index + firstSetBit(mask);
+    }
+  }
+
+  const std::size_t tail = findCrlfScalar(data + index, length - index);
+  return tail == NPOS ? NPOS : index + tail;
+#else
+  return findCrlfScalar(data, length);
+#endif
+}
+
+std::size_t ByteScanner::findByte(const char* data, std::size_t length,
+                                  char byte) {
+#if defined(BYTE_SCANNER_AVX2) || defined(BYTE_SCANNER_SSE2)
+  const Vector needle = splat(byte);
+  std::size_t index = 0;
+
+  for (; index + K_VECTOR_WIDTH <= length; index += K_VECTOR_WIDTH) {
+    const unsigned int mask = moveMask(equal(loadVector(data + index), needle));
+    if (mask != 0) {
+      return index + firstSetBit(mask);
+    }
+  }
+
+  const std::size_t tail = findByteScalar(data + index, length - index, byte);
+  return tail == NPOS ? NPOS : index + tail;
+#else
+  return findByteScalar(data, length, byte);
+#endif
+}
+
+std::size_t ByteScanner::findInvalidTokenChar(const char* data,
+                                              std::size_t length) {
+#if defined(BYTE_SCANNER_AVX2) || defined(BYTE_SCANNER_SSE2)
+  std::size_t index = 0;
+
+  for (; index + K_VECTOR_WIDTH <= length; index += K_VECTOR_WIDTH) {
+    const unsigned int mask =
+        moveMask(invalidTokenMask(loadVector(data + index)));
+    if (mask != 0) {
+      return index + firstSetBit(mask);
+    }
+  }
+
+  const std::size_t tail =
+      findInvalidTokenCharScalar(data + index, length - index);
+  return tail == NPOS ? NPOS : index + tail;
+#else
+  return findInvalidTokenCharScalar(data, length);
+#endif
+}
+
+void ByteScanner::toLowerAscii(char* data, std::size_t length) {
+#if defined(BYTE_SCANNER_AVX2) || defined(BYTE_SCANNER_SSE2)
+  const Vector caseBit = splat(ASCII_CASE_BIT);
+  std::size_t index = 0;
+
+  for (; index + K_VECTOR_WIDTH <= length; index += K_VECTOR_WIDTH) {
+    const Vector value = loadVector(data + index);
+    const Vector upper = inRange(value, 'A', 'Z');
+    storeVector(data + index, bitOr(value, bitAnd(upper, caseBit)));
+  }
+
+  toLowerAsciiScalar(data + index, length - index);
+#else
+  toLowerAsciiScalar(data, length);
+#endif
+}
+
+std::size_t ByteScanner::findCrlfScalar(const char* data, std::size_t length) {
+  for (std::size_t i = 0; i + 1 < length; ++i) {
+    if (data[i] == ASCII_CARRIAGE_RETURN && data[i + 1] == ASCII_LINE_FEED) {
+      return i;
+    }
+  }
+  return NPOS;
+}
+
+std::size_t ByteScanner::findByteScalar(const char* data, std::size_t length,
+                                        char byte) {
+  for (std::size_t i = 0; i < length; ++i) {
+    if (data[i] == byte) {
+      return i;
+    }
+  }
+  return NPOS;
+}
+
+std::size_t ByteScanner::findInvalidTokenCharScalar(const char* data,
+                                                    std::size_t length) {
+  for (std::size_t i = 0; i < length; ++i) {
+    if (!isTokenChar(static_cast<unsigned char>(data[i]))) {
+      return i;
+    }
+  }
+  return NPOS;
+}
+
+void ByteScanner::toLowerAsciiScalar(char* data, std::size_t length) {
+  for (std::size_t i = 0; i < length; ++i) {
+    if (data[i] >= 'A' && data[i] <= 'Z') {
+      data[i] = static_cast<char>(data[i] | ASCII_CASE_BIT);
+    }
+  }
+}
+
+bool ByteScanner::isTokenChar(unsigned char chr) {
+  if (chr < static_cast<unsigned char>(ASCII_FIRST_VISIBLE) ||
+      chr >= static_cast<unsigned char>(ASCII_DELETE)) {
+    return false;
+  }
+
+  switch (chr) {
+    case '"':
+    case '(':
+    case ')':
+    case ',':
+    case '/':
+    case ':':
+    case ';':
+    case '<':
+    case '=':
+    case '>':
+    case '?':
+    case '@':
+    case '[':
+    case '\\':
+    case ']':
+    case '{':
+    case '}':
+      return false;
+    default:
+      return true;
+  }
+}
+
+const char* ByteScanner::getBackendName() {
+#if defined(BYTE_SCANNER_AVX2)
+  return "avx2";
+#elif defined(BYTE_SCANNER_SSE2)
+  return "sse2";
+#else
+  return "scalar";
+#endif
+}
+
+}  // namespace utils
+}  // namespace shared
+}  // namespace domain
@@ -0,0 +1,54 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ByteScanner.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 12:20:05 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 12:20:05 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef BYTE_SCANNER_HPP
+#define BYTE_SCANNER_HPP
+
+#include <cstddef>
+
+namespace domain {
+namespace shared {
+namespace utils {
+
+class ByteScanner {
+ public:
+  static const std::size_t NPOS = static_cast<std::size_t>(-1);
+
+  static std::size_t findCrlf(const char* data, std::size_t length);
+  static std::size_t findByte(const char* data, std::size_t length, char byte);
+  static std::size_t findInvalidTokenChar(const char* data,
+                                          std::size_t length);
+  static void toLowerAscii(char* data, std::size_t length);
+
+  static std::size_t findCrlfScalar(const char* data, std::size_t length);
+  static std::size_t findByteScalar(const char* data, std::size_t length,
+                                    char byte);
+  static std::size_t findInvalidTokenCharScalar(const char* data,
+                                                std::size_t length);
+  static void toLowerAsciiScalar(char* data, std::size_t length);
+
+  static bool isTokenChar(unsigned char chr);
+  static const char* getBackendName();
+
+ private:
+  ByteScanner();
+  ByteScanner(const ByteScanner&);
+  ~ByteScanner();
+
+  ByteScanner& operator=(const ByteScanner&);
+};
+
+}  // namespace utils
+}  // namespace shared
+}  // namespace domain
+
+#endif  // BYTE_SCANNER_HPP
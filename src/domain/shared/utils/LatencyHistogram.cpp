@@ -0,0 +1,191 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   LatencyHistogram.cpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 03:12:40 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 03:12:40 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "domain/shared/utils/LatencyHistogram.hpp"
+
+namespace domain {
+namespace shared {
+namespace utils {
+
+namespace {
+
+const std::size_t K_LINEAR_LIMIT = LatencyHistogram::K_SUB_BUCKETS * 2;
+const std::size_t K_BUCKET_COUNT =
+    K_LINEAR_LIMIT +
+    (LatencyHistogram::K_MAX_MAGNITUDE - LatencyHistogram::K_SUB_BUCKET_BITS) *
+        LatencyHistogram::K_SUB_BUCKETS;
+const unsigned long K_MAX_TRACKABLE =
+    (1ul << (LatencyHistogram::K_MAX_MAGNITUDE + 1)) - 1;
+const double K_HUNDRED_PERCENT = 100.0;
+const double K_RANK_EPSILON = 1e-6;
+
+}  // namespace
+
+const unsigned int LatencyHistogram::K_SUB_BUCKET_BITS;
+const std::size_t LatencyHistogram::K_SUB_BUCKETS;
+const unsigned int LatencyHistogram::K_MAX_MAGNITUDE;
+
+LatencyHistogram::LatencyHistogram()
+    : m_counts(K_BUCKET_COUNT, 0), m_total(0), m_min(0), m_max(0), m_sum(0) {}
+
+LatencyHistogram::~LatencyHistogram() {}
+
+void LatencyHistogram::record(unsigned long value) { recordMany(value, 1); }
+
+void LatencyHistogram::recordMany(unsigned long value, unsigned long count) {
+  if (count == 0) {
+    return;
+  }
+  m_counts[bucketIndexFor(value)] += count;
+  if (m_total == 0 || value < m_min) {
+    m_min = value;
+  }
+  if (value > m_max) {
+    m_max = value;
+  }
+  m_total += count;
+  m_sum += static_cast<double>(value) * static_cast<double>(count);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+  if (other.m_total == 0) {
+    return;
+  }
+  for (std::size_t i = 0; i < m_counts.size(); ++i) {
+    m_counts[i] += other.m_counts[i];
+  }
+  if (m_total == 0 || other.m_min < m_min) {
+    m_min = other.m_min;
+  }
+  if (other.m_max > m_max) {
+    m_max = other.m_max;
+  }
+  m_total += other.m_total;
+  m_sum += other.m_sum;
+}
+
+void LatencyHistogram::reset() {
+  m_counts.assign(K_BUCKET_COUNT, 0);
+  m_total = 0;
+  m_min = 0;
+  m_max = 0;
+  m_sum = 0;
+}
+
+unsigned long LatencyHistogram::getCount() const { return m_total; }
+
+unsigned long LatencyHistogram::getMin() const { return m_min; }
+
+unsigned long LatencyHistogram::getMax() const { return m_max; }
+
+double LatencyHistogram::getMean() const {
+  if (m_total == 0) {
+    return 0;
+  }
+  return m_sum / static_cast<double>(m_total);
+}
+
+// Reports the top of the bucket holding the requested rank, capped at the
+// largest value seen, so a percentile never understates the latency.
+unsigned long LatencyHistogram::valueAtPercentile(double percentile) const {
+  if (m_total == 0) {
+    return 0;
+  }
+  if (percentile >= K_HUNDRED_PERCENT) {
+    return m_max;
+  }
+  if (percentile < 0) {
+    percentile = 0;
+  }
+
+  const double exactRank =
+      percentile * static_cast<double>(m_total) / K_HUNDRED_PERCENT;
+  unsigned long rank = static_cast<unsigned long>(exactRank);
+  if (exactRank - static_cast<double>(rank) > K_RANK_EPSILON) {
+    ++rank;
+  }
+  if (rank == 0) {
+    rank = 1;
+  }
+
+  unsigned long seen = 0;
+  for (std::size_t i = 0; i < m_counts.size(); ++i) {
+    seen += m_counts[i];
+    if (seen >= rank) {
+      const unsigned long upper = bucketUpperBound(i);
+      return upper < m_max ? upper : m_max;
+    }
+  }
+  return m_max;
+}
+
+// Counts whole buckets, so values sharing the bucket of `value` are included
+// even when slightly above it; exact below 2 * K_SUB_BUCKETS.
+unsigned long LatencyHistogram::countAtOrBelow(unsigned long value) const {
+  if (m_total == 0 || value >= m_max) {
+    return m_total;
+  }
+  if (value < m_min) {
+    return 0;
+  }
+
+  const std::size_t last = bucketIndexFor(value);
+  unsigned long seen = 0;
+  for (std::size_t i = 0; i <= last; ++i) {
+    seen += m_counts[i];
+  }
+  return seen;
+}
+
+std::size_t LatencyHistogram::getBucketCount() const { return m_counts.size(); }
+
+unsigned long LatencyHistogram::getBucketCountAt(std::size_t index) const {
+  return index < m_counts.size() ? m_counts[index] : 0;
+}
+
+std::size_t LatencyHistogram::bucketIndexFor(unsigned long value) {
+  if (value < K_LINEAR_LIMIT) {
+    return static_cast<std::size_t>(value);
+  }
+  if (value > K_MAX_TRACKABLE) {
+    value = K_MAX_TRACKABLE;
+  }
+  const unsigned int shift = magnitudeOf(value) - K_SUB_BUCKET_BITS;
+  const std::size_t subBucket = static_cast<std::size_t>(value >> shift);
+  return K_LINEAR_LIMIT + (shift - 1) * K_SUB_BUCKETS +
+         (subBucket - K_SUB_BUCKETS);
+}
+
+unsigned long LatencyHistogram::bucketUpperBound(std::size_t index) {
+  if (index < K_LINEAR_LIMIT) {
+    return static_cast<unsigned long>(index);
+  }
+  const std::size_t offset = index - K_LINEAR_LIMIT;
+  const unsigned int shift =
+      static_cast<unsigned int>(offset / K_SUB_BUCKETS) + 1;
+  const unsigned long subBucket =
+      static_cast<unsigned long>(offset % K_SUB_BUCKETS + K_SUB_BUCKETS);
+  return ((subBucket + 1) << shift) - 1;
+}
+
+unsigned int LatencyHistogram::magnitudeOf(unsigned long value) {
+  unsigned int magnitude = 0;
+  while (value > 1) {
+    value >>= 1;
+    ++magnitude;
+  }
+  return magnitude;
+}
+
+}  // namespace utils
+}  // namespace shared
+}  // namespace domain
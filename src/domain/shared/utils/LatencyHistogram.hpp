@@ -0,0 +1,68 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   LatencyHistogram.hpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 03:12:40 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 03:12:40 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef LATENCY_HISTOGRAM_HPP
+#define LATENCY_HISTOGRAM_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace domain {
+namespace shared {
+namespace utils {
+
+// Log-linear histogram in the style of HdrHistogram: values below
+// 2 * K_SUB_BUCKETS are counted exactly, larger ones fall into power-of-two
+// ranges split into K_SUB_BUCKETS linear steps, so any recorded value is
+// reported within 1/K_SUB_BUCKETS of its true size. Values past the last
+// range are clamped into it. Units are whatever the caller records.
+class LatencyHistogram {
+ public:
+  static const unsigned int K_SUB_BUCKET_BITS = 6;
+  static const std::size_t K_SUB_BUCKETS = 1u << K_SUB_BUCKET_BITS;
+  static const unsigned int K_MAX_MAGNITUDE = 40;
+
+  LatencyHistogram();
+  ~LatencyHistogram();
+
+  void record(unsigned long value);
+  void recordMany(unsigned long value, unsigned long count);
+  void merge(const LatencyHistogram& other);
+  void reset();
+
+  unsigned long getCount() const;
+  unsigned long getMin() const;
+  unsigned long getMax() const;
+  double getMean() const;
+  unsigned long valueAtPercentile(double percentile) const;
+  unsigned long countAtOrBelow(unsigned long value) const;
+
+  std::size_t getBucketCount() const;
+  unsigned long getBucketCountAt(std::size_t index) const;
+  static std::size_t bucketIndexFor(unsigned long value);
+  static unsigned long bucketUpperBound(std::size_t index);
+
+ private:
+  std::vector<unsigned long> m_counts;
+  unsigned long m_total;
+  unsigned long m_min;
+  unsigned long m_max;
+  double m_sum;
+
+  static unsigned int magnitudeOf(unsigned long value);
+};
+
+}  // namespace utils
+}  // namespace shared
+}  // namespace domain
+
+#endif  // LATENCY_HISTOGRAM_HPP
@@ -195,10 +195,16 @@ ErrorCode ErrorCode::internalServerError() {
   return ErrorCode(STATUS_INTERNAL_SERVER_ERROR);
 }
 
+ErrorCode ErrorCode::badGateway() { return ErrorCode(STATUS_BAD_GATEWAY); }
+
 ErrorCode ErrorCode::serviceUnavailable() {
   return ErrorCode(STATUS_SERVICE_UNAVAILABLE);
 }
 
+ErrorCode ErrorCode::gatewayTimeout() {
+  return ErrorCode(STATUS_GATEWAY_TIMEOUT);
+}
+
 ErrorCode ErrorCode::ok() { return ErrorCode(STATUS_OK); }
 
 ErrorCode ErrorCode::created() { return ErrorCode(STATUS_CREATED); }
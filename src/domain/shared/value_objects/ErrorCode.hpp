@@ -128,7 +128,9 @@ class ErrorCode {
   static ErrorCode methodNotAllowed();
   static ErrorCode payloadTooLarge();
   static ErrorCode internalServerError();
+  static ErrorCode badGateway();
   static ErrorCode serviceUnavailable();
+  static ErrorCode gatewayTimeout();
 
   static ErrorCode ok();
   static ErrorCode created();
@@ -0,0 +1,583 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ResponseCache.cpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:02:18 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:02:18 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "domain/shared/exceptions/BinaryFormatException.hpp"
+#include "domain/shared/utils/BinaryReader.hpp"
+#include "domain/shared/utils/BinaryWriter.hpp"
+#include "infrastructure/cache/adapters/ResponseCache.hpp"
+#include "infrastructure/cache/primitives/CacheKey.hpp"
+#include "infrastructure/filesystem/adapters/FileSystemHelper.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace infrastructure {
+namespace cache {
+namespace adapters {
+
+namespace {
+
+const std::size_t K_PREFIX_LENGTH = ResponseCache::K_MAGIC_LENGTH + 4;
+const std::size_t K_MAX_HEADER_BLOCK = 1024 * 1024;
+const std::size_t K_READ_CHUNK = 65536;
+const char K_TEMP_SUFFIX[] = ".tmp";
+const mode_t K_FILE_MODE = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
+
+bool readExactly(int fd, std::size_t length, std::string& out) {
+  out.resize(length);
+  std::size_t done = 0;
+  while (done < length) {
+    const ssize_t got = ::read(fd, &out[done], length - done);
+    if (got < 0 && errno == EINTR) {
+      continue;
+    }
+    if (got <= 0) {
+      return false;
+    }
+    done += static_cast<std::size_t>(got);
+  }
+  return true;
+}
+
+bool hasSuffix(const std::string& name, const char* suffix) {
+  const std::size_t length = std::strlen(suffix);
+  return name.size() >= length &&
+         name.compare(name.size() - length, length, suffix) == 0;
+}
+
+bool isMoreRecent(const std::pair<std::time_t, std::size_t>& left,
+                  const std::pair<std::time_t, std::size_t>& right) {
+  return left.first > right.first;
+}
+
+}  // namespace
+
+const char ResponseCache::K_MAGIC[] = "WSRC";
+const std::size_t ResponseCache::K_MAGIC_LENGTH;
+const unsigned long ResponseCache::K_FORMAT_VERSION;
+
+ResponseCache::Response::Response() : status(0) {}
+
+ResponseCache::Zone::Zone(
+    const domain::configuration::value_objects::CacheZoneConfig& zoneConfig)
+    : config(zoneConfig), storedBytes(0) {}
+
+// ============================================================================
+// Fill
+// ============================================================================
+
+ResponseCache::Fill::Fill(ResponseCache& cache, const std::string& zone,
+                          const std::string& zonePath, const std::string& key,
+                          const std::string& path, const std::string& tempPath,
+                          int fd, std::time_t expires)
+    : m_cache(cache),
+      m_zone(zone),
+      m_zonePath(zonePath),
+      m_key(key),
+      m_path(path),
+      m_tempPath(tempPath),
+      m_fd(fd),
+      m_expires(expires),
+      m_size(0),
+      m_failed(false),
+      m_done(false) {}
+
+ResponseCache::Fill::~Fill() { abort(); }
+
+bool ResponseCache::Fill::append(const char* data, std::size_t length) {
+  if (m_failed || m_done) {
+    return false;
+  }
+  if (!writeAll(m_fd, data, length)) {
+    m_failed = true;
+    return false;
+  }
+  m_size += length;
+  return true;
+}
+
+bool ResponseCache::Fill::commit() {
+  if (m_done) {
+    return false;
+  }
+  m_done = true;
+  ::close(m_fd);
+  m_fd = -1;
+  const bool stored = !m_failed && m_cache.commitFill(*this);
+  if (!stored) {
+    ::unlink(m_tempPath.c_str());
+  }
+  m_cache.finishFill();
+  return stored;
+}
+
+void ResponseCache::Fill::abort() {
+  if (m_done) {
+    return;
+  }
+  m_done = true;
+  ::close(m_fd);
+  m_fd = -1;
+  ::unlink(m_tempPath.c_str());
+  m_cache.finishFill();
+}
+
+std::size_t ResponseCache::Fill::getSize() const { return m_size; }
+
+// ============================================================================
+// ResponseCache
+// ============================================================================
+
+ResponseCache::ResponseCache(application::ports::ILogger& logger)
+    : m_logger(logger),
+      m_generation(0),
+      m_hits(0),
+      m_misses(0),
+      m_stores(0),
+      m_tempSequence(0) {}
+
+ResponseCache::~ResponseCache() {
+  for (ZoneMap::iterator it = m_zones.begin(); it != m_zones.end(); ++it) {
+    delete it->second;
+  }
+}
+
+// A zone whose path and levels are unchanged keeps its index across a
+// reload; any other zone is indexed from disk again.
+void ResponseCache::configure(
+    const domain::configuration::entities::HttpConfig::CacheZones& zones,
+    std::time_t now) {
+  ZoneMap next;
+  for (domain::configuration::entities::HttpConfig::CacheZones::const_iterator
+           it = zones.begin();
+       it != zones.end(); ++it) {
+    ZoneMap::iterator current = m_zones.find(it->first);
+    if (current != m_zones.end() &&
+        current->second->config.getPath() == it->second.getPath() &&
+        current->second->config.getLevels() == it->second.getLevels()) {
+      current->second->config = it->second;
+      next[it->first] = current->second;
+      m_zones.erase(current);
+      continue;
+    }
+
+    try {
+      filesystem::adapters::FileSystemHelper::createDirectoryRecursive(
+          it->second.getPath());
+    } catch (const std::exception& e) {
+      m_logger.error("Cache zone '" + it->first + "' disabled: " + e.what());
+      continue;
+    }
+    Zone* zone = new Zone(it->second);
+    load(*zone);
+    next[it->first] = zone;
+  }
+
+  for (ZoneMap::iterator it = m_zones.begin(); it != m_zones.end(); ++it) {
+    delete it->second;
+  }
+  m_zones.swap(next);
+  evict(now);
+  ++m_generation;
+}
+
+bool ResponseCache::hasZone(const std::string& zone) const {
+  return findZone(zone) != NULL;
+}
+
+// An expired entry stays indexed until it is replaced or evicted; it is
+// reported so the caller can log EXPIRED rather than MISS.
+ResponseCache::Status ResponseCache::lookup(const std::string& zone,
+                                            const std::string& key,
+                                            std::time_t now,
+                                            Response& response) {
+  Zone* found = findZone(zone);
+  Index::iterator entry =
+      found != NULL ? found->index.find(key) : Index::iterator();
+  if (found == NULL || entry == found->index.end()) {
+    ++m_misses;
+    return STATUS_MISS;
+  }
+  if (entry->second.expires <= now) {
+    ++m_misses;
+    return STATUS_EXPIRED;
+  }
+
+  std::string storedKey;
+  std::time_t expires = 0;
+  std::size_t size = 0;
+  const std::string path = entryPath(found->config, key);
+  const bool readable = readEntry(path, storedKey, expires, size, &response);
+  if (!readable || storedKey != key) {
+    m_logger.warn("Dropping unreadable cache entry " + path);
+    remove(*found, entry, !readable);
+    ++m_misses;
+    return STATUS_MISS;
+  }
+
+  entry->second.lastAccess = now;
+  found->lru.splice(found->lru.begin(), found->lru,
+                    entry->second.lruPosition);
+  ++m_hits;
+  return STATUS_HIT;
+}
+
+bool ResponseCache::lock(const std::string& zone, const std::string& key) {
+  Zone* found = findZone(zone);
+  return found != NULL && found->locks.insert(key).second;
+}
+
+void ResponseCache::unlock(const std::string& zone, const std::string& key) {
+  Zone* found = findZone(zone);
+  if (found != NULL && found->locks.erase(key) != 0) {
+    ++m_generation;
+  }
+}
+
+bool ResponseCache::isLocked(const std::string& zone,
+                             const std::string& key) const {
+  Zone* found = findZone(zone);
+  return found != NULL && found->locks.count(key) != 0;
+}
+
+// NULL when the zone is unknown or the entry file cannot be created; the
+// response is then served without being stored.
+ResponseCache::Fill* ResponseCache::startFill(const std::string& zone,
+                                              const std::string& key,
+                                              unsigned int status,
+                                              const HeaderMap& headers,
+                                              std::time_t expires) {
+  Zone* found = findZone(zone);
+  if (found == NULL) {
+    return NULL;
+  }
+
+  const std::string path = entryPath(found->config, key);
+  std::ostringstream temp;
+  temp << path << "." << ++m_tempSequence << K_TEMP_SUFFIX;
+  try {
+    filesystem::adapters::FileSystemHelper::createDirectoryRecursive(
+        path.substr(0, path.rfind('/')));
+  } catch (const std::exception& e) {
+    m_logger.warn(std::string("Cannot store cache entry: ") + e.what());
+    return NULL;
+  }
+
+  const int fd =
+      ::open(temp.str().c_str(), O_WRONLY | O_CREAT | O_TRUNC, K_FILE_MODE);
+  if (fd < 0) {
+    m_logger.warn("Cannot create cache file " + temp.str() + ": " +
+                  std::strerror(errno));
+    return NULL;
+  }
+
+  const std::string header = encodeHeader(key, status, expires, headers);
+  if (!writeAll(fd, header.data(), header.size())) {
+    ::close(fd);
+    ::unlink(temp.str().c_str());
+    m_logger.warn("Cannot write cache file " + temp.str());
+    return NULL;
+  }
+  return new Fill(*this, zone, found->config.getPath(), key, path, temp.str(),
+                  fd, expires);
+}
+
+// Entries unused for longer than the zone's inactive time go first; then
+// the least recently used ones until the zone is back under max_size.
+void ResponseCache::evict(std::time_t now) {
+  for (ZoneMap::iterator it = m_zones.begin(); it != m_zones.end(); ++it) {
+    Zone& zone = *it->second;
+    const std::time_t inactive =
+        static_cast<std::time_t>(zone.config.getInactive());
+    while (!zone.lru.empty()) {
+      Index::iterator oldest = zone.index.find(zone.lru.back());
+      if (oldest->second.lastAccess + inactive > now) {
+        break;
+      }
+      remove(zone, oldest, true);
+    }
+
+    const std::size_t maxSize = zone.config.getMaxSize();
+    while (maxSize != 0 && zone.storedBytes > maxSize && !zone.lru.empty()) {
+      remove(zone, zone.index.find(zone.lru.back()), true);
+    }
+  }
+}
+
+unsigned long ResponseCache::getGeneration() const { return m_generation; }
+
+unsigned long ResponseCache::getHitCount() const { return m_hits; }
+
+unsigned long ResponseCache::getMissCount() const { return m_misses; }
+
+unsigned long ResponseCache::getStoreCount() const { return m_stores; }
+
+std::size_t ResponseCache::getEntryCount() const {
+  std::size_t count = 0;
+  for (ZoneMap::const_iterator it = m_zones.begin(); it != m_zones.end();
+       ++it) {
+    count += it->second->index.size();
+  }
+  return count;
+}
+
+std::size_t ResponseCache::getStoredBytes() const {
+  std::size_t bytes = 0;
+  for (ZoneMap::const_iterator it = m_zones.begin(); it != m_zones.end();
+       ++it) {
+    bytes += it->second->storedBytes;
+  }
+  return bytes;
+}
+
+// levels=1:2 stores the key hashing to "...b7f29c" as "<path>/c/29/<hash>":
+// each level takes its digits from the end of the hash, as nginx does.
+std::string ResponseCache::entryPath(
+    const domain::configuration::value_objects::CacheZoneConfig& zone,
+    const std::string& key) {
+  const std::string hash = primitives::CacheKey::hash(key);
+  std::string path = zone.getPath();
+  std::size_t end = hash.size();
+  const domain::configuration::value_objects::CacheZoneConfig::Levels& levels =
+      zone.getLevels();
+  for (std::size_t i = 0; i < levels.size(); ++i) {
+    end -= levels[i];
+    path += "/" + hash.substr(end, levels[i]);
+  }
+  return path + "/" + hash;
+}
+
+ResponseCache::Zone* ResponseCache::findZone(const std::string& name) const {
+  ZoneMap::const_iterator it = m_zones.find(name);
+  return it != m_zones.end() ? it->second : NULL;
+}
+
+// Leftover temporary files and entries that cannot be read, or that sit
+// where the current levels would not put them, are removed.
+void ResponseCache::load(Zone& zone) {
+  std::vector<LoadedEntry> found;
+  scanDirectory(zone, zone.config.getPath(), 0, found);
+
+  std::vector<std::pair<std::time_t, std::size_t> > order;
+  for (std::size_t i = 0; i < found.size(); ++i) {
+    order.push_back(std::make_pair(found[i].lastAccess, i));
+  }
+  std::stable_sort(order.begin(), order.end(), isMoreRecent);
+  for (std::size_t i = order.size(); i > 0; --i) {
+    const LoadedEntry& entry = found[order[i - 1].second];
+    insert(zone, entry.key, entry.expires, entry.lastAccess, entry.size);
+  }
+
+  if (!found.empty()) {
+    std::ostringstream oss;
+    oss << "Cache zone '" << zone.config.getName() << "' loaded "
+        << found.size() << " entries (" << zone.storedBytes << " bytes)";
+    m_logger.info(oss.str());
+  }
+}
+
+void ResponseCache::scanDirectory(const Zone& zone,
+                                  const std::string& directory,
+                                  std::size_t depth,
+                                  std::vector<LoadedEntry>& found) {
+  DIR* dir = ::opendir(directory.c_str());
+  if (dir == NULL) {
+    return;
+  }
+
+  struct dirent* item;
+  while ((item = ::readdir(dir)) != NULL) {
+    const std::string name = item->d_name;
+    if (name == "." || name == "..") {
+      continue;
+    }
+    const std::string path = directory + "/" + name;
+    struct stat info;
+    if (::lstat(path.c_str(), &info) != 0) {
+      continue;
+    }
+    if (S_ISDIR(info.st_mode)) {
+      if (depth <
+          domain::configuration::value_objects::CacheZoneConfig::MAX_LEVELS) {
+        scanDirectory(zone, path, depth + 1, found);
+      }
+      continue;
+    }
+    if (!S_ISREG(info.st_mode)) {
+      continue;
+    }
+
+    LoadedEntry entry;
+    if (hasSuffix(name, K_TEMP_SUFFIX) ||
+        !readEntry(path, entry.key, entry.expires, entry.size, NULL) ||
+        entryPath(zone.config, entry.key) != path) {
+      ::unlink(path.c_str());
+      continue;
+    }
+    entry.lastAccess = info.st_mtime;
+    found.push_back(entry);
+  }
+  ::closedir(dir);
+}
+
+void ResponseCache::insert(Zone& zone, const std::string& key,
+                           std::time_t expires, std::time_t lastAccess,
+                           std::size_t size) {
+  Index::iterator existing = zone.index.find(key);
+  if (existing != zone.index.end()) {
+    remove(zone, existing, false);
+  }
+  Entry& entry = zone.index[key];
+  entry.expires = expires;
+  entry.lastAccess = lastAccess;
+  entry.size = size;
+  zone.lru.push_front(key);
+  entry.lruPosition = zone.lru.begin();
+  zone.storedBytes += size;
+}
+
+void ResponseCache::remove(Zone& zone, Index::iterator entry,
+                           bool removeFile) {
+  if (removeFile) {
+    ::unlink(entryPath(zone.config, entry->first).c_str());
+  }
+  zone.storedBytes -= entry->second.size;
+  zone.lru.erase(entry->second.lruPosition);
+  zone.index.erase(entry);
+}
+
+// The zone may have been dropped or moved by a reload while the fill ran;
+// the entry is then discarded.
+bool ResponseCache::commitFill(Fill& fill) {
+  Zone* zone = findZone(fill.m_zone);
+  if (zone == NULL || zone->config.getPath() != fill.m_zonePath ||
+      entryPath(zone->config, fill.m_key) != fill.m_path) {
+    return false;
+  }
+  if (::rename(fill.m_tempPath.c_str(), fill.m_path.c_str()) != 0) {
+    m_logger.warn("Cannot store cache file " + fill.m_path + ": " +
+                  std::strerror(errno));
+    return false;
+  }
+
+  struct stat info;
+  const std::size_t size = ::stat(fill.m_path.c_str(), &info) == 0
+                               ? static_cast<std::size_t>(info.st_size)
+                               : fill.m_size;
+  insert(*zone, fill.m_key, fill.m_expires, std::time(NULL), size);
+  ++m_stores;
+  return true;
+}
+
+void ResponseCache::finishFill() { ++m_generation; }
+
+// magic, header length, then the header block: format version, key,
+// status, expiry and the response headers.
+std::string ResponseCache::encodeHeader(const std::string& key,
+                                        unsigned int status,
+                                        std::time_t expires,
+                                        const HeaderMap& headers) {
+  domain::shared::utils::BinaryWriter block;
+  block.writeU32(K_FORMAT_VERSION);
+  block.writeString(key);
+  block.writeU32(status);
+  block.writeSize(static_cast<std::size_t>(expires));
+  block.writeStringMap(headers);
+
+  domain::shared::utils::BinaryWriter prefix;
+  prefix.writeBytes(K_MAGIC, K_MAGIC_LENGTH);
+  prefix.writeU32(block.size());
+  return prefix.getBuffer() + block.getBuffer();
+}
+
+// Reads the header block and, when a response is given, the body after it.
+bool ResponseCache::readEntry(const std::string& path, std::string& key,
+                              std::time_t& expires, std::size_t& size,
+                              Response* response) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  bool ok = false;
+  struct stat info;
+  std::string prefix;
+  std::string block;
+  if (::fstat(fd, &info) == 0 && readExactly(fd, K_PREFIX_LENGTH, prefix) &&
+      prefix.compare(0, K_MAGIC_LENGTH, K_MAGIC) == 0) {
+    try {
+      domain::shared::utils::BinaryReader prefixReader(prefix.data(),
+                                                       prefix.size());
+      prefixReader.readBytes(K_MAGIC_LENGTH);
+      const std::size_t blockLength =
+          static_cast<std::size_t>(prefixReader.readU32());
+      if (blockLength <= K_MAX_HEADER_BLOCK &&
+          readExactly(fd, blockLength, block)) {
+        domain::shared::utils::BinaryReader reader(block.data(), block.size());
+        if (reader.readU32() == K_FORMAT_VERSION) {
+          key = reader.readString();
+          const unsigned long status = reader.readU32();
+          expires = static_cast<std::time_t>(reader.readSize());
+          HeaderMap headers = reader.readStringMap();
+          size = static_cast<std::size_t>(info.st_size);
+          ok = true;
+          if (response != NULL) {
+            const std::size_t bodyLength =
+                size - K_PREFIX_LENGTH - blockLength;
+            response->status = static_cast<unsigned int>(status);
+            response->headers.swap(headers);
+            response->body.clear();
+            response->body.reserve(bodyLength);
+            std::string chunk;
+            while (ok && response->body.size() < bodyLength) {
+              ok = readExactly(
+                  fd,
+                  std::min(K_READ_CHUNK, bodyLength - response->body.size()),
+                  chunk);
+              response->body += chunk;
+            }
+          }
+        }
+      }
+    } catch (const domain::shared::exceptions::BinaryFormatException&) {
+      ok = false;
+    }
+  }
+  ::close(fd);
+  return ok;
+}
+
+bool ResponseCache::writeAll(int fd, const char* data, std::size_t length) {
+  std::size_t done = 0;
+  while (done < length) {
+    const ssize_t written = ::write(fd, data + done, length - done);
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    if (written <= 0) {
+      return false;
+    }
+    done += static_cast<std::size_t>(written);
+  }
+  return true;
+}
+
+}  // namespace adapters
+}  // namespace cache
+}  // namespace infrastructure
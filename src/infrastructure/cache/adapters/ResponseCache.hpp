@@ -0,0 +1,189 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ResponseCache.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:02:18 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:02:18 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef RESPONSE_CACHE_HPP
+#define RESPONSE_CACHE_HPP
+
+#include "application/ports/ILogger.hpp"
+#include "domain/configuration/entities/HttpConfig.hpp"
+#include "domain/configuration/value_objects/CacheZoneConfig.hpp"
+#include "domain/http/entities/HttpResponse.hpp"
+
+#include <cstddef>
+#include <ctime>
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace infrastructure {
+namespace cache {
+namespace adapters {
+
+// The proxy_cache zones: an in-memory index per zone over response files
+// kept under the zone's hashed directory tree. Each file starts with a
+// header block (key, status, expiry, response headers) and carries the body
+// after it; the index holds only what eviction needs. Entries are written
+// through a Fill into a temporary file that is renamed into place, so a
+// reader never sees a partial entry. Cache locks let one request fill a key
+// while others wait; every commit, abort or unlock bumps the generation the
+// event loop watches to wake them. Zones found on disk are indexed again
+// when first configured.
+class ResponseCache {
+ public:
+  typedef domain::http::entities::HttpResponse::HeaderMap HeaderMap;
+
+  enum Status { STATUS_MISS, STATUS_HIT, STATUS_EXPIRED };
+
+  struct Response {
+    unsigned int status;
+    HeaderMap headers;
+    std::string body;
+
+    Response();
+  };
+
+  class Fill {
+   public:
+    ~Fill();
+
+    bool append(const char* data, std::size_t length);
+    bool commit();
+    void abort();
+
+    std::size_t getSize() const;
+
+   private:
+    friend class ResponseCache;
+
+    Fill(ResponseCache& cache, const std::string& zone,
+         const std::string& zonePath, const std::string& key,
+         const std::string& path, const std::string& tempPath, int fd,
+         std::time_t expires);
+    Fill(const Fill&);
+    Fill& operator=(const Fill&);
+
+    ResponseCache& m_cache;
+    std::string m_zone;
+    std::string m_zonePath;
+    std::string m_key;
+    std::string m_path;
+    std::string m_tempPath;
+    int m_fd;
+    std::time_t m_expires;
+    std::size_t m_size;
+    bool m_failed;
+    bool m_done;
+  };
+
+  static const char K_MAGIC[];
+  static const std::size_t K_MAGIC_LENGTH = 4;
+  static const unsigned long K_FORMAT_VERSION = 1;
+
+  explicit ResponseCache(application::ports::ILogger& logger);
+  ~ResponseCache();
+
+  void configure(
+      const domain::configuration::entities::HttpConfig::CacheZones& zones,
+      std::time_t now);
+  bool hasZone(const std::string& zone) const;
+
+  Status lookup(const std::string& zone, const std::string& key,
+                std::time_t now, Response& response);
+  bool lock(const std::string& zone, const std::string& key);
+  void unlock(const std::string& zone, const std::string& key);
+  bool isLocked(const std::string& zone, const std::string& key) const;
+  Fill* startFill(const std::string& zone, const std::string& key,
+                  unsigned int status, const HeaderMap& headers,
+                  std::time_t expires);
+  void evict(std::time_t now);
+
+  unsigned long getGeneration() const;
+  unsigned long getHitCount() const;
+  unsigned long getMissCount() const;
+  unsigned long getStoreCount() const;
+  std::size_t getEntryCount() const;
+  std::size_t getStoredBytes() const;
+
+  static std::string entryPath(
+      const domain::configuration::value_objects::CacheZoneConfig& zone,
+      const std::string& key);
+
+ private:
+  typedef std::list<std::string> LruList;
+
+  struct Entry {
+    std::time_t expires;
+    std::time_t lastAccess;
+    std::size_t size;
+    LruList::iterator lruPosition;
+  };
+
+  typedef std::map<std::string, Entry> Index;
+
+  struct Zone {
+    domain::configuration::value_objects::CacheZoneConfig config;
+    Index index;
+    LruList lru;
+    std::set<std::string> locks;
+    std::size_t storedBytes;
+
+    explicit Zone(
+        const domain::configuration::value_objects::CacheZoneConfig&
+            zoneConfig);
+  };
+
+  typedef std::map<std::string, Zone*> ZoneMap;
+
+  struct LoadedEntry {
+    std::string key;
+    std::time_t expires;
+    std::time_t lastAccess;
+    std::size_t size;
+  };
+
+  ResponseCache(const ResponseCache&);
+  ResponseCache& operator=(const ResponseCache&);
+
+  application::ports::ILogger& m_logger;
+  ZoneMap m_zones;
+  unsigned long m_generation;
+  unsigned long m_hits;
+  unsigned long m_misses;
+  unsigned long m_stores;
+  unsigned long m_tempSequence;
+
+  Zone* findZone(const std::string& name) const;
+  void load(Zone& zone);
+  void scanDirectory(const Zone& zone, const std::string& directory,
+                     std::size_t depth, std::vector<LoadedEntry>& found);
+  void insert(Zone& zone, const std::string& key, std::time_t expires,
+              std::time_t lastAccess, std::size_t size);
+  void remove(Zone& zone, Index::iterator entry, bool removeFile);
+  bool commitFill(Fill& fill);
+  void finishFill();
+
+  static std::string encodeHeader(const std::string& key, unsigned int status,
+                                  std::time_t expires,
+                                  const HeaderMap& headers);
+  static bool readEntry(const std::string& path, std::string& key,
+                        std::time_t& expires, std::size_t& size,
+                        Response* response);
+  static bool writeAll(int fd, const char* data, std::size_t length);
+};
+
+}  // namespace adapters
+}  // namespace cache
+}  // namespace infrastructure
+
+#endif  // RESPONSE_CACHE_HPP
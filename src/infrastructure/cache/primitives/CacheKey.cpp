@@ -0,0 +1,135 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CacheKey.cpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 10:56:24 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 10:56:24 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/cache/primitives/CacheKey.hpp"
+
+#include <cctype>
+
+namespace infrastructure {
+namespace cache {
+namespace primitives {
+
+namespace {
+
+const unsigned long K_FNV_PRIME = 16777619ul;
+const unsigned long K_LANE_BASES[] = {2166136261ul, 3735928559ul, 2654435769ul,
+                                      1013904223ul};
+const std::size_t K_LANE_COUNT = sizeof(K_LANE_BASES) / sizeof(K_LANE_BASES[0]);
+const unsigned long K_LANE_MASK = 0xFFFFFFFFul;
+const char K_HEX_DIGITS[] = "0123456789abcdef";
+const char K_HEADER_PREFIX[] = "http_";
+
+bool isNameChar(char c) {
+  return std::isalnum(static_cast<unsigned char>(c)) != 0 || c == '_';
+}
+
+}  // namespace
+
+const std::size_t CacheKey::K_HASH_LENGTH;
+
+// Variables follow the access log syntax: "$name" or "${name}". Anything
+// that is not a variable is copied as it stands.
+std::string CacheKey::render(const std::string& pattern,
+                             const domain::http::entities::HttpRequest& request,
+                             const std::string& scheme,
+                             const std::string& remoteAddress) {
+  std::string key;
+  std::size_t pos = 0;
+  while (pos < pattern.size()) {
+    if (pattern[pos] != '$') {
+      key += pattern[pos++];
+      continue;
+    }
+    const bool braced = pos + 1 < pattern.size() && pattern[pos + 1] == '{';
+    const std::size_t start = pos + (braced ? 2 : 1);
+    std::size_t end = start;
+    while (end < pattern.size() && isNameChar(pattern[end])) {
+      ++end;
+    }
+    if (end == start ||
+        (braced && (end >= pattern.size() || pattern[end] != '}'))) {
+      key += pattern[pos++];
+      continue;
+    }
+    key += lookup(pattern.substr(start, end - start), request, scheme,
+                  remoteAddress);
+    pos = braced ? end + 1 : end;
+  }
+  return key;
+}
+
+std::string CacheKey::hash(const std::string& key) {
+  std::string digest;
+  digest.reserve(K_HASH_LENGTH);
+  for (std::size_t lane = 0; lane < K_LANE_COUNT; ++lane) {
+    unsigned long value = K_LANE_BASES[lane];
+    for (std::size_t i = 0; i < key.size(); ++i) {
+      value ^= static_cast<unsigned char>(key[i]);
+      value = (value * K_FNV_PRIME) & K_LANE_MASK;
+    }
+    value ^= static_cast<unsigned long>(key.size()) & K_LANE_MASK;
+    value = (value * K_FNV_PRIME) & K_LANE_MASK;
+    for (int shift = 28; shift >= 0; shift -= 4) {
+      digest += K_HEX_DIGITS[(value >> shift) & 0xF];
+    }
+  }
+  return digest;
+}
+
+std::string CacheKey::lookup(const std::string& name,
+                             const domain::http::entities::HttpRequest& request,
+                             const std::string& scheme,
+                             const std::string& remoteAddress) {
+  if (name == "scheme") {
+    return scheme;
+  }
+  if (name == "request_method") {
+    return request.getMethod().toString();
+  }
+  if (name == "host") {
+    return request.getHost();
+  }
+  if (name == "uri") {
+    return request.getPath().toString();
+  }
+  if (name == "args" || name == "request_uri") {
+    const std::string query = request.getQuery().build();
+    const std::string args =
+        !query.empty() && query[0] == '?' ? query.substr(1) : query;
+    if (name == "args") {
+      return args;
+    }
+    return request.getPath().toString() + (args.empty() ? "" : "?" + args);
+  }
+  // Keys are only ever hashed, so nginx's packed $binary_remote_addr is the
+  // printable address here.
+  if (name == "remote_addr" || name == "binary_remote_addr") {
+    return remoteAddress;
+  }
+
+  const std::size_t prefixLength = sizeof(K_HEADER_PREFIX) - 1;
+  if (name.size() > prefixLength &&
+      name.compare(0, prefixLength, K_HEADER_PREFIX) == 0) {
+    std::string header = name.substr(prefixLength);
+    for (std::size_t i = 0; i < header.size(); ++i) {
+      if (header[i] == '_') {
+        header[i] = '-';
+      }
+    }
+    return request.getHeader(header);
+  }
+  return "";
+}
+
+}  // namespace primitives
+}  // namespace cache
+}  // namespace infrastructure
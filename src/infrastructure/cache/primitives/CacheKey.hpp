@@ -0,0 +1,51 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CacheKey.hpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 10:56:24 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 10:56:24 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef CACHE_KEY_HPP
+#define CACHE_KEY_HPP
+
+#include "domain/http/entities/HttpRequest.hpp"
+
+#include <string>
+
+namespace infrastructure {
+namespace cache {
+namespace primitives {
+
+// Renders a proxy_cache_key template for one request and hashes the result
+// into the name an entry is stored under. The hash is four 32-bit FNV-1a
+// lanes with distinct offset bases, printed as 32 hex digits; an entry file
+// also records the full key, so a collision is detected on read.
+class CacheKey {
+ public:
+  static const std::size_t K_HASH_LENGTH = 32;
+
+  static std::string render(const std::string& pattern,
+                            const domain::http::entities::HttpRequest& request,
+                            const std::string& scheme,
+                            const std::string& remoteAddress);
+  static std::string hash(const std::string& key);
+
+ private:
+  CacheKey();
+
+  static std::string lookup(const std::string& name,
+                            const domain::http::entities::HttpRequest& request,
+                            const std::string& scheme,
+                            const std::string& remoteAddress);
+};
+
+}  // namespace primitives
+}  // namespace cache
+}  // namespace infrastructure
+
+#endif  // CACHE_KEY_HPP
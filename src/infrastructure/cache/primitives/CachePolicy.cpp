@@ -0,0 +1,209 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CachePolicy.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 10:58:41 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 10:58:41 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "domain/shared/utils/StringUtils.hpp"
+#include "infrastructure/cache/primitives/CachePolicy.hpp"
+
+#include <cctype>
+#include <climits>
+
+namespace infrastructure {
+namespace cache {
+namespace primitives {
+
+namespace {
+
+const char* const K_MONTHS[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+const std::size_t K_MONTH_COUNT = 12;
+const long K_SECONDS_PER_DAY = 86400;
+const long K_SECONDS_PER_HOUR = 3600;
+const long K_SECONDS_PER_MINUTE = 60;
+
+// Days since 1970-01-01 of a proleptic Gregorian date.
+long daysFromCivil(long year, long month, long day) {
+  year -= month <= 2 ? 1 : 0;
+  const long era = (year >= 0 ? year : year - 399) / 400;
+  const long yearOfEra = year - era * 400;
+  const long dayOfYear =
+      (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  const long dayOfEra =
+      yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+  return era * 146097 + dayOfEra - 719468;
+}
+
+bool parseNumber(const std::string& text, std::size_t pos, std::size_t width,
+                 long& value) {
+  if (pos + width > text.size()) {
+    return false;
+  }
+  value = 0;
+  for (std::size_t i = pos; i < pos + width; ++i) {
+    if (!std::isdigit(static_cast<unsigned char>(text[i]))) {
+      return false;
+    }
+    value = value * 10 + (text[i] - '0');
+  }
+  return true;
+}
+
+std::string trim(const std::string& text) {
+  std::size_t start = 0;
+  std::size_t end = text.size();
+  while (start < end && std::isspace(static_cast<unsigned char>(text[start]))) {
+    ++start;
+  }
+  while (end > start &&
+         std::isspace(static_cast<unsigned char>(text[end - 1]))) {
+    --end;
+  }
+  return text.substr(start, end - start);
+}
+
+}  // namespace
+
+std::time_t CachePolicy::freshUntil(
+    unsigned int status,
+    const domain::http::entities::HttpResponse::HeaderMap& headers,
+    const domain::configuration::value_objects::ProxyCacheConfig& config,
+    std::time_t now) {
+  std::string value;
+  if (findHeader(headers, "set-cookie", value)) {
+    return 0;
+  }
+  if (findHeader(headers, "vary", value) && trim(value) == "*") {
+    return 0;
+  }
+
+  if (findHeader(headers, "cache-control", value)) {
+    bool hasMaxAge = false;
+    bool hasSharedMaxAge = false;
+    unsigned long maxAge = 0;
+    unsigned long sharedMaxAge = 0;
+
+    std::size_t pos = 0;
+    while (pos <= value.size()) {
+      std::size_t comma = value.find(',', pos);
+      if (comma == std::string::npos) {
+        comma = value.size();
+      }
+      const std::string directive = trim(value.substr(pos, comma - pos));
+      pos = comma + 1;
+
+      const std::size_t equals = directive.find('=');
+      const std::string name = domain::shared::utils::StringUtils::toLowerCase(
+          trim(directive.substr(0, equals)));
+      const std::string argument =
+          equals == std::string::npos ? "" : trim(directive.substr(equals + 1));
+
+      if (name == "no-store" || name == "no-cache" || name == "private") {
+        return 0;
+      }
+      if (name == "s-maxage") {
+        hasSharedMaxAge = parseDirectiveSeconds(argument, sharedMaxAge);
+      } else if (name == "max-age") {
+        hasMaxAge = parseDirectiveSeconds(argument, maxAge);
+      }
+    }
+
+    if (hasSharedMaxAge || hasMaxAge) {
+      const unsigned long seconds = hasSharedMaxAge ? sharedMaxAge : maxAge;
+      return seconds == 0 ? 0 : now + static_cast<std::time_t>(seconds);
+    }
+  }
+
+  std::time_t expires = 0;
+  if (findHeader(headers, "expires", value) &&
+      parseHttpDate(trim(value), expires)) {
+    return expires > now ? expires : 0;
+  }
+
+  const unsigned int seconds = config.getValidity(status);
+  return seconds == 0 ? 0 : now + static_cast<std::time_t>(seconds);
+}
+
+// IMF-fixdate only ("Sun, 06 Nov 1994 08:49:37 GMT"), the form RFC 9110
+// requires senders to generate; an Expires the parser rejects is ignored.
+bool CachePolicy::parseHttpDate(const std::string& value, std::time_t& when) {
+  static const std::size_t K_FIXDATE_LENGTH = 29;
+  if (value.size() != K_FIXDATE_LENGTH || value[3] != ',' ||
+      value[4] != ' ' || value[7] != ' ' || value[11] != ' ' ||
+      value[16] != ' ' || value[19] != ':' || value[22] != ':' ||
+      value.compare(25, 4, " GMT") != 0) {
+    return false;
+  }
+
+  long month = 0;
+  for (std::size_t i = 0; i < K_MONTH_COUNT; ++i) {
+    if (value.compare(8, 3, K_MONTHS[i]) == 0) {
+      month = static_cast<long>(i) + 1;
+    }
+  }
+
+  long day = 0;
+  long year = 0;
+  long hour = 0;
+  long minute = 0;
+  long second = 0;
+  if (month == 0 || !parseNumber(value, 5, 2, day) ||
+      !parseNumber(value, 12, 4, year) || !parseNumber(value, 17, 2, hour) ||
+      !parseNumber(value, 20, 2, minute) ||
+      !parseNumber(value, 23, 2, second) || day < 1 || day > 31 ||
+      hour > 23 || minute > 59 || second > 60 || year < 1970) {
+    return false;
+  }
+
+  when = static_cast<std::time_t>(
+      daysFromCivil(year, month, day) * K_SECONDS_PER_DAY +
+      hour * K_SECONDS_PER_HOUR + minute * K_SECONDS_PER_MINUTE + second);
+  return true;
+}
+
+bool CachePolicy::findHeader(
+    const domain::http::entities::HttpResponse::HeaderMap& headers,
+    const std::string& name, std::string& value) {
+  domain::http::entities::HttpResponse::HeaderMap::const_iterator it =
+      headers.find(name);
+  if (it == headers.end()) {
+    return false;
+  }
+  value = it->second;
+  return true;
+}
+
+bool CachePolicy::parseDirectiveSeconds(const std::string& value,
+                                        unsigned long& seconds) {
+  std::string digits = value;
+  if (digits.size() >= 2 && digits[0] == '"' &&
+      digits[digits.size() - 1] == '"') {
+    digits = digits.substr(1, digits.size() - 2);
+  }
+  if (digits.empty()) {
+    return false;
+  }
+  seconds = 0;
+  for (std::size_t i = 0; i < digits.size(); ++i) {
+    if (!std::isdigit(static_cast<unsigned char>(digits[i]))) {
+      return false;
+    }
+    if (seconds > (static_cast<unsigned long>(INT_MAX) - 9) / 10) {
+      seconds = static_cast<unsigned long>(INT_MAX);
+      return true;
+    }
+    seconds = seconds * 10 + static_cast<unsigned long>(digits[i] - '0');
+  }
+  return true;
+}
+
+}  // namespace primitives
+}  // namespace cache
+}  // namespace infrastructure
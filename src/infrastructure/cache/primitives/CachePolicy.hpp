@@ -0,0 +1,55 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CachePolicy.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 10:58:41 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 10:58:41 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef CACHE_POLICY_HPP
+#define CACHE_POLICY_HPP
+
+#include "domain/configuration/value_objects/ProxyCacheConfig.hpp"
+#include "domain/http/entities/HttpResponse.hpp"
+
+#include <ctime>
+#include <string>
+
+namespace infrastructure {
+namespace cache {
+namespace primitives {
+
+// Decides whether a response may be stored and until when it is fresh.
+// The response's own Cache-Control (s-maxage, then max-age) and Expires win
+// over proxy_cache_valid; no-store, no-cache, private, Set-Cookie and
+// "Vary: *" keep a response out of the cache. Header names are the
+// lower-case keys HttpResponse uses.
+class CachePolicy {
+ public:
+  static std::time_t freshUntil(
+      unsigned int status,
+      const domain::http::entities::HttpResponse::HeaderMap& headers,
+      const domain::configuration::value_objects::ProxyCacheConfig& config,
+      std::time_t now);
+
+  static bool parseHttpDate(const std::string& value, std::time_t& when);
+
+ private:
+  CachePolicy();
+
+  static bool findHeader(
+      const domain::http::entities::HttpResponse::HeaderMap& headers,
+      const std::string& name, std::string& value);
+  static bool parseDirectiveSeconds(const std::string& value,
+                                    unsigned long& seconds);
+};
+
+}  // namespace primitives
+}  // namespace cache
+}  // namespace infrastructure
+
+#endif  // CACHE_POLICY_HPP
@@ -18,6 +18,7 @@
 #include <cstring>
 #include <fcntl.h>
 #include <signal.h>
+#include <spawn.h>
 #include <sstream>
 #include <sys/stat.h>
 #include <sys/time.h>
@@ -32,19 +33,34 @@ namespace adapters {
 CgiExecutor::CgiExecutor(application::ports::ILogger& logger)
     : m_logger(logger),
       m_timeoutSeconds(DEFAULT_TIMEOUT_SECONDS),
-      m_maxOutputSize(DEFAULT_MAX_OUTPUT_SIZE) {}
+      m_maxOutputSize(DEFAULT_MAX_OUTPUT_SIZE),
+      m_environmentCacheHits(0),
+      m_environmentCacheMisses(0),
+      m_spawnCount(0) {}
 
-CgiExecutor::~CgiExecutor() {}
+CgiExecutor::~CgiExecutor() {
+  for (std::size_t i = 0; i < m_exiting.size(); ++i) {
+    delete m_exiting[i].stream;
+  }
+}
 
 CgiExecutor::CgiExecutor(const CgiExecutor& other)
     : m_logger(other.m_logger),
       m_timeoutSeconds(other.m_timeoutSeconds),
-      m_maxOutputSize(other.m_maxOutputSize) {}
+      m_maxOutputSize(other.m_maxOutputSize),
+      m_environmentCache(other.m_environmentCache),
+      m_environmentCacheHits(other.m_environmentCacheHits),
+      m_environmentCacheMisses(other.m_environmentCacheMisses),
+      m_spawnCount(other.m_spawnCount) {}
 
 CgiExecutor& CgiExecutor::operator=(const CgiExecutor& other) {
   if (this != &other) {
     m_timeoutSeconds = other.m_timeoutSeconds;
     m_maxOutputSize = other.m_maxOutputSize;
+    m_environmentCache = other.m_environmentCache;
+    m_environmentCacheHits = other.m_environmentCacheHits;
+    m_environmentCacheMisses = other.m_environmentCacheMisses;
+    m_spawnCount = other.m_spawnCount;
   }
   return *this;
 }
@@ -53,13 +69,112 @@ primitives::CgiResponse CgiExecutor::execute(
     const primitives::CgiRequest& request) {
   validateRequest(request);
 
-  m_logger.debug("Executing CGI script: " + request.getScriptPath());
+  WEBSERV_LOG_DEBUG(m_logger,
+                    "Executing CGI script: " << request.getScriptPath());
 
   primitives::CgiExecutionContext context = runChildProcess(request);
 
   return buildResponse(context);
 }
 
+CgiStream* CgiExecutor::start(const primitives::CgiRequest& request) {
+  validateRequest(request);
+
+  WEBSERV_LOG_DEBUG(m_logger,
+                    "Streaming CGI script: " << request.getScriptPath());
+
+  primitives::PipeDescriptors pipes;
+  createPipes(pipes);
+
+  setNonBlocking(pipes.getStdoutReadFd());
+  setNonBlocking(pipes.getStderrReadFd());
+
+  pid_t childPid = spawnProcess(request, pipes);
+  ++m_spawnCount;
+  pipes.closeUnusedInParent();
+
+  try {
+    writeRequestBody(pipes.getStdinWriteFd(), request.getRequestBody());
+  } catch (const std::exception& ex) {
+    m_logger.error(std::string("Failed to write request body: ") + ex.what());
+  }
+  pipes.closeStdinWrite();
+
+  CgiStream* stream =
+      new CgiStream(m_logger, childPid, pipes.getStdoutReadFd(),
+                    pipes.getStderrReadFd(), m_timeoutSeconds);
+  pipes.invalidateAll();
+  return stream;
+}
+
+// Takes the stream once its descriptors are off the caller's event loop. A
+// script that has not exited yet is kept for reapStreams() rather than
+// waited on; an unfinished one is killed first.
+void CgiExecutor::release(CgiStream* stream) {
+  if (!stream->isFinished()) {
+    stream->abort();
+  }
+  stream->closeDescriptors();
+  if (stream->reap()) {
+    delete stream;
+    return;
+  }
+
+  ExitingStream exiting;
+  exiting.stream = stream;
+  exiting.since = std::time(NULL);
+  m_exiting.push_back(exiting);
+}
+
+// Run from the connection sweep: collects scripts that have exited and
+// kills those still running K_EXIT_GRACE_SECONDS after their output ended.
+void CgiExecutor::reapStreams(std::time_t now) {
+  std::size_t kept = 0;
+  for (std::size_t i = 0; i < m_exiting.size(); ++i) {
+    ExitingStream& exiting = m_exiting[i];
+    if (exiting.stream->reap()) {
+      delete exiting.stream;
+      continue;
+    }
+    if (now - exiting.since >= K_EXIT_GRACE_SECONDS) {
+      exiting.stream->abort();
+    }
+    m_exiting[kept++] = exiting;
+  }
+  m_exiting.resize(kept);
+}
+
+std::size_t CgiExecutor::getExitingCount() const { return m_exiting.size(); }
+
+// Keyed by the CgiConfig owned by the location, which lives as long as the
+// loaded configuration; clearEnvironmentCache() must run when it is replaced.
+const primitives::CgiEnvironment& CgiExecutor::getSharedEnvironment(
+    const domain::configuration::value_objects::CgiConfig& cgiConfig) {
+  EnvironmentCache::iterator it = m_environmentCache.find(&cgiConfig);
+  if (it != m_environmentCache.end()) {
+    ++m_environmentCacheHits;
+    return it->second;
+  }
+  ++m_environmentCacheMisses;
+  it = m_environmentCache
+           .insert(std::make_pair(&cgiConfig,
+                                  primitives::CgiEnvironment(cgiConfig)))
+           .first;
+  return it->second;
+}
+
+void CgiExecutor::clearEnvironmentCache() { m_environmentCache.clear(); }
+
+std::size_t CgiExecutor::getEnvironmentCacheHits() const {
+  return m_environmentCacheHits;
+}
+
+std::size_t CgiExecutor::getEnvironmentCacheMisses() const {
+  return m_environmentCacheMisses;
+}
+
+std::size_t CgiExecutor::getSpawnCount() const { return m_spawnCount; }
+
 void CgiExecutor::setTimeout(unsigned int seconds) {
   m_timeoutSeconds = seconds;
 }
@@ -153,62 +268,11 @@ void CgiExecutor::createPipes(primitives::PipeDescriptors& pipes) {
   setCloseOnExec(pipes.getStderrReadFd());
 }
 
-pid_t CgiExecutor::forkProcess() {
-  pid_t pid = fork();
-
-  if (pid == -1) {
-    throw exceptions::CgiExecutionException(
-        "Failed to fork process: " + getErrorMessage(errno),
-        exceptions::CgiExecutionException::FORK_FAILED);
-  }
-
-  return pid;
-}
-
-void CgiExecutor::executeChildProcess(
-    const primitives::CgiRequest& request,
-    const primitives::PipeDescriptors& pipes) const {
-  try {
-    primitives::PipeDescriptors childPipes = pipes;
-    childPipes.closeUnusedInChild();
-    redirectChildStreams(childPipes);
-    executeScript(request);
-
-  } catch (const std::exception& ex) {
-    m_logger.error(std::string("CGI child process error: ") + ex.what());
-    std::exit(EXIT_FAILURE);
-  } catch (...) {
-    m_logger.error("CGI child process unknown error");
-    std::exit(EXIT_FAILURE);
-  }
-}
-
-void CgiExecutor::redirectChildStreams(
-    const primitives::PipeDescriptors& pipes) {
-  if (dup2(pipes.getStdinReadFd(), STDIN_FILENO) == -1) {
-    throw exceptions::CgiExecutionException(
-        "Failed to redirect stdin: " + getErrorMessage(errno),
-        exceptions::CgiExecutionException::PIPE_FAILED);
-  }
-
-  if (dup2(pipes.getStdoutWriteFd(), STDOUT_FILENO) == -1) {
-    throw exceptions::CgiExecutionException(
-        "Failed to redirect stdout: " + getErrorMessage(errno),
-        exceptions::CgiExecutionException::PIPE_FAILED);
-  }
-
-  if (dup2(pipes.getStderrWriteFd(), STDERR_FILENO) == -1) {
-    throw exceptions::CgiExecutionException(
-        "Failed to redirect stderr: " + getErrorMessage(errno),
-        exceptions::CgiExecutionException::PIPE_FAILED);
-  }
-
-  close(pipes.getStdinReadFd());
-  close(pipes.getStdoutWriteFd());
-  close(pipes.getStderrWriteFd());
-}
-
-void CgiExecutor::executeScript(const primitives::CgiRequest& request) const {
+// posix_spawn lets the C library use vfork semantics, so launching a script
+// does not copy the server's page tables. The child gets its own process
+// group so a timeout can kill anything the script started.
+pid_t CgiExecutor::spawnProcess(const primitives::CgiRequest& request,
+                                const primitives::PipeDescriptors& pipes) {
   std::vector<std::string> argv = request.buildArgv();
   std::vector<char*> envp = request.buildEnvp();
 
@@ -219,13 +283,44 @@ void CgiExecutor::executeScript(const primitives::CgiRequest& request) const {
   }
   argvPtrs.push_back(NULL);
 
-  if (execve(argvPtrs[0], &argvPtrs[0], &envp[0]) == -1) {
-    std::string error =
+  posix_spawn_file_actions_t actions;
+  posix_spawn_file_actions_init(&actions);
+  posix_spawn_file_actions_adddup2(&actions, pipes.getStdinReadFd(),
+                                   STDIN_FILENO);
+  posix_spawn_file_actions_adddup2(&actions, pipes.getStdoutWriteFd(),
+                                   STDOUT_FILENO);
+  posix_spawn_file_actions_adddup2(&actions, pipes.getStderrWriteFd(),
+                                   STDERR_FILENO);
+  posix_spawn_file_actions_addclose(&actions, pipes.getStdinReadFd());
+  posix_spawn_file_actions_addclose(&actions, pipes.getStdoutWriteFd());
+  posix_spawn_file_actions_addclose(&actions, pipes.getStderrWriteFd());
+
+  sigset_t defaultSignals;
+  sigemptyset(&defaultSignals);
+  sigaddset(&defaultSignals, SIGPIPE);
+
+  posix_spawnattr_t attributes;
+  posix_spawnattr_init(&attributes);
+  posix_spawnattr_setsigdefault(&attributes, &defaultSignals);
+  posix_spawnattr_setpgroup(&attributes, 0);
+  posix_spawnattr_setflags(&attributes,
+                           POSIX_SPAWN_SETSIGDEF | POSIX_SPAWN_SETPGROUP);
+
+  pid_t pid = -1;
+  const int result = posix_spawn(&pid, argvPtrs[0], &actions, &attributes,
+                                 &argvPtrs[0], &envp[0]);
+
+  posix_spawnattr_destroy(&attributes);
+  posix_spawn_file_actions_destroy(&actions);
+
+  if (result != 0) {
+    throw exceptions::CgiExecutionException(
         "Failed to execute CGI script: " + request.getScriptPath() + " - " +
-        getErrorMessage(errno);
-    m_logger.error(error);
-    std::exit(EXIT_FAILURE);
+            getErrorMessage(result),
+        exceptions::CgiExecutionException::EXEC_FAILED);
   }
+
+  return pid;
 }
 
 void CgiExecutor::writeRequestBody(int fileDescriptor,
@@ -344,14 +439,9 @@ primitives::CgiExecutionContext CgiExecutor::runChildProcess(
   setNonBlocking(context.getPipes().getStdoutReadFd());
   setNonBlocking(context.getPipes().getStderrReadFd());
 
-  pid_t childPid = forkProcess();
+  pid_t childPid = spawnProcess(request, context.getPipes());
+  ++m_spawnCount;
   context.setChildPid(childPid);
-
-  if (childPid == 0) {
-    executeChildProcess(request, context.getPipes());
-    std::exit(EXIT_SUCCESS);
-  }
-
   context.getPipes().closeUnusedInParent();
 
   try {
@@ -14,10 +14,15 @@
 #define CGI_EXECUTOR_HPP
 
 #include "application/ports/ILogger.hpp"
+#include "domain/configuration/value_objects/CgiConfig.hpp"
+#include "infrastructure/cgi/adapters/CgiStream.hpp"
+#include "infrastructure/cgi/primitives/CgiEnvironment.hpp"
 #include "infrastructure/cgi/primitives/CgiExecutionContext.hpp"
 #include "infrastructure/cgi/primitives/CgiRequest.hpp"
 #include "infrastructure/cgi/primitives/CgiResponse.hpp"
 
+#include <ctime>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -34,6 +39,17 @@ class CgiExecutor {
   CgiExecutor& operator=(const CgiExecutor& other);
 
   primitives::CgiResponse execute(const primitives::CgiRequest& request);
+  CgiStream* start(const primitives::CgiRequest& request);
+  void release(CgiStream* stream);
+  void reapStreams(std::time_t now);
+  std::size_t getExitingCount() const;
+
+  const primitives::CgiEnvironment& getSharedEnvironment(
+      const domain::configuration::value_objects::CgiConfig& cgiConfig);
+  void clearEnvironmentCache();
+  std::size_t getEnvironmentCacheHits() const;
+  std::size_t getEnvironmentCacheMisses() const;
+  std::size_t getSpawnCount() const;
 
   void setTimeout(unsigned int seconds);
   unsigned int getTimeout() const;
@@ -44,11 +60,26 @@ class CgiExecutor {
   static const unsigned int DEFAULT_TIMEOUT_SECONDS = 30;
   static const std::size_t DEFAULT_MAX_OUTPUT_SIZE = 10485760;
   static const std::size_t PIPE_BUFFER_SIZE = 4096;
+  static const std::time_t K_EXIT_GRACE_SECONDS = 1;
 
  private:
+  typedef std::map<const domain::configuration::value_objects::CgiConfig*,
+                   primitives::CgiEnvironment>
+      EnvironmentCache;
+
+  struct ExitingStream {
+    CgiStream* stream;
+    std::time_t since;
+  };
+
   application::ports::ILogger& m_logger;
   unsigned int m_timeoutSeconds;
   std::size_t m_maxOutputSize;
+  EnvironmentCache m_environmentCache;
+  std::size_t m_environmentCacheHits;
+  std::size_t m_environmentCacheMisses;
+  std::size_t m_spawnCount;
+  std::vector<ExitingStream> m_exiting;
 
   static void validateRequest(const primitives::CgiRequest& request);
   static void validateScriptExecutability(const std::string& scriptPath);
@@ -56,11 +87,8 @@ class CgiExecutor {
 
   static void createPipes(primitives::PipeDescriptors& pipes);
 
-  static pid_t forkProcess();
-  void executeChildProcess(const primitives::CgiRequest& request,
-                           const primitives::PipeDescriptors& pipes) const;
-  static void redirectChildStreams(const primitives::PipeDescriptors& pipes);
-  void executeScript(const primitives::CgiRequest& request) const;
+  static pid_t spawnProcess(const primitives::CgiRequest& request,
+                            const primitives::PipeDescriptors& pipes);
 
   static void writeRequestBody(int fileDescriptor, const std::vector<char>& body);
   static std::vector<char> readFromPipe(int fileDescriptor, std::size_t maxSize);
@@ -0,0 +1,353 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CgiStream.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 19:48:21 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 19:48:21 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/cgi/adapters/CgiStream.hpp"
+#include "infrastructure/cgi/exceptions/CgiExecutionException.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <ctime>
+#include <sstream>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace infrastructure {
+namespace cgi {
+namespace adapters {
+
+namespace {
+
+const std::size_t K_HEADER_READ_SIZE = 4096;
+
+}  // namespace
+
+const std::size_t CgiStream::K_MAX_HEADER_SIZE;
+const std::size_t CgiStream::K_MAX_ERROR_LOG_SIZE;
+const ssize_t CgiStream::K_WOULD_BLOCK;
+
+CgiStream::CgiStream(application::ports::ILogger& logger, pid_t childPid,
+                     int stdoutFd, int stderrFd, unsigned int timeoutSeconds)
+    : m_logger(logger),
+      m_childPid(childPid),
+      m_stdoutFd(stdoutFd),
+      m_stderrFd(stderrFd),
+      m_timeoutSeconds(timeoutSeconds),
+      m_startedAt(std::time(NULL)),
+      m_pendingOffset(0),
+      m_scanned(0),
+      m_headersComplete(false),
+      m_outputClosed(false),
+      m_exitStatus(0),
+      m_finished(false),
+      m_reportExit(false) {}
+
+// Only a stream never handed to CgiExecutor::release() still has a child
+// here; it is killed and collected on the spot.
+CgiStream::~CgiStream() {
+  if (m_childPid > 0) {
+    ::kill(-m_childPid, SIGKILL);
+    while (::waitpid(m_childPid, NULL, 0) < 0 && errno == EINTR) {
+    }
+    m_childPid = -1;
+  }
+  closeDescriptors();
+}
+
+// True once the header block is complete. Output that ends before it is
+// reported once the child has been collected, so the error can carry its
+// exit code; until then isAwaitingExit() holds and the caller retries from
+// its sweep rather than polling a pipe that stays readable at EOF.
+bool CgiStream::advance() {
+  if (m_headersComplete) {
+    return true;
+  }
+
+  std::size_t bodyStart = std::string::npos;
+  try {
+    if (m_outputClosed || !fillHeaderBlock(bodyStart)) {
+      if (!m_outputClosed) {
+        return false;
+      }
+      drainErrorOutput();
+      if (!reap()) {
+        return false;
+      }
+      failBeforeHeaders();
+    }
+  } catch (...) {
+    abort();
+    throw;
+  }
+
+  m_response = primitives::CgiResponse::fromRawOutput(std::vector<char>(
+      m_pending.begin(),
+      m_pending.begin() + static_cast<std::ptrdiff_t>(bodyStart)));
+  m_pendingOffset = bodyStart;
+  m_headersComplete = true;
+  return true;
+}
+
+const primitives::CgiResponse& CgiStream::getResponse() const {
+  return m_response;
+}
+
+ssize_t CgiStream::read(char* buffer, std::size_t size) {
+  if (m_pendingOffset < m_pending.size()) {
+    const std::size_t count =
+        std::min(size, m_pending.size() - m_pendingOffset);
+    std::memcpy(buffer, &m_pending[m_pendingOffset], count);
+    m_pendingOffset += count;
+    if (m_pendingOffset == m_pending.size()) {
+      std::vector<char>().swap(m_pending);
+      m_pendingOffset = 0;
+    }
+    return static_cast<ssize_t>(count);
+  }
+
+  drainErrorOutput();
+
+  while (true) {
+    const ssize_t bytesRead = ::read(m_stdoutFd, buffer, size);
+    if (bytesRead >= 0) {
+      return bytesRead;
+    }
+    if (errno == EINTR) {
+      continue;
+    }
+    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      return K_WOULD_BLOCK;
+    }
+    throw exceptions::CgiExecutionException(
+        "Failed to read CGI output: " + getErrorMessage(errno),
+        exceptions::CgiExecutionException::PIPE_FAILED);
+  }
+}
+
+// Only the header block is bounded by the CGI timeout. stderr is drained
+// here as well, since the event loop watches stdout alone.
+void CgiStream::checkTimeout(std::time_t now) {
+  drainErrorOutput();
+  if (m_headersComplete || m_finished || m_timeoutSeconds == 0 ||
+      now - m_startedAt < static_cast<std::time_t>(m_timeoutSeconds)) {
+    return;
+  }
+
+  m_logger.error("CGI script execution timeout - killing process");
+  abort();
+  throw exceptions::CgiExecutionException(
+      "CGI script execution timeout",
+      exceptions::CgiExecutionException::TIMEOUT);
+}
+
+// The script's output is done with; its exit status is logged as soon as
+// reap() collects it, which may be later if it has not exited yet.
+void CgiStream::finish() {
+  if (m_finished) {
+    return;
+  }
+
+  drainErrorOutput();
+  m_finished = true;
+  m_reportExit = true;
+  reap();
+}
+
+void CgiStream::abort() {
+  if (m_childPid > 0) {
+    ::kill(-m_childPid, SIGKILL);
+  }
+  m_finished = true;
+  reap();
+}
+
+// Collects the child without waiting; true once there is none left.
+bool CgiStream::reap() {
+  if (m_childPid <= 0) {
+    return true;
+  }
+
+  int status = 0;
+  pid_t result;
+  do {
+    result = ::waitpid(m_childPid, &status, WNOHANG);
+  } while (result < 0 && errno == EINTR);
+
+  if (result == 0) {
+    return false;
+  }
+  m_childPid = -1;
+  if (result < 0) {
+    return true;
+  }
+
+  m_exitStatus = status;
+  if (m_reportExit) {
+    drainErrorOutput();
+    logExitStatus();
+  }
+  return true;
+}
+
+int CgiStream::getFd() const { return m_stdoutFd; }
+
+pid_t CgiStream::getPid() const { return m_childPid; }
+
+bool CgiStream::isFinished() const { return m_finished; }
+
+bool CgiStream::isAwaitingExit() const {
+  return m_outputClosed && !m_headersComplete && !m_finished;
+}
+
+bool CgiStream::fillHeaderBlock(std::size_t& bodyStart) {
+  char buffer[K_HEADER_READ_SIZE];
+  drainErrorOutput();
+
+  while (true) {
+    bodyStart = findBodyStart(m_pending, m_scanned);
+    if (bodyStart != std::string::npos) {
+      return true;
+    }
+    m_scanned = (m_pending.size() > 3) ? m_pending.size() - 3 : 0;
+
+    if (m_pending.size() > K_MAX_HEADER_SIZE) {
+      throw exceptions::CgiExecutionException(
+          "CGI header block exceeds maximum header size",
+          exceptions::CgiExecutionException::INVALID_OUTPUT);
+    }
+
+    const ssize_t bytesRead = ::read(m_stdoutFd, buffer, sizeof(buffer));
+    if (bytesRead > 0) {
+      m_pending.insert(m_pending.end(), buffer, buffer + bytesRead);
+      continue;
+    }
+    if (bytesRead == 0) {
+      m_outputClosed = true;
+      return false;
+    }
+    if (errno == EINTR) {
+      continue;
+    }
+    if (errno != EAGAIN && errno != EWOULDBLOCK) {
+      throw exceptions::CgiExecutionException(
+          "Failed to read CGI output: " + getErrorMessage(errno),
+          exceptions::CgiExecutionException::PIPE_FAILED);
+    }
+    return false;
+  }
+}
+
+// stderr is only drained so a chatty script cannot block on a full pipe; the
+// first few kilobytes are kept for the log.
+void CgiStream::drainErrorOutput() {
+  if (m_stderrFd < 0) {
+    return;
+  }
+
+  char buffer[K_HEADER_READ_SIZE];
+  while (true) {
+    const ssize_t bytesRead = ::read(m_stderrFd, buffer, sizeof(buffer));
+    if (bytesRead > 0) {
+      if (m_errorOutput.size() < K_MAX_ERROR_LOG_SIZE) {
+        m_errorOutput.append(
+            buffer, std::min(K_MAX_ERROR_LOG_SIZE - m_errorOutput.size(),
+                             static_cast<std::size_t>(bytesRead)));
+      }
+      continue;
+    }
+    if (bytesRead < 0 && errno == EINTR) {
+      continue;
+    }
+    if (bytesRead == 0) {
+      ::close(m_stderrFd);
+      m_stderrFd = -1;
+    }
+    return;
+  }
+}
+
+void CgiStream::failBeforeHeaders() {
+  m_finished = true;
+
+  if (WIFEXITED(m_exitStatus) && WEXITSTATUS(m_exitStatus) != 0) {
+    std::ostringstream oss;
+    oss << "CGI script failed with exit code " << WEXITSTATUS(m_exitStatus);
+    if (!m_errorOutput.empty()) {
+      oss << ": " << m_errorOutput;
+    }
+    throw exceptions::CgiExecutionException(
+        oss.str(), exceptions::CgiExecutionException::PROCESS_ERROR);
+  }
+
+  if (m_pending.empty()) {
+    throw exceptions::CgiExecutionException(
+        "CGI script produced no output",
+        exceptions::CgiExecutionException::INVALID_OUTPUT);
+  }
+
+  throw exceptions::CgiExecutionException(
+      "CGI script output missing header/body separator",
+      exceptions::CgiExecutionException::INVALID_OUTPUT);
+}
+
+void CgiStream::logExitStatus() const {
+  std::ostringstream oss;
+  if (WIFEXITED(m_exitStatus) && WEXITSTATUS(m_exitStatus) != 0) {
+    oss << "CGI script exited with code " << WEXITSTATUS(m_exitStatus);
+  } else if (WIFSIGNALED(m_exitStatus)) {
+    oss << "CGI script terminated by signal " << WTERMSIG(m_exitStatus);
+  } else {
+    if (!m_errorOutput.empty()) {
+      WEBSERV_LOG_DEBUG(m_logger, "CGI script stderr: " << m_errorOutput);
+    }
+    return;
+  }
+
+  if (!m_errorOutput.empty()) {
+    oss << ": " << m_errorOutput;
+  }
+  m_logger.warn(oss.str());
+}
+
+void CgiStream::closeDescriptors() {
+  if (m_stdoutFd >= 0) {
+    ::close(m_stdoutFd);
+    m_stdoutFd = -1;
+  }
+  if (m_stderrFd >= 0) {
+    ::close(m_stderrFd);
+    m_stderrFd = -1;
+  }
+}
+
+std::size_t CgiStream::findBodyStart(const std::vector<char>& data,
+                                     std::size_t from) {
+  for (std::size_t i = from; i + 1 < data.size(); ++i) {
+    if (data[i] == '\n' && data[i + 1] == '\n') {
+      return i + 2;
+    }
+    if (i + 3 < data.size() && data[i] == '\r' && data[i + 1] == '\n' &&
+        data[i + 2] == '\r' && data[i + 3] == '\n') {
+      return i + 4;
+    }
+  }
+  return std::string::npos;
+}
+
+std::string CgiStream::getErrorMessage(int errnoValue) {
+  return std::string(std::strerror(errnoValue));
+}
+
+}  // namespace adapters
+}  // namespace cgi
+}  // namespace infrastructure
@@ -0,0 +1,93 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CgiStream.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 19:48:21 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 19:48:21 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef CGI_STREAM_HPP
+#define CGI_STREAM_HPP
+
+#include "application/ports/ILogger.hpp"
+#include "infrastructure/cgi/primitives/CgiResponse.hpp"
+
+#include <cstddef>
+#include <ctime>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+namespace infrastructure {
+namespace cgi {
+namespace adapters {
+
+// A running CGI script whose stdout is relayed as it is produced. The header
+// block is collected up to the blank line by advance(), called whenever the
+// pipe is readable; everything after it is handed out in caller-sized pieces
+// so no buffer ever holds the whole body. Nothing here blocks: a child that
+// has not exited by the time its output ends is collected later by reap().
+class CgiStream {
+ public:
+  static const std::size_t K_MAX_HEADER_SIZE = 65536;
+  static const std::size_t K_MAX_ERROR_LOG_SIZE = 4096;
+  static const ssize_t K_WOULD_BLOCK = -1;
+
+  CgiStream(application::ports::ILogger& logger, pid_t childPid,
+            int stdoutFd, int stderrFd, unsigned int timeoutSeconds);
+  ~CgiStream();
+
+  bool advance();
+  const primitives::CgiResponse& getResponse() const;
+  ssize_t read(char* buffer, std::size_t size);
+  void checkTimeout(std::time_t now);
+  void finish();
+  void abort();
+  bool reap();
+  void closeDescriptors();
+
+  int getFd() const;
+  pid_t getPid() const;
+  bool isFinished() const;
+  bool isAwaitingExit() const;
+
+ private:
+  CgiStream(const CgiStream&);
+  CgiStream& operator=(const CgiStream&);
+
+  application::ports::ILogger& m_logger;
+  pid_t m_childPid;
+  int m_stdoutFd;
+  int m_stderrFd;
+  unsigned int m_timeoutSeconds;
+  std::time_t m_startedAt;
+  std::vector<char> m_pending;
+  std::size_t m_pendingOffset;
+  std::size_t m_scanned;
+  primitives::CgiResponse m_response;
+  bool m_headersComplete;
+  bool m_outputClosed;
+  std::string m_errorOutput;
+  int m_exitStatus;
+  bool m_finished;
+  bool m_reportExit;
+
+  bool fillHeaderBlock(std::size_t& bodyStart);
+  void drainErrorOutput();
+  void failBeforeHeaders();
+  void logExitStatus() const;
+
+  static std::size_t findBodyStart(const std::vector<char>& data,
+                                   std::size_t from);
+  static std::string getErrorMessage(int errnoValue);
+};
+
+}  // namespace adapters
+}  // namespace cgi
+}  // namespace infrastructure
+
+#endif  // CGI_STREAM_HPP
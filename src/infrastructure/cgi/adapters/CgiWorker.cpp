@@ -0,0 +1,271 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CgiWorker.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 18:12:40 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 18:12:40 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/cgi/adapters/CgiWorker.hpp"
+#include "infrastructure/cgi/exceptions/CgiExecutionException.hpp"
+#include "infrastructure/cgi/primitives/FastCgiRecord.hpp"
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+namespace infrastructure {
+namespace cgi {
+namespace adapters {
+
+namespace {
+
+const int K_EXEC_FAILED_STATUS = 127;
+
+}  // namespace
+
+const std::size_t CgiWorker::K_READ_CHUNK_SIZE;
+const unsigned short CgiWorker::K_REQUEST_ID;
+
+CgiWorker::Result::Result() : exitCode(0) {}
+
+CgiWorker::CgiWorker(const std::string& interpreter,
+                     const std::string& bootstrap)
+    : m_pid(-1),
+      m_fd(-1),
+      m_servedCount(0),
+      m_leased(false),
+      m_outputOffset(0) {
+  spawn(interpreter, bootstrap);
+}
+
+CgiWorker::~CgiWorker() { terminate(); }
+
+// Queues the request records; nothing is written until flush().
+void CgiWorker::beginRequest(const primitives::CgiRequest& request) {
+  if (!isAlive()) {
+    throw exceptions::CgiExecutionException(
+        "CGI worker is not running",
+        exceptions::CgiExecutionException::PROCESS_ERROR);
+  }
+
+  const std::vector<char>& body = request.getRequestBody();
+  m_output.clear();
+  m_outputOffset = 0;
+  primitives::FastCgiRecord::appendBeginRequest(
+      m_output, K_REQUEST_ID, primitives::FastCgiRecord::ROLE_RESPONDER, true);
+  primitives::FastCgiRecord::appendParams(m_output, K_REQUEST_ID,
+                                          request.getEnvironment());
+  primitives::FastCgiRecord::appendStream(
+      m_output, primitives::FastCgiRecord::TYPE_STDIN, K_REQUEST_ID,
+      body.empty() ? NULL : &body[0], body.size());
+  primitives::FastCgiRecord::appendStreamEnd(
+      m_output, primitives::FastCgiRecord::TYPE_STDIN, K_REQUEST_ID);
+
+  m_result = Result();
+  m_decoder.reset();
+}
+
+void CgiWorker::flush() {
+  while (m_outputOffset < m_output.size()) {
+    const ssize_t written =
+        ::send(m_fd, &m_output[m_outputOffset],
+               m_output.size() - m_outputOffset, MSG_NOSIGNAL);
+    if (written > 0) {
+      m_outputOffset += static_cast<std::size_t>(written);
+      continue;
+    }
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      return;
+    }
+    throw exceptions::CgiExecutionException(
+        "send to CGI worker failed: " + getErrorMessage(errno),
+        exceptions::CgiExecutionException::PROCESS_ERROR);
+  }
+  m_output.clear();
+  m_outputOffset = 0;
+}
+
+// Reads whatever the worker has sent; true once END_REQUEST has arrived.
+bool CgiWorker::receive(std::size_t maxOutputSize) {
+  char buffer[K_READ_CHUNK_SIZE];
+  for (;;) {
+    const ssize_t received = ::recv(m_fd, buffer, sizeof(buffer), 0);
+
+    if (received == 0) {
+      throw exceptions::CgiExecutionException(
+          "CGI worker exited mid-request",
+          exceptions::CgiExecutionException::PROCESS_ERROR);
+    }
+    if (received < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        return false;
+      }
+      throw exceptions::CgiExecutionException(
+          "recv from CGI worker failed: " + getErrorMessage(errno),
+          exceptions::CgiExecutionException::PROCESS_ERROR);
+    }
+
+    m_decoder.feed(buffer, static_cast<std::size_t>(received));
+    if (dispatch(maxOutputSize)) {
+      ++m_servedCount;
+      return true;
+    }
+  }
+}
+
+const CgiWorker::Result& CgiWorker::getResult() const { return m_result; }
+
+pid_t CgiWorker::getPid() const { return m_pid; }
+
+int CgiWorker::getFd() const { return m_fd; }
+
+std::size_t CgiWorker::getServedCount() const { return m_servedCount; }
+
+bool CgiWorker::hasOutput() const { return m_outputOffset < m_output.size(); }
+
+bool CgiWorker::isAlive() const {
+  if (m_pid <= 0 || m_fd < 0) {
+    return false;
+  }
+
+  char probe;
+  const ssize_t result = ::recv(m_fd, &probe, 1, MSG_PEEK | MSG_DONTWAIT);
+  if (result == 0) {
+    return false;
+  }
+  return result > 0 || errno == EAGAIN || errno == EWOULDBLOCK;
+}
+
+// A leased worker is serving a request and is not handed to another one.
+bool CgiWorker::isLeased() const { return m_leased; }
+
+void CgiWorker::setLeased(bool leased) { m_leased = leased; }
+
+void CgiWorker::terminate() {
+  if (m_fd >= 0) {
+    ::close(m_fd);
+    m_fd = -1;
+  }
+
+  if (m_pid > 0) {
+    ::kill(m_pid, SIGKILL);
+    while (::waitpid(m_pid, NULL, 0) < 0 && errno == EINTR) {
+    }
+    m_pid = -1;
+  }
+  m_decoder.reset();
+}
+
+void CgiWorker::spawn(const std::string& interpreter,
+                      const std::string& bootstrap) {
+  if (::access(interpreter.c_str(), X_OK) != 0) {
+    throw exceptions::CgiExecutionException(
+        "CGI worker interpreter is not executable: " + interpreter,
+        exceptions::CgiExecutionException::INTERPRETER_NOT_FOUND);
+  }
+  if (::access(bootstrap.c_str(), R_OK) != 0) {
+    throw exceptions::CgiExecutionException(
+        "CGI worker bootstrap is not readable: " + bootstrap,
+        exceptions::CgiExecutionException::SCRIPT_NOT_FOUND);
+  }
+
+  int channel[2];
+  if (::socketpair(AF_UNIX, SOCK_STREAM, 0, channel) != 0) {
+    throw exceptions::CgiExecutionException(
+        "Failed to create CGI worker channel: " + getErrorMessage(errno),
+        exceptions::CgiExecutionException::PIPE_FAILED);
+  }
+
+  m_pid = ::fork();
+  if (m_pid < 0) {
+    const int error = errno;
+    ::close(channel[0]);
+    ::close(channel[1]);
+    throw exceptions::CgiExecutionException(
+        "Failed to fork CGI worker: " + getErrorMessage(error),
+        exceptions::CgiExecutionException::FORK_FAILED);
+  }
+
+  if (m_pid == 0) {
+    ::close(channel[0]);
+    execInterpreter(channel[1], interpreter, bootstrap);
+  }
+
+  ::close(channel[1]);
+  m_fd = channel[0];
+  fcntl(m_fd, F_SETFL, fcntl(m_fd, F_GETFL, 0) | O_NONBLOCK);
+  fcntl(m_fd, F_SETFD, FD_CLOEXEC);
+}
+
+void CgiWorker::execInterpreter(int channelFd, const std::string& interpreter,
+                                const std::string& bootstrap) {
+  ::setpgid(0, 0);
+  if (::dup2(channelFd, STDIN_FILENO) < 0 ||
+      ::dup2(channelFd, STDOUT_FILENO) < 0) {
+    ::_exit(K_EXEC_FAILED_STATUS);
+  }
+
+  const long maxDescriptors = ::sysconf(_SC_OPEN_MAX);
+  for (long fd = STDERR_FILENO + 1; fd < maxDescriptors; ++fd) {
+    ::close(static_cast<int>(fd));
+  }
+
+  char* argv[] = {const_cast<char*>(interpreter.c_str()),
+                  const_cast<char*>(bootstrap.c_str()), NULL};
+  ::execve(argv[0], argv, environ);
+  ::_exit(K_EXEC_FAILED_STATUS);
+}
+
+bool CgiWorker::dispatch(std::size_t maxOutputSize) {
+  primitives::FastCgiRecord record;
+  while (m_decoder.next(record)) {
+    switch (record.type) {
+      case primitives::FastCgiRecord::TYPE_STDOUT:
+        m_result.output.insert(m_result.output.end(), record.content.begin(),
+                               record.content.end());
+        break;
+      case primitives::FastCgiRecord::TYPE_STDERR:
+        m_result.errorOutput.insert(m_result.errorOutput.end(),
+                                    record.content.begin(),
+                                    record.content.end());
+        break;
+      case primitives::FastCgiRecord::TYPE_END_REQUEST:
+        m_result.exitCode = record.getAppStatus();
+        return true;
+      default:
+        break;
+    }
+
+    if (m_result.output.size() > maxOutputSize) {
+      throw exceptions::CgiExecutionException(
+          "CGI worker output exceeds maximum output size",
+          exceptions::CgiExecutionException::INVALID_OUTPUT);
+    }
+  }
+  return false;
+}
+
+std::string CgiWorker::getErrorMessage(int errnoValue) {
+  return std::string(std::strerror(errnoValue));
+}
+
+}  // namespace adapters
+}  // namespace cgi
+}  // namespace infrastructure
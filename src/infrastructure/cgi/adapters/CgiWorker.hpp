@@ -0,0 +1,93 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CgiWorker.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 18:12:40 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 18:12:40 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef CGI_WORKER_HPP
+#define CGI_WORKER_HPP
+
+#include "infrastructure/cgi/primitives/CgiRequest.hpp"
+#include "infrastructure/cgi/primitives/FastCgiRecordDecoder.hpp"
+
+#include <cstddef>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+namespace infrastructure {
+namespace cgi {
+namespace adapters {
+
+// One long-lived interpreter process running a bootstrap program. Requests
+// and responses travel over a socketpair bound to the worker's stdin/stdout,
+// framed as FastCGI records (BEGIN_REQUEST, PARAMS, STDIN in; STDOUT, STDERR,
+// END_REQUEST out). The channel is non-blocking: the caller queues a request
+// with beginRequest() and then calls flush() and receive() as the descriptor
+// becomes writable or readable.
+class CgiWorker {
+ public:
+  struct Result {
+    std::vector<char> output;
+    std::vector<char> errorOutput;
+    unsigned int exitCode;
+
+    Result();
+  };
+
+  static const std::size_t K_READ_CHUNK_SIZE = 16384;
+
+  CgiWorker(const std::string& interpreter, const std::string& bootstrap);
+  ~CgiWorker();
+
+  void beginRequest(const primitives::CgiRequest& request);
+  void flush();
+  bool receive(std::size_t maxOutputSize);
+  const Result& getResult() const;
+
+  pid_t getPid() const;
+  int getFd() const;
+  std::size_t getServedCount() const;
+  bool hasOutput() const;
+  bool isAlive() const;
+
+  bool isLeased() const;
+  void setLeased(bool leased);
+
+  void terminate();
+
+ private:
+  CgiWorker(const CgiWorker&);
+  CgiWorker& operator=(const CgiWorker&);
+
+  static const unsigned short K_REQUEST_ID = 1;
+
+  pid_t m_pid;
+  int m_fd;
+  std::size_t m_servedCount;
+  bool m_leased;
+  std::vector<char> m_output;
+  std::size_t m_outputOffset;
+  Result m_result;
+  primitives::FastCgiRecordDecoder m_decoder;
+
+  void spawn(const std::string& interpreter, const std::string& bootstrap);
+  static void execInterpreter(int channelFd, const std::string& interpreter,
+                              const std::string& bootstrap);
+
+  bool dispatch(std::size_t maxOutputSize);
+
+  static std::string getErrorMessage(int errnoValue);
+};
+
+}  // namespace adapters
+}  // namespace cgi
+}  // namespace infrastructure
+
+#endif  // CGI_WORKER_HPP
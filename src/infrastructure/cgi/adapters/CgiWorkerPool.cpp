@@ -0,0 +1,238 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CgiWorkerPool.cpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 18:40:07 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 18:40:07 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/cgi/adapters/CgiWorkerPool.hpp"
+#include "infrastructure/cgi/exceptions/CgiExecutionException.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+namespace infrastructure {
+namespace cgi {
+namespace adapters {
+
+CgiWorkerPool::Group::Group() : maxRequests(0), next(0) {}
+
+CgiWorkerPool::CgiWorkerPool(application::ports::ILogger& logger)
+    : m_logger(logger),
+      m_timeoutSeconds(DEFAULT_TIMEOUT_SECONDS),
+      m_maxOutputSize(DEFAULT_MAX_OUTPUT_SIZE),
+      m_spawnCount(0) {}
+
+CgiWorkerPool::~CgiWorkerPool() { shutdown(); }
+
+// Returns an idle worker leased to the caller, or NULL with the owner
+// queued when the whole group is busy.
+CgiWorker* CgiWorkerPool::acquire(
+    const domain::configuration::value_objects::CgiConfig& config,
+    int owner) {
+  Group& group = ensureGroup(config);
+  CgiWorker** slot = selectWorker(group);
+
+  std::deque<int>::iterator waiting =
+      std::find(group.waiting.begin(), group.waiting.end(), owner);
+  if (slot == NULL) {
+    if (waiting == group.waiting.end()) {
+      group.waiting.push_back(owner);
+    }
+    return NULL;
+  }
+  if (waiting != group.waiting.end()) {
+    group.waiting.erase(waiting);
+  }
+
+  (*slot)->setLeased(true);
+  return *slot;
+}
+
+// A worker whose request failed, or that has served worker_max_requests, is
+// replaced. The caller must already have stopped watching its descriptor.
+// Everyone queued on the group is woken to try again.
+void CgiWorkerPool::release(
+    const domain::configuration::value_objects::CgiConfig& config,
+    CgiWorker* worker, bool reusable) {
+  GroupMap::iterator it = m_groups.find(groupKey(config));
+  if (it == m_groups.end()) {
+    delete worker;
+    return;
+  }
+
+  Group& group = it->second;
+  for (std::size_t i = 0; i < group.workers.size(); ++i) {
+    if (group.workers[i] != worker) {
+      continue;
+    }
+    worker->setLeased(false);
+    if (!reusable) {
+      replaceWorker(group, group.workers[i], "request failed");
+    } else if (worker->getServedCount() >= group.maxRequests) {
+      std::ostringstream oss;
+      oss << "served " << worker->getServedCount() << " requests";
+      replaceWorker(group, group.workers[i], oss.str());
+    }
+    break;
+  }
+
+  m_ready.insert(m_ready.end(), group.waiting.begin(), group.waiting.end());
+  group.waiting.clear();
+}
+
+void CgiWorkerPool::cancelWait(
+    const domain::configuration::value_objects::CgiConfig& config,
+    int owner) {
+  GroupMap::iterator it = m_groups.find(groupKey(config));
+  if (it != m_groups.end()) {
+    it->second.waiting.erase(std::remove(it->second.waiting.begin(),
+                                         it->second.waiting.end(), owner),
+                             it->second.waiting.end());
+  }
+  m_ready.erase(std::remove(m_ready.begin(), m_ready.end(), owner),
+                m_ready.end());
+}
+
+void CgiWorkerPool::collectReady(std::vector<int>& owners) {
+  owners.insert(owners.end(), m_ready.begin(), m_ready.end());
+  m_ready.clear();
+}
+
+void CgiWorkerPool::prespawn(
+    const domain::configuration::value_objects::CgiConfig& config) {
+  Group& group = ensureGroup(config);
+
+  std::ostringstream oss;
+  oss << "Pre-spawned " << group.workers.size() << " CGI worker(s) for "
+      << group.interpreter << " " << group.bootstrap;
+  m_logger.info(oss.str());
+}
+
+void CgiWorkerPool::setTimeout(unsigned int seconds) {
+  m_timeoutSeconds = seconds;
+}
+
+unsigned int CgiWorkerPool::getTimeout() const { return m_timeoutSeconds; }
+
+void CgiWorkerPool::setMaxOutputSize(std::size_t bytes) {
+  m_maxOutputSize = bytes;
+}
+
+std::size_t CgiWorkerPool::getMaxOutputSize() const { return m_maxOutputSize; }
+
+std::size_t CgiWorkerPool::getWorkerCount(
+    const domain::configuration::value_objects::CgiConfig& config) const {
+  GroupMap::const_iterator it = m_groups.find(groupKey(config));
+  if (it == m_groups.end()) {
+    return 0;
+  }
+
+  std::size_t running = 0;
+  for (std::size_t i = 0; i < it->second.workers.size(); ++i) {
+    if (it->second.workers[i] != NULL && it->second.workers[i]->isAlive()) {
+      ++running;
+    }
+  }
+  return running;
+}
+
+std::size_t CgiWorkerPool::getSpawnCount() const { return m_spawnCount; }
+
+void CgiWorkerPool::shutdown() {
+  for (GroupMap::iterator it = m_groups.begin(); it != m_groups.end(); ++it) {
+    for (std::size_t i = 0; i < it->second.workers.size(); ++i) {
+      delete it->second.workers[i];
+    }
+  }
+  m_groups.clear();
+  m_ready.clear();
+}
+
+CgiWorkerPool::Group& CgiWorkerPool::ensureGroup(
+    const domain::configuration::value_objects::CgiConfig& config) {
+  const std::string key = groupKey(config);
+  GroupMap::iterator it = m_groups.find(key);
+  if (it != m_groups.end()) {
+    return it->second;
+  }
+
+  if (!config.hasWorkerPool()) {
+    throw exceptions::CgiExecutionException(
+        "No CGI worker pool configured for " + config.getScriptPath(),
+        exceptions::CgiExecutionException::PROCESS_ERROR);
+  }
+
+  Group& group = m_groups[key];
+  group.interpreter = config.getScriptPath();
+  group.bootstrap = config.getWorkerBootstrap();
+  group.maxRequests = config.getWorkerMaxRequests();
+  group.workers.resize(config.getWorkerCount(), NULL);
+
+  try {
+    for (std::size_t i = 0; i < group.workers.size(); ++i) {
+      group.workers[i] = spawnWorker(group);
+    }
+  } catch (...) {
+    for (std::size_t i = 0; i < group.workers.size(); ++i) {
+      delete group.workers[i];
+    }
+    m_groups.erase(key);
+    throw;
+  }
+  return group;
+}
+
+CgiWorker* CgiWorkerPool::spawnWorker(const Group& group) {
+  CgiWorker* worker = new CgiWorker(group.interpreter, group.bootstrap);
+  ++m_spawnCount;
+  return worker;
+}
+
+// Round robin over the idle workers, respawning one that has died; NULL
+// when every worker is leased.
+CgiWorker** CgiWorkerPool::selectWorker(Group& group) {
+  for (std::size_t tried = 0; tried < group.workers.size(); ++tried) {
+    CgiWorker*& slot = group.workers[group.next % group.workers.size()];
+    group.next = (group.next + 1) % group.workers.size();
+    if (slot != NULL && slot->isLeased()) {
+      continue;
+    }
+
+    if (slot == NULL || !slot->isAlive()) {
+      delete slot;
+      slot = NULL;
+      slot = spawnWorker(group);
+    }
+    return &slot;
+  }
+  return NULL;
+}
+
+void CgiWorkerPool::replaceWorker(Group& group, CgiWorker*& slot,
+                                  const std::string& why) {
+  WEBSERV_LOG_DEBUG(m_logger, "Replacing CGI worker: " << why);
+
+  delete slot;
+  slot = NULL;
+
+  try {
+    slot = spawnWorker(group);
+  } catch (const std::exception& ex) {
+    m_logger.error(std::string("Failed to respawn CGI worker: ") + ex.what());
+  }
+}
+
+std::string CgiWorkerPool::groupKey(
+    const domain::configuration::value_objects::CgiConfig& config) {
+  return config.getScriptPath() + "\n" + config.getWorkerBootstrap();
+}
+
+}  // namespace adapters
+}  // namespace cgi
+}  // namespace infrastructure
@@ -0,0 +1,106 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CgiWorkerPool.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 18:40:07 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 18:40:07 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef CGI_WORKER_POOL_HPP
+#define CGI_WORKER_POOL_HPP
+
+#include "application/ports/ILogger.hpp"
+#include "domain/configuration/value_objects/CgiConfig.hpp"
+#include "infrastructure/cgi/adapters/CgiWorker.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace infrastructure {
+namespace cgi {
+namespace adapters {
+
+// Long-lived workers grouped by interpreter and bootstrap. A request leases
+// an idle worker for the length of its exchange; when every worker of the
+// group is busy the caller is queued and reported by collectReady() once a
+// worker is handed back.
+class CgiWorkerPool {
+ public:
+  static const unsigned int DEFAULT_TIMEOUT_SECONDS = 30;
+  static const std::size_t DEFAULT_MAX_OUTPUT_SIZE = 10485760;
+
+  explicit CgiWorkerPool(application::ports::ILogger& logger);
+  ~CgiWorkerPool();
+
+  CgiWorker* acquire(
+      const domain::configuration::value_objects::CgiConfig& config,
+      int owner);
+  void release(const domain::configuration::value_objects::CgiConfig& config,
+               CgiWorker* worker, bool reusable);
+  void cancelWait(
+      const domain::configuration::value_objects::CgiConfig& config,
+      int owner);
+  void collectReady(std::vector<int>& owners);
+
+  void prespawn(const domain::configuration::value_objects::CgiConfig& config);
+
+  void setTimeout(unsigned int seconds);
+  unsigned int getTimeout() const;
+
+  void setMaxOutputSize(std::size_t bytes);
+  std::size_t getMaxOutputSize() const;
+
+  std::size_t getWorkerCount(
+      const domain::configuration::value_objects::CgiConfig& config) const;
+  std::size_t getSpawnCount() const;
+
+  void shutdown();
+
+ private:
+  CgiWorkerPool(const CgiWorkerPool&);
+  CgiWorkerPool& operator=(const CgiWorkerPool&);
+
+  typedef std::vector<CgiWorker*> WorkerList;
+
+  struct Group {
+    std::string interpreter;
+    std::string bootstrap;
+    std::size_t maxRequests;
+    std::size_t next;
+    WorkerList workers;
+    std::deque<int> waiting;
+
+    Group();
+  };
+
+  typedef std::map<std::string, Group> GroupMap;
+
+  application::ports::ILogger& m_logger;
+  GroupMap m_groups;
+  unsigned int m_timeoutSeconds;
+  std::size_t m_maxOutputSize;
+  std::size_t m_spawnCount;
+  std::vector<int> m_ready;
+
+  Group& ensureGroup(
+      const domain::configuration::value_objects::CgiConfig& config);
+  CgiWorker* spawnWorker(const Group& group);
+  CgiWorker** selectWorker(Group& group);
+  void replaceWorker(Group& group, CgiWorker*& slot, const std::string& why);
+
+  static std::string groupKey(
+      const domain::configuration::value_objects::CgiConfig& config);
+};
+
+}  // namespace adapters
+}  // namespace cgi
+}  // namespace infrastructure
+
+#endif  // CGI_WORKER_POOL_HPP
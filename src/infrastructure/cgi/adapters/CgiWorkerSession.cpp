@@ -0,0 +1,156 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CgiWorkerSession.cpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 13:20:44 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 13:20:44 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/cgi/adapters/CgiWorkerSession.hpp"
+#include "infrastructure/cgi/exceptions/CgiExecutionException.hpp"
+
+#include <sstream>
+#include <unistd.h>
+
+namespace infrastructure {
+namespace cgi {
+namespace adapters {
+
+CgiWorkerSession::CgiWorkerSession(
+    application::ports::ILogger& logger, CgiWorkerPool& pool,
+    const domain::configuration::value_objects::CgiConfig& config,
+    const primitives::CgiRequest& request)
+    : m_logger(logger),
+      m_pool(pool),
+      m_config(config),
+      m_request(request),
+      m_owner(-1),
+      m_state(STATE_IDLE),
+      m_worker(NULL),
+      m_startedAt(0) {}
+
+CgiWorkerSession::~CgiWorkerSession() { finish(); }
+
+// Tag reported by CgiWorkerPool::collectReady() when a worker frees up for
+// a queued session.
+void CgiWorkerSession::setOwner(int owner) { m_owner = owner; }
+
+void CgiWorkerSession::start() {
+  m_request.validate();
+
+  if (::access(m_request.getScriptPath().c_str(), F_OK) != 0) {
+    throw exceptions::CgiExecutionException(
+        "Script not found: " + m_request.getScriptPath(),
+        exceptions::CgiExecutionException::SCRIPT_NOT_FOUND);
+  }
+
+  m_startedAt = std::time(NULL);
+  lease();
+}
+
+// True once the worker has ended the request; false while queued or waiting
+// on the socketpair.
+bool CgiWorkerSession::advance() {
+  if (m_state == STATE_DONE) {
+    return true;
+  }
+  if (m_state == STATE_QUEUED && !lease()) {
+    return false;
+  }
+
+  m_worker->flush();
+  if (!m_worker->receive(m_pool.getMaxOutputSize())) {
+    return false;
+  }
+  m_result = m_worker->getResult();
+  m_state = STATE_DONE;
+  return true;
+}
+
+// The time spent queued for a worker counts against the same limit as the
+// script's own run.
+void CgiWorkerSession::checkTimeout(std::time_t now) {
+  if (m_state != STATE_QUEUED && m_state != STATE_RUNNING) {
+    return;
+  }
+
+  const unsigned int limit = m_pool.getTimeout();
+  if (limit == 0 || now - m_startedAt < static_cast<std::time_t>(limit)) {
+    return;
+  }
+
+  throw exceptions::CgiExecutionException(
+      m_state == STATE_QUEUED ? "No CGI worker became free in time"
+                              : "CGI worker did not respond in time",
+      exceptions::CgiExecutionException::TIMEOUT);
+}
+
+primitives::CgiResponse CgiWorkerSession::buildResponse() const {
+  if (!m_result.errorOutput.empty()) {
+    m_logger.warn("CGI worker stderr: " +
+                  std::string(m_result.errorOutput.begin(),
+                              m_result.errorOutput.end()));
+  }
+
+  if (m_result.exitCode != 0) {
+    std::ostringstream oss;
+    oss << "CGI script failed with exit code " << m_result.exitCode;
+    throw exceptions::CgiExecutionException(
+        oss.str(), exceptions::CgiExecutionException::PROCESS_ERROR);
+  }
+
+  if (m_result.output.empty()) {
+    throw exceptions::CgiExecutionException(
+        "CGI script produced no output",
+        exceptions::CgiExecutionException::INVALID_OUTPUT);
+  }
+
+  return primitives::CgiResponse::fromRawOutput(m_result.output);
+}
+
+// Hands the worker back once the caller has stopped watching its socketpair;
+// a worker left mid-request is replaced rather than reused.
+void CgiWorkerSession::finish() {
+  if (m_worker != NULL) {
+    m_pool.release(m_config, m_worker, m_state == STATE_DONE);
+    m_worker = NULL;
+  } else if (m_state == STATE_QUEUED) {
+    m_pool.cancelWait(m_config, m_owner);
+  }
+  m_state = STATE_DONE;
+}
+
+int CgiWorkerSession::getFd() const {
+  return m_worker != NULL ? m_worker->getFd() : -1;
+}
+
+bool CgiWorkerSession::wantsWrite() const {
+  return m_worker != NULL && m_worker->hasOutput();
+}
+
+bool CgiWorkerSession::lease() {
+  m_worker = m_pool.acquire(m_config, m_owner);
+  if (m_worker == NULL) {
+    if (m_state != STATE_QUEUED) {
+      WEBSERV_LOG_DEBUG(m_logger, "Queued " << m_request.getScriptPath()
+                                            << " until a CGI worker is free");
+    }
+    m_state = STATE_QUEUED;
+    return false;
+  }
+
+  WEBSERV_LOG_DEBUG(m_logger, "Running " << m_request.getScriptPath()
+                                         << " in CGI worker");
+  m_state = STATE_RUNNING;
+  m_worker->beginRequest(m_request);
+  m_worker->flush();
+  return true;
+}
+
+}  // namespace adapters
+}  // namespace cgi
+}  // namespace infrastructure
@@ -0,0 +1,76 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CgiWorkerSession.hpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 13:20:44 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 13:20:44 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef CGI_WORKER_SESSION_HPP
+#define CGI_WORKER_SESSION_HPP
+
+#include "application/ports/ILogger.hpp"
+#include "domain/configuration/value_objects/CgiConfig.hpp"
+#include "infrastructure/cgi/adapters/CgiWorker.hpp"
+#include "infrastructure/cgi/adapters/CgiWorkerPool.hpp"
+#include "infrastructure/cgi/primitives/CgiRequest.hpp"
+#include "infrastructure/cgi/primitives/CgiResponse.hpp"
+
+#include <ctime>
+
+namespace infrastructure {
+namespace cgi {
+namespace adapters {
+
+// One request run inside a pooled CGI worker. Every step is non-blocking and
+// driven from the caller's event loop: advance() leases a worker, flushes the
+// request records over its socketpair and collects the response until the
+// worker ends the request. While every worker is busy the session waits in
+// the pool's queue and is reported through CgiWorkerPool::collectReady().
+class CgiWorkerSession {
+ public:
+  CgiWorkerSession(
+      application::ports::ILogger& logger, CgiWorkerPool& pool,
+      const domain::configuration::value_objects::CgiConfig& config,
+      const primitives::CgiRequest& request);
+  ~CgiWorkerSession();
+
+  void setOwner(int owner);
+
+  void start();
+  bool advance();
+  void checkTimeout(std::time_t now);
+  primitives::CgiResponse buildResponse() const;
+  void finish();
+
+  int getFd() const;
+  bool wantsWrite() const;
+
+ private:
+  enum State { STATE_IDLE, STATE_QUEUED, STATE_RUNNING, STATE_DONE };
+
+  CgiWorkerSession(const CgiWorkerSession&);
+  CgiWorkerSession& operator=(const CgiWorkerSession&);
+
+  application::ports::ILogger& m_logger;
+  CgiWorkerPool& m_pool;
+  domain::configuration::value_objects::CgiConfig m_config;
+  primitives::CgiRequest m_request;
+  int m_owner;
+  State m_state;
+  CgiWorker* m_worker;
+  std::time_t m_startedAt;
+  CgiWorker::Result m_result;
+
+  bool lease();
+};
+
+}  // namespace adapters
+}  // namespace cgi
+}  // namespace infrastructure
+
+#endif  // CGI_WORKER_SESSION_HPP
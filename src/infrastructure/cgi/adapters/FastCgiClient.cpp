@@ -0,0 +1,174 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FastCgiClient.cpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 15:10:37 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 15:10:37 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/cgi/adapters/FastCgiClient.hpp"
+
+#include <algorithm>
+
+namespace infrastructure {
+namespace cgi {
+namespace adapters {
+
+FastCgiClient::FastCgiClient(application::ports::ILogger& logger)
+    : m_logger(logger),
+      m_timeoutSeconds(DEFAULT_TIMEOUT_SECONDS),
+      m_maxOutputSize(DEFAULT_MAX_OUTPUT_SIZE),
+      m_connectCount(0),
+      m_reuseCount(0) {}
+
+// Connections still in use belong to their sessions, which the caller ends
+// before the client goes away.
+FastCgiClient::~FastCgiClient() { closeIdle(); }
+
+// A multiplexing connection with room for another request is preferred,
+// then an idle one, then a new connection. The connect of a new one is
+// still in flight when it is handed out.
+FastCgiConnection* FastCgiClient::acquire(const std::string& address,
+                                          bool& reused) {
+  FastCgiConnection* connection = findShared(address);
+  if (connection == NULL) {
+    connection = takeIdle(address);
+  }
+
+  if (connection != NULL) {
+    reused = true;
+    ++m_reuseCount;
+  } else {
+    reused = false;
+    connection = new FastCgiConnection(address);
+    connection->queryCapabilities();
+    ++m_connectCount;
+    m_active[address].push_back(connection);
+  }
+
+  connection->attach();
+  return connection;
+}
+
+// The last user hands the connection back; it is kept only if nothing is
+// left in flight on it in either direction.
+void FastCgiClient::release(FastCgiConnection* connection) {
+  if (connection == NULL || connection->detach() > 0) {
+    return;
+  }
+
+  forget(connection);
+  ConnectionList& idle = m_idle[connection->getAddress()];
+  if (!connection->isReusable() || idle.size() >= K_MAX_IDLE_PER_ENDPOINT) {
+    delete connection;
+    return;
+  }
+  idle.push_back(connection);
+}
+
+// Owner tags of requests whose responses moved since they last looked,
+// typically because a read on behalf of another request took their records.
+void FastCgiClient::collectUpdated(std::vector<int>& owners) {
+  for (ConnectionPool::iterator poolIt = m_active.begin();
+       poolIt != m_active.end(); ++poolIt) {
+    for (std::size_t i = 0; i < poolIt->second.size(); ++i) {
+      poolIt->second[i]->collectUpdated(owners);
+    }
+  }
+}
+
+void FastCgiClient::setTimeout(unsigned int seconds) {
+  m_timeoutSeconds = seconds;
+}
+
+unsigned int FastCgiClient::getTimeout() const { return m_timeoutSeconds; }
+
+void FastCgiClient::setMaxOutputSize(std::size_t bytes) {
+  m_maxOutputSize = bytes;
+}
+
+std::size_t FastCgiClient::getMaxOutputSize() const { return m_maxOutputSize; }
+
+std::size_t FastCgiClient::getIdleCount(const std::string& address) const {
+  ConnectionPool::const_iterator it = m_idle.find(address);
+  return it == m_idle.end() ? 0 : it->second.size();
+}
+
+std::size_t FastCgiClient::getActiveCount(const std::string& address) const {
+  ConnectionPool::const_iterator it = m_active.find(address);
+  return it == m_active.end() ? 0 : it->second.size();
+}
+
+std::size_t FastCgiClient::getConnectCount() const { return m_connectCount; }
+
+std::size_t FastCgiClient::getReuseCount() const { return m_reuseCount; }
+
+void FastCgiClient::closeIdle() {
+  for (ConnectionPool::iterator poolIt = m_idle.begin(); poolIt != m_idle.end();
+       ++poolIt) {
+    for (std::size_t i = 0; i < poolIt->second.size(); ++i) {
+      delete poolIt->second[i];
+    }
+  }
+  m_idle.clear();
+}
+
+FastCgiConnection* FastCgiClient::findShared(const std::string& address) {
+  ConnectionPool::iterator poolIt = m_active.find(address);
+  if (poolIt == m_active.end()) {
+    return NULL;
+  }
+
+  const ConnectionList& active = poolIt->second;
+  for (std::size_t i = 0; i < active.size(); ++i) {
+    if (active[i]->canMultiplex() &&
+        active[i]->getPendingCount() < K_MAX_REQUESTS_PER_CONNECTION) {
+      WEBSERV_LOG_DEBUG(m_logger, "Multiplexing request on FastCGI connection"
+                                      << " fd=" << active[i]->getFd());
+      return active[i];
+    }
+  }
+  return NULL;
+}
+
+// An idle connection the server has closed in the meantime reads as EOF.
+FastCgiConnection* FastCgiClient::takeIdle(const std::string& address) {
+  ConnectionPool::iterator poolIt = m_idle.find(address);
+  if (poolIt == m_idle.end()) {
+    return NULL;
+  }
+
+  ConnectionList& idle = poolIt->second;
+  while (!idle.empty()) {
+    FastCgiConnection* connection = idle.back();
+    idle.pop_back();
+    if (!connection->isPeerClosed()) {
+      m_active[address].push_back(connection);
+      return connection;
+    }
+    delete connection;
+  }
+  return NULL;
+}
+
+void FastCgiClient::forget(FastCgiConnection* connection) {
+  ConnectionPool::iterator poolIt = m_active.find(connection->getAddress());
+  if (poolIt == m_active.end()) {
+    return;
+  }
+
+  ConnectionList& active = poolIt->second;
+  active.erase(std::remove(active.begin(), active.end(), connection),
+               active.end());
+  if (active.empty()) {
+    m_active.erase(poolIt);
+  }
+}
+
+}  // namespace adapters
+}  // namespace cgi
+}  // namespace infrastructure
@@ -0,0 +1,84 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FastCgiClient.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 15:10:37 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 15:10:37 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef FAST_CGI_CLIENT_HPP
+#define FAST_CGI_CLIENT_HPP
+
+#include "application/ports/ILogger.hpp"
+#include "infrastructure/cgi/adapters/FastCgiConnection.hpp"
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace infrastructure {
+namespace cgi {
+namespace adapters {
+
+// Pool of FastCGI connections per fastcgi_pass address. A connection whose
+// server announced FCGI_MPXS_CONNS is shared by concurrent requests; any
+// other connection carries one request at a time and returns to the idle
+// list once its last user lets go of it.
+class FastCgiClient {
+ public:
+  static const std::size_t K_MAX_IDLE_PER_ENDPOINT = 8;
+  static const std::size_t K_MAX_REQUESTS_PER_CONNECTION = 16;
+  static const unsigned int DEFAULT_TIMEOUT_SECONDS = 30;
+  static const unsigned int K_CONNECT_TIMEOUT_SECONDS = 5;
+  static const std::size_t DEFAULT_MAX_OUTPUT_SIZE = 10485760;
+
+  explicit FastCgiClient(application::ports::ILogger& logger);
+  ~FastCgiClient();
+
+  FastCgiConnection* acquire(const std::string& address, bool& reused);
+  void release(FastCgiConnection* connection);
+  void collectUpdated(std::vector<int>& owners);
+
+  void setTimeout(unsigned int seconds);
+  unsigned int getTimeout() const;
+
+  void setMaxOutputSize(std::size_t bytes);
+  std::size_t getMaxOutputSize() const;
+
+  std::size_t getIdleCount(const std::string& address) const;
+  std::size_t getActiveCount(const std::string& address) const;
+  std::size_t getConnectCount() const;
+  std::size_t getReuseCount() const;
+
+  void closeIdle();
+
+ private:
+  FastCgiClient(const FastCgiClient&);
+  FastCgiClient& operator=(const FastCgiClient&);
+
+  typedef std::vector<FastCgiConnection*> ConnectionList;
+  typedef std::map<std::string, ConnectionList> ConnectionPool;
+
+  application::ports::ILogger& m_logger;
+  ConnectionPool m_idle;
+  ConnectionPool m_active;
+  unsigned int m_timeoutSeconds;
+  std::size_t m_maxOutputSize;
+  std::size_t m_connectCount;
+  std::size_t m_reuseCount;
+
+  FastCgiConnection* findShared(const std::string& address);
+  FastCgiConnection* takeIdle(const std::string& address);
+  void forget(FastCgiConnection* connection);
+};
+
+}  // namespace adapters
+}  // namespace cgi
+}  // namespace infrastructure
+
+#endif  // FAST_CGI_CLIENT_HPP
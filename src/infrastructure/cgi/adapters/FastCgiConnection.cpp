@@ -0,0 +1,442 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FastCgiConnection.cpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 14:41:09 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 14:41:09 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/cgi/adapters/FastCgiConnection.hpp"
+#include "infrastructure/cgi/exceptions/CgiExecutionException.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace infrastructure {
+namespace cgi {
+namespace adapters {
+
+namespace {
+
+const std::string K_UNIX_PREFIX = "unix:";
+const std::string K_MPXS_CONNS = "FCGI_MPXS_CONNS";
+
+}  // namespace
+
+FastCgiConnection::Exchange::Exchange()
+    : appStatus(0),
+      protocolStatus(primitives::FastCgiRecord::STATUS_REQUEST_COMPLETE),
+      complete(false),
+      owner(-1),
+      updated(false) {}
+
+FastCgiConnection::FastCgiConnection(const std::string& address)
+    : m_address(address),
+      m_fd(-1),
+      m_connecting(false),
+      m_peerClosed(false),
+      m_multiplexing(false),
+      m_aborted(false),
+      m_nextRequestId(1),
+      m_bytesReceived(0),
+      m_attached(0),
+      m_outputOffset(0) {
+  if (address.compare(0, K_UNIX_PREFIX.size(), K_UNIX_PREFIX) == 0) {
+    connectUnix(unixSocketPath(address));
+  } else {
+    connectTcp(address);
+  }
+}
+
+FastCgiConnection::~FastCgiConnection() { close(); }
+
+const std::string& FastCgiConnection::getAddress() const { return m_address; }
+
+int FastCgiConnection::getFd() const { return m_fd; }
+
+bool FastCgiConnection::isOpen() const { return m_fd >= 0 && !m_peerClosed; }
+
+bool FastCgiConnection::isConnecting() const { return m_connecting; }
+
+bool FastCgiConnection::isIdle() const { return m_exchanges.empty(); }
+
+bool FastCgiConnection::canMultiplex() const {
+  return m_multiplexing && isOpen();
+}
+
+bool FastCgiConnection::hasOutput() const {
+  return m_outputOffset < m_output.size();
+}
+
+// The server may still be answering an aborted request, so only a
+// connection that never had one goes back to the idle list.
+bool FastCgiConnection::isReusable() const {
+  return isOpen() && isIdle() && !hasOutput() && !m_aborted;
+}
+
+std::size_t FastCgiConnection::getPendingCount() const {
+  return m_exchanges.size();
+}
+
+std::size_t FastCgiConnection::getBytesReceived() const {
+  return m_bytesReceived;
+}
+
+bool FastCgiConnection::isPeerClosed() const {
+  if (!isOpen()) {
+    return true;
+  }
+
+  char probe;
+  const ssize_t result = ::recv(m_fd, &probe, 1, MSG_PEEK | MSG_DONTWAIT);
+  if (result == 0) {
+    return true;
+  }
+  return result < 0 && errno != EAGAIN && errno != EWOULDBLOCK;
+}
+
+void FastCgiConnection::attach() { ++m_attached; }
+
+// Returns how many sessions still use the connection.
+std::size_t FastCgiConnection::detach() {
+  if (m_attached > 0) {
+    --m_attached;
+  }
+  return m_attached;
+}
+
+// Asks whether the server takes concurrent requests on one connection; until
+// it answers FCGI_MPXS_CONNS=1 the connection carries one request at a time.
+void FastCgiConnection::queryCapabilities() {
+  primitives::FastCgiRecord::ParameterMap names;
+  names[K_MPXS_CONNS] = "";
+  primitives::FastCgiRecord::appendValues(
+      m_output, primitives::FastCgiRecord::TYPE_GET_VALUES, names);
+}
+
+unsigned short FastCgiConnection::beginRequest(
+    const primitives::CgiRequest& request, int owner) {
+  if (!isOpen()) {
+    throw exceptions::CgiExecutionException(
+        "FastCGI connection is closed",
+        exceptions::CgiExecutionException::PROTOCOL_ERROR);
+  }
+
+  const unsigned short requestId = allocateRequestId();
+  const std::vector<char>& body = request.getRequestBody();
+
+  primitives::FastCgiRecord::appendBeginRequest(
+      m_output, requestId, primitives::FastCgiRecord::ROLE_RESPONDER, true);
+  primitives::FastCgiRecord::appendParams(m_output, requestId,
+                                          request.getEnvironment());
+  primitives::FastCgiRecord::appendStream(
+      m_output, primitives::FastCgiRecord::TYPE_STDIN, requestId,
+      body.empty() ? NULL : &body[0], body.size());
+  primitives::FastCgiRecord::appendStreamEnd(
+      m_output, primitives::FastCgiRecord::TYPE_STDIN, requestId);
+
+  Exchange& exchange = m_exchanges[requestId];
+  exchange = Exchange();
+  exchange.owner = owner;
+  return requestId;
+}
+
+FastCgiConnection::Exchange* FastCgiConnection::findExchange(
+    unsigned short requestId) {
+  ExchangeMap::iterator it = m_exchanges.find(requestId);
+  return it != m_exchanges.end() ? &it->second : NULL;
+}
+
+void FastCgiConnection::endRequest(unsigned short requestId) {
+  m_exchanges.erase(requestId);
+}
+
+void FastCgiConnection::abortRequest(unsigned short requestId) {
+  if (m_exchanges.erase(requestId) == 0 || !isOpen()) {
+    return;
+  }
+
+  m_aborted = true;
+  primitives::FastCgiRecord::appendAbortRequest(m_output, requestId);
+  flush();
+}
+
+// False while the handshake is still in flight.
+bool FastCgiConnection::finishConnect() {
+  if (!m_connecting) {
+    return true;
+  }
+
+  struct pollfd probe;
+  probe.fd = m_fd;
+  probe.events = POLLOUT;
+  probe.revents = 0;
+  if (::poll(&probe, 1, 0) == 0) {
+    return false;
+  }
+
+  int error = 0;
+  socklen_t length = sizeof(error);
+  if (getsockopt(m_fd, SOL_SOCKET, SO_ERROR, &error, &length) != 0) {
+    error = errno;
+  }
+  if (error != 0) {
+    fail();
+    throw exceptions::CgiExecutionException(
+        "connect to " + m_address + " failed: " + getErrorMessage(error),
+        exceptions::CgiExecutionException::CONNECT_FAILED);
+  }
+  m_connecting = false;
+  return true;
+}
+
+// Sends as much of the queued records as the socket takes; a write error
+// fails every request on the connection.
+void FastCgiConnection::flush() {
+  while (hasOutput() && isOpen() && !m_connecting) {
+    const ssize_t written =
+        ::send(m_fd, &m_output[m_outputOffset],
+               m_output.size() - m_outputOffset, MSG_NOSIGNAL);
+    if (written > 0) {
+      m_outputOffset += static_cast<std::size_t>(written);
+      continue;
+    }
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      return;
+    }
+    fail();
+    return;
+  }
+
+  if (!hasOutput()) {
+    m_output.clear();
+    m_outputOffset = 0;
+  }
+}
+
+// Reads until the socket is drained. End of stream, a read error or a
+// malformed record fail every request still waiting on the connection.
+void FastCgiConnection::receive() {
+  char buffer[K_READ_CHUNK_SIZE];
+  while (isOpen() && !m_connecting) {
+    const ssize_t received = ::recv(m_fd, buffer, sizeof(buffer), 0);
+    if (received < 0 && errno == EINTR) {
+      continue;
+    }
+    if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      return;
+    }
+    if (received <= 0) {
+      fail();
+      return;
+    }
+
+    m_bytesReceived += static_cast<std::size_t>(received);
+    m_decoder.feed(buffer, static_cast<std::size_t>(received));
+    try {
+      primitives::FastCgiRecord record;
+      while (m_decoder.next(record)) {
+        dispatch(record);
+      }
+    } catch (const exceptions::CgiExecutionException&) {
+      fail();
+      return;
+    }
+
+    if (static_cast<std::size_t>(received) < sizeof(buffer)) {
+      return;
+    }
+  }
+}
+
+void FastCgiConnection::collectUpdated(std::vector<int>& owners) {
+  for (ExchangeMap::iterator it = m_exchanges.begin(); it != m_exchanges.end();
+       ++it) {
+    if (it->second.updated && it->second.owner >= 0) {
+      owners.push_back(it->second.owner);
+    }
+    it->second.updated = false;
+  }
+}
+
+std::string FastCgiConnection::unixSocketPath(const std::string& address) {
+  if (address.compare(0, K_UNIX_PREFIX.size(), K_UNIX_PREFIX) != 0) {
+    return "";
+  }
+  return address.substr(K_UNIX_PREFIX.size());
+}
+
+void FastCgiConnection::connectUnix(const std::string& path) {
+  struct sockaddr_un addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+
+  if (path.empty() || path.size() >= sizeof(addr.sun_path)) {
+    throw exceptions::CgiExecutionException(
+        "invalid FastCGI socket path: " + path,
+        exceptions::CgiExecutionException::CONNECT_FAILED);
+  }
+  std::memcpy(addr.sun_path, path.c_str(), path.size());
+
+  m_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  startConnect(reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+}
+
+void FastCgiConnection::connectTcp(const std::string& address) {
+  const std::size_t colonPos = address.rfind(':');
+  if (colonPos == std::string::npos) {
+    throw exceptions::CgiExecutionException(
+        "FastCGI address has no port: " + address,
+        exceptions::CgiExecutionException::CONNECT_FAILED);
+  }
+
+  const std::string host = address.substr(0, colonPos);
+  const std::string port = address.substr(colonPos + 1);
+
+  struct addrinfo hints;
+  std::memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags = AI_NUMERICSERV;
+
+  struct addrinfo* result = NULL;
+  const int status = getaddrinfo(host.c_str(), port.c_str(), &hints, &result);
+  if (status != 0 || result == NULL) {
+    throw exceptions::CgiExecutionException(
+        "cannot resolve FastCGI host " + host + ": " + gai_strerror(status),
+        exceptions::CgiExecutionException::CONNECT_FAILED);
+  }
+
+  m_fd = ::socket(result->ai_family, SOCK_STREAM, 0);
+  try {
+    startConnect(result->ai_addr, result->ai_addrlen);
+  } catch (...) {
+    freeaddrinfo(result);
+    throw;
+  }
+  freeaddrinfo(result);
+}
+
+// A connect still in flight is completed by finishConnect() once the socket
+// turns writable.
+void FastCgiConnection::startConnect(const sockaddr* addr,
+                                     socklen_t addrLength) {
+  if (m_fd < 0) {
+    throw exceptions::CgiExecutionException(
+        "socket() failed: " + getErrorMessage(errno),
+        exceptions::CgiExecutionException::CONNECT_FAILED);
+  }
+
+  const int flags = fcntl(m_fd, F_GETFL, 0);
+  fcntl(m_fd, F_SETFL, flags | O_NONBLOCK);
+  fcntl(m_fd, F_SETFD, FD_CLOEXEC);
+
+  if (::connect(m_fd, addr, addrLength) == 0) {
+    return;
+  }
+
+  const int error = errno;
+  if (error == EINPROGRESS || error == EAGAIN) {
+    m_connecting = true;
+    return;
+  }
+
+  close();
+  throw exceptions::CgiExecutionException(
+      "connect to " + m_address + " failed: " + getErrorMessage(error),
+      exceptions::CgiExecutionException::CONNECT_FAILED);
+}
+
+void FastCgiConnection::close() {
+  if (m_fd >= 0) {
+    ::close(m_fd);
+    m_fd = -1;
+  }
+}
+
+// The descriptor stays open until the connection is deleted: it may still be
+// registered with the event loop on behalf of the requests that used it.
+void FastCgiConnection::fail() {
+  m_peerClosed = true;
+  m_connecting = false;
+  for (ExchangeMap::iterator it = m_exchanges.begin(); it != m_exchanges.end();
+       ++it) {
+    if (!it->second.complete) {
+      it->second.updated = true;
+    }
+  }
+}
+
+unsigned short FastCgiConnection::allocateRequestId() {
+  for (unsigned int attempt = 0; attempt < K_MAX_REQUEST_ID; ++attempt) {
+    const unsigned short candidate = m_nextRequestId;
+    m_nextRequestId = (m_nextRequestId == K_MAX_REQUEST_ID)
+                          ? 1
+                          : static_cast<unsigned short>(m_nextRequestId + 1);
+    if (m_exchanges.find(candidate) == m_exchanges.end()) {
+      return candidate;
+    }
+  }
+
+  throw exceptions::CgiExecutionException(
+      "no free FastCGI request id on connection",
+      exceptions::CgiExecutionException::PROTOCOL_ERROR);
+}
+
+void FastCgiConnection::dispatch(const primitives::FastCgiRecord& record) {
+  if (record.type == primitives::FastCgiRecord::TYPE_GET_VALUES_RESULT) {
+    primitives::FastCgiRecord::ParameterMap values;
+    if (!record.content.empty() &&
+        primitives::FastCgiRecord::parseNameValues(
+            &record.content[0], record.content.size(), values)) {
+      m_multiplexing = values[K_MPXS_CONNS] == "1";
+    }
+    return;
+  }
+
+  ExchangeMap::iterator it = m_exchanges.find(record.requestId);
+  if (it == m_exchanges.end()) {
+    return;
+  }
+
+  Exchange& exchange = it->second;
+  switch (record.type) {
+    case primitives::FastCgiRecord::TYPE_STDOUT:
+      exchange.output.insert(exchange.output.end(), record.content.begin(),
+                             record.content.end());
+      break;
+    case primitives::FastCgiRecord::TYPE_STDERR:
+      exchange.errorOutput.insert(exchange.errorOutput.end(),
+                                  record.content.begin(),
+                                  record.content.end());
+      break;
+    case primitives::FastCgiRecord::TYPE_END_REQUEST:
+      exchange.appStatus = record.getAppStatus();
+      exchange.protocolStatus = record.getProtocolStatus();
+      exchange.complete = true;
+      break;
+    default:
+      return;
+  }
+  exchange.updated = true;
+}
+
+std::string FastCgiConnection::getErrorMessage(int errnoValue) {
+  return std::string(std::strerror(errnoValue));
+}
+
+}  // namespace adapters
+}  // namespace cgi
+}  // namespace infrastructure
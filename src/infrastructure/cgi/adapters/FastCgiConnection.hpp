@@ -0,0 +1,121 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FastCgiConnection.hpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 14:41:09 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 14:41:09 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef FAST_CGI_CONNECTION_HPP
+#define FAST_CGI_CONNECTION_HPP
+
+#include "infrastructure/cgi/primitives/CgiRequest.hpp"
+#include "infrastructure/cgi/primitives/FastCgiRecord.hpp"
+#include "infrastructure/cgi/primitives/FastCgiRecordDecoder.hpp"
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <sys/socket.h>
+#include <vector>
+
+namespace infrastructure {
+namespace cgi {
+namespace adapters {
+
+// One socket to a FastCGI server, possibly carrying several requests at once.
+// Nothing here blocks: requests are queued as records and go out on flush(),
+// and receive() takes whatever the server has sent and files each record
+// under its request. The owner tag of a request whose exchange changed is
+// reported by collectUpdated(), so the event loop can wake whoever waits on
+// it even when another request's read picked the records up.
+class FastCgiConnection {
+ public:
+  struct Exchange {
+    std::vector<char> output;
+    std::vector<char> errorOutput;
+    unsigned int appStatus;
+    primitives::FastCgiRecord::ProtocolStatus protocolStatus;
+    bool complete;
+    int owner;
+    bool updated;
+
+    Exchange();
+  };
+
+  static const std::size_t K_READ_CHUNK_SIZE = 16384;
+  static const unsigned short K_MAX_REQUEST_ID = 65535;
+
+  explicit FastCgiConnection(const std::string& address);
+  ~FastCgiConnection();
+
+  const std::string& getAddress() const;
+  int getFd() const;
+  bool isOpen() const;
+  bool isConnecting() const;
+  bool isIdle() const;
+  bool canMultiplex() const;
+  bool hasOutput() const;
+  bool isReusable() const;
+  std::size_t getPendingCount() const;
+  std::size_t getBytesReceived() const;
+  bool isPeerClosed() const;
+
+  void attach();
+  std::size_t detach();
+
+  void queryCapabilities();
+  unsigned short beginRequest(const primitives::CgiRequest& request,
+                              int owner);
+  Exchange* findExchange(unsigned short requestId);
+  void endRequest(unsigned short requestId);
+  void abortRequest(unsigned short requestId);
+
+  bool finishConnect();
+  void flush();
+  void receive();
+  void collectUpdated(std::vector<int>& owners);
+
+  static std::string unixSocketPath(const std::string& address);
+
+ private:
+  FastCgiConnection(const FastCgiConnection&);
+  FastCgiConnection& operator=(const FastCgiConnection&);
+
+  typedef std::map<unsigned short, Exchange> ExchangeMap;
+
+  std::string m_address;
+  int m_fd;
+  bool m_connecting;
+  bool m_peerClosed;
+  bool m_multiplexing;
+  bool m_aborted;
+  unsigned short m_nextRequestId;
+  std::size_t m_bytesReceived;
+  std::size_t m_attached;
+  std::vector<char> m_output;
+  std::size_t m_outputOffset;
+  ExchangeMap m_exchanges;
+  primitives::FastCgiRecordDecoder m_decoder;
+
+  void connectUnix(const std::string& path);
+  void connectTcp(const std::string& address);
+  void startConnect(const sockaddr* addr, socklen_t addrLength);
+  void close();
+  void fail();
+
+  unsigned short allocateRequestId();
+  void dispatch(const primitives::FastCgiRecord& record);
+
+  static std::string getErrorMessage(int errnoValue);
+};
+
+}  // namespace adapters
+}  // namespace cgi
+}  // namespace infrastructure
+
+#endif  // FAST_CGI_CONNECTION_HPP
@@ -0,0 +1,241 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FastCgiSession.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 13:05:12 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 13:05:12 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/cgi/adapters/FastCgiSession.hpp"
+#include "infrastructure/cgi/exceptions/CgiExecutionException.hpp"
+
+#include <sstream>
+
+namespace infrastructure {
+namespace cgi {
+namespace adapters {
+
+FastCgiSession::FastCgiSession(application::ports::ILogger& logger,
+                               FastCgiClient& client,
+                               const std::string& address,
+                               const primitives::CgiRequest& request)
+    : m_logger(logger),
+      m_client(client),
+      m_address(address),
+      m_request(request),
+      m_owner(-1),
+      m_state(STATE_IDLE),
+      m_connection(NULL),
+      m_requestId(0),
+      m_reused(false),
+      m_staleRetried(false),
+      m_received(0),
+      m_waitingSince(0) {}
+
+FastCgiSession::~FastCgiSession() { finish(); }
+
+// Tag reported by FastCgiClient::collectUpdated() when another request's
+// read on a shared connection picks up this request's records.
+void FastCgiSession::setOwner(int owner) { m_owner = owner; }
+
+void FastCgiSession::start() {
+  m_request.validate();
+  WEBSERV_LOG_DEBUG(m_logger, "Passing " << m_request.getScriptPath()
+                                         << " to FastCGI server "
+                                         << m_address);
+  connect();
+}
+
+// True once the server has ended the request; false while waiting on the
+// connection.
+bool FastCgiSession::advance() {
+  for (;;) {
+    try {
+      return step();
+    } catch (const exceptions::CgiExecutionException& ex) {
+      if (!canRetry()) {
+        throw;
+      }
+      m_staleRetried = true;
+      WEBSERV_LOG_DEBUG(m_logger, "Retrying on a fresh FastCGI connection: "
+                                      << ex.what());
+      dropConnection();
+      connect();
+    }
+  }
+}
+
+// The connect is bounded by K_CONNECT_TIMEOUT_SECONDS; after that the
+// server must keep the response moving within fastcgi timeout.
+void FastCgiSession::checkTimeout(std::time_t now) {
+  if (m_waitingSince == 0 || m_state == STATE_IDLE || m_state == STATE_DONE) {
+    return;
+  }
+
+  const unsigned int limit = m_state == STATE_CONNECTING
+                                 ? FastCgiClient::K_CONNECT_TIMEOUT_SECONDS
+                                 : m_client.getTimeout();
+  if (limit == 0 || now - m_waitingSince < static_cast<std::time_t>(limit)) {
+    return;
+  }
+
+  std::ostringstream oss;
+  oss << "FastCGI server " << m_address << " timed out after " << limit
+      << "s " << (m_state == STATE_CONNECTING ? "connecting" : "responding");
+  throw exceptions::CgiExecutionException(
+      oss.str(), exceptions::CgiExecutionException::TIMEOUT);
+}
+
+primitives::CgiResponse FastCgiSession::buildResponse() const {
+  if (!m_exchange.errorOutput.empty()) {
+    m_logger.warn("FastCGI stderr: " +
+                  std::string(m_exchange.errorOutput.begin(),
+                              m_exchange.errorOutput.end()));
+  }
+
+  if (m_exchange.protocolStatus !=
+      primitives::FastCgiRecord::STATUS_REQUEST_COMPLETE) {
+    std::ostringstream oss;
+    oss << "FastCGI server rejected request with protocol status "
+        << m_exchange.protocolStatus;
+    throw exceptions::CgiExecutionException(
+        oss.str(), exceptions::CgiExecutionException::PROTOCOL_ERROR);
+  }
+
+  if (m_exchange.output.empty()) {
+    std::ostringstream oss;
+    oss << "FastCGI application produced no output (status "
+        << m_exchange.appStatus << ")";
+    throw exceptions::CgiExecutionException(
+        oss.str(), exceptions::CgiExecutionException::INVALID_OUTPUT);
+  }
+
+  return primitives::CgiResponse::fromRawOutput(m_exchange.output);
+}
+
+// A request the server has not ended yet is aborted so a shared connection
+// can go on serving the others.
+void FastCgiSession::finish() {
+  if (m_connection != NULL) {
+    if (m_state != STATE_DONE) {
+      m_connection->abortRequest(m_requestId);
+    }
+    m_client.release(m_connection);
+    m_connection = NULL;
+  }
+  m_state = STATE_DONE;
+  releaseDiscarded();
+}
+
+// Connections given up on stay attached until the caller has taken their
+// descriptors off its event loop, so a new connection never reuses a
+// descriptor number the loop still watches.
+void FastCgiSession::releaseDiscarded() {
+  for (std::size_t i = 0; i < m_discarded.size(); ++i) {
+    m_client.release(m_discarded[i]);
+  }
+  m_discarded.clear();
+}
+
+int FastCgiSession::getFd() const {
+  return m_connection != NULL ? m_connection->getFd() : -1;
+}
+
+bool FastCgiSession::wantsWrite() const {
+  return m_state == STATE_CONNECTING ||
+         (m_connection != NULL && m_connection->hasOutput());
+}
+
+bool FastCgiSession::isFinished() const { return m_state == STATE_DONE; }
+
+bool FastCgiSession::isReused() const { return m_reused; }
+
+void FastCgiSession::connect() {
+  m_connection = m_client.acquire(m_address, m_reused);
+  try {
+    m_requestId = m_connection->beginRequest(m_request, m_owner);
+  } catch (...) {
+    m_discarded.push_back(m_connection);
+    m_connection = NULL;
+    throw;
+  }
+
+  m_received = 0;
+  m_waitingSince = std::time(NULL);
+  m_state = m_connection->isConnecting() ? STATE_CONNECTING : STATE_WAITING;
+  m_connection->flush();
+}
+
+bool FastCgiSession::step() {
+  if (m_state == STATE_DONE) {
+    return true;
+  }
+  if (m_state == STATE_CONNECTING) {
+    if (!m_connection->finishConnect()) {
+      return false;
+    }
+    m_state = STATE_WAITING;
+    m_waitingSince = std::time(NULL);
+  }
+
+  m_connection->flush();
+  m_connection->receive();
+
+  FastCgiConnection::Exchange* exchange =
+      m_connection->findExchange(m_requestId);
+  exchange->updated = false;
+
+  const std::size_t received =
+      exchange->output.size() + exchange->errorOutput.size();
+  if (received != m_received) {
+    m_received = received;
+    m_waitingSince = std::time(NULL);
+  }
+  if (exchange->output.size() > m_client.getMaxOutputSize()) {
+    throw exceptions::CgiExecutionException(
+        "FastCGI response exceeds maximum output size",
+        exceptions::CgiExecutionException::INVALID_OUTPUT);
+  }
+
+  if (exchange->complete) {
+    m_exchange.output.swap(exchange->output);
+    m_exchange.errorOutput.swap(exchange->errorOutput);
+    m_exchange.appStatus = exchange->appStatus;
+    m_exchange.protocolStatus = exchange->protocolStatus;
+    m_exchange.complete = true;
+    m_connection->endRequest(m_requestId);
+    m_state = STATE_DONE;
+    return true;
+  }
+  if (!m_connection->isOpen()) {
+    throw exceptions::CgiExecutionException(
+        "FastCGI server closed the connection mid-response",
+        exceptions::CgiExecutionException::PROTOCOL_ERROR);
+  }
+  return false;
+}
+
+// Only a request that reached a reused connection the server had already
+// closed is replayed, and only if nothing of its response has arrived.
+bool FastCgiSession::canRetry() const {
+  return m_connection != NULL && m_reused && !m_staleRetried &&
+         m_received == 0 && m_state == STATE_WAITING &&
+         !m_connection->isOpen();
+}
+
+void FastCgiSession::dropConnection() {
+  if (m_connection == NULL) {
+    return;
+  }
+  m_connection->abortRequest(m_requestId);
+  m_discarded.push_back(m_connection);
+  m_connection = NULL;
+}
+
+}  // namespace adapters
+}  // namespace cgi
+}  // namespace infrastructure
@@ -0,0 +1,88 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FastCgiSession.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 13:05:12 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 13:05:12 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef FAST_CGI_SESSION_HPP
+#define FAST_CGI_SESSION_HPP
+
+#include "application/ports/ILogger.hpp"
+#include "infrastructure/cgi/adapters/FastCgiClient.hpp"
+#include "infrastructure/cgi/adapters/FastCgiConnection.hpp"
+#include "infrastructure/cgi/primitives/CgiRequest.hpp"
+#include "infrastructure/cgi/primitives/CgiResponse.hpp"
+
+#include <cstddef>
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace infrastructure {
+namespace cgi {
+namespace adapters {
+
+// One request passed to a FastCGI server. Every step is non-blocking and
+// driven from the caller's event loop: advance() finishes the connect,
+// flushes the request records and collects the response until the server
+// ends the request. A request lost on a reused connection the server had
+// just closed is replayed once on a fresh one.
+class FastCgiSession {
+ public:
+  FastCgiSession(application::ports::ILogger& logger, FastCgiClient& client,
+                 const std::string& address,
+                 const primitives::CgiRequest& request);
+  ~FastCgiSession();
+
+  void setOwner(int owner);
+
+  void start();
+  bool advance();
+  void checkTimeout(std::time_t now);
+  primitives::CgiResponse buildResponse() const;
+  void finish();
+  void releaseDiscarded();
+
+  int getFd() const;
+  bool wantsWrite() const;
+  bool isFinished() const;
+  bool isReused() const;
+
+ private:
+  enum State { STATE_IDLE, STATE_CONNECTING, STATE_WAITING, STATE_DONE };
+
+  FastCgiSession(const FastCgiSession&);
+  FastCgiSession& operator=(const FastCgiSession&);
+
+  application::ports::ILogger& m_logger;
+  FastCgiClient& m_client;
+  std::string m_address;
+  primitives::CgiRequest m_request;
+  int m_owner;
+  State m_state;
+  FastCgiConnection* m_connection;
+  std::vector<FastCgiConnection*> m_discarded;
+  unsigned short m_requestId;
+  bool m_reused;
+  bool m_staleRetried;
+  std::size_t m_received;
+  std::time_t m_waitingSince;
+  FastCgiConnection::Exchange m_exchange;
+
+  void connect();
+  bool step();
+  bool canRetry() const;
+  void dropConnection();
+};
+
+}  // namespace adapters
+}  // namespace cgi
+}  // namespace infrastructure
+
+#endif  // FAST_CGI_SESSION_HPP
@@ -39,18 +39,22 @@ const std::pair<CgiExecutionException::ErrorCode, std::string>
         std::make_pair(CgiExecutionException::ENVIRONMENT_ERROR,
                        "Failed to set CGI environment"),
         std::make_pair(CgiExecutionException::INTERPRETER_NOT_FOUND,
-                       "CGI interpreter not found")};
+                       "CGI interpreter not found"),
+        std::make_pair(CgiExecutionException::CONNECT_FAILED,
+                       "Failed to connect to FastCGI server"),
+        std::make_pair(CgiExecutionException::PROTOCOL_ERROR,
+                       "FastCGI protocol error")};
 
 CgiExecutionException::CgiExecutionException(const std::string& message,
                                              ErrorCode code)
-    : BaseException("", static_cast<int>(code)) {
+    : BaseException("", static_cast<int>(code)), m_code(code) {
   std::ostringstream oss;
   oss << getErrorMsg(code) << ": " << message;
   this->m_whatMsg = oss.str();
 }
 
 CgiExecutionException::CgiExecutionException(const CgiExecutionException& other)
-    : BaseException(other) {}
+    : BaseException(other), m_code(other.m_code) {}
 
 CgiExecutionException::~CgiExecutionException() throw() {}
 
@@ -58,10 +62,15 @@ CgiExecutionException& CgiExecutionException::operator=(
     const CgiExecutionException& other) {
   if (this != &other) {
     BaseException::operator=(other);
+    m_code = other.m_code;
   }
   return *this;
 }
 
+CgiExecutionException::ErrorCode CgiExecutionException::getCode() const {
+  return m_code;
+}
+
 std::string CgiExecutionException::getErrorMsg(ErrorCode code) {
   for (int i = 0; i < CODE_COUNT; ++i) {
     if (K_CODE_MSGS[i].first == code) {
@@ -32,6 +32,8 @@ class CgiExecutionException : public ::shared::exceptions::BaseException {
     PROCESS_ERROR,
     ENVIRONMENT_ERROR,
     INTERPRETER_NOT_FOUND,
+    CONNECT_FAILED,
+    PROTOCOL_ERROR,
     CODE_COUNT
   };
 
@@ -41,7 +43,11 @@ class CgiExecutionException : public ::shared::exceptions::BaseException {
 
   CgiExecutionException& operator=(const CgiExecutionException& other);
 
+  ErrorCode getCode() const;
+
  private:
+  ErrorCode m_code;
+
   static const std::pair<ErrorCode, std::string> K_CODE_MSGS[];
 
   static std::string getErrorMsg(ErrorCode code);
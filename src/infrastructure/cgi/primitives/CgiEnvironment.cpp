@@ -0,0 +1,117 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CgiEnvironment.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 20:52:36 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 20:52:36 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/cgi/primitives/CgiEnvironment.hpp"
+
+#include <climits>
+#include <cstdlib>
+#include <unistd.h>
+
+namespace infrastructure {
+namespace cgi {
+namespace primitives {
+
+CgiEnvironment::CgiEnvironment() {}
+
+CgiEnvironment::CgiEnvironment(
+    const domain::configuration::value_objects::CgiConfig& cgiConfig) {
+  const VariableMap variables = buildVariables(cgiConfig);
+
+  m_entries.reserve(variables.size());
+  m_names.reserve(variables.size());
+  for (VariableMap::const_iterator it = variables.begin();
+       it != variables.end(); ++it) {
+    m_names.push_back(it->first);
+    m_entries.push_back(it->first + "=" + it->second);
+  }
+
+  VariableMap::const_iterator root = variables.find("DOCUMENT_ROOT");
+  if (root != variables.end()) {
+    m_documentRoot = root->second;
+  }
+}
+
+CgiEnvironment::CgiEnvironment(const CgiEnvironment& other)
+    : m_entries(other.m_entries),
+      m_names(other.m_names),
+      m_documentRoot(other.m_documentRoot) {}
+
+CgiEnvironment::~CgiEnvironment() {}
+
+CgiEnvironment& CgiEnvironment::operator=(const CgiEnvironment& other) {
+  if (this != &other) {
+    m_entries = other.m_entries;
+    m_names = other.m_names;
+    m_documentRoot = other.m_documentRoot;
+  }
+  return *this;
+}
+
+const std::vector<std::string>& CgiEnvironment::getEntries() const {
+  return m_entries;
+}
+
+const std::string& CgiEnvironment::getDocumentRoot() const {
+  return m_documentRoot;
+}
+
+std::size_t CgiEnvironment::size() const { return m_entries.size(); }
+
+void CgiEnvironment::appendTo(std::vector<char*>& envp,
+                              const VariableMap& overrides) const {
+  for (std::size_t i = 0; i < m_entries.size(); ++i) {
+    if (overrides.find(m_names[i]) == overrides.end()) {
+      envp.push_back(const_cast<char*>(m_entries[i].c_str()));
+    }
+  }
+}
+
+CgiEnvironment::VariableMap CgiEnvironment::buildVariables(
+    const domain::configuration::value_objects::CgiConfig& cgiConfig) {
+  VariableMap variables(cgiConfig.getParameters().begin(),
+                        cgiConfig.getParameters().end());
+
+  variables["SERVER_SOFTWARE"] = "WebServ/1.0";
+  variables["SERVER_PROTOCOL"] = "HTTP/1.1";
+  variables["GATEWAY_INTERFACE"] = "CGI/1.1";
+  variables["DOCUMENT_ROOT"] =
+      resolveDocumentRoot(cgiConfig.getCgiRoot().toString());
+  variables["REDIRECT_STATUS"] = "200";
+
+  return variables;
+}
+
+std::string CgiEnvironment::resolveDocumentRoot(
+    const std::string& documentRoot) {
+  if (documentRoot.empty() || documentRoot[0] == '/') {
+    return documentRoot;
+  }
+
+  char resolvedRoot[PATH_MAX];
+  if (realpath(documentRoot.c_str(), resolvedRoot) != NULL) {
+    return resolvedRoot;
+  }
+
+  char cwd[PATH_MAX];
+  if (getcwd(cwd, sizeof(cwd)) == NULL) {
+    return documentRoot;
+  }
+  if (documentRoot.length() >= 2 && documentRoot[0] == '.' &&
+      documentRoot[1] == '/') {
+    return std::string(cwd) + "/" + documentRoot.substr(2);
+  }
+  return std::string(cwd) + "/" + documentRoot;
+}
+
+}  // namespace primitives
+}  // namespace cgi
+}  // namespace infrastructure
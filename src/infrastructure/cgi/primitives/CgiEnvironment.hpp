@@ -0,0 +1,62 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   CgiEnvironment.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 20:52:36 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 20:52:36 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef CGI_ENVIRONMENT_HPP
+#define CGI_ENVIRONMENT_HPP
+
+#include "domain/configuration/value_objects/CgiConfig.hpp"
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace infrastructure {
+namespace cgi {
+namespace primitives {
+
+// The part of a CGI environment that depends only on the location: cgi_param
+// values, server identity and the resolved document root. It is rendered to
+// "NAME=VALUE" strings once and shared by every request routed there.
+class CgiEnvironment {
+ public:
+  typedef std::map<std::string, std::string> VariableMap;
+
+  CgiEnvironment();
+  explicit CgiEnvironment(
+      const domain::configuration::value_objects::CgiConfig& cgiConfig);
+  CgiEnvironment(const CgiEnvironment& other);
+  ~CgiEnvironment();
+
+  CgiEnvironment& operator=(const CgiEnvironment& other);
+
+  const std::vector<std::string>& getEntries() const;
+  const std::string& getDocumentRoot() const;
+  std::size_t size() const;
+
+  void appendTo(std::vector<char*>& envp, const VariableMap& overrides) const;
+
+  static VariableMap buildVariables(
+      const domain::configuration::value_objects::CgiConfig& cgiConfig);
+  static std::string resolveDocumentRoot(const std::string& documentRoot);
+
+ private:
+  std::vector<std::string> m_entries;
+  std::vector<std::string> m_names;
+  std::string m_documentRoot;
+};
+
+}  // namespace primitives
+}  // namespace cgi
+}  // namespace infrastructure
+
+#endif  // CGI_ENVIRONMENT_HPP
@@ -24,17 +24,38 @@ namespace infrastructure {
 namespace cgi {
 namespace primitives {
 
-CgiRequest::CgiRequest() {}
+CgiRequest::CgiRequest() : m_sharedEnvironment(NULL) {}
 
 CgiRequest::CgiRequest(
     const domain::http::entities::HttpRequest& httpRequest,
     const domain::configuration::value_objects::CgiConfig& cgiConfig,
     const domain::http::value_objects::RouteMatchInfo& matchInfo,
     const std::string& serverName, unsigned int serverPort)
+    : m_environment(CgiEnvironment::buildVariables(cgiConfig)),
+      m_scriptPath(matchInfo.getFileToServe()),
+      m_interpreter(cgiConfig.getScriptPath()),
+      m_sharedEnvironment(NULL) {
+  buildRequestEnvironment(httpRequest, matchInfo, serverName, serverPort,
+                          m_environment["DOCUMENT_ROOT"]);
+
+  if (httpRequest.hasBody()) {
+    m_requestBody = httpRequest.getBody();
+  }
+
+  validate();
+}
+
+CgiRequest::CgiRequest(
+    const domain::http::entities::HttpRequest& httpRequest,
+    const domain::configuration::value_objects::CgiConfig& cgiConfig,
+    const domain::http::value_objects::RouteMatchInfo& matchInfo,
+    const std::string& serverName, unsigned int serverPort,
+    const CgiEnvironment& sharedEnvironment)
     : m_scriptPath(matchInfo.getFileToServe()),
-      m_interpreter(cgiConfig.getScriptPath()) {
-  buildStandardEnvironment(httpRequest, cgiConfig, matchInfo, serverName,
-                           serverPort);
+      m_interpreter(cgiConfig.getScriptPath()),
+      m_sharedEnvironment(&sharedEnvironment) {
+  buildRequestEnvironment(httpRequest, matchInfo, serverName, serverPort,
+                          sharedEnvironment.getDocumentRoot());
 
   if (httpRequest.hasBody()) {
     m_requestBody = httpRequest.getBody();
@@ -47,7 +68,8 @@ CgiRequest::CgiRequest(const CgiRequest& other)
     : m_environment(other.m_environment),
       m_requestBody(other.m_requestBody),
       m_scriptPath(other.m_scriptPath),
-      m_interpreter(other.m_interpreter) {}
+      m_interpreter(other.m_interpreter),
+      m_sharedEnvironment(other.m_sharedEnvironment) {}
 
 CgiRequest::~CgiRequest() {}
 
@@ -57,6 +79,7 @@ CgiRequest& CgiRequest::operator=(const CgiRequest& other) {
     m_requestBody = other.m_requestBody;
     m_scriptPath = other.m_scriptPath;
     m_interpreter = other.m_interpreter;
+    m_sharedEnvironment = other.m_sharedEnvironment;
     m_envStrings.clear();
   }
   return *this;
@@ -74,6 +97,10 @@ const std::string& CgiRequest::getScriptPath() const { return m_scriptPath; }
 
 const std::string& CgiRequest::getInterpreter() const { return m_interpreter; }
 
+const CgiEnvironment* CgiRequest::getSharedEnvironment() const {
+  return m_sharedEnvironment;
+}
+
 void CgiRequest::setEnvironmentVariable(const std::string& name,
                                         const std::string& value) {
   if (!isValidEnvironmentName(name)) {
@@ -118,6 +145,11 @@ std::vector<char*> CgiRequest::buildEnvp() const {
   std::vector<char*> envp;
   envp.reserve(m_environment.size() + 1);
 
+  if (m_sharedEnvironment != NULL) {
+    envp.reserve(m_sharedEnvironment->size() + m_environment.size() + 1);
+    m_sharedEnvironment->appendTo(envp, m_environment);
+  }
+
   for (EnvironmentMap::const_iterator it = m_environment.begin();
        it != m_environment.end(); ++it) {
     std::string envString = it->first + "=" + it->second;
@@ -161,7 +193,8 @@ void CgiRequest::validate() const {
         exceptions::CgiExecutionException::ENVIRONMENT_ERROR);
   }
 
-  if (m_environment.find("SERVER_PROTOCOL") == m_environment.end()) {
+  if (m_sharedEnvironment == NULL &&
+      m_environment.find("SERVER_PROTOCOL") == m_environment.end()) {
     throw exceptions::CgiExecutionException(
         "Missing SERVER_PROTOCOL environment variable",
         exceptions::CgiExecutionException::ENVIRONMENT_ERROR);
@@ -176,23 +209,15 @@ CgiRequest CgiRequest::fromHttpRequest(
   return CgiRequest(httpRequest, cgiConfig, matchInfo, serverName, serverPort);
 }
 
-void CgiRequest::buildStandardEnvironment(
+void CgiRequest::buildRequestEnvironment(
     const domain::http::entities::HttpRequest& httpRequest,
-    const domain::configuration::value_objects::CgiConfig& cgiConfig,
     const domain::http::value_objects::RouteMatchInfo& matchInfo,
-    const std::string& serverName, unsigned int serverPort) {
-  const domain::configuration::value_objects::CgiConfig::ParameterMap& params =
-      cgiConfig.getParameters();
-  for (domain::configuration::value_objects::CgiConfig::ParameterMap::
-           const_iterator it = params.begin();
-       it != params.end(); ++it) {
-    m_environment[it->first] = it->second;
-  }
-
+    const std::string& serverName, unsigned int serverPort,
+    const std::string& documentRoot) {
   addRequestMethodInfo(httpRequest);
   addServerInfo(serverName, serverPort);
-  addScriptInfo(cgiConfig, matchInfo);
-  addPathInfo(httpRequest, matchInfo);
+  addScriptInfo(matchInfo);
+  addPathInfo(httpRequest, matchInfo, documentRoot);
   addQueryString(httpRequest);
   addContentInfo(httpRequest);
   addHttpHeaders(httpRequest);
@@ -211,14 +236,9 @@ void CgiRequest::addServerInfo(const std::string& serverName,
   std::ostringstream oss;
   oss << serverPort;
   m_environment["SERVER_PORT"] = oss.str();
-
-  m_environment["SERVER_SOFTWARE"] = "WebServ/1.0";
-  m_environment["SERVER_PROTOCOL"] = "HTTP/1.1";
-  m_environment["GATEWAY_INTERFACE"] = "CGI/1.1";
 }
 
 void CgiRequest::addScriptInfo(
-    const domain::configuration::value_objects::CgiConfig& cgiConfig,
     const domain::http::value_objects::RouteMatchInfo& matchInfo) {
   std::string fileToServe = matchInfo.getFileToServe();
   std::string absoluteScriptPath = fileToServe;
@@ -238,30 +258,12 @@ void CgiRequest::addScriptInfo(
     }
   }
   m_environment["SCRIPT_FILENAME"] = absoluteScriptPath;
-  std::string documentRoot = cgiConfig.getCgiRoot().toString();
-  if (!documentRoot.empty() && documentRoot[0] != '/') {
-    char resolvedRoot[PATH_MAX];
-    if (realpath(documentRoot.c_str(), resolvedRoot) != NULL) {
-      documentRoot = resolvedRoot;
-    } else {
-      char cwd[PATH_MAX];
-      if (getcwd(cwd, sizeof(cwd)) != NULL) {
-        if (documentRoot.length() >= 2 && documentRoot[0] == '.' &&
-            documentRoot[1] == '/') {
-          documentRoot = std::string(cwd) + "/" + documentRoot.substr(2);
-        } else {
-          documentRoot = std::string(cwd) + "/" + documentRoot;
-        }
-      }
-    }
-  }
-  m_environment["DOCUMENT_ROOT"] = documentRoot;
-  m_environment["REDIRECT_STATUS"] = "200";
 }
 
 void CgiRequest::addPathInfo(
     const domain::http::entities::HttpRequest& httpRequest,
-    const domain::http::value_objects::RouteMatchInfo& matchInfo) {
+    const domain::http::value_objects::RouteMatchInfo& matchInfo,
+    const std::string& documentRoot) {
   std::string requestPath = httpRequest.getPath().toString();
   std::string scriptName = matchInfo.getFileToServe();
 
@@ -270,8 +272,6 @@ void CgiRequest::addPathInfo(
   std::string pathInfo = extractPathInfo(requestPath, scriptName);
   if (!pathInfo.empty()) {
     m_environment["PATH_INFO"] = pathInfo;
-
-    std::string documentRoot = m_environment["DOCUMENT_ROOT"];
     m_environment["PATH_TRANSLATED"] = documentRoot + pathInfo;
   }
 
@@ -299,8 +299,10 @@ void CgiRequest::addContentInfo(
     oss << httpRequest.getBody().size();
     m_environment["CONTENT_LENGTH"] = oss.str();
 
-    if (httpRequest.hasHeader("content-type")) {
-      m_environment["CONTENT_TYPE"] = httpRequest.getHeader("content-type");
+    if (httpRequest.hasHeader(
+            domain::http::value_objects::HttpHeader::HEADER_CONTENT_TYPE)) {
+      m_environment["CONTENT_TYPE"] = httpRequest.getHeader(
+          domain::http::value_objects::HttpHeader::HEADER_CONTENT_TYPE);
     }
   } else {
     m_environment["CONTENT_LENGTH"] = "0";
@@ -309,7 +311,7 @@ void CgiRequest::addContentInfo(
 
 void CgiRequest::addHttpHeaders(
     const domain::http::entities::HttpRequest& httpRequest) {
-  const std::map<std::string, std::string>& headers = httpRequest.getHeaders();
+  const std::map<std::string, std::string> headers = httpRequest.getHeaders();
 
   for (std::map<std::string, std::string>::const_iterator it = headers.begin();
        it != headers.end(); ++it) {
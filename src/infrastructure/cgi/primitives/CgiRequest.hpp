@@ -16,6 +16,7 @@
 #include "domain/configuration/value_objects/CgiConfig.hpp"
 #include "domain/http/entities/HttpRequest.hpp"
 #include "domain/http/value_objects/RouteMatchInfo.hpp"
+#include "infrastructure/cgi/primitives/CgiEnvironment.hpp"
 
 #include <map>
 #include <string>
@@ -25,6 +26,8 @@ namespace infrastructure {
 namespace cgi {
 namespace primitives {
 
+// When built against a shared CgiEnvironment, getEnvironment() only holds the
+// per-request variables; buildEnvp() places the shared block in front of them.
 class CgiRequest {
  public:
   typedef std::map<std::string, std::string> EnvironmentMap;
@@ -34,6 +37,11 @@ class CgiRequest {
              const domain::configuration::value_objects::CgiConfig& cgiConfig,
              const domain::http::value_objects::RouteMatchInfo& matchInfo,
              const std::string& serverName, unsigned int serverPort);
+  CgiRequest(const domain::http::entities::HttpRequest& httpRequest,
+             const domain::configuration::value_objects::CgiConfig& cgiConfig,
+             const domain::http::value_objects::RouteMatchInfo& matchInfo,
+             const std::string& serverName, unsigned int serverPort,
+             const CgiEnvironment& sharedEnvironment);
 
   CgiRequest(const CgiRequest& other);
   ~CgiRequest();
@@ -44,6 +52,7 @@ class CgiRequest {
   const std::vector<char>& getRequestBody() const;
   const std::string& getScriptPath() const;
   const std::string& getInterpreter() const;
+  const CgiEnvironment* getSharedEnvironment() const;
 
   void setEnvironmentVariable(const std::string& name,
                                const std::string& value);
@@ -67,24 +76,25 @@ class CgiRequest {
   std::vector<char> m_requestBody;
   std::string m_scriptPath;
   std::string m_interpreter;
+  const CgiEnvironment* m_sharedEnvironment;
 
   mutable std::vector<std::string> m_envStrings;
 
-  void buildStandardEnvironment(
+  void buildRequestEnvironment(
       const domain::http::entities::HttpRequest& httpRequest,
-      const domain::configuration::value_objects::CgiConfig& cgiConfig,
       const domain::http::value_objects::RouteMatchInfo& matchInfo,
-      const std::string& serverName, unsigned int serverPort);
+      const std::string& serverName, unsigned int serverPort,
+      const std::string& documentRoot);
 
   void addRequestMethodInfo(
       const domain::http::entities::HttpRequest& httpRequest);
   void addServerInfo(const std::string& serverName, unsigned int serverPort);
   void addScriptInfo(
-      const domain::configuration::value_objects::CgiConfig& cgiConfig,
       const domain::http::value_objects::RouteMatchInfo& matchInfo);
   void addPathInfo(
       const domain::http::entities::HttpRequest& httpRequest,
-      const domain::http::value_objects::RouteMatchInfo& matchInfo);
+      const domain::http::value_objects::RouteMatchInfo& matchInfo,
+      const std::string& documentRoot);
   void addQueryString(const domain::http::entities::HttpRequest& httpRequest);
   void addContentInfo(const domain::http::entities::HttpRequest& httpRequest);
   void addHttpHeaders(const domain::http::entities::HttpRequest& httpRequest);
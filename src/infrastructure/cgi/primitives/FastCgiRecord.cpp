@@ -0,0 +1,263 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FastCgiRecord.cpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 14:02:18 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 14:02:18 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/cgi/primitives/FastCgiRecord.hpp"
+
+namespace infrastructure {
+namespace cgi {
+namespace primitives {
+
+const unsigned char FastCgiRecord::K_VERSION;
+const unsigned char FastCgiRecord::K_FLAG_KEEP_CONN;
+const std::size_t FastCgiRecord::K_HEADER_SIZE;
+const std::size_t FastCgiRecord::K_BEGIN_REQUEST_BODY_SIZE;
+const std::size_t FastCgiRecord::K_END_REQUEST_BODY_SIZE;
+const std::size_t FastCgiRecord::K_MAX_CONTENT_LENGTH;
+const std::size_t FastCgiRecord::K_ALIGNMENT;
+
+namespace {
+
+const std::size_t K_SHORT_LENGTH_LIMIT = 127;
+const std::size_t K_LONG_LENGTH_SIZE = 4;
+const unsigned char K_LONG_LENGTH_FLAG = 0x80;
+const std::size_t K_BYTE_BITS = 8;
+const unsigned int K_BYTE_MASK = 0xFF;
+
+inline unsigned char byteAt(const char* data, std::size_t index) {
+  return static_cast<unsigned char>(data[index]);
+}
+
+}  // namespace
+
+FastCgiRecord::FastCgiRecord() : type(TYPE_UNKNOWN_TYPE), requestId(0) {}
+
+FastCgiRecord::FastCgiRecord(Type recordType, unsigned short recordRequestId)
+    : type(recordType), requestId(recordRequestId) {}
+
+FastCgiRecord::FastCgiRecord(const FastCgiRecord& other)
+    : type(other.type), requestId(other.requestId), content(other.content) {}
+
+FastCgiRecord::~FastCgiRecord() {}
+
+FastCgiRecord& FastCgiRecord::operator=(const FastCgiRecord& other) {
+  if (this != &other) {
+    type = other.type;
+    requestId = other.requestId;
+    content = other.content;
+  }
+  return *this;
+}
+
+bool FastCgiRecord::isEndOfStream() const { return content.empty(); }
+
+unsigned int FastCgiRecord::getAppStatus() const {
+  if (type != TYPE_END_REQUEST || content.size() < K_END_REQUEST_BODY_SIZE) {
+    return 0;
+  }
+
+  unsigned int status = 0;
+  for (std::size_t i = 0; i < K_LONG_LENGTH_SIZE; ++i) {
+    status = (status << K_BYTE_BITS) | byteAt(&content[0], i);
+  }
+  return status;
+}
+
+FastCgiRecord::ProtocolStatus FastCgiRecord::getProtocolStatus() const {
+  if (type != TYPE_END_REQUEST || content.size() < K_END_REQUEST_BODY_SIZE) {
+    return STATUS_REQUEST_COMPLETE;
+  }
+  return static_cast<ProtocolStatus>(byteAt(&content[0], K_LONG_LENGTH_SIZE));
+}
+
+void FastCgiRecord::appendBeginRequest(std::vector<char>& out,
+                                       unsigned short requestId, Role role,
+                                       bool keepConnection) {
+  const char body[K_BEGIN_REQUEST_BODY_SIZE] = {
+      static_cast<char>((role >> K_BYTE_BITS) & K_BYTE_MASK),
+      static_cast<char>(role & K_BYTE_MASK),
+      static_cast<char>(keepConnection ? K_FLAG_KEEP_CONN : 0),
+      0,
+      0,
+      0,
+      0,
+      0};
+  appendRecord(out, TYPE_BEGIN_REQUEST, requestId, body, sizeof(body));
+}
+
+void FastCgiRecord::appendEndRequest(std::vector<char>& out,
+                                     unsigned short requestId,
+                                     unsigned int appStatus,
+                                     ProtocolStatus status) {
+  const char body[K_END_REQUEST_BODY_SIZE] = {
+      static_cast<char>((appStatus >> 24) & K_BYTE_MASK),
+      static_cast<char>((appStatus >> 16) & K_BYTE_MASK),
+      static_cast<char>((appStatus >> 8) & K_BYTE_MASK),
+      static_cast<char>(appStatus & K_BYTE_MASK),
+      static_cast<char>(status),
+      0,
+      0,
+      0};
+  appendRecord(out, TYPE_END_REQUEST, requestId, body, sizeof(body));
+}
+
+void FastCgiRecord::appendAbortRequest(std::vector<char>& out,
+                                       unsigned short requestId) {
+  appendRecord(out, TYPE_ABORT_REQUEST, requestId, NULL, 0);
+}
+
+void FastCgiRecord::appendParams(std::vector<char>& out,
+                                 unsigned short requestId,
+                                 const ParameterMap& params) {
+  std::vector<char> encoded;
+  for (ParameterMap::const_iterator it = params.begin(); it != params.end();
+       ++it) {
+    appendNameValue(encoded, it->first, it->second);
+  }
+
+  appendStream(out, TYPE_PARAMS, requestId,
+               encoded.empty() ? NULL : &encoded[0], encoded.size());
+  appendStreamEnd(out, TYPE_PARAMS, requestId);
+}
+
+void FastCgiRecord::appendStream(std::vector<char>& out, Type type,
+                                 unsigned short requestId, const char* data,
+                                 std::size_t length) {
+  std::size_t offset = 0;
+  while (offset < length) {
+    std::size_t chunk = length - offset;
+    if (chunk > K_MAX_CONTENT_LENGTH) {
+      chunk = K_MAX_CONTENT_LENGTH;
+    }
+    appendRecord(out, type, requestId, data + offset, chunk);
+    offset += chunk;
+  }
+}
+
+void FastCgiRecord::appendStreamEnd(std::vector<char>& out, Type type,
+                                    unsigned short requestId) {
+  appendRecord(out, type, requestId, NULL, 0);
+}
+
+void FastCgiRecord::appendNameValue(std::vector<char>& out,
+                                    const std::string& name,
+                                    const std::string& value) {
+  appendLength(out, name.size());
+  appendLength(out, value.size());
+  out.insert(out.end(), name.begin(), name.end());
+  out.insert(out.end(), value.begin(), value.end());
+}
+
+bool FastCgiRecord::parseNameValues(const char* data, std::size_t length,
+                                    ParameterMap& out) {
+  std::size_t offset = 0;
+  while (offset < length) {
+    std::size_t nameLength = 0;
+    std::size_t valueLength = 0;
+    if (!readLength(data, length, offset, nameLength) ||
+        !readLength(data, length, offset, valueLength) ||
+        length - offset < nameLength + valueLength) {
+      return false;
+    }
+
+    out[std::string(data + offset, nameLength)] =
+        std::string(data + offset + nameLength, valueLength);
+    offset += nameLength + valueLength;
+  }
+  return true;
+}
+
+// Management records (GET_VALUES and its result) carry name-value pairs on
+// request id 0; a query leaves every value empty.
+void FastCgiRecord::appendValues(std::vector<char>& out, Type type,
+                                 const ParameterMap& values) {
+  std::vector<char> encoded;
+  for (ParameterMap::const_iterator it = values.begin(); it != values.end();
+       ++it) {
+    appendNameValue(encoded, it->first, it->second);
+  }
+  appendRecord(out, type, 0, encoded.empty() ? NULL : &encoded[0],
+               encoded.size());
+}
+
+void FastCgiRecord::appendHeader(std::vector<char>& out, Type type,
+                                 unsigned short requestId,
+                                 std::size_t contentLength,
+                                 std::size_t paddingLength) {
+  const char header[K_HEADER_SIZE] = {
+      static_cast<char>(K_VERSION),
+      static_cast<char>(type),
+      static_cast<char>((requestId >> K_BYTE_BITS) & K_BYTE_MASK),
+      static_cast<char>(requestId & K_BYTE_MASK),
+      static_cast<char>((contentLength >> K_BYTE_BITS) & K_BYTE_MASK),
+      static_cast<char>(contentLength & K_BYTE_MASK),
+      static_cast<char>(paddingLength),
+      0};
+  out.insert(out.end(), header, header + K_HEADER_SIZE);
+}
+
+void FastCgiRecord::appendRecord(std::vector<char>& out, Type type,
+                                 unsigned short requestId, const char* data,
+                                 std::size_t length) {
+  const std::size_t padding = paddingFor(length);
+  out.reserve(out.size() + K_HEADER_SIZE + length + padding);
+  appendHeader(out, type, requestId, length, padding);
+  if (length > 0) {
+    out.insert(out.end(), data, data + length);
+  }
+  out.insert(out.end(), padding, '\0');
+}
+
+void FastCgiRecord::appendLength(std::vector<char>& out, std::size_t length) {
+  if (length <= K_SHORT_LENGTH_LIMIT) {
+    out.push_back(static_cast<char>(length));
+    return;
+  }
+
+  out.push_back(static_cast<char>(((length >> 24) & K_BYTE_MASK) |
+                                  K_LONG_LENGTH_FLAG));
+  out.push_back(static_cast<char>((length >> 16) & K_BYTE_MASK));
+  out.push_back(static_cast<char>((length >> 8) & K_BYTE_MASK));
+  out.push_back(static_cast<char>(length & K_BYTE_MASK));
+}
+
+bool FastCgiRecord::readLength(const char* data, std::size_t length,
+                               std::size_t& offset, std::size_t& value) {
+  if (offset >= length) {
+    return false;
+  }
+
+  const unsigned char first = byteAt(data, offset);
+  if ((first & K_LONG_LENGTH_FLAG) == 0) {
+    value = first;
+    offset += 1;
+    return true;
+  }
+
+  if (length - offset < K_LONG_LENGTH_SIZE) {
+    return false;
+  }
+
+  value = first & ~K_LONG_LENGTH_FLAG;
+  for (std::size_t i = 1; i < K_LONG_LENGTH_SIZE; ++i) {
+    value = (value << K_BYTE_BITS) | byteAt(data, offset + i);
+  }
+  offset += K_LONG_LENGTH_SIZE;
+  return true;
+}
+
+std::size_t FastCgiRecord::paddingFor(std::size_t contentLength) {
+  return (K_ALIGNMENT - (contentLength % K_ALIGNMENT)) % K_ALIGNMENT;
+}
+
+}  // namespace primitives
+}  // namespace cgi
+}  // namespace infrastructure
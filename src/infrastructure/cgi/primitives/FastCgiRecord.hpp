@@ -0,0 +1,114 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FastCgiRecord.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 14:02:18 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 14:02:18 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef FAST_CGI_RECORD_HPP
+#define FAST_CGI_RECORD_HPP
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace infrastructure {
+namespace cgi {
+namespace primitives {
+
+class FastCgiRecord {
+ public:
+  typedef std::map<std::string, std::string> ParameterMap;
+
+  enum Type {
+    TYPE_BEGIN_REQUEST = 1,
+    TYPE_ABORT_REQUEST = 2,
+    TYPE_END_REQUEST = 3,
+    TYPE_PARAMS = 4,
+    TYPE_STDIN = 5,
+    TYPE_STDOUT = 6,
+    TYPE_STDERR = 7,
+    TYPE_DATA = 8,
+    TYPE_GET_VALUES = 9,
+    TYPE_GET_VALUES_RESULT = 10,
+    TYPE_UNKNOWN_TYPE = 11
+  };
+
+  enum Role { ROLE_RESPONDER = 1, ROLE_AUTHORIZER = 2, ROLE_FILTER = 3 };
+
+  enum ProtocolStatus {
+    STATUS_REQUEST_COMPLETE = 0,
+    STATUS_CANT_MPX_CONN = 1,
+    STATUS_OVERLOADED = 2,
+    STATUS_UNKNOWN_ROLE = 3
+  };
+
+  static const unsigned char K_VERSION = 1;
+  static const unsigned char K_FLAG_KEEP_CONN = 1;
+  static const std::size_t K_HEADER_SIZE = 8;
+  static const std::size_t K_BEGIN_REQUEST_BODY_SIZE = 8;
+  static const std::size_t K_END_REQUEST_BODY_SIZE = 8;
+  static const std::size_t K_MAX_CONTENT_LENGTH = 65535;
+  static const std::size_t K_ALIGNMENT = 8;
+
+  FastCgiRecord();
+  FastCgiRecord(Type type, unsigned short requestId);
+  FastCgiRecord(const FastCgiRecord& other);
+  ~FastCgiRecord();
+
+  FastCgiRecord& operator=(const FastCgiRecord& other);
+
+  Type type;
+  unsigned short requestId;
+  std::vector<char> content;
+
+  bool isEndOfStream() const;
+  unsigned int getAppStatus() const;
+  ProtocolStatus getProtocolStatus() const;
+
+  static void appendBeginRequest(std::vector<char>& out,
+                                 unsigned short requestId, Role role,
+                                 bool keepConnection);
+  static void appendEndRequest(std::vector<char>& out, unsigned short requestId,
+                               unsigned int appStatus, ProtocolStatus status);
+  static void appendAbortRequest(std::vector<char>& out,
+                                 unsigned short requestId);
+  static void appendParams(std::vector<char>& out, unsigned short requestId,
+                           const ParameterMap& params);
+  static void appendStream(std::vector<char>& out, Type type,
+                           unsigned short requestId, const char* data,
+                           std::size_t length);
+  static void appendStreamEnd(std::vector<char>& out, Type type,
+                              unsigned short requestId);
+
+  static void appendNameValue(std::vector<char>& out, const std::string& name,
+                              const std::string& value);
+  static bool parseNameValues(const char* data, std::size_t length,
+                              ParameterMap& out);
+  static void appendValues(std::vector<char>& out, Type type,
+                           const ParameterMap& values);
+
+ private:
+  static void appendHeader(std::vector<char>& out, Type type,
+                           unsigned short requestId, std::size_t contentLength,
+                           std::size_t paddingLength);
+  static void appendRecord(std::vector<char>& out, Type type,
+                           unsigned short requestId, const char* data,
+                           std::size_t length);
+  static void appendLength(std::vector<char>& out, std::size_t length);
+  static bool readLength(const char* data, std::size_t length,
+                         std::size_t& offset, std::size_t& value);
+  static std::size_t paddingFor(std::size_t contentLength);
+};
+
+}  // namespace primitives
+}  // namespace cgi
+}  // namespace infrastructure
+
+#endif  // FAST_CGI_RECORD_HPP
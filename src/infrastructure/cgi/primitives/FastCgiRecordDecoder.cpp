@@ -0,0 +1,103 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FastCgiRecordDecoder.cpp                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 14:20:44 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 14:20:44 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/cgi/exceptions/CgiExecutionException.hpp"
+#include "infrastructure/cgi/primitives/FastCgiRecordDecoder.hpp"
+
+#include <sstream>
+
+namespace infrastructure {
+namespace cgi {
+namespace primitives {
+
+namespace {
+
+const std::size_t K_BYTE_BITS = 8;
+const std::size_t K_COMPACT_THRESHOLD = 16384;
+
+inline std::size_t readShort(const char* data) {
+  return (static_cast<std::size_t>(static_cast<unsigned char>(data[0]))
+          << K_BYTE_BITS) |
+         static_cast<unsigned char>(data[1]);
+}
+
+}  // namespace
+
+FastCgiRecordDecoder::FastCgiRecordDecoder() : m_offset(0) {}
+
+FastCgiRecordDecoder::~FastCgiRecordDecoder() {}
+
+void FastCgiRecordDecoder::feed(const char* data, std::size_t length) {
+  if (length == 0) {
+    return;
+  }
+  compact();
+  m_buffer.insert(m_buffer.end(), data, data + length);
+}
+
+bool FastCgiRecordDecoder::next(FastCgiRecord& record) {
+  const std::size_t available = bufferedBytes();
+  if (available < FastCgiRecord::K_HEADER_SIZE) {
+    return false;
+  }
+
+  const char* header = &m_buffer[m_offset];
+  if (static_cast<unsigned char>(header[0]) != FastCgiRecord::K_VERSION) {
+    std::ostringstream oss;
+    oss << "unsupported FastCGI record version "
+        << static_cast<unsigned int>(static_cast<unsigned char>(header[0]));
+    throw exceptions::CgiExecutionException(
+        oss.str(), exceptions::CgiExecutionException::PROTOCOL_ERROR);
+  }
+
+  const std::size_t contentLength = readShort(header + 4);
+  const std::size_t paddingLength = static_cast<unsigned char>(header[6]);
+  const std::size_t recordLength =
+      FastCgiRecord::K_HEADER_SIZE + contentLength + paddingLength;
+  if (available < recordLength) {
+    return false;
+  }
+
+  record.type = static_cast<FastCgiRecord::Type>(
+      static_cast<unsigned char>(header[1]));
+  record.requestId = static_cast<unsigned short>(readShort(header + 2));
+  record.content.assign(header + FastCgiRecord::K_HEADER_SIZE,
+                        header + FastCgiRecord::K_HEADER_SIZE + contentLength);
+
+  m_offset += recordLength;
+  if (m_offset == m_buffer.size()) {
+    reset();
+  }
+  return true;
+}
+
+std::size_t FastCgiRecordDecoder::bufferedBytes() const {
+  return m_buffer.size() - m_offset;
+}
+
+void FastCgiRecordDecoder::reset() {
+  m_buffer.clear();
+  m_offset = 0;
+}
+
+void FastCgiRecordDecoder::compact() {
+  if (m_offset < K_COMPACT_THRESHOLD) {
+    return;
+  }
+  m_buffer.erase(m_buffer.begin(),
+                 m_buffer.begin() + static_cast<std::ptrdiff_t>(m_offset));
+  m_offset = 0;
+}
+
+}  // namespace primitives
+}  // namespace cgi
+}  // namespace infrastructure
@@ -0,0 +1,50 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   FastCgiRecordDecoder.hpp                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 14:20:44 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 14:20:44 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef FAST_CGI_RECORD_DECODER_HPP
+#define FAST_CGI_RECORD_DECODER_HPP
+
+#include "infrastructure/cgi/primitives/FastCgiRecord.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace infrastructure {
+namespace cgi {
+namespace primitives {
+
+class FastCgiRecordDecoder {
+ public:
+  FastCgiRecordDecoder();
+  ~FastCgiRecordDecoder();
+
+  void feed(const char* data, std::size_t length);
+  bool next(FastCgiRecord& record);
+
+  std::size_t bufferedBytes() const;
+  void reset();
+
+ private:
+  FastCgiRecordDecoder(const FastCgiRecordDecoder&);
+  FastCgiRecordDecoder& operator=(const FastCgiRecordDecoder&);
+
+  std::vector<char> m_buffer;
+  std::size_t m_offset;
+
+  void compact();
+};
+
+}  // namespace primitives
+}  // namespace cgi
+}  // namespace infrastructure
+
+#endif  // FAST_CGI_RECORD_DECODER_HPP
@@ -26,33 +26,50 @@ namespace config {
 namespace adapters {
 
 ConfigProvider::ConfigProvider(application::ports::ILogger& logger)
-    : m_logger(logger), m_valid(false) {
+    : m_logger(logger),
+      m_compiler(logger),
+      m_snapshot(NULL),
+      m_generation(0),
+      m_valid(false) {
   this->m_parser.reset(new parsers::ConfigParser(m_logger));
   this->m_logger.info("ConfigProvider initialized with parser.");
 }
 
-ConfigProvider::~ConfigProvider() {}
+ConfigProvider::~ConfigProvider() { publish(NULL); }
 
 void ConfigProvider::load(const std::string& configPath) {
   this->m_configPath = configPath;
-  this->m_valid = false;
-  this->m_serverPtrs.clear();
+  publish(parse(configPath));
+}
 
+// Parses and validates into a fresh generation; the current one is replaced
+// only once the new configuration is known to be good. An up-to-date image
+// from --compile-config was validated when it was written and is used as is.
+domain::configuration::entities::ConfigSnapshot* ConfigProvider::parse(
+    const std::string& configPath) {
+  domain::configuration::entities::HttpConfig* httpConfig = NULL;
   try {
-    domain::configuration::entities::HttpConfig* httpConfig =
-        this->m_parser->parseFile(configPath);
+    httpConfig = this->m_compiler.load(
+        parsers::ConfigCompiler::compiledPathFor(configPath));
+    if (httpConfig == NULL) {
+      httpConfig = this->m_parser->parseFile(configPath);
+      this->m_parser->validateConfiguration(*httpConfig);
+    }
 
-    this->m_httpConfig.reset(httpConfig);
-    this->m_parser->validateConfiguration(*this->m_httpConfig);
-    updateServerPointers();
-    this->m_valid = true;
+    domain::configuration::entities::ConfigSnapshot* snapshot =
+        domain::configuration::entities::ConfigSnapshot::create(
+            httpConfig, this->m_generation + 1);
+    httpConfig = NULL;
 
     std::ostringstream oss;
     oss << "Configuration loaded successfully from " << configPath << " with "
-        << this->m_serverPtrs.size() << " servers";
+        << snapshot->getServers().size() << " servers (generation "
+        << snapshot->getGeneration() << ")";
     this->m_logger.info(oss.str());
+    return snapshot;
 
   } catch (const std::exception& exception) {
+    delete httpConfig;
     throw exceptions::ConfigException(
         std::string(exception.what()),
         exceptions::ConfigException::LOAD_UNEXPECTED);
@@ -61,19 +78,24 @@ void ConfigProvider::load(const std::string& configPath) {
 
 const domain::configuration::entities::HttpConfig&
 ConfigProvider::getConfiguration() const {
-  if (this->m_httpConfig.get() == 0) {
+  return getSnapshot().getConfiguration();
+}
+
+domain::configuration::entities::ConfigSnapshot& ConfigProvider::getSnapshot()
+    const {
+  if (this->m_snapshot == NULL) {
     throw exceptions::ConfigException(
         "Configuration not loaded", exceptions::ConfigException::INVALID_STATE);
   }
-  return *this->m_httpConfig;
+  return *this->m_snapshot;
 }
 
 const domain::configuration::entities::ServerConfig* ConfigProvider::findServer(
     const std::string& host, unsigned int port) const {
-  if (this->m_httpConfig.get() == 0) {
+  if (this->m_snapshot == NULL) {
     return NULL;
   }
-  return this->m_httpConfig->selectServer(host, port);
+  return this->m_snapshot->getConfiguration().selectServer(host, port);
 }
 
 const domain::configuration::entities::LocationConfig*
@@ -85,32 +107,43 @@ ConfigProvider::findLocation(
 
 const std::vector<const domain::configuration::entities::ServerConfig*>&
 ConfigProvider::getAllServers() const {
-  return this->m_serverPtrs;
+  static const domain::configuration::entities::ConfigSnapshot::Servers
+      K_NO_SERVERS;
+  return this->m_snapshot != NULL ? this->m_snapshot->getServers()
+                                  : K_NO_SERVERS;
 }
 
-void ConfigProvider::reload() {
+void ConfigProvider::reload() { publish(prepareReload()); }
+
+// The generation comes back unpublished with one reference owned by the
+// caller, who either hands it to publish() or releases it. Until then the
+// current generation stays the one every lookup sees.
+domain::configuration::entities::ConfigSnapshot*
+ConfigProvider::prepareReload() {
   if (this->m_configPath.empty()) {
     throw exceptions::ConfigException(
         "Cannot reload: no configuration path stored",
         exceptions::ConfigException::INVALID_STATE);
   }
-  load(this->m_configPath);
+  return parse(this->m_configPath);
 }
 
 bool ConfigProvider::isValid() const {
-  return this->m_valid && this->m_httpConfig.get() != NULL;
+  return this->m_valid && this->m_snapshot != NULL;
 }
 
-void ConfigProvider::updateServerPointers() {
-  this->m_serverPtrs.clear();
-  if (this->m_httpConfig.get() != 0) {
-    const domain::configuration::entities::HttpConfig::ServerConfigs& servers =
-        this->m_httpConfig->getServerConfigs();
-    for (domain::configuration::entities::HttpConfig::ServerConfigs::
-             const_iterator it = servers.begin();
-         it != servers.end(); ++it) {
-      this->m_serverPtrs.push_back(*it);
-    }
+// The provider keeps one reference on the published generation; holders that
+// acquired their own keep an older one alive after it is replaced.
+void ConfigProvider::publish(
+    domain::configuration::entities::ConfigSnapshot* snapshot) {
+  domain::configuration::entities::ConfigSnapshot* previous = this->m_snapshot;
+  this->m_snapshot = snapshot;
+  if (snapshot != NULL) {
+    this->m_generation = snapshot->getGeneration();
+    this->m_valid = true;
+  }
+  if (previous != NULL) {
+    previous->release();
   }
 }
 
@@ -16,7 +16,9 @@
 #include "application/ports/IConfigParser.hpp"
 #include "application/ports/IConfigProvider.hpp"
 #include "application/ports/ILogger.hpp"
+#include "domain/configuration/entities/ConfigSnapshot.hpp"
 #include "domain/configuration/entities/ServerConfig.hpp"
+#include "infrastructure/config/parsers/ConfigCompiler.hpp"
 
 #include <memory>
 #include <string>
@@ -36,6 +38,8 @@ class ConfigProvider : public application::ports::IConfigProvider {
   virtual const domain::configuration::entities::HttpConfig& getConfiguration()
       const;
 
+  virtual domain::configuration::entities::ConfigSnapshot& getSnapshot() const;
+
   virtual const domain::configuration::entities::ServerConfig* findServer(
       const std::string& host, unsigned int port) const;
 
@@ -48,6 +52,9 @@ class ConfigProvider : public application::ports::IConfigProvider {
   getAllServers() const;
 
   virtual void reload();
+  virtual domain::configuration::entities::ConfigSnapshot* prepareReload();
+  virtual void publish(
+      domain::configuration::entities::ConfigSnapshot* snapshot);
   virtual bool isValid() const;
 
  private:
@@ -56,15 +63,15 @@ class ConfigProvider : public application::ports::IConfigProvider {
 
   application::ports::ILogger& m_logger;
   std::auto_ptr<application::ports::IConfigParser> m_parser;
-  std::auto_ptr<domain::configuration::entities::HttpConfig> m_httpConfig;
-
-  std::vector<const domain::configuration::entities::ServerConfig*>
-      m_serverPtrs;
+  parsers::ConfigCompiler m_compiler;
+  domain::configuration::entities::ConfigSnapshot* m_snapshot;
+  unsigned long m_generation;
   bool m_valid;
 
   std::string m_configPath;
 
-  void updateServerPointers();
+  domain::configuration::entities::ConfigSnapshot* parse(
+      const std::string& configPath);
 };
 
 }  // namespace adapters
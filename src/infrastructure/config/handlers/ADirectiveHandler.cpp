@@ -64,7 +64,7 @@ unsigned int ADirectiveHandler::parseUnsignedInt(const std::string& str,
     unsigned long result = domain::shared::utils::StringUtils::toUnsignedLong(
         str, domain::shared::utils::StringUtils::BASE_DECIMAL);
 
-    if (result > ULONG_MAX) {
+    if (result > UINT_MAX) {
       std::ostringstream oss;
       oss << "Number '" << str << "' too large for " << context << " at line "
           << lineNumber;
@@ -89,6 +89,80 @@ unsigned int ADirectiveHandler::parseUnsignedInt(const std::string& str,
   }
 }
 
+unsigned int ADirectiveHandler::parseTimeSeconds(const std::string& str,
+                                                 const std::string& context,
+                                                 std::size_t lineNumber) {
+  if (str.empty()) {
+    std::ostringstream oss;
+    oss << "Empty time value for " << context << " at line " << lineNumber;
+    throw exceptions::SyntaxException(
+        oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+  }
+
+  unsigned int multiplier = 1;
+  std::string digits = str;
+  const char unit = str[str.length() - 1];
+
+  if (unit == 's') {
+    digits.erase(digits.length() - 1);
+  } else if (unit == 'm') {
+    multiplier = K_SECONDS_PER_MINUTE;
+    digits.erase(digits.length() - 1);
+  } else if (unit == 'h') {
+    multiplier = K_SECONDS_PER_HOUR;
+    digits.erase(digits.length() - 1);
+  }
+
+  unsigned int value = parseUnsignedInt(digits, context, lineNumber);
+
+  if (value > UINT_MAX / multiplier) {
+    std::ostringstream oss;
+    oss << "Time value '" << str << "' too large for " << context
+        << " at line " << lineNumber;
+    throw exceptions::SyntaxException(
+        oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+  }
+
+  return value * multiplier;
+}
+
+// Accepts an "ms" suffix on top of the units parseTimeSeconds() knows.
+unsigned int ADirectiveHandler::parseTimeMillis(const std::string& str,
+                                                const std::string& context,
+                                                std::size_t lineNumber) {
+  const std::string::size_type length = str.length();
+  if (length > 2 && str.compare(length - 2, 2, "ms") == 0) {
+    return parseUnsignedInt(str.substr(0, length - 2), context, lineNumber);
+  }
+
+  const unsigned int seconds = parseTimeSeconds(str, context, lineNumber);
+  if (seconds > UINT_MAX / K_MILLIS_PER_SECOND) {
+    std::ostringstream oss;
+    oss << "Time value '" << str << "' too large for " << context
+        << " at line " << lineNumber;
+    throw exceptions::SyntaxException(
+        oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+  }
+  return seconds * K_MILLIS_PER_SECOND;
+}
+
+bool ADirectiveHandler::parseOnOff(const std::string& str,
+                                   const std::string& context,
+                                   std::size_t lineNumber) {
+  if (str == "on") {
+    return true;
+  }
+  if (str == "off") {
+    return false;
+  }
+
+  std::ostringstream oss;
+  oss << context << " requires 'on' or 'off', got '" << str << "' at line "
+      << lineNumber;
+  throw exceptions::SyntaxException(
+      oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+}
+
 unsigned int ADirectiveHandler::parseOctalPermissions(
     const std::string& str, const std::string& context,
     std::size_t lineNumber) {
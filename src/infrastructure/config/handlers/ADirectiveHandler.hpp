@@ -32,6 +32,14 @@ class ADirectiveHandler {
                       std::size_t lineNumber) = 0;
 
  protected:
+  static const unsigned int K_SECONDS_PER_MINUTE = 60;
+  static const unsigned int K_SECONDS_PER_HOUR = 3600;
+  static const unsigned int K_MILLIS_PER_SECOND = 1000;
+
+  typedef unsigned int (*ValueParser)(const std::string& str,
+                                      const std::string& context,
+                                      std::size_t lineNumber);
+
   application::ports::ILogger& m_logger;
 
   static void validateArgumentCount(const std::string& directive,
@@ -45,6 +53,14 @@ class ADirectiveHandler {
   static unsigned int parseUnsignedInt(const std::string& str,
                                        const std::string& context,
                                        std::size_t lineNumber);
+  static unsigned int parseTimeSeconds(const std::string& str,
+                                       const std::string& context,
+                                       std::size_t lineNumber);
+  static unsigned int parseTimeMillis(const std::string& str,
+                                      const std::string& context,
+                                      std::size_t lineNumber);
+  static bool parseOnOff(const std::string& str, const std::string& context,
+                         std::size_t lineNumber);
   static unsigned int parseOctalPermissions(const std::string& str,
                                             const std::string& context,
                                             std::size_t lineNumber);
@@ -10,6 +10,10 @@
 /*                                                                            */
 /* ************************************************************************** */
 
+#include "domain/configuration/value_objects/CacheZoneConfig.hpp"
+#include "domain/configuration/value_objects/LimitZoneConfig.hpp"
+#include "domain/configuration/value_objects/MimeTypes.hpp"
+#include "domain/filesystem/value_objects/Size.hpp"
 #include "domain/shared/value_objects/ErrorCode.hpp"
 #include "infrastructure/config/exceptions/ConfigException.hpp"
 #include "infrastructure/config/exceptions/SyntaxException.hpp"
@@ -22,6 +26,12 @@ namespace infrastructure {
 namespace config {
 namespace handlers {
 
+namespace {
+
+typedef domain::configuration::entities::HttpConfig HttpConfig;
+
+}  // namespace
+
 GlobalDirectiveHandler::GlobalDirectiveHandler(
     application::ports::ILogger& logger,
     domain::configuration::entities::HttpConfig& httpConfig)
@@ -40,10 +50,40 @@ void GlobalDirectiveHandler::handle(const std::string& directive,
     handleErrorLog(args, lineNumber);
   } else if (directive == "access_log") {
     handleAccessLog(args, lineNumber);
+  } else if (directive == "log_format") {
+    handleLogFormat(args, lineNumber);
+  } else if (directive == "slow_request_threshold") {
+    handleSlowRequestThreshold(args, lineNumber);
   } else if (directive == "error_page") {
     handleErrorPage(args, lineNumber);
+  } else if (directive == "default_type") {
+    handleDefaultType(args, lineNumber);
   } else if (directive == "include") {
     handleInclude(args, lineNumber);
+  } else if (directive == "keepalive_timeout") {
+    handleConnectionSetting(directive, args, lineNumber, parseTimeSeconds,
+                            &HttpConfig::setKeepaliveTimeout);
+  } else if (directive == "keepalive_requests") {
+    handleConnectionSetting(directive, args, lineNumber, parseUnsignedInt,
+                            &HttpConfig::setKeepaliveRequests);
+  } else if (directive == "client_header_timeout") {
+    handleConnectionSetting(directive, args, lineNumber, parseTimeSeconds,
+                            &HttpConfig::setClientHeaderTimeout);
+  } else if (directive == "client_body_timeout") {
+    handleConnectionSetting(directive, args, lineNumber, parseTimeSeconds,
+                            &HttpConfig::setClientBodyTimeout);
+  } else if (directive == "send_timeout") {
+    handleConnectionSetting(directive, args, lineNumber, parseTimeSeconds,
+                            &HttpConfig::setSendTimeout);
+  } else if (directive == "tcp_nodelay") {
+    handleTcpNoDelay(args, lineNumber);
+  } else if (directive == "tcp_nopush") {
+    handleTcpNoPush(args, lineNumber);
+  } else if (directive == "proxy_cache_path") {
+    handleProxyCachePath(args, lineNumber);
+  } else if (directive == "limit_req_zone" ||
+             directive == "limit_conn_zone") {
+    handleLimitZone(directive, args, lineNumber);
   } else {
     std::ostringstream oss;
     oss << "Unknown global directive: '" << directive << "' at line "
@@ -116,9 +156,19 @@ void GlobalDirectiveHandler::handleClientMaxBodySize(
 
 void GlobalDirectiveHandler::handleErrorLog(
     const std::vector<std::string>& args, std::size_t lineNumber) {
-  validateArgumentCount("error_log", args, 1, lineNumber);
+  validateMinimumArguments("error_log", args, 1, lineNumber);
+  if (args.size() > 2) {
+    std::ostringstream oss;
+    oss << "Directive 'error_log' takes a path and an optional level at line "
+        << lineNumber;
+    throw exceptions::SyntaxException(
+        oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+  }
 
   m_httpConfig.setErrorLogPath(args[0]);
+  if (args.size() == 2) {
+    m_httpConfig.setErrorLogLevel(args[1]);
+  }
 
   std::ostringstream oss;
   oss << "Set error_log to '" << args[0] << "' at line " << lineNumber;
@@ -127,15 +177,62 @@ void GlobalDirectiveHandler::handleErrorLog(
 
 void GlobalDirectiveHandler::handleAccessLog(
     const std::vector<std::string>& args, std::size_t lineNumber) {
-  validateArgumentCount("access_log", args, 1, lineNumber);
+  validateMinimumArguments("access_log", args, 1, lineNumber);
+  if (args.size() > 2) {
+    std::ostringstream oss;
+    oss << "Directive 'access_log' takes a path and an optional format name"
+        << " at line " << lineNumber;
+    throw exceptions::SyntaxException(
+        oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+  }
 
-  m_httpConfig.setAccessLogPath(args[0]);
+  if (args[0] == "off") {
+    m_httpConfig.setAccessLogEnabled(false);
+  } else {
+    m_httpConfig.setAccessLogPath(args[0]);
+    m_httpConfig.setAccessLogEnabled(true);
+    if (args.size() == 2) {
+      m_httpConfig.setAccessLogFormat(args[1]);
+    }
+  }
 
   std::ostringstream oss;
   oss << "Set access_log to '" << args[0] << "' at line " << lineNumber;
   m_logger.debug(oss.str());
 }
 
+// The pattern may be split across several arguments, as nginx allows; they
+// are joined without a separator so quoted pieces concatenate.
+void GlobalDirectiveHandler::handleLogFormat(
+    const std::vector<std::string>& args, std::size_t lineNumber) {
+  validateMinimumArguments("log_format", args, 2, lineNumber);
+
+  std::string pattern;
+  for (std::size_t i = 1; i < args.size(); ++i) {
+    pattern += args[i];
+  }
+  m_httpConfig.addLogFormat(args[0], pattern);
+
+  std::ostringstream oss;
+  oss << "Defined log_format '" << args[0] << "' at line " << lineNumber;
+  m_logger.debug(oss.str());
+}
+
+void GlobalDirectiveHandler::handleSlowRequestThreshold(
+    const std::vector<std::string>& args, std::size_t lineNumber) {
+  validateArgumentCount("slow_request_threshold", args, 1, lineNumber);
+
+  m_httpConfig.setSlowRequestThreshold(
+      args[0] == "off"
+          ? 0
+          : parseTimeMillis(args[0], "slow_request_threshold", lineNumber));
+
+  std::ostringstream oss;
+  oss << "Set slow_request_threshold to '" << args[0] << "' at line "
+      << lineNumber;
+  m_logger.debug(oss.str());
+}
+
 void GlobalDirectiveHandler::handleErrorPage(
     const std::vector<std::string>& args, std::size_t lineNumber) {
   validateMinimumArguments("error_page", args, 2, lineNumber);
@@ -185,6 +282,24 @@ void GlobalDirectiveHandler::handleErrorPage(
   }
 }
 
+void GlobalDirectiveHandler::handleDefaultType(
+    const std::vector<std::string>& args, std::size_t lineNumber) {
+  validateArgumentCount("default_type", args, 1, lineNumber);
+
+  if (!domain::configuration::value_objects::MimeTypes::isValidType(args[0])) {
+    std::ostringstream oss;
+    oss << "Invalid default_type '" << args[0] << "' at line " << lineNumber;
+    throw exceptions::SyntaxException(
+        oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+  }
+
+  m_httpConfig.setDefaultType(args[0]);
+
+  std::ostringstream oss;
+  oss << "Set default_type to '" << args[0] << "' at line " << lineNumber;
+  m_logger.debug(oss.str());
+}
+
 void GlobalDirectiveHandler::handleInclude(const std::vector<std::string>& args,
                                            std::size_t lineNumber) {
   validateArgumentCount("include", args, 1, lineNumber);
@@ -211,6 +326,202 @@ void GlobalDirectiveHandler::handleInclude(const std::vector<std::string>& args,
   }
 }
 
+// keepalive_requests and the connection timeouts differ only in how the
+// value is parsed and which setter stores it.
+void GlobalDirectiveHandler::handleConnectionSetting(
+    const std::string& directive, const std::vector<std::string>& args,
+    std::size_t lineNumber, ValueParser parser, ConnectionSetter setter) {
+  validateArgumentCount(directive, args, 1, lineNumber);
+
+  const unsigned int value = parser(args[0], directive, lineNumber);
+
+  try {
+    (m_httpConfig.*setter)(value);
+  } catch (const std::exception& e) {
+    std::ostringstream oss;
+    oss << "Invalid " << directive << " '" << args[0] << "': " << e.what()
+        << " at line " << lineNumber;
+    throw exceptions::SyntaxException(
+        oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+  }
+
+  std::ostringstream oss;
+  oss << "Set " << directive << " to " << value << " at line " << lineNumber;
+  m_logger.debug(oss.str());
+}
+
+void GlobalDirectiveHandler::handleTcpNoDelay(
+    const std::vector<std::string>& args, std::size_t lineNumber) {
+  validateArgumentCount("tcp_nodelay", args, 1, lineNumber);
+
+  m_httpConfig.setTcpNoDelay(parseOnOff(args[0], "tcp_nodelay", lineNumber));
+
+  std::ostringstream oss;
+  oss << "Set tcp_nodelay to '" << args[0] << "' at line " << lineNumber;
+  m_logger.debug(oss.str());
+}
+
+void GlobalDirectiveHandler::handleTcpNoPush(
+    const std::vector<std::string>& args, std::size_t lineNumber) {
+  validateArgumentCount("tcp_nopush", args, 1, lineNumber);
+
+  m_httpConfig.setTcpNoPush(parseOnOff(args[0], "tcp_nopush", lineNumber));
+
+  std::ostringstream oss;
+  oss << "Set tcp_nopush to '" << args[0] << "' at line " << lineNumber;
+  m_logger.debug(oss.str());
+}
+
+// proxy_cache_path <path> keys_zone=<name>[:size] [levels=1:2]
+// [max_size=<size>] [inactive=<time>]; the size after the zone name sizes
+// nginx's shared memory index and is accepted and ignored here.
+void GlobalDirectiveHandler::handleProxyCachePath(
+    const std::vector<std::string>& args, std::size_t lineNumber) {
+  validateMinimumArguments("proxy_cache_path", args, 2, lineNumber);
+
+  std::string zoneName;
+  std::string levels;
+  std::string maxSize;
+  std::string inactive;
+  for (std::size_t i = 1; i < args.size(); ++i) {
+    const std::string::size_type equals = args[i].find('=');
+    const std::string name = args[i].substr(0, equals);
+    const std::string value =
+        equals == std::string::npos ? "" : args[i].substr(equals + 1);
+    if (equals == std::string::npos || value.empty()) {
+      std::ostringstream oss;
+      oss << "Invalid proxy_cache_path parameter '" << args[i] << "' at line "
+          << lineNumber;
+      throw exceptions::SyntaxException(
+          oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+    }
+    if (name == "keys_zone") {
+      zoneName = value.substr(0, value.find(':'));
+    } else if (name == "levels") {
+      levels = value;
+    } else if (name == "max_size") {
+      maxSize = value;
+    } else if (name == "inactive") {
+      inactive = value;
+    } else {
+      std::ostringstream oss;
+      oss << "Unknown proxy_cache_path parameter '" << name << "' at line "
+          << lineNumber;
+      throw exceptions::SyntaxException(
+          oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+    }
+  }
+  if (zoneName.empty()) {
+    std::ostringstream oss;
+    oss << "Directive 'proxy_cache_path' requires keys_zone= at line "
+        << lineNumber;
+    throw exceptions::SyntaxException(
+        oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+  }
+
+  try {
+    domain::configuration::value_objects::CacheZoneConfig zone(zoneName,
+                                                               args[0]);
+    if (!levels.empty()) {
+      zone.setLevels(levels);
+    }
+    if (!maxSize.empty()) {
+      zone.setMaxSize(
+          domain::filesystem::value_objects::Size::fromString(maxSize)
+              .getBytes());
+    }
+    if (!inactive.empty()) {
+      zone.setInactive(parseTimeSeconds(inactive, "inactive", lineNumber));
+    }
+    m_httpConfig.addCacheZone(zone);
+
+  } catch (const exceptions::SyntaxException&) {
+    throw;
+  } catch (const std::exception& e) {
+    std::ostringstream oss;
+    oss << "Invalid proxy_cache_path '" << args[0] << "': " << e.what()
+        << " at line " << lineNumber;
+    throw exceptions::SyntaxException(
+        oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+  }
+
+  std::ostringstream oss;
+  oss << "Defined cache zone '" << zoneName << "' at '" << args[0]
+      << "' at line " << lineNumber;
+  m_logger.debug(oss.str());
+}
+
+// limit_req_zone <key> zone=<name>:<size> rate=<n>r/s|<n>r/m
+// limit_conn_zone <key> zone=<name>:<size>
+void GlobalDirectiveHandler::handleLimitZone(
+    const std::string& directive, const std::vector<std::string>& args,
+    std::size_t lineNumber) {
+  const bool requestZone = directive == "limit_req_zone";
+  validateArgumentCount(directive, args, requestZone ? 3 : 2, lineNumber);
+
+  std::string zone;
+  std::string rate;
+  for (std::size_t i = 1; i < args.size(); ++i) {
+    const std::string::size_type equals = args[i].find('=');
+    const std::string name = args[i].substr(0, equals);
+    const std::string value =
+        equals == std::string::npos ? "" : args[i].substr(equals + 1);
+    if (name == "zone" && !value.empty()) {
+      zone = value;
+    } else if (requestZone && name == "rate" && !value.empty()) {
+      rate = value;
+    } else {
+      std::ostringstream oss;
+      oss << "Invalid " << directive << " parameter '" << args[i]
+          << "' at line " << lineNumber;
+      throw exceptions::SyntaxException(
+          oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+    }
+  }
+  const std::string::size_type colon = zone.find(':');
+  if (colon == std::string::npos || colon + 1 == zone.size() ||
+      (requestZone && rate.empty())) {
+    std::ostringstream oss;
+    oss << "Directive '" << directive << "' requires zone=<name>:<size>"
+        << (requestZone ? " and rate=" : "") << " at line " << lineNumber;
+    throw exceptions::SyntaxException(
+        oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+  }
+
+  const std::string zoneName = zone.substr(0, colon);
+  try {
+    domain::configuration::value_objects::LimitZoneConfig config(
+        zoneName,
+        requestZone
+            ? domain::configuration::value_objects::LimitZoneConfig::
+                  TYPE_REQUEST
+            : domain::configuration::value_objects::LimitZoneConfig::
+                  TYPE_CONNECTION,
+        args[0],
+        domain::filesystem::value_objects::Size::fromString(
+            zone.substr(colon + 1))
+            .getBytes());
+    if (requestZone) {
+      config.setRate(rate);
+    }
+    m_httpConfig.addLimitZone(config);
+
+  } catch (const exceptions::SyntaxException&) {
+    throw;
+  } catch (const std::exception& e) {
+    std::ostringstream oss;
+    oss << "Invalid " << directive << " '" << zoneName << "': " << e.what()
+        << " at line " << lineNumber;
+    throw exceptions::SyntaxException(
+        oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+  }
+
+  std::ostringstream oss;
+  oss << "Defined " << directive << " '" << zoneName << "' keyed by '"
+      << args[0] << "' at line " << lineNumber;
+  m_logger.debug(oss.str());
+}
+
 }  // namespace handlers
 }  // namespace config
 }  // namespace infrastructure
@@ -31,6 +31,9 @@ class GlobalDirectiveHandler : public ADirectiveHandler {
                       std::size_t lineNumber);
 
  private:
+  typedef void (domain::configuration::entities::HttpConfig::*
+                    ConnectionSetter)(unsigned int);
+
   domain::configuration::entities::HttpConfig& m_httpConfig;
 
   void handleWorkerProcesses(const std::vector<std::string>& args,
@@ -43,10 +46,29 @@ class GlobalDirectiveHandler : public ADirectiveHandler {
                       std::size_t lineNumber);
   void handleAccessLog(const std::vector<std::string>& args,
                        std::size_t lineNumber);
+  void handleLogFormat(const std::vector<std::string>& args,
+                       std::size_t lineNumber);
+  void handleSlowRequestThreshold(const std::vector<std::string>& args,
+                                  std::size_t lineNumber);
   void handleErrorPage(const std::vector<std::string>& args,
                        std::size_t lineNumber);
+  void handleDefaultType(const std::vector<std::string>& args,
+                         std::size_t lineNumber);
   void handleInclude(const std::vector<std::string>& args,
                      std::size_t lineNumber);
+  void handleConnectionSetting(const std::string& directive,
+                               const std::vector<std::string>& args,
+                               std::size_t lineNumber, ValueParser parser,
+                               ConnectionSetter setter);
+  void handleTcpNoDelay(const std::vector<std::string>& args,
+                        std::size_t lineNumber);
+  void handleTcpNoPush(const std::vector<std::string>& args,
+                       std::size_t lineNumber);
+  void handleProxyCachePath(const std::vector<std::string>& args,
+                            std::size_t lineNumber);
+  void handleLimitZone(const std::string& directive,
+                       const std::vector<std::string>& args,
+                       std::size_t lineNumber);
 };
 
 }  // namespace handlers
@@ -10,6 +10,8 @@
 /*                                                                            */
 /* ************************************************************************** */
 
+#include "domain/configuration/value_objects/ProxyCacheConfig.hpp"
+#include "domain/configuration/value_objects/RequestLimitConfig.hpp"
 #include "domain/filesystem/value_objects/UploadAccess.hpp"
 #include "domain/http/value_objects/HttpMethod.hpp"
 #include "domain/shared/value_objects/ErrorCode.hpp"
@@ -57,6 +59,26 @@ void LocationDirectiveHandler::handle(const std::string& directive,
     handleCgiRoot(args, lineNumber);
   } else if (directive == "fastcgi_param") {
     handleFastcgiParam(args, lineNumber);
+  } else if (directive == "fastcgi_pass") {
+    handleFastcgiPass(args, lineNumber);
+  } else if (directive == "cgi_workers") {
+    handleCgiWorkers(args, lineNumber);
+  } else if (directive == "cgi_worker_bootstrap") {
+    handleCgiWorkerBootstrap(args, lineNumber);
+  } else if (directive == "proxy_pass") {
+    handleProxyPass(args, lineNumber);
+  } else if (directive == "proxy_connect_timeout" ||
+             directive == "proxy_read_timeout") {
+    handleProxyTimeout(directive, args, lineNumber);
+  } else if (directive == "proxy_cache" || directive == "proxy_cache_key" ||
+             directive == "proxy_cache_valid" ||
+             directive == "proxy_cache_lock" ||
+             directive == "proxy_cache_lock_timeout") {
+    handleProxyCache(directive, args, lineNumber);
+  } else if (directive == "limit_req" || directive == "limit_conn" ||
+             directive == "limit_req_status" ||
+             directive == "limit_conn_status") {
+    handleRequestLimit(directive, args, lineNumber);
   } else if (directive == "upload_max_file_size" ||
              directive == "upload_max_total_size") {
     handleUploadSizeLimits(directive, args, lineNumber);
@@ -66,6 +88,8 @@ void LocationDirectiveHandler::handle(const std::string& directive,
     handleClientMaxBodySize(args, lineNumber);
   } else if (directive == "error_page") {
     handleErrorPage(args, lineNumber);
+  } else if (directive == "stub_status") {
+    handleStubStatus(args, lineNumber);
   } else if (directive == "include") {
     std::ostringstream oss;
     oss << "Include directive in location context (not yet implemented): "
@@ -210,6 +234,30 @@ void LocationDirectiveHandler::handleAutoIndex(
   m_logger.debug(oss.str());
 }
 
+void LocationDirectiveHandler::handleStubStatus(
+    const std::vector<std::string>& args, std::size_t lineNumber) {
+  if (args.size() > 1) {
+    validateArgumentCount("stub_status", args, 1, lineNumber);
+  }
+
+  const std::string value = args.empty() ? "text" : args[0];
+  if (value == "text" || value == "on") {
+    m_location.setStatusFormat(
+        domain::configuration::entities::LocationConfig::STATUS_TEXT);
+  } else if (value == "prometheus") {
+    m_location.setStatusFormat(
+        domain::configuration::entities::LocationConfig::STATUS_PROMETHEUS);
+  } else {
+    throw exceptions::SyntaxException(
+        "stub_status requires 'text' or 'prometheus', got '" + value + "'",
+        exceptions::SyntaxException::INVALID_DIRECTIVE);
+  }
+
+  std::ostringstream oss;
+  oss << "Set stub_status to '" << value << "' at line " << lineNumber;
+  m_logger.debug(oss.str());
+}
+
 void LocationDirectiveHandler::handleTryFiles(
     const std::vector<std::string>& args, std::size_t lineNumber) {
   validateMinimumArguments("try_files", args, 1, lineNumber);
@@ -477,6 +525,269 @@ void LocationDirectiveHandler::handleFastcgiParam(
   }
 }
 
+void LocationDirectiveHandler::handleFastcgiPass(
+    const std::vector<std::string>& args, std::size_t lineNumber) {
+  validateArgumentCount("fastcgi_pass", args, 1, lineNumber);
+
+  try {
+    domain::configuration::value_objects::CgiConfig cgiConfig;
+    try {
+      cgiConfig = m_location.getCgiConfig();
+    } catch (...) {
+      domain::filesystem::value_objects::Path emptyRoot;
+      domain::shared::value_objects::RegexPattern defaultPattern(
+          "\\.(php|py|pl|cgi)$");
+      cgiConfig = domain::configuration::value_objects::CgiConfig(
+          "", emptyRoot, defaultPattern);
+    }
+
+    cgiConfig.setFastcgiPass(args[0]);
+    m_location.setCgiConfig(cgiConfig);
+
+    std::ostringstream oss;
+    oss << "Set fastcgi_pass to '" << args[0] << "' at line " << lineNumber;
+    m_logger.debug(oss.str());
+
+  } catch (const std::exception& e) {
+    std::ostringstream oss;
+    oss << "Invalid fastcgi_pass '" << args[0] << "': " << e.what()
+        << " at line " << lineNumber;
+    throw exceptions::SyntaxException(
+        oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+  }
+}
+
+// The host of a proxy_pass URL names an upstream block when one exists by
+// that name; otherwise it is a literal host[:port].
+void LocationDirectiveHandler::handleProxyPass(
+    const std::vector<std::string>& args, std::size_t lineNumber) {
+  validateArgumentCount("proxy_pass", args, 1, lineNumber);
+
+  try {
+    m_location.setProxyPass(args[0]);
+
+    std::ostringstream oss;
+    oss << "Set proxy_pass to '" << args[0] << "' at line " << lineNumber;
+    m_logger.debug(oss.str());
+
+  } catch (const std::exception& e) {
+    std::ostringstream oss;
+    oss << "Invalid proxy_pass '" << args[0] << "': " << e.what()
+        << " at line " << lineNumber;
+    throw exceptions::SyntaxException(
+        oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+  }
+}
+
+void LocationDirectiveHandler::handleProxyTimeout(
+    const std::string& directive, const std::vector<std::string>& args,
+    std::size_t lineNumber) {
+  validateArgumentCount(directive, args, 1, lineNumber);
+
+  const unsigned int seconds = parseTimeSeconds(args[0], directive, lineNumber);
+  try {
+    if (directive == "proxy_connect_timeout") {
+      m_location.setProxyConnectTimeout(seconds);
+    } else {
+      m_location.setProxyReadTimeout(seconds);
+    }
+  } catch (const std::exception& e) {
+    std::ostringstream oss;
+    oss << "Invalid " << directive << " '" << args[0] << "': " << e.what()
+        << " at line " << lineNumber;
+    throw exceptions::SyntaxException(
+        oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+  }
+}
+
+// The proxy_cache family applies to proxied and CGI responses alike:
+//   proxy_cache <zone>|off
+//   proxy_cache_key <template>
+//   proxy_cache_valid [code ...|any] <time>
+//   proxy_cache_lock on|off
+//   proxy_cache_lock_timeout <time>
+void LocationDirectiveHandler::handleProxyCache(
+    const std::string& directive, const std::vector<std::string>& args,
+    std::size_t lineNumber) {
+  validateMinimumArguments(directive, args, 1, lineNumber);
+  if (directive != "proxy_cache_valid") {
+    validateArgumentCount(directive, args, 1, lineNumber);
+  }
+
+  domain::configuration::value_objects::ProxyCacheConfig cache =
+      m_location.getProxyCache();
+  try {
+    if (directive == "proxy_cache") {
+      if (args[0] == "off") {
+        cache.disable();
+      } else {
+        cache.setZone(args[0]);
+      }
+    } else if (directive == "proxy_cache_key") {
+      cache.setKey(args[0]);
+    } else if (directive == "proxy_cache_valid") {
+      domain::configuration::value_objects::ProxyCacheConfig::StatusList
+          statuses;
+      for (std::size_t i = 0; i + 1 < args.size(); ++i) {
+        statuses.push_back(
+            args[i] == "any"
+                ? domain::configuration::value_objects::ProxyCacheConfig::
+                      ANY_STATUS
+                : parseUnsignedInt(args[i], directive, lineNumber));
+      }
+      cache.addValidity(statuses, parseTimeSeconds(args[args.size() - 1],
+                                                   directive, lineNumber));
+    } else if (directive == "proxy_cache_lock") {
+      cache.setLockEnabled(parseOnOff(args[0], directive, lineNumber));
+    } else {
+      cache.setLockTimeout(parseTimeSeconds(args[0], directive, lineNumber));
+    }
+  } catch (const exceptions::SyntaxException&) {
+    throw;
+  } catch (const std::exception& e) {
+    std::ostringstream oss;
+    oss << "Invalid " << directive << " '" << args[0] << "': " << e.what()
+        << " at line " << lineNumber;
+    throw exceptions::SyntaxException(
+        oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+  }
+  m_location.setProxyCache(cache);
+
+  std::ostringstream oss;
+  oss << "Set " << directive << " at line " << lineNumber;
+  m_logger.debug(oss.str());
+}
+
+// limit_req zone=<name> [burst=<n>] [nodelay]
+// limit_conn <zone> <n>
+// limit_req_status <code>, limit_conn_status <code>
+void LocationDirectiveHandler::handleRequestLimit(
+    const std::string& directive, const std::vector<std::string>& args,
+    std::size_t lineNumber) {
+  validateMinimumArguments(directive, args, 1, lineNumber);
+  if (directive == "limit_conn") {
+    validateArgumentCount(directive, args, 2, lineNumber);
+  } else if (directive != "limit_req") {
+    validateArgumentCount(directive, args, 1, lineNumber);
+  }
+
+  domain::configuration::value_objects::RequestLimitConfig limits =
+      m_location.getRequestLimits();
+  try {
+    if (directive == "limit_req") {
+      domain::configuration::value_objects::RequestLimitConfig::RequestRule
+          rule;
+      for (std::size_t i = 0; i < args.size(); ++i) {
+        const std::string::size_type equals = args[i].find('=');
+        const std::string name = args[i].substr(0, equals);
+        const std::string value =
+            equals == std::string::npos ? "" : args[i].substr(equals + 1);
+        if (name == "zone" && !value.empty()) {
+          rule.zone = value;
+        } else if (name == "burst" && !value.empty()) {
+          rule.burst = parseUnsignedInt(value, directive, lineNumber);
+        } else if (args[i] == "nodelay") {
+          rule.nodelay = true;
+        } else {
+          std::ostringstream oss;
+          oss << "Invalid limit_req parameter '" << args[i] << "' at line "
+              << lineNumber;
+          throw exceptions::SyntaxException(
+              oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+        }
+      }
+      if (rule.zone.empty()) {
+        std::ostringstream oss;
+        oss << "Directive 'limit_req' requires zone= at line " << lineNumber;
+        throw exceptions::SyntaxException(
+            oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+      }
+      limits.addRequestRule(rule);
+    } else if (directive == "limit_conn") {
+      limits.addConnectionRule(
+          domain::configuration::value_objects::RequestLimitConfig::
+              ConnectionRule(args[0], parseUnsignedInt(args[1], directive,
+                                                       lineNumber)));
+    } else if (directive == "limit_req_status") {
+      limits.setRequestStatus(parseUnsignedInt(args[0], directive, lineNumber));
+    } else {
+      limits.setConnectionStatus(
+          parseUnsignedInt(args[0], directive, lineNumber));
+    }
+  } catch (const exceptions::SyntaxException&) {
+    throw;
+  } catch (const std::exception& e) {
+    std::ostringstream oss;
+    oss << "Invalid " << directive << " '" << args[0] << "': " << e.what()
+        << " at line " << lineNumber;
+    throw exceptions::SyntaxException(
+        oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+  }
+  m_location.setRequestLimits(limits);
+
+  std::ostringstream oss;
+  oss << "Set " << directive << " at line " << lineNumber;
+  m_logger.debug(oss.str());
+}
+
+void LocationDirectiveHandler::handleCgiWorkers(
+    const std::vector<std::string>& args, std::size_t lineNumber) {
+  validateMinimumArguments("cgi_workers", args, 1, lineNumber);
+  if (args.size() > 2) {
+    validateArgumentCount("cgi_workers", args, 2, lineNumber);
+  }
+
+  const unsigned int count =
+      parseUnsignedInt(args[0], "cgi_workers", lineNumber);
+  std::size_t maxRequests = domain::configuration::value_objects::CgiConfig::
+      DEFAULT_WORKER_MAX_REQUESTS;
+  if (args.size() > 1) {
+    maxRequests = parseUnsignedInt(args[1], "cgi_workers", lineNumber);
+  }
+
+  try {
+    domain::configuration::value_objects::CgiConfig cgiConfig =
+        m_location.getCgiConfig();
+    cgiConfig.setWorkerPool(count, maxRequests);
+    m_location.setCgiConfig(cgiConfig);
+
+    std::ostringstream oss;
+    oss << "Set cgi_workers to " << count << " (recycle after " << maxRequests
+        << " requests) at line " << lineNumber;
+    m_logger.debug(oss.str());
+
+  } catch (const std::exception& e) {
+    std::ostringstream oss;
+    oss << "Invalid cgi_workers: " << e.what() << " at line " << lineNumber;
+    throw exceptions::SyntaxException(
+        oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+  }
+}
+
+void LocationDirectiveHandler::handleCgiWorkerBootstrap(
+    const std::vector<std::string>& args, std::size_t lineNumber) {
+  validateArgumentCount("cgi_worker_bootstrap", args, 1, lineNumber);
+
+  try {
+    domain::configuration::value_objects::CgiConfig cgiConfig =
+        m_location.getCgiConfig();
+    cgiConfig.setWorkerBootstrap(args[0]);
+    m_location.setCgiConfig(cgiConfig);
+
+    std::ostringstream oss;
+    oss << "Set cgi_worker_bootstrap to '" << args[0] << "' at line "
+        << lineNumber;
+    m_logger.debug(oss.str());
+
+  } catch (const std::exception& e) {
+    std::ostringstream oss;
+    oss << "Invalid cgi_worker_bootstrap '" << args[0] << "': " << e.what()
+        << " at line " << lineNumber;
+    throw exceptions::SyntaxException(
+        oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+  }
+}
+
 void LocationDirectiveHandler::handleUploadSizeLimits(
     const std::string& directive, const std::vector<std::string>& args,
     std::size_t lineNumber) {
@@ -42,6 +42,8 @@ class LocationDirectiveHandler : public ADirectiveHandler {
                          std::size_t lineNumber);
   void handleAutoIndex(const std::vector<std::string>& args,
                        std::size_t lineNumber);
+  void handleStubStatus(const std::vector<std::string>& args,
+                        std::size_t lineNumber);
   void handleTryFiles(const std::vector<std::string>& args,
                       std::size_t lineNumber);
   void handleReturn(const std::vector<std::string>& args,
@@ -58,6 +60,23 @@ class LocationDirectiveHandler : public ADirectiveHandler {
                      std::size_t lineNumber);
   void handleFastcgiParam(const std::vector<std::string>& args,
                           std::size_t lineNumber);
+  void handleFastcgiPass(const std::vector<std::string>& args,
+                         std::size_t lineNumber);
+  void handleCgiWorkers(const std::vector<std::string>& args,
+                        std::size_t lineNumber);
+  void handleCgiWorkerBootstrap(const std::vector<std::string>& args,
+                                std::size_t lineNumber);
+  void handleProxyPass(const std::vector<std::string>& args,
+                       std::size_t lineNumber);
+  void handleProxyTimeout(const std::string& directive,
+                          const std::vector<std::string>& args,
+                          std::size_t lineNumber);
+  void handleProxyCache(const std::string& directive,
+                        const std::vector<std::string>& args,
+                        std::size_t lineNumber);
+  void handleRequestLimit(const std::string& directive,
+                          const std::vector<std::string>& args,
+                          std::size_t lineNumber);
   void handleUploadSizeLimits(const std::string& directive,
                               const std::vector<std::string>& args,
                               std::size_t lineNumber);
@@ -11,6 +11,8 @@
 /* ************************************************************************** */
 
 #include "domain/configuration/exceptions/ServerConfigException.hpp"
+#include "domain/configuration/exceptions/SslConfigException.hpp"
+#include "domain/configuration/value_objects/SslConfig.hpp"
 #include "domain/shared/value_objects/ErrorCode.hpp"
 #include "infrastructure/config/exceptions/SyntaxException.hpp"
 #include "infrastructure/config/handlers/ServerDirectiveHandler.hpp"
@@ -21,6 +23,12 @@ namespace infrastructure {
 namespace config {
 namespace handlers {
 
+namespace {
+
+typedef domain::configuration::entities::ServerConfig ServerConfig;
+
+}  // namespace
+
 ServerDirectiveHandler::ServerDirectiveHandler(
     application::ports::ILogger& logger,
     domain::configuration::entities::ServerConfig& server)
@@ -43,6 +51,31 @@ void ServerDirectiveHandler::handle(const std::string& directive,
     handleClientMaxBodySize(args, lineNumber);
   } else if (directive == "return") {
     handleReturn(args, lineNumber);
+  } else if (directive == "keepalive_timeout") {
+    handleConnectionSetting(directive, args, lineNumber, parseTimeSeconds,
+                            &ServerConfig::setKeepaliveTimeout);
+  } else if (directive == "keepalive_requests") {
+    handleConnectionSetting(directive, args, lineNumber, parseUnsignedInt,
+                            &ServerConfig::setKeepaliveRequests);
+  } else if (directive == "client_header_timeout") {
+    handleConnectionSetting(directive, args, lineNumber, parseTimeSeconds,
+                            &ServerConfig::setClientHeaderTimeout);
+  } else if (directive == "client_body_timeout") {
+    handleConnectionSetting(directive, args, lineNumber, parseTimeSeconds,
+                            &ServerConfig::setClientBodyTimeout);
+  } else if (directive == "send_timeout") {
+    handleConnectionSetting(directive, args, lineNumber, parseTimeSeconds,
+                            &ServerConfig::setSendTimeout);
+  } else if (directive == "tcp_nodelay") {
+    handleTcpNoDelay(args, lineNumber);
+  } else if (directive == "tcp_nopush") {
+    handleTcpNoPush(args, lineNumber);
+  } else if (directive == "ssl_certificate" ||
+             directive == "ssl_certificate_key" ||
+             directive == "ssl_session_cache" ||
+             directive == "ssl_session_timeout" ||
+             directive == "ssl_session_tickets") {
+    handleSsl(directive, args, lineNumber);
   } else {
     std::ostringstream oss;
     oss << "Unknown server directive: '" << directive << "' at line "
@@ -55,16 +88,30 @@ void ServerDirectiveHandler::handleListen(const std::vector<std::string>& args,
                                           std::size_t lineNumber) {
   validateMinimumArguments("listen", args, 1, lineNumber);
 
-  std::ostringstream log;
-  log << args.size();
+  if (domain::configuration::entities::ListenDirective::isParameter(args[0])) {
+    std::ostringstream oss;
+    oss << "listen parameter '" << args[0]
+        << "' must follow an address at line " << lineNumber;
+    throw exceptions::SyntaxException(
+        oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+  }
+
+  std::size_t i = 0;
+  while (i < args.size()) {
+    const std::string& address = args[i++];
+    std::vector<std::string> parameters;
+    while (i < args.size() &&
+           domain::configuration::entities::ListenDirective::isParameter(
+               args[i])) {
+      parameters.push_back(args[i++]);
+    }
 
-  for (std::size_t i = 0; i < args.size(); ++i) {
     try {
-      m_server.addListenDirective(args[i]);
+      m_server.addListenDirective(address, parameters);
 
       std::ostringstream oss;
-      oss << "Added listen directive '" << args[i] << "' at line "
-          << lineNumber;
+      oss << "Added listen directive '" << address << "' with "
+          << parameters.size() << " parameter(s) at line " << lineNumber;
       m_logger.debug(oss.str());
 
     } catch (const exceptions::SyntaxException&) {
@@ -77,7 +124,7 @@ void ServerDirectiveHandler::handleListen(const std::vector<std::string>& args,
           oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
     } catch (const std::exception& e) {
       std::ostringstream oss;
-      oss << "Invalid listen directive '" << args[i] << "': " << e.what()
+      oss << "Invalid listen directive '" << address << "': " << e.what()
           << " at line " << lineNumber;
       throw exceptions::SyntaxException(
           oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
@@ -336,6 +383,86 @@ void ServerDirectiveHandler::handleReturn(const std::vector<std::string>& args,
   }
 }
 
+// keepalive_requests and the connection timeouts differ only in how the
+// value is parsed and which setter stores it.
+void ServerDirectiveHandler::handleConnectionSetting(
+    const std::string& directive, const std::vector<std::string>& args,
+    std::size_t lineNumber, ValueParser parser, ConnectionSetter setter) {
+  validateArgumentCount(directive, args, 1, lineNumber);
+
+  const unsigned int value = parser(args[0], directive, lineNumber);
+
+  try {
+    (m_server.*setter)(value);
+  } catch (const std::exception& e) {
+    std::ostringstream oss;
+    oss << "Invalid " << directive << " '" << args[0] << "': " << e.what()
+        << " at line " << lineNumber;
+    throw exceptions::SyntaxException(
+        oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+  }
+
+  std::ostringstream oss;
+  oss << "Set " << directive << " to " << value << " at line " << lineNumber;
+  m_logger.debug(oss.str());
+}
+
+void ServerDirectiveHandler::handleTcpNoDelay(
+    const std::vector<std::string>& args, std::size_t lineNumber) {
+  validateArgumentCount("tcp_nodelay", args, 1, lineNumber);
+
+  m_server.setTcpNoDelay(parseOnOff(args[0], "tcp_nodelay", lineNumber));
+
+  std::ostringstream oss;
+  oss << "Set tcp_nodelay to '" << args[0] << "' at line " << lineNumber;
+  m_logger.debug(oss.str());
+}
+
+void ServerDirectiveHandler::handleTcpNoPush(
+    const std::vector<std::string>& args, std::size_t lineNumber) {
+  validateArgumentCount("tcp_nopush", args, 1, lineNumber);
+
+  m_server.setTcpNoPush(parseOnOff(args[0], "tcp_nopush", lineNumber));
+
+  std::ostringstream oss;
+  oss << "Set tcp_nopush to '" << args[0] << "' at line " << lineNumber;
+  m_logger.debug(oss.str());
+}
+
+void ServerDirectiveHandler::handleSsl(const std::string& directive,
+                                       const std::vector<std::string>& args,
+                                       std::size_t lineNumber) {
+  validateArgumentCount(directive, args, 1, lineNumber);
+
+  domain::configuration::value_objects::SslConfig ssl =
+      m_server.getSslConfig();
+  try {
+    if (directive == "ssl_certificate") {
+      ssl.setCertificate(args[0]);
+    } else if (directive == "ssl_certificate_key") {
+      ssl.setCertificateKey(args[0]);
+    } else if (directive == "ssl_session_cache") {
+      ssl.setSessionCache(args[0]);
+    } else if (directive == "ssl_session_timeout") {
+      ssl.setSessionTimeout(parseTimeSeconds(args[0], directive, lineNumber));
+    } else {
+      ssl.setSessionTicketsEnabled(parseOnOff(args[0], directive, lineNumber));
+    }
+  } catch (const domain::configuration::exceptions::SslConfigException& e) {
+    std::ostringstream oss;
+    oss << "Invalid " << directive << ": " << e.what() << " at line "
+        << lineNumber;
+    throw exceptions::SyntaxException(
+        oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+  }
+  m_server.setSslConfig(ssl);
+
+  std::ostringstream oss;
+  oss << "Set " << directive << " to '" << args[0] << "' at line "
+      << lineNumber;
+  m_logger.debug(oss.str());
+}
+
 }  // namespace handlers
 }  // namespace config
 }  // namespace infrastructure
@@ -30,6 +30,9 @@ class ServerDirectiveHandler : public ADirectiveHandler {
                       std::size_t lineNumber);
 
  private:
+  typedef void (domain::configuration::entities::ServerConfig::*
+                    ConnectionSetter)(unsigned int);
+
   domain::configuration::entities::ServerConfig& m_server;
 
   void handleListen(const std::vector<std::string>& args,
@@ -45,6 +48,16 @@ class ServerDirectiveHandler : public ADirectiveHandler {
                                std::size_t lineNumber);
   void handleReturn(const std::vector<std::string>& args,
                     std::size_t lineNumber);
+  void handleConnectionSetting(const std::string& directive,
+                               const std::vector<std::string>& args,
+                               std::size_t lineNumber, ValueParser parser,
+                               ConnectionSetter setter);
+  void handleTcpNoDelay(const std::vector<std::string>& args,
+                        std::size_t lineNumber);
+  void handleTcpNoPush(const std::vector<std::string>& args,
+                       std::size_t lineNumber);
+  void handleSsl(const std::string& directive,
+                 const std::vector<std::string>& args, std::size_t lineNumber);
 };
 
 }  // namespace handlers
@@ -0,0 +1,129 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   UpstreamDirectiveHandler.cpp                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 09:12:40 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 09:12:40 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/config/exceptions/SyntaxException.hpp"
+#include "infrastructure/config/handlers/UpstreamDirectiveHandler.hpp"
+
+#include <sstream>
+
+namespace infrastructure {
+namespace config {
+namespace handlers {
+
+UpstreamDirectiveHandler::UpstreamDirectiveHandler(
+    application::ports::ILogger& logger,
+    domain::configuration::value_objects::UpstreamConfig& upstream)
+    : ADirectiveHandler(logger), m_upstream(upstream) {}
+
+void UpstreamDirectiveHandler::handle(const std::string& directive,
+                                      const std::vector<std::string>& args,
+                                      std::size_t lineNumber) {
+  if (directive == "server") {
+    handleServer(args, lineNumber);
+  } else if (directive == "least_conn") {
+    handleLeastConn(args, lineNumber);
+  } else if (directive == "hash") {
+    handleHash(args, lineNumber);
+  } else if (directive == "keepalive") {
+    handleKeepalive(args, lineNumber);
+  } else {
+    std::ostringstream oss;
+    oss << "Unknown or unsupported upstream directive: '" << directive
+        << "' at line " << lineNumber;
+    throw exceptions::SyntaxException(
+        oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+  }
+}
+
+// server address [weight=N] [max_fails=N] [fail_timeout=time];
+void UpstreamDirectiveHandler::handleServer(
+    const std::vector<std::string>& args, std::size_t lineNumber) {
+  validateMinimumArguments("server", args, 1, lineNumber);
+
+  try {
+    domain::configuration::value_objects::UpstreamConfig::Server server =
+        domain::configuration::value_objects::UpstreamConfig::parseServer(
+            args[0]);
+
+    for (std::size_t i = 1; i < args.size(); ++i) {
+      const std::string::size_type equals = args[i].find('=');
+      const std::string name = args[i].substr(0, equals);
+      const std::string value =
+          equals == std::string::npos ? "" : args[i].substr(equals + 1);
+
+      if (name == "weight" && !value.empty()) {
+        server.weight = parseUnsignedInt(value, "server weight", lineNumber);
+      } else if (name == "max_fails" && !value.empty()) {
+        server.maxFails =
+            parseUnsignedInt(value, "server max_fails", lineNumber);
+      } else if (name == "fail_timeout" && !value.empty()) {
+        server.failTimeout =
+            parseTimeSeconds(value, "server fail_timeout", lineNumber);
+      } else {
+        std::ostringstream oss;
+        oss << "Invalid upstream server parameter '" << args[i]
+            << "' at line " << lineNumber;
+        throw exceptions::SyntaxException(
+            oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+      }
+    }
+
+    m_upstream.addServer(server);
+
+    std::ostringstream oss;
+    oss << "Added upstream server '" << server.getAddress() << "' to '"
+        << m_upstream.getName() << "' at line " << lineNumber;
+    m_logger.debug(oss.str());
+
+  } catch (const exceptions::SyntaxException&) {
+    throw;
+  } catch (const std::exception& e) {
+    std::ostringstream oss;
+    oss << "Invalid upstream server '" << args[0] << "': " << e.what()
+        << " at line " << lineNumber;
+    throw exceptions::SyntaxException(
+        oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+  }
+}
+
+void UpstreamDirectiveHandler::handleLeastConn(
+    const std::vector<std::string>& args, std::size_t lineNumber) {
+  validateArgumentCount("least_conn", args, 0, lineNumber);
+  m_upstream.setBalance(
+      domain::configuration::value_objects::UpstreamConfig::BALANCE_LEAST_CONN);
+}
+
+void UpstreamDirectiveHandler::handleHash(const std::vector<std::string>& args,
+                                          std::size_t lineNumber) {
+  validateArgumentCount("hash", args, 1, lineNumber);
+
+  try {
+    m_upstream.setHashKey(args[0]);
+  } catch (const std::exception& e) {
+    std::ostringstream oss;
+    oss << "Invalid hash key '" << args[0] << "': " << e.what() << " at line "
+        << lineNumber;
+    throw exceptions::SyntaxException(
+        oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+  }
+}
+
+void UpstreamDirectiveHandler::handleKeepalive(
+    const std::vector<std::string>& args, std::size_t lineNumber) {
+  validateArgumentCount("keepalive", args, 1, lineNumber);
+  m_upstream.setKeepalive(
+      parseUnsignedInt(args[0], "upstream keepalive", lineNumber));
+}
+
+}  // namespace handlers
+}  // namespace config
+}  // namespace infrastructure
@@ -0,0 +1,50 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   UpstreamDirectiveHandler.hpp                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 09:12:40 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 09:12:40 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef UPSTREAM_DIRECTIVE_HANDLER_HPP
+#define UPSTREAM_DIRECTIVE_HANDLER_HPP
+
+#include "domain/configuration/value_objects/UpstreamConfig.hpp"
+#include "infrastructure/config/handlers/ADirectiveHandler.hpp"
+
+namespace infrastructure {
+namespace config {
+namespace handlers {
+
+class UpstreamDirectiveHandler : public ADirectiveHandler {
+ public:
+  UpstreamDirectiveHandler(
+      application::ports::ILogger& logger,
+      domain::configuration::value_objects::UpstreamConfig& upstream);
+
+  virtual void handle(const std::string& directive,
+                      const std::vector<std::string>& args,
+                      std::size_t lineNumber);
+
+ private:
+  domain::configuration::value_objects::UpstreamConfig& m_upstream;
+
+  void handleServer(const std::vector<std::string>& args,
+                    std::size_t lineNumber);
+  void handleLeastConn(const std::vector<std::string>& args,
+                       std::size_t lineNumber);
+  void handleHash(const std::vector<std::string>& args,
+                  std::size_t lineNumber);
+  void handleKeepalive(const std::vector<std::string>& args,
+                       std::size_t lineNumber);
+};
+
+}  // namespace handlers
+}  // namespace config
+}  // namespace infrastructure
+
+#endif  // UPSTREAM_DIRECTIVE_HANDLER_HPP
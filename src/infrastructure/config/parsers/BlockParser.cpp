@@ -13,10 +13,12 @@
 #include "domain/configuration/entities/HttpConfig.hpp"
 #include "domain/configuration/entities/LocationConfig.hpp"
 #include "domain/configuration/entities/ServerConfig.hpp"
+#include "domain/configuration/value_objects/MimeTypes.hpp"
 #include "infrastructure/config/exceptions/SyntaxException.hpp"
 #include "infrastructure/config/handlers/GlobalDirectiveHandler.hpp"
 #include "infrastructure/config/handlers/LocationDirectiveHandler.hpp"
 #include "infrastructure/config/handlers/ServerDirectiveHandler.hpp"
+#include "infrastructure/config/handlers/UpstreamDirectiveHandler.hpp"
 #include "infrastructure/config/parsers/BlockParser.hpp"
 
 #include <sstream>
@@ -52,7 +54,11 @@ void BlockParser::parseHttpBlock(
     if (token.type == lexer::Token::STRING) {
       std::string tokenValue = token.value;
 
-      if (context.currentIndex() + 1 < context.tokenCount()) {
+      if (tokenValue == "upstream") {
+        context.advance();
+        context.pushState(ParserState::UPSTREAM, "upstream");
+        parseUpstreamBlock(context, httpConfig);
+      } else if (context.currentIndex() + 1 < context.tokenCount()) {
         const lexer::Token& nextToken = context.peekToken();
 
         if (nextToken.type == lexer::Token::BLOCK_START) {
@@ -90,6 +96,13 @@ void BlockParser::parseServerBlock(
 
   try {
     server->setClientMaxBodySize(httpConfig.getClientMaxBodySize());
+    server->setKeepaliveTimeout(httpConfig.getKeepaliveTimeout());
+    server->setKeepaliveRequests(httpConfig.getKeepaliveRequests());
+    server->setClientHeaderTimeout(httpConfig.getClientHeaderTimeout());
+    server->setClientBodyTimeout(httpConfig.getClientBodyTimeout());
+    server->setSendTimeout(httpConfig.getSendTimeout());
+    server->setTcpNoDelay(httpConfig.isTcpNoDelay());
+    server->setTcpNoPush(httpConfig.isTcpNoPush());
 
     const domain::configuration::entities::HttpConfig::ErrorPagesMap&
         httpErrorPages = httpConfig.getErrorPages();
@@ -322,6 +335,136 @@ void BlockParser::parseLocationBlock(
   }
 }
 
+void BlockParser::parseTypesBlock(
+    ParserContext& context,
+    domain::configuration::entities::HttpConfig& httpConfig) {
+  m_logger.debug("Parsing types block content");
+
+  std::size_t typeCount = 0;
+  while (context.hasMoreTokens()) {
+    const lexer::Token& token = context.currentToken();
+
+    if (token.type == lexer::Token::BLOCK_END) {
+      context.advance();
+
+      std::ostringstream oss;
+      oss << "End of types block, added " << typeCount << " MIME types";
+      m_logger.debug(oss.str());
+      return;
+    }
+
+    if (token.type == lexer::Token::EOF_T) {
+      throw exceptions::SyntaxException(
+          "Unexpected end of file in types block",
+          exceptions::SyntaxException::UNEXPECTED_EOF);
+    }
+
+    if (token.type != lexer::Token::STRING) {
+      std::ostringstream oss;
+      oss << "Unexpected token in types block: " << token.typeToString()
+          << " at line " << token.lineNumber;
+      throw exceptions::SyntaxException(
+          oss.str(), exceptions::SyntaxException::UNEXPECTED_TOKEN);
+    }
+
+    const std::string mimeType = token.value;
+    const std::size_t lineNumber = token.lineNumber;
+    if (!domain::configuration::value_objects::MimeTypes::isValidType(
+            mimeType)) {
+      std::ostringstream oss;
+      oss << "Invalid MIME type '" << mimeType << "' at line " << lineNumber;
+      throw exceptions::SyntaxException(
+          oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+    }
+    context.advance();
+
+    std::size_t extensionCount = 0;
+    while (context.hasMoreTokens() &&
+           context.currentToken().type == lexer::Token::STRING) {
+      httpConfig.addMimeType(mimeType, context.currentToken().value);
+      ++extensionCount;
+      context.advance();
+    }
+    context.expect(lexer::Token::SEMICOLON, "semicolon after MIME type");
+    context.advance();
+
+    if (extensionCount == 0) {
+      std::ostringstream oss;
+      oss << "MIME type '" << mimeType
+          << "' requires at least one extension at line " << lineNumber;
+      throw exceptions::SyntaxException(
+          oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+    }
+    typeCount += extensionCount;
+  }
+
+  throw exceptions::SyntaxException("Types block not properly closed",
+                                    exceptions::SyntaxException::MISSING_BRACE);
+}
+
+void BlockParser::parseUpstreamBlock(
+    ParserContext& context,
+    domain::configuration::entities::HttpConfig& httpConfig) {
+  const std::size_t lineNumber = context.currentToken().lineNumber;
+  context.expect(lexer::Token::STRING, "upstream name");
+  const std::string name = context.currentToken().value;
+  context.advance();
+  context.expect(lexer::Token::BLOCK_START, "block start");
+  context.advance();
+
+  domain::configuration::value_objects::UpstreamConfig upstream;
+  try {
+    upstream = domain::configuration::value_objects::UpstreamConfig(name);
+  } catch (const std::exception& e) {
+    std::ostringstream oss;
+    oss << "Invalid upstream '" << name << "': " << e.what() << " at line "
+        << lineNumber;
+    throw exceptions::SyntaxException(
+        oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+  }
+
+  handlers::UpstreamDirectiveHandler handler(m_logger, upstream);
+  while (context.hasMoreTokens()) {
+    const lexer::Token& token = context.currentToken();
+
+    if (token.type == lexer::Token::BLOCK_END) {
+      context.advance();
+      context.popState();
+      try {
+        httpConfig.addUpstream(upstream);
+      } catch (const std::exception& e) {
+        std::ostringstream oss;
+        oss << e.what() << " at line " << lineNumber;
+        throw exceptions::SyntaxException(
+            oss.str(), exceptions::SyntaxException::INVALID_DIRECTIVE);
+      }
+
+      std::ostringstream oss;
+      oss << "End of upstream block '" << name << "' with "
+          << upstream.getServers().size() << " servers";
+      m_logger.debug(oss.str());
+      return;
+    }
+
+    if (token.type != lexer::Token::STRING) {
+      std::ostringstream oss;
+      oss << "Unexpected token in upstream block: " << token.typeToString()
+          << " at line " << token.lineNumber;
+      throw exceptions::SyntaxException(
+          oss.str(), exceptions::SyntaxException::UNEXPECTED_TOKEN);
+    }
+
+    const std::string directive = token.value;
+    const std::size_t directiveLine = token.lineNumber;
+    const std::vector<std::string> args =
+        readDirectiveArguments(context, token);
+    handler.handle(directive, args, directiveLine);
+  }
+
+  throw exceptions::SyntaxException("Upstream block not properly closed",
+                                    exceptions::SyntaxException::MISSING_BRACE);
+}
+
 void BlockParser::handleNestedBlock(
     ParserContext& context, const std::string& blockName,
     domain::configuration::entities::HttpConfig* httpConfig,
@@ -335,6 +478,11 @@ void BlockParser::handleNestedBlock(
     context.advance();
     context.pushState(ParserState::SERVER, "server");
     parseServerBlock(context, *httpConfig);
+  } else if (blockName == "types" && httpConfig != NULL) {
+    context.advance();
+    context.expect(lexer::Token::BLOCK_START, "block start");
+    context.advance();
+    parseTypesBlock(context, *httpConfig);
   } else if (blockName == "location" && server != NULL) {
     std::ostringstream oss;
     oss << "Location blocks should be handled specially, not as nested blocks "
@@ -360,7 +508,31 @@ void BlockParser::handleDirective(
     domain::configuration::entities::LocationConfig* location) {
   std::string directive = directiveToken.value;
   std::size_t lineNumber = directiveToken.lineNumber;
+  const std::vector<std::string> args =
+      readDirectiveArguments(context, directiveToken);
 
+  if (httpConfig != NULL) {
+    handlers::GlobalDirectiveHandler handler(m_logger, *httpConfig);
+    handler.handle(directive, args, lineNumber);
+  } else if (server != NULL) {
+    handlers::ServerDirectiveHandler handler(m_logger, *server);
+    handler.handle(directive, args, lineNumber);
+  } else if (location != NULL) {
+    handlers::LocationDirectiveHandler handler(m_logger, *location);
+    handler.handle(directive, args, lineNumber);
+  }
+
+  std::ostringstream oss;
+  oss << "Processed directive '" << directive << "' with " << args.size()
+      << " arguments at line " << lineNumber;
+  m_logger.debug(oss.str());
+}
+
+// Consumes the directive name and its arguments up to and including the
+// terminating semicolon.
+std::vector<std::string> BlockParser::readDirectiveArguments(
+    ParserContext& context, const lexer::Token& directiveToken) {
+  const std::string directive = directiveToken.value;
   context.advance();
 
   std::vector<std::string> args;
@@ -398,22 +570,7 @@ void BlockParser::handleDirective(
           oss.str(), exceptions::SyntaxException::UNEXPECTED_TOKEN);
     }
   }
-
-  if (httpConfig != NULL) {
-    handlers::GlobalDirectiveHandler handler(m_logger, *httpConfig);
-    handler.handle(directive, args, lineNumber);
-  } else if (server != NULL) {
-    handlers::ServerDirectiveHandler handler(m_logger, *server);
-    handler.handle(directive, args, lineNumber);
-  } else if (location != NULL) {
-    handlers::LocationDirectiveHandler handler(m_logger, *location);
-    handler.handle(directive, args, lineNumber);
-  }
-
-  std::ostringstream oss;
-  oss << "Processed directive '" << directive << "' with " << args.size()
-      << " arguments at line " << lineNumber;
-  m_logger.debug(oss.str());
+  return args;
 }
 
 void BlockParser::handleLimitExceptBlock(
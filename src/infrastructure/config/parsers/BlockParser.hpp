@@ -33,6 +33,11 @@ class BlockParser {
   void parseLocationBlock(
       ParserContext& context,
       domain::configuration::entities::ServerConfig& server);
+  void parseTypesBlock(ParserContext& context,
+                       domain::configuration::entities::HttpConfig& httpConfig);
+  void parseUpstreamBlock(
+      ParserContext& context,
+      domain::configuration::entities::HttpConfig& httpConfig);
 
  private:
   application::ports::ILogger& m_logger;
@@ -52,6 +57,9 @@ class BlockParser {
       domain::configuration::entities::ServerConfig* server,
       domain::configuration::entities::LocationConfig* location);
 
+  std::vector<std::string> readDirectiveArguments(
+      ParserContext& context, const lexer::Token& directiveToken);
+
   void handleLimitExceptBlock(
       ParserContext& context,
       domain::configuration::entities::LocationConfig& location);
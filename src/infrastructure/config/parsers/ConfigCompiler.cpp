@@ -0,0 +1,320 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ConfigCompiler.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 00:12:37 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 00:12:37 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "domain/shared/exceptions/BinaryFormatException.hpp"
+#include "infrastructure/config/exceptions/ConfigException.hpp"
+#include "infrastructure/config/parsers/ConfigCompiler.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <fstream>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace infrastructure {
+namespace config {
+namespace parsers {
+
+namespace {
+
+const unsigned long K_FNV_OFFSET_BASIS = 2166136261UL;
+const unsigned long K_FNV_PRIME = 16777619UL;
+const unsigned long K_HASH_MASK = 0xFFFFFFFFUL;
+const std::size_t K_READ_CHUNK = 8192;
+
+}  // namespace
+
+const char ConfigCompiler::K_MAGIC[] = "WSCC";
+const std::size_t ConfigCompiler::K_MAGIC_LENGTH;
+const unsigned long ConfigCompiler::FORMAT_VERSION;
+const std::string ConfigCompiler::COMPILED_SUFFIX = ".compiled";
+
+ConfigCompiler::ConfigCompiler(application::ports::ILogger& logger)
+    : m_logger(logger) {}
+
+ConfigCompiler::~ConfigCompiler() {}
+
+// The image is decoded and re-encoded before it is written, so a field that
+// serialize() writes but deserialize() drops fails here rather than at
+// startup.
+void ConfigCompiler::compile(
+    const domain::configuration::entities::HttpConfig& httpConfig,
+    const std::string& outputPath) const {
+  const std::string image = encode(httpConfig);
+
+  domain::configuration::entities::HttpConfig* decoded =
+      decode(image.data(), image.size(), NULL);
+  const bool faithful = serializeTree(*decoded) == serializeTree(httpConfig);
+  delete decoded;
+  if (!faithful) {
+    throw exceptions::ConfigException(
+        "Compiled configuration does not decode to the parsed one",
+        exceptions::ConfigException::INVALID_STATE);
+  }
+
+  const std::string temporaryPath = outputPath + ".tmp";
+  std::ofstream output(temporaryPath.c_str(),
+                       std::ios::out | std::ios::binary | std::ios::trunc);
+  output.write(image.data(), static_cast<std::streamsize>(image.size()));
+  output.close();
+  if (!output || std::rename(temporaryPath.c_str(), outputPath.c_str()) != 0) {
+    std::remove(temporaryPath.c_str());
+    throw exceptions::ConfigException(
+        "Cannot write compiled configuration: " + outputPath,
+        exceptions::ConfigException::LOAD_FILE_NOT_FOUND);
+  }
+
+  std::ostringstream oss;
+  oss << "Compiled configuration written to " << outputPath << " ("
+      << image.size() << " bytes, " << httpConfig.getSourceFiles().size()
+      << " source(s))";
+  m_logger.info(oss.str());
+}
+
+domain::configuration::entities::HttpConfig* ConfigCompiler::load(
+    const std::string& compiledPath) const {
+  const int descriptor = open(compiledPath.c_str(), O_RDONLY);
+  if (descriptor < 0) {
+    return NULL;
+  }
+
+  struct stat info;
+  if (fstat(descriptor, &info) != 0 || info.st_size <= 0) {
+    close(descriptor);
+    m_logger.warn("Ignoring unreadable compiled configuration " +
+                  compiledPath);
+    return NULL;
+  }
+
+  const std::size_t length = static_cast<std::size_t>(info.st_size);
+  void* mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+  close(descriptor);
+  if (mapping == MAP_FAILED) {
+    m_logger.warn("Cannot map compiled configuration " + compiledPath);
+    return NULL;
+  }
+
+  domain::configuration::entities::HttpConfig* httpConfig = NULL;
+  std::string staleSource;
+  try {
+    httpConfig =
+        decode(static_cast<const char*>(mapping), length, &staleSource);
+  } catch (const std::exception& exception) {
+    m_logger.warn("Ignoring compiled configuration " + compiledPath + ": " +
+                  exception.what());
+  }
+  munmap(mapping, length);
+
+  if (httpConfig != NULL) {
+    m_logger.info("Loaded compiled configuration " + compiledPath);
+  } else if (!staleSource.empty()) {
+    m_logger.info("Compiled configuration " + compiledPath +
+                  " is stale: " + staleSource + " changed");
+  }
+  return httpConfig;
+}
+
+std::string ConfigCompiler::compiledPathFor(const std::string& configPath) {
+  return configPath + COMPILED_SUFFIX;
+}
+
+std::string ConfigCompiler::encode(
+    const domain::configuration::entities::HttpConfig& httpConfig) {
+  domain::shared::utils::BinaryWriter payload;
+
+  const domain::configuration::entities::HttpConfig::SourceFiles& sources =
+      httpConfig.getSourceFiles();
+  payload.writeSize(sources.size());
+  for (std::size_t i = 0; i < sources.size(); ++i) {
+    SourceStamp stamp;
+    if (!stampSource(sources[i], stamp)) {
+      throw exceptions::ConfigException(
+          "Cannot fingerprint configuration source: " + sources[i],
+          exceptions::ConfigException::LOAD_FILE_NOT_FOUND);
+    }
+    payload.writeString(stamp.path);
+    payload.writeSize(stamp.modified);
+    payload.writeSize(stamp.size);
+    payload.writeU32(stamp.hash);
+  }
+  httpConfig.serialize(payload);
+
+  domain::shared::utils::BinaryWriter image;
+  image.writeBytes(K_MAGIC, K_MAGIC_LENGTH);
+  image.writeU32(FORMAT_VERSION);
+  image.writeSize(payload.size());
+  image.writeU32(hashBytes(K_FNV_OFFSET_BASIS, payload.getBuffer().data(),
+                           payload.size()));
+  image.writeBytes(payload.getBuffer().data(), payload.size());
+  return image.getBuffer();
+}
+
+// Returns NULL without throwing when staleSource is given and a recorded
+// source no longer matches; malformed images throw BinaryFormatException.
+domain::configuration::entities::HttpConfig* ConfigCompiler::decode(
+    const char* data, std::size_t length, std::string* staleSource) {
+  domain::shared::utils::BinaryReader header(data, length);
+
+  if (std::memcmp(header.readBytes(K_MAGIC_LENGTH), K_MAGIC, K_MAGIC_LENGTH) !=
+      0) {
+    throw domain::shared::exceptions::BinaryFormatException(
+        "not a compiled configuration",
+        domain::shared::exceptions::BinaryFormatException::INVALID_VALUE);
+  }
+
+  const unsigned long version = header.readU32();
+  if (version != FORMAT_VERSION) {
+    std::ostringstream oss;
+    oss << "format version " << version << ", expected " << FORMAT_VERSION;
+    throw domain::shared::exceptions::BinaryFormatException(
+        oss.str(),
+        domain::shared::exceptions::BinaryFormatException::INVALID_VALUE);
+  }
+
+  const std::size_t payloadLength = header.readSize();
+  const unsigned long checksum = header.readU32();
+  if (payloadLength != header.remaining()) {
+    throw domain::shared::exceptions::BinaryFormatException(
+        "payload length does not match the file size",
+        domain::shared::exceptions::BinaryFormatException::TRUNCATED_INPUT);
+  }
+  const char* payload = header.readBytes(payloadLength);
+  if (hashBytes(K_FNV_OFFSET_BASIS, payload, payloadLength) != checksum) {
+    throw domain::shared::exceptions::BinaryFormatException(
+        "payload checksum mismatch",
+        domain::shared::exceptions::BinaryFormatException::INVALID_VALUE);
+  }
+
+  domain::shared::utils::BinaryReader reader(payload, payloadLength);
+  std::vector<std::string> sources;
+  const std::size_t sourceCount = reader.readSize();
+  for (std::size_t i = 0; i < sourceCount; ++i) {
+    SourceStamp recorded;
+    recorded.path = reader.readString();
+    recorded.modified = reader.readSize();
+    recorded.size = reader.readSize();
+    recorded.hash = reader.readU32();
+
+    if (staleSource != NULL) {
+      SourceStamp current;
+      if (!stampSource(recorded.path, current) ||
+          current.modified != recorded.modified ||
+          current.size != recorded.size || current.hash != recorded.hash) {
+        *staleSource = recorded.path;
+        return NULL;
+      }
+    }
+    sources.push_back(recorded.path);
+  }
+
+  domain::configuration::entities::HttpConfig* httpConfig =
+      new domain::configuration::entities::HttpConfig();
+  try {
+    httpConfig->deserialize(reader);
+    if (!reader.isAtEnd()) {
+      throw domain::shared::exceptions::BinaryFormatException(
+          "trailing bytes after the configuration tree",
+          domain::shared::exceptions::BinaryFormatException::INVALID_VALUE);
+    }
+  } catch (...) {
+    delete httpConfig;
+    throw;
+  }
+
+  for (std::size_t i = 0; i < sources.size(); ++i) {
+    httpConfig->addSourceFile(sources[i]);
+  }
+  return httpConfig;
+}
+
+// A globbed include is recorded as its directory, fingerprinted by its sorted
+// listing, so adding or removing a matching file also invalidates the image.
+bool ConfigCompiler::stampSource(const std::string& path, SourceStamp& stamp) {
+  struct stat info;
+  if (stat(path.c_str(), &info) != 0) {
+    return false;
+  }
+
+  stamp.path = path;
+  stamp.modified = static_cast<std::size_t>(info.st_mtime);
+  if (S_ISDIR(info.st_mode)) {
+    return hashDirectory(path, stamp.size, stamp.hash);
+  }
+  stamp.size = static_cast<std::size_t>(info.st_size);
+  return hashFile(path, stamp.hash);
+}
+
+bool ConfigCompiler::hashFile(const std::string& path, unsigned long& hash) {
+  std::ifstream input(path.c_str(), std::ios::in | std::ios::binary);
+  if (!input.is_open()) {
+    return false;
+  }
+
+  char buffer[K_READ_CHUNK];
+  hash = K_FNV_OFFSET_BASIS;
+  while (input.read(buffer, sizeof(buffer)) || input.gcount() > 0) {
+    hash = hashBytes(hash, buffer, static_cast<std::size_t>(input.gcount()));
+  }
+  return input.eof();
+}
+
+bool ConfigCompiler::hashDirectory(const std::string& path,
+                                   std::size_t& entries, unsigned long& hash) {
+  DIR* directory = opendir(path.c_str());
+  if (directory == NULL) {
+    return false;
+  }
+
+  std::vector<std::string> names;
+  struct dirent* entry;
+  while ((entry = readdir(directory)) != NULL) {
+    const std::string name = entry->d_name;
+    if (name != "." && name != "..") {
+      names.push_back(name);
+    }
+  }
+  closedir(directory);
+
+  std::sort(names.begin(), names.end());
+  entries = names.size();
+  hash = K_FNV_OFFSET_BASIS;
+  for (std::size_t i = 0; i < names.size(); ++i) {
+    hash = hashBytes(hash, names[i].c_str(), names[i].size() + 1);
+  }
+  return true;
+}
+
+unsigned long ConfigCompiler::hashBytes(unsigned long hash, const char* data,
+                                        std::size_t length) {
+  for (std::size_t i = 0; i < length; ++i) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash = (hash * K_FNV_PRIME) & K_HASH_MASK;
+  }
+  return hash;
+}
+
+std::string ConfigCompiler::serializeTree(
+    const domain::configuration::entities::HttpConfig& httpConfig) {
+  domain::shared::utils::BinaryWriter writer;
+  httpConfig.serialize(writer);
+  return writer.getBuffer();
+}
+
+}  // namespace parsers
+}  // namespace config
+}  // namespace infrastructure
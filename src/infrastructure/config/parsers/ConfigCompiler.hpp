@@ -0,0 +1,85 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ConfigCompiler.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 00:12:37 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 00:12:37 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef CONFIG_COMPILER_HPP
+#define CONFIG_COMPILER_HPP
+
+#include "application/ports/ILogger.hpp"
+#include "domain/configuration/entities/HttpConfig.hpp"
+#include "domain/shared/utils/BinaryReader.hpp"
+#include "domain/shared/utils/BinaryWriter.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace infrastructure {
+namespace config {
+namespace parsers {
+
+// Writes a validated HttpConfig as a versioned binary image and maps it back
+// in without going through the lexer, parser or validators. The image records
+// the mtime, size and content hash of every file (and globbed include
+// directory) the configuration was read from; if any of them changed the
+// image is stale and load() returns NULL so the caller parses the source.
+//
+// Layout: magic "WSCC", u32 format version, size payload length, u32 FNV-1a
+// checksum of the payload, then the payload: the source list followed by the
+// serialized HttpConfig tree.
+class ConfigCompiler {
+ public:
+  static const char K_MAGIC[];
+  static const std::size_t K_MAGIC_LENGTH = 4;
+  static const unsigned long FORMAT_VERSION = 10;
+  static const std::string COMPILED_SUFFIX;
+
+  explicit ConfigCompiler(application::ports::ILogger& logger);
+  ~ConfigCompiler();
+
+  void compile(const domain::configuration::entities::HttpConfig& httpConfig,
+               const std::string& outputPath) const;
+  domain::configuration::entities::HttpConfig* load(
+      const std::string& compiledPath) const;
+
+  static std::string compiledPathFor(const std::string& configPath);
+  static std::string encode(
+      const domain::configuration::entities::HttpConfig& httpConfig);
+  static domain::configuration::entities::HttpConfig* decode(
+      const char* data, std::size_t length, std::string* staleSource);
+
+ private:
+  ConfigCompiler(const ConfigCompiler&);
+  ConfigCompiler& operator=(const ConfigCompiler&);
+
+  struct SourceStamp {
+    std::string path;
+    std::size_t modified;
+    std::size_t size;
+    unsigned long hash;
+  };
+
+  application::ports::ILogger& m_logger;
+
+  static bool stampSource(const std::string& path, SourceStamp& stamp);
+  static bool hashFile(const std::string& path, unsigned long& hash);
+  static bool hashDirectory(const std::string& path, std::size_t& entries,
+                            unsigned long& hash);
+  static unsigned long hashBytes(unsigned long hash, const char* data,
+                                 std::size_t length);
+  static std::string serializeTree(
+      const domain::configuration::entities::HttpConfig& httpConfig);
+};
+
+}  // namespace parsers
+}  // namespace config
+}  // namespace infrastructure
+
+#endif  // CONFIG_COMPILER_HPP
@@ -41,8 +41,10 @@ domain::configuration::entities::HttpConfig* ConfigParser::parseFile(
     parser::ParserContext context(tokens, configPath);
 
     httpConfig = new domain::configuration::entities::HttpConfig(configPath);
+    httpConfig->addSourceFile(configPath);
 
     parseTokens(context, *httpConfig);
+    httpConfig->compileMimeTypes();
     validateConfiguration(*httpConfig);
 
     std::ostringstream oss;
@@ -69,6 +71,27 @@ domain::configuration::entities::HttpConfig* ConfigParser::parseFile(
   }
 }
 
+// Parses an included file. It may hold only part of a configuration (a
+// single server, or a mime.types `types` block), so it is not validated or
+// given the built-in MIME table; the including file takes care of both.
+domain::configuration::entities::HttpConfig* ConfigParser::parseFragment(
+    const std::string& configPath) {
+  std::vector<lexer::Token> tokens = m_lexer.tokenizeFile(configPath);
+  parser::ParserContext context(tokens, configPath);
+
+  domain::configuration::entities::HttpConfig* httpConfig =
+      new domain::configuration::entities::HttpConfig(configPath);
+  httpConfig->addSourceFile(configPath);
+
+  try {
+    parseTokens(context, *httpConfig);
+  } catch (...) {
+    delete httpConfig;
+    throw;
+  }
+  return httpConfig;
+}
+
 void ConfigParser::initializeParser(const std::string& configPath) {
   m_logger.debug("Initializing parser for: " + configPath);
 }
@@ -142,6 +165,13 @@ void ConfigParser::handleBlockDeclaration(
 
     m_blockParser.parseHttpBlock(context, httpConfig);
 
+  } else if (blockName == "types") {
+    std::ostringstream oss;
+    oss << "Entering types block at line " << lineNumber;
+    m_logger.debug(oss.str());
+
+    m_blockParser.parseTypesBlock(context, httpConfig);
+
   } else if (blockName == "server") {
     context.pushState(parser::ParserState::SERVER, "server");
 
@@ -36,6 +36,9 @@ class ConfigParser : public application::ports::IConfigParser {
   virtual void validateConfiguration(
       const domain::configuration::entities::HttpConfig& httpConfig);
 
+  domain::configuration::entities::HttpConfig* parseFragment(
+      const std::string& configPath);
+
  private:
   application::ports::ILogger& m_logger;
   lexer::ConfigLexer m_lexer;
@@ -41,6 +41,11 @@ void IncludeProcessor::processIncludes(
   }
 
   std::vector<std::string> files = expandGlobPattern(pattern);
+  if (pattern.find('*') != std::string::npos ||
+      pattern.find('?') != std::string::npos) {
+    const std::string dirPath = extractDirectory(pattern);
+    httpConfig.addSourceFile(dirPath.empty() ? "." : dirPath);
+  }
 
   if (files.empty()) {
     std::ostringstream oss;
@@ -66,7 +71,7 @@ void IncludeProcessor::processIncludes(
 
       ConfigParser includeParser(m_logger);
       domain::configuration::entities::HttpConfig* includedConfig =
-          includeParser.parseFile(filePath);
+          includeParser.parseFragment(filePath);
 
       const domain::configuration::entities::HttpConfig::ServerConfigs&
           servers = includedConfig->getServerConfigs();
@@ -76,10 +81,18 @@ void IncludeProcessor::processIncludes(
             new domain::configuration::entities::ServerConfig(*servers[j]);
         httpConfig.addServerConfig(serverCopy);
       }
+      httpConfig.addMimeTypes(includedConfig->getMimeTypes());
+
+      const domain::configuration::entities::HttpConfig::SourceFiles& sources =
+          includedConfig->getSourceFiles();
+      for (std::size_t j = 0; j < sources.size(); ++j) {
+        httpConfig.addSourceFile(sources[j]);
+      }
 
       std::ostringstream successMsg;
       successMsg << "Successfully included " << servers.size()
-                 << " server(s) from " << filePath;
+                 << " server(s) and " << includedConfig->getMimeTypes().size()
+                 << " MIME type(s) from " << filePath;
       m_logger.info(successMsg.str());
 
       delete includedConfig;
@@ -25,6 +25,7 @@ std::string ParserState::contextToString() const {
     case HTTP: return "http";
     case SERVER: return "server";
     case LOCATION: return "location";
+    case UPSTREAM: return "upstream";
     default: return "unknown";
   }
 }
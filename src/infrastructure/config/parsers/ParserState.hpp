@@ -21,7 +21,7 @@ namespace parser {
 
 class ParserState {
  public:
-  enum Context { GLOBAL, HTTP, SERVER, LOCATION };
+  enum Context { GLOBAL, HTTP, SERVER, LOCATION, UPSTREAM };
 
   Context context;
   std::string blockName;
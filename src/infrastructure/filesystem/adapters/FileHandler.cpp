@@ -10,6 +10,7 @@
 /*                                                                            */
 /* ************************************************************************** */
 
+#include "domain/configuration/value_objects/MimeTypes.hpp"
 #include "domain/filesystem/value_objects/Path.hpp"
 #include "domain/filesystem/value_objects/Permission.hpp"
 #include "domain/filesystem/value_objects/Size.hpp"
@@ -1268,35 +1269,8 @@ std::string FileHandler::getFileExtension(const std::string& filename) const {
 
 std::string FileHandler::extensionToMimeType(
     const std::string& extension) const {
-  if (extension == "html" || extension == "htm") return "text/html";
-  if (extension == "css") return "text/css";
-  if (extension == "js") return "application/javascript";
-  if (extension == "json") return "application/json";
-  if (extension == "xml") return "application/xml";
-  if (extension == "txt") return "text/plain";
-  if (extension == "pdf") return "application/pdf";
-  if (extension == "jpg" || extension == "jpeg") return "image/jpeg";
-  if (extension == "png") return "image/png";
-  if (extension == "gif") return "image/gif";
-  if (extension == "bmp") return "image/bmp";
-  if (extension == "ico") return "image/x-icon";
-  if (extension == "svg") return "image/svg+xml";
-  if (extension == "zip") return "application/zip";
-  if (extension == "tar") return "application/x-tar";
-  if (extension == "gz") return "application/gzip";
-  if (extension == "mp3") return "audio/mpeg";
-  if (extension == "mp4") return "video/mp4";
-  if (extension == "avi") return "video/x-msvideo";
-  if (extension == "mov") return "video/quicktime";
-  if (extension == "php") return "application/x-httpd-php";
-  if (extension == "py") return "text/x-python";
-  if (extension == "c") return "text/x-c";
-  if (extension == "cpp" || extension == "cc" || extension == "cxx") {
-    return "text/x-c++";
-  }
-  if (extension == "h" || extension == "hpp") return "text/x-c++hdr";
-
-  return "application/octet-stream";
+  return domain::configuration::value_objects::MimeTypes::builtin().lookup(
+      extension);
 }
 
 }  // namespace filesystem
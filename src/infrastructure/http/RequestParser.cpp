@@ -13,6 +13,7 @@
 #include "domain/filesystem/value_objects/Path.hpp"
 #include "domain/http/value_objects/HttpMethod.hpp"
 #include "domain/http/value_objects/QueryStringBuilder.hpp"
+#include "domain/shared/utils/ByteScanner.hpp"
 #include "infrastructure/http/RequestParser.hpp"
 #include "infrastructure/http/RequestParserException.hpp"
 
@@ -24,12 +25,37 @@
 namespace infrastructure {
 namespace http {
 
+using domain::http::value_objects::HttpHeader;
+using domain::shared::utils::ByteScanner;
 using shared::exceptions::RequestParserException;
 
+HeaderView::HeaderView()
+    : nameOffset(0),
+      nameLength(0),
+      valueOffset(0),
+      valueLength(0),
+      id(HttpHeader::HEADER_UNKNOWN) {}
+
+HeaderView::HeaderView(std::size_t nameOff, std::size_t nameLen,
+                       std::size_t valueOff, std::size_t valueLen,
+                       HttpHeader::KnownHeader headerId)
+    : nameOffset(nameOff),
+      nameLength(nameLen),
+      valueOffset(valueOff),
+      valueLength(valueLen),
+      id(headerId) {}
+
 ParsedRequest::ParsedRequest()
     : method(domain::http::value_objects::HttpMethod::METHOD_UNKNOWN),
       path(domain::filesystem::value_objects::Path::fromString("/", true)),
-      httpVersion("HTTP/1.1") {}
+      version(domain::http::value_objects::HttpVersion::http11()),
+      bodyOffset(0),
+      bodyLength(0),
+      data(NULL) {
+  for (std::size_t i = 0; i < HttpHeader::KNOWN_HEADER_COUNT; ++i) {
+    knownHeaders[i] = K_NO_HEADER;
+  }
+}
 
 bool ParsedRequest::isComplete() const {
   return !hasError() &&
@@ -44,60 +70,127 @@ bool ParsedRequest::hasError() const {
 }
 
 std::string ParsedRequest::getHeader(const std::string& name) const {
-  std::string lowerName = name;
-  std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(),
-                 ::tolower);
+  const HeaderView* view = findHeader(name);
+  if (view != NULL) {
+    return headerValue(*view);
+  }
+  return "";
+}
 
-  std::map<std::string, std::string>::const_iterator it =
-      headers.find(lowerName);
-  if (it != headers.end()) {
-    return it->second;
+std::string ParsedRequest::getHeader(KnownHeader header) const {
+  const HeaderView* view = findHeader(header);
+  if (view != NULL) {
+    return headerValue(*view);
   }
   return "";
 }
 
 bool ParsedRequest::hasHeader(const std::string& name) const {
-  std::string lowerName = name;
-  std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(),
-                 ::tolower);
-  return headers.find(lowerName) != headers.end();
+  return findHeader(name) != NULL;
+}
+
+bool ParsedRequest::hasHeader(KnownHeader header) const {
+  return findHeader(header) != NULL;
 }
 
 std::size_t ParsedRequest::getContentLength() const {
-  std::string contentLength = getHeader("content-length");
-  if (contentLength.empty()) {
+  const HeaderView* view = findHeader(HttpHeader::HEADER_CONTENT_LENGTH);
+  if (view == NULL) {
     return 0;
   }
 
-  std::istringstream iss(contentLength);
-  std::size_t length;
-  if (iss >> length) {
-    return length;
+  const char* value = data + view->valueOffset;
+  std::size_t length = 0;
+  std::size_t index = 0;
+  while (index < view->valueLength &&
+         std::isdigit(static_cast<unsigned char>(value[index]))) {
+    length = length * 10 + static_cast<std::size_t>(value[index] - '0');
+    ++index;
   }
-  return 0;
+  return length;
 }
 
 bool ParsedRequest::isChunked() const {
-  std::string transferEncoding = getHeader("transfer-encoding");
+  std::string transferEncoding =
+      getHeader(HttpHeader::HEADER_TRANSFER_ENCODING);
   std::transform(transferEncoding.begin(), transferEncoding.end(),
                  transferEncoding.begin(), ::tolower);
   return transferEncoding.find("chunked") != std::string::npos;
 }
 
+std::string ParsedRequest::headerName(const HeaderView& view) const {
+  std::string name(data + view.nameOffset, view.nameLength);
+  if (!name.empty()) {
+    ByteScanner::toLowerAscii(&name[0], name.size());
+  }
+  return name;
+}
+
+std::string ParsedRequest::headerValue(const HeaderView& view) const {
+  return std::string(data + view.valueOffset, view.valueLength);
+}
+
+const char* ParsedRequest::bodyData() const { return data + bodyOffset; }
+
+const HeaderView* ParsedRequest::findHeader(const std::string& name) const {
+  const KnownHeader header = HttpHeader::lookupKnown(name);
+  if (header != HttpHeader::HEADER_UNKNOWN) {
+    return findHeader(header);
+  }
+
+  if (data == NULL) {
+    return NULL;
+  }
+
+  for (HeaderViews::const_reverse_iterator it = headers.rbegin();
+       it != headers.rend(); ++it) {
+    if (it->id != HttpHeader::HEADER_UNKNOWN ||
+        it->nameLength != name.length()) {
+      continue;
+    }
+
+    const char* candidate = data + it->nameOffset;
+    std::size_t index = 0;
+    while (index < name.length() &&
+           std::tolower(static_cast<unsigned char>(candidate[index])) ==
+               std::tolower(static_cast<unsigned char>(name[index]))) {
+      ++index;
+    }
+    if (index == name.length()) {
+      return &*it;
+    }
+  }
+  return NULL;
+}
+
+const HeaderView* ParsedRequest::findHeader(KnownHeader header) const {
+  if (header >= HttpHeader::HEADER_UNKNOWN ||
+      knownHeaders[header] == K_NO_HEADER) {
+    return NULL;
+  }
+  return &headers[static_cast<std::size_t>(knownHeaders[header])];
+}
+
+const std::size_t RequestParser::K_MAX_URI_LENGTH;
+
 RequestParser::RequestParser()
-    : m_maxHeaderSize(8192),
+    : m_data(NULL),
+      m_length(0),
+      m_position(0),
+      m_maxHeaderSize(8192),
       m_maxBodySize(10 * 1024 * 1024),
-      m_state(START_LINE),
-      m_bodyBytesRead(0) {
-  reset();
+      m_state(START_LINE) {
+  m_request.headers.reserve(K_DEFAULT_HEADER_CAPACITY);
 }
 
 RequestParser::RequestParser(std::size_t maxHeaderSize, std::size_t maxBodySize)
-    : m_maxHeaderSize(maxHeaderSize),
+    : m_data(NULL),
+      m_length(0),
+      m_position(0),
+      m_maxHeaderSize(maxHeaderSize),
       m_maxBodySize(maxBodySize),
-      m_state(START_LINE),
-      m_bodyBytesRead(0) {
-  reset();
+      m_state(START_LINE) {
+  m_request.headers.reserve(K_DEFAULT_HEADER_CAPACITY);
 }
 
 bool RequestParser::parse(const char* data, std::size_t length) {
@@ -109,7 +202,14 @@ bool RequestParser::parse(const char* data, std::size_t length) {
     return false;
   }
 
-  m_buffer.append(data, length);
+  if (length < m_position) {
+    m_state = ERROR;
+    return false;
+  }
+
+  m_data = data;
+  m_length = length;
+  m_request.data = data;
 
   try {
     bool progress = false;
@@ -124,6 +224,7 @@ bool RequestParser::parse(const char* data, std::size_t length) {
         case HEADERS:
           progress = parseHeaders();
           if (!progress) return false;
+          m_request.bodyOffset = m_position;
           if (m_request.isChunked()) {
             m_state = CHUNKED_BODY;
           } else if (m_request.getContentLength() > 0) {
@@ -162,6 +263,9 @@ bool RequestParser::parse(const char* data, std::size_t length) {
 }
 
 bool RequestParser::parse(const std::vector<char>& data) {
+  if (data.empty()) {
+    return false;
+  }
   return parse(&data[0], data.size());
 }
 
@@ -171,11 +275,23 @@ bool RequestParser::isComplete() const { return m_state == COMPLETE; }
 
 bool RequestParser::hasError() const { return m_state == ERROR; }
 
+bool RequestParser::headersComplete() const {
+  return m_state == BODY || m_state == CHUNKED_BODY || m_state == COMPLETE;
+}
+
+std::size_t RequestParser::getConsumedBytes() const { return m_position; }
+
 void RequestParser::reset() {
+  ParsedRequest::HeaderViews headers;
+  headers.swap(m_request.headers);
+  headers.clear();
+
   m_request = ParsedRequest();
-  m_buffer.clear();
+  m_request.headers.swap(headers);
+  m_data = NULL;
+  m_length = 0;
+  m_position = 0;
   m_state = START_LINE;
-  m_bodyBytesRead = 0;
 }
 
 void RequestParser::setMaxHeaderSize(std::size_t size) {
@@ -189,41 +305,34 @@ std::size_t RequestParser::getMaxHeaderSize() const { return m_maxHeaderSize; }
 std::size_t RequestParser::getMaxBodySize() const { return m_maxBodySize; }
 
 bool RequestParser::parseStartLine() {
-  std::size_t lineEnd = findLineEnd();
+  std::size_t lineEnd = findLineEnd(m_position);
   if (lineEnd == std::string::npos) {
+    checkHeaderSize(m_length);
     return false;
   }
 
-  std::string line = m_buffer.substr(0, lineEnd);
-  m_buffer.erase(0, lineEnd + 2);
-
-  processStartLine(line);
+  processStartLine(m_position, lineEnd);
+  m_position = lineEnd + 2;
   return true;
 }
 
 bool RequestParser::parseHeaders() {
   while (true) {
-    std::size_t lineEnd = findLineEnd();
+    std::size_t lineEnd = findLineEnd(m_position);
     if (lineEnd == std::string::npos) {
+      checkHeaderSize(m_length);
       return false;
     }
 
-    std::string line = m_buffer.substr(0, lineEnd);
-    m_buffer.erase(0, lineEnd + 2);
+    const std::size_t lineStart = m_position;
+    m_position = lineEnd + 2;
 
-    if (line.empty()) {
+    if (lineEnd == lineStart) {
       break;
     }
 
-    processHeaderLine(line);
-
-    if (m_buffer.size() > m_maxHeaderSize) {
-      std::ostringstream oss;
-      oss << "Headers size " << m_buffer.size() << " exceeds maximum of "
-          << m_maxHeaderSize;
-      throw RequestParserException(oss.str(),
-                                   RequestParserException::HEADER_TOO_LARGE);
-    }
+    processHeaderLine(lineStart, lineEnd);
+    checkHeaderSize(m_position);
   }
 
   return true;
@@ -245,74 +354,94 @@ bool RequestParser::parseBody() {
                                  RequestParserException::BODY_TOO_LARGE);
   }
 
-  std::size_t bytesNeeded = contentLength - m_bodyBytesRead;
-
-  if (bytesNeeded == 0) {
-    m_state = COMPLETE;
-    return true;
-  }
-
-  std::size_t bytesToRead = std::min(bytesNeeded, m_buffer.size());
-  m_request.body.insert(m_request.body.end(), m_buffer.begin(),
-                        m_buffer.begin() + bytesToRead);
-  m_bodyBytesRead += bytesToRead;
-  m_buffer.erase(0, bytesToRead);
-
-  if (m_bodyBytesRead >= contentLength) {
-    m_state = COMPLETE;
-    return true;
+  if (m_length - m_request.bodyOffset < contentLength) {
+    return false;
   }
 
-  return false;
+  m_request.bodyLength = contentLength;
+  m_position = m_request.bodyOffset + contentLength;
+  m_state = COMPLETE;
+  return true;
 }
 
 bool RequestParser::parseChunkedBody() {
-  std::size_t endPos = m_buffer.find("0\r\n\r\n");
-  if (endPos == std::string::npos) {
+  static const char K_CHUNKED_TERMINATOR[] = "0\r\n\r\n";
+  static const std::size_t K_CHUNKED_TERMINATOR_LENGTH =
+      sizeof(K_CHUNKED_TERMINATOR) - 1;
+
+  const char* begin = m_data + m_position;
+  const char* end = m_data + m_length;
+  const char* found =
+      std::search(begin, end, K_CHUNKED_TERMINATOR,
+                  K_CHUNKED_TERMINATOR + K_CHUNKED_TERMINATOR_LENGTH);
+  if (found == end) {
     return false;
   }
 
-  m_buffer.erase(0, endPos + 5);
+  m_position = static_cast<std::size_t>(found - m_data) +
+               K_CHUNKED_TERMINATOR_LENGTH;
   m_state = COMPLETE;
   return true;
 }
 
-std::size_t RequestParser::findLineEnd() const {
-  for (std::size_t i = 0; i + 1 < m_buffer.size(); ++i) {
-    if (m_buffer[i] == '\r' && m_buffer[i + 1] == '\n') {
-      return i;
-    }
+std::size_t RequestParser::findLineEnd(std::size_t from) const {
+  if (from >= m_length) {
+    return std::string::npos;
   }
-  return std::string::npos;
+
+  const std::size_t offset =
+      ByteScanner::findCrlf(m_data + from, m_length - from);
+  return offset == ByteScanner::NPOS ? std::string::npos : from + offset;
 }
 
-std::string RequestParser::extractLine() {
-  std::size_t lineEnd = findLineEnd();
-  if (lineEnd == std::string::npos) {
-    return "";
+void RequestParser::checkHeaderSize(std::size_t headerEnd) const {
+  if (headerEnd > m_maxHeaderSize) {
+    std::ostringstream oss;
+    oss << "Headers size " << headerEnd << " exceeds maximum of "
+        << m_maxHeaderSize;
+    throw RequestParserException(oss.str(),
+                                 RequestParserException::HEADER_TOO_LARGE);
   }
-
-  std::string line = m_buffer.substr(0, lineEnd);
-  m_buffer.erase(0, lineEnd + 2);
-  return line;
 }
 
-void RequestParser::processStartLine(const std::string& line) {
-  std::istringstream iss(line);
-  std::string methodStr, uri, version;
-
-  if (!(iss >> methodStr >> uri >> version)) {
-    throw RequestParserException("Invalid start line: " + line,
-                                 RequestParserException::MALFORMED_REQUEST);
+void RequestParser::processStartLine(std::size_t lineStart,
+                                     std::size_t lineEnd) {
+  static const std::size_t K_TOKEN_COUNT = 3;
+  std::size_t tokenStart[K_TOKEN_COUNT];
+  std::size_t tokenLength[K_TOKEN_COUNT];
+  std::size_t pos = lineStart;
+
+  for (std::size_t i = 0; i < K_TOKEN_COUNT; ++i) {
+    while (pos < lineEnd &&
+           std::isspace(static_cast<unsigned char>(m_data[pos]))) {
+      ++pos;
+    }
+    tokenStart[i] = pos;
+    while (pos < lineEnd &&
+           !std::isspace(static_cast<unsigned char>(m_data[pos]))) {
+      ++pos;
+    }
+    tokenLength[i] = pos - tokenStart[i];
+    if (tokenLength[i] == 0) {
+      throw RequestParserException(
+          "Invalid start line: " +
+              std::string(m_data + lineStart, lineEnd - lineStart),
+          RequestParserException::MALFORMED_REQUEST);
+    }
   }
 
-  if (!validateMethod(methodStr)) {
-    throw RequestParserException("Unsupported HTTP method: " + methodStr,
-                                 RequestParserException::UNSUPPORTED_METHOD);
+  const domain::http::value_objects::HttpMethod::Method method =
+      domain::http::value_objects::HttpMethod::lookupMethod(
+          m_data + tokenStart[0], tokenLength[0]);
+  if (method == domain::http::value_objects::HttpMethod::METHOD_UNKNOWN) {
+    throw RequestParserException(
+        "Unsupported HTTP method: " +
+            std::string(m_data + tokenStart[0], tokenLength[0]),
+        RequestParserException::UNSUPPORTED_METHOD);
   }
-  m_request.method =
-      domain::http::value_objects::HttpMethod::fromString(methodStr);
+  m_request.method = domain::http::value_objects::HttpMethod(method);
 
+  const std::string uri(m_data + tokenStart[1], tokenLength[1]);
   std::size_t queryPos = uri.find('?');
   std::string pathStr;
   if (queryPos != std::string::npos) {
@@ -325,10 +454,10 @@ void RequestParser::processStartLine(const std::string& line) {
     pathStr = uri;
   }
 
-  if (pathStr.length() > 8192) {
+  if (pathStr.length() > K_MAX_URI_LENGTH) {
     std::ostringstream oss;
-    oss << "URI length " << pathStr.length()
-        << " exceeds maximum of 8192 characters";
+    oss << "URI length " << pathStr.length() << " exceeds maximum of "
+        << K_MAX_URI_LENGTH << " characters";
     throw RequestParserException(oss.str(),
                                  RequestParserException::URI_TOO_LONG);
   }
@@ -351,41 +480,72 @@ void RequestParser::processStartLine(const std::string& line) {
                                  RequestParserException::MALFORMED_REQUEST);
   }
 
-  if (!validateHttpVersion(version)) {
+  if (!parseHttpVersion(m_data + tokenStart[2], tokenLength[2])) {
     throw RequestParserException(
-        "Invalid or unsupported HTTP version: " + version,
+        "Invalid or unsupported HTTP version: " +
+            std::string(m_data + tokenStart[2], tokenLength[2]),
         RequestParserException::INVALID_HTTP_VERSION);
   }
-  m_request.httpVersion = version;
 }
 
-void RequestParser::processHeaderLine(const std::string& line) {
-  std::size_t colonPos = line.find(':');
-  if (colonPos == std::string::npos) {
-    throw RequestParserException("Invalid header line (missing colon): " + line,
-                                 RequestParserException::INVALID_HEADER);
+void RequestParser::processHeaderLine(std::size_t lineStart,
+                                      std::size_t lineEnd) {
+  const std::size_t colonOffset =
+      ByteScanner::findByte(m_data + lineStart, lineEnd - lineStart, ':');
+  if (colonOffset == ByteScanner::NPOS) {
+    throw RequestParserException(
+        "Invalid header line (missing colon): " +
+            std::string(m_data + lineStart, lineEnd - lineStart),
+        RequestParserException::INVALID_HEADER);
   }
 
-  std::string name = line.substr(0, colonPos);
-  std::string value = line.substr(colonPos + 1);
+  const std::size_t colonPos = lineStart + colonOffset;
 
-  name.erase(0, name.find_first_not_of(" \t"));
-  name.erase(name.find_last_not_of(" \t") + 1);
-  value.erase(0, value.find_first_not_of(" \t"));
-  value.erase(value.find_last_not_of(" \t") + 1);
+  std::size_t nameStart = lineStart;
+  std::size_t nameEnd = colonPos;
+  std::size_t valueStart = colonPos + 1;
+  std::size_t valueEnd = lineEnd;
+
+  while (nameStart < nameEnd &&
+         (m_data[nameStart] == ' ' || m_data[nameStart] == '\t')) {
+    ++nameStart;
+  }
+  while (nameEnd > nameStart &&
+         (m_data[nameEnd - 1] == ' ' || m_data[nameEnd - 1] == '\t')) {
+    --nameEnd;
+  }
+  while (valueStart < valueEnd &&
+         (m_data[valueStart] == ' ' || m_data[valueStart] == '\t')) {
+    ++valueStart;
+  }
+  while (valueEnd > valueStart &&
+         (m_data[valueEnd - 1] == ' ' || m_data[valueEnd - 1] == '\t')) {
+    --valueEnd;
+  }
 
-  if (name.empty()) {
+  if (nameStart == nameEnd) {
     throw RequestParserException("Empty header name",
                                  RequestParserException::INVALID_HEADER);
   }
 
-  std::transform(name.begin(), name.end(), name.begin(), ::tolower);
-
-  m_request.headers[name] = value;
-}
+  if (ByteScanner::findInvalidTokenChar(m_data + nameStart,
+                                        nameEnd - nameStart) !=
+      ByteScanner::NPOS) {
+    throw RequestParserException(
+        "Invalid character in header name: " +
+            std::string(m_data + nameStart, nameEnd - nameStart),
+        RequestParserException::INVALID_HEADER);
+  }
 
-bool RequestParser::validateMethod(const std::string& method) const {
-  return domain::http::value_objects::HttpMethod::isValidMethodString(method);
+  const HttpHeader::KnownHeader header =
+      HttpHeader::lookupKnown(m_data + nameStart, nameEnd - nameStart);
+  if (header != HttpHeader::HEADER_UNKNOWN) {
+    m_request.knownHeaders[header] =
+        static_cast<int>(m_request.headers.size());
+  }
+  m_request.headers.push_back(HeaderView(nameStart, nameEnd - nameStart,
+                                         valueStart, valueEnd - valueStart,
+                                         header));
 }
 
 bool RequestParser::validatePath(const std::string& path) const {
@@ -406,16 +566,22 @@ bool RequestParser::validatePath(const std::string& path) const {
   return true;
 }
 
-bool RequestParser::validateHttpVersion(const std::string& version) const {
-  if (version.find("HTTP/") != 0) {
+bool RequestParser::parseHttpVersion(const char* token, std::size_t length) {
+  static const char K_HTTP_10[] = "HTTP/1.0";
+  static const char K_HTTP_11[] = "HTTP/1.1";
+  static const std::size_t K_VERSION_LENGTH = sizeof(K_HTTP_11) - 1;
+
+  if (length != K_VERSION_LENGTH) {
     return false;
   }
-
-  std::string verNum = version.substr(5);
-  if (verNum == "1.0" || verNum == "1.1") {
+  if (std::equal(token, token + length, K_HTTP_11)) {
+    m_request.version = domain::http::value_objects::HttpVersion::http11();
+    return true;
+  }
+  if (std::equal(token, token + length, K_HTTP_10)) {
+    m_request.version = domain::http::value_objects::HttpVersion::http10();
     return true;
   }
-
   return false;
 }
 
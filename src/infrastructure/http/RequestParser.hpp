@@ -14,7 +14,9 @@
 #define REQUEST_PARSER_HPP
 
 #include "domain/filesystem/value_objects/Path.hpp"
+#include "domain/http/value_objects/HttpHeader.hpp"
 #include "domain/http/value_objects/HttpMethod.hpp"
+#include "domain/http/value_objects/HttpVersion.hpp"
 #include "domain/http/value_objects/QueryStringBuilder.hpp"
 
 #include <map>
@@ -24,13 +26,34 @@
 namespace infrastructure {
 namespace http {
 
+struct HeaderView {
+  std::size_t nameOffset;
+  std::size_t nameLength;
+  std::size_t valueOffset;
+  std::size_t valueLength;
+  domain::http::value_objects::HttpHeader::KnownHeader id;
+
+  HeaderView();
+  HeaderView(std::size_t nameOff, std::size_t nameLen, std::size_t valueOff,
+             std::size_t valueLen,
+             domain::http::value_objects::HttpHeader::KnownHeader headerId);
+};
+
 struct ParsedRequest {
+  typedef std::vector<HeaderView> HeaderViews;
+  typedef domain::http::value_objects::HttpHeader::KnownHeader KnownHeader;
+
+  static const int K_NO_HEADER = -1;
+
   domain::http::value_objects::HttpMethod method;
   domain::filesystem::value_objects::Path path;
   domain::http::value_objects::QueryStringBuilder query;
-  std::string httpVersion;
-  std::map<std::string, std::string> headers;
-  std::vector<char> body;
+  domain::http::value_objects::HttpVersion version;
+  HeaderViews headers;
+  int knownHeaders[domain::http::value_objects::HttpHeader::KNOWN_HEADER_COUNT];
+  std::size_t bodyOffset;
+  std::size_t bodyLength;
+  const char* data;
 
   ParsedRequest();
 
@@ -38,13 +61,26 @@ struct ParsedRequest {
   bool hasError() const;
 
   std::string getHeader(const std::string& name) const;
+  std::string getHeader(KnownHeader header) const;
   bool hasHeader(const std::string& name) const;
+  bool hasHeader(KnownHeader header) const;
   std::size_t getContentLength() const;
   bool isChunked() const;
+
+  std::string headerName(const HeaderView& view) const;
+  std::string headerValue(const HeaderView& view) const;
+  const char* bodyData() const;
+
+ private:
+  const HeaderView* findHeader(const std::string& name) const;
+  const HeaderView* findHeader(KnownHeader header) const;
 };
 
 class RequestParser {
  public:
+  static const std::size_t K_DEFAULT_HEADER_CAPACITY = 32;
+  static const std::size_t K_MAX_URI_LENGTH = 8192;
+
   RequestParser();
   explicit RequestParser(std::size_t maxHeaderSize, std::size_t maxBodySize);
 
@@ -55,6 +91,8 @@ class RequestParser {
 
   bool isComplete() const;
   bool hasError() const;
+  bool headersComplete() const;
+  std::size_t getConsumedBytes() const;
   void reset();
 
   void setMaxHeaderSize(std::size_t size);
@@ -64,28 +102,28 @@ class RequestParser {
 
  private:
   ParsedRequest m_request;
-  std::string m_buffer;
+  const char* m_data;
+  std::size_t m_length;
+  std::size_t m_position;
   std::size_t m_maxHeaderSize;
   std::size_t m_maxBodySize;
 
   enum ParseState { START_LINE, HEADERS, BODY, CHUNKED_BODY, COMPLETE, ERROR };
 
   ParseState m_state;
-  std::size_t m_bodyBytesRead;
 
   bool parseStartLine();
   bool parseHeaders();
   bool parseBody();
   bool parseChunkedBody();
 
-  std::size_t findLineEnd() const;
-  std::string extractLine();
-  void processStartLine(const std::string& line);
-  void processHeaderLine(const std::string& line);
+  std::size_t findLineEnd(std::size_t from) const;
+  void processStartLine(std::size_t lineStart, std::size_t lineEnd);
+  void processHeaderLine(std::size_t lineStart, std::size_t lineEnd);
+  void checkHeaderSize(std::size_t headerEnd) const;
 
-  bool validateMethod(const std::string& method) const;
   bool validatePath(const std::string& path) const;
-  bool validateHttpVersion(const std::string& version) const;
+  bool parseHttpVersion(const char* token, std::size_t length);
 };
 
 }  // namespace http
@@ -0,0 +1,1172 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Http2Session.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 12:07:51 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 12:07:51 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/http2/adapters/Http2Session.hpp"
+
+#include <cstring>
+#include <sstream>
+
+namespace infrastructure {
+namespace http2 {
+namespace adapters {
+
+namespace {
+
+typedef exceptions::Http2Exception Http2Exception;
+typedef primitives::Http2Frame Http2Frame;
+
+const unsigned long K_EXCLUSIVE_BIT = 0x80000000ul;
+const unsigned long K_STRIDE_SCALE = 256;
+const std::size_t K_MAX_CONTENT_LENGTH_DIGITS = 18;
+const std::size_t K_OUTPUT_COMPACT_THRESHOLD = 16384;
+const char K_SWITCHING_PROTOCOLS[] =
+    "HTTP/1.1 101 Switching Protocols\r\n"
+    "Connection: Upgrade\r\n"
+    "Upgrade: h2c\r\n\r\n";
+
+const char* const K_REQUEST_PSEUDO_HEADERS[] = {":method", ":scheme", ":path",
+                                                ":authority"};
+const std::size_t K_PSEUDO_METHOD = 0;
+const std::size_t K_PSEUDO_SCHEME = 1;
+const std::size_t K_PSEUDO_PATH = 2;
+
+// RFC 7540 section 8.1.2.2: these only mean something to HTTP/1.1.
+const char* const K_CONNECTION_HEADERS[] = {
+    "connection", "keep-alive", "proxy-connection", "transfer-encoding",
+    "upgrade"};
+
+void connectionError(Http2Exception::ErrorCode code,
+                     const std::string& message) {
+  throw Http2Exception(message, code, 0);
+}
+
+void streamError(unsigned int streamId, Http2Exception::ErrorCode code,
+                 const std::string& message) {
+  throw Http2Exception(message, code, streamId);
+}
+
+std::size_t pseudoHeaderIndex(const std::string& name) {
+  const std::size_t count =
+      sizeof(K_REQUEST_PSEUDO_HEADERS) / sizeof(K_REQUEST_PSEUDO_HEADERS[0]);
+  for (std::size_t i = 0; i < count; ++i) {
+    if (name == K_REQUEST_PSEUDO_HEADERS[i]) {
+      return i;
+    }
+  }
+  return count;
+}
+
+bool isConnectionHeader(const std::string& name) {
+  const std::size_t count =
+      sizeof(K_CONNECTION_HEADERS) / sizeof(K_CONNECTION_HEADERS[0]);
+  for (std::size_t i = 0; i < count; ++i) {
+    if (name == K_CONNECTION_HEADERS[i]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool parseContentLength(const std::string& value, std::size_t& length) {
+  if (value.empty() || value.size() > K_MAX_CONTENT_LENGTH_DIGITS) {
+    return false;
+  }
+  length = 0;
+  for (std::size_t i = 0; i < value.size(); ++i) {
+    if (value[i] < '0' || value[i] > '9') {
+      return false;
+    }
+    length = length * 10 + static_cast<std::size_t>(value[i] - '0');
+  }
+  return true;
+}
+
+int base64UrlValue(char c) {
+  if (c >= 'A' && c <= 'Z') {
+    return c - 'A';
+  }
+  if (c >= 'a' && c <= 'z') {
+    return c - 'a' + 26;
+  }
+  if (c >= '0' && c <= '9') {
+    return c - '0' + 52;
+  }
+  if (c == '-' || c == '+') {
+    return 62;
+  }
+  if (c == '_' || c == '/') {
+    return 63;
+  }
+  return -1;
+}
+
+// HTTP2-Settings is base64url without padding; padding and the standard
+// alphabet are tolerated since some clients send them anyway.
+bool decodeBase64Url(const std::string& text, std::string& out) {
+  unsigned int buffer = 0;
+  unsigned int bits = 0;
+  for (std::size_t i = 0; i < text.size(); ++i) {
+    if (text[i] == '=') {
+      break;
+    }
+    const int value = base64UrlValue(text[i]);
+    if (value < 0) {
+      return false;
+    }
+    buffer = (buffer << 6) | static_cast<unsigned int>(value);
+    bits += 6;
+    if (bits >= 8) {
+      bits -= 8;
+      out += static_cast<char>((buffer >> bits) & 0xFF);
+      buffer &= (1u << bits) - 1;
+    }
+  }
+  return true;
+}
+
+std::size_t headerListSize(const Http2Session::HeaderList& headers) {
+  std::size_t size = 0;
+  for (Http2Session::HeaderList::const_iterator it = headers.begin();
+       it != headers.end(); ++it) {
+    size += primitives::HpackTable::entrySize(it->first, it->second);
+  }
+  return size;
+}
+
+}  // namespace
+
+const unsigned int Http2Session::K_MAX_CONCURRENT_STREAMS;
+const unsigned long Http2Session::K_RECEIVE_WINDOW;
+const std::size_t Http2Session::K_MAX_HEADER_LIST_SIZE;
+const std::size_t Http2Session::K_OUTPUT_HIGH_WATER;
+const std::size_t Http2Session::K_MAX_IDLE_STREAMS;
+
+Http2Session::Request::Request()
+    : streamId(0), headerBytes(0), oversized(false), headersTooLarge(false) {}
+
+Http2Session::Stream::Stream(unsigned int streamId, long initialSendWindow)
+    : id(streamId),
+      idle(false),
+      remoteClosed(false),
+      localClosed(false),
+      headersSent(false),
+      queued(false),
+      sendWindow(initialSendWindow),
+      receiveWindow(static_cast<long>(K_RECEIVE_WINDOW)),
+      headerBytes(0),
+      oversized(false),
+      headersTooLarge(false),
+      hasExpectedLength(false),
+      expectedLength(0),
+      pendingOffset(0),
+      pendingEnd(false),
+      parent(0),
+      weight(Http2Frame::K_DEFAULT_WEIGHT),
+      pass(0) {}
+
+Http2Session::PrioritySpec::PrioritySpec()
+    : present(false),
+      dependency(0),
+      weight(Http2Frame::K_DEFAULT_WEIGHT),
+      exclusive(false) {}
+
+Http2Session::Http2Session(std::size_t maxRequestSize)
+    : m_maxRequestSize(maxRequestSize),
+      m_idleCount(0),
+      m_lastStreamId(0),
+      m_prefaceMatched(0),
+      m_settingsReceived(false),
+      m_expectingContinuation(false),
+      m_headerStreamId(0),
+      m_headerEndStream(false),
+      m_sendWindow(static_cast<long>(Http2Frame::K_DEFAULT_WINDOW_SIZE)),
+      m_receiveWindow(static_cast<long>(K_RECEIVE_WINDOW)),
+      m_peerInitialWindow(static_cast<long>(Http2Frame::K_DEFAULT_WINDOW_SIZE)),
+      m_peerMaxFrameSize(Http2Frame::K_DEFAULT_MAX_FRAME_SIZE),
+      m_outputOffset(0),
+      m_goAwaySent(false),
+      m_peerGoneAway(false),
+      m_failed(false) {
+  m_hpackDecoder.setMaxHeaderListSize(K_MAX_HEADER_LIST_SIZE);
+}
+
+Http2Session::~Http2Session() {
+  for (StreamMap::iterator it = m_streams.begin(); it != m_streams.end();
+       ++it) {
+    delete it->second;
+  }
+}
+
+// The server preface. The connection window starts at the protocol default
+// whatever the settings say, so it is raised separately.
+void Http2Session::start() {
+  Http2Frame::SettingList settings;
+  settings.push_back(Http2Frame::Setting(
+      Http2Frame::SETTINGS_MAX_CONCURRENT_STREAMS, K_MAX_CONCURRENT_STREAMS));
+  settings.push_back(Http2Frame::Setting(
+      Http2Frame::SETTINGS_INITIAL_WINDOW_SIZE, K_RECEIVE_WINDOW));
+  settings.push_back(Http2Frame::Setting(
+      Http2Frame::SETTINGS_MAX_HEADER_LIST_SIZE, K_MAX_HEADER_LIST_SIZE));
+  Http2Frame::appendSettings(m_output, settings);
+  Http2Frame::appendWindowUpdate(
+      m_output, 0, K_RECEIVE_WINDOW - Http2Frame::K_DEFAULT_WINDOW_SIZE);
+}
+
+// h2c upgrade (RFC 7540 section 3.2): the client's settings arrive in the
+// HTTP2-Settings header and the 101, queued ahead of the server preface,
+// acknowledges them. The upgraded request becomes stream 1, already
+// complete and being served.
+bool Http2Session::startUpgrade(const std::string& settings) {
+  std::string payload;
+  if (!decodeBase64Url(settings, payload) ||
+      payload.size() % Http2Frame::K_SETTING_SIZE != 0) {
+    return false;
+  }
+  try {
+    applySettings(payload.data(), payload.size());
+  } catch (const Http2Exception&) {
+    return false;
+  }
+
+  m_output.append(K_SWITCHING_PROTOCOLS, sizeof(K_SWITCHING_PROTOCOLS) - 1);
+  start();
+  Stream* stream = createStream(1);
+  stream->remoteClosed = true;
+  stream->queued = true;
+  m_lastStreamId = 1;
+  return true;
+}
+
+void Http2Session::receive(const char* data, std::size_t length) {
+  if (m_failed) {
+    return;
+  }
+  try {
+    consumePreface(data, length);
+    m_frames.feed(data, length);
+    Http2Frame frame;
+    while (!m_failed && m_frames.next(frame)) {
+      try {
+        handleFrame(frame);
+      } catch (const Http2Exception& ex) {
+        if (!ex.isStreamError()) {
+          throw;
+        }
+        resetStream(ex.getStreamId(), ex.getCode());
+      }
+    }
+  } catch (const Http2Exception& ex) {
+    failConnection(ex);
+  }
+  fillOutput();
+}
+
+bool Http2Session::nextRequest(Request& request) {
+  while (!m_readyQueue.empty()) {
+    Stream* stream = findStream(m_readyQueue.front());
+    m_readyQueue.pop_front();
+    if (stream == NULL) {
+      continue;
+    }
+    request.streamId = stream->id;
+    request.headers.swap(stream->headers);
+    request.body.swap(stream->body);
+    request.headerBytes = stream->headerBytes;
+    request.oversized = stream->oversized;
+    request.headersTooLarge = stream->headersTooLarge;
+    stream->headers.clear();
+    std::string().swap(stream->body);
+    return true;
+  }
+  return false;
+}
+
+// HEADERS go out at once, ahead of any DATA still queued: they are small
+// and let the client start on the response while bodies are interleaved.
+void Http2Session::submitHeaders(unsigned int streamId,
+                                 const HeaderList& headers, bool endStream) {
+  Stream* stream = findStream(streamId);
+  if (stream == NULL || stream->idle || stream->localClosed ||
+      stream->headersSent || m_failed) {
+    return;
+  }
+  std::string block;
+  m_hpackEncoder.encode(headers, block);
+  compactOutput();
+  Http2Frame::appendHeaders(m_output, streamId, block, endStream,
+                            m_peerMaxFrameSize);
+  stream->headersSent = true;
+  if (endStream) {
+    closeLocal(stream);
+  }
+}
+
+void Http2Session::submitData(unsigned int streamId, const char* data,
+                              std::size_t length, bool endStream) {
+  Stream* stream = findStream(streamId);
+  if (stream == NULL || stream->idle || stream->localClosed ||
+      !stream->headersSent || m_failed) {
+    return;
+  }
+  if (stream->pendingOffset > 0 &&
+      stream->pendingOffset * 2 >= stream->pending.size()) {
+    stream->pending.erase(0, stream->pendingOffset);
+    stream->pendingOffset = 0;
+  }
+  stream->pending.append(data, length);
+  if (endStream) {
+    stream->pendingEnd = true;
+  }
+  fillOutput();
+}
+
+void Http2Session::resetStream(unsigned int streamId,
+                               Http2Exception::ErrorCode code) {
+  if (m_failed) {
+    return;
+  }
+  compactOutput();
+  Http2Frame::appendRstStream(m_output, streamId,
+                              static_cast<unsigned int>(code));
+  Stream* stream = findStream(streamId);
+  if (stream != NULL && !stream->idle) {
+    closeStream(stream);
+  }
+}
+
+// Response bytes accepted for a stream but not yet framed; the caller
+// stops reading from its upstream while this stays high.
+std::size_t Http2Session::getQueuedBytes(unsigned int streamId) const {
+  const Stream* stream = findStream(streamId);
+  if (stream == NULL) {
+    return 0;
+  }
+  return stream->pending.size() - stream->pendingOffset;
+}
+
+bool Http2Session::isStreamOpen(unsigned int streamId) const {
+  const Stream* stream = findStream(streamId);
+  return stream != NULL && !stream->idle && !stream->localClosed;
+}
+
+bool Http2Session::hasOutput() const {
+  return m_outputOffset < m_output.size();
+}
+
+const char* Http2Session::outputData() const {
+  return m_output.data() + m_outputOffset;
+}
+
+std::size_t Http2Session::outputSize() const {
+  return m_output.size() - m_outputOffset;
+}
+
+void Http2Session::consumeOutput(std::size_t length) {
+  m_outputOffset += length;
+  if (m_outputOffset >= m_output.size()) {
+    m_output.clear();
+    m_outputOffset = 0;
+  }
+  fillOutput();
+}
+
+// Graceful: streams already opened are still answered, new ones are not.
+void Http2Session::shutdown() {
+  if (m_goAwaySent || m_failed) {
+    return;
+  }
+  compactOutput();
+  Http2Frame::appendGoAway(m_output, m_lastStreamId,
+                           static_cast<unsigned int>(Http2Exception::NO_ERROR));
+  m_goAwaySent = true;
+}
+
+bool Http2Session::isFinished() const {
+  return m_failed ||
+         ((m_goAwaySent || m_peerGoneAway) && getActiveStreamCount() == 0);
+}
+
+bool Http2Session::hasFailed() const { return m_failed; }
+
+std::size_t Http2Session::getActiveStreamCount() const {
+  return m_streams.size() - m_idleCount;
+}
+
+const std::string& Http2Session::getLastError() const { return m_lastError; }
+
+void Http2Session::consumePreface(const char*& data, std::size_t& length) {
+  while (m_prefaceMatched < Http2Frame::K_CLIENT_PREFACE_SIZE && length > 0) {
+    if (*data != Http2Frame::K_CLIENT_PREFACE[m_prefaceMatched]) {
+      connectionError(Http2Exception::PROTOCOL_ERROR,
+                      "invalid connection preface");
+    }
+    ++m_prefaceMatched;
+    ++data;
+    --length;
+  }
+}
+
+void Http2Session::handleFrame(const Http2Frame& frame) {
+  if (m_expectingContinuation &&
+      (frame.type != Http2Frame::TYPE_CONTINUATION ||
+       frame.streamId != m_headerStreamId)) {
+    connectionError(Http2Exception::PROTOCOL_ERROR,
+                    "header block interrupted");
+  }
+  if (!m_settingsReceived) {
+    if (frame.type != Http2Frame::TYPE_SETTINGS ||
+        frame.hasFlag(Http2Frame::K_FLAG_ACK)) {
+      connectionError(Http2Exception::PROTOCOL_ERROR,
+                      "preface not followed by SETTINGS");
+    }
+    m_settingsReceived = true;
+  }
+
+  switch (frame.type) {
+    case Http2Frame::TYPE_DATA:
+      handleData(frame);
+      break;
+    case Http2Frame::TYPE_HEADERS:
+      handleHeaders(frame);
+      break;
+    case Http2Frame::TYPE_PRIORITY:
+      handlePriority(frame);
+      break;
+    case Http2Frame::TYPE_RST_STREAM:
+      handleRstStream(frame);
+      break;
+    case Http2Frame::TYPE_SETTINGS:
+      handleSettings(frame);
+      break;
+    case Http2Frame::TYPE_PUSH_PROMISE:
+      connectionError(Http2Exception::PROTOCOL_ERROR,
+                      "PUSH_PROMISE from a client");
+      break;
+    case Http2Frame::TYPE_PING:
+      handlePing(frame);
+      break;
+    case Http2Frame::TYPE_GOAWAY:
+      handleGoAway(frame);
+      break;
+    case Http2Frame::TYPE_WINDOW_UPDATE:
+      handleWindowUpdate(frame);
+      break;
+    case Http2Frame::TYPE_CONTINUATION:
+      handleContinuation(frame);
+      break;
+    default:
+      break;
+  }
+}
+
+// The whole frame, padding included, counts against both windows.
+void Http2Session::handleData(const Http2Frame& frame) {
+  if (frame.streamId == 0) {
+    connectionError(Http2Exception::PROTOCOL_ERROR, "DATA on stream 0");
+  }
+  const long frameLength = static_cast<long>(frame.payload.size());
+  if (frameLength > m_receiveWindow) {
+    connectionError(Http2Exception::FLOW_CONTROL_ERROR,
+                    "DATA beyond the connection window");
+  }
+  m_receiveWindow -= frameLength;
+  if (m_receiveWindow <= static_cast<long>(K_RECEIVE_WINDOW / 2)) {
+    Http2Frame::appendWindowUpdate(
+        m_output, 0,
+        K_RECEIVE_WINDOW - static_cast<unsigned long>(m_receiveWindow));
+    m_receiveWindow = static_cast<long>(K_RECEIVE_WINDOW);
+  }
+
+  std::size_t offset = 0;
+  const std::size_t end = stripPadding(frame, offset);
+
+  Stream* stream = findStream(frame.streamId);
+  if (frame.streamId > m_lastStreamId || (stream != NULL && stream->idle)) {
+    connectionError(Http2Exception::PROTOCOL_ERROR, "DATA on an idle stream");
+  }
+  if (stream == NULL || stream->remoteClosed) {
+    streamError(frame.streamId, Http2Exception::STREAM_CLOSED,
+                "DATA after END_STREAM");
+  }
+  if (frameLength > stream->receiveWindow) {
+    streamError(frame.streamId, Http2Exception::FLOW_CONTROL_ERROR,
+                "DATA beyond the stream window");
+  }
+  stream->receiveWindow -= frameLength;
+
+  const std::size_t dataLength = end - offset;
+  if (!stream->oversized) {
+    if (stream->headerBytes + stream->body.size() + dataLength >
+        m_maxRequestSize) {
+      stream->oversized = true;
+      std::string().swap(stream->body);
+    } else {
+      stream->body.append(frame.payload, offset, dataLength);
+    }
+  }
+
+  if (frame.hasFlag(Http2Frame::K_FLAG_END_STREAM)) {
+    stream->remoteClosed = true;
+    completeRequest(stream);
+    return;
+  }
+  if (stream->receiveWindow <= static_cast<long>(K_RECEIVE_WINDOW / 2)) {
+    Http2Frame::appendWindowUpdate(
+        m_output, stream->id,
+        K_RECEIVE_WINDOW - static_cast<unsigned long>(stream->receiveWindow));
+    stream->receiveWindow = static_cast<long>(K_RECEIVE_WINDOW);
+  }
+}
+
+void Http2Session::handleHeaders(const Http2Frame& frame) {
+  if (frame.streamId == 0) {
+    connectionError(Http2Exception::PROTOCOL_ERROR, "HEADERS on stream 0");
+  }
+  std::size_t offset = 0;
+  const std::size_t end = stripPadding(frame, offset);
+
+  m_headerPriority = PrioritySpec();
+  if (frame.hasFlag(Http2Frame::K_FLAG_PRIORITY)) {
+    if (end - offset < Http2Frame::K_PRIORITY_SIZE) {
+      connectionError(Http2Exception::FRAME_SIZE_ERROR,
+                      "HEADERS too short for its priority");
+    }
+    m_headerPriority = readPriority(frame.payload.data() + offset);
+    offset += Http2Frame::K_PRIORITY_SIZE;
+  }
+
+  m_headerStreamId = frame.streamId;
+  m_headerEndStream = frame.hasFlag(Http2Frame::K_FLAG_END_STREAM);
+  m_headerBlock.assign(frame.payload, offset, end - offset);
+  if (frame.hasFlag(Http2Frame::K_FLAG_END_HEADERS)) {
+    finishHeaderBlock();
+  } else {
+    m_expectingContinuation = true;
+  }
+}
+
+void Http2Session::handleContinuation(const Http2Frame& frame) {
+  if (!m_expectingContinuation) {
+    connectionError(Http2Exception::PROTOCOL_ERROR,
+                    "CONTINUATION without HEADERS");
+  }
+  if (m_headerBlock.size() + frame.payload.size() > K_MAX_HEADER_LIST_SIZE) {
+    connectionError(Http2Exception::ENHANCE_YOUR_CALM,
+                    "header block too large");
+  }
+  m_headerBlock.append(frame.payload);
+  if (frame.hasFlag(Http2Frame::K_FLAG_END_HEADERS)) {
+    finishHeaderBlock();
+  }
+}
+
+// Priority may point at streams that are not open yet; those get a
+// placeholder node, up to a small cap (RFC 7540 section 5.3.4).
+void Http2Session::handlePriority(const Http2Frame& frame) {
+  if (frame.streamId == 0) {
+    connectionError(Http2Exception::PROTOCOL_ERROR, "PRIORITY on stream 0");
+  }
+  if (frame.payload.size() != Http2Frame::K_PRIORITY_SIZE) {
+    streamError(frame.streamId, Http2Exception::FRAME_SIZE_ERROR,
+                "PRIORITY of the wrong size");
+  }
+  const PrioritySpec priority = readPriority(frame.payload.data());
+  if (priority.dependency == frame.streamId) {
+    streamError(frame.streamId, Http2Exception::PROTOCOL_ERROR,
+                "stream depends on itself");
+  }
+
+  Stream* stream = findStream(frame.streamId);
+  if (stream == NULL) {
+    if (frame.streamId <= m_lastStreamId ||
+        m_idleCount >= K_MAX_IDLE_STREAMS) {
+      return;
+    }
+    stream = createStream(frame.streamId);
+    stream->idle = true;
+    ++m_idleCount;
+  }
+  setPriority(stream, priority);
+}
+
+void Http2Session::handleRstStream(const Http2Frame& frame) {
+  if (frame.streamId == 0) {
+    connectionError(Http2Exception::PROTOCOL_ERROR, "RST_STREAM on stream 0");
+  }
+  if (frame.payload.size() != Http2Frame::K_RST_STREAM_SIZE) {
+    connectionError(Http2Exception::FRAME_SIZE_ERROR,
+                    "RST_STREAM of the wrong size");
+  }
+  if (frame.streamId > m_lastStreamId) {
+    connectionError(Http2Exception::PROTOCOL_ERROR,
+                    "RST_STREAM on an idle stream");
+  }
+  Stream* stream = findStream(frame.streamId);
+  if (stream != NULL && !stream->idle) {
+    closeStream(stream);
+  }
+}
+
+void Http2Session::handleSettings(const Http2Frame& frame) {
+  if (frame.streamId != 0) {
+    connectionError(Http2Exception::PROTOCOL_ERROR,
+                    "SETTINGS on a stream");
+  }
+  if (frame.hasFlag(Http2Frame::K_FLAG_ACK)) {
+    if (!frame.payload.empty()) {
+      connectionError(Http2Exception::FRAME_SIZE_ERROR,
+                      "SETTINGS acknowledgement with a payload");
+    }
+    return;
+  }
+  if (frame.payload.size() % Http2Frame::K_SETTING_SIZE != 0) {
+    connectionError(Http2Exception::FRAME_SIZE_ERROR,
+                    "SETTINGS of the wrong size");
+  }
+  applySettings(frame.payload.data(), frame.payload.size());
+  Http2Frame::appendSettingsAck(m_output);
+}
+
+void Http2Session::handlePing(const Http2Frame& frame) {
+  if (frame.streamId != 0) {
+    connectionError(Http2Exception::PROTOCOL_ERROR, "PING on a stream");
+  }
+  if (frame.payload.size() != Http2Frame::K_PING_SIZE) {
+    connectionError(Http2Exception::FRAME_SIZE_ERROR,
+                    "PING of the wrong size");
+  }
+  if (!frame.hasFlag(Http2Frame::K_FLAG_ACK)) {
+    Http2Frame::appendPing(m_output, frame.payload.data(), true);
+  }
+}
+
+void Http2Session::handleGoAway(const Http2Frame& frame) {
+  if (frame.streamId != 0) {
+    connectionError(Http2Exception::PROTOCOL_ERROR, "GOAWAY on a stream");
+  }
+  if (frame.payload.size() < Http2Frame::K_GOAWAY_MIN_SIZE) {
+    connectionError(Http2Exception::FRAME_SIZE_ERROR, "GOAWAY too short");
+  }
+  m_peerGoneAway = true;
+}
+
+void Http2Session::handleWindowUpdate(const Http2Frame& frame) {
+  if (frame.payload.size() != Http2Frame::K_WINDOW_UPDATE_SIZE) {
+    connectionError(Http2Exception::FRAME_SIZE_ERROR,
+                    "WINDOW_UPDATE of the wrong size");
+  }
+  const long increment = static_cast<long>(
+      Http2Frame::readUint32(frame.payload.data()) &
+      Http2Frame::K_MAX_WINDOW_SIZE);
+  const long limit = static_cast<long>(Http2Frame::K_MAX_WINDOW_SIZE);
+
+  if (frame.streamId == 0) {
+    if (increment == 0) {
+      connectionError(Http2Exception::PROTOCOL_ERROR,
+                      "zero WINDOW_UPDATE increment");
+    }
+    if (m_sendWindow > limit - increment) {
+      connectionError(Http2Exception::FLOW_CONTROL_ERROR,
+                      "connection window overflow");
+    }
+    m_sendWindow += increment;
+    return;
+  }
+
+  Stream* stream = findStream(frame.streamId);
+  if (frame.streamId > m_lastStreamId &&
+      (stream == NULL || stream->idle)) {
+    connectionError(Http2Exception::PROTOCOL_ERROR,
+                    "WINDOW_UPDATE on an idle stream");
+  }
+  if (stream == NULL || stream->idle) {
+    return;
+  }
+  if (increment == 0) {
+    streamError(frame.streamId, Http2Exception::PROTOCOL_ERROR,
+                "zero WINDOW_UPDATE increment");
+  }
+  if (stream->sendWindow > limit - increment) {
+    streamError(frame.streamId, Http2Exception::FLOW_CONTROL_ERROR,
+                "stream window overflow");
+  }
+  stream->sendWindow += increment;
+}
+
+// The block is decoded before anything else is decided, even for a stream
+// that is about to be refused: skipping it would leave the dynamic table
+// out of step with the client's.
+void Http2Session::finishHeaderBlock() {
+  m_expectingContinuation = false;
+  HeaderList headers;
+  const bool fits = m_hpackDecoder.decode(m_headerBlock.data(),
+                                          m_headerBlock.size(), headers);
+  std::string().swap(m_headerBlock);
+
+  const unsigned int streamId = m_headerStreamId;
+  Stream* stream = findStream(streamId);
+  if (stream != NULL && !stream->idle) {
+    receiveTrailers(stream, headers);
+    return;
+  }
+  if (streamId <= m_lastStreamId) {
+    connectionError(Http2Exception::STREAM_CLOSED,
+                    "HEADERS on a closed stream");
+  }
+  if (streamId % 2 == 0) {
+    connectionError(Http2Exception::PROTOCOL_ERROR,
+                    "client opened an even stream");
+  }
+  m_lastStreamId = streamId;
+  if (m_goAwaySent) {
+    return;
+  }
+  if (getActiveStreamCount() >= K_MAX_CONCURRENT_STREAMS) {
+    streamError(streamId, Http2Exception::REFUSED_STREAM,
+                "too many concurrent streams");
+  }
+  if (m_headerPriority.present && m_headerPriority.dependency == streamId) {
+    streamError(streamId, Http2Exception::PROTOCOL_ERROR,
+                "stream depends on itself");
+  }
+
+  if (stream == NULL) {
+    stream = createStream(streamId);
+  } else {
+    stream->idle = false;
+    stream->sendWindow = m_peerInitialWindow;
+    --m_idleCount;
+  }
+  if (m_headerPriority.present) {
+    setPriority(stream, m_headerPriority);
+  }
+  stream->remoteClosed = m_headerEndStream;
+  stream->headerBytes = headerListSize(headers);
+  if (!fits) {
+    stream->headersTooLarge = true;
+  } else if (!validateRequest(headers, *stream)) {
+    streamError(streamId, Http2Exception::PROTOCOL_ERROR,
+                "malformed request headers");
+  }
+  stream->headers.swap(headers);
+  if (stream->headerBytes > m_maxRequestSize) {
+    stream->oversized = true;
+  }
+  if (stream->remoteClosed) {
+    completeRequest(stream);
+  }
+}
+
+// Trailers end the request; there is nowhere to pass them on, so they are
+// only checked.
+void Http2Session::receiveTrailers(Stream* stream,
+                                   const HeaderList& trailers) {
+  if (stream->remoteClosed) {
+    streamError(stream->id, Http2Exception::STREAM_CLOSED,
+                "HEADERS after END_STREAM");
+  }
+  if (!m_headerEndStream) {
+    streamError(stream->id, Http2Exception::PROTOCOL_ERROR,
+                "trailers without END_STREAM");
+  }
+  for (HeaderList::const_iterator it = trailers.begin(); it != trailers.end();
+       ++it) {
+    if (!it->first.empty() && it->first[0] == ':') {
+      streamError(stream->id, Http2Exception::PROTOCOL_ERROR,
+                  "pseudo-header in trailers");
+    }
+  }
+  stream->remoteClosed = true;
+  completeRequest(stream);
+}
+
+void Http2Session::completeRequest(Stream* stream) {
+  if (stream->localClosed) {
+    closeStream(stream);
+    return;
+  }
+  if (stream->queued) {
+    return;
+  }
+  if (stream->hasExpectedLength && !stream->oversized &&
+      stream->body.size() != stream->expectedLength) {
+    streamError(stream->id, Http2Exception::PROTOCOL_ERROR,
+                "body does not match content-length");
+  }
+  stream->queued = true;
+  m_readyQueue.push_back(stream->id);
+}
+
+void Http2Session::applySettings(const char* data, std::size_t length) {
+  for (std::size_t offset = 0; offset + Http2Frame::K_SETTING_SIZE <= length;
+       offset += Http2Frame::K_SETTING_SIZE) {
+    const unsigned int id =
+        (static_cast<unsigned int>(static_cast<unsigned char>(data[offset]))
+         << 8) |
+        static_cast<unsigned char>(data[offset + 1]);
+    const unsigned long value = Http2Frame::readUint32(data + offset + 2);
+
+    switch (id) {
+      case Http2Frame::SETTINGS_HEADER_TABLE_SIZE:
+        m_hpackEncoder.setMaxTableSize(value);
+        break;
+      case Http2Frame::SETTINGS_ENABLE_PUSH:
+        if (value > 1) {
+          connectionError(Http2Exception::PROTOCOL_ERROR,
+                          "invalid SETTINGS_ENABLE_PUSH");
+        }
+        break;
+      case Http2Frame::SETTINGS_INITIAL_WINDOW_SIZE: {
+        if (value > Http2Frame::K_MAX_WINDOW_SIZE) {
+          connectionError(Http2Exception::FLOW_CONTROL_ERROR,
+                          "invalid SETTINGS_INITIAL_WINDOW_SIZE");
+        }
+        const long delta = static_cast<long>(value) - m_peerInitialWindow;
+        const long limit = static_cast<long>(Http2Frame::K_MAX_WINDOW_SIZE);
+        for (StreamMap::iterator it = m_streams.begin();
+             it != m_streams.end(); ++it) {
+          if (delta > 0 && it->second->sendWindow > limit - delta) {
+            connectionError(Http2Exception::FLOW_CONTROL_ERROR,
+                            "stream window overflow");
+          }
+          it->second->sendWindow += delta;
+        }
+        m_peerInitialWindow = static_cast<long>(value);
+        break;
+      }
+      case Http2Frame::SETTINGS_MAX_FRAME_SIZE:
+        if (value < Http2Frame::K_DEFAULT_MAX_FRAME_SIZE ||
+            value > Http2Frame::K_MAX_FRAME_SIZE_LIMIT) {
+          connectionError(Http2Exception::PROTOCOL_ERROR,
+                          "invalid SETTINGS_MAX_FRAME_SIZE");
+        }
+        m_peerMaxFrameSize = static_cast<std::size_t>(value);
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+void Http2Session::failConnection(const Http2Exception& error) {
+  m_lastError = error.what();
+  Http2Frame::appendGoAway(m_output, m_lastStreamId,
+                           static_cast<unsigned int>(error.getCode()));
+  m_goAwaySent = true;
+  m_failed = true;
+}
+
+Http2Session::Stream* Http2Session::findStream(unsigned int streamId) const {
+  StreamMap::const_iterator it = m_streams.find(streamId);
+  return it == m_streams.end() ? NULL : it->second;
+}
+
+Http2Session::Stream* Http2Session::createStream(unsigned int streamId) {
+  Stream* stream = new Stream(streamId, m_peerInitialWindow);
+  m_streams[streamId] = stream;
+  attach(stream, 0, false);
+  return stream;
+}
+
+void Http2Session::closeLocal(Stream* stream) {
+  stream->localClosed = true;
+  std::string().swap(stream->pending);
+  stream->pendingOffset = 0;
+  if (stream->remoteClosed) {
+    closeStream(stream);
+  }
+}
+
+// A closed stream's dependents move up to its parent (RFC 7540 section
+// 5.3.4), keeping their weights.
+void Http2Session::closeStream(Stream* stream) {
+  detach(stream);
+  std::vector<unsigned int>& siblings = childrenOf(stream->parent);
+  for (std::size_t i = 0; i < stream->children.size(); ++i) {
+    Stream* child = findStream(stream->children[i]);
+    child->parent = stream->parent;
+    siblings.push_back(child->id);
+  }
+  if (stream->idle) {
+    --m_idleCount;
+  }
+  m_streams.erase(stream->id);
+  delete stream;
+}
+
+std::vector<unsigned int>& Http2Session::childrenOf(unsigned int streamId) {
+  if (streamId == 0) {
+    return m_rootChildren;
+  }
+  return m_streams[streamId]->children;
+}
+
+// A stream joining a parent starts level with the siblings that have sent
+// least, so it neither bursts ahead nor waits for them to catch up.
+void Http2Session::attach(Stream* stream, unsigned int parentId,
+                          bool exclusive) {
+  std::vector<unsigned int>& siblings = childrenOf(parentId);
+  stream->pass = 0;
+  for (std::size_t i = 0; i < siblings.size(); ++i) {
+    const unsigned long pass = findStream(siblings[i])->pass;
+    if (i == 0 || pass < stream->pass) {
+      stream->pass = pass;
+    }
+  }
+  if (exclusive) {
+    for (std::size_t i = 0; i < siblings.size(); ++i) {
+      findStream(siblings[i])->parent = stream->id;
+      stream->children.push_back(siblings[i]);
+    }
+    siblings.clear();
+  }
+  siblings.push_back(stream->id);
+  stream->parent = parentId;
+}
+
+void Http2Session::detach(Stream* stream) {
+  std::vector<unsigned int>& siblings = childrenOf(stream->parent);
+  for (std::size_t i = 0; i < siblings.size(); ++i) {
+    if (siblings[i] == stream->id) {
+      siblings.erase(siblings.begin() + static_cast<long>(i));
+      break;
+    }
+  }
+}
+
+bool Http2Session::dependsOn(unsigned int streamId,
+                             unsigned int ancestorId) const {
+  const Stream* stream = findStream(streamId);
+  while (stream != NULL && stream->parent != 0) {
+    if (stream->parent == ancestorId) {
+      return true;
+    }
+    stream = findStream(stream->parent);
+  }
+  return false;
+}
+
+// A dependency on a stream outside the tree falls back to the default
+// priority; one on the stream's own descendant first moves that descendant
+// up to take the stream's place (RFC 7540 section 5.3.3).
+void Http2Session::setPriority(Stream* stream, const PrioritySpec& priority) {
+  unsigned int dependency = priority.dependency;
+  unsigned int weight = priority.weight;
+  bool exclusive = priority.exclusive;
+  if (dependency != 0 && findStream(dependency) == NULL) {
+    dependency = 0;
+    weight = Http2Frame::K_DEFAULT_WEIGHT;
+    exclusive = false;
+  }
+  if (dependency != 0 && dependsOn(dependency, stream->id)) {
+    Stream* descendant = findStream(dependency);
+    detach(descendant);
+    attach(descendant, stream->parent, false);
+  }
+  detach(stream);
+  stream->weight = weight;
+  attach(stream, dependency, exclusive);
+}
+
+void Http2Session::fillOutput() {
+  if (m_failed) {
+    return;
+  }
+  compactOutput();
+  while (outputSize() < K_OUTPUT_HIGH_WATER) {
+    Stream* stream = pickStream(0);
+    if (stream == NULL) {
+      return;
+    }
+    const std::size_t queued = stream->pending.size() - stream->pendingOffset;
+    std::size_t chunk = queued < m_peerMaxFrameSize ? queued
+                                                    : m_peerMaxFrameSize;
+    if (static_cast<long>(chunk) > stream->sendWindow) {
+      chunk = static_cast<std::size_t>(stream->sendWindow);
+    }
+    if (static_cast<long>(chunk) > m_sendWindow) {
+      chunk = static_cast<std::size_t>(m_sendWindow);
+    }
+    const bool endStream = stream->pendingEnd && chunk == queued;
+    Http2Frame::appendData(m_output, stream->id,
+                           stream->pending.data() + stream->pendingOffset,
+                           chunk, endStream);
+    stream->pendingOffset += chunk;
+    stream->sendWindow -= static_cast<long>(chunk);
+    m_sendWindow -= static_cast<long>(chunk);
+    charge(stream, chunk);
+    if (endStream) {
+      closeLocal(stream);
+    } else if (stream->pendingOffset == stream->pending.size()) {
+      stream->pending.clear();
+      stream->pendingOffset = 0;
+    }
+  }
+}
+
+// A stream only gets bandwidth its ancestors cannot use; among siblings the
+// one that has sent least relative to its weight goes next.
+Http2Session::Stream* Http2Session::pickStream(unsigned int parentId) {
+  const std::vector<unsigned int>& children = childrenOf(parentId);
+  Stream* bestChild = NULL;
+  Stream* bestSender = NULL;
+  for (std::size_t i = 0; i < children.size(); ++i) {
+    Stream* child = findStream(children[i]);
+    Stream* sender = isSendable(*child) ? child : pickStream(child->id);
+    if (sender == NULL) {
+      continue;
+    }
+    if (bestChild == NULL || child->pass < bestChild->pass) {
+      bestChild = child;
+      bestSender = sender;
+    }
+  }
+  return bestSender;
+}
+
+bool Http2Session::isSendable(const Stream& stream) const {
+  if (stream.idle || stream.localClosed || !stream.headersSent) {
+    return false;
+  }
+  if (stream.pendingOffset == stream.pending.size()) {
+    return stream.pendingEnd;
+  }
+  return stream.sendWindow > 0 && m_sendWindow > 0;
+}
+
+// Every node from the sender up to the root advances by the bytes sent
+// scaled down by its weight.
+void Http2Session::charge(Stream* stream, std::size_t bytes) {
+  const unsigned long cost = (bytes + Http2Frame::K_HEADER_SIZE) *
+                             K_STRIDE_SCALE;
+  while (stream != NULL) {
+    stream->pass += cost / stream->weight;
+    stream = findStream(stream->parent);
+  }
+}
+
+void Http2Session::compactOutput() {
+  if (m_outputOffset < K_OUTPUT_COMPACT_THRESHOLD) {
+    return;
+  }
+  m_output.erase(0, m_outputOffset);
+  m_outputOffset = 0;
+}
+
+// RFC 7540 section 8.1.2: lowercase names, pseudo-headers first and only
+// the request ones, no connection-specific fields. Cookie crumbs are put
+// back together into one field for the HTTP/1.1 side.
+bool Http2Session::validateRequest(HeaderList& headers, Stream& stream) {
+  const std::size_t pseudoCount =
+      sizeof(K_REQUEST_PSEUDO_HEADERS) / sizeof(K_REQUEST_PSEUDO_HEADERS[0]);
+  std::vector<bool> seen(pseudoCount, false);
+  bool regularSeen = false;
+  bool isConnect = false;
+  std::string cookie;
+  HeaderList normalized;
+  normalized.reserve(headers.size());
+
+  for (HeaderList::const_iterator it = headers.begin(); it != headers.end();
+       ++it) {
+    const std::string& name = it->first;
+    if (name.empty()) {
+      return false;
+    }
+    for (std::size_t i = 0; i < name.size(); ++i) {
+      if (name[i] >= 'A' && name[i] <= 'Z') {
+        return false;
+      }
+    }
+
+    if (name[0] == ':') {
+      const std::size_t index = pseudoHeaderIndex(name);
+      if (regularSeen || index == pseudoCount || seen[index]) {
+        return false;
+      }
+      seen[index] = true;
+      if (index == K_PSEUDO_METHOD) {
+        isConnect = it->second == "CONNECT";
+      } else if (index == K_PSEUDO_PATH && it->second.empty()) {
+        return false;
+      }
+      normalized.push_back(*it);
+      continue;
+    }
+
+    regularSeen = true;
+    if (isConnectionHeader(name) ||
+        (name == "te" && it->second != "trailers")) {
+      return false;
+    }
+    if (name == "cookie") {
+      if (!cookie.empty()) {
+        cookie += "; ";
+      }
+      cookie += it->second;
+      continue;
+    }
+    if (name == "content-length") {
+      if (!parseContentLength(it->second, stream.expectedLength)) {
+        return false;
+      }
+      stream.hasExpectedLength = true;
+    }
+    normalized.push_back(*it);
+  }
+
+  if (!seen[K_PSEUDO_METHOD]) {
+    return false;
+  }
+  if (isConnect ? (seen[K_PSEUDO_SCHEME] || seen[K_PSEUDO_PATH])
+                : (!seen[K_PSEUDO_SCHEME] || !seen[K_PSEUDO_PATH])) {
+    return false;
+  }
+  if (!cookie.empty()) {
+    normalized.push_back(Field("cookie", cookie));
+  }
+  headers.swap(normalized);
+  return true;
+}
+
+// Returns where the frame's data ends; offset is moved past the pad length.
+std::size_t Http2Session::stripPadding(const Http2Frame& frame,
+                                       std::size_t& offset) {
+  if (!frame.hasFlag(Http2Frame::K_FLAG_PADDED)) {
+    return frame.payload.size();
+  }
+  if (frame.payload.empty()) {
+    connectionError(Http2Exception::PROTOCOL_ERROR, "missing pad length");
+  }
+  const std::size_t padding = static_cast<unsigned char>(frame.payload[0]);
+  if (padding >= frame.payload.size()) {
+    connectionError(Http2Exception::PROTOCOL_ERROR,
+                    "padding longer than the frame");
+  }
+  offset = 1;
+  return frame.payload.size() - padding;
+}
+
+Http2Session::PrioritySpec Http2Session::readPriority(const char* data) {
+  const unsigned long dependency = Http2Frame::readUint32(data);
+  PrioritySpec priority;
+  priority.present = true;
+  priority.exclusive = (dependency & K_EXCLUSIVE_BIT) != 0;
+  priority.dependency =
+      static_cast<unsigned int>(dependency & Http2Frame::K_STREAM_ID_MASK);
+  priority.weight = static_cast<unsigned int>(
+                        static_cast<unsigned char>(data[4])) + 1;
+  return priority;
+}
+
+}  // namespace adapters
+}  // namespace http2
+}  // namespace infrastructure
@@ -0,0 +1,207 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Http2Session.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 12:07:51 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 12:07:51 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef HTTP2_SESSION_HPP
+#define HTTP2_SESSION_HPP
+
+#include "infrastructure/http2/exceptions/Http2Exception.hpp"
+#include "infrastructure/http2/primitives/HpackDecoder.hpp"
+#include "infrastructure/http2/primitives/HpackEncoder.hpp"
+#include "infrastructure/http2/primitives/Http2Frame.hpp"
+#include "infrastructure/http2/primitives/Http2FrameDecoder.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace infrastructure {
+namespace http2 {
+namespace adapters {
+
+// The server side of one HTTP/2 connection, with no I/O of its own: bytes
+// read from the socket go in through receive(), frames to send come out of
+// the output buffer. Complete requests are handed out one at a time in the
+// order they finished arriving; the responses submitted for them are
+// interleaved on the wire by stream priority and flow control, so a slow
+// or large response does not hold up the ones behind it.
+class Http2Session {
+ public:
+  typedef primitives::HpackDecoder::Field Field;
+  typedef primitives::HpackDecoder::HeaderList HeaderList;
+
+  struct Request {
+    unsigned int streamId;
+    HeaderList headers;
+    std::string body;
+    std::size_t headerBytes;
+    bool oversized;
+    bool headersTooLarge;
+
+    Request();
+  };
+
+  static const unsigned int K_MAX_CONCURRENT_STREAMS = 128;
+  static const unsigned long K_RECEIVE_WINDOW = 1048576;
+  static const std::size_t K_MAX_HEADER_LIST_SIZE = 65536;
+  static const std::size_t K_OUTPUT_HIGH_WATER = 65536;
+  static const std::size_t K_MAX_IDLE_STREAMS = 32;
+
+  explicit Http2Session(std::size_t maxRequestSize);
+  ~Http2Session();
+
+  void start();
+  bool startUpgrade(const std::string& settings);
+  void receive(const char* data, std::size_t length);
+
+  bool nextRequest(Request& request);
+  void submitHeaders(unsigned int streamId, const HeaderList& headers,
+                     bool endStream);
+  void submitData(unsigned int streamId, const char* data,
+                  std::size_t length, bool endStream);
+  void resetStream(unsigned int streamId,
+                   exceptions::Http2Exception::ErrorCode code);
+  std::size_t getQueuedBytes(unsigned int streamId) const;
+  bool isStreamOpen(unsigned int streamId) const;
+
+  bool hasOutput() const;
+  const char* outputData() const;
+  std::size_t outputSize() const;
+  void consumeOutput(std::size_t length);
+
+  void shutdown();
+  bool isFinished() const;
+  bool hasFailed() const;
+  std::size_t getActiveStreamCount() const;
+  const std::string& getLastError() const;
+
+ private:
+  struct Stream {
+    unsigned int id;
+    bool idle;
+    bool remoteClosed;
+    bool localClosed;
+    bool headersSent;
+    bool queued;
+    long sendWindow;
+    long receiveWindow;
+    HeaderList headers;
+    std::string body;
+    std::size_t headerBytes;
+    bool oversized;
+    bool headersTooLarge;
+    bool hasExpectedLength;
+    std::size_t expectedLength;
+    std::string pending;
+    std::size_t pendingOffset;
+    bool pendingEnd;
+    unsigned int parent;
+    unsigned int weight;
+    unsigned long pass;
+    std::vector<unsigned int> children;
+
+    Stream(unsigned int streamId, long initialSendWindow);
+  };
+
+  struct PrioritySpec {
+    bool present;
+    unsigned int dependency;
+    unsigned int weight;
+    bool exclusive;
+
+    PrioritySpec();
+  };
+
+  typedef std::map<unsigned int, Stream*> StreamMap;
+
+  Http2Session(const Http2Session&);
+  Http2Session& operator=(const Http2Session&);
+
+  std::size_t m_maxRequestSize;
+  primitives::Http2FrameDecoder m_frames;
+  primitives::HpackDecoder m_hpackDecoder;
+  primitives::HpackEncoder m_hpackEncoder;
+
+  StreamMap m_streams;
+  std::vector<unsigned int> m_rootChildren;
+  std::deque<unsigned int> m_readyQueue;
+  std::size_t m_idleCount;
+  unsigned int m_lastStreamId;
+
+  std::size_t m_prefaceMatched;
+  bool m_settingsReceived;
+  bool m_expectingContinuation;
+  unsigned int m_headerStreamId;
+  bool m_headerEndStream;
+  PrioritySpec m_headerPriority;
+  std::string m_headerBlock;
+
+  long m_sendWindow;
+  long m_receiveWindow;
+  long m_peerInitialWindow;
+  std::size_t m_peerMaxFrameSize;
+
+  std::string m_output;
+  std::size_t m_outputOffset;
+
+  bool m_goAwaySent;
+  bool m_peerGoneAway;
+  bool m_failed;
+  std::string m_lastError;
+
+  void consumePreface(const char*& data, std::size_t& length);
+  void handleFrame(const primitives::Http2Frame& frame);
+  void handleData(const primitives::Http2Frame& frame);
+  void handleHeaders(const primitives::Http2Frame& frame);
+  void handleContinuation(const primitives::Http2Frame& frame);
+  void handlePriority(const primitives::Http2Frame& frame);
+  void handleRstStream(const primitives::Http2Frame& frame);
+  void handleSettings(const primitives::Http2Frame& frame);
+  void handlePing(const primitives::Http2Frame& frame);
+  void handleGoAway(const primitives::Http2Frame& frame);
+  void handleWindowUpdate(const primitives::Http2Frame& frame);
+
+  void finishHeaderBlock();
+  void receiveTrailers(Stream* stream, const HeaderList& trailers);
+  void completeRequest(Stream* stream);
+  void applySettings(const char* data, std::size_t length);
+  void failConnection(const exceptions::Http2Exception& error);
+
+  Stream* findStream(unsigned int streamId) const;
+  Stream* createStream(unsigned int streamId);
+  void closeLocal(Stream* stream);
+  void closeStream(Stream* stream);
+
+  std::vector<unsigned int>& childrenOf(unsigned int streamId);
+  void attach(Stream* stream, unsigned int parentId, bool exclusive);
+  void detach(Stream* stream);
+  bool dependsOn(unsigned int streamId, unsigned int ancestorId) const;
+  void setPriority(Stream* stream, const PrioritySpec& priority);
+
+  void fillOutput();
+  Stream* pickStream(unsigned int parentId);
+  bool isSendable(const Stream& stream) const;
+  void charge(Stream* stream, std::size_t bytes);
+  void compactOutput();
+
+  static bool validateRequest(HeaderList& headers, Stream& stream);
+  static std::size_t stripPadding(const primitives::Http2Frame& frame,
+                                  std::size_t& offset);
+  static PrioritySpec readPriority(const char* data);
+};
+
+}  // namespace adapters
+}  // namespace http2
+}  // namespace infrastructure
+
+#endif  // HTTP2_SESSION_HPP
@@ -0,0 +1,120 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Http2Exception.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:41:07 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:41:07 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/http2/exceptions/Http2Exception.hpp"
+
+#include <sstream>
+
+namespace infrastructure {
+namespace http2 {
+namespace exceptions {
+
+namespace {
+
+const char* const K_CODE_NAMES[Http2Exception::CODE_COUNT] = {
+    "NO_ERROR",
+    "PROTOCOL_ERROR",
+    "INTERNAL_ERROR",
+    "FLOW_CONTROL_ERROR",
+    "SETTINGS_TIMEOUT",
+    "STREAM_CLOSED",
+    "FRAME_SIZE_ERROR",
+    "REFUSED_STREAM",
+    "CANCEL",
+    "COMPRESSION_ERROR",
+    "CONNECT_ERROR",
+    "ENHANCE_YOUR_CALM",
+    "INADEQUATE_SECURITY",
+    "HTTP_1_1_REQUIRED"};
+
+}  // namespace
+
+const std::pair<Http2Exception::ErrorCode, std::string>
+    Http2Exception::K_CODE_MSGS[] = {
+        std::make_pair(Http2Exception::NO_ERROR, "HTTP/2 graceful shutdown"),
+        std::make_pair(Http2Exception::PROTOCOL_ERROR,
+                       "HTTP/2 protocol error"),
+        std::make_pair(Http2Exception::INTERNAL_ERROR,
+                       "HTTP/2 internal error"),
+        std::make_pair(Http2Exception::FLOW_CONTROL_ERROR,
+                       "HTTP/2 flow control violated"),
+        std::make_pair(Http2Exception::SETTINGS_TIMEOUT,
+                       "HTTP/2 settings not acknowledged"),
+        std::make_pair(Http2Exception::STREAM_CLOSED,
+                       "HTTP/2 frame on a closed stream"),
+        std::make_pair(Http2Exception::FRAME_SIZE_ERROR,
+                       "HTTP/2 frame size invalid"),
+        std::make_pair(Http2Exception::REFUSED_STREAM,
+                       "HTTP/2 stream refused"),
+        std::make_pair(Http2Exception::CANCEL, "HTTP/2 stream cancelled"),
+        std::make_pair(Http2Exception::COMPRESSION_ERROR,
+                       "HTTP/2 header compression failed"),
+        std::make_pair(Http2Exception::CONNECT_ERROR,
+                       "HTTP/2 CONNECT tunnel failed"),
+        std::make_pair(Http2Exception::ENHANCE_YOUR_CALM,
+                       "HTTP/2 peer is misbehaving"),
+        std::make_pair(Http2Exception::INADEQUATE_SECURITY,
+                       "HTTP/2 transport security inadequate"),
+        std::make_pair(Http2Exception::HTTP_1_1_REQUIRED,
+                       "HTTP/2 peer requires HTTP/1.1")};
+
+Http2Exception::Http2Exception(const std::string& message, ErrorCode code,
+                               unsigned int streamId)
+    : BaseException("", static_cast<int>(code)),
+      m_code(code),
+      m_streamId(streamId) {
+  std::ostringstream oss;
+  oss << getErrorMsg(code) << ": " << message;
+  this->m_whatMsg = oss.str();
+}
+
+Http2Exception::Http2Exception(const Http2Exception& other)
+    : BaseException(other),
+      m_code(other.m_code),
+      m_streamId(other.m_streamId) {}
+
+Http2Exception::~Http2Exception() throw() {}
+
+Http2Exception& Http2Exception::operator=(const Http2Exception& other) {
+  if (this != &other) {
+    BaseException::operator=(other);
+    m_code = other.m_code;
+    m_streamId = other.m_streamId;
+  }
+  return *this;
+}
+
+Http2Exception::ErrorCode Http2Exception::getCode() const { return m_code; }
+
+unsigned int Http2Exception::getStreamId() const { return m_streamId; }
+
+bool Http2Exception::isStreamError() const { return m_streamId != 0; }
+
+const char* Http2Exception::codeName(ErrorCode code) {
+  if (static_cast<unsigned int>(code) >= CODE_COUNT) {
+    return "UNKNOWN_ERROR";
+  }
+  return K_CODE_NAMES[code];
+}
+
+std::string Http2Exception::getErrorMsg(ErrorCode code) {
+  for (int i = 0; i < CODE_COUNT; ++i) {
+    if (K_CODE_MSGS[i].first == code) {
+      return K_CODE_MSGS[i].second;
+    }
+  }
+  return "unknown http2 error";
+}
+
+}  // namespace exceptions
+}  // namespace http2
+}  // namespace infrastructure
@@ -0,0 +1,71 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Http2Exception.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:41:07 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:41:07 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef HTTP2_EXCEPTION_HPP
+#define HTTP2_EXCEPTION_HPP
+
+#include "shared/exceptions/BaseException.hpp"
+
+namespace infrastructure {
+namespace http2 {
+namespace exceptions {
+
+// A protocol violation found while reading a peer's frames. The codes are
+// the HTTP/2 error codes in wire order, so getCode() goes straight into a
+// RST_STREAM or GOAWAY frame. A stream id of 0 makes it a connection error.
+class Http2Exception : public ::shared::exceptions::BaseException {
+ public:
+  enum ErrorCode {
+    NO_ERROR,
+    PROTOCOL_ERROR,
+    INTERNAL_ERROR,
+    FLOW_CONTROL_ERROR,
+    SETTINGS_TIMEOUT,
+    STREAM_CLOSED,
+    FRAME_SIZE_ERROR,
+    REFUSED_STREAM,
+    CANCEL,
+    COMPRESSION_ERROR,
+    CONNECT_ERROR,
+    ENHANCE_YOUR_CALM,
+    INADEQUATE_SECURITY,
+    HTTP_1_1_REQUIRED,
+    CODE_COUNT
+  };
+
+  Http2Exception(const std::string& message, ErrorCode code,
+                 unsigned int streamId);
+  Http2Exception(const Http2Exception& other);
+  virtual ~Http2Exception() throw();
+
+  Http2Exception& operator=(const Http2Exception& other);
+
+  ErrorCode getCode() const;
+  unsigned int getStreamId() const;
+  bool isStreamError() const;
+
+  static const char* codeName(ErrorCode code);
+
+ private:
+  ErrorCode m_code;
+  unsigned int m_streamId;
+
+  static const std::pair<ErrorCode, std::string> K_CODE_MSGS[];
+
+  static std::string getErrorMsg(ErrorCode code);
+};
+
+}  // namespace exceptions
+}  // namespace http2
+}  // namespace infrastructure
+
+#endif  // HTTP2_EXCEPTION_HPP
@@ -0,0 +1,189 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HpackDecoder.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:58:02 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:58:02 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/http2/exceptions/Http2Exception.hpp"
+#include "infrastructure/http2/primitives/HpackDecoder.hpp"
+#include "infrastructure/http2/primitives/HpackHuffman.hpp"
+
+namespace infrastructure {
+namespace http2 {
+namespace primitives {
+
+namespace {
+
+const unsigned char K_INDEXED = 0x80;
+const unsigned char K_LITERAL_INDEXED = 0x40;
+const unsigned char K_SIZE_UPDATE = 0x20;
+const unsigned char K_HUFFMAN = 0x80;
+const unsigned char K_CONTINUE = 0x80;
+const unsigned char K_PAYLOAD_MASK = 0x7F;
+const unsigned int K_INDEXED_PREFIX = 7;
+const unsigned int K_LITERAL_INDEXED_PREFIX = 6;
+const unsigned int K_SIZE_UPDATE_PREFIX = 5;
+const unsigned int K_LITERAL_PREFIX = 4;
+const unsigned int K_STRING_PREFIX = 7;
+const unsigned int K_CONTINUATION_BITS = 7;
+
+// Four continuation bytes already reach 2^28, far past any length or index
+// a sane peer sends; anything longer is treated as malformed.
+const unsigned int K_MAX_INTEGER_SHIFT = 21;
+
+}  // namespace
+
+HpackDecoder::HpackDecoder()
+    : m_maxTableSize(HpackTable::K_DEFAULT_MAX_SIZE), m_maxHeaderListSize(0) {}
+
+HpackDecoder::~HpackDecoder() {}
+
+// Returns false when the decoded list outgrew the header list limit. The
+// block is still decoded to the end so the dynamic table stays in step with
+// the peer's; the fields past the limit are dropped.
+bool HpackDecoder::decode(const char* data, std::size_t length,
+                          HeaderList& headers) {
+  std::size_t offset = 0;
+  std::size_t listSize = 0;
+  bool fieldSeen = false;
+  bool fits = true;
+
+  while (offset < length) {
+    const unsigned char first = static_cast<unsigned char>(data[offset]);
+    Field field;
+
+    if ((first & K_INDEXED) != 0) {
+      std::size_t index = 0;
+      if (!decodeInteger(data, length, offset, K_INDEXED_PREFIX, index)) {
+        fail("truncated index");
+      }
+      if (!m_table.get(index, field)) {
+        fail("index out of range");
+      }
+    } else if ((first & K_LITERAL_INDEXED) != 0) {
+      readLiteral(data, length, offset, K_LITERAL_INDEXED_PREFIX, field);
+      m_table.insert(field.first, field.second);
+    } else if ((first & K_SIZE_UPDATE) != 0) {
+      std::size_t size = 0;
+      if (!decodeInteger(data, length, offset, K_SIZE_UPDATE_PREFIX, size)) {
+        fail("truncated table size update");
+      }
+      if (fieldSeen) {
+        fail("table size update after a field");
+      }
+      if (size > m_maxTableSize) {
+        fail("table size update above the advertised limit");
+      }
+      m_table.setMaxSize(size);
+      continue;
+    } else {
+      readLiteral(data, length, offset, K_LITERAL_PREFIX, field);
+    }
+
+    fieldSeen = true;
+    listSize += HpackTable::entrySize(field.first, field.second);
+    if (m_maxHeaderListSize != 0 && listSize > m_maxHeaderListSize) {
+      fits = false;
+    }
+    if (fits) {
+      headers.push_back(field);
+    }
+  }
+  return fits;
+}
+
+void HpackDecoder::setMaxTableSize(std::size_t size) {
+  m_maxTableSize = size;
+  if (m_table.getMaxSize() > size) {
+    m_table.setMaxSize(size);
+  }
+}
+
+void HpackDecoder::setMaxHeaderListSize(std::size_t size) {
+  m_maxHeaderListSize = size;
+}
+
+const HpackTable& HpackDecoder::getTable() const { return m_table; }
+
+// RFC 7541 section 5.1: an N-bit prefix, then 7 bits per byte, least
+// significant group first, while the top bit is set.
+bool HpackDecoder::decodeInteger(const char* data, std::size_t length,
+                                 std::size_t& offset, unsigned int prefixBits,
+                                 std::size_t& value) {
+  if (offset >= length) {
+    return false;
+  }
+  const std::size_t prefixMax = (static_cast<std::size_t>(1) << prefixBits) - 1;
+  value = static_cast<unsigned char>(data[offset++]) & prefixMax;
+  if (value < prefixMax) {
+    return true;
+  }
+
+  unsigned int shift = 0;
+  while (offset < length && shift <= K_MAX_INTEGER_SHIFT) {
+    const unsigned char byte = static_cast<unsigned char>(data[offset++]);
+    value += static_cast<std::size_t>(byte & K_PAYLOAD_MASK) << shift;
+    if ((byte & K_CONTINUE) == 0) {
+      return true;
+    }
+    shift += K_CONTINUATION_BITS;
+  }
+  return false;
+}
+
+// A name index of 0 means the name follows as a string literal.
+void HpackDecoder::readLiteral(const char* data, std::size_t length,
+                               std::size_t& offset, unsigned int prefixBits,
+                               Field& field) const {
+  std::size_t nameIndex = 0;
+  if (!decodeInteger(data, length, offset, prefixBits, nameIndex)) {
+    fail("truncated name index");
+  }
+  if (nameIndex == 0) {
+    readString(data, length, offset, field.first);
+  } else {
+    Field indexed;
+    if (!m_table.get(nameIndex, indexed)) {
+      fail("name index out of range");
+    }
+    field.first = indexed.first;
+  }
+  readString(data, length, offset, field.second);
+}
+
+void HpackDecoder::readString(const char* data, std::size_t length,
+                              std::size_t& offset, std::string& out) const {
+  if (offset >= length) {
+    fail("missing string literal");
+  }
+  const bool huffman =
+      (static_cast<unsigned char>(data[offset]) & K_HUFFMAN) != 0;
+  std::size_t size = 0;
+  if (!decodeInteger(data, length, offset, K_STRING_PREFIX, size) ||
+      size > length - offset) {
+    fail("truncated string literal");
+  }
+  if (huffman) {
+    if (!HpackHuffman::decode(data + offset, size, out)) {
+      fail("invalid Huffman encoding");
+    }
+  } else {
+    out.assign(data + offset, size);
+  }
+  offset += size;
+}
+
+void HpackDecoder::fail(const std::string& reason) {
+  throw exceptions::Http2Exception(
+      reason, exceptions::Http2Exception::COMPRESSION_ERROR, 0);
+}
+
+}  // namespace primitives
+}  // namespace http2
+}  // namespace infrastructure
@@ -0,0 +1,67 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HpackDecoder.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:58:02 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:58:02 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef HPACK_DECODER_HPP
+#define HPACK_DECODER_HPP
+
+#include "infrastructure/http2/primitives/HpackTable.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace infrastructure {
+namespace http2 {
+namespace primitives {
+
+// Turns header blocks back into fields. The dynamic table carries state
+// from one block to the next, so every block of a connection must go
+// through the same decoder, in order, even for streams that get refused.
+class HpackDecoder {
+ public:
+  typedef HpackTable::Field Field;
+  typedef std::vector<Field> HeaderList;
+
+  HpackDecoder();
+  ~HpackDecoder();
+
+  bool decode(const char* data, std::size_t length, HeaderList& headers);
+
+  void setMaxTableSize(std::size_t size);
+  void setMaxHeaderListSize(std::size_t size);
+  const HpackTable& getTable() const;
+
+  static bool decodeInteger(const char* data, std::size_t length,
+                            std::size_t& offset, unsigned int prefixBits,
+                            std::size_t& value);
+
+ private:
+  HpackDecoder(const HpackDecoder&);
+  HpackDecoder& operator=(const HpackDecoder&);
+
+  HpackTable m_table;
+  std::size_t m_maxTableSize;
+  std::size_t m_maxHeaderListSize;
+
+  void readLiteral(const char* data, std::size_t length, std::size_t& offset,
+                   unsigned int prefixBits, Field& field) const;
+  void readString(const char* data, std::size_t length, std::size_t& offset,
+                  std::string& out) const;
+
+  static void fail(const std::string& reason);
+};
+
+}  // namespace primitives
+}  // namespace http2
+}  // namespace infrastructure
+
+#endif  // HPACK_DECODER_HPP
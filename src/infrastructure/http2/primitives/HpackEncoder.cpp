@@ -0,0 +1,176 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HpackEncoder.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 12:01:37 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 12:01:37 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/http2/primitives/HpackEncoder.hpp"
+#include "infrastructure/http2/primitives/HpackHuffman.hpp"
+
+namespace infrastructure {
+namespace http2 {
+namespace primitives {
+
+namespace {
+
+const unsigned char K_INDEXED = 0x80;
+const unsigned char K_LITERAL_INDEXED = 0x40;
+const unsigned char K_SIZE_UPDATE = 0x20;
+const unsigned char K_LITERAL_NEVER_INDEXED = 0x10;
+const unsigned char K_LITERAL_UNINDEXED = 0x00;
+const unsigned char K_HUFFMAN = 0x80;
+const unsigned char K_CONTINUE = 0x80;
+const unsigned char K_PAYLOAD_MASK = 0x7F;
+const unsigned int K_INDEXED_PREFIX = 7;
+const unsigned int K_LITERAL_INDEXED_PREFIX = 6;
+const unsigned int K_SIZE_UPDATE_PREFIX = 5;
+const unsigned int K_LITERAL_PREFIX = 4;
+const unsigned int K_STRING_PREFIX = 7;
+const unsigned int K_CONTINUATION_BITS = 7;
+
+// Values that differ from one response to the next.
+const char* const K_UNINDEXED_NAMES[] = {
+    "content-length", "content-range", "etag", "last-modified", "location",
+    "age"};
+
+// Values an intermediary must not be able to probe through the table
+// (RFC 7541 section 7.1.3).
+const char* const K_NEVER_INDEXED_NAMES[] = {"set-cookie", "authorization"};
+
+bool isListed(const std::string& name, const char* const* names,
+              std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    if (name == names[i]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+HpackEncoder::HpackEncoder()
+    : m_sizeUpdatePending(false),
+      m_smallestPendingSize(HpackTable::K_DEFAULT_MAX_SIZE),
+      m_pendingSize(HpackTable::K_DEFAULT_MAX_SIZE) {}
+
+HpackEncoder::~HpackEncoder() {}
+
+void HpackEncoder::encode(const HeaderList& headers, std::string& out) {
+  appendSizeUpdates(out);
+
+  for (HeaderList::const_iterator it = headers.begin(); it != headers.end();
+       ++it) {
+    bool valueMatched = false;
+    const std::size_t index = m_table.find(it->first, it->second,
+                                           valueMatched);
+    if (valueMatched) {
+      appendInteger(out, K_INDEXED, K_INDEXED_PREFIX, index);
+      continue;
+    }
+
+    const Indexing indexing = indexingFor(it->first);
+    if (indexing == INDEXING_INCREMENTAL) {
+      appendInteger(out, K_LITERAL_INDEXED, K_LITERAL_INDEXED_PREFIX, index);
+    } else {
+      appendInteger(out,
+                    indexing == INDEXING_NEVER ? K_LITERAL_NEVER_INDEXED
+                                               : K_LITERAL_UNINDEXED,
+                    K_LITERAL_PREFIX, index);
+    }
+    if (index == 0) {
+      appendString(out, it->first);
+    }
+    appendString(out, it->second);
+    if (indexing == INDEXING_INCREMENTAL) {
+      m_table.insert(it->first, it->second);
+    }
+  }
+}
+
+// The peer's SETTINGS_HEADER_TABLE_SIZE, never above the default: a larger
+// table would only cost memory per connection. Several changes between two
+// header blocks are signalled as the smallest one followed by the last
+// (RFC 7541 section 4.2).
+void HpackEncoder::setMaxTableSize(std::size_t size) {
+  if (size > HpackTable::K_DEFAULT_MAX_SIZE) {
+    size = HpackTable::K_DEFAULT_MAX_SIZE;
+  }
+  if (!m_sizeUpdatePending) {
+    if (size == m_table.getMaxSize()) {
+      return;
+    }
+    m_sizeUpdatePending = true;
+    m_smallestPendingSize = size;
+  } else if (size < m_smallestPendingSize) {
+    m_smallestPendingSize = size;
+  }
+  m_pendingSize = size;
+}
+
+const HpackTable& HpackEncoder::getTable() const { return m_table; }
+
+void HpackEncoder::appendInteger(std::string& out, unsigned char flags,
+                                 unsigned int prefixBits, std::size_t value) {
+  const std::size_t prefixMax = (static_cast<std::size_t>(1) << prefixBits) - 1;
+  if (value < prefixMax) {
+    out += static_cast<char>(flags | value);
+    return;
+  }
+  out += static_cast<char>(flags | prefixMax);
+  value -= prefixMax;
+  while (value > K_PAYLOAD_MASK) {
+    out += static_cast<char>((value & K_PAYLOAD_MASK) | K_CONTINUE);
+    value >>= K_CONTINUATION_BITS;
+  }
+  out += static_cast<char>(value);
+}
+
+// Huffman-coded only when that is actually shorter.
+void HpackEncoder::appendString(std::string& out, const std::string& text) {
+  const std::size_t huffmanLength = HpackHuffman::encodedLength(text);
+  if (huffmanLength < text.size()) {
+    appendInteger(out, K_HUFFMAN, K_STRING_PREFIX, huffmanLength);
+    HpackHuffman::encode(text, out);
+    return;
+  }
+  appendInteger(out, 0, K_STRING_PREFIX, text.size());
+  out += text;
+}
+
+void HpackEncoder::appendSizeUpdates(std::string& out) {
+  if (!m_sizeUpdatePending) {
+    return;
+  }
+  if (m_smallestPendingSize < m_pendingSize) {
+    appendInteger(out, K_SIZE_UPDATE, K_SIZE_UPDATE_PREFIX,
+                  m_smallestPendingSize);
+    m_table.setMaxSize(m_smallestPendingSize);
+  }
+  appendInteger(out, K_SIZE_UPDATE, K_SIZE_UPDATE_PREFIX, m_pendingSize);
+  m_table.setMaxSize(m_pendingSize);
+  m_sizeUpdatePending = false;
+}
+
+HpackEncoder::Indexing HpackEncoder::indexingFor(const std::string& name) {
+  if (isListed(name, K_NEVER_INDEXED_NAMES,
+               sizeof(K_NEVER_INDEXED_NAMES) /
+                   sizeof(K_NEVER_INDEXED_NAMES[0]))) {
+    return INDEXING_NEVER;
+  }
+  if (isListed(name, K_UNINDEXED_NAMES,
+               sizeof(K_UNINDEXED_NAMES) / sizeof(K_UNINDEXED_NAMES[0]))) {
+    return INDEXING_NONE;
+  }
+  return INDEXING_INCREMENTAL;
+}
+
+}  // namespace primitives
+}  // namespace http2
+}  // namespace infrastructure
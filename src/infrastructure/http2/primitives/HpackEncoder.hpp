@@ -0,0 +1,67 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HpackEncoder.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 12:01:37 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 12:01:37 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef HPACK_ENCODER_HPP
+#define HPACK_ENCODER_HPP
+
+#include "infrastructure/http2/primitives/HpackTable.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace infrastructure {
+namespace http2 {
+namespace primitives {
+
+// Compresses response headers. Repeated fields (server, content-type,
+// cache-control, ...) go into the dynamic table and cost a byte or two on
+// later responses; fields whose value changes per response are sent as
+// literals so they do not push the useful entries out.
+class HpackEncoder {
+ public:
+  typedef HpackTable::Field Field;
+  typedef std::vector<Field> HeaderList;
+
+  HpackEncoder();
+  ~HpackEncoder();
+
+  void encode(const HeaderList& headers, std::string& out);
+
+  void setMaxTableSize(std::size_t size);
+  const HpackTable& getTable() const;
+
+  static void appendInteger(std::string& out, unsigned char flags,
+                            unsigned int prefixBits, std::size_t value);
+  static void appendString(std::string& out, const std::string& text);
+
+ private:
+  enum Indexing { INDEXING_INCREMENTAL, INDEXING_NONE, INDEXING_NEVER };
+
+  HpackEncoder(const HpackEncoder&);
+  HpackEncoder& operator=(const HpackEncoder&);
+
+  HpackTable m_table;
+  bool m_sizeUpdatePending;
+  std::size_t m_smallestPendingSize;
+  std::size_t m_pendingSize;
+
+  void appendSizeUpdates(std::string& out);
+
+  static Indexing indexingFor(const std::string& name);
+};
+
+}  // namespace primitives
+}  // namespace http2
+}  // namespace infrastructure
+
+#endif  // HPACK_ENCODER_HPP
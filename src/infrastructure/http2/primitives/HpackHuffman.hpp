@@ -0,0 +1,40 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HpackHuffman.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:50:13 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:50:13 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef HPACK_HUFFMAN_HPP
+#define HPACK_HUFFMAN_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace infrastructure {
+namespace http2 {
+namespace primitives {
+
+// The static Huffman code of RFC 7541 Appendix B. The code is canonical, so
+// decoding walks one bit at a time against the range of codes each length
+// covers instead of a tree.
+class HpackHuffman {
+ public:
+  static std::size_t encodedLength(const std::string& text);
+  static void encode(const std::string& text, std::string& out);
+  static bool decode(const char* data, std::size_t length, std::string& out);
+
+ private:
+  HpackHuffman();
+};
+
+}  // namespace primitives
+}  // namespace http2
+}  // namespace infrastructure
+
+#endif  // HPACK_HUFFMAN_HPP
@@ -0,0 +1,191 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HpackTable.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:53:40 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:53:40 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/http2/primitives/HpackTable.hpp"
+
+namespace infrastructure {
+namespace http2 {
+namespace primitives {
+
+namespace {
+
+struct StaticEntry {
+  const char* name;
+  const char* value;
+};
+
+// RFC 7541 Appendix A; index 1 is the first entry.
+const StaticEntry K_STATIC_TABLE[HpackTable::K_STATIC_SIZE] = {
+    {":authority", ""},
+    {":method", "GET"},
+    {":method", "POST"},
+    {":path", "/"},
+    {":path", "/index.html"},
+    {":scheme", "http"},
+    {":scheme", "https"},
+    {":status", "200"},
+    {":status", "204"},
+    {":status", "206"},
+    {":status", "304"},
+    {":status", "400"},
+    {":status", "404"},
+    {":status", "500"},
+    {"accept-charset", ""},
+    {"accept-encoding", "gzip, deflate"},
+    {"accept-language", ""},
+    {"accept-ranges", ""},
+    {"accept", ""},
+    {"access-control-allow-origin", ""},
+    {"age", ""},
+    {"allow", ""},
+    {"authorization", ""},
+    {"cache-control", ""},
+    {"content-disposition", ""},
+    {"content-encoding", ""},
+    {"content-language", ""},
+    {"content-length", ""},
+    {"content-location", ""},
+    {"content-range", ""},
+    {"content-type", ""},
+    {"cookie", ""},
+    {"date", ""},
+    {"etag", ""},
+    {"expect", ""},
+    {"expires", ""},
+    {"from", ""},
+    {"host", ""},
+    {"if-match", ""},
+    {"if-modified-since", ""},
+    {"if-none-match", ""},
+    {"if-range", ""},
+    {"if-unmodified-since", ""},
+    {"last-modified", ""},
+    {"link", ""},
+    {"location", ""},
+    {"max-forwards", ""},
+    {"proxy-authenticate", ""},
+    {"proxy-authorization", ""},
+    {"range", ""},
+    {"referer", ""},
+    {"refresh", ""},
+    {"retry-after", ""},
+    {"server", ""},
+    {"set-cookie", ""},
+    {"strict-transport-security", ""},
+    {"transfer-encoding", ""},
+    {"user-agent", ""},
+    {"vary", ""},
+    {"via", ""},
+    {"www-authenticate", ""}};
+
+}  // namespace
+
+const std::size_t HpackTable::K_STATIC_SIZE;
+const std::size_t HpackTable::K_ENTRY_OVERHEAD;
+const std::size_t HpackTable::K_DEFAULT_MAX_SIZE;
+
+HpackTable::HpackTable() : m_size(0), m_maxSize(K_DEFAULT_MAX_SIZE) {}
+
+HpackTable::~HpackTable() {}
+
+// Index 0 is never valid; indexes past the static table count into the
+// dynamic one from its newest entry.
+bool HpackTable::get(std::size_t index, Field& field) const {
+  if (index == 0) {
+    return false;
+  }
+  if (index <= K_STATIC_SIZE) {
+    field.first = K_STATIC_TABLE[index - 1].name;
+    field.second = K_STATIC_TABLE[index - 1].value;
+    return true;
+  }
+  const std::size_t dynamicIndex = index - K_STATIC_SIZE - 1;
+  if (dynamicIndex >= m_entries.size()) {
+    return false;
+  }
+  field = m_entries[dynamicIndex];
+  return true;
+}
+
+// An entry larger than the whole table empties it and is not added
+// (RFC 7541 section 4.4).
+void HpackTable::insert(const std::string& name, const std::string& value) {
+  const std::size_t size = entrySize(name, value);
+  if (size > m_maxSize) {
+    evict(0);
+    return;
+  }
+  evict(m_maxSize - size);
+  m_entries.push_front(Field(name, value));
+  m_size += size;
+}
+
+// Returns the lowest index whose name matches, preferring one whose value
+// matches as well; 0 when the name is in neither table.
+std::size_t HpackTable::find(const std::string& name,
+                             const std::string& value,
+                             bool& valueMatched) const {
+  std::size_t nameIndex = 0;
+  valueMatched = false;
+  for (std::size_t i = 0; i < K_STATIC_SIZE; ++i) {
+    if (name != K_STATIC_TABLE[i].name) {
+      continue;
+    }
+    if (value == K_STATIC_TABLE[i].value) {
+      valueMatched = true;
+      return i + 1;
+    }
+    if (nameIndex == 0) {
+      nameIndex = i + 1;
+    }
+  }
+  for (std::size_t i = 0; i < m_entries.size(); ++i) {
+    if (m_entries[i].first != name) {
+      continue;
+    }
+    if (m_entries[i].second == value) {
+      valueMatched = true;
+      return K_STATIC_SIZE + i + 1;
+    }
+    if (nameIndex == 0) {
+      nameIndex = K_STATIC_SIZE + i + 1;
+    }
+  }
+  return nameIndex;
+}
+
+void HpackTable::setMaxSize(std::size_t maxSize) {
+  m_maxSize = maxSize;
+  evict(maxSize);
+}
+
+std::size_t HpackTable::getMaxSize() const { return m_maxSize; }
+
+std::size_t HpackTable::getSize() const { return m_size; }
+
+std::size_t HpackTable::getEntryCount() const { return m_entries.size(); }
+
+std::size_t HpackTable::entrySize(const std::string& name,
+                                  const std::string& value) {
+  return name.size() + value.size() + K_ENTRY_OVERHEAD;
+}
+
+void HpackTable::evict(std::size_t limit) {
+  while (m_size > limit && !m_entries.empty()) {
+    m_size -= entrySize(m_entries.back().first, m_entries.back().second);
+    m_entries.pop_back();
+  }
+}
+
+}  // namespace primitives
+}  // namespace http2
+}  // namespace infrastructure
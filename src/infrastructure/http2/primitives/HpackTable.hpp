@@ -0,0 +1,67 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   HpackTable.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:53:40 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:53:40 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef HPACK_TABLE_HPP
+#define HPACK_TABLE_HPP
+
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <utility>
+
+namespace infrastructure {
+namespace http2 {
+namespace primitives {
+
+// The HPACK index space (RFC 7541 section 2.3): the 61 static entries
+// followed by the dynamic table, newest entry first. Each side of a
+// connection owns one table per direction.
+class HpackTable {
+ public:
+  typedef std::pair<std::string, std::string> Field;
+
+  static const std::size_t K_STATIC_SIZE = 61;
+  static const std::size_t K_ENTRY_OVERHEAD = 32;
+  static const std::size_t K_DEFAULT_MAX_SIZE = 4096;
+
+  HpackTable();
+  ~HpackTable();
+
+  bool get(std::size_t index, Field& field) const;
+  void insert(const std::string& name, const std::string& value);
+  std::size_t find(const std::string& name, const std::string& value,
+                   bool& valueMatched) const;
+
+  void setMaxSize(std::size_t maxSize);
+  std::size_t getMaxSize() const;
+  std::size_t getSize() const;
+  std::size_t getEntryCount() const;
+
+  static std::size_t entrySize(const std::string& name,
+                               const std::string& value);
+
+ private:
+  HpackTable(const HpackTable&);
+  HpackTable& operator=(const HpackTable&);
+
+  std::deque<Field> m_entries;
+  std::size_t m_size;
+  std::size_t m_maxSize;
+
+  void evict(std::size_t limit);
+};
+
+}  // namespace primitives
+}  // namespace http2
+}  // namespace infrastructure
+
+#endif  // HPACK_TABLE_HPP
@@ -0,0 +1,185 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Http2Frame.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:44:52 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:44:52 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/http2/primitives/Http2Frame.hpp"
+
+namespace infrastructure {
+namespace http2 {
+namespace primitives {
+
+const unsigned char Http2Frame::K_FLAG_END_STREAM;
+const unsigned char Http2Frame::K_FLAG_ACK;
+const unsigned char Http2Frame::K_FLAG_END_HEADERS;
+const unsigned char Http2Frame::K_FLAG_PADDED;
+const unsigned char Http2Frame::K_FLAG_PRIORITY;
+const std::size_t Http2Frame::K_HEADER_SIZE;
+const std::size_t Http2Frame::K_SETTING_SIZE;
+const std::size_t Http2Frame::K_PING_SIZE;
+const std::size_t Http2Frame::K_PRIORITY_SIZE;
+const std::size_t Http2Frame::K_RST_STREAM_SIZE;
+const std::size_t Http2Frame::K_WINDOW_UPDATE_SIZE;
+const std::size_t Http2Frame::K_GOAWAY_MIN_SIZE;
+const std::size_t Http2Frame::K_DEFAULT_MAX_FRAME_SIZE;
+const std::size_t Http2Frame::K_MAX_FRAME_SIZE_LIMIT;
+const unsigned long Http2Frame::K_DEFAULT_WINDOW_SIZE;
+const unsigned long Http2Frame::K_MAX_WINDOW_SIZE;
+const unsigned int Http2Frame::K_STREAM_ID_MASK;
+const unsigned int Http2Frame::K_DEFAULT_WEIGHT;
+const std::size_t Http2Frame::K_CLIENT_PREFACE_SIZE;
+
+const char Http2Frame::K_CLIENT_PREFACE[] = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+
+namespace {
+
+const std::size_t K_BYTE_BITS = 8;
+const unsigned long K_BYTE_MASK = 0xFF;
+
+}  // namespace
+
+Http2Frame::Http2Frame() : type(TYPE_DATA), flags(0), streamId(0) {}
+
+Http2Frame::Http2Frame(const Http2Frame& other)
+    : type(other.type),
+      flags(other.flags),
+      streamId(other.streamId),
+      payload(other.payload) {}
+
+Http2Frame::~Http2Frame() {}
+
+Http2Frame& Http2Frame::operator=(const Http2Frame& other) {
+  if (this != &other) {
+    type = other.type;
+    flags = other.flags;
+    streamId = other.streamId;
+    payload = other.payload;
+  }
+  return *this;
+}
+
+bool Http2Frame::hasFlag(unsigned char flag) const {
+  return (flags & flag) != 0;
+}
+
+void Http2Frame::appendHeader(std::string& out, Type frameType,
+                              unsigned char frameFlags,
+                              unsigned int frameStreamId,
+                              std::size_t length) {
+  const unsigned int id = frameStreamId & K_STREAM_ID_MASK;
+  const char header[K_HEADER_SIZE] = {
+      static_cast<char>((length >> 16) & K_BYTE_MASK),
+      static_cast<char>((length >> K_BYTE_BITS) & K_BYTE_MASK),
+      static_cast<char>(length & K_BYTE_MASK),
+      static_cast<char>(frameType),
+      static_cast<char>(frameFlags),
+      static_cast<char>((id >> 24) & K_BYTE_MASK),
+      static_cast<char>((id >> 16) & K_BYTE_MASK),
+      static_cast<char>((id >> K_BYTE_BITS) & K_BYTE_MASK),
+      static_cast<char>(id & K_BYTE_MASK)};
+  out.append(header, K_HEADER_SIZE);
+}
+
+void Http2Frame::appendData(std::string& out, unsigned int frameStreamId,
+                            const char* data, std::size_t length,
+                            bool endStream) {
+  out.reserve(out.size() + K_HEADER_SIZE + length);
+  appendHeader(out, TYPE_DATA, endStream ? K_FLAG_END_STREAM : 0,
+               frameStreamId, length);
+  if (length > 0) {
+    out.append(data, length);
+  }
+}
+
+// A block larger than the peer's frame size continues in CONTINUATION
+// frames; END_STREAM stays on the HEADERS frame, END_HEADERS on the last.
+void Http2Frame::appendHeaders(std::string& out, unsigned int frameStreamId,
+                               const std::string& block, bool endStream,
+                               std::size_t maxFrameSize) {
+  std::size_t offset = 0;
+  Type frameType = TYPE_HEADERS;
+  do {
+    std::size_t chunk = block.size() - offset;
+    if (chunk > maxFrameSize) {
+      chunk = maxFrameSize;
+    }
+    unsigned char frameFlags = 0;
+    if (frameType == TYPE_HEADERS && endStream) {
+      frameFlags |= K_FLAG_END_STREAM;
+    }
+    if (offset + chunk == block.size()) {
+      frameFlags |= K_FLAG_END_HEADERS;
+    }
+    appendHeader(out, frameType, frameFlags, frameStreamId, chunk);
+    out.append(block, offset, chunk);
+    offset += chunk;
+    frameType = TYPE_CONTINUATION;
+  } while (offset < block.size());
+}
+
+void Http2Frame::appendSettings(std::string& out,
+                                const SettingList& settings) {
+  appendHeader(out, TYPE_SETTINGS, 0, 0, settings.size() * K_SETTING_SIZE);
+  for (SettingList::const_iterator it = settings.begin(); it != settings.end();
+       ++it) {
+    out += static_cast<char>((it->first >> K_BYTE_BITS) & K_BYTE_MASK);
+    out += static_cast<char>(it->first & K_BYTE_MASK);
+    appendUint32(out, it->second);
+  }
+}
+
+void Http2Frame::appendSettingsAck(std::string& out) {
+  appendHeader(out, TYPE_SETTINGS, K_FLAG_ACK, 0, 0);
+}
+
+void Http2Frame::appendPing(std::string& out, const char* opaque, bool ack) {
+  appendHeader(out, TYPE_PING, ack ? K_FLAG_ACK : 0, 0, K_PING_SIZE);
+  out.append(opaque, K_PING_SIZE);
+}
+
+void Http2Frame::appendGoAway(std::string& out, unsigned int lastStreamId,
+                              unsigned int errorCode) {
+  appendHeader(out, TYPE_GOAWAY, 0, 0, K_GOAWAY_MIN_SIZE);
+  appendUint32(out, lastStreamId & K_STREAM_ID_MASK);
+  appendUint32(out, errorCode);
+}
+
+void Http2Frame::appendRstStream(std::string& out, unsigned int frameStreamId,
+                                 unsigned int errorCode) {
+  appendHeader(out, TYPE_RST_STREAM, 0, frameStreamId, K_RST_STREAM_SIZE);
+  appendUint32(out, errorCode);
+}
+
+void Http2Frame::appendWindowUpdate(std::string& out,
+                                    unsigned int frameStreamId,
+                                    unsigned long increment) {
+  appendHeader(out, TYPE_WINDOW_UPDATE, 0, frameStreamId,
+               K_WINDOW_UPDATE_SIZE);
+  appendUint32(out, increment & K_MAX_WINDOW_SIZE);
+}
+
+unsigned long Http2Frame::readUint32(const char* data) {
+  unsigned long value = 0;
+  for (std::size_t i = 0; i < 4; ++i) {
+    value = (value << K_BYTE_BITS) | static_cast<unsigned char>(data[i]);
+  }
+  return value;
+}
+
+void Http2Frame::appendUint32(std::string& out, unsigned long value) {
+  out += static_cast<char>((value >> 24) & K_BYTE_MASK);
+  out += static_cast<char>((value >> 16) & K_BYTE_MASK);
+  out += static_cast<char>((value >> K_BYTE_BITS) & K_BYTE_MASK);
+  out += static_cast<char>(value & K_BYTE_MASK);
+}
+
+}  // namespace primitives
+}  // namespace http2
+}  // namespace infrastructure
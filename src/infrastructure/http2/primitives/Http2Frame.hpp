@@ -0,0 +1,117 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Http2Frame.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:44:52 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:44:52 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef HTTP2_FRAME_HPP
+#define HTTP2_FRAME_HPP
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace infrastructure {
+namespace http2 {
+namespace primitives {
+
+// One HTTP/2 frame as read off the wire, plus the encoders for the frames a
+// server sends. The type is kept as the raw byte because frames of unknown
+// types must be skipped rather than rejected.
+class Http2Frame {
+ public:
+  typedef std::pair<unsigned int, unsigned long> Setting;
+  typedef std::vector<Setting> SettingList;
+
+  enum Type {
+    TYPE_DATA = 0x0,
+    TYPE_HEADERS = 0x1,
+    TYPE_PRIORITY = 0x2,
+    TYPE_RST_STREAM = 0x3,
+    TYPE_SETTINGS = 0x4,
+    TYPE_PUSH_PROMISE = 0x5,
+    TYPE_PING = 0x6,
+    TYPE_GOAWAY = 0x7,
+    TYPE_WINDOW_UPDATE = 0x8,
+    TYPE_CONTINUATION = 0x9
+  };
+
+  enum SettingId {
+    SETTINGS_HEADER_TABLE_SIZE = 0x1,
+    SETTINGS_ENABLE_PUSH = 0x2,
+    SETTINGS_MAX_CONCURRENT_STREAMS = 0x3,
+    SETTINGS_INITIAL_WINDOW_SIZE = 0x4,
+    SETTINGS_MAX_FRAME_SIZE = 0x5,
+    SETTINGS_MAX_HEADER_LIST_SIZE = 0x6
+  };
+
+  static const unsigned char K_FLAG_END_STREAM = 0x1;
+  static const unsigned char K_FLAG_ACK = 0x1;
+  static const unsigned char K_FLAG_END_HEADERS = 0x4;
+  static const unsigned char K_FLAG_PADDED = 0x8;
+  static const unsigned char K_FLAG_PRIORITY = 0x20;
+
+  static const std::size_t K_HEADER_SIZE = 9;
+  static const std::size_t K_SETTING_SIZE = 6;
+  static const std::size_t K_PING_SIZE = 8;
+  static const std::size_t K_PRIORITY_SIZE = 5;
+  static const std::size_t K_RST_STREAM_SIZE = 4;
+  static const std::size_t K_WINDOW_UPDATE_SIZE = 4;
+  static const std::size_t K_GOAWAY_MIN_SIZE = 8;
+  static const std::size_t K_DEFAULT_MAX_FRAME_SIZE = 16384;
+  static const std::size_t K_MAX_FRAME_SIZE_LIMIT = 16777215;
+  static const unsigned long K_DEFAULT_WINDOW_SIZE = 65535;
+  static const unsigned long K_MAX_WINDOW_SIZE = 0x7FFFFFFF;
+  static const unsigned int K_STREAM_ID_MASK = 0x7FFFFFFF;
+  static const unsigned int K_DEFAULT_WEIGHT = 16;
+
+  static const char K_CLIENT_PREFACE[];
+  static const std::size_t K_CLIENT_PREFACE_SIZE = 24;
+
+  Http2Frame();
+  Http2Frame(const Http2Frame& other);
+  ~Http2Frame();
+
+  Http2Frame& operator=(const Http2Frame& other);
+
+  unsigned char type;
+  unsigned char flags;
+  unsigned int streamId;
+  std::string payload;
+
+  bool hasFlag(unsigned char flag) const;
+
+  static void appendHeader(std::string& out, Type type, unsigned char flags,
+                           unsigned int streamId, std::size_t length);
+  static void appendData(std::string& out, unsigned int streamId,
+                         const char* data, std::size_t length,
+                         bool endStream);
+  static void appendHeaders(std::string& out, unsigned int streamId,
+                            const std::string& block, bool endStream,
+                            std::size_t maxFrameSize);
+  static void appendSettings(std::string& out, const SettingList& settings);
+  static void appendSettingsAck(std::string& out);
+  static void appendPing(std::string& out, const char* opaque, bool ack);
+  static void appendGoAway(std::string& out, unsigned int lastStreamId,
+                           unsigned int errorCode);
+  static void appendRstStream(std::string& out, unsigned int streamId,
+                              unsigned int errorCode);
+  static void appendWindowUpdate(std::string& out, unsigned int streamId,
+                                 unsigned long increment);
+
+  static unsigned long readUint32(const char* data);
+  static void appendUint32(std::string& out, unsigned long value);
+};
+
+}  // namespace primitives
+}  // namespace http2
+}  // namespace infrastructure
+
+#endif  // HTTP2_FRAME_HPP
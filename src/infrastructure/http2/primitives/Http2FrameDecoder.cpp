@@ -0,0 +1,102 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Http2FrameDecoder.cpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:47:26 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:47:26 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/http2/exceptions/Http2Exception.hpp"
+#include "infrastructure/http2/primitives/Http2FrameDecoder.hpp"
+
+#include <sstream>
+
+namespace infrastructure {
+namespace http2 {
+namespace primitives {
+
+namespace {
+
+const std::size_t K_COMPACT_THRESHOLD = 16384;
+
+inline unsigned char byteAt(const char* data, std::size_t index) {
+  return static_cast<unsigned char>(data[index]);
+}
+
+}  // namespace
+
+Http2FrameDecoder::Http2FrameDecoder()
+    : m_offset(0), m_maxFrameSize(Http2Frame::K_DEFAULT_MAX_FRAME_SIZE) {}
+
+Http2FrameDecoder::~Http2FrameDecoder() {}
+
+void Http2FrameDecoder::feed(const char* data, std::size_t length) {
+  if (length == 0) {
+    return;
+  }
+  compact();
+  m_buffer.append(data, length);
+}
+
+bool Http2FrameDecoder::next(Http2Frame& frame) {
+  const std::size_t available = bufferedBytes();
+  if (available < Http2Frame::K_HEADER_SIZE) {
+    return false;
+  }
+
+  const char* header = m_buffer.data() + m_offset;
+  const std::size_t length =
+      (static_cast<std::size_t>(byteAt(header, 0)) << 16) |
+      (static_cast<std::size_t>(byteAt(header, 1)) << 8) | byteAt(header, 2);
+  if (length > m_maxFrameSize) {
+    std::ostringstream oss;
+    oss << "frame of " << length << " bytes exceeds the " << m_maxFrameSize
+        << " byte limit";
+    throw exceptions::Http2Exception(
+        oss.str(), exceptions::Http2Exception::FRAME_SIZE_ERROR, 0);
+  }
+  if (available < Http2Frame::K_HEADER_SIZE + length) {
+    return false;
+  }
+
+  frame.type = byteAt(header, 3);
+  frame.flags = byteAt(header, 4);
+  frame.streamId = static_cast<unsigned int>(
+      Http2Frame::readUint32(header + 5) & Http2Frame::K_STREAM_ID_MASK);
+  frame.payload.assign(header + Http2Frame::K_HEADER_SIZE, length);
+
+  m_offset += Http2Frame::K_HEADER_SIZE + length;
+  if (m_offset == m_buffer.size()) {
+    reset();
+  }
+  return true;
+}
+
+void Http2FrameDecoder::setMaxFrameSize(std::size_t size) {
+  m_maxFrameSize = size;
+}
+
+std::size_t Http2FrameDecoder::bufferedBytes() const {
+  return m_buffer.size() - m_offset;
+}
+
+void Http2FrameDecoder::reset() {
+  m_buffer.clear();
+  m_offset = 0;
+}
+
+void Http2FrameDecoder::compact() {
+  if (m_offset < K_COMPACT_THRESHOLD) {
+    return;
+  }
+  m_buffer.erase(0, m_offset);
+  m_offset = 0;
+}
+
+}  // namespace primitives
+}  // namespace http2
+}  // namespace infrastructure
@@ -0,0 +1,55 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   Http2FrameDecoder.hpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:47:26 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:47:26 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef HTTP2_FRAME_DECODER_HPP
+#define HTTP2_FRAME_DECODER_HPP
+
+#include "infrastructure/http2/primitives/Http2Frame.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace infrastructure {
+namespace http2 {
+namespace primitives {
+
+// Splits a byte stream into frames. A frame longer than the advertised
+// SETTINGS_MAX_FRAME_SIZE is a connection error, raised before its payload
+// is buffered.
+class Http2FrameDecoder {
+ public:
+  Http2FrameDecoder();
+  ~Http2FrameDecoder();
+
+  void feed(const char* data, std::size_t length);
+  bool next(Http2Frame& frame);
+
+  void setMaxFrameSize(std::size_t size);
+  std::size_t bufferedBytes() const;
+  void reset();
+
+ private:
+  Http2FrameDecoder(const Http2FrameDecoder&);
+  Http2FrameDecoder& operator=(const Http2FrameDecoder&);
+
+  std::string m_buffer;
+  std::size_t m_offset;
+  std::size_t m_maxFrameSize;
+
+  void compact();
+};
+
+}  // namespace primitives
+}  // namespace http2
+}  // namespace infrastructure
+
+#endif  // HTTP2_FRAME_DECODER_HPP
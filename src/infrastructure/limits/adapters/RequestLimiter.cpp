@@ -0,0 +1,253 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RequestLimiter.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:17:45 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:17:45 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/cache/primitives/CacheKey.hpp"
+#include "infrastructure/limits/adapters/RequestLimiter.hpp"
+
+#include <sstream>
+
+namespace infrastructure {
+namespace limits {
+namespace adapters {
+
+namespace {
+
+typedef domain::configuration::value_objects::RequestLimitConfig
+    RequestLimitConfig;
+
+struct PendingRequest {
+  primitives::LimitTable* table;
+  unsigned long hash;
+  unsigned long excess;
+  unsigned long rate;
+  bool nodelay;
+};
+
+// "1.000" for an excess of 1000, as nginx prints it.
+std::string formatExcess(unsigned long excess) {
+  std::ostringstream oss;
+  oss << excess / primitives::LimitTable::K_EXCESS_SCALE << '.';
+  const unsigned long fraction =
+      excess % primitives::LimitTable::K_EXCESS_SCALE;
+  oss << (fraction < 100 ? "0" : "") << (fraction < 10 ? "0" : "")
+      << fraction;
+  return oss.str();
+}
+
+}  // namespace
+
+RequestLimiter::Lease::Lease() {}
+
+RequestLimiter::Lease::~Lease() {}
+
+bool RequestLimiter::Lease::isEmpty() const { return m_slots.empty(); }
+
+RequestLimiter::Zone::Zone(
+    const domain::configuration::value_objects::LimitZoneConfig& zoneConfig,
+    unsigned long zoneId)
+    : config(zoneConfig), table(zoneConfig.getSize()), id(zoneId) {}
+
+RequestLimiter::RequestLimiter(application::ports::ILogger& logger)
+    : m_logger(logger),
+      m_nextZoneId(1),
+      m_delayed(0),
+      m_rejected(0),
+      m_connectionsRejected(0) {}
+
+RequestLimiter::~RequestLimiter() {
+  for (ZoneMap::iterator it = m_zones.begin(); it != m_zones.end(); ++it) {
+    delete it->second;
+  }
+}
+
+// A zone whose table is replaced gets a new id, so a lease taken on the old
+// table is not given back to the new one.
+void RequestLimiter::configure(
+    const domain::configuration::entities::HttpConfig::LimitZones& zones) {
+  ZoneMap next;
+  for (domain::configuration::entities::HttpConfig::LimitZones::const_iterator
+           it = zones.begin();
+       it != zones.end(); ++it) {
+    ZoneMap::iterator current = m_zones.find(it->first);
+    if (current != m_zones.end() &&
+        current->second->config.getType() == it->second.getType() &&
+        current->second->config.getKey() == it->second.getKey() &&
+        current->second->config.getSize() == it->second.getSize()) {
+      current->second->config = it->second;
+      next[it->first] = current->second;
+      m_zones.erase(current);
+      continue;
+    }
+    next[it->first] = new Zone(it->second, m_nextZoneId++);
+  }
+
+  for (ZoneMap::iterator it = m_zones.begin(); it != m_zones.end(); ++it) {
+    delete it->second;
+  }
+  m_zones.swap(next);
+}
+
+bool RequestLimiter::hasZone(const std::string& zone) const {
+  return findZone(zone) != NULL;
+}
+
+// Every limit_req is checked before any is charged, so a request one zone
+// refuses costs the others nothing. The delay is the longest any zone asks
+// for: the time its bucket needs to drain the excess.
+RequestLimiter::Outcome RequestLimiter::limitRequest(
+    const RequestLimitConfig& limits,
+    const domain::http::entities::HttpRequest& request,
+    const std::string& remoteAddress, unsigned long nowMillis,
+    unsigned long& delayMillis) {
+  delayMillis = 0;
+  const RequestLimitConfig::RequestRules& rules = limits.getRequestRules();
+  std::vector<PendingRequest> pending;
+  pending.reserve(rules.size());
+
+  for (RequestLimitConfig::RequestRules::const_iterator rule = rules.begin();
+       rule != rules.end(); ++rule) {
+    Zone* zone = findZone(rule->zone);
+    if (zone == NULL) {
+      continue;
+    }
+    const std::string key = renderKey(*zone, request, remoteAddress);
+    if (key.empty()) {
+      continue;
+    }
+
+    PendingRequest entry;
+    entry.table = &zone->table;
+    entry.hash = primitives::LimitTable::hashKey(key);
+    entry.rate = zone->config.getRate();
+    entry.nodelay = rule->nodelay;
+    const primitives::LimitTable::Verdict verdict = zone->table.checkRequest(
+        entry.hash, entry.rate,
+        rule->burst * primitives::LimitTable::K_EXCESS_SCALE, nowMillis,
+        entry.excess);
+    if (verdict != primitives::LimitTable::VERDICT_PASS) {
+      ++m_rejected;
+      reportLimited("limiting requests", *zone, remoteAddress,
+                    verdict == primitives::LimitTable::VERDICT_FULL
+                        ? "zone is full"
+                        : "excess: " + formatExcess(entry.excess));
+      return OUTCOME_REJECT;
+    }
+    pending.push_back(entry);
+  }
+
+  for (std::vector<PendingRequest>::const_iterator it = pending.begin();
+       it != pending.end(); ++it) {
+    it->table->accountRequest(it->hash, it->excess, nowMillis);
+    if (!it->nodelay) {
+      const unsigned long delay =
+          it->excess * primitives::LimitTable::K_EXCESS_SCALE / it->rate;
+      if (delay > delayMillis) {
+        delayMillis = delay;
+      }
+    }
+  }
+  if (delayMillis == 0) {
+    return OUTCOME_PASS;
+  }
+  ++m_delayed;
+  WEBSERV_LOG_DEBUG(m_logger, "Delaying request from "
+                                  << remoteAddress << " for " << delayMillis
+                                  << "ms");
+  return OUTCOME_DELAY;
+}
+
+RequestLimiter::Outcome RequestLimiter::limitConnection(
+    const RequestLimitConfig& limits,
+    const domain::http::entities::HttpRequest& request,
+    const std::string& remoteAddress, unsigned long nowMillis,
+    Lease& lease) {
+  const RequestLimitConfig::ConnectionRules& rules =
+      limits.getConnectionRules();
+  for (RequestLimitConfig::ConnectionRules::const_iterator rule =
+           rules.begin();
+       rule != rules.end(); ++rule) {
+    Zone* zone = findZone(rule->zone);
+    if (zone == NULL) {
+      continue;
+    }
+    const std::string key = renderKey(*zone, request, remoteAddress);
+    if (key.empty()) {
+      continue;
+    }
+
+    Lease::Slot slot;
+    slot.zone = rule->zone;
+    slot.zoneId = zone->id;
+    slot.hash = primitives::LimitTable::hashKey(key);
+    const primitives::LimitTable::Verdict verdict =
+        zone->table.acquireConnection(slot.hash, rule->limit, nowMillis);
+    if (verdict != primitives::LimitTable::VERDICT_PASS) {
+      ++m_connectionsRejected;
+      std::ostringstream detail;
+      if (verdict == primitives::LimitTable::VERDICT_FULL) {
+        detail << "zone is full";
+      } else {
+        detail << "limit: " << rule->limit;
+      }
+      reportLimited("limiting connections", *zone, remoteAddress,
+                    detail.str());
+      release(lease);
+      return OUTCOME_REJECT;
+    }
+    lease.m_slots.push_back(slot);
+  }
+  return OUTCOME_PASS;
+}
+
+void RequestLimiter::release(Lease& lease) {
+  for (std::vector<Lease::Slot>::const_iterator it = lease.m_slots.begin();
+       it != lease.m_slots.end(); ++it) {
+    Zone* zone = findZone(it->zone);
+    if (zone != NULL && zone->id == it->zoneId) {
+      zone->table.releaseConnection(it->hash);
+    }
+  }
+  lease.m_slots.clear();
+}
+
+unsigned long RequestLimiter::getDelayedCount() const { return m_delayed; }
+
+unsigned long RequestLimiter::getRejectedCount() const { return m_rejected; }
+
+unsigned long RequestLimiter::getConnectionRejectedCount() const {
+  return m_connectionsRejected;
+}
+
+RequestLimiter::Zone* RequestLimiter::findZone(const std::string& name) const {
+  ZoneMap::const_iterator it = m_zones.find(name);
+  return it != m_zones.end() ? it->second : NULL;
+}
+
+void RequestLimiter::reportLimited(const char* action, const Zone& zone,
+                                   const std::string& remoteAddress,
+                                   const std::string& detail) {
+  std::ostringstream oss;
+  oss << action << ", " << detail << ", by zone \"" << zone.config.getName()
+      << "\", client: " << remoteAddress;
+  m_logger.warn(oss.str());
+}
+
+std::string RequestLimiter::renderKey(
+    const Zone& zone, const domain::http::entities::HttpRequest& request,
+    const std::string& remoteAddress) {
+  return cache::primitives::CacheKey::render(zone.config.getKey(), request,
+                                             "http", remoteAddress);
+}
+
+}  // namespace adapters
+}  // namespace limits
+}  // namespace infrastructure
@@ -0,0 +1,121 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RequestLimiter.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:17:45 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:17:45 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef REQUEST_LIMITER_HPP
+#define REQUEST_LIMITER_HPP
+
+#include "application/ports/ILogger.hpp"
+#include "domain/configuration/entities/HttpConfig.hpp"
+#include "domain/configuration/value_objects/LimitZoneConfig.hpp"
+#include "domain/configuration/value_objects/RequestLimitConfig.hpp"
+#include "domain/http/entities/HttpRequest.hpp"
+#include "infrastructure/limits/primitives/LimitTable.hpp"
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace infrastructure {
+namespace limits {
+namespace adapters {
+
+// The limit_req_zone and limit_conn_zone tables, and the limit_req and
+// limit_conn rules applied against them. Requests are checked first, as in
+// nginx, so a request refused or delayed by limit_req holds no connection
+// slot; the slots limit_conn grants are recorded in a Lease and given back
+// when the request finishes. A reload keeps a zone's table while its type,
+// key and size stay the same.
+class RequestLimiter {
+ public:
+  enum Outcome { OUTCOME_PASS, OUTCOME_DELAY, OUTCOME_REJECT };
+
+  class Lease {
+   public:
+    Lease();
+    ~Lease();
+
+    bool isEmpty() const;
+
+   private:
+    friend class RequestLimiter;
+
+    struct Slot {
+      std::string zone;
+      unsigned long zoneId;
+      unsigned long hash;
+    };
+
+    std::vector<Slot> m_slots;
+  };
+
+  explicit RequestLimiter(application::ports::ILogger& logger);
+  ~RequestLimiter();
+
+  void configure(
+      const domain::configuration::entities::HttpConfig::LimitZones& zones);
+  bool hasZone(const std::string& zone) const;
+
+  Outcome limitRequest(
+      const domain::configuration::value_objects::RequestLimitConfig& limits,
+      const domain::http::entities::HttpRequest& request,
+      const std::string& remoteAddress, unsigned long nowMillis,
+      unsigned long& delayMillis);
+  Outcome limitConnection(
+      const domain::configuration::value_objects::RequestLimitConfig& limits,
+      const domain::http::entities::HttpRequest& request,
+      const std::string& remoteAddress, unsigned long nowMillis,
+      Lease& lease);
+  void release(Lease& lease);
+
+  unsigned long getDelayedCount() const;
+  unsigned long getRejectedCount() const;
+  unsigned long getConnectionRejectedCount() const;
+
+ private:
+  struct Zone {
+    domain::configuration::value_objects::LimitZoneConfig config;
+    primitives::LimitTable table;
+    unsigned long id;
+
+    Zone(const domain::configuration::value_objects::LimitZoneConfig&
+             zoneConfig,
+         unsigned long zoneId);
+  };
+
+  typedef std::map<std::string, Zone*> ZoneMap;
+
+  RequestLimiter(const RequestLimiter&);
+  RequestLimiter& operator=(const RequestLimiter&);
+
+  Zone* findZone(const std::string& name) const;
+  void reportLimited(const char* action, const Zone& zone,
+                     const std::string& remoteAddress,
+                     const std::string& detail);
+
+  static std::string renderKey(
+      const Zone& zone, const domain::http::entities::HttpRequest& request,
+      const std::string& remoteAddress);
+
+  application::ports::ILogger& m_logger;
+  ZoneMap m_zones;
+  unsigned long m_nextZoneId;
+  unsigned long m_delayed;
+  unsigned long m_rejected;
+  unsigned long m_connectionsRejected;
+};
+
+}  // namespace adapters
+}  // namespace limits
+}  // namespace infrastructure
+
+#endif  // REQUEST_LIMITER_HPP
@@ -0,0 +1,170 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   LimitTable.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:16:08 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:16:08 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/limits/primitives/LimitTable.hpp"
+
+namespace infrastructure {
+namespace limits {
+namespace primitives {
+
+namespace {
+
+const unsigned long K_FNV_OFFSET_BASIS = 14695981039346656037ul;
+const unsigned long K_FNV_PRIME = 1099511628211ul;
+const unsigned long K_MILLIS_PER_SECOND = 1000;
+// Long enough for any bucket to drain, short enough that rate * elapsed
+// cannot overflow.
+const unsigned long K_MAX_ELAPSED_MILLIS = 100000000ul;
+
+}  // namespace
+
+const std::size_t LimitTable::K_PROBE_LIMIT;
+const unsigned long LimitTable::K_EXCESS_SCALE;
+
+LimitTable::LimitTable(std::size_t bytes) : m_mask(0), m_used(0) {
+  std::size_t capacity = K_PROBE_LIMIT;
+  while (capacity * 2 * sizeof(Slot) <= bytes) {
+    capacity *= 2;
+  }
+  const Slot empty = {0, 0, 0, 0};
+  m_slots.assign(capacity, empty);
+  m_mask = capacity - 1;
+}
+
+LimitTable::~LimitTable() {}
+
+// nginx's ngx_http_limit_req_lookup(): the bucket drains rate * elapsed
+// and takes 1000 for this request; more than the burst allows is busy.
+// Nothing is stored, so a request refused by a later limit_req leaves this
+// zone untouched; accountRequest() commits the result.
+LimitTable::Verdict LimitTable::checkRequest(unsigned long hash,
+                                             unsigned long rate,
+                                             unsigned long burst,
+                                             unsigned long nowMillis,
+                                             unsigned long& excess) {
+  excess = 0;
+  const Slot* slot = find(hash);
+  if (slot == NULL) {
+    return claim(hash, nowMillis) != NULL ? VERDICT_PASS : VERDICT_FULL;
+  }
+
+  unsigned long elapsed =
+      nowMillis > slot->lastMillis ? nowMillis - slot->lastMillis : 0;
+  if (elapsed > K_MAX_ELAPSED_MILLIS) {
+    elapsed = K_MAX_ELAPSED_MILLIS;
+  }
+  const unsigned long drained = rate * elapsed / K_MILLIS_PER_SECOND;
+  const unsigned long queued = slot->excess + K_EXCESS_SCALE;
+  excess = queued > drained ? queued - drained : 0;
+  return excess > burst ? VERDICT_BUSY : VERDICT_PASS;
+}
+
+void LimitTable::accountRequest(unsigned long hash, unsigned long excess,
+                                unsigned long nowMillis) {
+  Slot* slot = find(hash);
+  if (slot == NULL) {
+    return;
+  }
+  slot->excess = excess;
+  if (nowMillis > slot->lastMillis) {
+    slot->lastMillis = nowMillis;
+  }
+}
+
+LimitTable::Verdict LimitTable::acquireConnection(unsigned long hash,
+                                                  unsigned long limit,
+                                                  unsigned long nowMillis) {
+  Slot* slot = find(hash);
+  if (slot == NULL) {
+    slot = claim(hash, nowMillis);
+    if (slot == NULL) {
+      return VERDICT_FULL;
+    }
+  }
+  if (slot->connections >= limit) {
+    return VERDICT_BUSY;
+  }
+  ++slot->connections;
+  slot->lastMillis = nowMillis;
+  return VERDICT_PASS;
+}
+
+// A slot is never dropped while it holds connections, so a release always
+// finds the slot its acquire used; one taken on a previous table is ignored.
+void LimitTable::releaseConnection(unsigned long hash) {
+  Slot* slot = find(hash);
+  if (slot != NULL && slot->connections > 0) {
+    --slot->connections;
+  }
+}
+
+unsigned long LimitTable::getConnections(unsigned long hash) const {
+  const Slot* slot = find(hash);
+  return slot != NULL ? slot->connections : 0;
+}
+
+std::size_t LimitTable::getCapacity() const { return m_slots.size(); }
+
+std::size_t LimitTable::getUsed() const { return m_used; }
+
+// 64-bit FNV-1a; 0 marks an empty slot, so a key hashing to it moves to 1.
+unsigned long LimitTable::hashKey(const std::string& key) {
+  unsigned long hash = K_FNV_OFFSET_BASIS;
+  for (std::size_t i = 0; i < key.size(); ++i) {
+    hash ^= static_cast<unsigned char>(key[i]);
+    hash *= K_FNV_PRIME;
+  }
+  return hash != 0 ? hash : 1;
+}
+
+LimitTable::Slot* LimitTable::find(unsigned long hash) {
+  return const_cast<Slot*>(
+      static_cast<const LimitTable*>(this)->find(hash));
+}
+
+const LimitTable::Slot* LimitTable::find(unsigned long hash) const {
+  for (std::size_t i = 0; i < K_PROBE_LIMIT; ++i) {
+    const Slot& slot = m_slots[(hash + i) & m_mask];
+    if (slot.hash == hash) {
+      return &slot;
+    }
+  }
+  return NULL;
+}
+
+LimitTable::Slot* LimitTable::claim(unsigned long hash,
+                                    unsigned long nowMillis) {
+  Slot* victim = NULL;
+  for (std::size_t i = 0; i < K_PROBE_LIMIT; ++i) {
+    Slot& slot = m_slots[(hash + i) & m_mask];
+    if (slot.hash == 0) {
+      ++m_used;
+      victim = &slot;
+      break;
+    }
+    if (slot.connections == 0 &&
+        (victim == NULL || slot.lastMillis < victim->lastMillis)) {
+      victim = &slot;
+    }
+  }
+  if (victim != NULL) {
+    victim->hash = hash;
+    victim->lastMillis = nowMillis;
+    victim->excess = 0;
+    victim->connections = 0;
+  }
+  return victim;
+}
+
+}  // namespace primitives
+}  // namespace limits
+}  // namespace infrastructure
@@ -0,0 +1,85 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   LimitTable.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:16:08 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:16:08 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef LIMIT_TABLE_HPP
+#define LIMIT_TABLE_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace infrastructure {
+namespace limits {
+namespace primitives {
+
+// The state of one limit zone: a flat, power-of-two array of fixed-size
+// slots sized once from the zone's configured memory and never grown. A
+// key is found by its 64-bit hash within a short probe window starting at
+// hash & mask, so a lookup touches a couple of cache lines and allocates
+// nothing. When the window is full the least recently used slot that holds
+// no connections is reused; when every slot in it holds connections the
+// table is full and the caller refuses the request, as nginx does when its
+// zone runs out of memory.
+//
+// Request slots run nginx's leaky bucket: "excess" counts queued requests
+// in thousandths, drains at the zone rate and grows by 1000 per request.
+class LimitTable {
+ public:
+  enum Verdict { VERDICT_PASS, VERDICT_BUSY, VERDICT_FULL };
+
+  static const std::size_t K_PROBE_LIMIT = 8;
+  static const unsigned long K_EXCESS_SCALE = 1000;
+
+  explicit LimitTable(std::size_t bytes);
+  ~LimitTable();
+
+  Verdict checkRequest(unsigned long hash, unsigned long rate,
+                       unsigned long burst, unsigned long nowMillis,
+                       unsigned long& excess);
+  void accountRequest(unsigned long hash, unsigned long excess,
+                      unsigned long nowMillis);
+
+  Verdict acquireConnection(unsigned long hash, unsigned long limit,
+                            unsigned long nowMillis);
+  void releaseConnection(unsigned long hash);
+  unsigned long getConnections(unsigned long hash) const;
+
+  std::size_t getCapacity() const;
+  std::size_t getUsed() const;
+
+  static unsigned long hashKey(const std::string& key);
+
+ private:
+  struct Slot {
+    unsigned long hash;
+    unsigned long lastMillis;
+    unsigned long excess;
+    unsigned long connections;
+  };
+
+  LimitTable(const LimitTable&);
+  LimitTable& operator=(const LimitTable&);
+
+  Slot* find(unsigned long hash);
+  const Slot* find(unsigned long hash) const;
+  Slot* claim(unsigned long hash, unsigned long nowMillis);
+
+  std::vector<Slot> m_slots;
+  std::size_t m_mask;
+  std::size_t m_used;
+};
+
+}  // namespace primitives
+}  // namespace limits
+}  // namespace infrastructure
+
+#endif  // LIMIT_TABLE_HPP
@@ -0,0 +1,74 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   AccessLog.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 08:05:12 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 08:05:12 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/logging/AccessLog.hpp"
+
+namespace infrastructure {
+namespace logging {
+
+const std::size_t AccessLog::K_FLUSH_THRESHOLD;
+
+AccessLog::AccessLog() {}
+
+AccessLog::~AccessLog() { close(); }
+
+bool AccessLog::open(const std::string& path, const std::string& pattern) {
+  close();
+  m_file.open(path.c_str(), std::ios::out | std::ios::app);
+  if (!m_file.is_open()) {
+    m_file.clear();
+    return false;
+  }
+  m_path = path;
+  m_format.compile(pattern);
+  m_buffer.reserve(K_FLUSH_THRESHOLD);
+  return true;
+}
+
+void AccessLog::close() {
+  if (!m_file.is_open()) {
+    return;
+  }
+  flush();
+  m_file.close();
+  m_file.clear();
+  m_path.clear();
+}
+
+bool AccessLog::isOpen() const { return m_file.is_open(); }
+
+void AccessLog::write(const AccessLogEntry& entry) {
+  if (!m_file.is_open()) {
+    return;
+  }
+  m_buffer += m_format.format(entry);
+  m_buffer += '\n';
+  if (m_buffer.size() >= K_FLUSH_THRESHOLD) {
+    flush();
+  }
+}
+
+void AccessLog::flush() {
+  if (m_buffer.empty() || !m_file.is_open()) {
+    return;
+  }
+  m_file.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+  m_file.flush();
+  m_buffer.clear();
+}
+
+const std::string& AccessLog::getPath() const { return m_path; }
+
+const AccessLogFormat& AccessLog::getFormat() const { return m_format; }
+
+}  // namespace logging
+}  // namespace infrastructure
@@ -0,0 +1,58 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   AccessLog.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 08:05:12 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 08:05:12 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef ACCESS_LOG_HPP
+#define ACCESS_LOG_HPP
+
+#include "infrastructure/logging/AccessLogFormat.hpp"
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+namespace infrastructure {
+namespace logging {
+
+// Lines are buffered and written out once the buffer fills or when the
+// event loop calls flush() at the end of an iteration, so a burst of
+// requests costs one write instead of one per request.
+class AccessLog {
+ public:
+  static const std::size_t K_FLUSH_THRESHOLD = 8192;
+
+  AccessLog();
+  ~AccessLog();
+
+  bool open(const std::string& path, const std::string& pattern);
+  void close();
+  bool isOpen() const;
+
+  void write(const AccessLogEntry& entry);
+  void flush();
+
+  const std::string& getPath() const;
+  const AccessLogFormat& getFormat() const;
+
+ private:
+  AccessLog(const AccessLog&);
+  AccessLog& operator=(const AccessLog&);
+
+  std::ofstream m_file;
+  std::string m_path;
+  AccessLogFormat m_format;
+  std::string m_buffer;
+};
+
+}  // namespace logging
+}  // namespace infrastructure
+
+#endif  // ACCESS_LOG_HPP
@@ -0,0 +1,304 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   AccessLogFormat.cpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 07:48:31 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 07:48:31 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/logging/AccessLogFormat.hpp"
+
+#include <cctype>
+
+namespace infrastructure {
+namespace logging {
+
+namespace {
+
+typedef network::primitives::RequestTiming RequestTiming;
+
+struct VariableName {
+  const char* name;
+  AccessLogFormat::Variable variable;
+};
+
+const VariableName K_VARIABLES[] = {
+    {"remote_addr", AccessLogFormat::VAR_REMOTE_ADDR},
+    {"time_local", AccessLogFormat::VAR_TIME_LOCAL},
+    {"time_iso8601", AccessLogFormat::VAR_TIME_ISO8601},
+    {"request", AccessLogFormat::VAR_REQUEST},
+    {"request_method", AccessLogFormat::VAR_REQUEST_METHOD},
+    {"request_uri", AccessLogFormat::VAR_REQUEST_URI},
+    {"uri", AccessLogFormat::VAR_URI},
+    {"args", AccessLogFormat::VAR_ARGS},
+    {"server_protocol", AccessLogFormat::VAR_SERVER_PROTOCOL},
+    {"status", AccessLogFormat::VAR_STATUS},
+    {"body_bytes_sent", AccessLogFormat::VAR_BODY_BYTES_SENT},
+    {"bytes_sent", AccessLogFormat::VAR_BYTES_SENT},
+    {"request_length", AccessLogFormat::VAR_REQUEST_LENGTH},
+    {"host", AccessLogFormat::VAR_HOST},
+    {"http_referer", AccessLogFormat::VAR_HTTP_REFERER},
+    {"http_user_agent", AccessLogFormat::VAR_HTTP_USER_AGENT},
+    {"request_time", AccessLogFormat::VAR_REQUEST_TIME},
+    {"upstream_response_time", AccessLogFormat::VAR_UPSTREAM_RESPONSE_TIME},
+    {"header_time", AccessLogFormat::VAR_HEADER_TIME},
+    {"body_time", AccessLogFormat::VAR_BODY_TIME},
+    {"route_time", AccessLogFormat::VAR_ROUTE_TIME},
+    {"handler_time", AccessLogFormat::VAR_HANDLER_TIME},
+    {"ttfb", AccessLogFormat::VAR_TTFB},
+    {"write_time", AccessLogFormat::VAR_WRITE_TIME},
+    {"upstream_cache_status", AccessLogFormat::VAR_UPSTREAM_CACHE_STATUS}};
+
+const std::size_t K_TIME_BUFFER_SIZE = 64;
+
+bool isNameChar(char c) {
+  return std::isalnum(static_cast<unsigned char>(c)) != 0 || c == '_';
+}
+
+void appendUnsigned(std::string& line, unsigned long value) {
+  char digits[24];
+  std::size_t length = 0;
+  do {
+    digits[length++] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  while (length > 0) {
+    line += digits[--length];
+  }
+}
+
+void appendTime(std::string& line, std::time_t when, const char* layout) {
+  struct tm local;
+  char buffer[K_TIME_BUFFER_SIZE];
+  if (localtime_r(&when, &local) == NULL ||
+      std::strftime(buffer, sizeof(buffer), layout, &local) == 0) {
+    line += '-';
+    return;
+  }
+  line += buffer;
+}
+
+}  // namespace
+
+AccessLogEntry::AccessLogEntry()
+    : status(0),
+      requestLength(0),
+      bytesSent(0),
+      bodyBytesSent(0),
+      time(0),
+      timing(NULL) {}
+
+AccessLogFormat::AccessLogFormat() : m_unknownVariables(0) {}
+
+AccessLogFormat::AccessLogFormat(const std::string& pattern)
+    : m_unknownVariables(0) {
+  compile(pattern);
+}
+
+AccessLogFormat::~AccessLogFormat() {}
+
+// "$name" ends at the first character that cannot be part of a name;
+// "${name}" allows a variable to be followed directly by name characters.
+void AccessLogFormat::compile(const std::string& pattern) {
+  m_segments.clear();
+  m_unknownVariables = 0;
+
+  std::string literal;
+  std::size_t pos = 0;
+  while (pos < pattern.size()) {
+    if (pattern[pos] != '$') {
+      literal += pattern[pos++];
+      continue;
+    }
+
+    const bool braced = pos + 1 < pattern.size() && pattern[pos + 1] == '{';
+    std::size_t start = pos + (braced ? 2 : 1);
+    std::size_t end = start;
+    while (end < pattern.size() && isNameChar(pattern[end])) {
+      ++end;
+    }
+    if (end == start || (braced && (end >= pattern.size() ||
+                                    pattern[end] != '}'))) {
+      literal += pattern[pos++];
+      continue;
+    }
+
+    pushLiteral(literal);
+    literal.clear();
+
+    Segment segment;
+    segment.variable = lookupVariable(pattern.substr(start, end - start));
+    if (segment.variable == VAR_UNKNOWN) {
+      ++m_unknownVariables;
+    }
+    m_segments.push_back(segment);
+    pos = braced ? end + 1 : end;
+  }
+  pushLiteral(literal);
+}
+
+std::string AccessLogFormat::format(const AccessLogEntry& entry) const {
+  std::string line;
+  for (std::vector<Segment>::const_iterator it = m_segments.begin();
+       it != m_segments.end(); ++it) {
+    if (it->variable == VAR_UNKNOWN && !it->literal.empty()) {
+      line += it->literal;
+    } else {
+      appendVariable(line, it->variable, entry);
+    }
+  }
+  return line;
+}
+
+std::size_t AccessLogFormat::getSegmentCount() const {
+  return m_segments.size();
+}
+
+std::size_t AccessLogFormat::getUnknownVariableCount() const {
+  return m_unknownVariables;
+}
+
+AccessLogFormat::Variable AccessLogFormat::lookupVariable(
+    const std::string& name) {
+  const std::size_t count = sizeof(K_VARIABLES) / sizeof(K_VARIABLES[0]);
+  for (std::size_t i = 0; i < count; ++i) {
+    if (name == K_VARIABLES[i].name) {
+      return K_VARIABLES[i].variable;
+    }
+  }
+  return VAR_UNKNOWN;
+}
+
+void AccessLogFormat::pushLiteral(const std::string& text) {
+  if (text.empty()) {
+    return;
+  }
+  Segment segment;
+  segment.variable = VAR_UNKNOWN;
+  segment.literal = text;
+  m_segments.push_back(segment);
+}
+
+void AccessLogFormat::appendVariable(std::string& line, Variable variable,
+                                     const AccessLogEntry& entry) {
+  switch (variable) {
+    case VAR_REMOTE_ADDR:
+      appendOrDash(line, entry.remoteAddress);
+      break;
+    case VAR_TIME_LOCAL:
+      appendTime(line, entry.time, "%d/%b/%Y:%H:%M:%S %z");
+      break;
+    case VAR_TIME_ISO8601:
+      appendTime(line, entry.time, "%Y-%m-%dT%H:%M:%S%z");
+      break;
+    case VAR_REQUEST:
+      line += entry.method;
+      line += ' ';
+      line += entry.uri;
+      line += entry.query;
+      line += ' ';
+      line += entry.protocol;
+      break;
+    case VAR_REQUEST_METHOD:
+      appendOrDash(line, entry.method);
+      break;
+    case VAR_REQUEST_URI:
+      line += entry.uri;
+      line += entry.query;
+      break;
+    case VAR_URI:
+      appendOrDash(line, entry.uri);
+      break;
+    case VAR_ARGS:
+      appendOrDash(line, entry.query.empty() ? entry.query
+                                             : entry.query.substr(1));
+      break;
+    case VAR_SERVER_PROTOCOL:
+      appendOrDash(line, entry.protocol);
+      break;
+    case VAR_STATUS:
+      appendUnsigned(line, entry.status);
+      break;
+    case VAR_BODY_BYTES_SENT:
+      appendUnsigned(line, entry.bodyBytesSent);
+      break;
+    case VAR_BYTES_SENT:
+      appendUnsigned(line, entry.bytesSent);
+      break;
+    case VAR_REQUEST_LENGTH:
+      appendUnsigned(line, entry.requestLength);
+      break;
+    case VAR_HOST:
+      appendOrDash(line, entry.host);
+      break;
+    case VAR_HTTP_REFERER:
+      appendOrDash(line, entry.referer);
+      break;
+    case VAR_HTTP_USER_AGENT:
+      appendOrDash(line, entry.userAgent);
+      break;
+    case VAR_REQUEST_TIME:
+      appendPhase(line, entry, RequestTiming::PHASE_FIRST_BYTE,
+                  RequestTiming::PHASE_LAST_BYTE_WRITTEN);
+      break;
+    case VAR_UPSTREAM_RESPONSE_TIME:
+      appendPhase(line, entry, RequestTiming::PHASE_UPSTREAM_START,
+                  RequestTiming::PHASE_UPSTREAM_DONE);
+      break;
+    case VAR_HEADER_TIME:
+      appendPhase(line, entry, RequestTiming::PHASE_FIRST_BYTE,
+                  RequestTiming::PHASE_HEADERS_COMPLETE);
+      break;
+    case VAR_BODY_TIME:
+      appendPhase(line, entry, RequestTiming::PHASE_HEADERS_COMPLETE,
+                  RequestTiming::PHASE_BODY_COMPLETE);
+      break;
+    case VAR_ROUTE_TIME:
+      appendPhase(line, entry, RequestTiming::PHASE_BODY_COMPLETE,
+                  RequestTiming::PHASE_ROUTE_MATCHED);
+      break;
+    case VAR_HANDLER_TIME:
+      appendPhase(line, entry, RequestTiming::PHASE_ROUTE_MATCHED,
+                  RequestTiming::PHASE_HANDLER_DONE);
+      break;
+    case VAR_TTFB:
+      appendPhase(line, entry, RequestTiming::PHASE_FIRST_BYTE,
+                  RequestTiming::PHASE_FIRST_BYTE_WRITTEN);
+      break;
+    case VAR_WRITE_TIME:
+      appendPhase(line, entry, RequestTiming::PHASE_FIRST_BYTE_WRITTEN,
+                  RequestTiming::PHASE_LAST_BYTE_WRITTEN);
+      break;
+    case VAR_UPSTREAM_CACHE_STATUS:
+      appendOrDash(line, entry.cacheStatus);
+      break;
+    case VAR_UNKNOWN:
+      line += '-';
+      break;
+  }
+}
+
+void AccessLogFormat::appendPhase(std::string& line,
+                                  const AccessLogEntry& entry,
+                                  RequestTiming::Phase from,
+                                  RequestTiming::Phase to) {
+  line += RequestTiming::formatSeconds(
+      entry.timing != NULL ? entry.timing->elapsed(from, to)
+                           : RequestTiming::K_UNSET);
+}
+
+void AccessLogFormat::appendOrDash(std::string& line,
+                                   const std::string& value) {
+  if (value.empty()) {
+    line += '-';
+  } else {
+    line += value;
+  }
+}
+
+}  // namespace logging
+}  // namespace infrastructure
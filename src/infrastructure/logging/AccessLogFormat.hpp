@@ -0,0 +1,115 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   AccessLogFormat.hpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 07:48:31 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 07:48:31 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef ACCESS_LOG_FORMAT_HPP
+#define ACCESS_LOG_FORMAT_HPP
+
+#include "infrastructure/network/primitives/RequestTiming.hpp"
+
+#include <cstddef>
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace infrastructure {
+namespace logging {
+
+struct AccessLogEntry {
+  std::string remoteAddress;
+  std::string method;
+  std::string uri;
+  std::string query;
+  std::string protocol;
+  std::string host;
+  std::string referer;
+  std::string userAgent;
+  std::string cacheStatus;
+  unsigned int status;
+  std::size_t requestLength;
+  std::size_t bytesSent;
+  std::size_t bodyBytesSent;
+  std::time_t time;
+  const network::primitives::RequestTiming* timing;
+
+  AccessLogEntry();
+};
+
+// A log_format pattern split once into literal text and variables, so a
+// request line is rendered without scanning the pattern again. Variables
+// follow nginx naming; the phase timings ($header_time, $ttfb, ...) come
+// from RequestTiming. An unknown variable renders as "-".
+class AccessLogFormat {
+ public:
+  enum Variable {
+    VAR_REMOTE_ADDR,
+    VAR_TIME_LOCAL,
+    VAR_TIME_ISO8601,
+    VAR_REQUEST,
+    VAR_REQUEST_METHOD,
+    VAR_REQUEST_URI,
+    VAR_URI,
+    VAR_ARGS,
+    VAR_SERVER_PROTOCOL,
+    VAR_STATUS,
+    VAR_BODY_BYTES_SENT,
+    VAR_BYTES_SENT,
+    VAR_REQUEST_LENGTH,
+    VAR_HOST,
+    VAR_HTTP_REFERER,
+    VAR_HTTP_USER_AGENT,
+    VAR_REQUEST_TIME,
+    VAR_UPSTREAM_RESPONSE_TIME,
+    VAR_HEADER_TIME,
+    VAR_BODY_TIME,
+    VAR_ROUTE_TIME,
+    VAR_HANDLER_TIME,
+    VAR_TTFB,
+    VAR_WRITE_TIME,
+    VAR_UPSTREAM_CACHE_STATUS,
+    VAR_UNKNOWN
+  };
+
+  AccessLogFormat();
+  explicit AccessLogFormat(const std::string& pattern);
+  ~AccessLogFormat();
+
+  void compile(const std::string& pattern);
+  std::string format(const AccessLogEntry& entry) const;
+
+  std::size_t getSegmentCount() const;
+  std::size_t getUnknownVariableCount() const;
+
+  static Variable lookupVariable(const std::string& name);
+
+ private:
+  struct Segment {
+    Variable variable;
+    std::string literal;
+  };
+
+  static void appendVariable(std::string& line, Variable variable,
+                             const AccessLogEntry& entry);
+  static void appendPhase(std::string& line, const AccessLogEntry& entry,
+                          network::primitives::RequestTiming::Phase from,
+                          network::primitives::RequestTiming::Phase to);
+  static void appendOrDash(std::string& line, const std::string& value);
+
+  void pushLiteral(const std::string& text);
+
+  std::vector<Segment> m_segments;
+  std::size_t m_unknownVariables;
+};
+
+}  // namespace logging
+}  // namespace infrastructure
+
+#endif  // ACCESS_LOG_FORMAT_HPP
@@ -27,17 +27,22 @@ const infrastructure::logging::Logger::LogConfig
 
 infrastructure::logging::Logger::Logger(
     application::ports::IStreamWriter& consoleWriter, application::ports::IFileWriter& logFile)
-    : m_consoleWriter(consoleWriter), m_logFile(logFile) {
+    : m_consoleWriter(consoleWriter), m_logFile(logFile), m_level(DEBUG) {
   log(INFO, "Logger initialized.");
 }
 
 infrastructure::logging::Logger::Logger(const Logger& other)
-    : m_consoleWriter(other.m_consoleWriter), m_logFile(other.m_logFile) {}
+    : m_consoleWriter(other.m_consoleWriter),
+      m_logFile(other.m_logFile),
+      m_level(other.m_level) {}
 
 infrastructure::logging::Logger::~Logger() {}
 
 void infrastructure::logging::Logger::log(LogLevel level,
                                           const std::string& msg) {
+  if (!isEnabled(level)) {
+    return;
+  }
   this->m_consoleWriter.print(LOG_CONFIG[level].stream, formatMsg(msg, level ,true), true);
   this->m_logFile.write(formatMsg(msg, level, false), true);
 }
@@ -58,6 +63,14 @@ void infrastructure::logging::Logger::error(const std::string& msg) {
   log(ERROR, msg);
 }
 
+bool infrastructure::logging::Logger::isEnabled(LogLevel level) const {
+  return level >= m_level;
+}
+
+void infrastructure::logging::Logger::setLevel(LogLevel level) {
+  m_level = level;
+}
+
 std::string infrastructure::logging::Logger::formatMsg(const std::string& msg,
                                                        LogLevel level, bool isConsole) {
   std::ostringstream oss;
@@ -35,6 +35,9 @@ class Logger : public application::ports::ILogger {
   void warn(const std::string& msg);
   void error(const std::string& msg);
 
+  bool isEnabled(LogLevel level) const;
+  void setLevel(LogLevel level);
+
  private:
   struct LogConfig {
     std::string name;
@@ -52,6 +55,7 @@ class Logger : public application::ports::ILogger {
 
   application::ports::IStreamWriter& m_consoleWriter;
   application::ports::IFileWriter& m_logFile;
+  LogLevel m_level;
 
   static const LogConfig LOG_CONFIG[];
   static const size_t K_TIME_STRING_LENGTH = 26;
@@ -13,7 +13,6 @@
 #include "domain/configuration/entities/LocationConfig.hpp"
 #include "domain/configuration/exceptions/LocationConfigException.hpp"
 #include "domain/configuration/value_objects/CgiConfig.hpp"
-#include "domain/configuration/value_objects/Route.hpp"
 #include "domain/configuration/value_objects/UploadConfig.hpp"
 #include "domain/filesystem/value_objects/Path.hpp"
 #include "domain/http/entities/HttpRequest.hpp"
@@ -21,7 +20,10 @@
 #include "domain/http/exceptions/HttpRequestException.hpp"
 #include "domain/http/value_objects/HttpMethod.hpp"
 #include "domain/http/value_objects/RouteMatchInfo.hpp"
+#include "domain/shared/utils/StringUtils.hpp"
 #include "domain/shared/value_objects/ErrorCode.hpp"
+#include "infrastructure/cache/primitives/CacheKey.hpp"
+#include "infrastructure/cache/primitives/CachePolicy.hpp"
 #include "infrastructure/cgi/adapters/CgiExecutor.hpp"
 #include "infrastructure/cgi/exceptions/CgiExecutionException.hpp"
 #include "infrastructure/cgi/primitives/CgiRequest.hpp"
@@ -29,12 +31,19 @@
 #include "infrastructure/filesystem/adapters/DirectoryLister.hpp"
 #include "infrastructure/filesystem/adapters/FileSystemHelper.hpp"
 #include "infrastructure/http/RequestParser.hpp"
+#include "infrastructure/http2/primitives/Http2Frame.hpp"
 #include "infrastructure/network/adapters/ConnectionHandler.hpp"
 #include "infrastructure/network/adapters/TcpSocket.hpp"
 #include "infrastructure/network/exceptions/ConnectionException.hpp"
+#include "infrastructure/network/primitives/SocketEvent.hpp"
+#include "infrastructure/proxy/primitives/UpstreamRequest.hpp"
+#include "infrastructure/tls/adapters/TlsChannel.hpp"
 
+#include <algorithm>
+#include <cassert>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
 #include <fstream>
 #include <limits.h>
@@ -46,18 +55,75 @@ namespace infrastructure {
 namespace network {
 namespace adapters {
 
+// Indexed by HttpMethod::Method; NULL entries answer 405.
+const ConnectionHandler::MethodHandler ConnectionHandler::K_METHOD_HANDLERS
+    [domain::http::value_objects::HttpMethod::METHOD_UNKNOWN + 1] = {
+        &ConnectionHandler::handleGetRequest,     // GET
+        &ConnectionHandler::handlePostRequest,    // POST
+        NULL,                                     // PUT
+        &ConnectionHandler::handleDeleteRequest,  // DELETE
+        &ConnectionHandler::handleGetRequest,     // HEAD
+        NULL,                                     // OPTIONS
+        NULL,                                     // TRACE
+        NULL,                                     // CONNECT
+        NULL,                                     // PATCH
+        NULL};                                    // UNKNOWN
+
 ConnectionHandler::ConnectionHandler(
     TcpSocket* socket,
     const domain::configuration::entities::ServerConfig* serverConfig,
     application::ports::ILogger& logger,
-    application::ports::IConfigProvider& configProvider)
+    domain::configuration::entities::ConfigSnapshot& configSnapshot,
+    cgi::adapters::FastCgiClient& fastCgiClient,
+    cgi::adapters::CgiWorkerPool& cgiWorkerPool,
+    cgi::adapters::CgiExecutor& cgiExecutor,
+    proxy::adapters::UpstreamPool& upstreamPool,
+    cache::adapters::ResponseCache& responseCache,
+    limits::adapters::RequestLimiter& requestLimiter,
+    primitives::ServerMetrics& metrics, logging::AccessLog& accessLog)
     : m_logger(logger),
-      m_configProvider(configProvider),
+      m_configSnapshot(configSnapshot),
+      m_fastCgiClient(fastCgiClient),
+      m_cgiWorkerPool(cgiWorkerPool),
+      m_cgiExecutor(cgiExecutor),
+      m_upstreamPool(upstreamPool),
+      m_responseCache(responseCache),
+      m_requestLimiter(requestLimiter),
+      m_metrics(metrics),
+      m_accessLog(accessLog),
       m_socket(socket),
       m_serverConfig(serverConfig),
+      m_listenPort(0),
+      m_requestServer(serverConfig),
+      m_maxRequestSize(0),
       m_state(STATE_READING_REQUEST),
       m_lastActivityTime(std::time(NULL)),
-      m_responseOffset(0) {
+      m_requestStartTime(m_lastActivityTime),
+      m_requestLength(0),
+      m_responseHeaderBytes(0),
+      m_responseBytesSent(0),
+      m_headersReceived(false),
+      m_requestCount(0),
+      m_readBuffer(K_READ_BUFFER_SIZE),
+      m_responseOffset(0),
+      m_http2(NULL),
+      m_http2Stream(0),
+      m_http2Enabled(false),
+      m_cgiStream(NULL),
+      m_proxySession(NULL),
+      m_fastCgiSession(NULL),
+      m_workerSession(NULL),
+      m_upstreamPlan(NULL),
+      m_streamChunked(false),
+      m_streamHasLength(false),
+      m_streamRemaining(0),
+      m_cacheFill(NULL),
+      m_cacheConfig(NULL),
+      m_cacheLockHeld(false),
+      m_cacheBypass(false),
+      m_cacheWaitStart(0),
+      m_limitWakeMillis(0),
+      m_limitsPassed(false) {
   if (socket == NULL) {
     throw exceptions::ConnectionException(
         "Socket pointer cannot be NULL",
@@ -70,11 +136,17 @@ ConnectionHandler::ConnectionHandler(
         exceptions::ConnectionException::INVALID_STATE);
   }
 
-  m_requestBuffer.reserve(K_READ_BUFFER_SIZE);
+  m_maxRequestSize = m_serverConfig->getClientMaxBodySize().getBytes();
+  m_parser.setMaxHeaderSize(m_maxRequestSize);
+  m_parser.setMaxBodySize(m_maxRequestSize);
+  if (m_socket->isTls()) {
+    m_state = STATE_TLS_HANDSHAKE;
+  }
 
-  std::ostringstream oss;
-  oss << "ConnectionHandler created for " << getRemoteAddress();
-  m_logger.debug(oss.str());
+  WEBSERV_LOG_DEBUG(m_logger,
+                    "ConnectionHandler created for " << getRemoteAddress());
+
+  m_configSnapshot.acquire();
 }
 
 ConnectionHandler::~ConnectionHandler() {
@@ -85,23 +157,77 @@ ConnectionHandler::~ConnectionHandler() {
     remoteAddr = "unknown (disconnected)";
   }
 
-  std::ostringstream oss;
-  oss << "ConnectionHandler destroyed for " << remoteAddr;
-  m_logger.debug(oss.str());
+  WEBSERV_LOG_DEBUG(m_logger, "ConnectionHandler destroyed for " << remoteAddr);
+
+  finishCacheFill(false);
+  m_requestLimiter.release(m_limitLease);
+  if (m_cgiStream != NULL) {
+    m_cgiExecutor.release(m_cgiStream);
+    m_cgiStream = NULL;
+  }
+  delete m_proxySession;
+  m_proxySession = NULL;
+  delete m_fastCgiSession;
+  m_fastCgiSession = NULL;
+  delete m_workerSession;
+  m_workerSession = NULL;
+  releaseRetiredUpstreams();
+  delete m_http2;
+  m_http2 = NULL;
 
   delete m_socket;
   m_socket = NULL;
+
+  m_configSnapshot.release();
 }
 
+// Once a connection has switched to HTTP/2, by prior knowledge, by upgrade
+// or through ALPN, the session drives it for the rest of its life.
 void ConnectionHandler::processEvent() {
   updateLastActivity(std::time(NULL));
 
+  if (m_http2 == NULL) {
+    processHttp1Event();
+  }
+  if (m_http2 != NULL) {
+    processHttp2Event();
+  }
+}
+
+void ConnectionHandler::enableHttp2() { m_http2Enabled = true; }
+
+void ConnectionHandler::setListenBinding(const std::string& address,
+                                         unsigned int port) {
+  m_listenAddress = address;
+  m_listenPort = port;
+
+  // Host is only known once the headers are in, so until then reads are
+  // bounded by the largest limit among the servers sharing this socket.
+  const domain::configuration::entities::ConfigSnapshot::Servers& servers =
+      m_configSnapshot.getServers();
+  for (size_t i = 0; i < servers.size(); ++i) {
+    if (servers[i]->hasListenDirective(address, port)) {
+      m_maxRequestSize =
+          std::max(m_maxRequestSize,
+                   static_cast<size_t>(
+                       servers[i]->getClientMaxBodySize().getBytes()));
+    }
+  }
+  m_parser.setMaxHeaderSize(m_maxRequestSize);
+  m_parser.setMaxBodySize(m_maxRequestSize);
+}
+
+void ConnectionHandler::processHttp1Event() {
   try {
     bool continueProcessing = true;
-    while (continueProcessing) {
+    while (continueProcessing && m_http2 == NULL) {
       continueProcessing = false;
 
       switch (m_state) {
+        case STATE_TLS_HANDSHAKE:
+          continueProcessing = advanceHandshake();
+          break;
+
         case STATE_READING_REQUEST:
           handleRead();
           if (m_state == STATE_PROCESSING) {
@@ -111,14 +237,31 @@ void ConnectionHandler::processEvent() {
 
         case STATE_PROCESSING:
           processRequest();
-          m_responseBuffer = m_response.serialize();
-          m_responseOffset = 0;
-          m_state = STATE_WRITING_RESPONSE;
+          if (m_state == STATE_CACHE_WAIT || m_state == STATE_LIMIT_DELAY) {
+            break;
+          }
+          if (isStreamingUpstream()) {
+            m_state = STATE_PROXYING;
+          } else {
+            prepareResponse();
+          }
           continueProcessing = true;
           break;
 
+        case STATE_PROXYING:
+          if (advanceUpstream()) {
+            prepareResponse();
+            continueProcessing = true;
+          }
+          break;
+
+        case STATE_CACHE_WAIT:
+        case STATE_LIMIT_DELAY:
+          break;
+
         case STATE_WRITING_RESPONSE:
           handleWrite();
+          continueProcessing = resumePipelinedRequest();
           break;
 
         case STATE_KEEP_ALIVE:
@@ -128,14 +271,23 @@ void ConnectionHandler::processEvent() {
           }
           break;
 
+        case STATE_HTTP2:
         case STATE_CLOSING:
           break;
       }
+
+      // Plaintext already decrypted by TLS never wakes the multiplexer.
+      if (!continueProcessing &&
+          (m_state == STATE_READING_REQUEST || m_state == STATE_KEEP_ALIVE) &&
+          m_socket->hasPendingInput()) {
+        continueProcessing = true;
+      }
     }
   } catch (const domain::http::exceptions::HttpRequestException& ex) {
     m_logger.error(std::string("Request error: ") + ex.what());
     generateErrorResponse(
         domain::shared::value_objects::ErrorCode::badRequest(), ex.what());
+    m_response.setConnection("close");
     m_responseBuffer = m_response.serialize();
     m_responseOffset = 0;
     m_state = STATE_WRITING_RESPONSE;
@@ -143,23 +295,36 @@ void ConnectionHandler::processEvent() {
     m_logger.error(std::string("Connection error: ") + ex.what());
 
     const domain::configuration::entities::ServerConfig* config =
-        resolveVirtualHost();
+        m_requestServer;
     const domain::filesystem::value_objects::Path requestPath =
         domain::filesystem::value_objects::Path::fromString(
             m_request.getPath().toString(), true);
 
     const domain::configuration::entities::LocationConfig* matchedLocation =
         findMatchingLocation(config, requestPath.toString());
-    handlePayloadTooLarge(*matchedLocation);
+    if (matchedLocation != NULL) {
+      handlePayloadTooLarge(*matchedLocation);
+    } else {
+      generateErrorResponse(
+          domain::shared::value_objects::ErrorCode::payloadTooLarge(),
+          "Request entity too large");
+    }
+    m_response.setConnection("close");
 
     m_responseBuffer = m_response.serialize();
     m_responseOffset = 0;
     m_state = STATE_WRITING_RESPONSE;
   } catch (const std::exception& ex) {
     m_logger.error(std::string("Unexpected error: ") + ex.what());
+    if (isStreamingUpstream()) {
+      m_responseBuffer.clear();
+      m_state = STATE_CLOSING;
+      return;
+    }
     generateErrorResponse(
         domain::shared::value_objects::ErrorCode::internalServerError(),
         "Internal Server Error");
+    m_response.setConnection("close");
     m_responseBuffer = m_response.serialize();
     m_responseOffset = 0;
     m_state = STATE_WRITING_RESPONSE;
@@ -181,21 +346,292 @@ std::string ConnectionHandler::getRemoteAddress() const {
 }
 
 bool ConnectionHandler::isTimedOut(time_t currentTime) const {
-  const time_t timeout = (m_state == STATE_KEEP_ALIVE) ? K_KEEPALIVE_TIMEOUT
-                                                       : K_CONNECTION_TIMEOUT;
-  return (currentTime - m_lastActivityTime) > timeout;
+  time_t since = m_lastActivityTime;
+  unsigned int timeout = m_requestServer->getSendTimeout();
+
+  if (m_state == STATE_PROXYING || m_state == STATE_CACHE_WAIT ||
+      m_state == STATE_LIMIT_DELAY) {
+    return false;
+  }
+
+  if (m_state == STATE_KEEP_ALIVE) {
+    timeout = m_requestServer->getKeepaliveTimeout();
+  } else if (m_state == STATE_HTTP2) {
+    timeout = m_http2->getActiveStreamCount() == 0
+                  ? m_requestServer->getKeepaliveTimeout()
+                  : m_requestServer->getClientBodyTimeout();
+  } else if (m_state == STATE_READING_REQUEST ||
+             m_state == STATE_TLS_HANDSHAKE) {
+    if (m_headersReceived) {
+      timeout = m_requestServer->getClientBodyTimeout();
+    } else {
+      since = m_requestStartTime;
+      timeout = m_serverConfig->getClientHeaderTimeout();
+    }
+  }
+
+  return (currentTime - since) > static_cast<time_t>(timeout);
+}
+
+// An HTTP/2 connection keeps reading while its requests are served, so
+// window updates and resets arrive; it only stops while the client is
+// not taking the frames already queued for it.
+bool ConnectionHandler::wantsRead() const {
+  if (m_http2 != NULL) {
+    return m_http2->outputSize() <
+           http2::adapters::Http2Session::K_OUTPUT_HIGH_WATER;
+  }
+  return !isStreamingUpstream() && !isWaitingForCache() && !isDelayedByLimit();
+}
+
+bool ConnectionHandler::wantsWrite() const {
+  if (m_state == STATE_TLS_HANDSHAKE) {
+    return m_socket->getTls()->wantsWrite();
+  }
+  if (m_http2 != NULL) {
+    return m_http2->hasOutput();
+  }
+  return m_state == STATE_WRITING_RESPONSE &&
+         m_responseOffset < m_responseBuffer.size();
+}
+
+bool ConnectionHandler::isStreamingUpstream() const {
+  return m_cgiStream != NULL || m_proxySession != NULL ||
+         m_fastCgiSession != NULL || m_workerSession != NULL;
+}
+
+// Backpressure: a CGI pipe or proxied upstream is only polled for the body
+// once everything read from it so far has reached the client socket. A
+// FastCGI server or CGI worker is read from while request records are still
+// going out.
+int ConnectionHandler::getUpstreamEvents() const {
+  if (m_state == STATE_PROXYING && m_fastCgiSession != NULL) {
+    return m_fastCgiSession->wantsWrite()
+               ? primitives::SocketEvent::EVENT_READ |
+                     primitives::SocketEvent::EVENT_WRITE
+               : primitives::SocketEvent::EVENT_READ;
+  }
+  if (m_state == STATE_PROXYING && m_workerSession != NULL) {
+    return m_workerSession->wantsWrite()
+               ? primitives::SocketEvent::EVENT_READ |
+                     primitives::SocketEvent::EVENT_WRITE
+               : primitives::SocketEvent::EVENT_READ;
+  }
+  if (m_state == STATE_PROXYING && m_cgiStream != NULL) {
+    return m_cgiStream->isAwaitingExit() ? primitives::SocketEvent::EVENT_NONE
+                                         : primitives::SocketEvent::EVENT_READ;
+  }
+  if (m_state == STATE_PROXYING && m_proxySession != NULL) {
+    return m_proxySession->wantsWrite() ? primitives::SocketEvent::EVENT_WRITE
+                                        : primitives::SocketEvent::EVENT_READ;
+  }
+  if (isStreamingUpstream() && m_state == STATE_WRITING_RESPONSE &&
+      m_http2 != NULL) {
+    return m_http2->getQueuedBytes(m_http2Stream) < K_STREAM_CHUNK_SIZE
+               ? primitives::SocketEvent::EVENT_READ
+               : primitives::SocketEvent::EVENT_NONE;
+  }
+  if (isStreamingUpstream() && m_state == STATE_WRITING_RESPONSE &&
+      m_responseOffset >= m_responseBuffer.size()) {
+    return primitives::SocketEvent::EVENT_READ;
+  }
+  return primitives::SocketEvent::EVENT_NONE;
+}
+
+int ConnectionHandler::getUpstreamFd() const {
+  if (m_proxySession != NULL) {
+    return m_proxySession->getFd();
+  }
+  if (m_fastCgiSession != NULL) {
+    return m_fastCgiSession->getFd();
+  }
+  if (m_workerSession != NULL) {
+    return m_workerSession->getFd();
+  }
+  return (m_cgiStream != NULL) ? m_cgiStream->getFd() : -1;
+}
+
+// Waiting on a proxied upstream is bounded by proxy_connect_timeout and
+// proxy_read_timeout rather than by the client-facing timeouts; a FastCGI
+// server gets its connect timeout and fastcgi timeout, a CGI worker the
+// pool's timeout and a CGI script the CGI timeout until its header block is
+// in. A script whose output ended before its headers is failed from here
+// once it has exited.
+void ConnectionHandler::checkUpstreamTimeout(time_t currentTime) {
+  if (m_cgiStream != NULL && m_state == STATE_PROXYING) {
+    bool ready = false;
+    try {
+      m_cgiStream->checkTimeout(currentTime);
+      ready = m_cgiStream->isAwaitingExit() && advanceCgiStream();
+    } catch (const cgi::exceptions::CgiExecutionException& ex) {
+      failCgi(ex);
+      ready = true;
+    }
+    if (ready) {
+      prepareResponse();
+      if (m_http2 != NULL) {
+        processHttp2Event();
+      }
+    }
+    return;
+  }
+  if (m_cgiStream != NULL) {
+    m_cgiStream->checkTimeout(currentTime);
+    return;
+  }
+  if (m_fastCgiSession != NULL || m_workerSession != NULL) {
+    try {
+      if (m_fastCgiSession != NULL) {
+        m_fastCgiSession->checkTimeout(currentTime);
+      } else {
+        m_workerSession->checkTimeout(currentTime);
+      }
+    } catch (const cgi::exceptions::CgiExecutionException& ex) {
+      failCgi(ex);
+      prepareResponse();
+      if (m_http2 != NULL) {
+        processHttp2Event();
+      }
+    }
+    return;
+  }
+  if (m_proxySession == NULL) {
+    return;
+  }
+
+  try {
+    m_proxySession->checkTimeout(currentTime);
+  } catch (const proxy::exceptions::ProxyException& ex) {
+    if (m_state == STATE_PROXYING) {
+      failProxy(ex);
+      prepareResponse();
+    } else {
+      m_logger.error(std::string("Proxy stream error: ") + ex.what());
+      if (m_http2 == NULL) {
+        retireUpstream();
+        m_responseBuffer.clear();
+        m_state = STATE_CLOSING;
+        return;
+      }
+      abortHttp2Stream();
+    }
+    if (m_http2 != NULL) {
+      processHttp2Event();
+    }
+  }
+}
+
+void ConnectionHandler::releaseRetiredUpstreams() {
+  for (size_t i = 0; i < m_retiredCgiStreams.size(); ++i) {
+    m_cgiExecutor.release(m_retiredCgiStreams[i]);
+  }
+  m_retiredCgiStreams.clear();
+  for (size_t i = 0; i < m_retiredProxySessions.size(); ++i) {
+    delete m_retiredProxySessions[i];
+  }
+  m_retiredProxySessions.clear();
+  for (size_t i = 0; i < m_retiredFastCgiSessions.size(); ++i) {
+    delete m_retiredFastCgiSessions[i];
+  }
+  m_retiredFastCgiSessions.clear();
+  for (size_t i = 0; i < m_retiredWorkerSessions.size(); ++i) {
+    delete m_retiredWorkerSessions[i];
+  }
+  m_retiredWorkerSessions.clear();
+  if (m_proxySession != NULL) {
+    m_proxySession->releaseDiscarded();
+  }
+  if (m_fastCgiSession != NULL) {
+    m_fastCgiSession->releaseDiscarded();
+  }
+}
+
+bool ConnectionHandler::isWaitingForCache() const {
+  return m_state == STATE_CACHE_WAIT;
+}
+
+// A request parked behind another request's cache lock is processed again
+// once the lock is gone, hitting the entry if the other request stored it.
+// After proxy_cache_lock_timeout it goes to the backend without storing.
+void ConnectionHandler::resumeCacheWait(time_t currentTime) {
+  if (m_state != STATE_CACHE_WAIT || m_cacheConfig == NULL) {
+    return;
+  }
+  if (m_responseCache.isLocked(m_cacheConfig->getZone(), m_cacheKey)) {
+    if (currentTime - m_cacheWaitStart <
+        static_cast<time_t>(m_cacheConfig->getLockTimeout())) {
+      return;
+    }
+    m_cacheBypass = true;
+  }
+  m_state = STATE_PROCESSING;
+  processEvent();
+}
+
+bool ConnectionHandler::isDelayedByLimit() const {
+  return m_state == STATE_LIMIT_DELAY;
+}
+
+unsigned long ConnectionHandler::getLimitWakeMillis() const {
+  return m_limitWakeMillis;
+}
+
+// A request held back by limit_req carries on where it stopped once its
+// delay has passed; it is not charged again.
+void ConnectionHandler::resumeLimitDelay(unsigned long nowMillis) {
+  if (m_state != STATE_LIMIT_DELAY || nowMillis < m_limitWakeMillis) {
+    return;
+  }
+  m_state = STATE_PROCESSING;
+  processEvent();
 }
 
 void ConnectionHandler::updateLastActivity(time_t currentTime) {
   m_lastActivityTime = currentTime;
 }
 
+// The handshake counts against client_header_timeout, like the request
+// line that follows it.
+bool ConnectionHandler::advanceHandshake() {
+  tls::adapters::TlsChannel* channel = m_socket->getTls();
+  switch (channel->handshake()) {
+    case tls::adapters::TlsChannel::HANDSHAKE_DONE:
+      m_metrics.recordTlsHandshake(channel->isResumed(),
+                                   channel->isKernelSend());
+      WEBSERV_LOG_DEBUG(m_logger,
+                        "TLS handshake with "
+                            << getRemoteAddress() << ": "
+                            << channel->getVersion() << " "
+                            << channel->getCipher()
+                            << (channel->isResumed() ? " (resumed)" : "")
+                            << (channel->isKernelSend() ? " (ktls)" : ""));
+      m_state = STATE_READING_REQUEST;
+      if (m_http2Enabled && channel->getAlpnProtocol() == "h2") {
+        startHttp2();
+      }
+      return true;
+    case tls::adapters::TlsChannel::HANDSHAKE_WANT_READ:
+    case tls::adapters::TlsChannel::HANDSHAKE_WANT_WRITE:
+      return false;
+    case tls::adapters::TlsChannel::HANDSHAKE_FAILED:
+      break;
+  }
+  m_metrics.recordTlsHandshakeFailure();
+  WEBSERV_LOG_DEBUG(m_logger, "TLS handshake with " << getRemoteAddress()
+                                                    << " failed: "
+                                                    << channel->getLastError());
+  m_state = STATE_CLOSING;
+  return false;
+}
+
 void ConnectionHandler::handleRead() {
-  char buffer[K_READ_BUFFER_SIZE];
-  const ssize_t bytesRead = m_socket->read(buffer, K_READ_BUFFER_SIZE);
+  m_readBuffer.reserve(K_READ_BUFFER_SIZE);
+  const ssize_t bytesRead = m_socket->read(m_readBuffer.writePointer(),
+                                           m_readBuffer.writableSize());
 
   if (bytesRead == 0) {
-    m_logger.debug("Client closed connection: " + getRemoteAddress());
+    WEBSERV_LOG_DEBUG(m_logger,
+                      "Client closed connection: " << getRemoteAddress());
     m_state = STATE_CLOSING;
     return;
   }
@@ -204,118 +640,802 @@ void ConnectionHandler::handleRead() {
     return;
   }
 
-  m_requestBuffer.append(buffer, static_cast<size_t>(bytesRead));
+  if (m_state == STATE_KEEP_ALIVE) {
+    m_state = STATE_READING_REQUEST;
+    m_requestStartTime = m_lastActivityTime;
+    m_requestServer = m_serverConfig;
+  }
+  m_timing.mark(primitives::RequestTiming::PHASE_FIRST_BYTE);
 
-  std::ostringstream oss;
-  oss << "Read " << bytesRead << " bytes from " << getRemoteAddress()
-      << " (total: " << m_requestBuffer.size() << ")";
-  m_logger.debug(oss.str());
+  m_readBuffer.commit(static_cast<size_t>(bytesRead));
+  m_metrics.recordBytesIn(static_cast<size_t>(bytesRead));
+
+  WEBSERV_LOG_DEBUG(m_logger, "Read " << bytesRead << " bytes from "
+                                      << getRemoteAddress() << " (total: "
+                                      << m_readBuffer.size() << ")");
+
+  processBufferedRequest();
+}
 
+void ConnectionHandler::processBufferedRequest() {
   const size_t maxRequestSize =
-      m_serverConfig->getClientMaxBodySize().getBytes();
+      m_headersReceived ? m_requestServer->getClientMaxBodySize().getBytes()
+                        : m_maxRequestSize;
 
-  if (m_requestBuffer.size() > maxRequestSize) {
+  if (m_readBuffer.size() > maxRequestSize) {
     std::ostringstream errorMsg;
-    errorMsg << "Request size (" << m_requestBuffer.size()
+    errorMsg << "Request size (" << m_readBuffer.size()
              << " bytes) exceeds server maximum (" << maxRequestSize
              << " bytes)";
     throw exceptions::ConnectionException(
         errorMsg.str(), exceptions::ConnectionException::REQUEST_TOO_LARGE);
   }
 
+  if (detectHttp2Preface()) {
+    return;
+  }
+
   if (parseRequest()) {
+    m_timing.mark(primitives::RequestTiming::PHASE_BODY_COMPLETE);
+    ++m_requestCount;
     m_state = STATE_PROCESSING;
+    upgradeToHttp2();
+  }
+}
+
+bool ConnectionHandler::resumePipelinedRequest() {
+  if (m_state != STATE_KEEP_ALIVE || m_readBuffer.empty()) {
+    return false;
+  }
+
+  m_state = STATE_READING_REQUEST;
+  m_requestStartTime = m_lastActivityTime;
+  m_requestServer = m_serverConfig;
+  m_timing.mark(primitives::RequestTiming::PHASE_FIRST_BYTE);
+  processBufferedRequest();
+  return m_state == STATE_PROCESSING;
+}
+
+// h2c with prior knowledge (RFC 7540 section 3.4): the connection opens
+// with the client preface instead of a request line. True while the bytes
+// read so far could still be the preface.
+bool ConnectionHandler::detectHttp2Preface() {
+  if (!m_http2Enabled || m_requestCount > 0 || m_socket->isTls()) {
+    return false;
+  }
+  const size_t length =
+      std::min(m_readBuffer.size(),
+               http2::primitives::Http2Frame::K_CLIENT_PREFACE_SIZE);
+  if (std::memcmp(m_readBuffer.data(),
+                  http2::primitives::Http2Frame::K_CLIENT_PREFACE,
+                  length) != 0) {
+    return false;
+  }
+  if (length == http2::primitives::Http2Frame::K_CLIENT_PREFACE_SIZE) {
+    startHttp2();
+  }
+  return true;
+}
+
+// h2c upgrade (RFC 7540 section 3.2), only for requests without a body.
+// Whatever the client pipelined behind the request is its preface.
+bool ConnectionHandler::upgradeToHttp2() {
+  if (!m_http2Enabled || m_socket->isTls() || !m_request.getBody().empty() ||
+      domain::shared::utils::StringUtils::toLowerCase(
+          m_request.getHeader("Upgrade")) != "h2c" ||
+      !m_request.hasHeader("HTTP2-Settings")) {
+    return false;
+  }
+
+  http2::adapters::Http2Session* session =
+      new http2::adapters::Http2Session(m_maxRequestSize);
+  if (!session->startUpgrade(m_request.getHeader("HTTP2-Settings"))) {
+    delete session;
+    return false;
+  }
+  m_http2 = session;
+  m_http2Stream = 1;
+  m_metrics.recordHttp2Connection();
+  m_http2->receive(m_readBuffer.data(), m_readBuffer.size());
+  m_readBuffer.consume(m_readBuffer.size());
+
+  WEBSERV_LOG_DEBUG(m_logger, "Upgraded " << getRemoteAddress() << " to h2c");
+  return true;
+}
+
+void ConnectionHandler::startHttp2() {
+  m_http2 = new http2::adapters::Http2Session(m_maxRequestSize);
+  m_http2->start();
+  m_metrics.recordHttp2Connection();
+  m_http2->receive(m_readBuffer.data(), m_readBuffer.size());
+  m_readBuffer.consume(m_readBuffer.size());
+  m_state = STATE_HTTP2;
+
+  WEBSERV_LOG_DEBUG(m_logger, "HTTP/2 session started for "
+                                  << getRemoteAddress());
+}
+
+// Queued frames go out first so a client that was waiting on them can be
+// read from again; input is taken in full before anything is dispatched.
+void ConnectionHandler::processHttp2Event() {
+  flushHttp2Output();
+  if (wantsRead() && !readHttp2Input()) {
+    WEBSERV_LOG_DEBUG(m_logger,
+                      "Client closed connection: " << getRemoteAddress());
+    m_state = STATE_CLOSING;
+    return;
+  }
+
+  if (m_http2->hasFailed()) {
+    m_logger.warn("HTTP/2 connection error from " + getRemoteAddress() +
+                  ": " + m_http2->getLastError());
+    finishCacheFill(false);
+    retireUpstream();
+    flushHttp2Output();
+    m_state = STATE_CLOSING;
+    return;
+  }
+
+  bool continueProcessing = true;
+  while (continueProcessing) {
+    try {
+      continueProcessing = advanceHttp2();
+    } catch (const domain::http::exceptions::HttpRequestException& ex) {
+      m_logger.error(std::string("Request error: ") + ex.what());
+      generateErrorResponse(
+          domain::shared::value_objects::ErrorCode::badRequest(), ex.what());
+      prepareResponse();
+      continueProcessing = true;
+    } catch (const std::exception& ex) {
+      m_logger.error(std::string("Unexpected error: ") + ex.what());
+      if (isStreamingUpstream()) {
+        abortHttp2Stream();
+      } else {
+        generateErrorResponse(
+            domain::shared::value_objects::ErrorCode::internalServerError(),
+            "Internal Server Error");
+        prepareResponse();
+      }
+      continueProcessing = true;
+    }
+  }
+
+  flushHttp2Output();
+  if (m_state == STATE_HTTP2 && m_http2->isFinished() &&
+      !m_http2->hasOutput()) {
+    m_state = STATE_CLOSING;
+  }
+}
+
+// Requests are served one at a time in the order the session completed
+// them; each one runs through the same states as an HTTP/1.1 request.
+bool ConnectionHandler::advanceHttp2() {
+  switch (m_state) {
+    case STATE_HTTP2:
+      return dispatchHttp2Request();
+
+    case STATE_PROCESSING:
+      processRequest();
+      if (m_state == STATE_CACHE_WAIT || m_state == STATE_LIMIT_DELAY) {
+        return false;
+      }
+      if (isStreamingUpstream()) {
+        m_state = STATE_PROXYING;
+      } else {
+        prepareResponse();
+      }
+      return true;
+
+    case STATE_PROXYING:
+      if (advanceUpstream()) {
+        prepareResponse();
+        return true;
+      }
+      return false;
+
+    case STATE_WRITING_RESPONSE:
+      return pumpHttp2Stream();
+
+    default:
+      return false;
+  }
+}
+
+// False once the client has closed its side.
+bool ConnectionHandler::readHttp2Input() {
+  char buffer[K_READ_BUFFER_SIZE];
+  while (!m_http2->hasFailed()) {
+    const ssize_t bytesRead = m_socket->read(buffer, sizeof(buffer));
+    if (bytesRead == 0) {
+      return false;
+    }
+    if (bytesRead == -1) {
+      break;
+    }
+    m_metrics.recordBytesIn(static_cast<size_t>(bytesRead));
+    m_http2->receive(buffer, static_cast<size_t>(bytesRead));
+  }
+  return true;
+}
+
+void ConnectionHandler::flushHttp2Output() {
+  while (m_http2->hasOutput()) {
+    const ssize_t bytesWritten =
+        m_socket->write(m_http2->outputData(), m_http2->outputSize());
+    if (bytesWritten == -1) {
+      return;
+    }
+    m_metrics.recordBytesOut(static_cast<size_t>(bytesWritten));
+    m_http2->consumeOutput(static_cast<size_t>(bytesWritten));
+  }
+}
+
+bool ConnectionHandler::dispatchHttp2Request() {
+  http2::adapters::Http2Session::Request request;
+  if (!m_http2->nextRequest(request)) {
+    return false;
+  }
+
+  m_http2Stream = request.streamId;
+  m_requestStartTime = m_lastActivityTime;
+  m_requestServer = m_serverConfig;
+  m_timing.mark(primitives::RequestTiming::PHASE_FIRST_BYTE);
+  m_timing.mark(primitives::RequestTiming::PHASE_HEADERS_COMPLETE);
+  m_timing.mark(primitives::RequestTiming::PHASE_BODY_COMPLETE);
+  m_requestLength = request.headerBytes + request.body.size();
+  ++m_requestCount;
+  m_state = STATE_PROCESSING;
+
+  if (request.headersTooLarge) {
+    generateErrorResponse(
+        domain::shared::value_objects::ErrorCode(
+            domain::shared::value_objects::ErrorCode::
+                STATUS_REQUEST_HEADER_FIELDS_TOO_LARGE),
+        "Request Header Fields Too Large");
+    prepareResponse();
+    return true;
+  }
+
+  buildHttp2Request(request);
+  routeRequest(m_request.getHost());
+
+  if (request.oversized) {
+    const domain::configuration::entities::LocationConfig* matchedLocation =
+        findMatchingLocation(m_requestServer, m_request.getPath().toString());
+    if (matchedLocation != NULL) {
+      handlePayloadTooLarge(*matchedLocation);
+    } else {
+      generateErrorResponse(
+          domain::shared::value_objects::ErrorCode::payloadTooLarge(),
+          "Request entity too large");
+    }
+    prepareResponse();
+  }
+  return true;
+}
+
+// The session has already checked the pseudo-headers, so what is left is
+// mapping them onto the request line HttpRequest expects.
+void ConnectionHandler::buildHttp2Request(
+    const http2::adapters::Http2Session::Request& request) {
+  std::string authority;
+  for (http2::adapters::Http2Session::HeaderList::const_iterator it =
+           request.headers.begin();
+       it != request.headers.end(); ++it) {
+    if (it->first == ":method") {
+      m_request.setMethod(domain::http::value_objects::HttpMethod(
+          domain::http::value_objects::HttpMethod::lookupMethod(
+              it->second.data(), it->second.size())));
+    } else if (it->first == ":path") {
+      const std::string::size_type queryPos = it->second.find('?');
+      const std::string pathStr = it->second.substr(0, queryPos);
+      if (pathStr.empty() || pathStr[0] != '/' ||
+          pathStr.size() > http::RequestParser::K_MAX_URI_LENGTH) {
+        throw domain::http::exceptions::HttpRequestException(
+            "Invalid path: " + pathStr,
+            domain::http::exceptions::HttpRequestException::INVALID_URI);
+      }
+      m_request.setPath(
+          domain::filesystem::value_objects::Path::fromString(pathStr, true));
+      if (queryPos != std::string::npos) {
+        m_request.setQuery(
+            domain::http::value_objects::QueryStringBuilder::parseQueryString(
+                it->second.substr(queryPos + 1)));
+      }
+    } else if (it->first == ":authority") {
+      authority = it->second;
+    } else if (it->first[0] != ':') {
+      m_request.addHeader(it->first, it->second);
+    }
+  }
+  if (!authority.empty() && !m_request.hasHeader("Host")) {
+    m_request.addHeader("Host", authority);
+  }
+  m_request.setVersion(domain::http::value_objects::HttpVersion::http20());
+  if (!request.oversized && !request.body.empty()) {
+    m_request.setBody(domain::http::entities::HttpRequest::Body(
+        request.body.begin(), request.body.end()));
+  }
+
+  m_request.validate();
+
+  WEBSERV_LOG_INFO(m_logger,
+                   "Parsed request: " << m_request.getMethod().toString()
+                                      << " " << m_request.getPath().toString()
+                                      << " "
+                                      << m_request.getVersion().toString()
+                                      << " (stream " << m_http2Stream << ")");
+}
+
+// Connection-specific fields have no meaning in HTTP/2 (RFC 7540 section
+// 8.1.2.2) and field names go out in lowercase. A streamed body follows
+// in DATA frames from pumpHttp2Stream().
+void ConnectionHandler::submitHttp2Response() {
+  http2::adapters::Http2Session::HeaderList headers;
+  std::ostringstream status;
+  status << m_response.getStatusCode().getValue();
+  headers.push_back(http2::adapters::Http2Session::Field(":status",
+                                                         status.str()));
+
+  const domain::http::entities::HttpResponse::HeaderMap& fields =
+      m_response.getHeaders();
+  for (domain::http::entities::HttpResponse::HeaderMap::const_iterator it =
+           fields.begin();
+       it != fields.end(); ++it) {
+    const std::string name =
+        domain::shared::utils::StringUtils::toLowerCase(it->first);
+    if (name == "connection" || name == "keep-alive" ||
+        name == "transfer-encoding" || name == "upgrade" ||
+        name == "proxy-connection") {
+      continue;
+    }
+    headers.push_back(http2::adapters::Http2Session::Field(name, it->second));
+  }
+
+  const domain::http::entities::HttpResponse::Body& body =
+      m_response.getBody();
+  const bool streaming = isStreamingUpstream();
+  const bool hasBody = !body.empty() && !m_request.getMethod().isHead();
+  m_http2->submitHeaders(m_http2Stream, headers, !hasBody && !streaming);
+  if (hasBody) {
+    m_http2->submitData(m_http2Stream, &body[0], body.size(), !streaming);
+    m_responseBytesSent = body.size();
+  }
+  m_timing.mark(primitives::RequestTiming::PHASE_FIRST_BYTE_WRITTEN);
+
+  if (streaming) {
+    m_state = STATE_WRITING_RESPONSE;
+  } else {
+    finishResponse();
+  }
+}
+
+// Reads from the upstream only while the stream has little queued, so a
+// client that stops granting window holds up its own response and nothing
+// else. A stream the client reset takes the upstream down with it.
+bool ConnectionHandler::pumpHttp2Stream() {
+  char chunk[K_STREAM_CHUNK_SIZE];
+  while (isStreamingUpstream()) {
+    if (!m_http2->isStreamOpen(m_http2Stream)) {
+      WEBSERV_LOG_DEBUG(m_logger, "Stream " << m_http2Stream
+                                            << " reset by "
+                                            << getRemoteAddress());
+      finishCacheFill(false);
+      retireUpstream();
+      break;
+    }
+    if (m_http2->getQueuedBytes(m_http2Stream) >= K_STREAM_CHUNK_SIZE) {
+      return false;
+    }
+
+    size_t wanted = sizeof(chunk);
+    if (m_streamHasLength) {
+      wanted = std::min(wanted, m_streamRemaining);
+    }
+    bool failed = false;
+    const ssize_t bytesRead =
+        wanted > 0 ? readUpstream(chunk, wanted, failed) : 0;
+    if (bytesRead < 0) {
+      return false;
+    }
+    if (bytesRead > 0) {
+      const size_t length = static_cast<size_t>(bytesRead);
+      if (m_cacheFill != NULL) {
+        m_cacheFill->append(chunk, length);
+      }
+      if (m_streamHasLength) {
+        m_streamRemaining -= length;
+      }
+      m_responseBytesSent += length;
+      m_http2->submitData(m_http2Stream, chunk, length, false);
+      continue;
+    }
+
+    if (m_streamHasLength && m_streamRemaining > 0) {
+      m_logger.warn("Upstream response shorter than its Content-Length");
+      failed = true;
+    }
+    if (failed) {
+      abortHttp2Stream();
+      return true;
+    }
+    finishCacheFill(true);
+    retireUpstream();
+    m_http2->submitData(m_http2Stream, NULL, 0, true);
+  }
+
+  finishResponse();
+  return true;
+}
+
+// A response that cannot be completed is cut off with RST_STREAM; unlike
+// HTTP/1.1 the connection and its other streams carry on.
+void ConnectionHandler::abortHttp2Stream() {
+  m_http2->resetStream(
+      m_http2Stream, http2::exceptions::Http2Exception::INTERNAL_ERROR);
+  finishCacheFill(false);
+  retireUpstream();
+  finishResponse();
+}
+
+void ConnectionHandler::handleWrite() {
+  if (m_responseOffset == 0 && !isStreamingUpstream() &&
+      m_requestServer->isTcpNoPush()) {
+    m_socket->setCork(true);
+  }
+
+  if (!m_timing.has(primitives::RequestTiming::PHASE_FIRST_BYTE_WRITTEN) &&
+      m_responseOffset == 0) {
+    const size_t bodyBytes = m_response.getBody().size();
+    m_responseHeaderBytes = m_responseBuffer.size() > bodyBytes
+                                ? m_responseBuffer.size() - bodyBytes
+                                : m_responseBuffer.size();
+  }
+
+  while (true) {
+    while (m_responseOffset < m_responseBuffer.size()) {
+      const size_t remaining = m_responseBuffer.size() - m_responseOffset;
+      const ssize_t bytesWritten = m_socket->write(
+          m_responseBuffer.c_str() + m_responseOffset, remaining);
+
+      if (bytesWritten == -1) {
+        return;
+      }
+
+      m_timing.mark(primitives::RequestTiming::PHASE_FIRST_BYTE_WRITTEN);
+      m_responseOffset += static_cast<size_t>(bytesWritten);
+      m_responseBytesSent += static_cast<size_t>(bytesWritten);
+      m_metrics.recordBytesOut(static_cast<size_t>(bytesWritten));
+
+      WEBSERV_LOG_DEBUG(m_logger, "Wrote " << bytesWritten << " bytes to "
+                                           << getRemoteAddress() << " ("
+                                           << m_responseOffset << "/"
+                                           << m_responseBuffer.size() << ")");
+    }
+
+    if (!isStreamingUpstream()) {
+      break;
+    }
+    if (!pumpUpstream()) {
+      return;
+    }
+  }
+
+  finishResponse();
+}
+
+bool ConnectionHandler::pumpUpstream() {
+  char chunk[K_STREAM_CHUNK_SIZE];
+  size_t wanted = sizeof(chunk);
+  if (m_streamHasLength) {
+    wanted = std::min(wanted, m_streamRemaining);
+  }
+
+  ssize_t bytesRead = 0;
+  bool failed = false;
+  if (wanted > 0) {
+    bytesRead = readUpstream(chunk, wanted, failed);
+  }
+
+  if (bytesRead < 0) {
+    return false;
+  }
+
+  m_responseBuffer.clear();
+  m_responseOffset = 0;
+
+  if (bytesRead > 0) {
+    const size_t length = static_cast<size_t>(bytesRead);
+    if (m_cacheFill != NULL) {
+      m_cacheFill->append(chunk, length);
+    }
+    if (m_streamChunked) {
+      std::ostringstream size;
+      size << std::hex << length << "\r\n";
+      m_responseBuffer.append(size.str());
+      m_responseBuffer.append(chunk, length);
+      m_responseBuffer.append("\r\n");
+    } else {
+      m_responseBuffer.append(chunk, length);
+    }
+    if (m_streamHasLength) {
+      m_streamRemaining -= length;
+    }
+    return true;
+  }
+
+  if (m_streamHasLength && m_streamRemaining > 0) {
+    m_logger.warn("Upstream response shorter than its Content-Length");
+    failed = true;
+  }
+
+  if (failed) {
+    m_response.setConnection("close");
+  } else if (m_streamChunked) {
+    m_responseBuffer = "0\r\n\r\n";
+  }
+
+  finishCacheFill(!failed);
+  retireUpstream();
+  return true;
+}
+
+// Negative when the upstream has nothing to hand over yet.
+ssize_t ConnectionHandler::readUpstream(char* buffer, size_t size,
+                                        bool& failed) {
+  try {
+    if (m_proxySession != NULL) {
+      return m_proxySession->read(buffer, size);
+    }
+    return m_cgiStream->read(buffer, size);
+  } catch (const cgi::exceptions::CgiExecutionException& ex) {
+    m_logger.error(std::string("CGI stream error: ") + ex.what());
+    if (ex.getCode() == cgi::exceptions::CgiExecutionException::TIMEOUT) {
+      m_metrics.recordCgiTimeout();
+    }
+  } catch (const proxy::exceptions::ProxyException& ex) {
+    m_logger.error(std::string("Proxy stream error: ") + ex.what());
+  } catch (const std::exception& ex) {
+    m_logger.error(std::string("Upstream stream error: ") + ex.what());
+  }
+  failed = true;
+  return 0;
+}
+
+// The pipe or upstream socket stays open until the orchestrator has dropped
+// it from the multiplexer; see releaseRetiredUpstreams().
+void ConnectionHandler::retireUpstream() {
+  if (m_cgiStream != NULL) {
+    m_cgiStream->finish();
+    m_retiredCgiStreams.push_back(m_cgiStream);
+    m_cgiStream = NULL;
+    m_upstreamPlan = NULL;
+  }
+  if (m_proxySession != NULL) {
+    m_retiredProxySessions.push_back(m_proxySession);
+    m_proxySession = NULL;
+    m_upstreamPlan = NULL;
+  }
+  if (m_fastCgiSession != NULL) {
+    m_retiredFastCgiSessions.push_back(m_fastCgiSession);
+    m_fastCgiSession = NULL;
+    m_upstreamPlan = NULL;
+  }
+  if (m_workerSession != NULL) {
+    m_retiredWorkerSessions.push_back(m_workerSession);
+    m_workerSession = NULL;
+    m_upstreamPlan = NULL;
+  }
+  m_timing.mark(primitives::RequestTiming::PHASE_UPSTREAM_DONE);
+}
+
+bool ConnectionHandler::advanceUpstream() {
+  if (m_cgiStream != NULL) {
+    return advanceCgiStream();
+  }
+  if (m_fastCgiSession != NULL || m_workerSession != NULL) {
+    return advanceCgi();
   }
+  return advanceProxy();
+}
+
+// True once a response is ready to go out: the upstream's head, or an error
+// if the exchange failed before one arrived.
+bool ConnectionHandler::advanceProxy() {
+  try {
+    if (!m_proxySession->advance()) {
+      return false;
+    }
+    startProxyResponse();
+  } catch (const proxy::exceptions::ProxyException& ex) {
+    failProxy(ex);
+  } catch (const std::exception& ex) {
+    failProxy(proxy::exceptions::ProxyException(
+        ex.what(), proxy::exceptions::ProxyException::INVALID_RESPONSE));
+  }
+  return true;
+}
+
+// True once a response is ready to go out: the script's header block, with
+// the body relayed from the pipe by handleWrite(), or an error if the script
+// failed before its headers.
+bool ConnectionHandler::advanceCgiStream() {
+  try {
+    if (!m_cgiStream->advance()) {
+      return false;
+    }
+    startCgiResponse();
+    if (m_upstreamPlan != NULL) {
+      applyCustomHeaders(*m_upstreamPlan);
+    }
+  } catch (const cgi::exceptions::CgiExecutionException& ex) {
+    failCgi(ex);
+  } catch (const std::exception& ex) {
+    failCgi(cgi::exceptions::CgiExecutionException(
+        ex.what(), cgi::exceptions::CgiExecutionException::INVALID_OUTPUT));
+  }
+  return true;
 }
 
-void ConnectionHandler::handleWrite() {
-  if (m_responseBuffer.empty()) {
-    logRequest(m_request, m_response);
+// True once a response is ready to go out: the script's output, or an error
+// if the exchange failed. The whole response is buffered, as FastCGI and
+// worker output always was here, so it can be stored in the cache in one
+// piece.
+bool ConnectionHandler::advanceCgi() {
+  try {
+    const bool done = m_fastCgiSession != NULL ? m_fastCgiSession->advance()
+                                               : m_workerSession->advance();
+    if (!done) {
+      return false;
+    }
+    const cgi::primitives::CgiResponse cgiResponse =
+        m_fastCgiSession != NULL ? m_fastCgiSession->buildResponse()
+                                 : m_workerSession->buildResponse();
+    const domain::configuration::entities::RequestPlan* plan = m_upstreamPlan;
+    retireUpstream();
 
-    if (shouldKeepAlive()) {
-      m_logger.debug("Keeping connection alive: " + getRemoteAddress());
-      resetForNextRequest();
-      m_state = STATE_KEEP_ALIVE;
-    } else {
-      m_logger.debug("Closing connection: " + getRemoteAddress());
-      m_state = STATE_CLOSING;
+    buildHttpResponseFromCgi(cgiResponse);
+    beginCacheFill();
+    const domain::http::entities::HttpResponse::Body& body =
+        m_response.getBody();
+    if (m_cacheFill != NULL && !body.empty()) {
+      m_cacheFill->append(&body[0], body.size());
     }
-    return;
+    finishCacheFill(true);
+    if (plan != NULL) {
+      applyCustomHeaders(*plan);
+    }
+  } catch (const cgi::exceptions::CgiExecutionException& ex) {
+    failCgi(ex);
+  } catch (const std::exception& ex) {
+    failCgi(cgi::exceptions::CgiExecutionException(
+        ex.what(), cgi::exceptions::CgiExecutionException::PROTOCOL_ERROR));
   }
+  return true;
+}
 
-  const size_t remaining = m_responseBuffer.size() - m_responseOffset;
-  const ssize_t bytesWritten =
-      m_socket->write(m_responseBuffer.c_str() + m_responseOffset, remaining);
-
-  if (bytesWritten == -1) {
+void ConnectionHandler::prepareResponse() {
+  m_timing.mark(primitives::RequestTiming::PHASE_HANDLER_DONE);
+  if (m_http2 != NULL) {
+    submitHttp2Response();
     return;
   }
+  applyConnectionHeader();
+  m_responseBuffer = m_response.serialize();
+  m_responseOffset = 0;
+  m_state = STATE_WRITING_RESPONSE;
+}
 
-  m_responseOffset += static_cast<size_t>(bytesWritten);
-
-  std::ostringstream oss;
-  oss << "Wrote " << bytesWritten << " bytes to " << getRemoteAddress() << " ("
-      << m_responseOffset << "/" << m_responseBuffer.size() << ")";
-  m_logger.debug(oss.str());
-
-  if (m_responseBuffer.size() <
-      m_serverConfig->getClientMaxBodySize().getBytes()) {
-    m_logger.debug("Closing connection: " + getRemoteAddress());
-    m_state = STATE_CLOSING;
+void ConnectionHandler::finishResponse() {
+  if (m_requestServer->isTcpNoPush()) {
+    m_socket->setCork(false);
+  }
+  finishCacheFill(false);
+  m_requestLimiter.release(m_limitLease);
+
+  logRequest(m_request, m_response);
+
+  m_timing.mark(primitives::RequestTiming::PHASE_LAST_BYTE_WRITTEN);
+  const long totalMicros = m_timing.total();
+  m_metrics.recordRequest(m_requestServer,
+                          m_response.getStatusCode().getValue(),
+                          totalMicros > 0
+                              ? static_cast<unsigned long>(totalMicros)
+                              : 0);
+  if (m_accessLog.isOpen()) {
+    writeAccessLog();
+  }
+  reportSlowRequest(totalMicros);
+  m_timing.reset();
+  m_requestLength = 0;
+  m_responseHeaderBytes = 0;
+  m_responseBytesSent = 0;
+
+  if (m_http2 != NULL) {
+    resetForNextRequest();
+    m_http2Stream = 0;
+    m_state = STATE_HTTP2;
+    if (m_requestCount >= m_requestServer->getKeepaliveRequests()) {
+      m_http2->shutdown();
+    }
+    return;
   }
-  if (m_responseOffset >= m_responseBuffer.size()) {
+
+  if (shouldKeepAlive()) {
+    WEBSERV_LOG_DEBUG(m_logger,
+                      "Keeping connection alive: " << getRemoteAddress());
+    resetForNextRequest();
+    m_state = STATE_KEEP_ALIVE;
+  } else {
+    WEBSERV_LOG_DEBUG(m_logger, "Closing connection: " << getRemoteAddress());
     m_responseBuffer.clear();
     m_responseOffset = 0;
+    m_state = STATE_CLOSING;
   }
 }
 
 bool ConnectionHandler::parseRequest() {
-  http::RequestParser parser;
-  const size_t maxBodySize = m_serverConfig->getClientMaxBodySize().getBytes();
-  parser.setMaxHeaderSize(maxBodySize);
-  parser.setMaxBodySize(maxBodySize);
+  const bool headersWereReceived = m_headersReceived;
+  const bool parsed = m_parser.parse(m_readBuffer.data(), m_readBuffer.size());
+  m_headersReceived = m_parser.headersComplete();
+  if (m_headersReceived) {
+    m_timing.mark(primitives::RequestTiming::PHASE_HEADERS_COMPLETE);
+  }
+  if (m_headersReceived && !headersWereReceived) {
+    routeRequest(m_parser.getRequest().getHeader(
+        domain::http::value_objects::HttpHeader::HEADER_HOST));
+  }
 
-  if (!parser.parse(m_requestBuffer.c_str(), m_requestBuffer.size())) {
+  if (!parsed) {
     return false;
   }
 
-  if (!parser.isComplete()) {
+  if (!m_parser.isComplete()) {
     return false;
   }
 
-  if (parser.hasError()) {
+  if (m_parser.hasError()) {
     throw exceptions::ConnectionException(
         "Failed to parse HTTP request",
         exceptions::ConnectionException::MALFORMED_REQUEST);
   }
 
-  const http::ParsedRequest& parsedReq = parser.getRequest();
+  const http::ParsedRequest& parsedReq = m_parser.getRequest();
 
   m_request.setMethod(parsedReq.method);
   m_request.setPath(parsedReq.path);
   m_request.setQuery(parsedReq.query);
-  m_request.setVersion(domain::http::value_objects::HttpVersion::fromString(
-      parsedReq.httpVersion));
+  m_request.setVersion(parsedReq.version);
   m_request.clearHeaders();
 
-  for (std::map<std::string, std::string>::const_iterator it =
+  for (http::ParsedRequest::HeaderViews::const_iterator it =
            parsedReq.headers.begin();
        it != parsedReq.headers.end(); ++it) {
-    m_request.addHeader(it->first, it->second);
+    if (it->id != domain::http::value_objects::HttpHeader::HEADER_UNKNOWN) {
+      m_request.addHeader(it->id, parsedReq.headerValue(*it));
+    } else {
+      m_request.addHeader(parsedReq.headerName(*it),
+                          parsedReq.headerValue(*it));
+    }
   }
 
-  if (!parsedReq.body.empty()) {
+  if (parsedReq.bodyLength > 0) {
+    const char* body = parsedReq.bodyData();
     m_request.setBody(domain::http::entities::HttpRequest::Body(
-        parsedReq.body.begin(), parsedReq.body.end()));
+        body, body + parsedReq.bodyLength));
   }
 
+  m_requestLength = m_parser.getConsumedBytes();
+  m_readBuffer.consume(m_requestLength);
+  m_parser.reset();
+
   m_request.validate();
 
-  std::ostringstream oss;
-  oss << "Parsed request: " << m_request.getMethod().toString() << " "
-      << m_request.getPath().toString() << " "
-      << m_request.getVersion().toString();
-  m_logger.info(oss.str());
+  WEBSERV_LOG_INFO(m_logger,
+                   "Parsed request: " << m_request.getMethod().toString()
+                                      << " " << m_request.getPath().toString()
+                                      << " "
+                                      << m_request.getVersion().toString());
 
   return true;
 }
@@ -324,79 +1444,17 @@ domain::filesystem::value_objects::Path
 ConnectionHandler::resolvePathWithServerFallback(
     const domain::configuration::entities::LocationConfig& location,
     const std::string& requestPath) const {
-  const domain::configuration::entities::LocationConfig::LocationMatchType
-      matchType = location.getMatchType();
-  bool isRegexLocation =
-      (matchType == domain::configuration::entities::LocationConfig::
-                        MATCH_REGEX_CASE_SENSITIVE ||
-       matchType == domain::configuration::entities::LocationConfig::
-                        MATCH_REGEX_CASE_INSENSITIVE);
-
-  std::string relativeRequestPath = requestPath;
-  if (!relativeRequestPath.empty() && relativeRequestPath[0] == '/') {
-    relativeRequestPath = relativeRequestPath.substr(1);
-  }
-
-  if (isRegexLocation) {
-    if (location.hasCgiConfig()) {
-      try {
-        const domain::configuration::value_objects::CgiConfig& cgiConfig =
-            location.getCgiConfig();
-        const domain::filesystem::value_objects::Path& cgiRoot =
-            cgiConfig.getCgiRoot();
-        std::string cgiRootStr = cgiRoot.toString();
-        if (!cgiRoot.isEmpty() && cgiRootStr != "/" &&
-            cgiRootStr.find('\\') == std::string::npos &&
-            cgiRootStr.find('$') == std::string::npos) {
-          return cgiRoot.join(relativeRequestPath);
-        }
-      } catch (const std::exception& ex) {
-        std::ostringstream oss;
-        oss << "CGI root resolution failed: " << ex.what();
-        m_logger.debug(oss.str());
-      }
-    }
-
-    if (m_serverConfig != NULL && !m_serverConfig->getRoot().isEmpty()) {
-      return m_serverConfig->getRoot().join(relativeRequestPath);
-    }
-
-    return domain::filesystem::value_objects::Path::fromString(
-        "./" + relativeRequestPath, false);
-  }
+  const domain::configuration::entities::RequestPlan& plan =
+      planFor(location);
 
   try {
-    const domain::filesystem::value_objects::Path& locationRoot =
-        location.getRoot();
-    std::string rootStr = locationRoot.toString();
-
-    bool looksLikeRegex =
-        (!rootStr.empty() &&
-         (rootStr[0] == '\\' || rootStr.find('$') != std::string::npos ||
-          rootStr.find('^') != std::string::npos ||
-          rootStr.find('*') != std::string::npos));
-
-    if (!looksLikeRegex && rootStr != "/") {
-      return location.resolvePath(requestPath);
-    }
-
-    if (m_serverConfig != NULL && !m_serverConfig->getRoot().isEmpty()) {
-      return m_serverConfig->getRoot().join(relativeRequestPath);
-    }
-
+    return plan.resolvePath(requestPath);
   } catch (const std::exception& ex) {
-    std::ostringstream oss;
-    oss << "Location root resolution failed (likely regex location): "
-        << ex.what();
-    m_logger.debug(oss.str());
-
-    if (m_serverConfig != NULL && !m_serverConfig->getRoot().isEmpty()) {
-      return m_serverConfig->getRoot().join(relativeRequestPath);
-    }
+    WEBSERV_LOG_DEBUG(m_logger,
+                      "Location root resolution failed: " << ex.what());
   }
 
-  return domain::filesystem::value_objects::Path::fromString(
-      "./" + relativeRequestPath, false);
+  return plan.resolveFallbackPath(requestPath);
 }
 
 domain::filesystem::value_objects::Path ConnectionHandler::resolveErrorPagePath(
@@ -428,10 +1486,9 @@ domain::filesystem::value_objects::Path ConnectionHandler::resolveErrorPagePath(
                                errorPagePath);
     }
 
-    std::ostringstream debugMsg;
-    debugMsg << "Resolved relative error page path: " << errorPagePath << " -> "
-             << resolvedPath;
-    m_logger.debug(debugMsg.str());
+    WEBSERV_LOG_DEBUG(m_logger,
+                      "Resolved relative error page path: "
+                          << errorPagePath << " -> " << resolvedPath);
 
     return domain::filesystem::value_objects::Path(resolvedPath);
   }
@@ -446,29 +1503,29 @@ domain::filesystem::value_objects::Path ConnectionHandler::resolveErrorPagePath(
         domain::filesystem::value_objects::Path resolvedPath =
             locationRoot.join(pathWithoutLeadingSlash);
 
-        std::ostringstream debugMsg;
-        debugMsg << "Resolved error page path using location root: "
-                 << errorPagePath << " + " << locationRoot.toString() << " -> "
-                 << resolvedPath.toString();
-        m_logger.debug(debugMsg.str());
+        WEBSERV_LOG_DEBUG(m_logger,
+                          "Resolved error page path using location root: "
+                              << errorPagePath << " + "
+                              << locationRoot.toString() << " -> "
+                              << resolvedPath.toString());
 
         return resolvedPath;
       }
     } catch (const std::exception& ex) {
-      std::ostringstream warnMsg;
-      warnMsg << "Could not use location root for error page: " << ex.what();
-      m_logger.debug(warnMsg.str());
+      WEBSERV_LOG_DEBUG(m_logger,
+                        "Could not use location root for error page: "
+                            << ex.what());
     }
 
-    if (m_serverConfig != NULL && !m_serverConfig->getRoot().isEmpty()) {
+    if (!m_requestServer->getRoot().isEmpty()) {
       domain::filesystem::value_objects::Path resolvedPath =
-          m_serverConfig->getRoot().join(pathWithoutLeadingSlash);
+          m_requestServer->getRoot().join(pathWithoutLeadingSlash);
 
-      std::ostringstream debugMsg;
-      debugMsg << "Resolved error page path using server root: "
-               << errorPagePath << " + " << m_serverConfig->getRoot().toString()
-               << " -> " << resolvedPath.toString();
-      m_logger.debug(debugMsg.str());
+      WEBSERV_LOG_DEBUG(m_logger,
+                        "Resolved error page path using server root: "
+                            << errorPagePath << " + "
+                            << m_requestServer->getRoot().toString() << " -> "
+                            << resolvedPath.toString());
 
       return resolvedPath;
     }
@@ -487,8 +1544,8 @@ domain::filesystem::value_objects::Path ConnectionHandler::resolveErrorPagePath(
       << "' doesn't start with ./ or /, treating as relative to server root";
   m_logger.warn(warnMsg.str());
 
-  if (m_serverConfig != NULL && !m_serverConfig->getRoot().isEmpty()) {
-    return m_serverConfig->getRoot().join(errorPagePath);
+  if (!m_requestServer->getRoot().isEmpty()) {
+    return m_requestServer->getRoot().join(errorPagePath);
   }
 
   return domain::filesystem::value_objects::Path("./" + errorPagePath);
@@ -497,7 +1554,7 @@ domain::filesystem::value_objects::Path ConnectionHandler::resolveErrorPagePath(
 void ConnectionHandler::processRequest() {
   try {
     const domain::configuration::entities::ServerConfig* config =
-        resolveVirtualHost();
+        m_requestServer;
 
     const domain::http::value_objects::HttpMethod& method =
         m_request.getMethod();
@@ -507,6 +1564,7 @@ void ConnectionHandler::processRequest() {
 
     const domain::configuration::entities::LocationConfig* matchedLocation =
         findMatchingLocation(config, requestPath.toString());
+    m_timing.mark(primitives::RequestTiming::PHASE_ROUTE_MATCHED);
 
     if (matchedLocation == NULL) {
       generateErrorResponse(
@@ -515,64 +1573,73 @@ void ConnectionHandler::processRequest() {
       return;
     }
 
-    if (!matchedLocation->isMethodAllowed(method)) {
+    const domain::configuration::entities::RequestPlan& plan =
+        planFor(*matchedLocation);
+
+    if (!plan.allowsMethod(method)) {
       generateErrorResponse(
           domain::shared::value_objects::ErrorCode::methodNotAllowed(),
           "Method not allowed for this resource");
       return;
     }
 
-    if (matchedLocation->hasReturnRedirect()) {
+    if (!applyRequestLimits(*matchedLocation)) {
+      return;
+    }
+
+    if (plan.getHandlerKind() ==
+        domain::configuration::entities::RequestPlan::HANDLER_REDIRECT) {
       handleRedirect(*matchedLocation);
       return;
     }
 
-    if (matchedLocation->hasReturnContent()) {
+    if (plan.getHandlerKind() ==
+        domain::configuration::entities::RequestPlan::HANDLER_RETURN_CONTENT) {
       handleReturnContent(*matchedLocation);
       return;
     }
 
-    if (!validateRequestBodySize(*matchedLocation)) {
+    if (plan.getHandlerKind() ==
+        domain::configuration::entities::RequestPlan::HANDLER_STATUS) {
+      handleStatusRequest(*matchedLocation);
+      return;
+    }
+
+    if (!validateRequestBodySize(plan)) {
       generateErrorResponse(
           domain::shared::value_objects::ErrorCode::payloadTooLarge(),
           "Request entity too large");
+      m_response.setConnection("close");
       return;
     }
 
-    m_logger.debug("route will be create");
-    domain::configuration::value_objects::Route route =
-        matchedLocation->toRoute();
-    m_logger.debug("route is working");
-
-    if (method == domain::http::value_objects::HttpMethod::get() ||
-        method == domain::http::value_objects::HttpMethod::head()) {
-      m_logger.debug("method == get or head");
-      handleGetRequest(route, *matchedLocation, requestPath);
-    } else if (method == domain::http::value_objects::HttpMethod::post()) {
-      m_logger.debug("method == post");
-      handlePostRequest(route, *matchedLocation, requestPath);
-    } else if (method ==
-               domain::http::value_objects::HttpMethod::deleteMethod()) {
-      handleDeleteRequest(route, *matchedLocation, requestPath);
+    if (plan.getHandlerKind() ==
+        domain::configuration::entities::RequestPlan::HANDLER_PROXY) {
+      handleProxyRequest(plan, *matchedLocation);
+      return;
+    }
+
+    const MethodHandler handler = K_METHOD_HANDLERS[method.getMethod()];
+    if (handler != NULL) {
+      (this->*handler)(plan, *matchedLocation, requestPath);
     } else {
-      m_logger.debug("else generateErrorResponse");
       generateErrorResponse(
           domain::shared::value_objects::ErrorCode::methodNotAllowed(),
           "Unsupported HTTP method");
     }
 
-    applyCustomHeaders(*matchedLocation);
-
-    if (shouldKeepAlive()) {
-      m_response.setConnection("keep-alive");
+    if (m_cgiStream != NULL || m_fastCgiSession != NULL ||
+        m_workerSession != NULL) {
+      m_upstreamPlan = &plan;
     } else {
-      m_response.setConnection("close");
+      applyCustomHeaders(plan);
     }
 
   } catch (const domain::http::exceptions::HttpRequestException& ex) {
     m_logger.error(std::string("HTTP request error: ") + ex.what());
     generateErrorResponse(
         domain::shared::value_objects::ErrorCode::badRequest(), ex.what());
+    m_response.setConnection("close");
   } catch (
       const domain::configuration::exceptions::LocationConfigException& ex) {
     m_logger.error(std::string("Location configuration error: ") + ex.what());
@@ -588,23 +1655,38 @@ void ConnectionHandler::processRequest() {
 }
 
 const domain::configuration::entities::ServerConfig*
-ConnectionHandler::resolveVirtualHost() {
-  if (!m_request.hasHeader("host")) {
+ConnectionHandler::resolveVirtualHost(const std::string& hostHeader) const {
+  if (hostHeader.empty() || m_listenPort == 0) {
     return m_serverConfig;
   }
 
-  const std::string hostHeader = m_request.getHost();
-  if (hostHeader.empty()) {
-    return m_serverConfig;
-  }
+  const domain::configuration::entities::ServerConfig* server =
+      m_configSnapshot.getConfiguration().findServer(
+          stripHostPort(hostHeader), m_listenAddress, m_listenPort);
+  return server != NULL ? server : m_serverConfig;
+}
 
-  return m_serverConfig;
+// The server picked here answers the whole request: its limits, timeouts,
+// keep-alive settings, error page root and metrics all follow Host.
+void ConnectionHandler::routeRequest(const std::string& hostHeader) {
+  m_requestServer = resolveVirtualHost(hostHeader);
+}
+
+// "example.com:8080" and "[::1]:8080" name their server without the port;
+// a bracketed IPv6 literal keeps its brackets.
+std::string ConnectionHandler::stripHostPort(const std::string& host) {
+  if (!host.empty() && host[0] == '[') {
+    const std::size_t close = host.find(']');
+    return close == std::string::npos ? host : host.substr(0, close + 1);
+  }
+  const std::size_t colon = host.find(':');
+  return colon == std::string::npos ? host : host.substr(0, colon);
 }
 
 const domain::configuration::entities::LocationConfig*
 ConnectionHandler::findMatchingLocation(
     const domain::configuration::entities::ServerConfig* serverConfig,
-    const std::string& requestPath) const {
+    const std::string& requestPath) {
   if (serverConfig == NULL) {
     return NULL;
   }
@@ -685,15 +1767,14 @@ ConnectionHandler::findMatchingLocation(
 }
 
 void ConnectionHandler::handleGetRequest(
-    const domain::configuration::value_objects::Route& /* route */,
+    const domain::configuration::entities::RequestPlan& plan,
     const domain::configuration::entities::LocationConfig& location,
     const domain::filesystem::value_objects::Path& requestPath) {
   domain::filesystem::value_objects::Path resolvedPath =
       resolvePathWithServerFallback(location, requestPath.toString());
 
-  std::ostringstream debugMsg;
-  debugMsg << "GET request - resolved path: " << resolvedPath.toString();
-  m_logger.debug(debugMsg.str());
+  WEBSERV_LOG_DEBUG(m_logger,
+                    "GET request - resolved path: " << resolvedPath.toString());
 
   bool pathExists = false;
   try {
@@ -703,11 +1784,11 @@ void ConnectionHandler::handleGetRequest(
     pathExists = false;
   }
 
-  std::ostringstream oss;
-  oss << "Inside of handleGetRequest verify pathExists = " << pathExists;
-  m_logger.debug(oss.str());
+  WEBSERV_LOG_DEBUG(m_logger,
+                    "Inside of handleGetRequest verify pathExists = "
+                        << pathExists);
   if (!pathExists) {
-    if (!location.getTryFiles().empty()) {
+    if (!plan.getTryFiles().empty()) {
       resolvedPath = tryFindFile(location, requestPath);
       if (resolvedPath.isEmpty()) {
         handleNotFound(location);
@@ -732,18 +1813,12 @@ void ConnectionHandler::handleGetRequest(
     return;
   }
 
-  if (location.hasCgiConfig()) {
-    const domain::configuration::entities::LocationConfig::LocationMatchType
-        matchType = location.getMatchType();
-    bool isRegexLocation =
-        (matchType == domain::configuration::entities::LocationConfig::
-                          MATCH_REGEX_CASE_SENSITIVE ||
-         matchType == domain::configuration::entities::LocationConfig::
-                          MATCH_REGEX_CASE_INSENSITIVE);
-
-    if (isRegexLocation ||
+  if (plan.hasCgi()) {
+    if (plan.isRegexLocation() ||
         location.getCgiConfig().matchesExtension(resolvedPath.toString())) {
-      m_logger.debug("Routing to CGI handler for: " + resolvedPath.toString());
+      WEBSERV_LOG_DEBUG(m_logger,
+                        "Routing to CGI handler for: "
+                            << resolvedPath.toString());
       handleCgiRequest(location, resolvedPath);
       return;
     }
@@ -753,30 +1828,23 @@ void ConnectionHandler::handleGetRequest(
 }
 
 void ConnectionHandler::handlePostRequest(
-    const domain::configuration::value_objects::Route& /* route */,
+    const domain::configuration::entities::RequestPlan& plan,
     const domain::configuration::entities::LocationConfig& location,
     const domain::filesystem::value_objects::Path& requestPath) {
-  if (location.isUploadRoute()) {
+  if (plan.isUploadRoute()) {
     handleFileUpload(location, requestPath);
     return;
   }
 
-  if (location.hasCgiConfig()) {
+  if (plan.hasCgi()) {
     domain::filesystem::value_objects::Path resolvedPath =
         resolvePathWithServerFallback(location, requestPath.toString());
 
-    const domain::configuration::entities::LocationConfig::LocationMatchType
-        matchType = location.getMatchType();
-    bool isRegexLocation =
-        (matchType == domain::configuration::entities::LocationConfig::
-                          MATCH_REGEX_CASE_SENSITIVE ||
-         matchType == domain::configuration::entities::LocationConfig::
-                          MATCH_REGEX_CASE_INSENSITIVE);
-
-    if (isRegexLocation ||
+    if (plan.isRegexLocation() ||
         location.getCgiConfig().matchesExtension(resolvedPath.toString())) {
-      m_logger.debug("POST routing to CGI handler for: " +
-                     resolvedPath.toString());
+      WEBSERV_LOG_DEBUG(m_logger,
+                        "POST routing to CGI handler for: "
+                            << resolvedPath.toString());
       handleCgiRequest(location, resolvedPath);
       return;
     }
@@ -788,21 +1856,22 @@ void ConnectionHandler::handlePostRequest(
 }
 
 void ConnectionHandler::handleDeleteRequest(
-    const domain::configuration::value_objects::Route& /* route */,
+    const domain::configuration::entities::RequestPlan& plan,
     const domain::configuration::entities::LocationConfig& location,
     const domain::filesystem::value_objects::Path& requestPath) {
   domain::filesystem::value_objects::Path resolvedPath;
 
-  m_logger.debug("enter handler Delete");
-  if (location.isUploadRoute() && location.hasUploadConfig()) {
+  WEBSERV_LOG_DEBUG(m_logger, "enter handler Delete");
+  if (plan.isUploadRoute()) {
     const domain::configuration::value_objects::UploadConfig& uploadConfig =
         location.getUploadConfig();
     const domain::filesystem::value_objects::Path& uploadStore =
         uploadConfig.getUploadDirectory();
 
-    m_logger.debug("uploadConfig => " +
-                   uploadConfig.getUploadDirectory().getFilename());
-    m_logger.debug("uploadStore => " + uploadStore.getFilename());
+    WEBSERV_LOG_DEBUG(m_logger,
+                      "uploadConfig => "
+                          << uploadConfig.getUploadDirectory().getFilename());
+    WEBSERV_LOG_DEBUG(m_logger, "uploadStore => " << uploadStore.getFilename());
     std::string requestPathStr = requestPath.toString();
     std::string locationPath = location.getPath();
 
@@ -824,37 +1893,37 @@ void ConnectionHandler::handleDeleteRequest(
       return;
     }
 
-    std::ostringstream debugMsg;
-    debugMsg << "DELETE request (upload location) - resolved path: "
-             << resolvedPath.toString();
-    m_logger.debug(debugMsg.str());
+    WEBSERV_LOG_DEBUG(m_logger,
+                      "DELETE request (upload location) - resolved path: "
+                          << resolvedPath.toString());
   } else {
     resolvedPath =
         resolvePathWithServerFallback(location, requestPath.toString());
 
-    std::ostringstream debugMsg;
-    debugMsg << "DELETE request - resolved path: " << resolvedPath.toString();
-    m_logger.debug(debugMsg.str());
+    WEBSERV_LOG_DEBUG(m_logger,
+                      "DELETE request - resolved path: "
+                          << resolvedPath.toString());
   }
 
   const std::string resolvedPathStr = resolvedPath.toString();
 
-  m_logger.debug("Checking if path exists: " + resolvedPathStr);
+  WEBSERV_LOG_DEBUG(m_logger, "Checking if path exists: " << resolvedPathStr);
   if (!filesystem::adapters::FileSystemHelper::exists(resolvedPathStr)) {
-    m_logger.debug("Path does not exist");
+    WEBSERV_LOG_DEBUG(m_logger, "Path does not exist");
     handleNotFound(location);
     return;
   }
-  m_logger.debug("Path exists");
+  WEBSERV_LOG_DEBUG(m_logger, "Path exists");
 
-  m_logger.debug("Checking if path is directory: " + resolvedPathStr);
+  WEBSERV_LOG_DEBUG(m_logger,
+                    "Checking if path is directory: " << resolvedPathStr);
   if (filesystem::adapters::FileSystemHelper::isDirectory(resolvedPathStr)) {
-    m_logger.debug("Path is a directory - deletion forbidden");
+    WEBSERV_LOG_DEBUG(m_logger, "Path is a directory - deletion forbidden");
     generateErrorResponse(domain::shared::value_objects::ErrorCode::forbidden(),
                           "Directory deletion not allowed");
     return;
   }
-  m_logger.debug("Path is a file - proceeding with deletion");
+  WEBSERV_LOG_DEBUG(m_logger, "Path is a file - proceeding with deletion");
 
   try {
     if (std::remove(resolvedPathStr.c_str()) != 0) {
@@ -876,57 +1945,61 @@ void ConnectionHandler::handleDirectoryRequest(
     const domain::configuration::entities::LocationConfig& location,
     const domain::filesystem::value_objects::Path& directoryPath,
     const domain::filesystem::value_objects::Path& requestPath) {
-  const std::vector<std::string>& indexFiles = location.getIndexFiles();
+  const std::vector<std::string>& indexFiles =
+      planFor(location).getIndexFiles();
 
-  std::ostringstream debugDirPath;
-  debugDirPath << "handleDirectoryRequest called with directory: "
-               << directoryPath.toString() << ", checking " << indexFiles.size()
-               << " index files";
-  m_logger.debug(debugDirPath.str());
+  WEBSERV_LOG_DEBUG(m_logger,
+                    "handleDirectoryRequest called with directory: "
+                        << directoryPath.toString() << ", checking "
+                        << indexFiles.size() << " index files");
 
   for (std::vector<std::string>::const_iterator it = indexFiles.begin();
        it != indexFiles.end(); ++it) {
     try {
-      m_logger.debug("About to join path: " + directoryPath.toString() +
-                     " with: " + *it);
+      WEBSERV_LOG_DEBUG(m_logger,
+                        "About to join path: "
+                            << directoryPath.toString() << " with: " << *it);
 
       domain::filesystem::value_objects::Path indexPath =
           directoryPath.join(*it);
 
-      m_logger.debug("Successfully created path: " + indexPath.toString());
+      WEBSERV_LOG_DEBUG(m_logger,
+                        "Successfully created path: " << indexPath.toString());
 
       bool pathExists = false;
       bool pathIsDir = false;
 
       try {
-        m_logger.debug("About to check if path exists...");
+        WEBSERV_LOG_DEBUG(m_logger, "About to check if path exists...");
         pathExists = filesystem::adapters::FileSystemHelper::exists(
             indexPath.toString());
-        m_logger.debug(pathExists ? "Path exists: YES" : "Path exists: NO");
+        WEBSERV_LOG_DEBUG(m_logger,
+                          "Path exists: " << (pathExists ? "YES" : "NO"));
       } catch (const std::exception& ex) {
-        m_logger.debug(std::string("Path exists check failed: ") + ex.what());
+        WEBSERV_LOG_DEBUG(m_logger, "Path exists check failed: " << ex.what());
         pathExists = false;
       }
 
       if (pathExists) {
         try {
-          m_logger.debug("About to check if path is directory...");
+          WEBSERV_LOG_DEBUG(m_logger, "About to check if path is directory...");
           pathIsDir = filesystem::adapters::FileSystemHelper::isDirectory(
               indexPath.toString());
-          m_logger.debug(pathIsDir ? "Path is directory: YES"
-                                   : "Path is directory: NO (it's a file)");
+          WEBSERV_LOG_DEBUG(m_logger, "Path is directory: "
+                                          << (pathIsDir ? "YES"
+                                                        : "NO (it's a file)"));
         } catch (const std::exception& ex) {
-          m_logger.debug(std::string("Path isDirectory check failed: ") +
-                         ex.what());
+          WEBSERV_LOG_DEBUG(m_logger,
+                            "Path isDirectory check failed: " << ex.what());
           pathIsDir = false;
         }
       }
 
-      std::ostringstream debugIndexPath;
-      debugIndexPath << "Checking index file: " << indexPath.toString()
-                     << " - exists: " << (pathExists ? "YES" : "NO")
-                     << " - isDir: " << (pathIsDir ? "YES" : "NO");
-      m_logger.debug(debugIndexPath.str());
+      WEBSERV_LOG_DEBUG(m_logger,
+                        "Checking index file: "
+                            << indexPath.toString() << " - exists: "
+                            << (pathExists ? "YES" : "NO") << " - isDir: "
+                            << (pathIsDir ? "YES" : "NO"));
 
       if (pathExists && !pathIsDir) {
         if (!filesystem::adapters::FileSystemHelper::isReadable(
@@ -936,7 +2009,8 @@ void ConnectionHandler::handleDirectoryRequest(
           continue;
         }
 
-        m_logger.debug("Found valid index file: " + indexPath.toString());
+        WEBSERV_LOG_DEBUG(m_logger,
+                          "Found valid index file: " << indexPath.toString());
 
         if (location.hasCgiConfig() &&
             location.getCgiConfig().matchesExtension(indexPath.toString())) {
@@ -955,11 +2029,13 @@ void ConnectionHandler::handleDirectoryRequest(
     }
   }
 
-  m_logger.debug("No index file found, checking autoindex: " +
-                 std::string(location.getAutoIndex() ? "enabled" : "disabled"));
+  WEBSERV_LOG_DEBUG(m_logger,
+                    "No index file found, checking autoindex: "
+                        << (location.getAutoIndex() ? "enabled" : "disabled"));
 
-  m_logger.debug("directoryPath => " + directoryPath.toString() +
-                 " requestPath => " + requestPath.toString());
+  WEBSERV_LOG_DEBUG(m_logger, "directoryPath => " << directoryPath.toString()
+                                                  << " requestPath => "
+                                                  << requestPath.toString());
   if (location.getAutoIndex()) {
     handleDirectoryListing(directoryPath, requestPath);
     return;
@@ -975,8 +2051,9 @@ void ConnectionHandler::handleStaticFileRequest(
   try {
     std::string pathStr = filePath.toString();
 
-    m_logger.debug("handleStaticFileRequest: Attempting to serve file: " +
-                   pathStr);
+    WEBSERV_LOG_DEBUG(m_logger,
+                      "handleStaticFileRequest: Attempting to serve file: "
+                          << pathStr);
 
     struct stat fileStat;
     if (stat(pathStr.c_str(), &fileStat) != 0) {
@@ -1015,46 +2092,14 @@ void ConnectionHandler::handleStaticFileRequest(
                         std::istreambuf_iterator<char>());
     file.close();
 
-    std::ostringstream oss;
-    oss << "Successfully read file: " << pathStr << " (" << content.length()
-        << " bytes)";
-    m_logger.debug(oss.str());
-
-    std::string mimeType = "application/octet-stream";
-    std::string filename = filePath.getFilename();
-    std::size_t dotPos = filename.find_last_of('.');
-    if (dotPos != std::string::npos) {
-      std::string ext = filename.substr(dotPos);
-      if (ext == ".html" || ext == ".htm")
-        mimeType = "text/html; charset=utf-8";
-      else if (ext == ".css")
-        mimeType = "text/css";
-      else if (ext == ".js")
-        mimeType = "application/javascript";
-      else if (ext == ".json")
-        mimeType = "application/json";
-      else if (ext == ".png")
-        mimeType = "image/png";
-      else if (ext == ".jpg" || ext == ".jpeg")
-        mimeType = "image/jpeg";
-      else if (ext == ".gif")
-        mimeType = "image/gif";
-      else if (ext == ".svg")
-        mimeType = "image/svg+xml";
-      else if (ext == ".ico")
-        mimeType = "image/x-icon";
-      else if (ext == ".txt")
-        mimeType = "text/plain";
-      else if (ext == ".xml")
-        mimeType = "application/xml";
-      else if (ext == ".pdf")
-        mimeType = "application/pdf";
-      else if (ext == ".zip")
-        mimeType = "application/zip";
-    }
+    WEBSERV_LOG_DEBUG(m_logger,
+                      "Successfully read file: "
+                          << pathStr << " (" << content.length() << " bytes)");
 
     m_response = domain::http::entities::HttpResponse::ok(content);
-    m_response.setContentType(mimeType);
+    m_response.setContentType(
+        m_configSnapshot.getConfiguration().getMimeTypes().lookupFilename(
+            filePath.getFilename()));
 
     std::ostringstream contentLength;
     contentLength << content.length();
@@ -1068,7 +2113,8 @@ void ConnectionHandler::handleStaticFileRequest(
       m_response.addHeader("Last-Modified", std::string(timeBuffer));
     }
 
-    m_logger.debug("Response prepared successfully for: " + pathStr);
+    WEBSERV_LOG_DEBUG(m_logger,
+                      "Response prepared successfully for: " << pathStr);
 
   } catch (const std::exception& ex) {
     m_logger.error(std::string("Static file error: ") + ex.what());
@@ -1098,10 +2144,9 @@ void ConnectionHandler::handleDirectoryListing(
 
     const domain::filesystem::value_objects::Path absolutePath(resolvedPath);
 
-    std::ostringstream debugMsg;
-    debugMsg << "Resolved directory path: " << dirPathStr << " -> "
-             << absolutePath.toString();
-    m_logger.debug(debugMsg.str());
+    WEBSERV_LOG_DEBUG(m_logger,
+                      "Resolved directory path: "
+                          << dirPathStr << " -> " << absolutePath.toString());
 
     const std::string htmlListing =
         filesystem::adapters::DirectoryLister::generateHtmlListing(
@@ -1131,7 +2176,8 @@ void ConnectionHandler::handleCgiRequest(
 
     std::string serverName = "localhost";
     unsigned int serverPort = 8080;
-    if (m_request.hasHeader("host")) {
+    if (m_request.hasHeader(
+            domain::http::value_objects::HttpHeader::HEADER_HOST)) {
       std::string hostHeader = m_request.getHost();
       std::size_t colonPos = hostHeader.find(':');
       if (colonPos != std::string::npos) {
@@ -1143,16 +2189,36 @@ void ConnectionHandler::handleCgiRequest(
       }
     }
 
-    cgi::primitives::CgiRequest cgiRequest(m_request, cgiConfig, matchInfo,
-                                           serverName, serverPort);
+    if (lookupCache(location)) {
+      return;
+    }
 
-    cgi::adapters::CgiExecutor executor(m_logger);
-    cgi::primitives::CgiResponse cgiResponse = executor.execute(cgiRequest);
+    m_timing.mark(primitives::RequestTiming::PHASE_UPSTREAM_START);
+    if (cgiConfig.hasFastcgiPass() || cgiConfig.hasWorkerPool()) {
+      cgi::primitives::CgiRequest cgiRequest(m_request, cgiConfig, matchInfo,
+                                             serverName, serverPort);
+      if (cgiConfig.hasFastcgiPass()) {
+        m_metrics.recordCgiRequest(primitives::ServerMetrics::CGI_FASTCGI);
+        startFastCgi(cgiConfig.getFastcgiPass(), cgiRequest);
+        return;
+      }
+      m_metrics.recordCgiRequest(primitives::ServerMetrics::CGI_WORKER_POOL);
+      startCgiWorker(cgiConfig, cgiRequest);
+      return;
+    }
 
-    buildHttpResponseFromCgi(cgiResponse);
+    cgi::primitives::CgiRequest cgiRequest(
+        m_request, cgiConfig, matchInfo, serverName, serverPort,
+        m_cgiExecutor.getSharedEnvironment(cgiConfig));
+    m_metrics.recordCgiRequest(primitives::ServerMetrics::CGI_SPAWN);
+    startCgiStream(m_cgiExecutor.start(cgiRequest));
 
   } catch (const cgi::exceptions::CgiExecutionException& ex) {
+    m_timing.mark(primitives::RequestTiming::PHASE_UPSTREAM_DONE);
     m_logger.error(std::string("CGI execution error: ") + ex.what());
+    if (ex.getCode() == cgi::exceptions::CgiExecutionException::TIMEOUT) {
+      m_metrics.recordCgiTimeout();
+    }
     generateErrorResponse(
         domain::shared::value_objects::ErrorCode::internalServerError(),
         "CGI Script Error");
@@ -1164,6 +2230,372 @@ void ConnectionHandler::handleCgiRequest(
   }
 }
 
+// Only the exchange is set up here; processEvent() drives it from the
+// FastCGI socket's events, which may be shared with other requests when the
+// server multiplexes, and the orchestrator wakes this handler whenever its
+// records arrive.
+void ConnectionHandler::startFastCgi(
+    const std::string& address, const cgi::primitives::CgiRequest& request) {
+  m_fastCgiSession = new cgi::adapters::FastCgiSession(
+      m_logger, m_fastCgiClient, address, request);
+  m_fastCgiSession->setOwner(getFd());
+  try {
+    m_fastCgiSession->start();
+  } catch (const cgi::exceptions::CgiExecutionException& ex) {
+    failCgi(ex);
+  }
+}
+
+// Same shape as startFastCgi(): the worker's socketpair is watched like any
+// other upstream, and the orchestrator wakes this handler when a request
+// queued behind busy workers can lease one.
+void ConnectionHandler::startCgiWorker(
+    const domain::configuration::value_objects::CgiConfig& config,
+    const cgi::primitives::CgiRequest& request) {
+  m_workerSession = new cgi::adapters::CgiWorkerSession(
+      m_logger, m_cgiWorkerPool, config, request);
+  m_workerSession->setOwner(getFd());
+  try {
+    m_workerSession->start();
+  } catch (const cgi::exceptions::CgiExecutionException& ex) {
+    failCgi(ex);
+  }
+}
+
+void ConnectionHandler::failCgi(
+    const cgi::exceptions::CgiExecutionException& error) {
+  m_logger.error(std::string("CGI execution error: ") + error.what());
+  if (error.getCode() == cgi::exceptions::CgiExecutionException::TIMEOUT) {
+    m_metrics.recordCgiTimeout();
+  }
+  const domain::configuration::entities::RequestPlan* plan = m_upstreamPlan;
+  finishCacheFill(false);
+  retireUpstream();
+  generateErrorResponse(
+      domain::shared::value_objects::ErrorCode::internalServerError(),
+      "CGI Script Error");
+  if (error.getCode() == cgi::exceptions::CgiExecutionException::TIMEOUT) {
+    m_response.setConnection("close");
+  }
+  if (plan != NULL) {
+    applyCustomHeaders(*plan);
+  }
+}
+
+// Only the exchange is set up here; processEvent() drives it from the
+// upstream socket's events and relays the response as it arrives.
+void ConnectionHandler::handleProxyRequest(
+    const domain::configuration::entities::RequestPlan& plan,
+    const domain::configuration::entities::LocationConfig& location) {
+  const domain::http::value_objects::Uri& target = location.getProxyPass();
+  if (!target.isHttp()) {
+    m_logger.error("proxy_pass scheme not supported: " + target.getScheme());
+    generateErrorResponse(
+        domain::shared::value_objects::ErrorCode::badGateway(), "Bad Gateway");
+    return;
+  }
+
+  if (lookupCache(location)) {
+    applyCustomHeaders(plan);
+    return;
+  }
+
+  const unsigned int port = target.hasPort() ? target.getPort().getValue() : 0;
+  const std::string groupKey = m_upstreamPool.resolve(target.getHost(), port);
+
+  std::ostringstream host;
+  host << target.getHost();
+  if (port != 0) {
+    host << ":" << port;
+  }
+
+  const std::string query = m_request.getQuery().build();
+  const std::string requestTarget =
+      proxy::primitives::UpstreamRequest::rewriteTarget(
+          m_request.getPath().toString(), query, location.getPath(),
+          target.getPath());
+  const std::string head = proxy::primitives::UpstreamRequest::buildHead(
+      m_request.getMethod().toString(), requestTarget, host.str(),
+      m_request.getHeaders(), getClientAddress(), m_request.getBody().size());
+
+  std::string hashValue;
+  const proxy::adapters::UpstreamPool::Group* group =
+      m_upstreamPool.findGroup(groupKey);
+  if (group != NULL && group->hashKey == "$remote_addr") {
+    hashValue = getClientAddress();
+  } else if (group != NULL && group->hashKey == "$request_uri") {
+    hashValue = m_request.getPath().toString() + query;
+  } else if (group != NULL && group->hashKey == "$host") {
+    hashValue = m_request.getHost();
+  }
+
+  m_timing.mark(primitives::RequestTiming::PHASE_UPSTREAM_START);
+  m_proxySession = new proxy::adapters::ProxySession(
+      m_logger, m_upstreamPool, groupKey, head, m_request.getBody(),
+      hashValue);
+  m_proxySession->setHeadRequest(m_request.getMethod().isHead());
+  m_proxySession->setTimeouts(location.getProxyConnectTimeout(),
+                              location.getProxyReadTimeout());
+  m_upstreamPlan = &plan;
+
+  WEBSERV_LOG_DEBUG(m_logger, "Proxying " << m_request.getMethod().toString()
+                                          << " " << requestTarget << " to "
+                                          << groupKey);
+
+  try {
+    m_proxySession->start();
+  } catch (const proxy::exceptions::ProxyException& ex) {
+    failProxy(ex);
+  }
+}
+
+// The upstream's framing is kept when it sent a Content-Length; otherwise
+// the body is re-chunked for HTTP/1.1 clients, or delimited by close.
+void ConnectionHandler::startProxyResponse() {
+  const proxy::primitives::UpstreamResponseParser& upstream =
+      m_proxySession->getResponse();
+
+  m_response = domain::http::entities::HttpResponse(
+      domain::shared::value_objects::ErrorCode(upstream.getStatusCode()));
+
+  const proxy::primitives::UpstreamResponseParser::HeaderList& headers =
+      upstream.getHeaders();
+  for (proxy::primitives::UpstreamResponseParser::HeaderList::const_iterator
+           it = headers.begin();
+       it != headers.end(); ++it) {
+    const std::string name =
+        domain::shared::utils::StringUtils::toLowerCase(it->first);
+    if (proxy::primitives::UpstreamRequest::isHopByHopHeader(name) ||
+        name == "content-length" || name == "server") {
+      continue;
+    }
+    if (m_response.hasHeader(name)) {
+      m_response.setHeader(name,
+                           m_response.getHeader(name) + ", " + it->second);
+    } else {
+      m_response.setHeader(name, it->second);
+    }
+  }
+  m_response.setServer(domain::http::entities::HttpResponse::SERVER_NAME);
+  if (!m_response.hasHeader("Date")) {
+    m_response.setDate();
+  }
+
+  const bool hasLength =
+      upstream.getFraming() ==
+      proxy::primitives::UpstreamResponseParser::FRAMING_LENGTH;
+  if (hasLength) {
+    m_response.setContentLength(upstream.getContentLength());
+  }
+
+  m_streamChunked = false;
+  m_streamHasLength =
+      hasLength ||
+      upstream.getFraming() ==
+          proxy::primitives::UpstreamResponseParser::FRAMING_NONE;
+  m_streamRemaining = hasLength && !m_request.getMethod().isHead()
+                          ? upstream.getContentLength()
+                          : 0;
+  if (!m_streamHasLength && m_http2 == NULL) {
+    if (m_request.getVersion().isHttp11()) {
+      m_response.setHeader("Transfer-Encoding", "chunked");
+      m_streamChunked = true;
+    } else {
+      m_response.setConnection("close");
+    }
+  }
+
+  beginCacheFill();
+  if (m_upstreamPlan != NULL) {
+    applyCustomHeaders(*m_upstreamPlan);
+  }
+}
+
+void ConnectionHandler::failProxy(
+    const proxy::exceptions::ProxyException& error) {
+  m_logger.error(std::string("Proxy error: ") + error.what());
+  finishCacheFill(false);
+  retireUpstream();
+  if (error.getCode() == proxy::exceptions::ProxyException::TIMEOUT) {
+    generateErrorResponse(
+        domain::shared::value_objects::ErrorCode::gatewayTimeout(),
+        "Gateway Timeout");
+    m_response.setConnection("close");
+  } else {
+    generateErrorResponse(
+        domain::shared::value_objects::ErrorCode::badGateway(), "Bad Gateway");
+  }
+}
+
+// True when the request was answered from the cache or parked behind
+// another request's cache lock. On a miss the key is kept so the response
+// can be stored; HEAD misses and lock-timeout retries are not stored.
+bool ConnectionHandler::lookupCache(
+    const domain::configuration::entities::LocationConfig& location) {
+  const domain::configuration::value_objects::ProxyCacheConfig& config =
+      location.getProxyCache();
+  const domain::http::value_objects::HttpMethod& method =
+      m_request.getMethod();
+  if (!config.isEnabled() || (!method.isGet() && !method.isHead()) ||
+      !m_responseCache.hasZone(config.getZone())) {
+    return false;
+  }
+
+  const std::string key = cache::primitives::CacheKey::render(
+      config.getKey(), m_request, getScheme(), getClientAddress());
+  cache::adapters::ResponseCache::Response cached;
+  const cache::adapters::ResponseCache::Status status =
+      m_responseCache.lookup(config.getZone(), key, std::time(NULL), cached);
+  m_cacheConfig = NULL;
+  if (status == cache::adapters::ResponseCache::STATUS_HIT) {
+    m_cacheStatus = "HIT";
+    serveCachedResponse(cached);
+    return true;
+  }
+
+  m_cacheStatus =
+      status == cache::adapters::ResponseCache::STATUS_EXPIRED ? "EXPIRED"
+                                                               : "MISS";
+  if (m_cacheBypass || method.isHead()) {
+    return false;
+  }
+
+  m_cacheConfig = &config;
+  m_cacheKey = key;
+  if (config.isLockEnabled()) {
+    if (!m_responseCache.lock(config.getZone(), key)) {
+      if (m_cacheWaitStart == 0) {
+        m_cacheWaitStart = std::time(NULL);
+      }
+      m_state = STATE_CACHE_WAIT;
+      return true;
+    }
+    m_cacheLockHeld = true;
+  }
+  return false;
+}
+
+void ConnectionHandler::serveCachedResponse(
+    const cache::adapters::ResponseCache::Response& cached) {
+  m_response = domain::http::entities::HttpResponse(
+      domain::shared::value_objects::ErrorCode(cached.status));
+  for (cache::adapters::ResponseCache::HeaderMap::const_iterator it =
+           cached.headers.begin();
+       it != cached.headers.end(); ++it) {
+    m_response.setHeader(it->first, it->second);
+  }
+  m_response.setServer(domain::http::entities::HttpResponse::SERVER_NAME);
+  m_response.setDate();
+  if (m_request.getMethod().isHead()) {
+    m_response.clearBody();
+    m_response.setContentLength(cached.body.size());
+  } else {
+    m_response.setBody(cached.body);
+  }
+}
+
+// The stored head leaves out what is rebuilt for every response served from
+// the entry: framing, connection handling, Server and Date.
+void ConnectionHandler::beginCacheFill() {
+  if (m_cacheConfig == NULL) {
+    return;
+  }
+
+  const std::time_t now = std::time(NULL);
+  const unsigned int status = m_response.getStatusCode().getValue();
+  const std::time_t expires = cache::primitives::CachePolicy::freshUntil(
+      status, m_response.getHeaders(), *m_cacheConfig, now);
+  if (expires > now) {
+    cache::adapters::ResponseCache::HeaderMap headers;
+    const domain::http::entities::HttpResponse::HeaderMap& current =
+        m_response.getHeaders();
+    for (domain::http::entities::HttpResponse::HeaderMap::const_iterator it =
+             current.begin();
+         it != current.end(); ++it) {
+      if (it->first != "connection" && it->first != "keep-alive" &&
+          it->first != "transfer-encoding" && it->first != "content-length" &&
+          it->first != "server" && it->first != "date") {
+        headers.insert(*it);
+      }
+    }
+    m_cacheFill = m_responseCache.startFill(m_cacheConfig->getZone(),
+                                            m_cacheKey, status, headers,
+                                            expires);
+  }
+  if (m_cacheFill == NULL) {
+    finishCacheFill(false);
+  }
+}
+
+// Releasing the lock here, whether or not the entry was stored, is what
+// lets requests parked in STATE_CACHE_WAIT move on.
+void ConnectionHandler::finishCacheFill(bool commit) {
+  if (m_cacheFill != NULL) {
+    if (commit) {
+      m_cacheFill->commit();
+    } else {
+      m_cacheFill->abort();
+    }
+    delete m_cacheFill;
+    m_cacheFill = NULL;
+  }
+  if (m_cacheLockHeld) {
+    m_responseCache.unlock(m_cacheConfig->getZone(), m_cacheKey);
+    m_cacheLockHeld = false;
+  }
+  m_cacheConfig = NULL;
+}
+
+// limit_req, then limit_conn, charged once per request: a request resumed
+// after its delay or after a cache lock is let through on the same grant.
+bool ConnectionHandler::applyRequestLimits(
+    const domain::configuration::entities::LocationConfig& location) {
+  const domain::configuration::value_objects::RequestLimitConfig& limits =
+      location.getRequestLimits();
+  if (m_limitsPassed || !limits.isEnabled()) {
+    return true;
+  }
+
+  const unsigned long nowMillis = primitives::RequestTiming::nowMillis();
+  const std::string clientAddress = getClientAddress();
+  if (m_limitWakeMillis == 0) {
+    unsigned long delayMillis = 0;
+    const limits::adapters::RequestLimiter::Outcome outcome =
+        m_requestLimiter.limitRequest(limits, m_request, clientAddress,
+                                      nowMillis, delayMillis);
+    if (outcome == limits::adapters::RequestLimiter::OUTCOME_REJECT) {
+      rejectLimitedRequest(location, limits.getRequestStatus());
+      return false;
+    }
+    if (outcome == limits::adapters::RequestLimiter::OUTCOME_DELAY) {
+      m_limitWakeMillis = nowMillis + delayMillis;
+      m_state = STATE_LIMIT_DELAY;
+      return false;
+    }
+  }
+
+  if (m_requestLimiter.limitConnection(limits, m_request, clientAddress,
+                                       nowMillis, m_limitLease) ==
+      limits::adapters::RequestLimiter::OUTCOME_REJECT) {
+    rejectLimitedRequest(location, limits.getConnectionStatus());
+    return false;
+  }
+  m_limitsPassed = true;
+  return true;
+}
+
+void ConnectionHandler::rejectLimitedRequest(
+    const domain::configuration::entities::LocationConfig& location,
+    unsigned int status) {
+  const domain::shared::value_objects::ErrorCode statusCode(status);
+  const std::string* errorPage = planFor(location).findErrorPage(statusCode);
+  if (errorPage != NULL) {
+    serveErrorPage(*errorPage, statusCode, location);
+    return;
+  }
+  generateErrorResponse(statusCode, statusCode.getDescription());
+}
+
 void ConnectionHandler::handleFileUpload(
     const domain::configuration::entities::LocationConfig& location,
     const domain::filesystem::value_objects::Path& /* requestPath */) {
@@ -1178,14 +2610,16 @@ void ConnectionHandler::handleFileUpload(
       location.getUploadConfig();
 
   try {
-    if (!m_request.hasHeader("content-type")) {
+    if (!m_request.hasHeader(
+            domain::http::value_objects::HttpHeader::HEADER_CONTENT_TYPE)) {
       generateErrorResponse(
           domain::shared::value_objects::ErrorCode::badRequest(),
           "Content-Type header required for upload");
       return;
     }
 
-    std::string contentType = m_request.getHeader("content-type");
+    std::string contentType = m_request.getHeader(
+        domain::http::value_objects::HttpHeader::HEADER_CONTENT_TYPE);
     if (contentType.find("multipart/form-data") == std::string::npos) {
       generateErrorResponse(
           domain::shared::value_objects::ErrorCode::badRequest(),
@@ -1201,7 +2635,7 @@ void ConnectionHandler::handleFileUpload(
       return;
     }
 
-    m_logger.debug("Upload boundary: " + boundary);
+    WEBSERV_LOG_DEBUG(m_logger, "Upload boundary: " << boundary);
 
     const domain::http::entities::HttpRequest::Body& body = m_request.getBody();
     std::string bodyStr(body.begin(), body.end());
@@ -1230,17 +2664,27 @@ void ConnectionHandler::handleFileUpload(
     }
 
     filename = sanitizeFilename(filename);
-    m_logger.debug("Upload filename: " + filename);
+    WEBSERV_LOG_DEBUG(m_logger, "Upload filename: " << filename);
+
+    const std::string& uploadType =
+        m_configSnapshot.getConfiguration().getMimeTypes().lookupFilename(
+            filename);
+    if (!uploadConfig.validateMimeType(uploadType)) {
+      generateErrorResponse(
+          domain::shared::value_objects::ErrorCode(
+              domain::shared::value_objects::ErrorCode::
+                  STATUS_UNSUPPORTED_MEDIA_TYPE),
+          "File type not allowed: " + uploadType);
+      return;
+    }
 
-    std::ostringstream sizeMsg;
-    sizeMsg << "Upload content size: " << fileContent.size();
-    m_logger.debug(sizeMsg.str());
+    WEBSERV_LOG_DEBUG(m_logger, "Upload content size: " << fileContent.size());
 
     domain::filesystem::value_objects::Path uploadDir =
         uploadConfig.getUploadDirectory();
     domain::filesystem::value_objects::Path filePath = uploadDir.join(filename);
 
-    m_logger.debug("Upload destination: " + filePath.toString());
+    WEBSERV_LOG_DEBUG(m_logger, "Upload destination: " << filePath.toString());
 
     ensureDirectoryExists(uploadDir);
     writeUploadedFile(filePath, fileContent);
@@ -1452,6 +2896,24 @@ void ConnectionHandler::handleReturnContent(
   m_response.setContentType("text/plain");
 }
 
+void ConnectionHandler::handleStatusRequest(
+    const domain::configuration::entities::LocationConfig& location) {
+  const bool prometheus =
+      location.getStatusFormat() ==
+      domain::configuration::entities::LocationConfig::STATUS_PROMETHEUS;
+
+  m_response = domain::http::entities::HttpResponse(
+      domain::shared::value_objects::ErrorCode::ok(),
+      prometheus ? m_metrics.renderPrometheus() : m_metrics.renderText());
+  m_response.setContentType(prometheus ? "text/plain; version=0.0.4"
+                                       : "text/plain");
+  m_response.addHeader("Cache-Control", "no-store");
+}
+
+// Connection is left to applyConnectionHeader(), so an error answer keeps
+// the connection alive like any other; only the callers that cannot trust
+// the rest of the stream (parse errors, oversized requests, timeouts) mark
+// the response close.
 void ConnectionHandler::generateErrorResponse(
     const domain::shared::value_objects::ErrorCode& statusCode,
     const std::string& message) {
@@ -1474,8 +2936,6 @@ void ConnectionHandler::generateErrorResponse(
   } else {
     m_response = domain::http::entities::HttpResponse(statusCode, message);
   }
-
-  m_response.setConnection("close");
 }
 
 void ConnectionHandler::handleNotFound(
@@ -1483,50 +2943,16 @@ void ConnectionHandler::handleNotFound(
   domain::shared::value_objects::ErrorCode notFoundCode =
       domain::shared::value_objects::ErrorCode::notFound();
 
-  std::ostringstream debugMsg;
-  debugMsg << "handleNotFound: looking for 404 error page";
-  m_logger.debug(debugMsg.str());
-
-  const domain::configuration::entities::LocationConfig::ErrorPageMap&
-      locationErrorPages = location.getErrorPages();
-
-  domain::configuration::entities::LocationConfig::ErrorPageMap::const_iterator
-      locationIt = locationErrorPages.find(notFoundCode);
-
-  if (locationIt != locationErrorPages.end()) {
-    std::ostringstream foundMsg;
-    foundMsg << "handleNotFound: found 404 page in location config: "
-             << locationIt->second;
-    m_logger.debug(foundMsg.str());
-    serveErrorPage(locationIt->second, notFoundCode, location);
+  const std::string* errorPage = planFor(location).findErrorPage(notFoundCode);
+  if (errorPage != NULL) {
+    WEBSERV_LOG_DEBUG(m_logger,
+                      "handleNotFound: found 404 page: " << *errorPage);
+    serveErrorPage(*errorPage, notFoundCode, location);
     return;
   }
 
-  std::ostringstream tryServerMsg;
-  tryServerMsg << "handleNotFound: 404 not in location, checking server config";
-  m_logger.debug(tryServerMsg.str());
-
-  if (m_serverConfig != NULL) {
-    const domain::configuration::entities::ServerConfig::ErrorPageMap&
-        serverErrorPages = m_serverConfig->getErrorPages();
-
-    domain::configuration::entities::ServerConfig::ErrorPageMap::const_iterator
-        serverIt = serverErrorPages.find(notFoundCode);
-
-    if (serverIt != serverErrorPages.end()) {
-      std::ostringstream foundServerMsg;
-      foundServerMsg << "handleNotFound: found 404 page in server config: "
-                     << serverIt->second;
-      m_logger.debug(foundServerMsg.str());
-      serveErrorPage(serverIt->second, notFoundCode, location);
-      return;
-    }
-  }
-
-  std::ostringstream noErrorPageMsg;
-  noErrorPageMsg
-      << "handleNotFound: no 404 error page configured, generating default";
-  m_logger.debug(noErrorPageMsg.str());
+  WEBSERV_LOG_DEBUG(m_logger, "handleNotFound: no 404 error page "
+                              "configured, generating default");
   generateErrorResponse(notFoundCode, "Not Found");
 }
 
@@ -1535,52 +2961,16 @@ void ConnectionHandler::handlePayloadTooLarge(
   domain::shared::value_objects::ErrorCode payloadTooLargeCode =
       domain::shared::value_objects::ErrorCode::payloadTooLarge();
 
-  std::ostringstream debugMsg;
-  debugMsg << "handlePayloadTooLarge: looking for 413 error page";
-  m_logger.debug(debugMsg.str());
-
-  const domain::configuration::entities::LocationConfig::ErrorPageMap&
-      locationErrorPages = location.getErrorPages();
-
-  domain::configuration::entities::LocationConfig::ErrorPageMap::const_iterator
-      locationIt = locationErrorPages.find(payloadTooLargeCode);
-
-  if (locationIt != locationErrorPages.end()) {
-    std::ostringstream foundMsg;
-    foundMsg << "handlePayloadTooLarge: found 413 page in location config: "
-             << locationIt->second;
-    m_logger.debug(foundMsg.str());
-    serveErrorPage(locationIt->second, payloadTooLargeCode, location);
+  const std::string* errorPage = planFor(location).findErrorPage(payloadTooLargeCode);
+  if (errorPage != NULL) {
+    WEBSERV_LOG_DEBUG(m_logger,
+                      "handlePayloadTooLarge: found 413 page: " << *errorPage);
+    serveErrorPage(*errorPage, payloadTooLargeCode, location);
     return;
   }
 
-  std::ostringstream tryServerMsg;
-  tryServerMsg
-      << "handlePayloadTooLarge: 413 not in location, checking server config";
-  m_logger.debug(tryServerMsg.str());
-
-  if (m_serverConfig != NULL) {
-    const domain::configuration::entities::ServerConfig::ErrorPageMap&
-        serverErrorPages = m_serverConfig->getErrorPages();
-
-    domain::configuration::entities::ServerConfig::ErrorPageMap::const_iterator
-        serverIt = serverErrorPages.find(payloadTooLargeCode);
-
-    if (serverIt != serverErrorPages.end()) {
-      std::ostringstream foundServerMsg;
-      foundServerMsg
-          << "handlePayloadTooLarge: found 413 page in server config: "
-          << serverIt->second;
-      m_logger.debug(foundServerMsg.str());
-      serveErrorPage(serverIt->second, payloadTooLargeCode, location);
-      return;
-    }
-  }
-
-  std::ostringstream noErrorPageMsg;
-  noErrorPageMsg << "handlePayloadTooLarge: no 413 error page configured, "
-                    "generating default";
-  m_logger.debug(noErrorPageMsg.str());
+  WEBSERV_LOG_DEBUG(m_logger, "handlePayloadTooLarge: no 413 error page "
+                              "configured, generating default");
   generateErrorResponse(payloadTooLargeCode, "Request entity too large");
 }
 
@@ -1589,18 +2979,17 @@ void ConnectionHandler::serveErrorPage(
     const domain::shared::value_objects::ErrorCode& statusCode,
     const domain::configuration::entities::LocationConfig& location) {
   try {
-    std::ostringstream debugStart;
-    debugStart << "Attempting to serve error page: " << errorPagePath
-               << " for status code: " << statusCode.getValue();
-    m_logger.debug(debugStart.str());
+    WEBSERV_LOG_DEBUG(m_logger,
+                      "Attempting to serve error page: "
+                          << errorPagePath << " for status code: "
+                          << statusCode.getValue());
 
     domain::filesystem::value_objects::Path errorPath =
         resolveErrorPagePath(location, errorPagePath);
 
-    std::ostringstream debugMsg;
-    debugMsg << "Resolved error page path: " << errorPagePath << " -> "
-             << errorPath.toString();
-    m_logger.debug(debugMsg.str());
+    WEBSERV_LOG_DEBUG(m_logger,
+                      "Resolved error page path: "
+                          << errorPagePath << " -> " << errorPath.toString());
 
     const std::string errorPathStr = errorPath.toString();
 
@@ -1623,17 +3012,16 @@ void ConnectionHandler::serveErrorPage(
 
     std::string contentStr = contentStream.str();
 
-    std::ostringstream sizeMsg;
-    sizeMsg << "Read error page file: " << contentStr.size() << " bytes";
-    m_logger.debug(sizeMsg.str());
+    WEBSERV_LOG_DEBUG(m_logger,
+                      "Read error page file: "
+                          << contentStr.size() << " bytes");
 
     m_response = domain::http::entities::HttpResponse(statusCode, contentStr);
     m_response.setContentType("text/html");
 
-    std::ostringstream successMsg;
-    successMsg << "Served error page " << statusCode.getValue()
-               << " from: " << errorPathStr;
-    m_logger.debug(successMsg.str());
+    WEBSERV_LOG_DEBUG(m_logger,
+                      "Served error page " << statusCode.getValue()
+                                           << " from: " << errorPathStr);
 
   } catch (const std::exception& ex) {
     m_logger.error(std::string("Error page serving failed: ") + ex.what());
@@ -1641,31 +3029,37 @@ void ConnectionHandler::serveErrorPage(
   }
 }
 
-bool ConnectionHandler::validateRequestBodySize(
+// Requests only ever reach locations of a published snapshot, and
+// publishing compiles every location's plan.
+const domain::configuration::entities::RequestPlan& ConnectionHandler::planFor(
     const domain::configuration::entities::LocationConfig& location) const {
+  const domain::configuration::entities::RequestPlan* plan =
+      location.getRequestPlan();
+  assert(plan != NULL);
+  return *plan;
+}
+
+bool ConnectionHandler::validateRequestBodySize(
+    const domain::configuration::entities::RequestPlan& plan) const {
   if (!m_request.hasBody()) {
     return true;
   }
 
-  const domain::http::entities::HttpRequest::Body& body = m_request.getBody();
-  const domain::filesystem::value_objects::Size& maxSize =
-      location.getClientMaxBodySize();
-
-  return body.size() <= maxSize.getBytes();
+  return m_request.getBody().size() <= plan.getMaxBodyBytes();
 }
 
 domain::filesystem::value_objects::Path ConnectionHandler::tryFindFile(
     const domain::configuration::entities::LocationConfig& location,
     const domain::filesystem::value_objects::Path& requestPath) const {
   const domain::configuration::entities::LocationConfig::TryFiles& tryFiles =
-      location.getTryFiles();
+      planFor(location).getTryFiles();
 
   const std::string requestPathStr = requestPath.toString();
 
-  std::ostringstream debugStart;
-  debugStart << "try_files: starting with " << tryFiles.size()
-             << " patterns for path: " << requestPathStr;
-  m_logger.debug(debugStart.str());
+  WEBSERV_LOG_DEBUG(m_logger,
+                    "try_files: starting with "
+                        << tryFiles.size() << " patterns for path: "
+                        << requestPathStr);
 
   for (domain::configuration::entities::LocationConfig::TryFiles::const_iterator
            it = tryFiles.begin();
@@ -1673,10 +3067,11 @@ domain::filesystem::value_objects::Path ConnectionHandler::tryFindFile(
     std::string tryFilePattern = *it;
 
     if (!tryFilePattern.empty() && tryFilePattern[0] == '=') {
-      std::ostringstream statusMsg;
-      statusMsg << "try_files: reached status code pattern '" << tryFilePattern
-                << "', returning empty path to trigger error handling";
-      m_logger.debug(statusMsg.str());
+      WEBSERV_LOG_DEBUG(m_logger,
+                        "try_files: reached status code pattern '"
+                            << tryFilePattern
+                            << "', returning empty path to trigger error "
+                               "handling");
       return domain::filesystem::value_objects::Path();
     }
 
@@ -1688,39 +3083,38 @@ domain::filesystem::value_objects::Path ConnectionHandler::tryFindFile(
           substitutedPattern.find("$uri", uriPos + requestPathStr.length());
     }
 
-    std::ostringstream patternMsg;
-    patternMsg << "try_files: processing pattern '" << tryFilePattern
-               << "' -> '" << substitutedPattern << "'";
-    m_logger.debug(patternMsg.str());
+    WEBSERV_LOG_DEBUG(m_logger,
+                      "try_files: processing pattern '"
+                          << tryFilePattern << "' -> '" << substitutedPattern
+                          << "'");
 
     try {
       domain::filesystem::value_objects::Path tryPath =
           resolvePathWithServerFallback(location, substitutedPattern);
 
-      std::ostringstream debugMsg;
-      debugMsg << "try_files: resolved to '" << tryPath.toString() << "'";
-      m_logger.debug(debugMsg.str());
+      WEBSERV_LOG_DEBUG(m_logger,
+                        "try_files: resolved to '"
+                            << tryPath.toString() << "'");
 
       if (filesystem::adapters::FileSystemHelper::exists(tryPath.toString())) {
-        std::ostringstream foundMsg;
-        foundMsg << "try_files: FOUND file at '" << tryPath.toString() << "'";
-        m_logger.debug(foundMsg.str());
+        WEBSERV_LOG_DEBUG(m_logger,
+                          "try_files: FOUND file at '"
+                              << tryPath.toString() << "'");
         return tryPath;
       } else {
-        std::ostringstream notFoundMsg;
-        notFoundMsg << "try_files: file does not exist: '" << tryPath.toString()
-                    << "'";
-        m_logger.debug(notFoundMsg.str());
+        WEBSERV_LOG_DEBUG(m_logger,
+                          "try_files: file does not exist: '"
+                              << tryPath.toString() << "'");
       }
     } catch (const std::exception& ex) {
-      std::ostringstream errMsg;
-      errMsg << "try_files: exception while resolving '" << substitutedPattern
-             << "': " << ex.what();
-      m_logger.debug(errMsg.str());
+      WEBSERV_LOG_DEBUG(m_logger,
+                        "try_files: exception while resolving '"
+                            << substitutedPattern << "': " << ex.what());
     }
   }
 
-  m_logger.debug("try_files: exhausted all patterns, returning empty path");
+  WEBSERV_LOG_DEBUG(m_logger,
+                    "try_files: exhausted all patterns, returning empty path");
   return domain::filesystem::value_objects::Path();
 }
 
@@ -1756,44 +3150,113 @@ void ConnectionHandler::buildHttpResponseFromCgi(
   }
 }
 
-void ConnectionHandler::applyCustomHeaders(
-    const domain::configuration::entities::LocationConfig& location) {
-  if (!location.hasCustomHeaders()) {
-    return;
+// The stdout pipe is watched from the moment the script starts; the header
+// block is collected from its readable events by advanceCgiStream().
+void ConnectionHandler::startCgiStream(cgi::adapters::CgiStream* stream) {
+  m_cgiStream = stream;
+}
+
+// The body is relayed from the pipe by handleWrite(), chunked unless the
+// script announced a Content-Length.
+void ConnectionHandler::startCgiResponse() {
+  const cgi::primitives::CgiResponse& head = m_cgiStream->getResponse();
+  buildHttpResponseFromCgi(head);
+  m_streamChunked = false;
+  m_streamHasLength = head.getHeaders().count("content-length") != 0;
+  m_streamRemaining = m_streamHasLength ? m_response.getContentLength() : 0;
+
+  if (!m_streamHasLength) {
+    m_response.removeHeader("Content-Length");
+  }
+  if (!m_streamHasLength && m_http2 == NULL) {
+    if (m_request.getVersion().isHttp11()) {
+      m_response.setHeader("Transfer-Encoding", "chunked");
+      m_streamChunked = true;
+    } else {
+      m_response.setConnection("close");
+    }
   }
+  beginCacheFill();
+}
 
-  const domain::configuration::entities::LocationConfig::CustomHeaderMap&
-      customHeaders = location.getCustomHeaders();
+void ConnectionHandler::applyCustomHeaders(
+    const domain::configuration::entities::RequestPlan& plan) {
+  const domain::configuration::entities::RequestPlan::HeaderBlock& headers =
+      plan.getHeaders();
 
-  for (domain::configuration::entities::LocationConfig::CustomHeaderMap::
-           const_iterator it = customHeaders.begin();
-       it != customHeaders.end(); ++it) {
+  for (domain::configuration::entities::RequestPlan::HeaderBlock::
+           const_iterator it = headers.begin();
+       it != headers.end(); ++it) {
     m_response.addHeader(it->first, it->second);
   }
 }
 
 bool ConnectionHandler::shouldKeepAlive() const {
+  if (m_requestServer->getKeepaliveTimeout() == 0 ||
+      m_requestCount >= m_requestServer->getKeepaliveRequests()) {
+    return false;
+  }
+
+  std::string connection = m_response.getConnection();
+  std::transform(connection.begin(), connection.end(), connection.begin(),
+                 ::tolower);
+  if (connection == "close") {
+    return false;
+  }
+
   return m_request.isKeepAlive();
 }
 
+void ConnectionHandler::applyConnectionHeader() {
+  if (shouldKeepAlive()) {
+    m_response.setConnection("keep-alive");
+  } else {
+    m_response.setConnection("close");
+  }
+}
+
 void ConnectionHandler::resetForNextRequest() {
-  m_requestBuffer.clear();
+  if (m_readBuffer.empty()) {
+    m_readBuffer.reset();
+  }
+  m_parser.reset();
+  m_headersReceived = false;
   m_request = domain::http::entities::HttpRequest();
   m_response = domain::http::entities::HttpResponse();
   m_responseBuffer.clear();
   m_responseOffset = 0;
+  m_upstreamPlan = NULL;
+  m_streamChunked = false;
+  m_streamHasLength = false;
+  m_streamRemaining = 0;
+  m_cacheKey.clear();
+  m_cacheBypass = false;
+  m_cacheWaitStart = 0;
+  m_cacheStatus.clear();
+  m_limitWakeMillis = 0;
+  m_limitsPassed = false;
 }
 
 std::string ConnectionHandler::formatState() const {
   switch (m_state) {
+    case STATE_TLS_HANDSHAKE:
+      return "TLS_HANDSHAKE";
     case STATE_READING_REQUEST:
       return "READING_REQUEST";
     case STATE_PROCESSING:
       return "PROCESSING";
+    case STATE_PROXYING:
+      return "PROXYING";
+    case STATE_CACHE_WAIT:
+      return "CACHE_WAIT";
+    case STATE_LIMIT_DELAY:
+      return "LIMIT_DELAY";
     case STATE_WRITING_RESPONSE:
       return "WRITING_RESPONSE";
     case STATE_KEEP_ALIVE:
       return "KEEP_ALIVE";
+    case STATE_HTTP2:
+      return "HTTP2";
     case STATE_CLOSING:
       return "CLOSING";
     default:
@@ -1801,14 +3264,74 @@ std::string ConnectionHandler::formatState() const {
   }
 }
 
+const char* ConnectionHandler::getScheme() const {
+  return m_socket->isTls() ? "https" : "http";
+}
+
 void ConnectionHandler::logRequest(
     const domain::http::entities::HttpRequest& request,
     const domain::http::entities::HttpResponse& response) {
+  WEBSERV_LOG_INFO(m_logger,
+                   getRemoteAddress() << " - \""
+                                      << request.getMethod().toString() << " "
+                                      << request.getPath().toString() << " "
+                                      << request.getVersion().toString()
+                                      << "\" "
+                                      << response.getStatusCode().getValue());
+}
+
+// The bare client address, as $remote_addr: no port, no IPv6 brackets.
+std::string ConnectionHandler::getClientAddress() const {
+  const std::string peer = getRemoteAddress();
+  const std::string::size_type colon = peer.rfind(':');
+  std::string address =
+      colon == std::string::npos ? peer : peer.substr(0, colon);
+  if (address.size() > 2 && address[0] == '[') {
+    address = address.substr(1, address.size() - 2);
+  }
+  return address;
+}
+
+void ConnectionHandler::writeAccessLog() {
+  logging::AccessLogEntry entry;
+  entry.remoteAddress = getClientAddress();
+  entry.method = m_request.getMethod().toString();
+  entry.uri = m_request.getPath().toString();
+  entry.query = m_request.getQuery().build();
+  entry.protocol = m_request.getVersion().toString();
+  entry.host = m_request.getHost();
+  entry.referer = m_request.getHeader(
+      domain::http::value_objects::HttpHeader::HEADER_REFERER);
+  entry.userAgent = m_request.getHeader(
+      domain::http::value_objects::HttpHeader::HEADER_USER_AGENT);
+  entry.cacheStatus = m_cacheStatus;
+  entry.status = m_response.getStatusCode().getValue();
+  entry.requestLength = m_requestLength;
+  entry.bytesSent = m_responseBytesSent;
+  entry.bodyBytesSent = m_responseBytesSent > m_responseHeaderBytes
+                            ? m_responseBytesSent - m_responseHeaderBytes
+                            : 0;
+  entry.time = std::time(NULL);
+  entry.timing = &m_timing;
+  m_accessLog.write(entry);
+}
+
+void ConnectionHandler::reportSlowRequest(long totalMicros) {
+  const unsigned long thresholdMillis =
+      m_configSnapshot.getConfiguration().getSlowRequestThreshold();
+  if (thresholdMillis == 0 || totalMicros < 0 ||
+      static_cast<unsigned long>(totalMicros) < thresholdMillis * 1000ul) {
+    return;
+  }
+
   std::ostringstream oss;
-  oss << getRemoteAddress() << " - \"" << request.getMethod().toString() << " "
-      << request.getPath().toString() << " " << request.getVersion().toString()
-      << "\" " << response.getStatusCode().getValue();
-  m_logger.info(oss.str());
+  oss << "Slow request: " << getRemoteAddress() << " \""
+      << m_request.getMethod().toString() << " "
+      << m_request.getPath().toString() << "\" "
+      << m_response.getStatusCode().getValue() << " took "
+      << primitives::RequestTiming::formatSeconds(totalMicros) << "s ("
+      << m_timing.formatBreakdown() << ")";
+  m_logger.warn(oss.str());
 }
 
 }  // namespace adapters
@@ -13,17 +13,35 @@
 #ifndef CONNECTIONHANDLER_HPP
 #define CONNECTIONHANDLER_HPP
 
-#include "application/ports/IConfigProvider.hpp"
 #include "application/ports/ILogger.hpp"
+#include "domain/configuration/entities/ConfigSnapshot.hpp"
 #include "domain/configuration/entities/LocationConfig.hpp"
+#include "domain/configuration/entities/RequestPlan.hpp"
 #include "domain/configuration/entities/ServerConfig.hpp"
-#include "domain/configuration/value_objects/Route.hpp"
 #include "domain/filesystem/value_objects/Path.hpp"
 #include "domain/http/entities/HttpRequest.hpp"
 #include "domain/http/entities/HttpResponse.hpp"
 #include "domain/shared/value_objects/ErrorCode.hpp"
+#include "infrastructure/cache/adapters/ResponseCache.hpp"
+#include "infrastructure/cgi/adapters/CgiExecutor.hpp"
+#include "infrastructure/cgi/adapters/CgiStream.hpp"
+#include "infrastructure/cgi/adapters/CgiWorkerPool.hpp"
+#include "infrastructure/cgi/adapters/CgiWorkerSession.hpp"
+#include "infrastructure/cgi/adapters/FastCgiClient.hpp"
+#include "infrastructure/cgi/adapters/FastCgiSession.hpp"
+#include "infrastructure/cgi/exceptions/CgiExecutionException.hpp"
 #include "infrastructure/cgi/primitives/CgiResponse.hpp"
+#include "infrastructure/http/RequestParser.hpp"
+#include "infrastructure/http2/adapters/Http2Session.hpp"
+#include "infrastructure/limits/adapters/RequestLimiter.hpp"
+#include "infrastructure/logging/AccessLog.hpp"
 #include "infrastructure/network/adapters/TcpSocket.hpp"
+#include "infrastructure/network/primitives/ReadArena.hpp"
+#include "infrastructure/network/primitives/RequestTiming.hpp"
+#include "infrastructure/network/primitives/ServerMetrics.hpp"
+#include "infrastructure/proxy/adapters/ProxySession.hpp"
+#include "infrastructure/proxy/adapters/UpstreamPool.hpp"
+#include "infrastructure/proxy/exceptions/ProxyException.hpp"
 
 #include <ctime>
 #include <map>
@@ -37,27 +55,39 @@ namespace adapters {
 class ConnectionHandler {
  public:
   enum State {
+    STATE_TLS_HANDSHAKE,
     STATE_READING_REQUEST,
     STATE_PROCESSING,
+    STATE_PROXYING,
+    STATE_CACHE_WAIT,
+    STATE_LIMIT_DELAY,
     STATE_WRITING_RESPONSE,
     STATE_KEEP_ALIVE,
+    STATE_HTTP2,
     STATE_CLOSING
   };
 
   static const size_t K_READ_BUFFER_SIZE = 8192;
-  static const time_t K_CONNECTION_TIMEOUT = 60;
-  static const time_t K_KEEPALIVE_TIMEOUT = 5;
-  static const size_t K_MAX_REQUEST_SIZE = 1048576;
+  static const size_t K_STREAM_CHUNK_SIZE = 16384;
 
   ConnectionHandler(
       TcpSocket* socket,
       const domain::configuration::entities::ServerConfig* serverConfig,
       application::ports::ILogger& logger,
-      application::ports::IConfigProvider& configProvider);
+      domain::configuration::entities::ConfigSnapshot& configSnapshot,
+      cgi::adapters::FastCgiClient& fastCgiClient,
+      cgi::adapters::CgiWorkerPool& cgiWorkerPool,
+      cgi::adapters::CgiExecutor& cgiExecutor,
+      proxy::adapters::UpstreamPool& upstreamPool,
+      cache::adapters::ResponseCache& responseCache,
+      limits::adapters::RequestLimiter& requestLimiter,
+      primitives::ServerMetrics& metrics, logging::AccessLog& accessLog);
 
   ~ConnectionHandler();
 
   void processEvent();
+  void enableHttp2();
+  void setListenBinding(const std::string& address, unsigned int port);
 
   bool shouldClose() const;
 
@@ -66,38 +96,93 @@ class ConnectionHandler {
   std::string getRemoteAddress() const;
 
   bool isTimedOut(time_t currentTime) const;
+  bool wantsRead() const;
+  bool wantsWrite() const;
+
+  bool isStreamingUpstream() const;
+  int getUpstreamEvents() const;
+  int getUpstreamFd() const;
+  void checkUpstreamTimeout(time_t currentTime);
+  void releaseRetiredUpstreams();
+
+  bool isWaitingForCache() const;
+  void resumeCacheWait(time_t currentTime);
+
+  bool isDelayedByLimit() const;
+  unsigned long getLimitWakeMillis() const;
+  void resumeLimitDelay(unsigned long nowMillis);
 
   void updateLastActivity(time_t currentTime);
 
+  static const domain::configuration::entities::LocationConfig*
+  findMatchingLocation(
+      const domain::configuration::entities::ServerConfig* serverConfig,
+      const std::string& requestPath);
+
  private:
+  typedef void (ConnectionHandler::*MethodHandler)(
+      const domain::configuration::entities::RequestPlan& plan,
+      const domain::configuration::entities::LocationConfig& location,
+      const domain::filesystem::value_objects::Path& requestPath);
+
+  static const MethodHandler
+      K_METHOD_HANDLERS[domain::http::value_objects::HttpMethod::METHOD_UNKNOWN +
+                        1];
+
   ConnectionHandler(const ConnectionHandler&);
   ConnectionHandler& operator=(const ConnectionHandler&);
 
+  void processHttp1Event();
+  bool advanceHandshake();
   void handleRead();
   void handleWrite();
+  bool pumpUpstream();
+  ssize_t readUpstream(char* buffer, size_t size, bool& failed);
+  void retireUpstream();
+  bool advanceUpstream();
+  bool advanceProxy();
+  bool advanceCgiStream();
+  bool advanceCgi();
+  void prepareResponse();
+  void finishResponse();
+  void processBufferedRequest();
+  bool resumePipelinedRequest();
+
+  bool detectHttp2Preface();
+  bool upgradeToHttp2();
+  void startHttp2();
+  void processHttp2Event();
+  bool advanceHttp2();
+  bool readHttp2Input();
+  void flushHttp2Output();
+  bool dispatchHttp2Request();
+  void buildHttp2Request(
+      const http2::adapters::Http2Session::Request& request);
+  void submitHttp2Response();
+  bool pumpHttp2Stream();
+  void abortHttp2Stream();
 
   bool parseRequest();
 
   void processRequest();
 
-  const domain::configuration::entities::ServerConfig* resolveVirtualHost();
-
-  const domain::configuration::entities::LocationConfig* findMatchingLocation(
-      const domain::configuration::entities::ServerConfig* serverConfig,
-      const std::string& requestPath) const;
+  const domain::configuration::entities::ServerConfig* resolveVirtualHost(
+      const std::string& hostHeader) const;
+  void routeRequest(const std::string& hostHeader);
+  static std::string stripHostPort(const std::string& host);
 
   void handleGetRequest(
-      const domain::configuration::value_objects::Route& route,
+      const domain::configuration::entities::RequestPlan& plan,
       const domain::configuration::entities::LocationConfig& location,
       const domain::filesystem::value_objects::Path& requestPath);
 
   void handlePostRequest(
-      const domain::configuration::value_objects::Route& route,
+      const domain::configuration::entities::RequestPlan& plan,
       const domain::configuration::entities::LocationConfig& location,
       const domain::filesystem::value_objects::Path& requestPath);
 
   void handleDeleteRequest(
-      const domain::configuration::value_objects::Route& route,
+      const domain::configuration::entities::RequestPlan& plan,
       const domain::configuration::entities::LocationConfig& location,
       const domain::filesystem::value_objects::Path& requestPath);
 
@@ -118,6 +203,26 @@ class ConnectionHandler {
       const domain::configuration::entities::LocationConfig& location,
       const domain::filesystem::value_objects::Path& scriptPath);
 
+  void handleProxyRequest(
+      const domain::configuration::entities::RequestPlan& plan,
+      const domain::configuration::entities::LocationConfig& location);
+
+  void startProxyResponse();
+  void failProxy(const proxy::exceptions::ProxyException& error);
+
+  bool lookupCache(
+      const domain::configuration::entities::LocationConfig& location);
+  void serveCachedResponse(const cache::adapters::ResponseCache::Response&
+                               cached);
+  void beginCacheFill();
+  void finishCacheFill(bool commit);
+
+  bool applyRequestLimits(
+      const domain::configuration::entities::LocationConfig& location);
+  void rejectLimitedRequest(
+      const domain::configuration::entities::LocationConfig& location,
+      unsigned int status);
+
   void handleFileUpload(
       const domain::configuration::entities::LocationConfig& location,
       const domain::filesystem::value_objects::Path& requestPath);
@@ -128,6 +233,9 @@ class ConnectionHandler {
   void handleReturnContent(
       const domain::configuration::entities::LocationConfig& location);
 
+  void handleStatusRequest(
+      const domain::configuration::entities::LocationConfig& location);
+
   void generateErrorResponse(
       const domain::shared::value_objects::ErrorCode& statusCode,
       const std::string& message);
@@ -151,9 +259,12 @@ class ConnectionHandler {
       const domain::configuration::entities::LocationConfig& location,
       const std::string& errorPagePath) const;
 
-  bool validateRequestBodySize(
+  const domain::configuration::entities::RequestPlan& planFor(
       const domain::configuration::entities::LocationConfig& location) const;
 
+  bool validateRequestBodySize(
+      const domain::configuration::entities::RequestPlan& plan) const;
+
   domain::filesystem::value_objects::Path tryFindFile(
       const domain::configuration::entities::LocationConfig& location,
       const domain::filesystem::value_objects::Path& requestPath) const;
@@ -166,17 +277,31 @@ class ConnectionHandler {
   void buildHttpResponseFromCgi(
       const infrastructure::cgi::primitives::CgiResponse& cgiResponse);
 
+  void startCgiStream(cgi::adapters::CgiStream* stream);
+  void startCgiResponse();
+  void startFastCgi(const std::string& address,
+                    const cgi::primitives::CgiRequest& request);
+  void startCgiWorker(
+      const domain::configuration::value_objects::CgiConfig& config,
+      const cgi::primitives::CgiRequest& request);
+  void failCgi(const cgi::exceptions::CgiExecutionException& error);
+
   void applyCustomHeaders(
-      const domain::configuration::entities::LocationConfig& location);
+      const domain::configuration::entities::RequestPlan& plan);
 
   bool shouldKeepAlive() const;
+  void applyConnectionHeader();
 
   void resetForNextRequest();
 
   std::string formatState() const;
+  const char* getScheme() const;
 
   void logRequest(const domain::http::entities::HttpRequest& request,
                   const domain::http::entities::HttpResponse& response);
+  std::string getClientAddress() const;
+  void writeAccessLog();
+  void reportSlowRequest(long totalMicros);
 
   std::string extractBoundary(const std::string& contentType) const;
 
@@ -197,19 +322,68 @@ class ConnectionHandler {
       const std::vector<char>& content) const;
 
   application::ports::ILogger& m_logger;
-  application::ports::IConfigProvider& m_configProvider;
+  domain::configuration::entities::ConfigSnapshot& m_configSnapshot;
+  cgi::adapters::FastCgiClient& m_fastCgiClient;
+  cgi::adapters::CgiWorkerPool& m_cgiWorkerPool;
+  cgi::adapters::CgiExecutor& m_cgiExecutor;
+  proxy::adapters::UpstreamPool& m_upstreamPool;
+  cache::adapters::ResponseCache& m_responseCache;
+  limits::adapters::RequestLimiter& m_requestLimiter;
+  primitives::ServerMetrics& m_metrics;
+  logging::AccessLog& m_accessLog;
 
   TcpSocket* m_socket;
   const domain::configuration::entities::ServerConfig* m_serverConfig;
+  std::string m_listenAddress;
+  unsigned int m_listenPort;
+  const domain::configuration::entities::ServerConfig* m_requestServer;
+  size_t m_maxRequestSize;
 
   State m_state;
   time_t m_lastActivityTime;
-
-  std::string m_requestBuffer;
+  time_t m_requestStartTime;
+  primitives::RequestTiming m_timing;
+  size_t m_requestLength;
+  size_t m_responseHeaderBytes;
+  size_t m_responseBytesSent;
+  bool m_headersReceived;
+  unsigned int m_requestCount;
+
+  primitives::ReadArena m_readBuffer;
+  http::RequestParser m_parser;
   domain::http::entities::HttpRequest m_request;
   domain::http::entities::HttpResponse m_response;
   std::string m_responseBuffer;
   size_t m_responseOffset;
+
+  http2::adapters::Http2Session* m_http2;
+  unsigned int m_http2Stream;
+  bool m_http2Enabled;
+
+  cgi::adapters::CgiStream* m_cgiStream;
+  std::vector<cgi::adapters::CgiStream*> m_retiredCgiStreams;
+  proxy::adapters::ProxySession* m_proxySession;
+  std::vector<proxy::adapters::ProxySession*> m_retiredProxySessions;
+  cgi::adapters::FastCgiSession* m_fastCgiSession;
+  std::vector<cgi::adapters::FastCgiSession*> m_retiredFastCgiSessions;
+  cgi::adapters::CgiWorkerSession* m_workerSession;
+  std::vector<cgi::adapters::CgiWorkerSession*> m_retiredWorkerSessions;
+  const domain::configuration::entities::RequestPlan* m_upstreamPlan;
+  bool m_streamChunked;
+  bool m_streamHasLength;
+  size_t m_streamRemaining;
+
+  cache::adapters::ResponseCache::Fill* m_cacheFill;
+  const domain::configuration::value_objects::ProxyCacheConfig* m_cacheConfig;
+  std::string m_cacheKey;
+  bool m_cacheLockHeld;
+  bool m_cacheBypass;
+  time_t m_cacheWaitStart;
+  std::string m_cacheStatus;
+
+  limits::adapters::RequestLimiter::Lease m_limitLease;
+  unsigned long m_limitWakeMillis;
+  bool m_limitsPassed;
 };
 
 }  // namespace adapters
@@ -62,10 +62,9 @@ void EventMultiplexer::registerSocket(int fileDescriptor, int eventMask) {
         savedErrno);
   }
 
-  std::ostringstream oss;
-  oss << "Registered fd=" << fileDescriptor << " with events=0x" << std::hex
-      << eventMask;
-  m_logger.debug(oss.str());
+  WEBSERV_LOG_DEBUG(m_logger, "Registered fd=" << fileDescriptor
+                                               << " with events=0x"
+                                               << std::hex << eventMask);
 }
 
 void EventMultiplexer::modifySocket(int fileDescriptor, int eventMask) {
@@ -92,10 +91,9 @@ void EventMultiplexer::modifySocket(int fileDescriptor, int eventMask) {
         errno);
   }
 
-  std::ostringstream oss;
-  oss << "Modified fd=" << fileDescriptor << " to events=0x" << std::hex
-      << eventMask;
-  m_logger.debug(oss.str());
+  WEBSERV_LOG_DEBUG(m_logger, "Modified fd=" << fileDescriptor
+                                             << " to events=0x" << std::hex
+                                             << eventMask);
 }
 
 void EventMultiplexer::deregisterSocket(int fileDescriptor) {
@@ -115,9 +113,7 @@ void EventMultiplexer::deregisterSocket(int fileDescriptor) {
 
   m_registrations.erase(fileDescriptor);
 
-  std::ostringstream oss;
-  oss << "Deregistered fd=" << fileDescriptor;
-  m_logger.debug(oss.str());
+  WEBSERV_LOG_DEBUG(m_logger, "Deregistered fd=" << fileDescriptor);
 }
 
 std::vector<primitives::SocketEvent> EventMultiplexer::wait(int timeoutMs) {
@@ -150,9 +146,8 @@ std::vector<primitives::SocketEvent> EventMultiplexer::wait(int timeoutMs) {
   }
 
   if (!events.empty()) {
-    std::ostringstream oss;
-    oss << "epoll_wait returned " << events.size() << " event(s)";
-    m_logger.debug(oss.str());
+    WEBSERV_LOG_DEBUG(m_logger,
+                      "epoll_wait returned " << events.size() << " event(s)");
   }
 
   return events;
@@ -166,6 +161,12 @@ bool EventMultiplexer::isRegistered(int fileDescriptor) const {
   return m_registrations.find(fileDescriptor) != m_registrations.end();
 }
 
+int EventMultiplexer::getEventMask(int fileDescriptor) const {
+  std::map<int, int>::const_iterator it = m_registrations.find(fileDescriptor);
+  return (it != m_registrations.end()) ? it->second
+                                       : primitives::SocketEvent::EVENT_NONE;
+}
+
 void EventMultiplexer::initializeEpoll() {
   m_epollFd = epoll_create1(0);
   if (m_epollFd == K_INVALID_EPOLL_FD) {
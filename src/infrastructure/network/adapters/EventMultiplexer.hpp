@@ -43,6 +43,7 @@ class EventMultiplexer {
   size_t getRegisteredCount() const;
 
   bool isRegistered(int fileDescriptor) const;
+  int getEventMask(int fileDescriptor) const;
 
  private:
   EventMultiplexer(const EventMultiplexer&);
@@ -15,7 +15,9 @@
 #include "infrastructure/network/adapters/EventMultiplexer.hpp"
 #include "infrastructure/network/adapters/SocketOrchestrator.hpp"
 #include "infrastructure/network/adapters/TcpSocket.hpp"
+#include "infrastructure/network/primitives/RequestTiming.hpp"
 #include "infrastructure/network/primitives/SocketEvent.hpp"
+#include "infrastructure/tls/adapters/TlsChannel.hpp"
 #include "shared/utils/SignalHandler.hpp"
 
 #include <cerrno>
@@ -28,12 +30,17 @@ namespace infrastructure {
 namespace network {
 namespace adapters {
 
-SocketOrchestrator::ListenSocket::ListenSocket() : socket(NULL), bindPort(0) {}
+SocketOrchestrator::ListenSocket::ListenSocket()
+    : socket(NULL), bindPort(0), ssl(false), http2(false) {}
 
 SocketOrchestrator::ListenSocket::ListenSocket(TcpSocket* sock,
                                                const std::string& address,
                                                unsigned int port)
-    : socket(sock), bindAddress(address), bindPort(port) {}
+    : socket(sock),
+      bindAddress(address),
+      bindPort(port),
+      ssl(false),
+      http2(false) {}
 
 SocketOrchestrator::ListenSocket::~ListenSocket() {
   delete socket;
@@ -78,13 +85,22 @@ SocketOrchestrator::SocketOrchestrator(
     : m_logger(logger),
       m_configProvider(configProvider),
       m_multiplexer(NULL),
+      m_fastCgiClient(logger),
+      m_cgiWorkerPool(logger),
+      m_cgiExecutor(logger),
+      m_upstreamPool(logger),
+      m_responseCache(logger),
+      m_requestLimiter(logger),
+      m_configSnapshot(NULL),
       m_isRunning(false),
       m_shutdownRequested(false),
-      m_lastConnectionSweep(0) {
+      m_lastConnectionSweep(0),
+      m_cacheGeneration(0) {
   if (!configProvider.isValid()) {
     throw std::invalid_argument(
         "SocketOrchestrator requires valid ConfigProvider");
   }
+  m_metrics.setSource(this);
 }
 
 SocketOrchestrator::~SocketOrchestrator() {
@@ -105,8 +121,18 @@ void SocketOrchestrator::initialize() {
   try {
     m_logger.info("Initializing SocketOrchestrator");
 
+    m_configSnapshot = &m_configProvider.getSnapshot();
+    m_configSnapshot->acquire();
+    applyLogLevel();
+
+    configureTls(*m_configSnapshot);
     initializeServerSockets();
     registerServerSocketsWithMultiplexer();
+    prespawnCgiWorkers();
+    configureUpstreams();
+    configureResponseCache();
+    configureRequestLimits();
+    openAccessLog();
 
     m_isRunning = true;
     m_shutdownRequested = false;
@@ -133,6 +159,9 @@ void SocketOrchestrator::run() {
   while (m_isRunning && !m_shutdownRequested &&
          !shared::utils::SignalHandler::isShutdownRequested()) {
     try {
+      if (shared::utils::SignalHandler::isReloadRequested()) {
+        reloadConfiguration();
+      }
       processEventLoopIteration();
     } catch (const std::exception& ex) {
       std::ostringstream oss;
@@ -174,8 +203,8 @@ size_t SocketOrchestrator::getServerSocketCount() const {
 }
 
 void SocketOrchestrator::initializeServerSockets() {
-  const std::vector<const domain::configuration::entities::ServerConfig*>&
-      serverConfigs = m_configProvider.getAllServers();
+  const domain::configuration::entities::ConfigSnapshot::Servers&
+      serverConfigs = m_configSnapshot->getServers();
 
   if (serverConfigs.empty()) {
     throw std::runtime_error("No server configurations available");
@@ -183,8 +212,8 @@ void SocketOrchestrator::initializeServerSockets() {
 
   m_logger.info("Creating server sockets from configuration");
 
-  UniqueBindingSet uniqueBindings;
-  collectUniqueBindings(uniqueBindings);
+  UniqueBindingMap uniqueBindings;
+  collectUniqueBindings(serverConfigs, uniqueBindings);
   createListenSocketsFromBindings(uniqueBindings);
   associateServerConfigsWithListenSockets();
 
@@ -205,20 +234,150 @@ void SocketOrchestrator::registerServerSocketsWithMultiplexer() {
     const int fd = it->first;
     m_multiplexer->registerSocket(fd, primitives::SocketEvent::EVENT_READ);
 
-    std::ostringstream oss;
-    oss << "Registered listen socket fd=" << fd << " ("
-        << it->second->bindAddress << ":" << it->second->bindPort << ")";
-    m_logger.debug(oss.str());
+    WEBSERV_LOG_DEBUG(m_logger,
+                      "Registered listen socket fd="
+                          << fd << " (" << it->second->bindAddress << ":"
+                          << it->second->bindPort << ")");
   }
 
   m_logger.info("Server sockets registered with event multiplexer");
 }
 
-void SocketOrchestrator::collectUniqueBindings(
-    UniqueBindingSet& uniqueBindings) const {
-  const std::vector<const domain::configuration::entities::ServerConfig*>&
-      serverConfigs = m_configProvider.getAllServers();
+void SocketOrchestrator::prespawnCgiWorkers() {
+  const domain::configuration::entities::ConfigSnapshot::Servers&
+      serverConfigs = m_configSnapshot->getServers();
+
+  for (size_t i = 0; i < serverConfigs.size(); ++i) {
+    const domain::configuration::entities::ServerConfig::Locations& locations =
+        serverConfigs[i]->getLocations();
+
+    for (size_t j = 0; j < locations.size(); ++j) {
+      if (!locations[j]->hasCgiConfig() ||
+          !locations[j]->getCgiConfig().hasWorkerPool()) {
+        continue;
+      }
+
+      try {
+        m_cgiWorkerPool.prespawn(locations[j]->getCgiConfig());
+      } catch (const std::exception& ex) {
+        m_logger.error(std::string("Failed to start CGI workers: ") +
+                       ex.what());
+      }
+    }
+  }
+}
+
+// Requests still proxying keep the servers they hold; a retry after the swap
+// picks from the new generation's groups. proxy_pass targets that name a host
+// directly get their groups here too, so their addresses are resolved with
+// the configuration rather than by the first request.
+void SocketOrchestrator::configureUpstreams() {
+  m_upstreamPool.configure(m_configSnapshot->getConfiguration().getUpstreams());
+
+  const domain::configuration::entities::ConfigSnapshot::Servers&
+      serverConfigs = m_configSnapshot->getServers();
+  for (size_t i = 0; i < serverConfigs.size(); ++i) {
+    const domain::configuration::entities::ServerConfig::Locations& locations =
+        serverConfigs[i]->getLocations();
+
+    for (size_t j = 0; j < locations.size(); ++j) {
+      if (!locations[j]->hasProxyPass() ||
+          !locations[j]->getProxyPass().isHttp()) {
+        continue;
+      }
+
+      const domain::http::value_objects::Uri& target =
+          locations[j]->getProxyPass();
+      m_upstreamPool.resolve(
+          target.getHost(),
+          target.hasPort() ? target.getPort().getValue() : 0);
+    }
+  }
+}
+
+// Certificates are loaded before a generation goes live, so one that cannot
+// be read fails startup or the reload instead of the first handshake.
+void SocketOrchestrator::configureTls(
+    const domain::configuration::entities::ConfigSnapshot& snapshot) {
+  m_tlsContexts.configure(snapshot.getServers());
+  if (m_tlsContexts.getContextCount() > 0) {
+    std::ostringstream oss;
+    oss << "TLS ready with " << m_tlsContexts.getContextCount()
+        << " certificate context(s)"
+        << (tls::adapters::TlsContext::isKernelTlsAvailable()
+                ? "; kernel TLS requested"
+                : "");
+    m_logger.info(oss.str());
+  }
+}
+
+// Contexts shared with the rejected generation were kept, so only the
+// certificates it dropped are loaded again.
+void SocketOrchestrator::restoreTls() {
+  try {
+    m_tlsContexts.configure(m_configSnapshot->getServers());
+  } catch (const std::exception& ex) {
+    m_logger.error(std::string("Failed to restore TLS contexts: ") +
+                   ex.what());
+  }
+}
+
+// Entries already on disk are indexed when their zone first appears, so a
+// restart keeps what was cached; zones dropped by a reload are forgotten but
+// their files are left in place.
+void SocketOrchestrator::configureResponseCache() {
+  m_responseCache.configure(
+      m_configSnapshot->getConfiguration().getCacheZones(), std::time(NULL));
+}
+
+// Zones keep their table across a reload while type, key and size are
+// unchanged, so clients already being throttled stay throttled.
+void SocketOrchestrator::configureRequestLimits() {
+  m_requestLimiter.configure(
+      m_configSnapshot->getConfiguration().getLimitZones());
+}
 
+// A log that cannot be opened is reported once and left disabled rather
+// than failing startup or a reload.
+void SocketOrchestrator::openAccessLog() {
+  const domain::configuration::entities::HttpConfig& config =
+      m_configSnapshot->getConfiguration();
+
+  if (!config.isAccessLogEnabled()) {
+    m_accessLog.close();
+    return;
+  }
+
+  const std::string path = config.getAccessLogPath().toString();
+  if (!m_accessLog.open(path, config.getAccessLogPattern())) {
+    m_logger.warn("Cannot open access log '" + path + "'; access logging off");
+    return;
+  }
+  if (m_accessLog.getFormat().getUnknownVariableCount() > 0) {
+    m_logger.warn("Access log format '" + config.getAccessLogFormat() +
+                  "' uses unknown variables; they are logged as '-'");
+  }
+}
+
+void SocketOrchestrator::applyLogLevel() {
+  const std::string& level =
+      m_configSnapshot->getConfiguration().getErrorLogLevel();
+
+  if (level == "error") {
+    m_logger.setLevel(ERROR);
+  } else if (level == "warn") {
+    m_logger.setLevel(WARN);
+  } else if (level == "info") {
+    m_logger.setLevel(INFO);
+  } else {
+    m_logger.setLevel(DEBUG);
+  }
+}
+
+void SocketOrchestrator::collectUniqueBindings(
+    const domain::configuration::entities::ConfigSnapshot::Servers&
+        serverConfigs,
+    UniqueBindingMap& uniqueBindings) const {
   for (size_t i = 0; i < serverConfigs.size(); ++i) {
     const domain::configuration::entities::ServerConfig::ListenDirectives&
         listenDirectives = serverConfigs[i]->getListenDirectives();
@@ -238,79 +397,89 @@ void SocketOrchestrator::collectUniqueBindings(
 
       bindKey << ":" << directive.getPort().getValue();
 
-      uniqueBindings.insert(bindKey.str());
+      UniqueBindingMap::iterator existing = uniqueBindings.find(bindKey.str());
+      if (existing == uniqueBindings.end()) {
+        uniqueBindings.insert(std::make_pair(bindKey.str(), directive));
+      } else if (directive.hasSocketOptions()) {
+        if (existing->second.hasSocketOptions()) {
+          std::ostringstream oss;
+          oss << "Duplicate listen options for " << bindKey.str()
+              << "; keeping the first declaration";
+          m_logger.warn(oss.str());
+        } else {
+          existing->second = directive;
+        }
+      }
     }
   }
 }
 
 void SocketOrchestrator::createListenSocketsFromBindings(
-    const UniqueBindingSet& bindings) {
-  for (UniqueBindingSet::const_iterator it = bindings.begin();
+    const UniqueBindingMap& bindings) {
+  for (UniqueBindingMap::const_iterator it = bindings.begin();
        it != bindings.end(); ++it) {
-    const std::string& binding = *it;
-    size_t colonPos;
-    std::string hostStr;
-    std::string portStr;
-
-    if (!binding.empty() && binding[0] == '[') {
-      const size_t closeBracketPos = binding.find(']');
-      if (closeBracketPos == std::string::npos) {
-        std::ostringstream oss;
-        oss << "Invalid IPv6 binding format (missing ']'): " << binding;
-        throw std::runtime_error(oss.str());
-      }
-
-      hostStr = binding.substr(1, closeBracketPos - 1);
-
-      colonPos = binding.find(':', closeBracketPos);
-      if (colonPos == std::string::npos) {
-        std::ostringstream oss;
-        oss << "Invalid binding format (missing port): " << binding;
-        throw std::runtime_error(oss.str());
-      }
-
-      portStr = binding.substr(colonPos + 1);
-    } else {
-      colonPos = binding.find(':');
-      if (colonPos == std::string::npos) {
-        std::ostringstream oss;
-        oss << "Invalid binding format (missing ':'): " << binding;
-        throw std::runtime_error(oss.str());
-      }
+    ListenSocket* listenSocket = openListenSocket(it->first, it->second);
+    m_listenSockets[listenSocket->socket->getFd()] = listenSocket;
+  }
+}
 
-      hostStr = binding.substr(0, colonPos);
-      portStr = binding.substr(colonPos + 1);
-    }
+SocketOrchestrator::ListenSocket* SocketOrchestrator::openListenSocket(
+    const std::string& binding,
+    const domain::configuration::entities::ListenDirective& directive) {
+  const domain::http::value_objects::Host host = directive.getHost();
+  const domain::http::value_objects::Port port = directive.getPort();
 
-    const domain::http::value_objects::Host host(hostStr);
-    const domain::http::value_objects::Port port(portStr);
+  TcpSocket* socket = new TcpSocket(host, port, m_logger);
 
-    TcpSocket* socket = new TcpSocket(host, port, m_logger);
+  try {
+    applyPreBindOptions(*socket, directive);
+    socket->bind();
+    applyPostBindOptions(*socket, directive);
+    socket->listen(directive.getBacklog() > 0 ? directive.getBacklog()
+                                              : K_DEFAULT_LISTEN_BACKLOG);
+    socket->setNonBlocking(true);
+  } catch (const std::exception& ex) {
+    delete socket;
+    throw;
+  }
 
-    try {
-      socket->bind();
-      socket->listen(K_DEFAULT_LISTEN_BACKLOG);
-      socket->setNonBlocking(true);
+  std::ostringstream oss;
+  oss << "Bound listen socket to " << binding << " (fd=" << socket->getFd()
+      << ")";
+  m_logger.info(oss.str());
 
-      ListenSocket* listenSocket =
-          new ListenSocket(socket, hostStr, port.getValue());
-      m_listenSockets[socket->getFd()] = listenSocket;
+  return new ListenSocket(socket, host.getValue(), port.getValue());
+}
 
-      std::ostringstream oss;
-      oss << "Bound listen socket to " << binding << " (fd=" << socket->getFd()
-          << ")";
-      m_logger.info(oss.str());
+void SocketOrchestrator::applyPreBindOptions(
+    TcpSocket& socket,
+    const domain::configuration::entities::ListenDirective& directive) const {
+  if (directive.isReusePort()) {
+    socket.setReusePort();
+  }
+  if (directive.getReceiveBufferSize() > 0) {
+    socket.setReceiveBufferSize(
+        static_cast<int>(directive.getReceiveBufferSize()));
+  }
+  if (directive.getSendBufferSize() > 0) {
+    socket.setSendBufferSize(static_cast<int>(directive.getSendBufferSize()));
+  }
+}
 
-    } catch (const std::exception& ex) {
-      delete socket;
-      throw;
-    }
+void SocketOrchestrator::applyPostBindOptions(
+    TcpSocket& socket,
+    const domain::configuration::entities::ListenDirective& directive) const {
+  if (directive.isDeferred()) {
+    socket.setDeferAccept(K_DEFER_ACCEPT_TIMEOUT);
+  }
+  if (directive.getFastOpenQueueLength() > 0) {
+    socket.setFastOpen(static_cast<int>(directive.getFastOpenQueueLength()));
   }
 }
 
 void SocketOrchestrator::associateServerConfigsWithListenSockets() {
-  const std::vector<const domain::configuration::entities::ServerConfig*>&
-      serverConfigs = m_configProvider.getAllServers();
+  const domain::configuration::entities::ConfigSnapshot::Servers&
+      serverConfigs = m_configSnapshot->getServers();
 
   for (size_t i = 0; i < serverConfigs.size(); ++i) {
     const domain::configuration::entities::ServerConfig* serverConfig =
@@ -329,12 +498,186 @@ void SocketOrchestrator::associateServerConfigsWithListenSockets() {
            lsIt != m_listenSockets.end(); ++lsIt) {
         if (lsIt->second->matchesBinding(hostStr, portVal)) {
           lsIt->second->addServerConfig(serverConfig);
+          lsIt->second->ssl = directive.isSsl();
+          lsIt->second->http2 = lsIt->second->http2 || directive.isHttp2();
         }
       }
     }
   }
 }
 
+// SIGHUP lands here between loop iterations. The new generation goes live only
+// if it parses, validates and every new binding can be opened; connections
+// already accepted keep the generation they started on until they close.
+void SocketOrchestrator::reloadConfiguration() {
+  shared::utils::SignalHandler::resetReloadFlag();
+  m_logger.info("Reload signal received; loading configuration");
+
+  domain::configuration::entities::ConfigSnapshot* snapshot = NULL;
+  try {
+    snapshot = m_configProvider.prepareReload();
+  } catch (const std::exception& ex) {
+    std::ostringstream oss;
+    oss << "Configuration reload failed, still serving generation "
+        << m_configSnapshot->getGeneration() << ": " << ex.what();
+    m_logger.error(oss.str());
+    return;
+  }
+
+  try {
+    configureTls(*snapshot);
+  } catch (const std::exception& ex) {
+    std::ostringstream oss;
+    oss << "TLS setup failed, still serving generation "
+        << m_configSnapshot->getGeneration() << ": " << ex.what();
+    m_logger.error(oss.str());
+    snapshot->release();
+    return;
+  }
+
+  UniqueBindingMap uniqueBindings;
+  collectUniqueBindings(snapshot->getServers(), uniqueBindings);
+  if (!swapListenSockets(uniqueBindings)) {
+    std::ostringstream oss;
+    oss << "Listeners unchanged, still serving generation "
+        << m_configSnapshot->getGeneration();
+    m_logger.error(oss.str());
+    restoreTls();
+    snapshot->release();
+    return;
+  }
+
+  // The provider takes over the reference prepareReload() handed out.
+  m_configProvider.publish(snapshot);
+  snapshot->acquire();
+  retireSnapshot(m_configSnapshot);
+  m_configSnapshot = snapshot;
+  associateServerConfigsWithListenSockets();
+  prespawnCgiWorkers();
+  configureUpstreams();
+  configureResponseCache();
+  configureRequestLimits();
+  openAccessLog();
+  applyLogLevel();
+
+  std::ostringstream oss;
+  oss << "Configuration generation " << snapshot->getGeneration()
+      << " is live on " << m_listenSockets.size() << " listen socket(s); "
+      << m_connectionHandlers.size()
+      << " connection(s) finishing on previous generations";
+  m_logger.info(oss.str());
+}
+
+// Opens every new binding before touching the live set, so a bind failure
+// leaves the current listeners as they were. Bindings present in both
+// generations keep their socket and accept queue.
+bool SocketOrchestrator::swapListenSockets(const UniqueBindingMap& bindings) {
+  std::vector<ListenSocket*> opened;
+
+  try {
+    for (UniqueBindingMap::const_iterator it = bindings.begin();
+         it != bindings.end(); ++it) {
+      if (findBoundListenSocket(it->second) == NULL) {
+        opened.push_back(openListenSocket(it->first, it->second));
+      }
+    }
+  } catch (const std::exception& ex) {
+    m_logger.error(std::string("Failed to open listen socket: ") + ex.what());
+    for (size_t i = 0; i < opened.size(); ++i) {
+      delete opened[i];
+    }
+    return false;
+  }
+
+  std::vector<int> closedFds;
+  for (ListenSocketMap::iterator it = m_listenSockets.begin();
+       it != m_listenSockets.end(); ++it) {
+    it->second->serverConfigs.clear();
+    it->second->ssl = false;
+    it->second->http2 = false;
+
+    bool stillBound = false;
+    for (UniqueBindingMap::const_iterator binding = bindings.begin();
+         binding != bindings.end() && !stillBound; ++binding) {
+      stillBound = it->second->matchesBinding(
+          binding->second.getHost().getValue(),
+          binding->second.getPort().getValue());
+    }
+    if (!stillBound) {
+      closedFds.push_back(it->first);
+    }
+  }
+
+  for (size_t i = 0; i < closedFds.size(); ++i) {
+    ListenSocket* listenSocket = m_listenSockets[closedFds[i]];
+
+    std::ostringstream oss;
+    oss << "Closing listen socket " << listenSocket->bindAddress << ":"
+        << listenSocket->bindPort << " (fd=" << closedFds[i] << ")";
+    m_logger.info(oss.str());
+
+    m_multiplexer->deregisterSocket(closedFds[i]);
+    m_listenSockets.erase(closedFds[i]);
+    delete listenSocket;
+  }
+
+  for (size_t i = 0; i < opened.size(); ++i) {
+    const int fd = opened[i]->socket->getFd();
+    m_listenSockets[fd] = opened[i];
+    m_multiplexer->registerSocket(fd, primitives::SocketEvent::EVENT_READ);
+  }
+
+  return true;
+}
+
+SocketOrchestrator::ListenSocket* SocketOrchestrator::findBoundListenSocket(
+    const domain::configuration::entities::ListenDirective& directive) const {
+  for (ListenSocketMap::const_iterator it = m_listenSockets.begin();
+       it != m_listenSockets.end(); ++it) {
+    if (it->second->matchesBinding(directive.getHost().getValue(),
+                                   directive.getPort().getValue())) {
+      return it->second;
+    }
+  }
+  return NULL;
+}
+
+void SocketOrchestrator::retireSnapshot(
+    domain::configuration::entities::ConfigSnapshot* snapshot) {
+  if (snapshot != NULL) {
+    m_retiredSnapshots.push_back(snapshot);
+  }
+}
+
+// A retired generation is freed once the orchestrator holds the only
+// reference. CGI environments are cached by CgiConfig address, so the cache
+// is dropped with it before a new generation can reuse that memory.
+void SocketOrchestrator::releaseRetiredSnapshots(bool force) {
+  bool released = false;
+
+  SnapshotList::iterator it = m_retiredSnapshots.begin();
+  while (it != m_retiredSnapshots.end()) {
+    if (!force && (*it)->getReferenceCount() > 1) {
+      ++it;
+      continue;
+    }
+
+    std::ostringstream oss;
+    oss << "Configuration generation " << (*it)->getGeneration()
+        << " retired";
+    m_logger.info(oss.str());
+
+    (*it)->release();
+    it = m_retiredSnapshots.erase(it);
+    released = true;
+  }
+
+  if (released) {
+    m_cgiExecutor.clearEnvironmentCache();
+    m_metrics.forgetServers();
+  }
+}
+
 void SocketOrchestrator::processEventLoopIteration() {
   if (shared::utils::SignalHandler::isShutdownRequested()) {
     m_logger.debug("Shutdown requested pre-wait; skipping iteration");
@@ -342,7 +685,7 @@ void SocketOrchestrator::processEventLoopIteration() {
   }
 
   const std::vector<primitives::SocketEvent> readyEvents =
-      m_multiplexer->wait(K_EVENT_LOOP_TIMEOUT_MS);
+      m_multiplexer->wait(computeWaitTimeout());
 
   if (shared::utils::SignalHandler::isShutdownRequested()) {
     m_logger.info("Shutdown signal during wait(); processing final events");
@@ -351,11 +694,19 @@ void SocketOrchestrator::processEventLoopIteration() {
   }
 
   processReadyEvents(readyEvents);
+  wakeCgiRequests();
+  resumeLimitDelays();
+  m_accessLog.flush();
 
   const time_t currentTime = std::time(NULL);
+  if (m_responseCache.getGeneration() != m_cacheGeneration) {
+    m_cacheGeneration = m_responseCache.getGeneration();
+    resumeCacheWaiters(currentTime);
+  }
   if (currentTime - m_lastConnectionSweep >= K_CONNECTION_SWEEP_INTERVAL) {
     performConnectionSweep(currentTime);
     m_lastConnectionSweep = currentTime;
+    wakeCgiRequests();
   }
 }
 
@@ -369,6 +720,18 @@ void SocketOrchestrator::processReadyEvents(
       continue;
     }
 
+    UpstreamOwnerMap::const_iterator upstream = m_upstreamOwners.find(fd);
+    if (upstream != m_upstreamOwners.end()) {
+      const std::vector<int> owners(upstream->second.begin(),
+                                    upstream->second.end());
+      for (size_t j = 0; j < owners.size(); ++j) {
+        if (m_connectionHandlers.count(owners[j]) != 0) {
+          handleClientEvent(owners[j]);
+        }
+      }
+      continue;
+    }
+
     if (event.hasError() || event.hasHangup()) {
       if (isServerSocket(fd)) {
         std::ostringstream oss;
@@ -392,19 +755,29 @@ void SocketOrchestrator::processReadyEvents(
 
 void SocketOrchestrator::performConnectionSweep(time_t currentTime) {
   std::vector<int> timedOutConnections;
+  std::vector<int> upstreamConnections;
   timedOutConnections.reserve(m_connectionHandlers.size() / 10);
 
   for (ConnectionHandlerMap::iterator it = m_connectionHandlers.begin();
        it != m_connectionHandlers.end(); ++it) {
     if (it->second->isTimedOut(currentTime)) {
       timedOutConnections.push_back(it->first);
+    } else if (it->second->isStreamingUpstream()) {
+      upstreamConnections.push_back(it->first);
     }
   }
 
+  for (size_t i = 0; i < upstreamConnections.size(); ++i) {
+    checkUpstreamTimeout(upstreamConnections[i], currentTime);
+  }
+  m_cgiExecutor.reapStreams(currentTime);
+  resumeCacheWaiters(currentTime);
+  m_responseCache.evict(currentTime);
+
   for (size_t i = 0; i < timedOutConnections.size(); ++i) {
-    std::ostringstream oss;
-    oss << "Closing timed-out connection fd=" << timedOutConnections[i];
-    m_logger.debug(oss.str());
+    WEBSERV_LOG_DEBUG(m_logger,
+                      "Closing timed-out connection fd="
+                          << timedOutConnections[i]);
     closeConnection(timedOutConnections[i]);
   }
 
@@ -414,6 +787,99 @@ void SocketOrchestrator::performConnectionSweep(time_t currentTime) {
         << " timed-out connection(s)";
     m_logger.info(oss.str());
   }
+
+  releaseRetiredSnapshots(false);
+}
+
+// Requests parked behind a cache lock are retried whenever a fill finishes
+// or a lock is dropped, and on every sweep for proxy_cache_lock_timeout.
+void SocketOrchestrator::resumeCacheWaiters(time_t currentTime) {
+  std::vector<int> waiting;
+  for (ConnectionHandlerMap::iterator it = m_connectionHandlers.begin();
+       it != m_connectionHandlers.end(); ++it) {
+    if (it->second->isWaitingForCache()) {
+      waiting.push_back(it->first);
+    }
+  }
+
+  for (size_t i = 0; i < waiting.size(); ++i) {
+    resumeCacheWait(waiting[i], currentTime);
+  }
+}
+
+// The wait ends early for the first request due out of its limit_req delay.
+int SocketOrchestrator::computeWaitTimeout() const {
+  if (m_limitDelayedClients.empty()) {
+    return K_EVENT_LOOP_TIMEOUT_MS;
+  }
+  const unsigned long nowMillis = primitives::RequestTiming::nowMillis();
+  unsigned long timeout = K_EVENT_LOOP_TIMEOUT_MS;
+  for (ClientFdSet::const_iterator it = m_limitDelayedClients.begin();
+       it != m_limitDelayedClients.end(); ++it) {
+    ConnectionHandlerMap::const_iterator handler =
+        m_connectionHandlers.find(*it);
+    if (handler == m_connectionHandlers.end()) {
+      continue;
+    }
+    const unsigned long wake = handler->second->getLimitWakeMillis();
+    if (wake <= nowMillis) {
+      return 0;
+    }
+    if (wake - nowMillis < timeout) {
+      timeout = wake - nowMillis;
+    }
+  }
+  return static_cast<int>(timeout);
+}
+
+void SocketOrchestrator::resumeLimitDelays() {
+  if (m_limitDelayedClients.empty()) {
+    return;
+  }
+  const unsigned long nowMillis = primitives::RequestTiming::nowMillis();
+  const std::vector<int> delayed(m_limitDelayedClients.begin(),
+                                 m_limitDelayedClients.end());
+  for (size_t i = 0; i < delayed.size(); ++i) {
+    resumeLimitDelay(delayed[i], nowMillis);
+  }
+}
+
+// Connection states and the CGI and proxy components' own counters are
+// tallied here, per scrape, rather than tracked on every state change.
+void SocketOrchestrator::collect(
+    primitives::ServerMetrics::Sample& sample) const {
+  sample.activeConnections = m_connectionHandlers.size();
+  for (ConnectionHandlerMap::const_iterator it = m_connectionHandlers.begin();
+       it != m_connectionHandlers.end(); ++it) {
+    switch (it->second->getState()) {
+      case ConnectionHandler::STATE_READING_REQUEST:
+        ++sample.readingConnections;
+        break;
+      case ConnectionHandler::STATE_KEEP_ALIVE:
+        ++sample.waitingConnections;
+        break;
+      default:
+        ++sample.writingConnections;
+        break;
+    }
+  }
+
+  sample.cgiProcessSpawns =
+      m_cgiExecutor.getSpawnCount() + m_cgiWorkerPool.getSpawnCount();
+  sample.cgiEnvironmentHits = m_cgiExecutor.getEnvironmentCacheHits();
+  sample.cgiEnvironmentMisses = m_cgiExecutor.getEnvironmentCacheMisses();
+  sample.fastCgiConnectionsReused = m_fastCgiClient.getReuseCount();
+  sample.fastCgiConnectionsOpened = m_fastCgiClient.getConnectCount();
+  sample.upstreamConnectionsReused = m_upstreamPool.getReuseCount();
+  sample.upstreamConnectionsOpened = m_upstreamPool.getConnectCount();
+  sample.responseCacheHits = m_responseCache.getHitCount();
+  sample.responseCacheMisses = m_responseCache.getMissCount();
+  sample.responseCacheEntries = m_responseCache.getEntryCount();
+  sample.responseCacheBytes = m_responseCache.getStoredBytes();
+  sample.limitRequestsDelayed = m_requestLimiter.getDelayedCount();
+  sample.limitRequestsRejected = m_requestLimiter.getRejectedCount();
+  sample.limitConnectionsRejected =
+      m_requestLimiter.getConnectionRejectedCount();
 }
 
 void SocketOrchestrator::handleNewConnection(int serverSocketFd) {
@@ -436,6 +902,7 @@ void SocketOrchestrator::handleNewConnection(int serverSocketFd) {
     if (clientSocket == NULL) {
       return;
     }
+    m_metrics.recordAccepted();
 
     clientSocket->setNonBlocking(true);
     const int clientFd = clientSocket->getFd();
@@ -451,10 +918,37 @@ void SocketOrchestrator::handleNewConnection(int serverSocketFd) {
       return;
     }
 
-    ConnectionHandler* handler = new ConnectionHandler(
-        clientSocket, serverConfig, m_logger, m_configProvider);
+    if (serverConfig->isTcpNoDelay()) {
+      clientSocket->setNoDelay(true);
+    }
+    if (listenSocket->ssl) {
+      try {
+        tls::adapters::TlsChannel* channel =
+            m_tlsContexts.createChannel(clientFd, serverConfig);
+        channel->setHttp2Offered(listenSocket->http2);
+        channel->setListenBinding(listenSocket->bindAddress,
+                                  listenSocket->bindPort);
+        clientSocket->attachTls(channel);
+      } catch (...) {
+        delete clientSocket;
+        throw;
+      }
+    }
+
+    ConnectionHandler* handler =
+        new ConnectionHandler(clientSocket, serverConfig, m_logger,
+                              *m_configSnapshot, m_fastCgiClient,
+                              m_cgiWorkerPool, m_cgiExecutor, m_upstreamPool,
+                              m_responseCache, m_requestLimiter, m_metrics,
+                              m_accessLog);
+    handler->setListenBinding(listenSocket->bindAddress,
+                              listenSocket->bindPort);
+    if (listenSocket->http2) {
+      handler->enableHttp2();
+    }
 
     registerClientSocket(clientFd, handler);
+    m_metrics.recordHandled();
 
     std::ostringstream oss;
     oss << "Accepted connection from " << clientSocket->getRemoteAddress()
@@ -486,6 +980,9 @@ void SocketOrchestrator::handleClientEvent(int clientSocketFd) {
 
     if (handler->shouldClose()) {
       closeConnection(clientSocketFd);
+    } else {
+      updateClientInterest(clientSocketFd, handler);
+      updateUpstreamInterest(clientSocketFd, handler);
     }
 
   } catch (const std::exception& ex) {
@@ -497,6 +994,82 @@ void SocketOrchestrator::handleClientEvent(int clientSocketFd) {
   }
 }
 
+void SocketOrchestrator::checkUpstreamTimeout(int clientSocketFd,
+                                              time_t currentTime) {
+  ConnectionHandlerMap::iterator it = m_connectionHandlers.find(clientSocketFd);
+  if (it == m_connectionHandlers.end()) {
+    return;
+  }
+
+  ConnectionHandler* handler = it->second;
+  try {
+    handler->checkUpstreamTimeout(currentTime);
+    if (handler->shouldClose()) {
+      closeConnection(clientSocketFd);
+    } else {
+      updateClientInterest(clientSocketFd, handler);
+      updateUpstreamInterest(clientSocketFd, handler);
+    }
+  } catch (const std::exception& ex) {
+    std::ostringstream oss;
+    oss << "Upstream timeout handling failed for fd=" << clientSocketFd
+        << ": " << ex.what();
+    m_logger.error(oss.str());
+    closeConnection(clientSocketFd);
+  }
+}
+
+void SocketOrchestrator::resumeCacheWait(int clientSocketFd,
+                                         time_t currentTime) {
+  ConnectionHandlerMap::iterator it = m_connectionHandlers.find(clientSocketFd);
+  if (it == m_connectionHandlers.end()) {
+    return;
+  }
+
+  ConnectionHandler* handler = it->second;
+  try {
+    handler->resumeCacheWait(currentTime);
+    if (handler->shouldClose()) {
+      closeConnection(clientSocketFd);
+    } else {
+      updateClientInterest(clientSocketFd, handler);
+      updateUpstreamInterest(clientSocketFd, handler);
+    }
+  } catch (const std::exception& ex) {
+    std::ostringstream oss;
+    oss << "Cache wait handling failed for fd=" << clientSocketFd << ": "
+        << ex.what();
+    m_logger.error(oss.str());
+    closeConnection(clientSocketFd);
+  }
+}
+
+void SocketOrchestrator::resumeLimitDelay(int clientSocketFd,
+                                          unsigned long nowMillis) {
+  ConnectionHandlerMap::iterator it = m_connectionHandlers.find(clientSocketFd);
+  if (it == m_connectionHandlers.end()) {
+    m_limitDelayedClients.erase(clientSocketFd);
+    return;
+  }
+
+  ConnectionHandler* handler = it->second;
+  try {
+    handler->resumeLimitDelay(nowMillis);
+    if (handler->shouldClose()) {
+      closeConnection(clientSocketFd);
+    } else {
+      updateClientInterest(clientSocketFd, handler);
+      updateUpstreamInterest(clientSocketFd, handler);
+    }
+  } catch (const std::exception& ex) {
+    std::ostringstream oss;
+    oss << "Limit delay handling failed for fd=" << clientSocketFd << ": "
+        << ex.what();
+    m_logger.error(oss.str());
+    closeConnection(clientSocketFd);
+  }
+}
+
 void SocketOrchestrator::closeConnection(int clientSocketFd) {
   ConnectionHandlerMap::iterator it = m_connectionHandlers.find(clientSocketFd);
 
@@ -504,7 +1077,9 @@ void SocketOrchestrator::closeConnection(int clientSocketFd) {
     return;
   }
 
+  deregisterUpstream(clientSocketFd);
   deregisterClientSocket(clientSocketFd);
+  m_limitDelayedClients.erase(clientSocketFd);
 
   ConnectionHandler* handler = it->second;
   m_connectionHandlers.erase(it);
@@ -515,10 +1090,10 @@ void SocketOrchestrator::closeConnection(int clientSocketFd) {
     m_logger.warn("Exception during connection handler destruction");
   }
 
-  std::ostringstream oss;
-  oss << "Closed connection fd=" << clientSocketFd
-      << " (active=" << m_connectionHandlers.size() << ")";
-  m_logger.debug(oss.str());
+  WEBSERV_LOG_DEBUG(m_logger,
+                    "Closed connection fd=" << clientSocketFd << " (active="
+                                            << m_connectionHandlers.size()
+                                            << ")");
 }
 
 bool SocketOrchestrator::canAcceptNewConnection() const {
@@ -531,6 +1106,112 @@ void SocketOrchestrator::registerClientSocket(int clientFd,
   m_multiplexer->registerSocket(clientFd, primitives::SocketEvent::EVENT_READ);
 }
 
+// A request waiting on a cache lock or a limit_req delay reads nothing more
+// until it is resumed.
+void SocketOrchestrator::updateClientInterest(
+    int clientFd, const ConnectionHandler* handler) {
+  if (handler->isDelayedByLimit()) {
+    m_limitDelayedClients.insert(clientFd);
+  } else {
+    m_limitDelayedClients.erase(clientFd);
+  }
+
+  int eventMask = handler->wantsRead() ? primitives::SocketEvent::EVENT_READ
+                                       : primitives::SocketEvent::EVENT_NONE;
+  if (handler->wantsWrite()) {
+    eventMask |= primitives::SocketEvent::EVENT_WRITE;
+  }
+
+  if (m_multiplexer->getEventMask(clientFd) != eventMask) {
+    m_multiplexer->modifySocket(clientFd, eventMask);
+  }
+}
+
+// A CGI pipe or proxied upstream socket is watched only while its handler
+// can make progress on it, and is dropped from the multiplexer before the
+// handler closes it.
+void SocketOrchestrator::updateUpstreamInterest(int clientFd,
+                                                ConnectionHandler* handler) {
+  const int eventMask = handler->getUpstreamEvents();
+  const int upstreamFd = eventMask != primitives::SocketEvent::EVENT_NONE
+                             ? handler->getUpstreamFd()
+                             : -1;
+
+  UpstreamInterestMap::iterator it = m_clientUpstreams.find(clientFd);
+  if (it != m_clientUpstreams.end() && it->second.fd == upstreamFd) {
+    if (it->second.events != eventMask) {
+      it->second.events = eventMask;
+      applyUpstreamInterest(upstreamFd);
+    }
+  } else {
+    deregisterUpstream(clientFd);
+    if (upstreamFd >= 0) {
+      UpstreamInterest interest;
+      interest.fd = upstreamFd;
+      interest.events = eventMask;
+      m_clientUpstreams[clientFd] = interest;
+      m_upstreamOwners[upstreamFd].insert(clientFd);
+      applyUpstreamInterest(upstreamFd);
+    }
+  }
+
+  handler->releaseRetiredUpstreams();
+}
+
+void SocketOrchestrator::deregisterUpstream(int clientFd) {
+  UpstreamInterestMap::iterator it = m_clientUpstreams.find(clientFd);
+  if (it == m_clientUpstreams.end()) {
+    return;
+  }
+
+  const int upstreamFd = it->second.fd;
+  m_clientUpstreams.erase(it);
+
+  UpstreamOwnerMap::iterator owners = m_upstreamOwners.find(upstreamFd);
+  owners->second.erase(clientFd);
+  if (owners->second.empty()) {
+    m_upstreamOwners.erase(owners);
+    m_multiplexer->deregisterSocket(upstreamFd);
+    return;
+  }
+  applyUpstreamInterest(upstreamFd);
+}
+
+void SocketOrchestrator::applyUpstreamInterest(int upstreamFd) {
+  const ClientFdSet& owners = m_upstreamOwners[upstreamFd];
+  int eventMask = primitives::SocketEvent::EVENT_NONE;
+  for (ClientFdSet::const_iterator it = owners.begin(); it != owners.end();
+       ++it) {
+    eventMask |= m_clientUpstreams[*it].events;
+  }
+
+  if (!m_multiplexer->isRegistered(upstreamFd)) {
+    m_multiplexer->registerSocket(upstreamFd, eventMask);
+  } else if (m_multiplexer->getEventMask(upstreamFd) != eventMask) {
+    m_multiplexer->modifySocket(upstreamFd, eventMask);
+  }
+}
+
+// A read on a multiplexed FastCGI connection takes in the records of every
+// request on it, and a CGI worker handed back may unblock requests queued
+// for one; those handlers are run again here, as no descriptor of theirs
+// will report the change.
+void SocketOrchestrator::wakeCgiRequests() {
+  std::vector<int> owners;
+  m_fastCgiClient.collectUpdated(owners);
+  m_cgiWorkerPool.collectReady(owners);
+  while (!owners.empty()) {
+    for (size_t i = 0; i < owners.size(); ++i) {
+      if (m_connectionHandlers.count(owners[i]) != 0) {
+        handleClientEvent(owners[i]);
+      }
+    }
+    owners.clear();
+    m_fastCgiClient.collectUpdated(owners);
+    m_cgiWorkerPool.collectReady(owners);
+  }
+}
+
 void SocketOrchestrator::deregisterClientSocket(int clientFd) {
   m_multiplexer->deregisterSocket(clientFd);
 }
@@ -574,6 +1255,16 @@ void SocketOrchestrator::cleanupResources() {
   cleanupConnectionHandlers();
   cleanupServerSockets();
   cleanupMultiplexer();
+  m_fastCgiClient.closeIdle();
+  m_upstreamPool.closeIdle();
+  m_cgiWorkerPool.shutdown();
+  m_accessLog.close();
+
+  releaseRetiredSnapshots(true);
+  if (m_configSnapshot != NULL) {
+    m_configSnapshot->release();
+    m_configSnapshot = NULL;
+  }
 }
 
 void SocketOrchestrator::cleanupServerSockets() {
@@ -16,8 +16,18 @@
 #include "application/ports/IConfigProvider.hpp"
 #include "application/ports/ILogger.hpp"
 #include "application/ports/ISocketOrchestrator.hpp"
+#include "domain/configuration/entities/ConfigSnapshot.hpp"
 #include "domain/configuration/entities/ServerConfig.hpp"
+#include "infrastructure/cache/adapters/ResponseCache.hpp"
+#include "infrastructure/cgi/adapters/CgiExecutor.hpp"
+#include "infrastructure/cgi/adapters/CgiWorkerPool.hpp"
+#include "infrastructure/cgi/adapters/FastCgiClient.hpp"
+#include "infrastructure/limits/adapters/RequestLimiter.hpp"
+#include "infrastructure/logging/AccessLog.hpp"
+#include "infrastructure/network/primitives/ServerMetrics.hpp"
 #include "infrastructure/network/primitives/SocketEvent.hpp"
+#include "infrastructure/proxy/adapters/UpstreamPool.hpp"
+#include "infrastructure/tls/adapters/TlsContextRegistry.hpp"
 
 #include <ctime>
 #include <map>
@@ -33,11 +43,13 @@ class TcpSocket;
 class EventMultiplexer;
 class ConnectionHandler;
 
-class SocketOrchestrator : public application::ports::ISocketOrchestrator {
+class SocketOrchestrator : public application::ports::ISocketOrchestrator,
+                           private primitives::ServerMetrics::Source {
  public:
   static const int K_EVENT_LOOP_TIMEOUT_MS = 1000;
-  static const time_t K_CONNECTION_SWEEP_INTERVAL = 30;
+  static const time_t K_CONNECTION_SWEEP_INTERVAL = 1;
   static const int K_DEFAULT_LISTEN_BACKLOG = 128;
+  static const int K_DEFER_ACCEPT_TIMEOUT = 60;
   static const size_t K_MAX_CONNECTIONS = 10000;
 
   SocketOrchestrator(application::ports::ILogger& logger,
@@ -57,6 +69,8 @@ class SocketOrchestrator : public application::ports::ISocketOrchestrator {
     TcpSocket* socket;
     std::string bindAddress;
     unsigned int bindPort;
+    bool ssl;
+    bool http2;
     std::vector<const domain::configuration::entities::ServerConfig*>
         serverConfigs;
 
@@ -78,28 +92,85 @@ class SocketOrchestrator : public application::ports::ISocketOrchestrator {
 
   typedef std::map<int, ListenSocket*> ListenSocketMap;
   typedef std::map<int, ConnectionHandler*> ConnectionHandlerMap;
-  typedef std::set<std::string> UniqueBindingSet;
+  typedef std::set<int> ClientFdSet;
+
+  // Upstream descriptor a client's handler waits on and the events it wants.
+  // A multiplexed FastCGI connection is one descriptor shared by several
+  // clients; it is watched for the union of their events.
+  struct UpstreamInterest {
+    int fd;
+    int events;
+  };
+  typedef std::map<int, UpstreamInterest> UpstreamInterestMap;
+  typedef std::map<int, ClientFdSet> UpstreamOwnerMap;
+  typedef std::map<std::string,
+                   domain::configuration::entities::ListenDirective>
+      UniqueBindingMap;
+  typedef std::vector<domain::configuration::entities::ConfigSnapshot*>
+      SnapshotList;
 
   SocketOrchestrator(const SocketOrchestrator&);
   SocketOrchestrator& operator=(const SocketOrchestrator&);
 
   void initializeServerSockets();
   void registerServerSocketsWithMultiplexer();
-  void collectUniqueBindings(UniqueBindingSet& uniqueBindings) const;
-  void createListenSocketsFromBindings(const UniqueBindingSet& bindings);
+  void prespawnCgiWorkers();
+  void configureUpstreams();
+  void configureTls(
+      const domain::configuration::entities::ConfigSnapshot& snapshot);
+  void restoreTls();
+  void configureResponseCache();
+  void configureRequestLimits();
+  void openAccessLog();
+  void applyLogLevel();
+  void collectUniqueBindings(
+      const domain::configuration::entities::ConfigSnapshot::Servers&
+          serverConfigs,
+      UniqueBindingMap& uniqueBindings) const;
+  void createListenSocketsFromBindings(const UniqueBindingMap& bindings);
+  ListenSocket* openListenSocket(
+      const std::string& binding,
+      const domain::configuration::entities::ListenDirective& directive);
+  void applyPreBindOptions(
+      TcpSocket& socket,
+      const domain::configuration::entities::ListenDirective& directive) const;
+  void applyPostBindOptions(
+      TcpSocket& socket,
+      const domain::configuration::entities::ListenDirective& directive) const;
   void associateServerConfigsWithListenSockets();
 
+  void reloadConfiguration();
+  bool swapListenSockets(const UniqueBindingMap& bindings);
+  ListenSocket* findBoundListenSocket(
+      const domain::configuration::entities::ListenDirective& directive) const;
+  void retireSnapshot(
+      domain::configuration::entities::ConfigSnapshot* snapshot);
+  void releaseRetiredSnapshots(bool force);
+
   void processEventLoopIteration();
   void processReadyEvents(
       const std::vector<primitives::SocketEvent>& readyEvents);
   void performConnectionSweep(time_t currentTime);
+  void resumeCacheWaiters(time_t currentTime);
+  int computeWaitTimeout() const;
+  void resumeLimitDelays();
+
+  virtual void collect(primitives::ServerMetrics::Sample& sample) const;
 
   void handleNewConnection(int serverSocketFd);
   void handleClientEvent(int clientSocketFd);
+  void checkUpstreamTimeout(int clientSocketFd, time_t currentTime);
+  void resumeCacheWait(int clientSocketFd, time_t currentTime);
+  void resumeLimitDelay(int clientSocketFd, unsigned long nowMillis);
   void closeConnection(int clientSocketFd);
 
   bool canAcceptNewConnection() const;
   void registerClientSocket(int clientFd, ConnectionHandler* handler);
+  void updateClientInterest(int clientFd, const ConnectionHandler* handler);
+  void updateUpstreamInterest(int clientFd, ConnectionHandler* handler);
+  void deregisterUpstream(int clientFd);
+  void applyUpstreamInterest(int upstreamFd);
+  void wakeCgiRequests();
   void deregisterClientSocket(int clientFd);
 
   const domain::configuration::entities::ServerConfig* resolveServerConfig(
@@ -122,10 +193,25 @@ class SocketOrchestrator : public application::ports::ISocketOrchestrator {
   ListenSocketMap m_listenSockets;
   EventMultiplexer* m_multiplexer;
   ConnectionHandlerMap m_connectionHandlers;
+  UpstreamOwnerMap m_upstreamOwners;
+  UpstreamInterestMap m_clientUpstreams;
+  cgi::adapters::FastCgiClient m_fastCgiClient;
+  cgi::adapters::CgiWorkerPool m_cgiWorkerPool;
+  cgi::adapters::CgiExecutor m_cgiExecutor;
+  proxy::adapters::UpstreamPool m_upstreamPool;
+  tls::adapters::TlsContextRegistry m_tlsContexts;
+  cache::adapters::ResponseCache m_responseCache;
+  limits::adapters::RequestLimiter m_requestLimiter;
+  ClientFdSet m_limitDelayedClients;
+  primitives::ServerMetrics m_metrics;
+  logging::AccessLog m_accessLog;
+  domain::configuration::entities::ConfigSnapshot* m_configSnapshot;
+  SnapshotList m_retiredSnapshots;
 
   volatile bool m_isRunning;
   volatile bool m_shutdownRequested;
   time_t m_lastConnectionSweep;
+  unsigned long m_cacheGeneration;
 };
 
 }  // namespace adapters
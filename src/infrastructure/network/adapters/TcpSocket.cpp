@@ -12,6 +12,8 @@
 
 #include "TcpSocket.hpp"
 #include "infrastructure/network/exceptions/SocketException.hpp"
+#include "infrastructure/tls/adapters/TlsChannel.hpp"
+#include "infrastructure/tls/exceptions/TlsException.hpp"
 
 #include <arpa/inet.h>
 #include <cerrno>
@@ -19,6 +21,7 @@
 #include <fcntl.h>
 #include <netdb.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <sstream>
 #include <sys/socket.h>
 #include <unistd.h>
@@ -35,7 +38,8 @@ TcpSocket::TcpSocket(const domain::http::value_objects::Host& host,
       m_host(host),
       m_port(port),
       m_isServerSocket(true),
-      m_address(NULL) {
+      m_address(NULL),
+      m_tls(NULL) {
   const int addressFamily = m_host.isIpv6() ? AF_INET6 : AF_INET;
 
   m_fd = socket(addressFamily, SOCK_STREAM, 0);
@@ -54,7 +58,8 @@ TcpSocket::TcpSocket(int fileDescriptor, application::ports::ILogger& logger)
     : m_logger(logger),
       m_fd(fileDescriptor),
       m_isServerSocket(false),
-      m_address(NULL) {
+      m_address(NULL),
+      m_tls(NULL) {
   if (fileDescriptor < 0) {
     throw exceptions::SocketException(
         "File descriptor must be non-negative",
@@ -144,9 +149,8 @@ void TcpSocket::bind() {
     throw exceptions::SocketException(oss.str(), errorCode, errno);
   }
 
-  std::ostringstream oss;
-  oss << "Socket bound to " << m_host.getValue() << ":" << m_port.getValue();
-  m_logger.debug(oss.str());
+  WEBSERV_LOG_DEBUG(m_logger, "Socket bound to " << m_host.getValue() << ":"
+                                                 << m_port.getValue());
 }
 
 void TcpSocket::listen(int backlog) {
@@ -163,10 +167,10 @@ void TcpSocket::listen(int backlog) {
         oss.str(), exceptions::SocketException::LISTEN_FAILED, errno);
   }
 
-  std::ostringstream oss;
-  oss << "Socket listening on " << m_host.getValue() << ":" << m_port.getValue()
-      << " (backlog=" << backlog << ")";
-  m_logger.debug(oss.str());
+  WEBSERV_LOG_DEBUG(m_logger,
+                    "Socket listening on " << m_host.getValue() << ":"
+                                           << m_port.getValue()
+                                           << " (backlog=" << backlog << ")");
 }
 
 TcpSocket* TcpSocket::accept() {
@@ -195,10 +199,10 @@ TcpSocket* TcpSocket::accept() {
   try {
     TcpSocket* clientSocket = new TcpSocket(clientFd, m_logger);
 
-    std::ostringstream oss;
-    oss << "Accepted connection from " << clientSocket->getRemoteAddress()
-        << " (FD=" << clientFd << ")";
-    m_logger.debug(oss.str());
+    WEBSERV_LOG_DEBUG(m_logger,
+                      "Accepted connection from "
+                          << clientSocket->getRemoteAddress() << " (FD="
+                          << clientFd << ")");
 
     return clientSocket;
   } catch (const std::exception& ex) {
@@ -234,6 +238,34 @@ void TcpSocket::setNonBlocking(bool nonBlocking) const {
   }
 }
 
+void TcpSocket::setReusePort() const {
+  setTuningOption(SOL_SOCKET, SO_REUSEPORT, 1, "SO_REUSEPORT");
+}
+
+void TcpSocket::setReceiveBufferSize(int bytes) const {
+  setTuningOption(SOL_SOCKET, SO_RCVBUF, bytes, "SO_RCVBUF");
+}
+
+void TcpSocket::setSendBufferSize(int bytes) const {
+  setTuningOption(SOL_SOCKET, SO_SNDBUF, bytes, "SO_SNDBUF");
+}
+
+void TcpSocket::setDeferAccept(int seconds) const {
+  setTuningOption(IPPROTO_TCP, TCP_DEFER_ACCEPT, seconds, "TCP_DEFER_ACCEPT");
+}
+
+void TcpSocket::setFastOpen(int queueLength) const {
+  setTuningOption(IPPROTO_TCP, TCP_FASTOPEN, queueLength, "TCP_FASTOPEN");
+}
+
+void TcpSocket::setNoDelay(bool enabled) const {
+  setTuningOption(IPPROTO_TCP, TCP_NODELAY, enabled ? 1 : 0, "TCP_NODELAY");
+}
+
+void TcpSocket::setCork(bool enabled) const {
+  setTuningOption(IPPROTO_TCP, TCP_CORK, enabled ? 1 : 0, "TCP_CORK");
+}
+
 ssize_t TcpSocket::read(char* buffer, size_t maxBytes) const {
   if (!isValid()) {
     throw exceptions::SocketException(
@@ -253,6 +285,15 @@ ssize_t TcpSocket::read(char* buffer, size_t maxBytes) const {
         exceptions::SocketException::INVALID_SIZE);
   }
 
+  if (m_tls != NULL) {
+    try {
+      return m_tls->read(buffer, maxBytes);
+    } catch (const tls::exceptions::TlsException& ex) {
+      throw exceptions::SocketException(
+          ex.what(), exceptions::SocketException::READ_FAILED);
+    }
+  }
+
   const ssize_t bytesRead = ::recv(m_fd, buffer, maxBytes, 0);
 
   if (bytesRead == K_SOCKET_ERROR) {
@@ -286,6 +327,15 @@ ssize_t TcpSocket::write(const char* data, size_t dataSize) {
         exceptions::SocketException::INVALID_SIZE);
   }
 
+  if (m_tls != NULL) {
+    try {
+      return m_tls->write(data, dataSize);
+    } catch (const tls::exceptions::TlsException& ex) {
+      throw exceptions::SocketException(
+          ex.what(), exceptions::SocketException::WRITE_FAILED);
+    }
+  }
+
   const ssize_t bytesWritten = ::send(m_fd, data, dataSize, MSG_NOSIGNAL);
 
   if (bytesWritten == K_SOCKET_ERROR) {
@@ -293,7 +343,7 @@ ssize_t TcpSocket::write(const char* data, size_t dataSize) {
       return -1;
     }
     if (errno == EPIPE) {
-      m_logger.debug("Socket write encountered broken pipe");
+      WEBSERV_LOG_DEBUG(m_logger, "Socket write encountered broken pipe");
       throw exceptions::SocketException(
           "Broken pipe detected", exceptions::SocketException::BROKEN_PIPE,
           errno);
@@ -306,6 +356,21 @@ ssize_t TcpSocket::write(const char* data, size_t dataSize) {
   return bytesWritten;
 }
 
+// Takes ownership of the channel, which is shut down and freed with the
+// socket.
+void TcpSocket::attachTls(tls::adapters::TlsChannel* channel) {
+  delete m_tls;
+  m_tls = channel;
+}
+
+bool TcpSocket::isTls() const { return m_tls != NULL; }
+
+tls::adapters::TlsChannel* TcpSocket::getTls() const { return m_tls; }
+
+bool TcpSocket::hasPendingInput() const {
+  return m_tls != NULL && m_tls->hasPendingInput();
+}
+
 int TcpSocket::getFd() const { return m_fd; }
 
 std::string TcpSocket::getLocalAddress() const {
@@ -359,6 +424,11 @@ std::string TcpSocket::getRemoteAddress() const {
 bool TcpSocket::isValid() const { return m_fd >= 0; }
 
 void TcpSocket::close() {
+  if (m_tls != NULL) {
+    m_tls->shutdown();
+    delete m_tls;
+    m_tls = NULL;
+  }
   if (isValid()) {
     if (::close(m_fd) == K_SOCKET_ERROR) {
       std::ostringstream oss;
@@ -444,6 +514,23 @@ void TcpSocket::setSocketOption(int level, int optname, const void* optval,
   }
 }
 
+void TcpSocket::setTuningOption(int level, int optname, int value,
+                                const char* optionName) const {
+  if (!isValid()) {
+    throw exceptions::SocketException(
+        "Cannot configure invalid socket",
+        exceptions::SocketException::INVALID_FILE_DESCRIPTOR);
+  }
+
+  if (setsockopt(m_fd, level, optname, &value, sizeof(value)) ==
+      K_SOCKET_ERROR) {
+    std::ostringstream oss;
+    oss << "Warning: Failed to set " << optionName << "=" << value
+        << " on fd=" << m_fd << " (errno=" << errno << ")";
+    m_logger.warn(oss.str());
+  }
+}
+
 std::string TcpSocket::formatAddress(const sockaddr_storage* addr) {
   std::ostringstream oss;
 
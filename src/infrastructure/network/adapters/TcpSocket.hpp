@@ -24,9 +24,17 @@
 #include <unistd.h>
 
 namespace infrastructure {
+namespace tls {
+namespace adapters {
+class TlsChannel;
+}  // namespace adapters
+}  // namespace tls
+
 namespace network {
 namespace adapters {
 
+// A stream socket; once a TLS channel is attached, read() and write() move
+// plaintext through it while the descriptor carries the records.
 class TcpSocket {
  public:
   static const int K_INVALID_FD = -1;
@@ -51,9 +59,22 @@ class TcpSocket {
 
   void setNonBlocking(bool nonBlocking) const;
 
+  void setReusePort() const;
+  void setReceiveBufferSize(int bytes) const;
+  void setSendBufferSize(int bytes) const;
+  void setDeferAccept(int seconds) const;
+  void setFastOpen(int queueLength) const;
+  void setNoDelay(bool enabled) const;
+  void setCork(bool enabled) const;
+
   ssize_t read(char* buffer, size_t maxBytes) const;
   ssize_t write(const char* data, size_t dataSize);
 
+  void attachTls(tls::adapters::TlsChannel* channel);
+  bool isTls() const;
+  tls::adapters::TlsChannel* getTls() const;
+  bool hasPendingInput() const;
+
   int getFd() const;
   std::string getLocalAddress() const;
   std::string getRemoteAddress() const;
@@ -70,6 +91,8 @@ class TcpSocket {
 
   void setSocketOption(int level, int optname, const void* optval,
                        socklen_t optlen) const;
+  void setTuningOption(int level, int optname, int value,
+                       const char* optionName) const;
 
   static std::string formatAddress(const sockaddr_storage* addr);
 
@@ -82,6 +105,7 @@ class TcpSocket {
   domain::http::value_objects::Port m_port;
   bool m_isServerSocket;
   void* m_address;
+  tls::adapters::TlsChannel* m_tls;
 };
 
 }  // namespace adapters
@@ -0,0 +1,94 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ReadArena.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:12:41 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 10:12:41 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/network/primitives/ReadArena.hpp"
+
+#include <cstring>
+
+namespace infrastructure {
+namespace network {
+namespace primitives {
+
+ReadArena::ReadArena(std::size_t initialCapacity)
+    : m_storage(initialCapacity > 0 ? initialCapacity : K_DEFAULT_CAPACITY),
+      m_initialCapacity(m_storage.size()),
+      m_begin(0),
+      m_end(0) {}
+
+ReadArena::~ReadArena() {}
+
+char* ReadArena::writePointer() { return &m_storage[0] + m_end; }
+
+std::size_t ReadArena::writableSize() const { return m_storage.size() - m_end; }
+
+void ReadArena::reserve(std::size_t minWritable) {
+  if (writableSize() >= minWritable) {
+    return;
+  }
+
+  compact();
+
+  if (writableSize() < minWritable) {
+    std::size_t newCapacity = m_storage.size() * 2;
+    if (newCapacity < m_end + minWritable) {
+      newCapacity = m_end + minWritable;
+    }
+    m_storage.resize(newCapacity);
+  }
+}
+
+void ReadArena::commit(std::size_t bytes) {
+  m_end += (bytes > writableSize()) ? writableSize() : bytes;
+}
+
+const char* ReadArena::data() const { return &m_storage[0] + m_begin; }
+
+std::size_t ReadArena::size() const { return m_end - m_begin; }
+
+std::size_t ReadArena::capacity() const { return m_storage.size(); }
+
+bool ReadArena::empty() const { return m_begin == m_end; }
+
+void ReadArena::consume(std::size_t bytes) {
+  if (bytes >= size()) {
+    m_begin = 0;
+    m_end = 0;
+    return;
+  }
+  m_begin += bytes;
+}
+
+void ReadArena::reset() {
+  m_begin = 0;
+  m_end = 0;
+
+  if (m_storage.size() > K_RETAIN_CAPACITY) {
+    std::vector<char>(m_initialCapacity).swap(m_storage);
+  }
+}
+
+void ReadArena::compact() {
+  if (m_begin == 0) {
+    return;
+  }
+
+  const std::size_t pending = size();
+  if (pending > 0) {
+    std::memmove(&m_storage[0], &m_storage[0] + m_begin, pending);
+  }
+  m_begin = 0;
+  m_end = pending;
+}
+
+}  // namespace primitives
+}  // namespace network
+}  // namespace infrastructure
@@ -0,0 +1,60 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ReadArena.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:12:41 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 10:12:41 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef READ_ARENA_HPP
+#define READ_ARENA_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace infrastructure {
+namespace network {
+namespace primitives {
+
+class ReadArena {
+ public:
+  static const std::size_t K_DEFAULT_CAPACITY = 8192;
+  static const std::size_t K_RETAIN_CAPACITY = 65536;
+
+  explicit ReadArena(std::size_t initialCapacity = K_DEFAULT_CAPACITY);
+  ~ReadArena();
+
+  char* writePointer();
+  std::size_t writableSize() const;
+  void reserve(std::size_t minWritable);
+  void commit(std::size_t bytes);
+
+  const char* data() const;
+  std::size_t size() const;
+  std::size_t capacity() const;
+  bool empty() const;
+
+  void consume(std::size_t bytes);
+  void reset();
+
+ private:
+  ReadArena(const ReadArena&);
+  ReadArena& operator=(const ReadArena&);
+
+  void compact();
+
+  std::vector<char> m_storage;
+  std::size_t m_initialCapacity;
+  std::size_t m_begin;
+  std::size_t m_end;
+};
+
+}  // namespace primitives
+}  // namespace network
+}  // namespace infrastructure
+
+#endif  // READ_ARENA_HPP
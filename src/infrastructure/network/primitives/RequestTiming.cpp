@@ -0,0 +1,152 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RequestTiming.cpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 07:20:16 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 07:20:16 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/network/primitives/RequestTiming.hpp"
+
+#include <ctime>
+#include <sstream>
+
+namespace infrastructure {
+namespace network {
+namespace primitives {
+
+namespace {
+
+const unsigned long K_MICROS_PER_SECOND = 1000000ul;
+const unsigned long K_NANOS_PER_MICRO = 1000ul;
+const unsigned long K_MICROS_PER_MILLI = 1000ul;
+const int K_SECONDS_PRECISION = 3;
+
+const char* const K_PHASE_NAMES[RequestTiming::PHASE_COUNT] = {
+    "first_byte", "headers",  "body",        "route",     "upstream_start",
+    "upstream",   "handler",  "first_write", "last_write"};
+
+// Steps reported by formatBreakdown(), each measured from the latest phase
+// before it that was actually reached.
+const RequestTiming::Phase K_BREAKDOWN_STEPS[] = {
+    RequestTiming::PHASE_HEADERS_COMPLETE,
+    RequestTiming::PHASE_BODY_COMPLETE,
+    RequestTiming::PHASE_ROUTE_MATCHED,
+    RequestTiming::PHASE_UPSTREAM_DONE,
+    RequestTiming::PHASE_HANDLER_DONE,
+    RequestTiming::PHASE_FIRST_BYTE_WRITTEN,
+    RequestTiming::PHASE_LAST_BYTE_WRITTEN};
+
+}  // namespace
+
+const long RequestTiming::K_UNSET;
+
+RequestTiming::RequestTiming() : m_present(0) {
+  for (int i = 0; i < PHASE_COUNT; ++i) {
+    m_marks[i] = 0;
+  }
+}
+
+RequestTiming::~RequestTiming() {}
+
+void RequestTiming::mark(Phase phase) {
+  if (!has(phase)) {
+    markAt(phase, nowMicros());
+  }
+}
+
+void RequestTiming::markAt(Phase phase, unsigned long micros) {
+  if (static_cast<unsigned int>(phase) >= PHASE_COUNT) {
+    return;
+  }
+  m_marks[phase] = micros;
+  m_present |= 1u << phase;
+}
+
+bool RequestTiming::has(Phase phase) const {
+  return static_cast<unsigned int>(phase) < PHASE_COUNT &&
+         (m_present & (1u << phase)) != 0;
+}
+
+unsigned long RequestTiming::at(Phase phase) const {
+  return has(phase) ? m_marks[phase] : 0;
+}
+
+long RequestTiming::elapsed(Phase from, Phase to) const {
+  if (!has(from) || !has(to)) {
+    return K_UNSET;
+  }
+  if (m_marks[to] < m_marks[from]) {
+    return 0;
+  }
+  return static_cast<long>(m_marks[to] - m_marks[from]);
+}
+
+long RequestTiming::total() const {
+  return elapsed(PHASE_FIRST_BYTE, PHASE_LAST_BYTE_WRITTEN);
+}
+
+void RequestTiming::reset() { m_present = 0; }
+
+std::string RequestTiming::formatBreakdown() const {
+  std::ostringstream out;
+  Phase previous = PHASE_FIRST_BYTE;
+  const std::size_t stepCount =
+      sizeof(K_BREAKDOWN_STEPS) / sizeof(K_BREAKDOWN_STEPS[0]);
+
+  for (std::size_t i = 0; i < stepCount; ++i) {
+    const Phase step = K_BREAKDOWN_STEPS[i];
+    if (!has(step)) {
+      continue;
+    }
+    const Phase from =
+        (step == PHASE_UPSTREAM_DONE && has(PHASE_UPSTREAM_START))
+            ? PHASE_UPSTREAM_START
+            : previous;
+    if (out.tellp() > 0) {
+      out << " ";
+    }
+    out << phaseName(step) << "=" << formatSeconds(elapsed(from, step));
+    previous = step;
+  }
+  return out.str();
+}
+
+const char* RequestTiming::phaseName(Phase phase) {
+  if (static_cast<unsigned int>(phase) >= PHASE_COUNT) {
+    return "unknown";
+  }
+  return K_PHASE_NAMES[phase];
+}
+
+// Seconds with millisecond resolution, as nginx prints $request_time; "-"
+// for an interval whose phases were not both reached.
+std::string RequestTiming::formatSeconds(long micros) {
+  if (micros < 0) {
+    return "-";
+  }
+  std::ostringstream out;
+  out.setf(std::ios::fixed);
+  out.precision(K_SECONDS_PRECISION);
+  out << static_cast<double>(micros) / static_cast<double>(K_MICROS_PER_SECOND);
+  return out.str();
+}
+
+unsigned long RequestTiming::nowMicros() {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return static_cast<unsigned long>(now.tv_sec) * K_MICROS_PER_SECOND +
+         static_cast<unsigned long>(now.tv_nsec) / K_NANOS_PER_MICRO;
+}
+
+unsigned long RequestTiming::nowMillis() {
+  return nowMicros() / K_MICROS_PER_MILLI;
+}
+
+}  // namespace primitives
+}  // namespace network
+}  // namespace infrastructure
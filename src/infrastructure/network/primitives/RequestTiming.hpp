@@ -0,0 +1,69 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   RequestTiming.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 07:20:16 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 07:20:16 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef REQUEST_TIMING_HPP
+#define REQUEST_TIMING_HPP
+
+#include <string>
+
+namespace infrastructure {
+namespace network {
+namespace primitives {
+
+// Monotonic timestamps, in microseconds, for the phases of one request.
+// The first mark of a phase wins, so a phase reached again (headers parsed
+// on every read, say) keeps the moment it was first reached.
+class RequestTiming {
+ public:
+  enum Phase {
+    PHASE_FIRST_BYTE,
+    PHASE_HEADERS_COMPLETE,
+    PHASE_BODY_COMPLETE,
+    PHASE_ROUTE_MATCHED,
+    PHASE_UPSTREAM_START,
+    PHASE_UPSTREAM_DONE,
+    PHASE_HANDLER_DONE,
+    PHASE_FIRST_BYTE_WRITTEN,
+    PHASE_LAST_BYTE_WRITTEN,
+    PHASE_COUNT
+  };
+
+  static const long K_UNSET = -1;
+
+  RequestTiming();
+  ~RequestTiming();
+
+  void mark(Phase phase);
+  void markAt(Phase phase, unsigned long micros);
+  bool has(Phase phase) const;
+  unsigned long at(Phase phase) const;
+  long elapsed(Phase from, Phase to) const;
+  long total() const;
+  void reset();
+
+  std::string formatBreakdown() const;
+
+  static const char* phaseName(Phase phase);
+  static std::string formatSeconds(long micros);
+  static unsigned long nowMicros();
+  static unsigned long nowMillis();
+
+ private:
+  unsigned long m_marks[PHASE_COUNT];
+  unsigned int m_present;
+};
+
+}  // namespace primitives
+}  // namespace network
+}  // namespace infrastructure
+
+#endif  // REQUEST_TIMING_HPP
@@ -0,0 +1,463 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ServerMetrics.cpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 06:12:38 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 06:12:38 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/network/primitives/ServerMetrics.hpp"
+
+#include <sstream>
+
+namespace infrastructure {
+namespace network {
+namespace primitives {
+
+namespace {
+
+const unsigned long K_MICROS_PER_SECOND = 1000000ul;
+const double K_MICROS_PER_MILLI = 1000.0;
+const char* const K_CGI_BACKEND_NAMES[] = {"spawn", "worker_pool", "fastcgi"};
+
+void writeFamily(std::ostringstream& out, const char* name, const char* help,
+                 const char* type) {
+  out << "# HELP " << name << " " << help << "\n"
+      << "# TYPE " << name << " " << type << "\n";
+}
+
+std::string escapeLabel(const std::string& value) {
+  std::string escaped;
+  escaped.reserve(value.size());
+  for (std::size_t i = 0; i < value.size(); ++i) {
+    if (value[i] == '\\' || value[i] == '"') {
+      escaped += '\\';
+      escaped += value[i];
+    } else if (value[i] == '\n') {
+      escaped += "\\n";
+    } else {
+      escaped += value[i];
+    }
+  }
+  return escaped;
+}
+
+double toSeconds(unsigned long micros) {
+  return static_cast<double>(micros) / static_cast<double>(K_MICROS_PER_SECOND);
+}
+
+double ratio(unsigned long hits, unsigned long misses) {
+  const unsigned long lookups = hits + misses;
+  return lookups == 0 ? 0.0
+                      : static_cast<double>(hits) /
+                            static_cast<double>(lookups);
+}
+
+}  // namespace
+
+const std::size_t ServerMetrics::K_STATUS_CLASSES;
+const std::size_t ServerMetrics::K_DURATION_BOUND_COUNT;
+
+const unsigned long
+    ServerMetrics::K_DURATION_BOUNDS_MICROS[K_DURATION_BOUND_COUNT] = {
+        500ul,    1000ul,    2500ul,    5000ul,    10000ul,
+        25000ul,  50000ul,   100000ul,  250000ul,  500000ul,
+        1000000ul, 2500000ul, 5000000ul, 10000000ul};
+
+ServerMetrics::Sample::Sample()
+    : activeConnections(0),
+      readingConnections(0),
+      writingConnections(0),
+      waitingConnections(0),
+      cgiProcessSpawns(0),
+      cgiEnvironmentHits(0),
+      cgiEnvironmentMisses(0),
+      fastCgiConnectionsReused(0),
+      fastCgiConnectionsOpened(0),
+      upstreamConnectionsReused(0),
+      upstreamConnectionsOpened(0),
+      responseCacheHits(0),
+      responseCacheMisses(0),
+      responseCacheEntries(0),
+      responseCacheBytes(0),
+      limitRequestsDelayed(0),
+      limitRequestsRejected(0),
+      limitConnectionsRejected(0) {}
+
+ServerMetrics::Source::~Source() {}
+
+ServerMetrics::ServerMetrics()
+    : m_source(NULL),
+      m_accepted(0),
+      m_handled(0),
+      m_requests(0),
+      m_bytesIn(0),
+      m_bytesOut(0),
+      m_cgiTimeouts(0),
+      m_tlsHandshakes(0),
+      m_tlsResumed(0),
+      m_tlsFailures(0),
+      m_tlsKernelSend(0),
+      m_http2Connections(0),
+      m_lastServer(NULL),
+      m_lastSlot(0) {
+  for (std::size_t i = 0; i < K_STATUS_CLASSES; ++i) {
+    m_requestsByClass[i] = 0;
+  }
+  for (std::size_t i = 0; i < CGI_BACKEND_COUNT; ++i) {
+    m_cgiRequests[i] = 0;
+  }
+}
+
+ServerMetrics::~ServerMetrics() {}
+
+void ServerMetrics::setSource(const Source* source) { m_source = source; }
+
+void ServerMetrics::recordAccepted() { ++m_accepted; }
+
+void ServerMetrics::recordHandled() { ++m_handled; }
+
+void ServerMetrics::recordBytesIn(std::size_t bytes) { m_bytesIn += bytes; }
+
+void ServerMetrics::recordBytesOut(std::size_t bytes) { m_bytesOut += bytes; }
+
+void ServerMetrics::recordRequest(
+    const domain::configuration::entities::ServerConfig* server,
+    unsigned int statusCode, unsigned long latencyMicros) {
+  ++m_requests;
+  const unsigned int statusClass = statusCode / 100;
+  if (statusClass >= 1 && statusClass <= K_STATUS_CLASSES) {
+    ++m_requestsByClass[statusClass - 1];
+  }
+  if (server != NULL) {
+    m_servers[slotFor(server)].latency.record(latencyMicros);
+  }
+}
+
+void ServerMetrics::recordCgiRequest(CgiBackend backend) {
+  if (backend < CGI_BACKEND_COUNT) {
+    ++m_cgiRequests[backend];
+  }
+}
+
+void ServerMetrics::recordCgiTimeout() { ++m_cgiTimeouts; }
+
+void ServerMetrics::recordTlsHandshake(bool resumed, bool kernelSend) {
+  ++m_tlsHandshakes;
+  if (resumed) {
+    ++m_tlsResumed;
+  }
+  if (kernelSend) {
+    ++m_tlsKernelSend;
+  }
+}
+
+void ServerMetrics::recordTlsHandshakeFailure() { ++m_tlsFailures; }
+
+void ServerMetrics::recordHttp2Connection() { ++m_http2Connections; }
+
+// Series are keyed by label and survive a reload; only the pointer lookup
+// is dropped, since a retired generation's ServerConfig memory can be reused.
+void ServerMetrics::forgetServers() {
+  m_slots.clear();
+  m_lastServer = NULL;
+  m_lastSlot = 0;
+}
+
+unsigned long ServerMetrics::getAccepted() const { return m_accepted; }
+
+unsigned long ServerMetrics::getHandled() const { return m_handled; }
+
+unsigned long ServerMetrics::getRequests() const { return m_requests; }
+
+unsigned long ServerMetrics::getRequestsInClass(unsigned int statusClass) const {
+  if (statusClass < 1 || statusClass > K_STATUS_CLASSES) {
+    return 0;
+  }
+  return m_requestsByClass[statusClass - 1];
+}
+
+unsigned long ServerMetrics::getBytesIn() const { return m_bytesIn; }
+
+unsigned long ServerMetrics::getBytesOut() const { return m_bytesOut; }
+
+unsigned long ServerMetrics::getCgiRequests(CgiBackend backend) const {
+  return backend < CGI_BACKEND_COUNT ? m_cgiRequests[backend] : 0;
+}
+
+unsigned long ServerMetrics::getCgiTimeouts() const { return m_cgiTimeouts; }
+
+unsigned long ServerMetrics::getTlsHandshakes() const {
+  return m_tlsHandshakes;
+}
+
+unsigned long ServerMetrics::getTlsResumed() const { return m_tlsResumed; }
+
+unsigned long ServerMetrics::getTlsFailures() const { return m_tlsFailures; }
+
+unsigned long ServerMetrics::getTlsKernelSend() const {
+  return m_tlsKernelSend;
+}
+
+unsigned long ServerMetrics::getHttp2Connections() const {
+  return m_http2Connections;
+}
+
+std::size_t ServerMetrics::getServerCount() const { return m_servers.size(); }
+
+const domain::shared::utils::LatencyHistogram* ServerMetrics::findLatency(
+    const std::string& label) const {
+  for (std::size_t i = 0; i < m_servers.size(); ++i) {
+    if (m_servers[i].label == label) {
+      return &m_servers[i].latency;
+    }
+  }
+  return NULL;
+}
+
+// nginx's stub_status lines first, so existing scrapers keep working.
+std::string ServerMetrics::renderText() const {
+  const Sample sample = collectSample();
+  std::ostringstream out;
+
+  out << "Active connections: " << sample.activeConnections << " \n"
+      << "server accepts handled requests\n"
+      << " " << m_accepted << " " << m_handled << " " << m_requests << " \n"
+      << "Reading: " << sample.readingConnections
+      << " Writing: " << sample.writingConnections
+      << " Waiting: " << sample.waitingConnections << " \n";
+
+  out << "Requests:";
+  for (std::size_t i = 0; i < K_STATUS_CLASSES; ++i) {
+    out << " " << (i + 1) << "xx " << m_requestsByClass[i];
+  }
+  out << "\n"
+      << "Bytes: in " << m_bytesIn << " out " << m_bytesOut << "\n"
+      << "CGI: spawns " << sample.cgiProcessSpawns << " timeouts "
+      << m_cgiTimeouts << "\n"
+      << "TLS: handshakes " << m_tlsHandshakes << " resumed " << m_tlsResumed
+      << " failed " << m_tlsFailures << " ktls " << m_tlsKernelSend << "\n"
+      << "HTTP/2: connections " << m_http2Connections << "\n";
+
+  out.setf(std::ios::fixed);
+  out.precision(3);
+  for (std::size_t i = 0; i < m_servers.size(); ++i) {
+    const domain::shared::utils::LatencyHistogram& latency =
+        m_servers[i].latency;
+    out << "Server " << m_servers[i].label << ": requests "
+        << latency.getCount() << " p50 "
+        << static_cast<double>(latency.valueAtPercentile(50)) /
+               K_MICROS_PER_MILLI
+        << "ms p99 "
+        << static_cast<double>(latency.valueAtPercentile(99)) /
+               K_MICROS_PER_MILLI
+        << "ms\n";
+  }
+  return out.str();
+}
+
+std::string ServerMetrics::renderPrometheus() const {
+  const Sample sample = collectSample();
+  std::ostringstream out;
+
+  writeFamily(out, "webserv_connections_accepted_total",
+              "Client connections accepted.", "counter");
+  out << "webserv_connections_accepted_total " << m_accepted << "\n";
+  writeFamily(out, "webserv_connections_handled_total",
+              "Accepted connections given a handler.", "counter");
+  out << "webserv_connections_handled_total " << m_handled << "\n";
+  writeFamily(out, "webserv_connections", "Open client connections by state.",
+              "gauge");
+  out << "webserv_connections{state=\"active\"} " << sample.activeConnections
+      << "\n"
+      << "webserv_connections{state=\"reading\"} "
+      << sample.readingConnections << "\n"
+      << "webserv_connections{state=\"writing\"} "
+      << sample.writingConnections << "\n"
+      << "webserv_connections{state=\"waiting\"} "
+      << sample.waitingConnections << "\n";
+
+  writeFamily(out, "webserv_requests_total",
+              "Completed requests by status class.", "counter");
+  for (std::size_t i = 0; i < K_STATUS_CLASSES; ++i) {
+    out << "webserv_requests_total{class=\"" << (i + 1) << "xx\"} "
+        << m_requestsByClass[i] << "\n";
+  }
+
+  writeFamily(out, "webserv_bytes_received_total",
+              "Bytes read from client sockets.", "counter");
+  out << "webserv_bytes_received_total " << m_bytesIn << "\n";
+  writeFamily(out, "webserv_bytes_sent_total",
+              "Bytes written to client sockets.", "counter");
+  out << "webserv_bytes_sent_total " << m_bytesOut << "\n";
+
+  writeFamily(out, "webserv_cgi_requests_total",
+              "CGI requests by backend.", "counter");
+  for (std::size_t i = 0; i < CGI_BACKEND_COUNT; ++i) {
+    out << "webserv_cgi_requests_total{backend=\"" << K_CGI_BACKEND_NAMES[i]
+        << "\"} " << m_cgiRequests[i] << "\n";
+  }
+  writeFamily(out, "webserv_cgi_spawns_total",
+              "CGI processes started, per request or as pool workers.",
+              "counter");
+  out << "webserv_cgi_spawns_total " << sample.cgiProcessSpawns << "\n";
+  writeFamily(out, "webserv_cgi_timeouts_total", "CGI requests that timed out.",
+              "counter");
+  out << "webserv_cgi_timeouts_total " << m_cgiTimeouts << "\n";
+
+  writeFamily(out, "webserv_tls_handshakes_total",
+              "TLS handshakes by result.", "counter");
+  out << "webserv_tls_handshakes_total{result=\"full\"} "
+      << m_tlsHandshakes - m_tlsResumed << "\n"
+      << "webserv_tls_handshakes_total{result=\"resumed\"} " << m_tlsResumed
+      << "\n"
+      << "webserv_tls_handshakes_total{result=\"failed\"} " << m_tlsFailures
+      << "\n";
+  writeFamily(out, "webserv_tls_ktls_connections_total",
+              "TLS connections sending through kernel TLS.", "counter");
+  out << "webserv_tls_ktls_connections_total " << m_tlsKernelSend << "\n";
+  writeFamily(out, "webserv_http2_connections_total",
+              "Connections served over HTTP/2.", "counter");
+  out << "webserv_http2_connections_total " << m_http2Connections << "\n";
+
+  writeFamily(out, "webserv_cache_lookups_total",
+              "Cache lookups by cache and result.", "counter");
+  out << "webserv_cache_lookups_total{cache=\"cgi_environment\",result=\"hit\"} "
+      << sample.cgiEnvironmentHits << "\n"
+      << "webserv_cache_lookups_total{cache=\"cgi_environment\",result=\"miss\"} "
+      << sample.cgiEnvironmentMisses << "\n"
+      << "webserv_cache_lookups_total{cache=\"fastcgi_connection\","
+         "result=\"hit\"} "
+      << sample.fastCgiConnectionsReused << "\n"
+      << "webserv_cache_lookups_total{cache=\"fastcgi_connection\","
+         "result=\"miss\"} "
+      << sample.fastCgiConnectionsOpened << "\n"
+      << "webserv_cache_lookups_total{cache=\"upstream_connection\","
+         "result=\"hit\"} "
+      << sample.upstreamConnectionsReused << "\n"
+      << "webserv_cache_lookups_total{cache=\"upstream_connection\","
+         "result=\"miss\"} "
+      << sample.upstreamConnectionsOpened << "\n"
+      << "webserv_cache_lookups_total{cache=\"response\",result=\"hit\"} "
+      << sample.responseCacheHits << "\n"
+      << "webserv_cache_lookups_total{cache=\"response\",result=\"miss\"} "
+      << sample.responseCacheMisses << "\n";
+  writeFamily(out, "webserv_cache_hit_ratio",
+              "Share of cache lookups that hit.", "gauge");
+  out << "webserv_cache_hit_ratio{cache=\"cgi_environment\"} "
+      << ratio(sample.cgiEnvironmentHits, sample.cgiEnvironmentMisses) << "\n"
+      << "webserv_cache_hit_ratio{cache=\"fastcgi_connection\"} "
+      << ratio(sample.fastCgiConnectionsReused,
+               sample.fastCgiConnectionsOpened)
+      << "\n"
+      << "webserv_cache_hit_ratio{cache=\"upstream_connection\"} "
+      << ratio(sample.upstreamConnectionsReused,
+               sample.upstreamConnectionsOpened)
+      << "\n"
+      << "webserv_cache_hit_ratio{cache=\"response\"} "
+      << ratio(sample.responseCacheHits, sample.responseCacheMisses) << "\n";
+  writeFamily(out, "webserv_response_cache_entries",
+              "Responses held in the proxy_cache zones.", "gauge");
+  out << "webserv_response_cache_entries " << sample.responseCacheEntries
+      << "\n";
+  writeFamily(out, "webserv_response_cache_bytes",
+              "Bytes of response files held in the proxy_cache zones.",
+              "gauge");
+  out << "webserv_response_cache_bytes " << sample.responseCacheBytes << "\n";
+
+  writeFamily(out, "webserv_limited_requests_total",
+              "Requests held back by limit_req or limit_conn.", "counter");
+  out << "webserv_limited_requests_total{limit=\"req\",result=\"delayed\"} "
+      << sample.limitRequestsDelayed << "\n"
+      << "webserv_limited_requests_total{limit=\"req\",result=\"rejected\"} "
+      << sample.limitRequestsRejected << "\n"
+      << "webserv_limited_requests_total{limit=\"conn\","
+         "result=\"rejected\"} "
+      << sample.limitConnectionsRejected << "\n";
+
+  writeFamily(out, "webserv_request_duration_seconds",
+              "Time from the first request byte to the last response byte.",
+              "histogram");
+  for (std::size_t i = 0; i < m_servers.size(); ++i) {
+    const domain::shared::utils::LatencyHistogram& latency =
+        m_servers[i].latency;
+    const std::string server = escapeLabel(m_servers[i].label);
+    for (std::size_t b = 0; b < K_DURATION_BOUND_COUNT; ++b) {
+      out << "webserv_request_duration_seconds_bucket{server=\"" << server
+          << "\",le=\"" << toSeconds(K_DURATION_BOUNDS_MICROS[b]) << "\"} "
+          << latency.countAtOrBelow(K_DURATION_BOUNDS_MICROS[b]) << "\n";
+    }
+    out << "webserv_request_duration_seconds_bucket{server=\"" << server
+        << "\",le=\"+Inf\"} " << latency.getCount() << "\n"
+        << "webserv_request_duration_seconds_sum{server=\"" << server << "\"} "
+        << latency.getMean() * static_cast<double>(latency.getCount()) /
+               static_cast<double>(K_MICROS_PER_SECOND)
+        << "\n"
+        << "webserv_request_duration_seconds_count{server=\"" << server
+        << "\"} " << latency.getCount() << "\n";
+  }
+  return out.str();
+}
+
+// First server_name (or "_") and first listen port, e.g. "example.com:8080".
+std::string ServerMetrics::labelFor(
+    const domain::configuration::entities::ServerConfig& server) {
+  std::ostringstream label;
+  const domain::configuration::entities::ServerConfig::ServerNames& names =
+      server.getServerNames();
+  label << (names.empty() ? std::string("_") : names[0]);
+
+  const domain::configuration::entities::ServerConfig::ListenDirectives&
+      listens = server.getListenDirectives();
+  if (!listens.empty()) {
+    label << ":" << listens[0].getPort().getValue();
+  }
+  return label.str();
+}
+
+std::size_t ServerMetrics::slotFor(
+    const domain::configuration::entities::ServerConfig* server) {
+  if (server == m_lastServer) {
+    return m_lastSlot;
+  }
+
+  SlotMap::const_iterator cached = m_slots.find(server);
+  std::size_t slot = 0;
+  if (cached != m_slots.end()) {
+    slot = cached->second;
+  } else {
+    const std::string label = labelFor(*server);
+    slot = m_servers.size();
+    for (std::size_t i = 0; i < m_servers.size(); ++i) {
+      if (m_servers[i].label == label) {
+        slot = i;
+        break;
+      }
+    }
+    if (slot == m_servers.size()) {
+      m_servers.push_back(ServerSeries());
+      m_servers.back().label = label;
+    }
+    m_slots[server] = slot;
+  }
+
+  m_lastServer = server;
+  m_lastSlot = slot;
+  return slot;
+}
+
+ServerMetrics::Sample ServerMetrics::collectSample() const {
+  Sample sample;
+  if (m_source != NULL) {
+    m_source->collect(sample);
+  }
+  return sample;
+}
+
+}  // namespace primitives
+}  // namespace network
+}  // namespace infrastructure
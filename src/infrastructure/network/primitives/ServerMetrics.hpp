@@ -0,0 +1,158 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ServerMetrics.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 06:12:38 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 06:12:38 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef SERVER_METRICS_HPP
+#define SERVER_METRICS_HPP
+
+#include "domain/configuration/entities/ServerConfig.hpp"
+#include "domain/shared/utils/LatencyHistogram.hpp"
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace infrastructure {
+namespace network {
+namespace primitives {
+
+// Counters for the stub_status endpoint. The event loop is single threaded,
+// so recording is a plain increment; anything another component already
+// counts (connection states, CGI spawns, cache lookups) is pulled from the
+// Source only when a scrape renders the page.
+class ServerMetrics {
+ public:
+  enum CgiBackend {
+    CGI_SPAWN,
+    CGI_WORKER_POOL,
+    CGI_FASTCGI,
+    CGI_BACKEND_COUNT
+  };
+
+  struct Sample {
+    std::size_t activeConnections;
+    std::size_t readingConnections;
+    std::size_t writingConnections;
+    std::size_t waitingConnections;
+    unsigned long cgiProcessSpawns;
+    unsigned long cgiEnvironmentHits;
+    unsigned long cgiEnvironmentMisses;
+    unsigned long fastCgiConnectionsReused;
+    unsigned long fastCgiConnectionsOpened;
+    unsigned long upstreamConnectionsReused;
+    unsigned long upstreamConnectionsOpened;
+    unsigned long responseCacheHits;
+    unsigned long responseCacheMisses;
+    std::size_t responseCacheEntries;
+    std::size_t responseCacheBytes;
+    unsigned long limitRequestsDelayed;
+    unsigned long limitRequestsRejected;
+    unsigned long limitConnectionsRejected;
+
+    Sample();
+  };
+
+  class Source {
+   public:
+    virtual ~Source();
+    virtual void collect(Sample& sample) const = 0;
+  };
+
+  static const std::size_t K_STATUS_CLASSES = 5;
+  static const std::size_t K_DURATION_BOUND_COUNT = 14;
+  static const unsigned long K_DURATION_BOUNDS_MICROS[K_DURATION_BOUND_COUNT];
+
+  ServerMetrics();
+  ~ServerMetrics();
+
+  void setSource(const Source* source);
+
+  void recordAccepted();
+  void recordHandled();
+  void recordBytesIn(std::size_t bytes);
+  void recordBytesOut(std::size_t bytes);
+  void recordRequest(
+      const domain::configuration::entities::ServerConfig* server,
+      unsigned int statusCode, unsigned long latencyMicros);
+  void recordCgiRequest(CgiBackend backend);
+  void recordCgiTimeout();
+  void recordTlsHandshake(bool resumed, bool kernelSend);
+  void recordTlsHandshakeFailure();
+  void recordHttp2Connection();
+  void forgetServers();
+
+  unsigned long getAccepted() const;
+  unsigned long getHandled() const;
+  unsigned long getRequests() const;
+  unsigned long getRequestsInClass(unsigned int statusClass) const;
+  unsigned long getBytesIn() const;
+  unsigned long getBytesOut() const;
+  unsigned long getCgiRequests(CgiBackend backend) const;
+  unsigned long getCgiTimeouts() const;
+  unsigned long getTlsHandshakes() const;
+  unsigned long getTlsResumed() const;
+  unsigned long getTlsFailures() const;
+  unsigned long getTlsKernelSend() const;
+  unsigned long getHttp2Connections() const;
+  std::size_t getServerCount() const;
+  const domain::shared::utils::LatencyHistogram* findLatency(
+      const std::string& label) const;
+
+  std::string renderText() const;
+  std::string renderPrometheus() const;
+
+  static std::string labelFor(
+      const domain::configuration::entities::ServerConfig& server);
+
+ private:
+  struct ServerSeries {
+    std::string label;
+    domain::shared::utils::LatencyHistogram latency;
+  };
+
+  typedef std::map<const domain::configuration::entities::ServerConfig*,
+                   std::size_t>
+      SlotMap;
+
+  ServerMetrics(const ServerMetrics&);
+  ServerMetrics& operator=(const ServerMetrics&);
+
+  std::size_t slotFor(
+      const domain::configuration::entities::ServerConfig* server);
+  Sample collectSample() const;
+
+  const Source* m_source;
+  unsigned long m_accepted;
+  unsigned long m_handled;
+  unsigned long m_requests;
+  unsigned long m_requestsByClass[K_STATUS_CLASSES];
+  unsigned long m_bytesIn;
+  unsigned long m_bytesOut;
+  unsigned long m_cgiRequests[CGI_BACKEND_COUNT];
+  unsigned long m_cgiTimeouts;
+  unsigned long m_tlsHandshakes;
+  unsigned long m_tlsResumed;
+  unsigned long m_tlsFailures;
+  unsigned long m_tlsKernelSend;
+  unsigned long m_http2Connections;
+
+  std::vector<ServerSeries> m_servers;
+  SlotMap m_slots;
+  const domain::configuration::entities::ServerConfig* m_lastServer;
+  std::size_t m_lastSlot;
+};
+
+}  // namespace primitives
+}  // namespace network
+}  // namespace infrastructure
+
+#endif  // SERVER_METRICS_HPP
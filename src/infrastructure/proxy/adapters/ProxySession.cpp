@@ -0,0 +1,361 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ProxySession.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 10:15:48 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 10:15:48 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/proxy/adapters/ProxySession.hpp"
+#include "infrastructure/proxy/exceptions/ProxyException.hpp"
+
+#include <cstring>
+#include <sstream>
+
+namespace infrastructure {
+namespace proxy {
+namespace adapters {
+
+const ssize_t ProxySession::K_WOULD_BLOCK;
+const std::size_t ProxySession::K_READ_CHUNK_SIZE;
+
+ProxySession::ProxySession(application::ports::ILogger& logger,
+                           UpstreamPool& pool, const std::string& groupKey,
+                           const std::string& requestHead,
+                           const std::vector<char>& body,
+                           const std::string& hashValue)
+    : m_logger(logger),
+      m_pool(pool),
+      m_groupKey(groupKey),
+      m_outgoing(requestHead),
+      m_hashValue(hashValue),
+      m_connectTimeout(0),
+      m_readTimeout(0),
+      m_headRequest(false),
+      m_state(STATE_IDLE),
+      m_peer(NULL),
+      m_connection(NULL),
+      m_reused(false),
+      m_staleRetried(false),
+      m_sent(0),
+      m_received(0),
+      m_waitingSince(0),
+      m_pendingOffset(0) {
+  if (!body.empty()) {
+    m_outgoing.append(&body[0], body.size());
+  }
+}
+
+ProxySession::~ProxySession() { finish(); }
+
+void ProxySession::setHeadRequest(bool headRequest) {
+  m_headRequest = headRequest;
+}
+
+// Zero disables the corresponding timeout.
+void ProxySession::setTimeouts(unsigned int connectSeconds,
+                               unsigned int readSeconds) {
+  m_connectTimeout = connectSeconds;
+  m_readTimeout = readSeconds;
+}
+
+void ProxySession::start() { connectNext(); }
+
+// True once the response head is available; false while waiting on the
+// upstream socket.
+bool ProxySession::advance() {
+  for (;;) {
+    try {
+      return step();
+    } catch (const exceptions::ProxyException& ex) {
+      if (!canRetry()) {
+        if (m_peer != NULL && !m_reused && m_state != STATE_READING_BODY) {
+          m_pool.reportFailure(*m_peer, std::time(NULL));
+        }
+        throw;
+      }
+      retry(ex.what(), std::time(NULL));
+    }
+  }
+}
+
+ssize_t ProxySession::read(char* buffer, std::size_t size) {
+  if (m_state != STATE_READING_BODY) {
+    return 0;
+  }
+
+  std::size_t copied = takePending(buffer, size);
+  if (copied > 0) {
+    return static_cast<ssize_t>(copied);
+  }
+
+  char chunk[K_READ_CHUNK_SIZE];
+  while (!m_parser.isComplete()) {
+    const ssize_t received = m_connection->receive(chunk, sizeof(chunk));
+    if (received == UpstreamConnection::K_WOULD_BLOCK) {
+      startWaiting();
+      return K_WOULD_BLOCK;
+    }
+    m_waitingSince = 0;
+    if (received == 0) {
+      m_parser.finishOnClose();
+      break;
+    }
+    m_received += static_cast<std::size_t>(received);
+    m_parser.feed(chunk, static_cast<std::size_t>(received), m_pending);
+    copied = takePending(buffer, size);
+    if (copied > 0) {
+      return static_cast<ssize_t>(copied);
+    }
+  }
+  return 0;
+}
+
+// A connect that outlives proxy_connect_timeout moves on to the next server;
+// a silent upstream past proxy_read_timeout ends the request.
+void ProxySession::checkTimeout(std::time_t now) {
+  if (m_waitingSince == 0 || m_state == STATE_IDLE || m_state == STATE_DONE) {
+    return;
+  }
+
+  const unsigned int limit =
+      m_state == STATE_CONNECTING ? m_connectTimeout : m_readTimeout;
+  if (limit == 0 || now - m_waitingSince < static_cast<std::time_t>(limit)) {
+    return;
+  }
+
+  std::ostringstream oss;
+  oss << "upstream " << m_peerAddress << " timed out after " << limit << "s "
+      << (m_state == STATE_CONNECTING ? "connecting" : "waiting for data");
+  if (m_state != STATE_READING_BODY) {
+    m_pool.reportFailure(*m_peer, now);
+  }
+
+  if (m_state == STATE_CONNECTING) {
+    m_logger.warn(oss.str());
+    dropConnection();
+    try {
+      connectNext();
+      return;
+    } catch (const exceptions::ProxyException&) {
+    }
+  }
+  throw exceptions::ProxyException(oss.str(),
+                                   exceptions::ProxyException::TIMEOUT);
+}
+
+// The connection returns to the pool only after a complete response on a
+// keep-alive exchange; anything else is closed.
+void ProxySession::finish() {
+  if (m_connection != NULL) {
+    const bool reusable = m_state == STATE_READING_BODY &&
+                          m_parser.isComplete() && m_parser.isKeepAlive() &&
+                          m_pendingOffset >= m_pending.size();
+    m_pool.release(*m_peer, m_connection, reusable);
+    m_connection = NULL;
+    m_peer = NULL;
+  }
+  m_state = STATE_DONE;
+  releaseDiscarded();
+}
+
+// Connections given up on mid-request stay open until the caller has taken
+// their descriptors off its event loop, so a new connection never reuses
+// a descriptor number the loop still watches.
+void ProxySession::releaseDiscarded() {
+  for (std::size_t i = 0; i < m_discarded.size(); ++i) {
+    delete m_discarded[i];
+  }
+  m_discarded.clear();
+}
+
+int ProxySession::getFd() const {
+  return m_connection != NULL ? m_connection->getFd() : -1;
+}
+
+bool ProxySession::wantsWrite() const {
+  return m_state == STATE_CONNECTING || m_state == STATE_SENDING;
+}
+
+bool ProxySession::hasHeaders() const { return m_parser.hasHeaders(); }
+
+bool ProxySession::isFinished() const { return m_state == STATE_DONE; }
+
+bool ProxySession::isReused() const { return m_reused; }
+
+std::size_t ProxySession::getAttempts() const { return m_tried.size(); }
+
+const std::string& ProxySession::getPeerAddress() const {
+  return m_peerAddress;
+}
+
+const primitives::UpstreamResponseParser& ProxySession::getResponse() const {
+  return m_parser;
+}
+
+void ProxySession::connectNext() {
+  const std::time_t now = std::time(NULL);
+  for (;;) {
+    const UpstreamPool::Group* group = m_pool.findGroup(m_groupKey);
+    UpstreamPool::Peer* peer =
+        group != NULL ? m_pool.select(*group, m_hashValue, m_tried, now)
+                      : NULL;
+    if (peer == NULL) {
+      throw exceptions::ProxyException(
+          "no live upstreams for " + m_groupKey,
+          exceptions::ProxyException::NO_LIVE_UPSTREAM);
+    }
+    m_tried.push_back(peer);
+
+    bool reused = false;
+    UpstreamConnection* connection = NULL;
+    try {
+      connection = m_pool.acquire(*peer, reused);
+    } catch (const exceptions::ProxyException& ex) {
+      m_logger.warn(std::string("Upstream ") + ex.what());
+      m_pool.reportFailure(*peer, now);
+      continue;
+    }
+
+    m_peer = peer;
+    m_peerAddress = peer->address;
+    m_connection = connection;
+    m_reused = reused;
+    m_sent = 0;
+    m_received = 0;
+    m_parser.reset();
+    m_parser.setHeadRequest(m_headRequest);
+    m_pending.clear();
+    m_pendingOffset = 0;
+    m_state = connection->isConnecting() ? STATE_CONNECTING : STATE_SENDING;
+    m_waitingSince = now;
+    return;
+  }
+}
+
+bool ProxySession::step() {
+  if (m_state == STATE_CONNECTING) {
+    if (!m_connection->finishConnect()) {
+      return false;
+    }
+    m_state = STATE_SENDING;
+    m_waitingSince = std::time(NULL);
+  }
+  if (m_state == STATE_SENDING && !sendRequest()) {
+    return false;
+  }
+  if (m_state == STATE_READING_HEADERS) {
+    return readHeaders();
+  }
+  return m_state == STATE_READING_BODY;
+}
+
+bool ProxySession::sendRequest() {
+  while (m_sent < m_outgoing.size()) {
+    const ssize_t written = m_connection->send(m_outgoing.data() + m_sent,
+                                               m_outgoing.size() - m_sent);
+    if (written == UpstreamConnection::K_WOULD_BLOCK) {
+      startWaiting();
+      return false;
+    }
+    m_sent += static_cast<std::size_t>(written);
+    m_waitingSince = 0;
+  }
+
+  m_connection->markRequest();
+  m_state = STATE_READING_HEADERS;
+  m_waitingSince = std::time(NULL);
+  return true;
+}
+
+bool ProxySession::readHeaders() {
+  char chunk[K_READ_CHUNK_SIZE];
+  for (;;) {
+    const ssize_t received = m_connection->receive(chunk, sizeof(chunk));
+    if (received == UpstreamConnection::K_WOULD_BLOCK) {
+      startWaiting();
+      return false;
+    }
+    if (received == 0) {
+      throw exceptions::ProxyException(
+          "upstream " + m_peerAddress + " closed before a response",
+          exceptions::ProxyException::UPSTREAM_CLOSED);
+    }
+
+    m_received += static_cast<std::size_t>(received);
+    m_waitingSince = 0;
+    m_parser.feed(chunk, static_cast<std::size_t>(received), m_pending);
+    if (m_parser.hasHeaders()) {
+      m_state = STATE_READING_BODY;
+      m_pool.reportSuccess(*m_peer);
+      return true;
+    }
+  }
+}
+
+// Nothing of the response may have arrived: a partial response cannot be
+// replayed. A request whose send failed is safe to repeat elsewhere, and so
+// is one lost on a keep-alive connection the upstream had just closed.
+bool ProxySession::canRetry() const {
+  if (m_peer == NULL || m_received > 0) {
+    return false;
+  }
+  if (m_state == STATE_CONNECTING || m_state == STATE_SENDING) {
+    return true;
+  }
+  return m_state == STATE_READING_HEADERS && m_reused && !m_staleRetried;
+}
+
+void ProxySession::retry(const std::string& reason, std::time_t now) {
+  if (m_reused && !m_staleRetried) {
+    m_staleRetried = true;
+    m_tried.pop_back();
+    WEBSERV_LOG_DEBUG(m_logger, "Stale keep-alive connection to "
+                                    << m_peerAddress << " (" << reason
+                                    << "), retrying on a new one");
+  } else {
+    m_pool.reportFailure(*m_peer, now);
+    m_logger.warn("Upstream " + reason + ", trying next server");
+  }
+  dropConnection();
+  connectNext();
+}
+
+void ProxySession::dropConnection() {
+  if (m_connection == NULL) {
+    return;
+  }
+  m_discarded.push_back(m_connection);
+  m_pool.release(*m_peer, NULL, false);
+  m_connection = NULL;
+  m_peer = NULL;
+}
+
+std::size_t ProxySession::takePending(char* buffer, std::size_t size) {
+  const std::size_t available = m_pending.size() - m_pendingOffset;
+  if (available == 0) {
+    return 0;
+  }
+  const std::size_t count = available < size ? available : size;
+  std::memcpy(buffer, m_pending.data() + m_pendingOffset, count);
+  m_pendingOffset += count;
+  if (m_pendingOffset == m_pending.size()) {
+    m_pending.clear();
+    m_pendingOffset = 0;
+  }
+  return count;
+}
+
+void ProxySession::startWaiting() {
+  if (m_waitingSince == 0) {
+    m_waitingSince = std::time(NULL);
+  }
+}
+
+}  // namespace adapters
+}  // namespace proxy
+}  // namespace infrastructure
@@ -0,0 +1,116 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ProxySession.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 10:15:48 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 10:15:48 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef PROXY_SESSION_HPP
+#define PROXY_SESSION_HPP
+
+#include "application/ports/ILogger.hpp"
+#include "infrastructure/proxy/adapters/UpstreamConnection.hpp"
+#include "infrastructure/proxy/adapters/UpstreamPool.hpp"
+#include "infrastructure/proxy/primitives/UpstreamResponseParser.hpp"
+
+#include <cstddef>
+#include <ctime>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+namespace infrastructure {
+namespace proxy {
+namespace adapters {
+
+// One request relayed to an upstream group. Every step is non-blocking and
+// driven from the caller's event loop: advance() connects, sends and reads
+// the response head; read() then hands out the decoded body piece by piece.
+// A connect or send failure moves on to the next server of the group; a
+// reused keep-alive connection that turns out stale is replaced once.
+class ProxySession {
+ public:
+  static const ssize_t K_WOULD_BLOCK = -1;
+  static const std::size_t K_READ_CHUNK_SIZE = 16384;
+
+  ProxySession(application::ports::ILogger& logger, UpstreamPool& pool,
+               const std::string& groupKey, const std::string& requestHead,
+               const std::vector<char>& body, const std::string& hashValue);
+  ~ProxySession();
+
+  void setHeadRequest(bool headRequest);
+  void setTimeouts(unsigned int connectSeconds, unsigned int readSeconds);
+
+  void start();
+  bool advance();
+  ssize_t read(char* buffer, std::size_t size);
+  void checkTimeout(std::time_t now);
+  void finish();
+  void releaseDiscarded();
+
+  int getFd() const;
+  bool wantsWrite() const;
+  bool hasHeaders() const;
+  bool isFinished() const;
+  bool isReused() const;
+  std::size_t getAttempts() const;
+  const std::string& getPeerAddress() const;
+  const primitives::UpstreamResponseParser& getResponse() const;
+
+ private:
+  enum State {
+    STATE_IDLE,
+    STATE_CONNECTING,
+    STATE_SENDING,
+    STATE_READING_HEADERS,
+    STATE_READING_BODY,
+    STATE_DONE
+  };
+
+  ProxySession(const ProxySession&);
+  ProxySession& operator=(const ProxySession&);
+
+  application::ports::ILogger& m_logger;
+  UpstreamPool& m_pool;
+  std::string m_groupKey;
+  std::string m_outgoing;
+  std::string m_hashValue;
+  unsigned int m_connectTimeout;
+  unsigned int m_readTimeout;
+  bool m_headRequest;
+  State m_state;
+  UpstreamPool::PeerList m_tried;
+  UpstreamPool::Peer* m_peer;
+  UpstreamConnection* m_connection;
+  std::vector<UpstreamConnection*> m_discarded;
+  bool m_reused;
+  bool m_staleRetried;
+  std::size_t m_sent;
+  std::size_t m_received;
+  std::time_t m_waitingSince;
+  std::string m_peerAddress;
+  primitives::UpstreamResponseParser m_parser;
+  std::string m_pending;
+  std::size_t m_pendingOffset;
+
+  void connectNext();
+  bool step();
+  bool sendRequest();
+  bool readHeaders();
+  bool canRetry() const;
+  void retry(const std::string& reason, std::time_t now);
+  void dropConnection();
+  std::size_t takePending(char* buffer, std::size_t size);
+  void startWaiting();
+};
+
+}  // namespace adapters
+}  // namespace proxy
+}  // namespace infrastructure
+
+#endif  // PROXY_SESSION_HPP
@@ -0,0 +1,174 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   UpstreamConnection.cpp                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 09:34:02 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 09:34:02 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/proxy/adapters/UpstreamConnection.hpp"
+#include "infrastructure/proxy/exceptions/ProxyException.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace infrastructure {
+namespace proxy {
+namespace adapters {
+
+const ssize_t UpstreamConnection::K_WOULD_BLOCK;
+
+UpstreamConnection::UpstreamConnection(const std::string& address,
+                                       const struct sockaddr* endpoint,
+                                       socklen_t length)
+    : m_address(address), m_fd(-1), m_connecting(false), m_requestCount(0) {
+  open(endpoint, length);
+}
+
+UpstreamConnection::~UpstreamConnection() { close(); }
+
+const std::string& UpstreamConnection::getAddress() const { return m_address; }
+
+int UpstreamConnection::getFd() const { return m_fd; }
+
+bool UpstreamConnection::isConnecting() const { return m_connecting; }
+
+std::size_t UpstreamConnection::getRequestCount() const {
+  return m_requestCount;
+}
+
+// False while the handshake is still in flight.
+bool UpstreamConnection::finishConnect() {
+  if (!m_connecting) {
+    return true;
+  }
+
+  struct pollfd probe;
+  probe.fd = m_fd;
+  probe.events = POLLOUT;
+  probe.revents = 0;
+  if (::poll(&probe, 1, 0) == 0) {
+    return false;
+  }
+
+  int error = 0;
+  socklen_t length = sizeof(error);
+  if (getsockopt(m_fd, SOL_SOCKET, SO_ERROR, &error, &length) != 0) {
+    error = errno;
+  }
+  if (error != 0) {
+    throw exceptions::ProxyException(
+        "connect to " + m_address + " failed: " + getErrorMessage(error),
+        exceptions::ProxyException::CONNECT_FAILED);
+  }
+  m_connecting = false;
+  return true;
+}
+
+ssize_t UpstreamConnection::send(const char* data, std::size_t size) {
+  ssize_t written;
+  do {
+    written = ::send(m_fd, data, size, MSG_NOSIGNAL);
+  } while (written < 0 && errno == EINTR);
+
+  if (written >= 0) {
+    return written;
+  }
+  if (errno == EAGAIN || errno == EWOULDBLOCK) {
+    return K_WOULD_BLOCK;
+  }
+  throw exceptions::ProxyException(
+      "send to " + m_address + " failed: " + getErrorMessage(errno),
+      exceptions::ProxyException::SEND_FAILED);
+}
+
+ssize_t UpstreamConnection::receive(char* buffer, std::size_t size) {
+  ssize_t received;
+  do {
+    received = ::recv(m_fd, buffer, size, 0);
+  } while (received < 0 && errno == EINTR);
+
+  if (received >= 0) {
+    return received;
+  }
+  if (errno == EAGAIN || errno == EWOULDBLOCK) {
+    return K_WOULD_BLOCK;
+  }
+  throw exceptions::ProxyException(
+      "receive from " + m_address + " failed: " + getErrorMessage(errno),
+      exceptions::ProxyException::RECEIVE_FAILED);
+}
+
+// An idle keep-alive connection is readable only if the upstream closed it
+// (or sent something unsolicited); either way it cannot carry a request.
+bool UpstreamConnection::isPeerClosed() const {
+  if (m_fd < 0) {
+    return true;
+  }
+
+  char probe;
+  const ssize_t result = ::recv(m_fd, &probe, 1, MSG_PEEK | MSG_DONTWAIT);
+  if (result >= 0) {
+    return true;
+  }
+  return errno != EAGAIN && errno != EWOULDBLOCK;
+}
+
+void UpstreamConnection::markRequest() { ++m_requestCount; }
+
+void UpstreamConnection::open(const struct sockaddr* endpoint,
+                              socklen_t length) {
+  m_fd = ::socket(endpoint->sa_family, SOCK_STREAM, 0);
+  if (m_fd < 0) {
+    throw exceptions::ProxyException(
+        "socket() failed: " + getErrorMessage(errno),
+        exceptions::ProxyException::CONNECT_FAILED);
+  }
+
+  const int flags = fcntl(m_fd, F_GETFL, 0);
+  fcntl(m_fd, F_SETFL, flags | O_NONBLOCK);
+  fcntl(m_fd, F_SETFD, FD_CLOEXEC);
+  const int noDelay = 1;
+  setsockopt(m_fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+  const int connected = ::connect(m_fd, endpoint, length);
+  const int error = errno;
+
+  if (connected == 0) {
+    return;
+  }
+  if (error == EINPROGRESS || error == EAGAIN) {
+    m_connecting = true;
+    return;
+  }
+
+  close();
+  throw exceptions::ProxyException(
+      "connect to " + m_address + " failed: " + getErrorMessage(error),
+      exceptions::ProxyException::CONNECT_FAILED);
+}
+
+void UpstreamConnection::close() {
+  if (m_fd >= 0) {
+    ::close(m_fd);
+    m_fd = -1;
+  }
+}
+
+std::string UpstreamConnection::getErrorMessage(int errnoValue) {
+  return std::string(std::strerror(errnoValue));
+}
+
+}  // namespace adapters
+}  // namespace proxy
+}  // namespace infrastructure
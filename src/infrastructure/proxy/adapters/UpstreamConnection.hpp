@@ -0,0 +1,67 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   UpstreamConnection.hpp                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 09:34:02 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 09:34:02 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef UPSTREAM_CONNECTION_HPP
+#define UPSTREAM_CONNECTION_HPP
+
+#include <cstddef>
+#include <string>
+#include <sys/socket.h>
+#include <sys/types.h>
+
+namespace infrastructure {
+namespace proxy {
+namespace adapters {
+
+// A non-blocking TCP connection to one upstream server. The endpoint was
+// resolved when the pool was configured, so connect() returns at once; the
+// caller waits for the socket to turn writable on its own event loop and
+// then calls finishConnect() to learn the outcome.
+class UpstreamConnection {
+ public:
+  static const ssize_t K_WOULD_BLOCK = -1;
+
+  UpstreamConnection(const std::string& address,
+                     const struct sockaddr* endpoint, socklen_t length);
+  ~UpstreamConnection();
+
+  const std::string& getAddress() const;
+  int getFd() const;
+  bool isConnecting() const;
+  std::size_t getRequestCount() const;
+
+  bool finishConnect();
+  ssize_t send(const char* data, std::size_t size);
+  ssize_t receive(char* buffer, std::size_t size);
+  bool isPeerClosed() const;
+  void markRequest();
+
+ private:
+  UpstreamConnection(const UpstreamConnection&);
+  UpstreamConnection& operator=(const UpstreamConnection&);
+
+  std::string m_address;
+  int m_fd;
+  bool m_connecting;
+  std::size_t m_requestCount;
+
+  void open(const struct sockaddr* endpoint, socklen_t length);
+  void close();
+
+  static std::string getErrorMessage(int errnoValue);
+};
+
+}  // namespace adapters
+}  // namespace proxy
+}  // namespace infrastructure
+
+#endif  // UPSTREAM_CONNECTION_HPP
@@ -0,0 +1,376 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   UpstreamPool.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 09:52:10 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 09:52:10 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/proxy/adapters/UpstreamPool.hpp"
+#include "infrastructure/proxy/exceptions/ProxyException.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <netdb.h>
+#include <sstream>
+
+namespace infrastructure {
+namespace proxy {
+namespace adapters {
+
+namespace {
+
+const unsigned long K_FNV_OFFSET_BASIS = 2166136261ul;
+const unsigned long K_FNV_PRIME = 16777619ul;
+const unsigned long K_FNV_MASK = 0xfffffffful;
+
+unsigned long hashValue(const std::string& value) {
+  unsigned long hash = K_FNV_OFFSET_BASIS;
+  for (std::size_t i = 0; i < value.size(); ++i) {
+    hash ^= static_cast<unsigned char>(value[i]);
+    hash = (hash * K_FNV_PRIME) & K_FNV_MASK;
+  }
+  return hash;
+}
+
+}  // namespace
+
+UpstreamPool::Peer::Peer(const UpstreamConfig::Server& peerServer,
+                         std::size_t idleLimit)
+    : server(peerServer),
+      address(peerServer.getAddress()),
+      endpointLength(0),
+      keepalive(idleLimit),
+      currentWeight(0),
+      active(0),
+      fails(0),
+      failWindowStart(0),
+      downUntil(0),
+      retired(false) {
+  std::memset(&endpoint, 0, sizeof(endpoint));
+}
+
+UpstreamPool::UpstreamPool(application::ports::ILogger& logger)
+    : m_logger(logger), m_connectCount(0), m_reuseCount(0) {}
+
+UpstreamPool::~UpstreamPool() {
+  clearGroups();
+  for (std::size_t i = 0; i < m_retired.size(); ++i) {
+    closeConnections(m_retired[i]->idle);
+    delete m_retired[i];
+  }
+  m_retired.clear();
+}
+
+void UpstreamPool::configure(
+    const domain::configuration::entities::HttpConfig::Upstreams& upstreams) {
+  clearGroups();
+
+  for (domain::configuration::entities::HttpConfig::Upstreams::const_iterator
+           it = upstreams.begin();
+       it != upstreams.end(); ++it) {
+    const UpstreamConfig& config = it->second;
+    Group* group = new Group();
+    group->name = config.getName();
+    group->balance = config.getBalance();
+    group->hashKey = config.getHashKey();
+    const UpstreamConfig::ServerList& servers = config.getServers();
+    for (std::size_t i = 0; i < servers.size(); ++i) {
+      group->peers.push_back(new Peer(servers[i], config.getKeepalive()));
+      resolvePeer(*group->peers.back());
+    }
+    m_groups[it->first] = group;
+  }
+
+  std::ostringstream oss;
+  oss << "Upstream pool configured with " << upstreams.size()
+      << " upstream group(s)";
+  m_logger.info(oss.str());
+}
+
+// A port of 0 means the proxy_pass URL named none.
+std::string UpstreamPool::resolve(const std::string& host, unsigned int port) {
+  if (port == 0 && m_groups.find(host) != m_groups.end()) {
+    return host;
+  }
+
+  const UpstreamConfig::Server server(
+      host, port == 0 ? UpstreamConfig::DEFAULT_PORT : port);
+  const std::string key = server.getAddress();
+  if (m_groups.find(key) == m_groups.end()) {
+    Group* group = new Group();
+    group->name = key;
+    group->balance = UpstreamConfig::BALANCE_ROUND_ROBIN;
+    group->peers.push_back(new Peer(server, UpstreamConfig::DEFAULT_KEEPALIVE));
+    resolvePeer(*group->peers.back());
+    m_groups[key] = group;
+  }
+  return key;
+}
+
+const UpstreamPool::Group* UpstreamPool::findGroup(
+    const std::string& key) const {
+  GroupMap::const_iterator it = m_groups.find(key);
+  return it != m_groups.end() ? it->second : NULL;
+}
+
+UpstreamPool::Peer* UpstreamPool::select(const Group& group,
+                                         const std::string& hashValue,
+                                         const PeerList& exclude,
+                                         std::time_t now) {
+  if (group.balance == UpstreamConfig::BALANCE_LEAST_CONN) {
+    return selectLeastConnected(group.peers, exclude, now);
+  }
+  if (group.balance == UpstreamConfig::BALANCE_HASH) {
+    return selectHashed(group.peers, hashValue, exclude, now);
+  }
+
+  PeerList candidates;
+  for (std::size_t i = 0; i < group.peers.size(); ++i) {
+    if (isEligible(*group.peers[i], exclude, now)) {
+      candidates.push_back(group.peers[i]);
+    }
+  }
+  return selectWeighted(candidates);
+}
+
+UpstreamConnection* UpstreamPool::acquire(Peer& peer, bool& reused) {
+  while (!peer.idle.empty()) {
+    UpstreamConnection* connection = peer.idle.back();
+    peer.idle.pop_back();
+    if (!connection->isPeerClosed()) {
+      reused = true;
+      ++m_reuseCount;
+      ++peer.active;
+      return connection;
+    }
+    delete connection;
+  }
+
+  if (peer.endpointLength == 0) {
+    throw exceptions::ProxyException(
+        "cannot resolve upstream host " + peer.server.host,
+        exceptions::ProxyException::CONNECT_FAILED);
+  }
+
+  reused = false;
+  UpstreamConnection* connection = new UpstreamConnection(
+      peer.address, reinterpret_cast<const struct sockaddr*>(&peer.endpoint),
+      peer.endpointLength);
+  ++m_connectCount;
+  ++peer.active;
+  return connection;
+}
+
+void UpstreamPool::release(Peer& peer, UpstreamConnection* connection,
+                           bool reusable) {
+  if (peer.active > 0) {
+    --peer.active;
+  }
+
+  if (connection != NULL) {
+    if (reusable && !peer.retired && peer.idle.size() < peer.keepalive) {
+      peer.idle.push_back(connection);
+    } else {
+      delete connection;
+    }
+  }
+
+  if (peer.retired && peer.active == 0) {
+    freeRetiredPeer(&peer);
+  }
+}
+
+// nginx semantics: max_fails failures within fail_timeout seconds take the
+// server out of rotation for fail_timeout seconds; max_fails=0 never does.
+void UpstreamPool::reportFailure(Peer& peer, std::time_t now) {
+  if (peer.server.maxFails == 0) {
+    return;
+  }
+
+  if (now - peer.failWindowStart >
+      static_cast<std::time_t>(peer.server.failTimeout)) {
+    peer.fails = 0;
+    peer.failWindowStart = now;
+  }
+  ++peer.fails;
+
+  if (peer.fails >= peer.server.maxFails) {
+    peer.downUntil = now + static_cast<std::time_t>(peer.server.failTimeout);
+    peer.fails = 0;
+    std::ostringstream oss;
+    oss << "Upstream server " << peer.address << " marked down for "
+        << peer.server.failTimeout << "s";
+    m_logger.warn(oss.str());
+  }
+}
+
+void UpstreamPool::reportSuccess(Peer& peer) { peer.fails = 0; }
+
+std::size_t UpstreamPool::getConnectCount() const { return m_connectCount; }
+
+std::size_t UpstreamPool::getReuseCount() const { return m_reuseCount; }
+
+std::size_t UpstreamPool::getIdleCount() const {
+  std::size_t count = 0;
+  for (GroupMap::const_iterator it = m_groups.begin(); it != m_groups.end();
+       ++it) {
+    for (std::size_t i = 0; i < it->second->peers.size(); ++i) {
+      count += it->second->peers[i]->idle.size();
+    }
+  }
+  return count;
+}
+
+void UpstreamPool::closeIdle() {
+  for (GroupMap::iterator it = m_groups.begin(); it != m_groups.end(); ++it) {
+    for (std::size_t i = 0; i < it->second->peers.size(); ++i) {
+      closeConnections(it->second->peers[i]->idle);
+    }
+  }
+}
+
+void UpstreamPool::clearGroups() {
+  for (GroupMap::iterator it = m_groups.begin(); it != m_groups.end(); ++it) {
+    for (std::size_t i = 0; i < it->second->peers.size(); ++i) {
+      retirePeer(it->second->peers[i]);
+    }
+    delete it->second;
+  }
+  m_groups.clear();
+}
+
+// A name that does not resolve leaves the server unusable until the next
+// reload; acquire() then fails so the request moves on to another server.
+void UpstreamPool::resolvePeer(Peer& peer) {
+  std::ostringstream service;
+  service << peer.server.port;
+
+  struct addrinfo hints;
+  std::memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags = AI_NUMERICSERV;
+
+  struct addrinfo* result = NULL;
+  const int status = getaddrinfo(peer.server.host.c_str(),
+                                 service.str().c_str(), &hints, &result);
+  if (status != 0 || result == NULL) {
+    m_logger.warn("Cannot resolve upstream server " + peer.address + ": " +
+                  gai_strerror(status));
+    return;
+  }
+
+  std::memcpy(&peer.endpoint, result->ai_addr, result->ai_addrlen);
+  peer.endpointLength = result->ai_addrlen;
+  freeaddrinfo(result);
+}
+
+void UpstreamPool::retirePeer(Peer* peer) {
+  closeConnections(peer->idle);
+  if (peer->active == 0) {
+    delete peer;
+    return;
+  }
+  peer->retired = true;
+  m_retired.push_back(peer);
+}
+
+void UpstreamPool::freeRetiredPeer(Peer* peer) {
+  PeerList::iterator it = std::find(m_retired.begin(), m_retired.end(), peer);
+  if (it != m_retired.end()) {
+    m_retired.erase(it);
+  }
+  closeConnections(peer->idle);
+  delete peer;
+}
+
+bool UpstreamPool::isEligible(const Peer& peer, const PeerList& exclude,
+                              std::time_t now) {
+  return now >= peer.downUntil &&
+         std::find(exclude.begin(), exclude.end(), &peer) == exclude.end();
+}
+
+// Smooth weighted round-robin as nginx does it: every candidate gains its
+// weight, the richest is picked and pays back the total, so a 5:1:1 group
+// yields a,a,b,a,c,a,a rather than five a's in a row.
+UpstreamPool::Peer* UpstreamPool::selectWeighted(const PeerList& candidates) {
+  Peer* best = NULL;
+  int total = 0;
+  for (std::size_t i = 0; i < candidates.size(); ++i) {
+    Peer* peer = candidates[i];
+    const int weight = static_cast<int>(peer->server.weight);
+    peer->currentWeight += weight;
+    total += weight;
+    if (best == NULL || peer->currentWeight > best->currentWeight) {
+      best = peer;
+    }
+  }
+  if (best != NULL) {
+    best->currentWeight -= total;
+  }
+  return best;
+}
+
+// Fewest active requests relative to weight; ties are broken by weighted
+// round-robin so an idle group still spreads load.
+UpstreamPool::Peer* UpstreamPool::selectLeastConnected(const PeerList& peers,
+                                                       const PeerList& exclude,
+                                                       std::time_t now) {
+  PeerList tied;
+  for (std::size_t i = 0; i < peers.size(); ++i) {
+    Peer* peer = peers[i];
+    if (!isEligible(*peer, exclude, now)) {
+      continue;
+    }
+    if (tied.empty()) {
+      tied.push_back(peer);
+      continue;
+    }
+    const Peer* current = tied[0];
+    const std::size_t lhs = peer->active * current->server.weight;
+    const std::size_t rhs = current->active * peer->server.weight;
+    if (lhs < rhs) {
+      tied.clear();
+      tied.push_back(peer);
+    } else if (lhs == rhs) {
+      tied.push_back(peer);
+    }
+  }
+  return selectWeighted(tied);
+}
+
+// The key picks a starting server; an unavailable one passes the request to
+// the next in order, so keys only move while their server is down.
+UpstreamPool::Peer* UpstreamPool::selectHashed(const PeerList& peers,
+                                               const std::string& value,
+                                               const PeerList& exclude,
+                                               std::time_t now) {
+  if (peers.empty()) {
+    return NULL;
+  }
+  const std::size_t start = hashValue(value) % peers.size();
+  for (std::size_t i = 0; i < peers.size(); ++i) {
+    Peer* peer = peers[(start + i) % peers.size()];
+    if (isEligible(*peer, exclude, now)) {
+      return peer;
+    }
+  }
+  return NULL;
+}
+
+void UpstreamPool::closeConnections(
+    std::vector<UpstreamConnection*>& connections) {
+  for (std::size_t i = 0; i < connections.size(); ++i) {
+    delete connections[i];
+  }
+  connections.clear();
+}
+
+}  // namespace adapters
+}  // namespace proxy
+}  // namespace infrastructure
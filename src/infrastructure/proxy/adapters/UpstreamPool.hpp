@@ -0,0 +1,123 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   UpstreamPool.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 09:52:10 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 09:52:10 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef UPSTREAM_POOL_HPP
+#define UPSTREAM_POOL_HPP
+
+#include "application/ports/ILogger.hpp"
+#include "domain/configuration/entities/HttpConfig.hpp"
+#include "domain/configuration/value_objects/UpstreamConfig.hpp"
+#include "infrastructure/proxy/adapters/UpstreamConnection.hpp"
+
+#include <cstddef>
+#include <ctime>
+#include <map>
+#include <string>
+#include <sys/socket.h>
+#include <vector>
+
+namespace infrastructure {
+namespace proxy {
+namespace adapters {
+
+// Server selection and idle keep-alive connections for every upstream the
+// configuration names. A proxy_pass to a literal host:port gets an implicit
+// single-server group on first use; a name without a port refers to an
+// upstream block when one exists. Every server's address is resolved once,
+// when its group is created, so connecting never waits on DNS. Peers
+// outlive a reload while requests still hold them; a retired peer is freed
+// with its last connection.
+class UpstreamPool {
+ public:
+  typedef domain::configuration::value_objects::UpstreamConfig UpstreamConfig;
+
+  struct Peer {
+    UpstreamConfig::Server server;
+    std::string address;
+    struct sockaddr_storage endpoint;
+    socklen_t endpointLength;
+    std::size_t keepalive;
+    int currentWeight;
+    std::size_t active;
+    unsigned int fails;
+    std::time_t failWindowStart;
+    std::time_t downUntil;
+    bool retired;
+    std::vector<UpstreamConnection*> idle;
+
+    Peer(const UpstreamConfig::Server& peerServer, std::size_t idleLimit);
+  };
+
+  typedef std::vector<Peer*> PeerList;
+
+  struct Group {
+    std::string name;
+    UpstreamConfig::Balance balance;
+    std::string hashKey;
+    PeerList peers;
+  };
+
+  explicit UpstreamPool(application::ports::ILogger& logger);
+  ~UpstreamPool();
+
+  void configure(
+      const domain::configuration::entities::HttpConfig::Upstreams& upstreams);
+
+  std::string resolve(const std::string& host, unsigned int port);
+  const Group* findGroup(const std::string& key) const;
+
+  Peer* select(const Group& group, const std::string& hashValue,
+               const PeerList& exclude, std::time_t now);
+  UpstreamConnection* acquire(Peer& peer, bool& reused);
+  void release(Peer& peer, UpstreamConnection* connection, bool reusable);
+
+  void reportFailure(Peer& peer, std::time_t now);
+  void reportSuccess(Peer& peer);
+
+  std::size_t getConnectCount() const;
+  std::size_t getReuseCount() const;
+  std::size_t getIdleCount() const;
+
+  void closeIdle();
+
+ private:
+  UpstreamPool(const UpstreamPool&);
+  UpstreamPool& operator=(const UpstreamPool&);
+
+  typedef std::map<std::string, Group*> GroupMap;
+
+  application::ports::ILogger& m_logger;
+  GroupMap m_groups;
+  PeerList m_retired;
+  std::size_t m_connectCount;
+  std::size_t m_reuseCount;
+
+  void clearGroups();
+  void resolvePeer(Peer& peer);
+  void retirePeer(Peer* peer);
+  void freeRetiredPeer(Peer* peer);
+
+  static bool isEligible(const Peer& peer, const PeerList& exclude,
+                         std::time_t now);
+  static Peer* selectWeighted(const PeerList& candidates);
+  static Peer* selectLeastConnected(const PeerList& peers,
+                                    const PeerList& exclude, std::time_t now);
+  static Peer* selectHashed(const PeerList& peers, const std::string& value,
+                            const PeerList& exclude, std::time_t now);
+  static void closeConnections(std::vector<UpstreamConnection*>& connections);
+};
+
+}  // namespace adapters
+}  // namespace proxy
+}  // namespace infrastructure
+
+#endif  // UPSTREAM_POOL_HPP
@@ -0,0 +1,70 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ProxyException.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 09:20:11 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 09:20:11 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/proxy/exceptions/ProxyException.hpp"
+
+#include <sstream>
+
+namespace infrastructure {
+namespace proxy {
+namespace exceptions {
+
+const std::pair<ProxyException::ErrorCode, std::string>
+    ProxyException::K_CODE_MSGS[] = {
+        std::make_pair(ProxyException::CONNECT_FAILED,
+                       "Failed to connect to upstream"),
+        std::make_pair(ProxyException::SEND_FAILED,
+                       "Failed to send request to upstream"),
+        std::make_pair(ProxyException::RECEIVE_FAILED,
+                       "Failed to read response from upstream"),
+        std::make_pair(ProxyException::INVALID_RESPONSE,
+                       "Upstream sent an invalid response"),
+        std::make_pair(ProxyException::UPSTREAM_CLOSED,
+                       "Upstream closed the connection prematurely"),
+        std::make_pair(ProxyException::TIMEOUT, "Upstream timed out"),
+        std::make_pair(ProxyException::NO_LIVE_UPSTREAM,
+                       "No live upstream server")};
+
+ProxyException::ProxyException(const std::string& message, ErrorCode code)
+    : BaseException("", static_cast<int>(code)), m_code(code) {
+  std::ostringstream oss;
+  oss << getErrorMsg(code) << ": " << message;
+  this->m_whatMsg = oss.str();
+}
+
+ProxyException::ProxyException(const ProxyException& other)
+    : BaseException(other), m_code(other.m_code) {}
+
+ProxyException::~ProxyException() throw() {}
+
+ProxyException& ProxyException::operator=(const ProxyException& other) {
+  if (this != &other) {
+    BaseException::operator=(other);
+    m_code = other.m_code;
+  }
+  return *this;
+}
+
+ProxyException::ErrorCode ProxyException::getCode() const { return m_code; }
+
+std::string ProxyException::getErrorMsg(ErrorCode code) {
+  for (int i = 0; i < CODE_COUNT; ++i) {
+    if (K_CODE_MSGS[i].first == code) {
+      return K_CODE_MSGS[i].second;
+    }
+  }
+  return "unknown proxy error";
+}
+
+}  // namespace exceptions
+}  // namespace proxy
+}  // namespace infrastructure
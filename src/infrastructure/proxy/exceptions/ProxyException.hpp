@@ -0,0 +1,55 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ProxyException.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 09:20:11 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 09:20:11 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef PROXY_EXCEPTION_HPP
+#define PROXY_EXCEPTION_HPP
+
+#include "shared/exceptions/BaseException.hpp"
+
+namespace infrastructure {
+namespace proxy {
+namespace exceptions {
+
+class ProxyException : public ::shared::exceptions::BaseException {
+ public:
+  enum ErrorCode {
+    CONNECT_FAILED,
+    SEND_FAILED,
+    RECEIVE_FAILED,
+    INVALID_RESPONSE,
+    UPSTREAM_CLOSED,
+    TIMEOUT,
+    NO_LIVE_UPSTREAM,
+    CODE_COUNT
+  };
+
+  explicit ProxyException(const std::string& message, ErrorCode code);
+  ProxyException(const ProxyException& other);
+  virtual ~ProxyException() throw();
+
+  ProxyException& operator=(const ProxyException& other);
+
+  ErrorCode getCode() const;
+
+ private:
+  ErrorCode m_code;
+
+  static const std::pair<ErrorCode, std::string> K_CODE_MSGS[];
+
+  static std::string getErrorMsg(ErrorCode code);
+};
+
+}  // namespace exceptions
+}  // namespace proxy
+}  // namespace infrastructure
+
+#endif  // PROXY_EXCEPTION_HPP
@@ -0,0 +1,115 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   UpstreamRequest.cpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 10:04:27 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 10:04:27 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/proxy/primitives/UpstreamRequest.hpp"
+#include "domain/shared/utils/StringUtils.hpp"
+
+#include <sstream>
+
+namespace infrastructure {
+namespace proxy {
+namespace primitives {
+
+namespace {
+
+const char* const K_HOP_BY_HOP_HEADERS[] = {
+    "connection",       "keep-alive", "proxy-authenticate",
+    "proxy-authorization", "proxy-connection", "te",
+    "trailer",          "transfer-encoding", "upgrade"};
+
+// Rewritten or regenerated for the upstream hop rather than copied.
+const char* const K_REPLACED_HEADERS[] = {"host", "content-length", "expect",
+                                          "x-forwarded-for"};
+
+bool isListed(const std::string& name, const char* const* list,
+              std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    if (name == list[i]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+std::string UpstreamRequest::buildHead(const std::string& method,
+                                       const std::string& target,
+                                       const std::string& host,
+                                       const HeaderMap& headers,
+                                       const std::string& clientAddress,
+                                       std::size_t bodySize) {
+  std::ostringstream head;
+  head << method << " " << target << " HTTP/1.1\r\n";
+  head << "Host: " << host << "\r\n";
+
+  std::string forwardedFor;
+  for (HeaderMap::const_iterator it = headers.begin(); it != headers.end();
+       ++it) {
+    const std::string name =
+        domain::shared::utils::StringUtils::toLowerCase(it->first);
+    if (name == "x-forwarded-for") {
+      forwardedFor = it->second;
+    }
+    if (isHopByHopHeader(name) ||
+        isListed(name, K_REPLACED_HEADERS,
+                 sizeof(K_REPLACED_HEADERS) / sizeof(K_REPLACED_HEADERS[0]))) {
+      continue;
+    }
+    head << it->first << ": " << it->second << "\r\n";
+  }
+
+  if (!clientAddress.empty()) {
+    head << "X-Forwarded-For: "
+         << (forwardedFor.empty() ? clientAddress
+                                  : forwardedFor + ", " + clientAddress)
+         << "\r\n";
+  }
+  if (bodySize > 0 || method == "POST" || method == "PUT") {
+    head << "Content-Length: " << bodySize << "\r\n";
+  }
+  head << "Connection: keep-alive\r\n\r\n";
+  return head.str();
+}
+
+// As nginx: a proxy_pass URL with a path replaces the part of the request
+// path the location matched; one without a path forwards it unchanged.
+std::string UpstreamRequest::rewriteTarget(const std::string& requestPath,
+                                           const std::string& query,
+                                           const std::string& locationPath,
+                                           const std::string& proxyPath) {
+  std::string path = requestPath.empty() ? "/" : requestPath;
+  if (!proxyPath.empty()) {
+    const std::string rest =
+        path.compare(0, locationPath.size(), locationPath) == 0
+            ? path.substr(locationPath.size())
+            : path;
+    if (proxyPath[proxyPath.size() - 1] == '/' && !rest.empty() &&
+        rest[0] == '/') {
+      path = proxyPath + rest.substr(1);
+    } else {
+      path = proxyPath + rest;
+    }
+  }
+  return path + query;
+}
+
+bool UpstreamRequest::isHopByHopHeader(const std::string& name) {
+  return isListed(
+      domain::shared::utils::StringUtils::toLowerCase(name),
+      K_HOP_BY_HOP_HEADERS,
+      sizeof(K_HOP_BY_HOP_HEADERS) / sizeof(K_HOP_BY_HOP_HEADERS[0]));
+}
+
+}  // namespace primitives
+}  // namespace proxy
+}  // namespace infrastructure
@@ -0,0 +1,53 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   UpstreamRequest.hpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 10:04:27 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 10:04:27 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef UPSTREAM_REQUEST_HPP
+#define UPSTREAM_REQUEST_HPP
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+namespace infrastructure {
+namespace proxy {
+namespace primitives {
+
+// The request head sent upstream: HTTP/1.1 with keep-alive, the client's
+// end-to-end headers, Host set to the proxy_pass host and the client added
+// to X-Forwarded-For. Hop-by-hop headers stay on the client connection.
+class UpstreamRequest {
+ public:
+  typedef std::map<std::string, std::string> HeaderMap;
+
+  static std::string buildHead(const std::string& method,
+                               const std::string& target,
+                               const std::string& host,
+                               const HeaderMap& headers,
+                               const std::string& clientAddress,
+                               std::size_t bodySize);
+
+  static std::string rewriteTarget(const std::string& requestPath,
+                                   const std::string& query,
+                                   const std::string& locationPath,
+                                   const std::string& proxyPath);
+
+  static bool isHopByHopHeader(const std::string& name);
+
+ private:
+  UpstreamRequest();
+};
+
+}  // namespace primitives
+}  // namespace proxy
+}  // namespace infrastructure
+
+#endif  // UPSTREAM_REQUEST_HPP
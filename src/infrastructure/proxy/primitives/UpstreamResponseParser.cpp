@@ -0,0 +1,407 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   UpstreamResponseParser.cpp                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 09:26:47 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 09:26:47 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "domain/shared/utils/StringUtils.hpp"
+#include "infrastructure/proxy/exceptions/ProxyException.hpp"
+#include "infrastructure/proxy/primitives/UpstreamResponseParser.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+namespace infrastructure {
+namespace proxy {
+namespace primitives {
+
+namespace {
+
+typedef domain::shared::utils::StringUtils StringUtils;
+
+const std::string K_HEADER_END = "\r\n\r\n";
+const unsigned int K_STATUS_SWITCHING_PROTOCOLS = 101;
+const unsigned int K_STATUS_NO_CONTENT = 204;
+const unsigned int K_STATUS_NOT_MODIFIED = 304;
+const unsigned int K_STATUS_MIN = 100;
+const unsigned int K_STATUS_MAX = 599;
+const std::size_t K_STATUS_DIGITS = 3;
+
+bool isInterim(unsigned int status) {
+  return status < 200 && status != K_STATUS_SWITCHING_PROTOCOLS;
+}
+
+bool hasToken(const std::string& value, const std::string& token) {
+  return StringUtils::toLowerCase(value).find(token) != std::string::npos;
+}
+
+}  // namespace
+
+UpstreamResponseParser::UpstreamResponseParser() : m_headRequest(false) {
+  reset();
+}
+
+UpstreamResponseParser::~UpstreamResponseParser() {}
+
+void UpstreamResponseParser::reset() {
+  m_state = STATE_HEADERS;
+  m_headerBlock.clear();
+  m_line.clear();
+  m_statusCode = 0;
+  m_reason.clear();
+  m_headers.clear();
+  m_framing = FRAMING_NONE;
+  m_contentLength = 0;
+  m_remaining = 0;
+  m_http11 = false;
+  m_connectionClose = false;
+  m_connectionKeepAlive = false;
+  m_trailingData = false;
+}
+
+void UpstreamResponseParser::setHeadRequest(bool headRequest) {
+  m_headRequest = headRequest;
+}
+
+void UpstreamResponseParser::feed(const char* data, std::size_t size,
+                                  std::string& body) {
+  std::size_t pos = 0;
+  while (pos < size) {
+    if (m_state == STATE_HEADERS) {
+      pos += feedHeaders(data + pos, size - pos);
+    } else if (m_state == STATE_COMPLETE) {
+      m_trailingData = true;
+      return;
+    } else {
+      pos += feedBody(data + pos, size - pos, body);
+    }
+  }
+}
+
+// Only a close-delimited body may legitimately end with the connection.
+void UpstreamResponseParser::finishOnClose() {
+  if (m_state == STATE_BODY && m_framing == FRAMING_CLOSE) {
+    m_state = STATE_COMPLETE;
+    return;
+  }
+  if (m_state != STATE_COMPLETE) {
+    throw exceptions::ProxyException(
+        m_state == STATE_HEADERS ? "connection closed before response headers"
+                                 : "connection closed mid-body",
+        exceptions::ProxyException::UPSTREAM_CLOSED);
+  }
+}
+
+bool UpstreamResponseParser::hasHeaders() const {
+  return m_state != STATE_HEADERS;
+}
+
+bool UpstreamResponseParser::isComplete() const {
+  return m_state == STATE_COMPLETE;
+}
+
+unsigned int UpstreamResponseParser::getStatusCode() const {
+  return m_statusCode;
+}
+
+const std::string& UpstreamResponseParser::getReason() const {
+  return m_reason;
+}
+
+const UpstreamResponseParser::HeaderList& UpstreamResponseParser::getHeaders()
+    const {
+  return m_headers;
+}
+
+std::string UpstreamResponseParser::getHeader(const std::string& name) const {
+  const std::string wanted = StringUtils::toLowerCase(name);
+  for (HeaderList::const_iterator it = m_headers.begin();
+       it != m_headers.end(); ++it) {
+    if (StringUtils::toLowerCase(it->first) == wanted) {
+      return it->second;
+    }
+  }
+  return "";
+}
+
+UpstreamResponseParser::Framing UpstreamResponseParser::getFraming() const {
+  return m_framing;
+}
+
+std::size_t UpstreamResponseParser::getContentLength() const {
+  return m_contentLength;
+}
+
+// A connection can go back to the pool only if the response ended on its own
+// framing, the upstream did not ask to close, and nothing followed it.
+bool UpstreamResponseParser::isKeepAlive() const {
+  if (m_framing == FRAMING_CLOSE || m_trailingData || m_connectionClose) {
+    return false;
+  }
+  return m_http11 || m_connectionKeepAlive;
+}
+
+std::size_t UpstreamResponseParser::feedHeaders(const char* data,
+                                                std::size_t size) {
+  const std::size_t previous = m_headerBlock.size();
+  m_headerBlock.append(data, size);
+
+  const std::size_t searchFrom =
+      previous >= K_HEADER_END.size() - 1 ? previous - (K_HEADER_END.size() - 1)
+                                          : 0;
+  const std::size_t end = m_headerBlock.find(K_HEADER_END, searchFrom);
+  if (end == std::string::npos) {
+    if (m_headerBlock.size() > K_MAX_HEADER_SIZE) {
+      throw exceptions::ProxyException(
+          "response header block too large",
+          exceptions::ProxyException::INVALID_RESPONSE);
+    }
+    return size;
+  }
+
+  const std::size_t blockEnd = end + K_HEADER_END.size();
+  const std::size_t consumed = blockEnd - previous;
+  const std::string block = m_headerBlock.substr(0, end);
+  m_headerBlock.clear();
+
+  parseHeaderBlock(block);
+  if (isInterim(m_statusCode)) {
+    const bool headRequest = m_headRequest;
+    reset();
+    m_headRequest = headRequest;
+    return consumed;
+  }
+
+  selectFraming();
+  return consumed;
+}
+
+std::size_t UpstreamResponseParser::feedBody(const char* data,
+                                             std::size_t size,
+                                             std::string& body) {
+  std::size_t pos = 0;
+  switch (m_state) {
+    case STATE_BODY: {
+      std::size_t length = size;
+      if (m_framing == FRAMING_LENGTH) {
+        length = std::min(length, m_remaining);
+        m_remaining -= length;
+        if (m_remaining == 0) {
+          m_state = STATE_COMPLETE;
+        }
+      }
+      body.append(data, length);
+      return length;
+    }
+    case STATE_CHUNK_SIZE:
+      if (takeLine(data, size, pos)) {
+        m_remaining = parseChunkSize(m_line);
+        m_line.clear();
+        m_state = m_remaining == 0 ? STATE_TRAILERS : STATE_CHUNK_DATA;
+      }
+      return pos;
+    case STATE_CHUNK_DATA: {
+      const std::size_t length = std::min(size, m_remaining);
+      body.append(data, length);
+      m_remaining -= length;
+      if (m_remaining == 0) {
+        m_state = STATE_CHUNK_DATA_END;
+      }
+      return length;
+    }
+    case STATE_CHUNK_DATA_END:
+      if (takeLine(data, size, pos)) {
+        if (!m_line.empty()) {
+          throw exceptions::ProxyException(
+              "missing CRLF after chunk data",
+              exceptions::ProxyException::INVALID_RESPONSE);
+        }
+        m_state = STATE_CHUNK_SIZE;
+      }
+      return pos;
+    case STATE_TRAILERS:
+      if (takeLine(data, size, pos)) {
+        if (m_line.empty()) {
+          m_state = STATE_COMPLETE;
+        }
+        m_line.clear();
+      }
+      return pos;
+    default:
+      return size;
+  }
+}
+
+void UpstreamResponseParser::parseHeaderBlock(const std::string& block) {
+  std::size_t start = 0;
+  bool statusLine = true;
+  while (start <= block.size()) {
+    std::size_t end = block.find('\n', start);
+    if (end == std::string::npos) {
+      end = block.size();
+    }
+    std::string line = block.substr(start, end - start);
+    if (!line.empty() && line[line.size() - 1] == '\r') {
+      line.erase(line.size() - 1);
+    }
+    if (statusLine) {
+      parseStatusLine(line);
+      statusLine = false;
+    } else if (!line.empty()) {
+      addHeader(line);
+    }
+    start = end + 1;
+  }
+}
+
+void UpstreamResponseParser::parseStatusLine(const std::string& line) {
+  const std::string prefix = "HTTP/1.";
+  if (line.compare(0, prefix.size(), prefix) != 0 ||
+      line.size() < prefix.size() + 2 + K_STATUS_DIGITS ||
+      line[prefix.size() + 1] != ' ') {
+    throw exceptions::ProxyException(
+        "malformed status line '" + line.substr(0, K_MAX_LINE_SIZE) + "'",
+        exceptions::ProxyException::INVALID_RESPONSE);
+  }
+
+  m_http11 = line[prefix.size()] == '1';
+  const std::string digits = line.substr(prefix.size() + 2, K_STATUS_DIGITS);
+  if (!StringUtils::isAllDigits(digits)) {
+    throw exceptions::ProxyException(
+        "malformed status code '" + digits + "'",
+        exceptions::ProxyException::INVALID_RESPONSE);
+  }
+  m_statusCode = static_cast<unsigned int>(std::atoi(digits.c_str()));
+  if (m_statusCode < K_STATUS_MIN || m_statusCode > K_STATUS_MAX) {
+    throw exceptions::ProxyException(
+        "status code out of range: " + digits,
+        exceptions::ProxyException::INVALID_RESPONSE);
+  }
+
+  const std::size_t reasonStart = prefix.size() + 2 + K_STATUS_DIGITS + 1;
+  m_reason = reasonStart < line.size() ? line.substr(reasonStart) : "";
+}
+
+void UpstreamResponseParser::addHeader(const std::string& line) {
+  const std::size_t colon = line.find(':');
+  if (colon == std::string::npos || colon == 0 || line[0] == ' ' ||
+      line[0] == '\t') {
+    throw exceptions::ProxyException(
+        "malformed header line '" + line.substr(0, K_MAX_LINE_SIZE) + "'",
+        exceptions::ProxyException::INVALID_RESPONSE);
+  }
+
+  const std::string name = line.substr(0, colon);
+  const std::string value = StringUtils::trim(line.substr(colon + 1));
+  const std::string lowered = StringUtils::toLowerCase(name);
+
+  if (lowered == "connection") {
+    m_connectionClose = m_connectionClose || hasToken(value, "close");
+    m_connectionKeepAlive =
+        m_connectionKeepAlive || hasToken(value, "keep-alive");
+  } else if (lowered == "transfer-encoding") {
+    if (hasToken(value, "chunked")) {
+      m_framing = FRAMING_CHUNKED;
+    }
+  } else if (lowered == "content-length") {
+    if (!StringUtils::isAllDigits(value)) {
+      throw exceptions::ProxyException(
+          "invalid Content-Length '" + value + "'",
+          exceptions::ProxyException::INVALID_RESPONSE);
+    }
+    errno = 0;
+    const unsigned long length = std::strtoul(value.c_str(), NULL, 10);
+    if (errno == ERANGE) {
+      throw exceptions::ProxyException(
+          "Content-Length out of range",
+          exceptions::ProxyException::INVALID_RESPONSE);
+    }
+    if (m_framing == FRAMING_LENGTH && length != m_contentLength) {
+      throw exceptions::ProxyException(
+          "conflicting Content-Length headers",
+          exceptions::ProxyException::INVALID_RESPONSE);
+    }
+    if (m_framing != FRAMING_CHUNKED) {
+      m_framing = FRAMING_LENGTH;
+    }
+    m_contentLength = static_cast<std::size_t>(length);
+  }
+
+  m_headers.push_back(std::make_pair(name, value));
+}
+
+// RFC 9112 6.3: HEAD, 204 and 304 never carry a body; chunked wins over a
+// Content-Length; with neither, the body runs until the upstream closes.
+void UpstreamResponseParser::selectFraming() {
+  if (m_headRequest || m_statusCode == K_STATUS_NO_CONTENT ||
+      m_statusCode == K_STATUS_NOT_MODIFIED) {
+    if (m_framing == FRAMING_CHUNKED) {
+      m_framing = FRAMING_NONE;
+    }
+    m_state = STATE_COMPLETE;
+    return;
+  }
+
+  switch (m_framing) {
+    case FRAMING_CHUNKED:
+      m_state = STATE_CHUNK_SIZE;
+      break;
+    case FRAMING_LENGTH:
+      m_remaining = m_contentLength;
+      m_state = m_contentLength == 0 ? STATE_COMPLETE : STATE_BODY;
+      break;
+    default:
+      m_framing = FRAMING_CLOSE;
+      m_state = STATE_BODY;
+      break;
+  }
+}
+
+bool UpstreamResponseParser::takeLine(const char* data, std::size_t size,
+                                      std::size_t& pos) {
+  const char* newline =
+      static_cast<const char*>(std::memchr(data + pos, '\n', size - pos));
+  const std::size_t end =
+      newline != NULL ? static_cast<std::size_t>(newline - data) : size;
+
+  m_line.append(data + pos, end - pos);
+  if (m_line.size() > K_MAX_LINE_SIZE) {
+    throw exceptions::ProxyException(
+        "chunk line too long", exceptions::ProxyException::INVALID_RESPONSE);
+  }
+  if (newline == NULL) {
+    pos = size;
+    return false;
+  }
+
+  pos = end + 1;
+  if (!m_line.empty() && m_line[m_line.size() - 1] == '\r') {
+    m_line.erase(m_line.size() - 1);
+  }
+  return true;
+}
+
+std::size_t UpstreamResponseParser::parseChunkSize(const std::string& line) {
+  const std::string digits =
+      StringUtils::trim(line.substr(0, line.find(';')));
+  if (digits.empty() || !StringUtils::isAllHexDigits(digits) ||
+      digits.size() > sizeof(std::size_t) * 2) {
+    throw exceptions::ProxyException(
+        "invalid chunk size '" + line.substr(0, K_MAX_LINE_SIZE) + "'",
+        exceptions::ProxyException::INVALID_RESPONSE);
+  }
+  return static_cast<std::size_t>(std::strtoul(
+      digits.c_str(), NULL, StringUtils::BASE_HEXADECIMAL));
+}
+
+}  // namespace primitives
+}  // namespace proxy
+}  // namespace infrastructure
@@ -0,0 +1,98 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   UpstreamResponseParser.hpp                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 09:26:47 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 09:26:47 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef UPSTREAM_RESPONSE_PARSER_HPP
+#define UPSTREAM_RESPONSE_PARSER_HPP
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace infrastructure {
+namespace proxy {
+namespace primitives {
+
+// Incremental parser for an upstream HTTP/1.x response. The header block is
+// buffered until complete; body bytes are decoded as they arrive (chunked
+// framing removed) and appended to the caller's buffer, so the body is never
+// held whole. Interim 1xx responses are skipped.
+class UpstreamResponseParser {
+ public:
+  enum Framing { FRAMING_NONE, FRAMING_LENGTH, FRAMING_CHUNKED, FRAMING_CLOSE };
+
+  typedef std::vector<std::pair<std::string, std::string> > HeaderList;
+
+  static const std::size_t K_MAX_HEADER_SIZE = 65536;
+  static const std::size_t K_MAX_LINE_SIZE = 4096;
+
+  UpstreamResponseParser();
+  ~UpstreamResponseParser();
+
+  void reset();
+  void setHeadRequest(bool headRequest);
+
+  void feed(const char* data, std::size_t size, std::string& body);
+  void finishOnClose();
+
+  bool hasHeaders() const;
+  bool isComplete() const;
+  unsigned int getStatusCode() const;
+  const std::string& getReason() const;
+  const HeaderList& getHeaders() const;
+  std::string getHeader(const std::string& name) const;
+  Framing getFraming() const;
+  std::size_t getContentLength() const;
+  bool isKeepAlive() const;
+
+ private:
+  enum State {
+    STATE_HEADERS,
+    STATE_BODY,
+    STATE_CHUNK_SIZE,
+    STATE_CHUNK_DATA,
+    STATE_CHUNK_DATA_END,
+    STATE_TRAILERS,
+    STATE_COMPLETE
+  };
+
+  State m_state;
+  bool m_headRequest;
+  std::string m_headerBlock;
+  std::string m_line;
+  unsigned int m_statusCode;
+  std::string m_reason;
+  HeaderList m_headers;
+  Framing m_framing;
+  std::size_t m_contentLength;
+  std::size_t m_remaining;
+  bool m_http11;
+  bool m_connectionClose;
+  bool m_connectionKeepAlive;
+  bool m_trailingData;
+
+  std::size_t feedHeaders(const char* data, std::size_t size);
+  std::size_t feedBody(const char* data, std::size_t size, std::string& body);
+  void parseHeaderBlock(const std::string& block);
+  void parseStatusLine(const std::string& line);
+  void addHeader(const std::string& line);
+  void selectFraming();
+  bool takeLine(const char* data, std::size_t size, std::size_t& pos);
+
+  static std::size_t parseChunkSize(const std::string& line);
+};
+
+}  // namespace primitives
+}  // namespace proxy
+}  // namespace infrastructure
+
+#endif  // UPSTREAM_RESPONSE_PARSER_HPP
@@ -0,0 +1,220 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   TlsChannel.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:26:08 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:26:08 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/tls/adapters/TlsChannel.hpp"
+#include "infrastructure/tls/exceptions/TlsException.hpp"
+
+#include <openssl/bio.h>
+#include <openssl/err.h>
+
+#include <cerrno>
+#include <climits>
+#include <cstring>
+
+namespace infrastructure {
+namespace tls {
+namespace adapters {
+
+namespace {
+
+typedef exceptions::TlsException TlsException;
+
+// ALPN lists in wire format, in the server's order of preference.
+const unsigned char K_PROTOCOLS_WITH_HTTP2[] = "\x02h2\x08http/1.1";
+const unsigned char K_PROTOCOLS_HTTP1[] = "\x08http/1.1";
+
+int clampLength(std::size_t length) {
+  return length > static_cast<std::size_t>(INT_MAX)
+             ? INT_MAX
+             : static_cast<int>(length);
+}
+
+}  // namespace
+
+// SSL_new() takes its own reference on the context, so a reload that
+// retires the context does not pull it from under this connection.
+TlsChannel::TlsChannel(int fileDescriptor, SSL_CTX* context)
+    : m_ssl(NULL),
+      m_established(false),
+      m_wantsWrite(false),
+      m_http2Offered(false),
+      m_listenPort(0) {
+  m_ssl = SSL_new(context);
+  if (m_ssl == NULL || SSL_set_fd(m_ssl, fileDescriptor) != 1) {
+    SSL_free(m_ssl);
+    throw TlsException(TlsException::lastLibraryError(),
+                       TlsException::CHANNEL_FAILED);
+  }
+  SSL_set_app_data(m_ssl, this);
+  SSL_set_accept_state(m_ssl);
+}
+
+TlsChannel::~TlsChannel() { SSL_free(m_ssl); }
+
+TlsChannel::HandshakeResult TlsChannel::handshake() {
+  if (m_established) {
+    return HANDSHAKE_DONE;
+  }
+  ERR_clear_error();
+  const int result = SSL_do_handshake(m_ssl);
+  if (result == 1) {
+    m_established = true;
+    m_wantsWrite = false;
+    return HANDSHAKE_DONE;
+  }
+
+  switch (SSL_get_error(m_ssl, result)) {
+    case SSL_ERROR_WANT_READ:
+      m_wantsWrite = false;
+      return HANDSHAKE_WANT_READ;
+    case SSL_ERROR_WANT_WRITE:
+      m_wantsWrite = true;
+      return HANDSHAKE_WANT_WRITE;
+    case SSL_ERROR_SYSCALL:
+      m_lastError = errno != 0 ? std::strerror(errno)
+                               : "connection closed during handshake";
+      ERR_clear_error();
+      return HANDSHAKE_FAILED;
+    default:
+      m_lastError = TlsException::lastLibraryError();
+      return HANDSHAKE_FAILED;
+  }
+}
+
+bool TlsChannel::isEstablished() const { return m_established; }
+
+ssize_t TlsChannel::read(char* buffer, std::size_t maxBytes) {
+  ERR_clear_error();
+  return interpret(SSL_read(m_ssl, buffer, clampLength(maxBytes)), "read");
+}
+
+ssize_t TlsChannel::write(const char* data, std::size_t dataSize) {
+  ERR_clear_error();
+  return interpret(SSL_write(m_ssl, data, clampLength(dataSize)), "write");
+}
+
+// Records already decrypted into OpenSSL's buffer never make the socket
+// readable again, so the caller has to drain them before it waits.
+bool TlsChannel::hasPendingInput() const { return SSL_pending(m_ssl) > 0; }
+
+bool TlsChannel::wantsWrite() const { return m_wantsWrite; }
+
+void TlsChannel::setHttp2Offered(bool offered) { m_http2Offered = offered; }
+
+std::string TlsChannel::getAlpnProtocol() const {
+  const unsigned char* protocol = NULL;
+  unsigned int length = 0;
+  SSL_get0_alpn_selected(m_ssl, &protocol, &length);
+  return protocol != NULL
+             ? std::string(reinterpret_cast<const char*>(protocol), length)
+             : "";
+}
+
+// The socket that accepted the connection, so the SNI callback only picks
+// among the servers listening on it.
+void TlsChannel::setListenBinding(const std::string& address,
+                                  unsigned int port) {
+  m_listenAddress = address;
+  m_listenPort = port;
+}
+
+const std::string& TlsChannel::getListenAddress() const {
+  return m_listenAddress;
+}
+
+unsigned int TlsChannel::getListenPort() const { return m_listenPort; }
+
+bool TlsChannel::isResumed() const { return SSL_session_reused(m_ssl) == 1; }
+
+bool TlsChannel::isKernelSend() const {
+  return BIO_get_ktls_send(SSL_get_wbio(m_ssl)) != 0;
+}
+
+std::string TlsChannel::getVersion() const { return SSL_get_version(m_ssl); }
+
+std::string TlsChannel::getCipher() const {
+  const char* cipher = SSL_get_cipher_name(m_ssl);
+  return cipher != NULL ? cipher : "";
+}
+
+const std::string& TlsChannel::getLastError() const { return m_lastError; }
+
+// Sends close_notify without waiting for the peer's, as the socket is
+// closed right after.
+void TlsChannel::shutdown() {
+  if (m_established) {
+    ERR_clear_error();
+    SSL_shutdown(m_ssl);
+    ERR_clear_error();
+    m_established = false;
+  }
+}
+
+// ALPN callback installed on every context. "h2" is only offered on
+// listeners that carry the http2 parameter; a client that names neither
+// protocol gets no ALPN extension back and falls back to HTTP/1.1.
+int TlsChannel::selectProtocol(SSL* ssl, const unsigned char** out,
+                               unsigned char* outLength,
+                               const unsigned char* in, unsigned int inLength,
+                               void* /*argument*/) {
+  const TlsChannel* channel =
+      static_cast<const TlsChannel*>(SSL_get_app_data(ssl));
+  const bool http2 = channel != NULL && channel->m_http2Offered;
+  const unsigned char* protocols =
+      http2 ? K_PROTOCOLS_WITH_HTTP2 : K_PROTOCOLS_HTTP1;
+  const unsigned int protocolsLength = static_cast<unsigned int>(
+      http2 ? sizeof(K_PROTOCOLS_WITH_HTTP2) - 1
+            : sizeof(K_PROTOCOLS_HTTP1) - 1);
+
+  unsigned char* selected = NULL;
+  if (SSL_select_next_proto(&selected, outLength, protocols, protocolsLength,
+                            in, inLength) != OPENSSL_NPN_NEGOTIATED) {
+    return SSL_TLSEXT_ERR_NOACK;
+  }
+  *out = selected;
+  return SSL_TLSEXT_ERR_OK;
+}
+
+ssize_t TlsChannel::interpret(int result, const char* operation) {
+  if (result > 0) {
+    m_wantsWrite = false;
+    return result;
+  }
+
+  const int savedErrno = errno;
+  switch (SSL_get_error(m_ssl, result)) {
+    case SSL_ERROR_WANT_READ:
+      m_wantsWrite = false;
+      return -1;
+    case SSL_ERROR_WANT_WRITE:
+      m_wantsWrite = true;
+      return -1;
+    case SSL_ERROR_ZERO_RETURN:
+      return 0;
+    case SSL_ERROR_SYSCALL:
+      if (savedErrno == EAGAIN || savedErrno == EWOULDBLOCK) {
+        return -1;
+      }
+      m_lastError = savedErrno != 0 ? std::strerror(savedErrno)
+                                    : "unexpected end of stream";
+      break;
+    default:
+      m_lastError = TlsException::lastLibraryError();
+      break;
+  }
+  throw TlsException(std::string(operation) + ": " + m_lastError,
+                     TlsException::IO_FAILED);
+}
+
+}  // namespace adapters
+}  // namespace tls
+}  // namespace infrastructure
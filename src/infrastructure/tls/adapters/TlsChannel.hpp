@@ -0,0 +1,90 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   TlsChannel.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:26:08 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:26:08 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef TLS_CHANNEL_HPP
+#define TLS_CHANNEL_HPP
+
+#include <openssl/ssl.h>
+
+#include <cstddef>
+#include <string>
+#include <sys/types.h>
+
+namespace infrastructure {
+namespace tls {
+namespace adapters {
+
+// The TLS state of one accepted connection. Every call is non-blocking:
+// handshake() reports which readiness it waits for, and read()/write()
+// return -1 when the record layer needs the socket again, 0 once the peer
+// closed, and throw TlsException on a protocol error.
+class TlsChannel {
+ public:
+  enum HandshakeResult {
+    HANDSHAKE_DONE,
+    HANDSHAKE_WANT_READ,
+    HANDSHAKE_WANT_WRITE,
+    HANDSHAKE_FAILED
+  };
+
+  TlsChannel(int fileDescriptor, SSL_CTX* context);
+  ~TlsChannel();
+
+  HandshakeResult handshake();
+  bool isEstablished() const;
+
+  ssize_t read(char* buffer, std::size_t maxBytes);
+  ssize_t write(const char* data, std::size_t dataSize);
+
+  bool hasPendingInput() const;
+  bool wantsWrite() const;
+
+  void setHttp2Offered(bool offered);
+  std::string getAlpnProtocol() const;
+
+  void setListenBinding(const std::string& address, unsigned int port);
+  const std::string& getListenAddress() const;
+  unsigned int getListenPort() const;
+
+  bool isResumed() const;
+  bool isKernelSend() const;
+  std::string getVersion() const;
+  std::string getCipher() const;
+  const std::string& getLastError() const;
+
+  void shutdown();
+
+  static int selectProtocol(SSL* ssl, const unsigned char** out,
+                            unsigned char* outLength,
+                            const unsigned char* in, unsigned int inLength,
+                            void* argument);
+
+ private:
+  TlsChannel(const TlsChannel&);
+  TlsChannel& operator=(const TlsChannel&);
+
+  ssize_t interpret(int result, const char* operation);
+
+  SSL* m_ssl;
+  std::string m_lastError;
+  bool m_established;
+  bool m_wantsWrite;
+  bool m_http2Offered;
+  std::string m_listenAddress;
+  unsigned int m_listenPort;
+};
+
+}  // namespace adapters
+}  // namespace tls
+}  // namespace infrastructure
+
+#endif  // TLS_CHANNEL_HPP
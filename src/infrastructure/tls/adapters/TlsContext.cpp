@@ -0,0 +1,154 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   TlsContext.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:24:52 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:24:52 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/tls/adapters/TlsContext.hpp"
+#include "infrastructure/tls/adapters/TlsChannel.hpp"
+#include "infrastructure/tls/exceptions/TlsException.hpp"
+
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+
+#include <string>
+
+namespace infrastructure {
+namespace tls {
+namespace adapters {
+
+namespace {
+
+typedef domain::configuration::value_objects::SslConfig SslConfig;
+typedef exceptions::TlsException TlsException;
+
+std::string describe(const std::string& path) {
+  return path + " (" + TlsException::lastLibraryError() + ")";
+}
+
+}  // namespace
+
+const long TlsContext::MIN_PROTOCOL_VERSION;
+
+TlsContext::TlsContext(const SslConfig& config)
+    : m_config(config), m_context(NULL) {
+  m_context = SSL_CTX_new(TLS_server_method());
+  if (m_context == NULL) {
+    throw TlsException(TlsException::lastLibraryError(),
+                       TlsException::CONTEXT_FAILED);
+  }
+  try {
+    SSL_CTX_set_min_proto_version(m_context, MIN_PROTOCOL_VERSION);
+    loadCertificate();
+    configureSessions();
+    configureOptions();
+    SSL_CTX_set_alpn_select_cb(m_context, TlsChannel::selectProtocol, NULL);
+  } catch (...) {
+    SSL_CTX_free(m_context);
+    m_context = NULL;
+    throw;
+  }
+}
+
+TlsContext::~TlsContext() { SSL_CTX_free(m_context); }
+
+const SslConfig& TlsContext::getConfig() const { return m_config; }
+
+SSL_CTX* TlsContext::getHandle() const { return m_context; }
+
+bool TlsContext::isKernelTlsAvailable() {
+#ifdef SSL_OP_ENABLE_KTLS
+  return true;
+#else
+  return false;
+#endif
+}
+
+void TlsContext::loadCertificate() {
+  const std::string& certificate = m_config.getCertificate();
+  const std::string& key = m_config.getCertificateKey();
+
+  if (SSL_CTX_use_certificate_chain_file(m_context, certificate.c_str()) !=
+      1) {
+    throw TlsException(describe(certificate),
+                       TlsException::CERTIFICATE_FAILED);
+  }
+  // OpenSSL 3 already compares the key with the certificate while loading.
+  if (SSL_CTX_use_PrivateKey_file(m_context, key.c_str(), SSL_FILETYPE_PEM) !=
+      1) {
+    const bool mismatch = ERR_GET_REASON(ERR_peek_last_error()) ==
+                          X509_R_KEY_VALUES_MISMATCH;
+    throw TlsException(describe(key), mismatch ? TlsException::KEY_MISMATCH
+                                               : TlsException::KEY_FAILED);
+  }
+  if (SSL_CTX_check_private_key(m_context) != 1) {
+    throw TlsException(describe(key), TlsException::KEY_MISMATCH);
+  }
+}
+
+// Sessions are tied to the certificate pair they were issued for, so a
+// session from one server is never resumed by a server with other keys.
+void TlsContext::configureSessions() {
+  const std::string identity =
+      m_config.getCertificate() + '\n' + m_config.getCertificateKey();
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  unsigned int digestLength = 0;
+  if (EVP_Digest(identity.data(), identity.size(), digest, &digestLength,
+                 EVP_sha256(), NULL) != 1 ||
+      digestLength > SSL_MAX_SID_CTX_LENGTH ||
+      SSL_CTX_set_session_id_context(m_context, digest, digestLength) != 1) {
+    throw TlsException(TlsException::lastLibraryError(),
+                       TlsException::CONTEXT_FAILED);
+  }
+
+  switch (m_config.getSessionCache()) {
+    case SslConfig::CACHE_BUILTIN:
+    case SslConfig::CACHE_SHARED:
+      SSL_CTX_set_session_cache_mode(m_context, SSL_SESS_CACHE_SERVER);
+      SSL_CTX_sess_set_cache_size(
+          m_context, static_cast<long>(m_config.getSessionCacheSessions()));
+      break;
+    case SslConfig::CACHE_NONE:
+    case SslConfig::CACHE_OFF:
+      SSL_CTX_set_session_cache_mode(m_context, SSL_SESS_CACHE_OFF);
+      break;
+  }
+  SSL_CTX_set_timeout(m_context,
+                      static_cast<long>(m_config.getSessionTimeout()));
+}
+
+// Clients that close without close_notify end the stream like any other
+// EOF. Partial writes and a moving buffer match how the connection retries a
+// send from wherever its write buffer has got to; released buffers keep
+// idle keep-alive connections small.
+void TlsContext::configureOptions() {
+  unsigned long options = SSL_OP_NO_COMPRESSION |
+                          SSL_OP_CIPHER_SERVER_PREFERENCE;
+#ifdef SSL_OP_NO_RENEGOTIATION
+  options |= SSL_OP_NO_RENEGOTIATION;
+#endif
+#ifdef SSL_OP_IGNORE_UNEXPECTED_EOF
+  options |= SSL_OP_IGNORE_UNEXPECTED_EOF;
+#endif
+#ifdef SSL_OP_ENABLE_KTLS
+  options |= SSL_OP_ENABLE_KTLS;
+#endif
+  if (!m_config.isSessionTicketsEnabled()) {
+    options |= SSL_OP_NO_TICKET;
+  }
+  SSL_CTX_set_options(m_context, options);
+  SSL_CTX_set_mode(m_context, SSL_MODE_ENABLE_PARTIAL_WRITE |
+                                  SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER |
+                                  SSL_MODE_RELEASE_BUFFERS);
+}
+
+}  // namespace adapters
+}  // namespace tls
+}  // namespace infrastructure
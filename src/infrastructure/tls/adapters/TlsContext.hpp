@@ -0,0 +1,58 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   TlsContext.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:24:52 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:24:52 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef TLS_CONTEXT_HPP
+#define TLS_CONTEXT_HPP
+
+#include "domain/configuration/value_objects/SslConfig.hpp"
+
+#include <openssl/ssl.h>
+
+namespace infrastructure {
+namespace tls {
+namespace adapters {
+
+// One SSL_CTX built from a server's ssl_* directives. The context owns the
+// certificate, the in-process session cache and the session ticket keys,
+// so keeping it alive across reloads keeps resumption working for clients
+// that connected before. Kernel TLS is requested when OpenSSL knows about
+// it; whether a connection actually got it is decided per handshake.
+class TlsContext {
+ public:
+  static const long MIN_PROTOCOL_VERSION = TLS1_2_VERSION;
+
+  explicit TlsContext(
+      const domain::configuration::value_objects::SslConfig& config);
+  ~TlsContext();
+
+  const domain::configuration::value_objects::SslConfig& getConfig() const;
+  SSL_CTX* getHandle() const;
+
+  static bool isKernelTlsAvailable();
+
+ private:
+  TlsContext(const TlsContext&);
+  TlsContext& operator=(const TlsContext&);
+
+  void loadCertificate();
+  void configureSessions();
+  void configureOptions();
+
+  domain::configuration::value_objects::SslConfig m_config;
+  SSL_CTX* m_context;
+};
+
+}  // namespace adapters
+}  // namespace tls
+}  // namespace infrastructure
+
+#endif  // TLS_CONTEXT_HPP
@@ -0,0 +1,138 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   TlsContextRegistry.cpp                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:27:31 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:27:31 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/tls/adapters/TlsContextRegistry.hpp"
+#include "infrastructure/tls/exceptions/TlsException.hpp"
+
+#include <algorithm>
+
+namespace infrastructure {
+namespace tls {
+namespace adapters {
+
+TlsContextRegistry::TlsContextRegistry() {}
+
+TlsContextRegistry::~TlsContextRegistry() { clear(); }
+
+void TlsContextRegistry::configure(const ServerList& servers) {
+  ContextList contexts;
+  ContextList created;
+  ServerContextMap byServer;
+
+  try {
+    for (std::size_t i = 0; i < servers.size(); ++i) {
+      const domain::configuration::value_objects::SslConfig& ssl =
+          servers[i]->getSslConfig();
+      if (!ssl.isConfigured()) {
+        continue;
+      }
+      TlsContext* context = findEqual(contexts, ssl);
+      if (context == NULL) {
+        context = findEqual(m_contexts, ssl);
+        if (context == NULL) {
+          context = new TlsContext(ssl);
+          created.push_back(context);
+          SSL_CTX_set_tlsext_servername_callback(context->getHandle(),
+                                                 selectServerName);
+          SSL_CTX_set_tlsext_servername_arg(context->getHandle(), this);
+        }
+        contexts.push_back(context);
+      }
+      byServer[servers[i]] = context;
+    }
+  } catch (...) {
+    for (std::size_t i = 0; i < created.size(); ++i) {
+      delete created[i];
+    }
+    throw;
+  }
+
+  for (std::size_t i = 0; i < m_contexts.size(); ++i) {
+    if (std::find(contexts.begin(), contexts.end(), m_contexts[i]) ==
+        contexts.end()) {
+      delete m_contexts[i];
+    }
+  }
+  m_contexts.swap(contexts);
+  m_byServer.swap(byServer);
+  m_selector.build(servers);
+}
+
+void TlsContextRegistry::clear() {
+  for (std::size_t i = 0; i < m_contexts.size(); ++i) {
+    delete m_contexts[i];
+  }
+  m_contexts.clear();
+  m_byServer.clear();
+  m_selector.clear();
+}
+
+const TlsContext* TlsContextRegistry::find(const ServerConfig* server) const {
+  ServerContextMap::const_iterator it = m_byServer.find(server);
+  return it != m_byServer.end() ? it->second : NULL;
+}
+
+std::size_t TlsContextRegistry::getContextCount() const {
+  return m_contexts.size();
+}
+
+TlsChannel* TlsContextRegistry::createChannel(
+    int fileDescriptor, const ServerConfig* server) const {
+  const TlsContext* context = find(server);
+  if (context == NULL) {
+    throw exceptions::TlsException("no ssl_certificate for this server",
+                                   exceptions::TlsException::CHANNEL_FAILED);
+  }
+  return new TlsChannel(fileDescriptor, context->getHandle());
+}
+
+// SNI callback installed on every context. The name only picks the
+// certificate, the request itself is still routed by Host; a client that
+// sends no name, or one no server on the socket claims, keeps the context of
+// the listener's default server.
+int TlsContextRegistry::selectServerName(SSL* ssl, int* /*alert*/,
+                                         void* argument) {
+  const TlsContextRegistry* registry =
+      static_cast<const TlsContextRegistry*>(argument);
+  const TlsChannel* channel =
+      static_cast<const TlsChannel*>(SSL_get_app_data(ssl));
+  const char* name = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name);
+  if (registry == NULL || channel == NULL || name == NULL) {
+    return SSL_TLSEXT_ERR_NOACK;
+  }
+
+  const TlsContext* context = registry->find(registry->m_selector.select(
+      name, channel->getListenAddress(), channel->getListenPort()));
+  if (context == NULL) {
+    return SSL_TLSEXT_ERR_NOACK;
+  }
+  if (context->getHandle() != SSL_get_SSL_CTX(ssl) &&
+      SSL_set_SSL_CTX(ssl, context->getHandle()) == NULL) {
+    return SSL_TLSEXT_ERR_ALERT_FATAL;
+  }
+  return SSL_TLSEXT_ERR_OK;
+}
+
+TlsContext* TlsContextRegistry::findEqual(
+    const ContextList& contexts,
+    const domain::configuration::value_objects::SslConfig& config) {
+  for (std::size_t i = 0; i < contexts.size(); ++i) {
+    if (contexts[i]->getConfig() == config) {
+      return contexts[i];
+    }
+  }
+  return NULL;
+}
+
+}  // namespace adapters
+}  // namespace tls
+}  // namespace infrastructure
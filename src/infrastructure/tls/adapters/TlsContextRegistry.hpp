@@ -0,0 +1,75 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   TlsContextRegistry.hpp                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:27:31 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:27:31 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef TLS_CONTEXT_REGISTRY_HPP
+#define TLS_CONTEXT_REGISTRY_HPP
+
+#include "domain/configuration/entities/ServerConfig.hpp"
+#include "domain/configuration/entities/ServerSelector.hpp"
+#include "infrastructure/tls/adapters/TlsChannel.hpp"
+#include "infrastructure/tls/adapters/TlsContext.hpp"
+
+#include <cstddef>
+#include <map>
+#include <vector>
+
+namespace infrastructure {
+namespace tls {
+namespace adapters {
+
+// The TLS contexts of the published configuration, one per distinct set of
+// ssl_* directives. Servers with identical settings share a context, and a
+// reload keeps every context whose settings did not change, so sessions
+// and ticket keys survive it. configure() either installs a complete new
+// set or throws and leaves the current one in place. Servers sharing a
+// listen socket are told apart by SNI: the client's server name switches the
+// handshake to the context of the server that name selects.
+class TlsContextRegistry {
+ public:
+  typedef domain::configuration::entities::ServerConfig ServerConfig;
+  typedef std::vector<const ServerConfig*> ServerList;
+
+  TlsContextRegistry();
+  ~TlsContextRegistry();
+
+  void configure(const ServerList& servers);
+  void clear();
+
+  const TlsContext* find(const ServerConfig* server) const;
+  std::size_t getContextCount() const;
+
+  TlsChannel* createChannel(int fileDescriptor,
+                            const ServerConfig* server) const;
+
+  static int selectServerName(SSL* ssl, int* alert, void* argument);
+
+ private:
+  TlsContextRegistry(const TlsContextRegistry&);
+  TlsContextRegistry& operator=(const TlsContextRegistry&);
+
+  typedef std::vector<TlsContext*> ContextList;
+  typedef std::map<const ServerConfig*, TlsContext*> ServerContextMap;
+
+  static TlsContext* findEqual(
+      const ContextList& contexts,
+      const domain::configuration::value_objects::SslConfig& config);
+
+  ContextList m_contexts;
+  ServerContextMap m_byServer;
+  domain::configuration::entities::ServerSelector m_selector;
+};
+
+}  // namespace adapters
+}  // namespace tls
+}  // namespace infrastructure
+
+#endif  // TLS_CONTEXT_REGISTRY_HPP
@@ -0,0 +1,87 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   TlsException.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:23:40 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:23:40 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "infrastructure/tls/exceptions/TlsException.hpp"
+
+#include <openssl/err.h>
+
+#include <sstream>
+
+namespace infrastructure {
+namespace tls {
+namespace exceptions {
+
+const std::pair<TlsException::ErrorCode, std::string>
+    TlsException::K_CODE_MSGS[] = {
+        std::make_pair(TlsException::CONTEXT_FAILED,
+                       "Failed to create TLS context"),
+        std::make_pair(TlsException::CERTIFICATE_FAILED,
+                       "Failed to load TLS certificate"),
+        std::make_pair(TlsException::KEY_FAILED,
+                       "Failed to load TLS certificate key"),
+        std::make_pair(TlsException::KEY_MISMATCH,
+                       "TLS certificate key does not match the certificate"),
+        std::make_pair(TlsException::CHANNEL_FAILED,
+                       "Failed to create TLS channel"),
+        std::make_pair(TlsException::HANDSHAKE_FAILED, "TLS handshake failed"),
+        std::make_pair(TlsException::IO_FAILED, "TLS record I/O failed")};
+
+TlsException::TlsException(const std::string& message, ErrorCode code)
+    : BaseException("", static_cast<int>(code)), m_code(code) {
+  std::ostringstream oss;
+  oss << getErrorMsg(code) << ": " << message;
+  this->m_whatMsg = oss.str();
+}
+
+TlsException::TlsException(const TlsException& other)
+    : BaseException(other), m_code(other.m_code) {}
+
+TlsException::~TlsException() throw() {}
+
+TlsException& TlsException::operator=(const TlsException& other) {
+  if (this != &other) {
+    BaseException::operator=(other);
+    m_code = other.m_code;
+  }
+  return *this;
+}
+
+TlsException::ErrorCode TlsException::getCode() const { return m_code; }
+
+// Drains the OpenSSL error queue of this thread, so the next failure does
+// not report a stale entry, and returns the most recent reason.
+std::string TlsException::lastLibraryError() {
+  unsigned long code = 0;
+  unsigned long last = 0;
+  while ((code = ERR_get_error()) != 0) {
+    last = code;
+  }
+  if (last == 0) {
+    return "no library error";
+  }
+  char buffer[256];
+  ERR_error_string_n(last, buffer, sizeof(buffer));
+  return buffer;
+}
+
+std::string TlsException::getErrorMsg(ErrorCode code) {
+  for (int i = 0; i < CODE_COUNT; ++i) {
+    if (K_CODE_MSGS[i].first == code) {
+      return K_CODE_MSGS[i].second;
+    }
+  }
+  return "unknown tls error";
+}
+
+}  // namespace exceptions
+}  // namespace tls
+}  // namespace infrastructure
@@ -0,0 +1,57 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   TlsException.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:23:40 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:23:40 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef TLS_EXCEPTION_HPP
+#define TLS_EXCEPTION_HPP
+
+#include "shared/exceptions/BaseException.hpp"
+
+namespace infrastructure {
+namespace tls {
+namespace exceptions {
+
+class TlsException : public ::shared::exceptions::BaseException {
+ public:
+  enum ErrorCode {
+    CONTEXT_FAILED,
+    CERTIFICATE_FAILED,
+    KEY_FAILED,
+    KEY_MISMATCH,
+    CHANNEL_FAILED,
+    HANDSHAKE_FAILED,
+    IO_FAILED,
+    CODE_COUNT
+  };
+
+  explicit TlsException(const std::string& message, ErrorCode code);
+  TlsException(const TlsException& other);
+  virtual ~TlsException() throw();
+
+  TlsException& operator=(const TlsException& other);
+
+  ErrorCode getCode() const;
+
+  static std::string lastLibraryError();
+
+ private:
+  ErrorCode m_code;
+
+  static const std::pair<ErrorCode, std::string> K_CODE_MSGS[];
+
+  static std::string getErrorMsg(ErrorCode code);
+};
+
+}  // namespace exceptions
+}  // namespace tls
+}  // namespace infrastructure
+
+#endif  // TLS_EXCEPTION_HPP
@@ -12,6 +12,8 @@
 
 #include "application/ports/IConfigProvider.hpp"
 #include "infrastructure/config/adapters/ConfigProvider.hpp"
+#include "infrastructure/config/parsers/ConfigCompiler.hpp"
+#include "infrastructure/config/parsers/ConfigParser.hpp"
 #include "infrastructure/network/adapters/SocketOrchestrator.hpp"
 #include "presentation/cli/CliController.hpp"
 #include "presentation/cli/CliView.hpp"
@@ -19,6 +21,7 @@
 
 #include <csignal>
 #include <cstdlib>
+#include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -26,6 +29,8 @@
 namespace presentation {
 namespace cli {
 
+const std::string CliController::K_COMPILE_CONFIG_FLAG = "--compile-config";
+
 CliController::CliController(CliView& view)
     : m_view(view), m_configProvider(NULL), m_orchestrator(NULL) {}
 
@@ -52,6 +57,10 @@ bool CliController::run(int argc, char** argv) {
     return false;
   }
 
+  if (argc == K_MAX_SIZE_ARGS) {
+    return compileConfiguration(argv[K_COMPILE_CONFIG_PATH_INDEX]);
+  }
+
   const std::string configPath =
       ((argv[K_LITERAL_ARGUMENT_INDEX] != 0)
            ? std::string(argv[K_LITERAL_ARGUMENT_INDEX])
@@ -76,7 +85,10 @@ bool CliController::run(int argc, char** argv) {
 }
 
 bool CliController::parseArguments(int argc, char** argv) {
-  if (argc > K_MAX_SIZE_ARGS) {
+  const bool compileFlag =
+      argc > K_LITERAL_ARGUMENT_INDEX &&
+      K_COMPILE_CONFIG_FLAG == argv[K_LITERAL_ARGUMENT_INDEX];
+  if (argc > K_MAX_SIZE_ARGS || compileFlag != (argc == K_MAX_SIZE_ARGS)) {
     this->m_view.displayUsage(std::string(argv[K_NAME_PROGRAM]));
     return false;
   }
@@ -109,6 +121,29 @@ bool CliController::loadConfiguration(const std::string& configPath) {
   }
 }
 
+// Parses and validates like a normal start, then writes the binary image that
+// later starts and reloads pick up instead of parsing.
+bool CliController::compileConfiguration(const std::string& configPath) {
+  try {
+    infrastructure::config::parsers::ConfigParser parser(m_view.getLogger());
+    std::auto_ptr<domain::configuration::entities::HttpConfig> httpConfig(
+        parser.parseFile(configPath));
+
+    infrastructure::config::parsers::ConfigCompiler compiler(
+        m_view.getLogger());
+    compiler.compile(
+        *httpConfig,
+        infrastructure::config::parsers::ConfigCompiler::compiledPathFor(
+            configPath));
+    return true;
+
+  } catch (const std::exception& exception) {
+    m_view.displayError(std::string("Configuration error: ") +
+                        exception.what());
+    return false;
+  }
+}
+
 void CliController::displayConfigurationSummary(
     const application::ports::IConfigProvider& configProvider) const {
   try {
@@ -17,6 +17,8 @@
 #include "application/ports/ISocketOrchestrator.hpp"
 #include "presentation/cli/CliView.hpp"
 
+#include <string>
+
 namespace presentation {
 namespace cli {
 
@@ -36,12 +38,15 @@ class CliController {
   application::ports::IConfigProvider* m_configProvider;
   application::ports::ISocketOrchestrator* m_orchestrator;
 
-  static const int K_MAX_SIZE_ARGS = 2;
+  static const int K_MAX_SIZE_ARGS = 3;
   static const int K_NAME_PROGRAM = 0;
   static const int K_LITERAL_ARGUMENT_INDEX = 1;
+  static const int K_COMPILE_CONFIG_PATH_INDEX = 2;
+  static const std::string K_COMPILE_CONFIG_FLAG;
 
   bool parseArguments(int argc, char** argv);
   bool loadConfiguration(const std::string& configPath);
+  bool compileConfiguration(const std::string& configPath);
   void displayConfigurationSummary(
       const application::ports::IConfigProvider& configProvider) const;
   bool startServer();
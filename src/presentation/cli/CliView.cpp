@@ -30,7 +30,8 @@ CliView& CliView::operator=(const CliView& other) {
 }
 
 void CliView::displayUsage(const std::string& programName) const {
-  this->m_logger.error("Usage: " + programName + " <config_file>");
+  this->m_logger.error("Usage: " + programName +
+                       " [--compile-config] <config_file>");
 }
 
 void CliView::displayError(const std::string& str) const {
@@ -17,11 +17,14 @@ namespace shared {
 namespace utils {
 
 volatile sig_atomic_t SignalHandler::s_shutdownRequested = 0;
+volatile sig_atomic_t SignalHandler::s_reloadRequested = 0;
 bool SignalHandler::s_initialized = false;
 
 extern "C" void handleSignal(int signal) {
   if (signal == SIGINT || signal == SIGTERM || signal == SIGQUIT) {
     SignalHandler::s_shutdownRequested = 1;
+  } else if (signal == SIGHUP) {
+    SignalHandler::s_reloadRequested = 1;
   }
 }
 
@@ -30,9 +33,11 @@ void SignalHandler::initialize() {
   std::signal(SIGINT, handleSignal);
   std::signal(SIGTERM, handleSignal);
   std::signal(SIGQUIT, handleSignal);
+  std::signal(SIGHUP, handleSignal);
   std::signal(SIGPIPE, SIG_IGN);
   s_initialized = true;
   s_shutdownRequested = 0;
+  s_reloadRequested = 0;
 }
 
 void SignalHandler::cleanup() {
@@ -40,9 +45,11 @@ void SignalHandler::cleanup() {
   std::signal(SIGINT, SIG_DFL);
   std::signal(SIGTERM, SIG_DFL);
   std::signal(SIGQUIT, SIG_DFL);
+  std::signal(SIGHUP, SIG_DFL);
   std::signal(SIGPIPE, SIG_DFL);
   s_initialized = false;
   s_shutdownRequested = 0;
+  s_reloadRequested = 0;
 }
 
 bool SignalHandler::isShutdownRequested() {
@@ -57,6 +64,14 @@ volatile sig_atomic_t* SignalHandler::getShutdownFlagPtr() {
   return &s_shutdownRequested;
 }
 
+bool SignalHandler::isReloadRequested() {
+  return s_reloadRequested != 0;
+}
+
+void SignalHandler::resetReloadFlag() {
+  s_reloadRequested = 0;
+}
+
 SignalHandler::SignalHandler() {}
 SignalHandler::~SignalHandler() {}
 
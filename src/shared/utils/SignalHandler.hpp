@@ -25,8 +25,11 @@ class SignalHandler {
   static bool isShutdownRequested();
   static void resetShutdownFlag();
   static volatile sig_atomic_t* getShutdownFlagPtr();
+  static bool isReloadRequested();
+  static void resetReloadFlag();
 
   static volatile sig_atomic_t s_shutdownRequested;
+  static volatile sig_atomic_t s_reloadRequested;
 
  private:
   SignalHandler();
@@ -0,0 +1,57 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   AllocationCounter.cpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 05:22:09 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 05:22:09 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "AllocationCounter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+namespace bench {
+
+unsigned long AllocationCounter::s_count = 0;
+unsigned long AllocationCounter::s_bytes = 0;
+
+unsigned long AllocationCounter::getCount() { return s_count; }
+
+unsigned long AllocationCounter::getBytes() { return s_bytes; }
+
+void AllocationCounter::record(std::size_t size) {
+  ++s_count;
+  s_bytes += size;
+}
+
+}  // namespace bench
+
+namespace {
+
+void* allocate(std::size_t size) {
+  bench::AllocationCounter::record(size);
+  void* memory = std::malloc(size == 0 ? 1 : size);
+  if (memory == NULL) {
+    throw std::bad_alloc();
+  }
+  return memory;
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) throw(std::bad_alloc) {
+  return allocate(size);
+}
+
+void* operator new[](std::size_t size) throw(std::bad_alloc) {
+  return allocate(size);
+}
+
+void operator delete(void* memory) throw() { std::free(memory); }
+
+void operator delete[](void* memory) throw() { std::free(memory); }
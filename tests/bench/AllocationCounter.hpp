@@ -0,0 +1,38 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   AllocationCounter.hpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 05:22:09 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 05:22:09 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#include <cstddef>
+
+namespace bench {
+
+// Totals kept by the replacement global operator new in
+// AllocationCounter.cpp; linking that file into a binary counts every heap
+// allocation it makes.
+class AllocationCounter {
+ public:
+  static unsigned long getCount();
+  static unsigned long getBytes();
+  static void record(std::size_t size);
+
+ private:
+  static unsigned long s_count;
+  static unsigned long s_bytes;
+
+  AllocationCounter();
+};
+
+}  // namespace bench
+
+#endif  // ALLOCATION_COUNTER_HPP
@@ -0,0 +1,144 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   BenchScenario.cpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 03:58:06 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 03:58:06 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "BenchScenario.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace bench {
+
+namespace {
+
+const char K_LARGE_FILE_NAME[] = "webserv_bench_large.bin";
+const char K_UPLOAD_DIRECTORY[] = "uploads";
+const char K_UPLOAD_FILE_NAME[] = "webserv_bench_upload.txt";
+const char K_BOUNDARY[] = "webservbenchboundary7MA4YWxkTrZu0gW";
+const int K_STATUS_OK = 200;
+const int K_STATUS_CREATED = 201;
+const int K_STATUS_NOT_FOUND = 404;
+const std::size_t K_PATTERN_PERIOD = 26;
+
+}  // namespace
+
+const std::size_t ScenarioCatalog::K_LARGE_FILE_BYTES;
+const std::size_t ScenarioCatalog::K_UPLOAD_BYTES;
+const std::size_t ScenarioCatalog::K_MISSING_PATHS;
+
+ScenarioCatalog::ScenarioCatalog(const std::string& documentRoot,
+                                 const std::string& host)
+    : m_documentRoot(documentRoot), m_host(host) {
+  add("small_static", "GET a small HTML page",
+      std::vector<std::string>(1, get("/index.html")), K_STATUS_OK);
+
+  add("large_static", "GET a 1 MiB file",
+      std::vector<std::string>(1, get(std::string("/") + K_LARGE_FILE_NAME)),
+      K_STATUS_OK);
+
+  std::vector<std::string> missing;
+  for (std::size_t i = 0; i < K_MISSING_PATHS; ++i) {
+    std::ostringstream target;
+    target << "/webserv_bench_missing_" << i << ".html";
+    missing.push_back(get(target.str()));
+  }
+  add("not_found", "GET paths that do not exist", missing, K_STATUS_NOT_FOUND);
+
+  add("directory_listing", "GET an autoindex page",
+      std::vector<std::string>(1, get("/uploads/")), K_STATUS_OK);
+
+  add("cgi", "GET a Python CGI script",
+      std::vector<std::string>(1, get("/api/env_dump.py")), K_STATUS_OK);
+
+  add("upload", "POST a 4 KiB multipart/form-data file",
+      std::vector<std::string>(1, multipartPost("/uploads")),
+      K_STATUS_CREATED);
+}
+
+const std::vector<BenchScenario>& ScenarioCatalog::getScenarios() const {
+  return m_scenarios;
+}
+
+const BenchScenario* ScenarioCatalog::find(const std::string& name) const {
+  for (std::size_t i = 0; i < m_scenarios.size(); ++i) {
+    if (m_scenarios[i].name == name) {
+      return &m_scenarios[i];
+    }
+  }
+  return NULL;
+}
+
+bool ScenarioCatalog::prepareFixtures() const {
+  std::ofstream file(largeFilePath().c_str(), std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  std::string block(K_LARGE_FILE_BYTES, 'x');
+  for (std::size_t i = 0; i < block.size(); ++i) {
+    block[i] = static_cast<char>('a' + i % K_PATTERN_PERIOD);
+  }
+  file.write(block.data(), static_cast<std::streamsize>(block.size()));
+  return file.good();
+}
+
+void ScenarioCatalog::removeFixtures() const {
+  std::remove(largeFilePath().c_str());
+  std::remove(uploadedFilePath().c_str());
+}
+
+void ScenarioCatalog::add(const std::string& name,
+                          const std::string& description,
+                          const std::vector<std::string>& requests,
+                          int expectedStatus) {
+  BenchScenario scenario;
+  scenario.name = name;
+  scenario.description = description;
+  scenario.requests = requests;
+  scenario.expectedStatus = expectedStatus;
+  m_scenarios.push_back(scenario);
+}
+
+std::string ScenarioCatalog::get(const std::string& target) const {
+  return "GET " + target + " HTTP/1.1\r\nHost: " + m_host +
+         "\r\nUser-Agent: webserv_bench\r\n\r\n";
+}
+
+std::string ScenarioCatalog::multipartPost(const std::string& target) const {
+  std::ostringstream body;
+  body << "--" << K_BOUNDARY << "\r\n"
+       << "Content-Disposition: form-data; name=\"file\"; filename=\""
+       << K_UPLOAD_FILE_NAME << "\"\r\n"
+       << "Content-Type: text/plain\r\n\r\n"
+       << std::string(K_UPLOAD_BYTES, 'u') << "\r\n"
+       << "--" << K_BOUNDARY << "--\r\n";
+  const std::string payload = body.str();
+
+  std::ostringstream request;
+  request << "POST " << target << " HTTP/1.1\r\n"
+          << "Host: " << m_host << "\r\n"
+          << "User-Agent: webserv_bench\r\n"
+          << "Content-Type: multipart/form-data; boundary=" << K_BOUNDARY
+          << "\r\n"
+          << "Content-Length: " << payload.size() << "\r\n\r\n"
+          << payload;
+  return request.str();
+}
+
+std::string ScenarioCatalog::largeFilePath() const {
+  return m_documentRoot + "/" + K_LARGE_FILE_NAME;
+}
+
+std::string ScenarioCatalog::uploadedFilePath() const {
+  return m_documentRoot + "/" + K_UPLOAD_DIRECTORY + "/" + K_UPLOAD_FILE_NAME;
+}
+
+}  // namespace bench
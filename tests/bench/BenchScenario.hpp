@@ -0,0 +1,63 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   BenchScenario.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 03:58:06 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 03:58:06 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef BENCH_SCENARIO_HPP
+#define BENCH_SCENARIO_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+struct BenchScenario {
+  std::string name;
+  std::string description;
+  std::vector<std::string> requests;
+  int expectedStatus;
+};
+
+// The canned workloads, written against the layout of
+// conf/webserv_combined_cgi.conf: static files under the document root,
+// autoindex and uploads under /uploads, and Python CGI under /api. The
+// catalog creates the large fixture file before a run and removes it and
+// the uploaded file afterwards.
+class ScenarioCatalog {
+ public:
+  static const std::size_t K_LARGE_FILE_BYTES = 1024 * 1024;
+  static const std::size_t K_UPLOAD_BYTES = 4 * 1024;
+  static const std::size_t K_MISSING_PATHS = 16;
+
+  ScenarioCatalog(const std::string& documentRoot, const std::string& host);
+
+  const std::vector<BenchScenario>& getScenarios() const;
+  const BenchScenario* find(const std::string& name) const;
+
+  bool prepareFixtures() const;
+  void removeFixtures() const;
+
+ private:
+  std::string m_documentRoot;
+  std::string m_host;
+  std::vector<BenchScenario> m_scenarios;
+
+  void add(const std::string& name, const std::string& description,
+           const std::vector<std::string>& requests, int expectedStatus);
+  std::string get(const std::string& target) const;
+  std::string multipartPost(const std::string& target) const;
+  std::string largeFilePath() const;
+  std::string uploadedFilePath() const;
+};
+
+}  // namespace bench
+
+#endif  // BENCH_SCENARIO_HPP
@@ -0,0 +1,635 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   LoadGenerator.cpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 03:34:18 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 03:34:18 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "LoadGenerator.hpp"
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace bench {
+
+namespace {
+
+const std::size_t K_READ_CHUNK = 64 * 1024;
+const int K_MAX_EVENTS = 256;
+const int K_IDLE_WAIT_MS = 10;
+const unsigned long K_MICROS_PER_SECOND = 1000000UL;
+const unsigned long K_MICROS_PER_MILLI = 1000UL;
+const unsigned long K_STALL_CHECK_MICROS = 100000UL;
+const std::size_t K_NPOS = static_cast<std::size_t>(-1);
+const int K_HTTP_STATUS_DIGITS = 3;
+const int K_DECIMAL = 10;
+const int K_HEX = 16;
+
+const char K_HEADER_END[] = "\r\n\r\n";
+const char K_LINE_END[] = "\r\n";
+
+std::string toLower(const std::string& value) {
+  std::string folded(value);
+  for (std::size_t i = 0; i < folded.size(); ++i) {
+    if (folded[i] >= 'A' && folded[i] <= 'Z') {
+      folded[i] = static_cast<char>(folded[i] - 'A' + 'a');
+    }
+  }
+  return folded;
+}
+
+std::string trim(const std::string& value) {
+  const std::size_t first = value.find_first_not_of(" \t");
+  if (first == std::string::npos) {
+    return "";
+  }
+  const std::size_t last = value.find_last_not_of(" \t");
+  return value.substr(first, last - first + 1);
+}
+
+}  // namespace
+
+LoadOptions::LoadOptions()
+    : host("127.0.0.1"),
+      port(8080),
+      connections(16),
+      pipeline(1),
+      durationSeconds(5),
+      requestsPerSecond(0),
+      timeoutSeconds(5) {}
+
+LoadResult::LoadResult()
+    : requests(0),
+      unexpectedStatus(0),
+      connectErrors(0),
+      ioErrors(0),
+      timeouts(0),
+      bytesReceived(0),
+      elapsedSeconds(0) {}
+
+LoadGenerator::Connection::Connection()
+    : fd(-1),
+      connecting(false),
+      outputOffset(0),
+      headerDone(false),
+      status(0),
+      bodyMode(BODY_NONE),
+      bodyStart(0),
+      bodyRemaining(0),
+      chunkCursor(0),
+      closeAfter(false),
+      responseEnd(0),
+      events(0),
+      lastActivity(0) {}
+
+LoadGenerator::LoadGenerator(const LoadOptions& options,
+                             const std::vector<std::string>& requests,
+                             int expectedStatus)
+    : m_options(options),
+      m_requests(requests),
+      m_expectedStatus(expectedStatus),
+      m_epollFd(-1),
+      m_nextRequest(0),
+      m_nextConnection(0),
+      m_accepting(false) {
+  std::memset(&m_address, 0, sizeof(m_address));
+  if (m_options.connections == 0) {
+    m_options.connections = 1;
+  }
+  if (m_options.pipeline == 0) {
+    m_options.pipeline = 1;
+  }
+}
+
+LoadGenerator::~LoadGenerator() {
+  for (std::size_t i = 0; i < m_connections.size(); ++i) {
+    if (m_connections[i].fd >= 0) {
+      ::close(m_connections[i].fd);
+    }
+  }
+  if (m_epollFd >= 0) {
+    ::close(m_epollFd);
+  }
+}
+
+unsigned long LoadGenerator::nowMicros() {
+  struct timeval now;
+  ::gettimeofday(&now, NULL);
+  return static_cast<unsigned long>(now.tv_sec) * K_MICROS_PER_SECOND +
+         static_cast<unsigned long>(now.tv_usec);
+}
+
+LoadResult LoadGenerator::run() {
+  m_result = LoadResult();
+  if (m_requests.empty() || !resolveAddress()) {
+    ++m_result.connectErrors;
+    return m_result;
+  }
+  m_epollFd = ::epoll_create(K_MAX_EVENTS);
+  if (m_epollFd < 0) {
+    ++m_result.ioErrors;
+    return m_result;
+  }
+
+  const bool openLoop = m_options.requestsPerSecond > 0;
+  const unsigned long start = nowMicros();
+  const unsigned long deadline =
+      start + static_cast<unsigned long>(m_options.durationSeconds *
+                                              K_MICROS_PER_SECOND);
+  const unsigned long timeout = static_cast<unsigned long>(
+      m_options.timeoutSeconds * K_MICROS_PER_SECOND);
+  const double interval =
+      openLoop ? K_MICROS_PER_SECOND / m_options.requestsPerSecond : 0;
+  double nextDue = static_cast<double>(start);
+  unsigned long nextStallCheck = start + K_STALL_CHECK_MICROS;
+
+  m_accepting = true;
+  m_connections.assign(m_options.connections, Connection());
+  for (std::size_t i = 0; i < m_connections.size(); ++i) {
+    openConnection(i);
+  }
+
+  struct epoll_event events[K_MAX_EVENTS];
+  unsigned long now = start;
+  while (true) {
+    now = nowMicros();
+    if (now >= deadline) {
+      m_accepting = false;
+      if (!hasInFlight() || now >= deadline + timeout) {
+        break;
+      }
+    }
+
+    int waitMs = K_IDLE_WAIT_MS;
+    if (openLoop && m_accepting) {
+      while (nextDue <= static_cast<double>(now)) {
+        m_backlog.push_back(static_cast<unsigned long>(nextDue));
+        nextDue += interval;
+      }
+      dispatchBacklog();
+      const double untilDue =
+          (nextDue - static_cast<double>(now)) / K_MICROS_PER_MILLI;
+      waitMs = untilDue < K_IDLE_WAIT_MS ? static_cast<int>(untilDue)
+                                         : K_IDLE_WAIT_MS;
+    }
+
+    const int ready = ::epoll_wait(m_epollFd, events, K_MAX_EVENTS, waitMs);
+    for (int i = 0; i < ready; ++i) {
+      const std::size_t index = events[i].data.u32;
+      if (index >= m_connections.size() || m_connections[index].fd < 0) {
+        continue;
+      }
+      if (m_connections[index].connecting) {
+        finishConnect(index);
+        continue;
+      }
+      if ((events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0) {
+        receive(index);
+      }
+      if (m_connections[index].fd >= 0 &&
+          (events[i].events & EPOLLOUT) != 0) {
+        flush(index);
+      }
+    }
+
+    if (now >= nextStallCheck) {
+      expireStalled(now);
+      nextStallCheck = now + K_STALL_CHECK_MICROS;
+    }
+  }
+
+  for (std::size_t i = 0; i < m_connections.size(); ++i) {
+    m_result.timeouts += m_connections[i].inFlight.size();
+    m_connections[i].inFlight.clear();
+    closeConnection(i, false);
+  }
+  m_result.timeouts += m_backlog.size();
+  m_backlog.clear();
+  m_result.elapsedSeconds =
+      static_cast<double>(now - start) / K_MICROS_PER_SECOND;
+  return m_result;
+}
+
+bool LoadGenerator::resolveAddress() {
+  struct addrinfo hints;
+  std::memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+
+  struct addrinfo* found = NULL;
+  if (::getaddrinfo(m_options.host.c_str(), NULL, &hints, &found) != 0 ||
+      found == NULL) {
+    return false;
+  }
+  std::memcpy(&m_address, found->ai_addr, sizeof(m_address));
+  m_address.sin_port = htons(static_cast<unsigned short>(m_options.port));
+  ::freeaddrinfo(found);
+  return true;
+}
+
+void LoadGenerator::openConnection(std::size_t index) {
+  Connection& connection = m_connections[index];
+  connection.lastActivity = nowMicros();
+
+  const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) {
+    ++m_result.connectErrors;
+    return;
+  }
+  const int enable = 1;
+  ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+  ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+  if (::connect(fd, reinterpret_cast<struct sockaddr*>(&m_address),
+                sizeof(m_address)) < 0 &&
+      errno != EINPROGRESS) {
+    ::close(fd);
+    ++m_result.connectErrors;
+    return;
+  }
+
+  struct epoll_event event;
+  std::memset(&event, 0, sizeof(event));
+  event.events = EPOLLIN | EPOLLOUT;
+  event.data.u32 = static_cast<unsigned int>(index);
+  if (::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+    ::close(fd);
+    ++m_result.ioErrors;
+    return;
+  }
+  connection.fd = fd;
+  connection.connecting = true;
+  connection.events = event.events;
+}
+
+void LoadGenerator::finishConnect(std::size_t index) {
+  Connection& connection = m_connections[index];
+  int error = 0;
+  socklen_t length = sizeof(error);
+  if (::getsockopt(connection.fd, SOL_SOCKET, SO_ERROR, &error, &length) < 0 ||
+      error != 0) {
+    ++m_result.connectErrors;
+    closeConnection(index, true);
+    return;
+  }
+  connection.connecting = false;
+  connection.lastActivity = nowMicros();
+  refill(index);
+  flush(index);
+}
+
+// Requests still waiting for an answer go back to the backlog with their
+// original due time, so a dropped connection costs latency, not samples.
+void LoadGenerator::closeConnection(std::size_t index, bool requeue) {
+  Connection& connection = m_connections[index];
+  if (connection.fd >= 0) {
+    ::epoll_ctl(m_epollFd, EPOLL_CTL_DEL, connection.fd, NULL);
+    ::close(connection.fd);
+  }
+  if (requeue) {
+    while (!connection.inFlight.empty()) {
+      m_backlog.push_front(connection.inFlight.back());
+      connection.inFlight.pop_back();
+    }
+  }
+  const unsigned long lastActivity = connection.lastActivity;
+  connection = Connection();
+  connection.lastActivity = lastActivity;
+}
+
+void LoadGenerator::reconnect(std::size_t index) {
+  closeConnection(index, true);
+  if (m_accepting || !m_backlog.empty()) {
+    openConnection(index);
+  }
+}
+
+void LoadGenerator::watch(std::size_t index, bool wantsWrite) {
+  Connection& connection = m_connections[index];
+  const unsigned int events =
+      EPOLLIN | (wantsWrite ? static_cast<unsigned int>(EPOLLOUT) : 0u);
+  if (connection.fd < 0 || connection.events == events) {
+    return;
+  }
+  struct epoll_event event;
+  std::memset(&event, 0, sizeof(event));
+  event.events = events;
+  event.data.u32 = static_cast<unsigned int>(index);
+  ::epoll_ctl(m_epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+  connection.events = events;
+}
+
+void LoadGenerator::enqueue(std::size_t index, unsigned long dueMicros) {
+  Connection& connection = m_connections[index];
+  connection.output += m_requests[m_nextRequest % m_requests.size()];
+  ++m_nextRequest;
+  if (connection.inFlight.empty()) {
+    connection.lastActivity = nowMicros();
+  }
+  connection.inFlight.push_back(dueMicros);
+}
+
+void LoadGenerator::flush(std::size_t index) {
+  Connection& connection = m_connections[index];
+  while (connection.outputOffset < connection.output.size()) {
+    const ssize_t written =
+        ::send(connection.fd, connection.output.data() + connection.outputOffset,
+               connection.output.size() - connection.outputOffset,
+               MSG_NOSIGNAL);
+    if (written < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        watch(index, true);
+        return;
+      }
+      ++m_result.ioErrors;
+      reconnect(index);
+      return;
+    }
+    connection.outputOffset += static_cast<std::size_t>(written);
+  }
+  connection.output.clear();
+  connection.outputOffset = 0;
+  watch(index, false);
+}
+
+void LoadGenerator::receive(std::size_t index) {
+  char buffer[K_READ_CHUNK];
+  bool atEof = false;
+
+  while (true) {
+    const ssize_t received =
+        ::recv(m_connections[index].fd, buffer, sizeof(buffer), 0);
+    if (received > 0) {
+      m_connections[index].input.append(buffer,
+                                        static_cast<std::size_t>(received));
+      m_result.bytesReceived += static_cast<unsigned long>(received);
+      continue;
+    }
+    if (received == 0) {
+      atEof = true;
+    } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+      ++m_result.ioErrors;
+      atEof = true;
+    }
+    break;
+  }
+
+  m_connections[index].lastActivity = nowMicros();
+  while (m_connections[index].fd >= 0 &&
+         !m_connections[index].inFlight.empty() &&
+         parseResponse(m_connections[index], atEof)) {
+    completeResponse(index);
+  }
+  if (atEof && m_connections[index].fd >= 0) {
+    reconnect(index);
+  }
+}
+
+bool LoadGenerator::parseResponse(Connection& connection, bool atEof) {
+  if (!connection.headerDone && !parseHeader(connection)) {
+    return false;
+  }
+
+  switch (connection.bodyMode) {
+    case BODY_NONE:
+      connection.responseEnd = connection.bodyStart;
+      return true;
+    case BODY_LENGTH:
+      if (connection.input.size() - connection.bodyStart <
+          connection.bodyRemaining) {
+        return false;
+      }
+      connection.responseEnd = connection.bodyStart + connection.bodyRemaining;
+      return true;
+    case BODY_CHUNKED:
+      return skipChunks(connection);
+    case BODY_UNTIL_CLOSE:
+      connection.responseEnd = connection.input.size();
+      return atEof;
+  }
+  return false;
+}
+
+bool LoadGenerator::parseHeader(Connection& connection) {
+  const std::size_t headerEnd = connection.input.find(K_HEADER_END);
+  if (headerEnd == std::string::npos) {
+    return false;
+  }
+
+  const std::size_t statusLineEnd = connection.input.find(K_LINE_END);
+  const std::string statusLine = connection.input.substr(0, statusLineEnd);
+  const std::size_t space = statusLine.find(' ');
+  connection.status =
+      space == std::string::npos
+          ? 0
+          : std::atoi(statusLine.substr(space + 1, K_HTTP_STATUS_DIGITS).c_str());
+  connection.closeAfter = statusLine.compare(0, 8, "HTTP/1.0") == 0;
+
+  bool hasLength = false;
+  bool chunked = false;
+  std::size_t length = 0;
+  std::size_t lineStart = statusLineEnd + 2;
+  while (lineStart < headerEnd) {
+    const std::size_t lineEnd = connection.input.find(K_LINE_END, lineStart);
+    const std::string line =
+        connection.input.substr(lineStart, lineEnd - lineStart);
+    lineStart = lineEnd + 2;
+
+    const std::size_t colon = line.find(':');
+    if (colon == std::string::npos) {
+      continue;
+    }
+    const std::string name = toLower(trim(line.substr(0, colon)));
+    const std::string value = toLower(trim(line.substr(colon + 1)));
+    if (name == "content-length") {
+      hasLength = true;
+      length = static_cast<std::size_t>(
+          std::strtoul(value.c_str(), NULL, K_DECIMAL));
+    } else if (name == "transfer-encoding") {
+      chunked = value.find("chunked") != std::string::npos;
+    } else if (name == "connection") {
+      if (value.find("close") != std::string::npos) {
+        connection.closeAfter = true;
+      } else if (value.find("keep-alive") != std::string::npos) {
+        connection.closeAfter = false;
+      }
+    }
+  }
+
+  connection.headerDone = true;
+  connection.bodyStart = headerEnd + 4;
+  connection.chunkCursor = connection.bodyStart;
+  if (connection.status < 200 || connection.status == 204 ||
+      connection.status == 304) {
+    connection.bodyMode = BODY_NONE;
+  } else if (chunked) {
+    connection.bodyMode = BODY_CHUNKED;
+  } else if (hasLength) {
+    connection.bodyMode = BODY_LENGTH;
+    connection.bodyRemaining = length;
+  } else {
+    connection.bodyMode = BODY_UNTIL_CLOSE;
+    connection.closeAfter = true;
+  }
+  return true;
+}
+
+bool LoadGenerator::skipChunks(Connection& connection) {
+  while (true) {
+    const std::size_t lineEnd =
+        connection.input.find(K_LINE_END, connection.chunkCursor);
+    if (lineEnd == std::string::npos) {
+      return false;
+    }
+    const std::size_t size = static_cast<std::size_t>(std::strtoul(
+        connection.input.c_str() + connection.chunkCursor, NULL, K_HEX));
+    if (size == 0) {
+      const std::size_t trailerEnd =
+          connection.input.compare(lineEnd, 4, K_HEADER_END) == 0
+              ? lineEnd
+              : connection.input.find(K_HEADER_END, lineEnd);
+      if (trailerEnd == std::string::npos) {
+        return false;
+      }
+      connection.responseEnd = trailerEnd + 4;
+      return true;
+    }
+    const std::size_t next = lineEnd + 2 + size + 2;
+    if (next > connection.input.size()) {
+      return false;
+    }
+    connection.chunkCursor = next;
+  }
+}
+
+void LoadGenerator::completeResponse(std::size_t index) {
+  Connection& connection = m_connections[index];
+  const unsigned long now = nowMicros();
+  const unsigned long due = connection.inFlight.front();
+  connection.inFlight.pop_front();
+
+  ++m_result.requests;
+  ++m_result.statusCounts[connection.status];
+  if (m_expectedStatus != 0 && connection.status != m_expectedStatus) {
+    ++m_result.unexpectedStatus;
+  }
+  m_result.latencyMicros.record(
+      static_cast<unsigned long>(now > due ? now - due : 0));
+
+  connection.input.erase(0, connection.responseEnd);
+  const bool closeAfter = connection.closeAfter;
+  resetResponse(connection);
+
+  if (closeAfter) {
+    reconnect(index);
+  } else {
+    refill(index);
+  }
+}
+
+void LoadGenerator::resetResponse(Connection& connection) {
+  connection.headerDone = false;
+  connection.status = 0;
+  connection.bodyMode = BODY_NONE;
+  connection.bodyStart = 0;
+  connection.bodyRemaining = 0;
+  connection.chunkCursor = 0;
+  connection.closeAfter = false;
+  connection.responseEnd = 0;
+}
+
+// Closed loop tops the connection back up to the pipeline depth; open loop
+// only hands out requests the schedule has already made due.
+void LoadGenerator::refill(std::size_t index) {
+  dispatchBacklog();
+  Connection& connection = m_connections[index];
+  if (connection.fd < 0 || connection.connecting) {
+    return;
+  }
+  if (m_options.requestsPerSecond <= 0 && m_accepting) {
+    const unsigned long now = nowMicros();
+    while (connection.inFlight.size() < m_options.pipeline) {
+      enqueue(index, now);
+    }
+  }
+  if (connection.outputOffset < connection.output.size()) {
+    flush(index);
+  }
+}
+
+void LoadGenerator::dispatchBacklog() {
+  while (!m_backlog.empty()) {
+    const std::size_t index = pickConnection();
+    if (index == K_NPOS) {
+      return;
+    }
+    enqueue(index, m_backlog.front());
+    m_backlog.pop_front();
+    flush(index);
+  }
+}
+
+std::size_t LoadGenerator::pickConnection() {
+  for (std::size_t tried = 0; tried < m_connections.size(); ++tried) {
+    const std::size_t index = m_nextConnection;
+    m_nextConnection = (m_nextConnection + 1) % m_connections.size();
+    const Connection& connection = m_connections[index];
+    if (connection.fd >= 0 && !connection.connecting &&
+        connection.inFlight.size() < m_options.pipeline) {
+      return index;
+    }
+  }
+  return K_NPOS;
+}
+
+void LoadGenerator::expireStalled(unsigned long now) {
+  const unsigned long timeout = static_cast<unsigned long>(
+      m_options.timeoutSeconds * K_MICROS_PER_SECOND);
+  for (std::size_t i = 0; i < m_connections.size(); ++i) {
+    Connection& connection = m_connections[i];
+    const bool waiting = !connection.inFlight.empty() || connection.connecting;
+    if (!waiting || now < connection.lastActivity + timeout) {
+      continue;
+    }
+    m_result.timeouts += connection.inFlight.size();
+    connection.inFlight.clear();
+    closeConnection(i, false);
+    if (m_accepting) {
+      openConnection(i);
+    }
+  }
+  for (std::size_t i = 0; i < m_connections.size() && m_accepting; ++i) {
+    if (m_connections[i].fd < 0 &&
+        now >= m_connections[i].lastActivity + K_STALL_CHECK_MICROS) {
+      openConnection(i);
+    }
+  }
+}
+
+bool LoadGenerator::hasInFlight() const {
+  if (!m_backlog.empty()) {
+    return true;
+  }
+  for (std::size_t i = 0; i < m_connections.size(); ++i) {
+    if (!m_connections[i].inFlight.empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace bench
@@ -0,0 +1,131 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   LoadGenerator.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 03:34:18 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 03:34:18 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef LOAD_GENERATOR_HPP
+#define LOAD_GENERATOR_HPP
+
+#include "domain/shared/utils/LatencyHistogram.hpp"
+
+#include <netinet/in.h>
+
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+struct LoadOptions {
+  LoadOptions();
+
+  std::string host;
+  unsigned int port;
+  std::size_t connections;
+  std::size_t pipeline;
+  double durationSeconds;
+  double requestsPerSecond;
+  double timeoutSeconds;
+};
+
+struct LoadResult {
+  LoadResult();
+
+  unsigned long requests;
+  unsigned long unexpectedStatus;
+  unsigned long connectErrors;
+  unsigned long ioErrors;
+  unsigned long timeouts;
+  unsigned long bytesReceived;
+  double elapsedSeconds;
+  std::map<int, unsigned long> statusCounts;
+  domain::shared::utils::LatencyHistogram latencyMicros;
+};
+
+// Drives keep-alive connections from a single epoll loop. Closed loop keeps
+// `pipeline` requests in flight on every connection; open loop issues
+// requests on a fixed schedule and measures each one from the moment it was
+// due, so a stalled server shows up in the tail instead of slowing the
+// client down with it.
+class LoadGenerator {
+ public:
+  LoadGenerator(const LoadOptions& options,
+                const std::vector<std::string>& requests, int expectedStatus);
+  ~LoadGenerator();
+
+  LoadResult run();
+
+  static unsigned long nowMicros();
+
+ private:
+  enum BodyMode { BODY_NONE, BODY_LENGTH, BODY_CHUNKED, BODY_UNTIL_CLOSE };
+
+  struct Connection {
+    Connection();
+
+    int fd;
+    bool connecting;
+    std::string output;
+    std::size_t outputOffset;
+    std::string input;
+    std::deque<unsigned long> inFlight;
+    bool headerDone;
+    int status;
+    BodyMode bodyMode;
+    std::size_t bodyStart;
+    std::size_t bodyRemaining;
+    std::size_t chunkCursor;
+    bool closeAfter;
+    std::size_t responseEnd;
+    unsigned int events;
+    unsigned long lastActivity;
+  };
+
+  LoadOptions m_options;
+  std::vector<std::string> m_requests;
+  int m_expectedStatus;
+  int m_epollFd;
+  sockaddr_in m_address;
+  std::vector<Connection> m_connections;
+  std::deque<unsigned long> m_backlog;
+  std::size_t m_nextRequest;
+  std::size_t m_nextConnection;
+  bool m_accepting;
+  LoadResult m_result;
+
+  bool resolveAddress();
+  void openConnection(std::size_t index);
+  void closeConnection(std::size_t index, bool requeue);
+  void reconnect(std::size_t index);
+  void finishConnect(std::size_t index);
+  void watch(std::size_t index, bool wantsWrite);
+  void enqueue(std::size_t index, unsigned long dueMicros);
+  void flush(std::size_t index);
+  void receive(std::size_t index);
+  bool parseResponse(Connection& connection, bool atEof);
+  bool parseHeader(Connection& connection);
+  bool skipChunks(Connection& connection);
+  void completeResponse(std::size_t index);
+  void resetResponse(Connection& connection);
+  void refill(std::size_t index);
+  void dispatchBacklog();
+  void expireStalled(unsigned long now);
+  std::size_t pickConnection();
+  bool hasInFlight() const;
+
+  LoadGenerator(const LoadGenerator&);
+  LoadGenerator& operator=(const LoadGenerator&);
+};
+
+}  // namespace bench
+
+#endif  // LOAD_GENERATOR_HPP
@@ -0,0 +1,230 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   MicroBenchmark.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 05:07:21 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 05:07:21 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MicroBenchmark.hpp"
+#include "AllocationCounter.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <time.h>
+
+namespace {
+
+volatile std::size_t g_sink = 0;
+
+const double K_NANOS_PER_SECOND = 1e9;
+const double K_GROWTH_HEADROOM = 1.4;
+const double K_MAX_GROWTH = 10;
+const double K_MIN_GROWTH = 2;
+const double K_ALLOC_TOLERANCE = 0.05;
+const double K_ALLOC_TOLERANCE_RATIO = 0.01;
+const double K_PERCENT = 100;
+const int K_NAME_WIDTH = 40;
+const int K_COLUMN_WIDTH = 12;
+
+}  // namespace
+
+namespace bench {
+
+const std::size_t MicroBenchmark::K_DEFAULT_REPETITIONS;
+const double MicroBenchmark::K_DEFAULT_MIN_SECONDS = 0.2;
+
+MicroResult::MicroResult()
+    : iterations(0), nsPerOp(0), allocsPerOp(0), bytesPerOp(0) {}
+
+MicroBenchmark::MicroBenchmark()
+    : m_minSeconds(K_DEFAULT_MIN_SECONDS),
+      m_repetitions(K_DEFAULT_REPETITIONS) {}
+
+void MicroBenchmark::add(const std::string& name, MicroFunction function) {
+  Entry entry;
+  entry.name = name;
+  entry.function = function;
+  m_entries.push_back(entry);
+}
+
+void MicroBenchmark::setMinSeconds(double seconds) { m_minSeconds = seconds; }
+
+void MicroBenchmark::setRepetitions(std::size_t repetitions) {
+  m_repetitions = repetitions == 0 ? 1 : repetitions;
+}
+
+std::vector<MicroResult> MicroBenchmark::run(const std::string& filter) const {
+  std::vector<MicroResult> results;
+  for (std::size_t i = 0; i < m_entries.size(); ++i) {
+    if (filter.empty() ||
+        m_entries[i].name.find(filter) != std::string::npos) {
+      results.push_back(measure(m_entries[i]));
+    }
+  }
+  return results;
+}
+
+void MicroBenchmark::keep(std::size_t value) { g_sink += value; }
+
+void MicroBenchmark::keep(const void* pointer) {
+  g_sink += reinterpret_cast<std::size_t>(pointer);
+}
+
+MicroResult MicroBenchmark::measure(const Entry& entry) const {
+  const double minNanos = m_minSeconds * K_NANOS_PER_SECOND;
+  std::size_t iterations = 1;
+  double nanos = elapsedNanos(entry.function, iterations);
+  while (nanos < minNanos) {
+    double growth = nanos > 0 ? minNanos * K_GROWTH_HEADROOM / nanos
+                              : K_MAX_GROWTH;
+    growth = std::max(K_MIN_GROWTH, std::min(K_MAX_GROWTH, growth));
+    iterations = static_cast<std::size_t>(
+        static_cast<double>(iterations) * growth);
+    nanos = elapsedNanos(entry.function, iterations);
+  }
+
+  const unsigned long allocationsBefore = AllocationCounter::getCount();
+  const unsigned long bytesBefore = AllocationCounter::getBytes();
+  std::vector<double> samples;
+  samples.push_back(nanos);
+  for (std::size_t i = 1; i < m_repetitions; ++i) {
+    samples.push_back(elapsedNanos(entry.function, iterations));
+  }
+  const double operations =
+      static_cast<double>(iterations) * static_cast<double>(m_repetitions - 1);
+  std::sort(samples.begin(), samples.end());
+
+  MicroResult result;
+  result.name = entry.name;
+  result.iterations = iterations;
+  result.nsPerOp =
+      samples[samples.size() / 2] / static_cast<double>(iterations);
+  if (operations > 0) {
+    result.allocsPerOp =
+        static_cast<double>(AllocationCounter::getCount() - allocationsBefore) / operations;
+    result.bytesPerOp =
+        static_cast<double>(AllocationCounter::getBytes() - bytesBefore) / operations;
+  }
+  return result;
+}
+
+double MicroBenchmark::elapsedNanos(MicroFunction function,
+                                    std::size_t iterations) {
+  struct timespec start;
+  struct timespec end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  function(iterations);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  return static_cast<double>(end.tv_sec - start.tv_sec) * K_NANOS_PER_SECOND +
+         static_cast<double>(end.tv_nsec - start.tv_nsec);
+}
+
+void MicroBenchmark::writeTable(std::ostream& out,
+                                const std::vector<MicroResult>& results) {
+  out << std::left << std::setw(K_NAME_WIDTH) << "benchmark" << std::right
+      << std::setw(K_COLUMN_WIDTH) << "ns/op" << std::setw(K_COLUMN_WIDTH)
+      << "allocs/op" << std::setw(K_COLUMN_WIDTH) << "bytes/op"
+      << std::setw(K_COLUMN_WIDTH) << "iterations" << "\n";
+  out << std::fixed;
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    out << std::left << std::setw(K_NAME_WIDTH) << results[i].name
+        << std::right << std::setprecision(1) << std::setw(K_COLUMN_WIDTH)
+        << results[i].nsPerOp << std::setprecision(2)
+        << std::setw(K_COLUMN_WIDTH) << results[i].allocsPerOp
+        << std::setprecision(0) << std::setw(K_COLUMN_WIDTH)
+        << results[i].bytesPerOp << std::setw(K_COLUMN_WIDTH)
+        << results[i].iterations << "\n";
+  }
+}
+
+void MicroBenchmark::writeBaseline(std::ostream& out,
+                                   const std::vector<MicroResult>& results) {
+  out << std::fixed;
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    out << results[i].name << " " << std::setprecision(1)
+        << results[i].nsPerOp << " " << std::setprecision(2)
+        << results[i].allocsPerOp << "\n";
+  }
+}
+
+// A benchmark regresses when it is slower than the baseline by more than
+// the threshold or allocates more per operation. Benchmarks missing from the
+// baseline are reported but never fail the comparison.
+bool MicroBenchmark::compareBaseline(std::istream& baseline, std::ostream& out,
+                                     const std::vector<MicroResult>& results,
+                                     double thresholdPercent) {
+  std::map<std::string, std::pair<double, double> > expected;
+  std::string line;
+  while (std::getline(baseline, line)) {
+    std::istringstream fields(line);
+    std::string name;
+    double nsPerOp = 0;
+    double allocsPerOp = 0;
+    if (fields >> name >> nsPerOp >> allocsPerOp) {
+      expected[name] = std::make_pair(nsPerOp, allocsPerOp);
+    }
+  }
+
+  bool passed = true;
+  out << std::left << std::setw(K_NAME_WIDTH) << "benchmark" << std::right
+      << std::setw(K_COLUMN_WIDTH) << "base ns" << std::setw(K_COLUMN_WIDTH)
+      << "ns/op" << std::setw(K_COLUMN_WIDTH) << "delta"
+      << std::setw(K_COLUMN_WIDTH) << "base alloc" << std::setw(K_COLUMN_WIDTH)
+      << "allocs/op" << "  verdict\n";
+  out << std::fixed;
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    const MicroResult& result = results[i];
+    out << std::left << std::setw(K_NAME_WIDTH) << result.name << std::right;
+
+    std::map<std::string, std::pair<double, double> >::const_iterator it =
+        expected.find(result.name);
+    if (it == expected.end()) {
+      out << std::setw(K_COLUMN_WIDTH) << "-" << std::setprecision(1)
+          << std::setw(K_COLUMN_WIDTH) << result.nsPerOp
+          << std::setw(K_COLUMN_WIDTH) << "-" << std::setw(K_COLUMN_WIDTH)
+          << "-" << std::setprecision(2) << std::setw(K_COLUMN_WIDTH)
+          << result.allocsPerOp << "  NEW\n";
+      continue;
+    }
+
+    const double baseNs = it->second.first;
+    const double baseAllocs = it->second.second;
+    const double delta =
+        baseNs > 0 ? (result.nsPerOp - baseNs) / baseNs * K_PERCENT : 0;
+    const bool slower = delta > thresholdPercent;
+    const bool moreAllocs =
+        result.allocsPerOp >
+        baseAllocs +
+            std::max(K_ALLOC_TOLERANCE, baseAllocs * K_ALLOC_TOLERANCE_RATIO);
+    const char* verdict = "OK";
+    if (slower && moreAllocs) {
+      verdict = "SLOWER, MORE ALLOCS";
+    } else if (slower) {
+      verdict = "SLOWER";
+    } else if (moreAllocs) {
+      verdict = "MORE ALLOCS";
+    } else if (delta < -thresholdPercent) {
+      verdict = "FASTER";
+    }
+    passed = passed && !slower && !moreAllocs;
+
+    out << std::setprecision(1) << std::setw(K_COLUMN_WIDTH) << baseNs
+        << std::setw(K_COLUMN_WIDTH) << result.nsPerOp
+        << std::setw(K_COLUMN_WIDTH - 1) << std::showpos << delta
+        << std::noshowpos << "%" << std::setprecision(2)
+        << std::setw(K_COLUMN_WIDTH) << baseAllocs
+        << std::setw(K_COLUMN_WIDTH) << result.allocsPerOp << "  " << verdict
+        << "\n";
+  }
+  return passed;
+}
+
+}  // namespace bench
@@ -0,0 +1,81 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   MicroBenchmark.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 05:07:21 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 05:07:21 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef MICRO_BENCHMARK_HPP
+#define MICRO_BENCHMARK_HPP
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+typedef void (*MicroFunction)(std::size_t iterations);
+
+struct MicroResult {
+  MicroResult();
+
+  std::string name;
+  std::size_t iterations;
+  double nsPerOp;
+  double allocsPerOp;
+  double bytesPerOp;
+};
+
+// A small Google-Benchmark-style runner. Each registered function runs its
+// operation `iterations` times; the runner grows the count until one run
+// lasts the minimum time, then reports the median of several runs.
+// Allocations are counted by the replacement operator new in
+// AllocationCounter.cpp, so they cover everything the operation allocates.
+class MicroBenchmark {
+ public:
+  static const std::size_t K_DEFAULT_REPETITIONS = 5;
+  static const double K_DEFAULT_MIN_SECONDS;
+
+  MicroBenchmark();
+
+  void add(const std::string& name, MicroFunction function);
+  void setMinSeconds(double seconds);
+  void setRepetitions(std::size_t repetitions);
+
+  std::vector<MicroResult> run(const std::string& filter) const;
+
+  static void keep(std::size_t value);
+  static void keep(const void* pointer);
+
+  static void writeTable(std::ostream& out,
+                         const std::vector<MicroResult>& results);
+  static void writeBaseline(std::ostream& out,
+                            const std::vector<MicroResult>& results);
+  static bool compareBaseline(std::istream& baseline, std::ostream& out,
+                              const std::vector<MicroResult>& results,
+                              double thresholdPercent);
+
+ private:
+  struct Entry {
+    std::string name;
+    MicroFunction function;
+  };
+
+  std::vector<Entry> m_entries;
+  double m_minSeconds;
+  std::size_t m_repetitions;
+
+  MicroResult measure(const Entry& entry) const;
+
+  static double elapsedNanos(MicroFunction function, std::size_t iterations);
+};
+
+}  // namespace bench
+
+#endif  // MICRO_BENCHMARK_HPP
@@ -0,0 +1,378 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   main.cpp                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 04:16:33 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 04:16:33 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "BenchScenario.hpp"
+#include "LoadGenerator.hpp"
+
+#include <arpa/inet.h>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <netinet/in.h>
+#include <sstream>
+#include <string>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+const unsigned int K_READY_ATTEMPTS = 100;
+const unsigned int K_READY_POLL_MICROS = 50000;
+const unsigned int K_SHUTDOWN_ATTEMPTS = 40;
+const double K_P50 = 50.0;
+const double K_P90 = 90.0;
+const double K_P99 = 99.0;
+const double K_P999 = 99.9;
+const int K_JSON_VERSION = 1;
+
+struct BenchOptions {
+  BenchOptions()
+      : documentRoot("./var/www/html"), scenarios(), listOnly(false) {}
+
+  bench::LoadOptions load;
+  std::string serverBinary;
+  std::string configPath;
+  std::string documentRoot;
+  std::string outputPath;
+  std::vector<std::string> scenarios;
+  bool listOnly;
+};
+
+void printUsage(const char* program) {
+  std::cerr
+      << "Usage: " << program << " [options]\n"
+      << "  --server PATH       start PATH with --config before the run\n"
+      << "  --config FILE       configuration passed to --server\n"
+      << "  --host HOST         target host (default 127.0.0.1)\n"
+      << "  --port PORT         target port (default 8080)\n"
+      << "  --connections N     concurrent keep-alive connections (default 16)\n"
+      << "  --pipeline N        requests in flight per connection (default 1)\n"
+      << "  --duration SECONDS  measured time per scenario (default 5)\n"
+      << "  --rate RPS          open loop at RPS requests/s (default: closed)\n"
+      << "  --timeout SECONDS   per-request timeout (default 5)\n"
+      << "  --scenario A,B      scenarios to run (default: all)\n"
+      << "  --docroot DIR       document root for fixtures (./var/www/html)\n"
+      << "  --output FILE       write JSON to FILE instead of stdout\n"
+      << "  --list              list scenarios and exit\n";
+}
+
+std::vector<std::string> splitList(const std::string& value) {
+  std::vector<std::string> items;
+  std::istringstream stream(value);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    if (!item.empty()) {
+      items.push_back(item);
+    }
+  }
+  return items;
+}
+
+bool parseArguments(int argc, char** argv, BenchOptions& options) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string flag = argv[i];
+    if (flag == "--list") {
+      options.listOnly = true;
+      continue;
+    }
+    if (i + 1 >= argc) {
+      std::cerr << "Missing value for " << flag << "\n";
+      return false;
+    }
+    const std::string value = argv[++i];
+    if (flag == "--server") {
+      options.serverBinary = value;
+    } else if (flag == "--config") {
+      options.configPath = value;
+    } else if (flag == "--host") {
+      options.load.host = value;
+    } else if (flag == "--port") {
+      options.load.port =
+          static_cast<unsigned int>(std::strtoul(value.c_str(), NULL, 10));
+    } else if (flag == "--connections") {
+      options.load.connections =
+          static_cast<std::size_t>(std::strtoul(value.c_str(), NULL, 10));
+    } else if (flag == "--pipeline") {
+      options.load.pipeline =
+          static_cast<std::size_t>(std::strtoul(value.c_str(), NULL, 10));
+    } else if (flag == "--duration") {
+      options.load.durationSeconds = std::strtod(value.c_str(), NULL);
+    } else if (flag == "--rate") {
+      options.load.requestsPerSecond = std::strtod(value.c_str(), NULL);
+    } else if (flag == "--timeout") {
+      options.load.timeoutSeconds = std::strtod(value.c_str(), NULL);
+    } else if (flag == "--scenario") {
+      options.scenarios = splitList(value);
+    } else if (flag == "--docroot") {
+      options.documentRoot = value;
+    } else if (flag == "--output") {
+      options.outputPath = value;
+    } else {
+      std::cerr << "Unknown option " << flag << "\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+bool portAccepts(const std::string& host, unsigned int port) {
+  const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) {
+    return false;
+  }
+  struct sockaddr_in address;
+  std::memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_port = htons(static_cast<unsigned short>(port));
+  if (::inet_pton(AF_INET, host == "localhost" ? "127.0.0.1" : host.c_str(),
+                  &address.sin_addr) != 1) {
+    ::close(fd);
+    return false;
+  }
+  const bool accepted =
+      ::connect(fd, reinterpret_cast<struct sockaddr*>(&address),
+                sizeof(address)) == 0;
+  ::close(fd);
+  return accepted;
+}
+
+pid_t startServer(const BenchOptions& options) {
+  const pid_t pid = ::fork();
+  if (pid != 0) {
+    return pid;
+  }
+  const int devNull = ::open("/dev/null", O_WRONLY);
+  if (devNull >= 0) {
+    ::dup2(devNull, STDOUT_FILENO);
+    ::dup2(devNull, STDERR_FILENO);
+    ::close(devNull);
+  }
+  std::vector<char*> args;
+  args.push_back(const_cast<char*>(options.serverBinary.c_str()));
+  if (!options.configPath.empty()) {
+    args.push_back(const_cast<char*>(options.configPath.c_str()));
+  }
+  args.push_back(NULL);
+  ::execv(options.serverBinary.c_str(), &args[0]);
+  std::_Exit(EXIT_FAILURE);
+}
+
+bool waitUntilReady(pid_t server, const BenchOptions& options) {
+  for (unsigned int attempt = 0; attempt < K_READY_ATTEMPTS; ++attempt) {
+    int status = 0;
+    if (server > 0 && ::waitpid(server, &status, WNOHANG) == server) {
+      return false;
+    }
+    if (portAccepts(options.load.host, options.load.port)) {
+      return true;
+    }
+    ::usleep(K_READY_POLL_MICROS);
+  }
+  return false;
+}
+
+void stopServer(pid_t server) {
+  if (server <= 0) {
+    return;
+  }
+  ::kill(server, SIGTERM);
+  for (unsigned int attempt = 0; attempt < K_SHUTDOWN_ATTEMPTS; ++attempt) {
+    int status = 0;
+    if (::waitpid(server, &status, WNOHANG) == server) {
+      return;
+    }
+    ::usleep(K_READY_POLL_MICROS);
+  }
+  ::kill(server, SIGKILL);
+  ::waitpid(server, NULL, 0);
+}
+
+std::string jsonString(const std::string& value) {
+  std::string quoted = "\"";
+  for (std::size_t i = 0; i < value.size(); ++i) {
+    const char chr = value[i];
+    if (chr == '"' || chr == '\\') {
+      quoted += '\\';
+      quoted += chr;
+    } else if (static_cast<unsigned char>(chr) < 0x20) {
+      quoted += ' ';
+    } else {
+      quoted += chr;
+    }
+  }
+  return quoted + "\"";
+}
+
+std::string utcTimestamp() {
+  const std::time_t now = std::time(NULL);
+  char buffer[32];
+  std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ",
+                std::gmtime(&now));
+  return buffer;
+}
+
+void writeScenario(std::ostream& out, const bench::BenchScenario& scenario,
+                   const bench::LoadResult& result) {
+  const domain::shared::utils::LatencyHistogram& latency =
+      result.latencyMicros;
+  const double seconds = result.elapsedSeconds > 0 ? result.elapsedSeconds : 1;
+
+  out << "    {\n"
+      << "      \"name\": " << jsonString(scenario.name) << ",\n"
+      << "      \"description\": " << jsonString(scenario.description) << ",\n"
+      << "      \"expected_status\": " << scenario.expectedStatus << ",\n"
+      << "      \"requests\": " << result.requests << ",\n"
+      << "      \"unexpected_status\": " << result.unexpectedStatus << ",\n"
+      << "      \"connect_errors\": " << result.connectErrors << ",\n"
+      << "      \"io_errors\": " << result.ioErrors << ",\n"
+      << "      \"timeouts\": " << result.timeouts << ",\n"
+      << "      \"elapsed_s\": " << result.elapsedSeconds << ",\n"
+      << "      \"rps\": " << static_cast<double>(result.requests) / seconds
+      << ",\n"
+      << "      \"bytes_per_s\": "
+      << static_cast<double>(result.bytesReceived) / seconds << ",\n"
+      << "      \"latency_us\": {\"min\": " << latency.getMin()
+      << ", \"mean\": " << latency.getMean()
+      << ", \"p50\": " << latency.valueAtPercentile(K_P50)
+      << ", \"p90\": " << latency.valueAtPercentile(K_P90)
+      << ", \"p99\": " << latency.valueAtPercentile(K_P99)
+      << ", \"p999\": " << latency.valueAtPercentile(K_P999)
+      << ", \"max\": " << latency.getMax() << "},\n"
+      << "      \"status\": {";
+  for (std::map<int, unsigned long>::const_iterator it =
+           result.statusCounts.begin();
+       it != result.statusCounts.end(); ++it) {
+    out << (it == result.statusCounts.begin() ? "" : ", ") << "\""
+        << it->first << "\": " << it->second;
+  }
+  out << "}\n    }";
+}
+
+void printSummary(const bench::BenchScenario& scenario,
+                  const bench::LoadResult& result) {
+  const double seconds = result.elapsedSeconds > 0 ? result.elapsedSeconds : 1;
+  std::cerr << std::left << std::setw(18) << scenario.name << std::right
+            << std::fixed << std::setprecision(0) << std::setw(10)
+            << static_cast<double>(result.requests) / seconds << " req/s"
+            << "  p50 " << result.latencyMicros.valueAtPercentile(K_P50)
+            << "us  p99 " << result.latencyMicros.valueAtPercentile(K_P99)
+            << "us  p999 " << result.latencyMicros.valueAtPercentile(K_P999)
+            << "us  errors "
+            << result.unexpectedStatus + result.connectErrors +
+                   result.ioErrors + result.timeouts
+            << "\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  BenchOptions options;
+  if (!parseArguments(argc, argv, options)) {
+    printUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  const bench::ScenarioCatalog catalog(options.documentRoot,
+                                       options.load.host);
+  if (options.listOnly) {
+    const std::vector<bench::BenchScenario>& all = catalog.getScenarios();
+    for (std::size_t i = 0; i < all.size(); ++i) {
+      std::cout << all[i].name << "\t" << all[i].description << "\n";
+    }
+    return EXIT_SUCCESS;
+  }
+
+  std::vector<const bench::BenchScenario*> selected;
+  if (options.scenarios.empty()) {
+    for (std::size_t i = 0; i < catalog.getScenarios().size(); ++i) {
+      selected.push_back(&catalog.getScenarios()[i]);
+    }
+  }
+  for (std::size_t i = 0; i < options.scenarios.size(); ++i) {
+    const bench::BenchScenario* scenario = catalog.find(options.scenarios[i]);
+    if (scenario == NULL) {
+      std::cerr << "Unknown scenario " << options.scenarios[i] << "\n";
+      return EXIT_FAILURE;
+    }
+    selected.push_back(scenario);
+  }
+
+  ::signal(SIGPIPE, SIG_IGN);
+  if (!catalog.prepareFixtures()) {
+    std::cerr << "Cannot write fixtures under " << options.documentRoot
+              << "\n";
+    return EXIT_FAILURE;
+  }
+
+  pid_t server = 0;
+  if (!options.serverBinary.empty()) {
+    server = startServer(options);
+  }
+  if (!waitUntilReady(server, options)) {
+    std::cerr << "Nothing accepts connections on " << options.load.host << ":"
+              << options.load.port << "\n";
+    stopServer(server);
+    catalog.removeFixtures();
+    return EXIT_FAILURE;
+  }
+
+  std::ostringstream json;
+  json << "{\n"
+       << "  \"tool\": \"webserv_bench\",\n"
+       << "  \"version\": " << K_JSON_VERSION << ",\n"
+       << "  \"timestamp\": " << jsonString(utcTimestamp()) << ",\n"
+       << "  \"target\": {\"host\": " << jsonString(options.load.host)
+       << ", \"port\": " << options.load.port
+       << ", \"config\": " << jsonString(options.configPath) << "},\n"
+       << "  \"load\": {\"mode\": \""
+       << (options.load.requestsPerSecond > 0 ? "open" : "closed")
+       << "\", \"connections\": " << options.load.connections
+       << ", \"pipeline\": " << options.load.pipeline
+       << ", \"duration_s\": " << options.load.durationSeconds
+       << ", \"rate\": " << options.load.requestsPerSecond << "},\n"
+       << "  \"scenarios\": [\n";
+
+  bool allAnswered = true;
+  for (std::size_t i = 0; i < selected.size(); ++i) {
+    bench::LoadGenerator generator(options.load, selected[i]->requests,
+                                   selected[i]->expectedStatus);
+    const bench::LoadResult result = generator.run();
+    allAnswered = allAnswered && result.requests > 0;
+    printSummary(*selected[i], result);
+    writeScenario(json, *selected[i], result);
+    json << (i + 1 < selected.size() ? ",\n" : "\n");
+  }
+  json << "  ]\n}\n";
+
+  stopServer(server);
+  catalog.removeFixtures();
+
+  if (options.outputPath.empty()) {
+    std::cout << json.str();
+  } else {
+    std::ofstream output(options.outputPath.c_str());
+    output << json.str();
+    if (!output) {
+      std::cerr << "Cannot write " << options.outputPath << "\n";
+      return EXIT_FAILURE;
+    }
+    std::cerr << "Results written to " << options.outputPath << "\n";
+  }
+  return allAnswered ? EXIT_SUCCESS : EXIT_FAILURE;
+}
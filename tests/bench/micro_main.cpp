@@ -0,0 +1,353 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   micro_main.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 05:31:48 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 05:31:48 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MicroBenchmark.hpp"
+#include "application/ports/ILogger.hpp"
+#include "domain/configuration/entities/LocationConfig.hpp"
+#include "domain/configuration/entities/ServerConfig.hpp"
+#include "domain/filesystem/value_objects/Path.hpp"
+#include "domain/http/entities/HttpResponse.hpp"
+#include "domain/http/value_objects/Uri.hpp"
+#include "domain/shared/value_objects/ErrorCode.hpp"
+#include "infrastructure/filesystem/adapters/DirectoryLister.hpp"
+#include "infrastructure/http/RequestParser.hpp"
+#include "infrastructure/network/adapters/ConnectionHandler.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using domain::configuration::entities::LocationConfig;
+using domain::configuration::entities::ServerConfig;
+using domain::filesystem::value_objects::Path;
+using domain::http::entities::HttpResponse;
+using domain::http::value_objects::Uri;
+using domain::shared::value_objects::ErrorCode;
+using infrastructure::filesystem::adapters::DirectoryLister;
+using infrastructure::http::RequestParser;
+using infrastructure::network::adapters::ConnectionHandler;
+
+namespace {
+
+const char K_LISTING_DIRECTORY[] = "/tmp/webserv_microbench_listing";
+const std::size_t K_LISTING_FILES = 64;
+const std::size_t K_RESPONSE_BODY_BYTES = 4096;
+const double K_DEFAULT_THRESHOLD_PERCENT = 10;
+
+const char K_GET_REQUEST[] =
+    "GET /images/gallery/cat.png?size=large&format=webp HTTP/1.1\r\n"
+    "Host: www.webserv.com\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64) Gecko/20100101 Firefox/120.0\r\n"
+    "Accept: image/avif,image/webp,*/*\r\n"
+    "Accept-Language: en-US,en;q=0.5\r\n"
+    "Accept-Encoding: gzip, deflate, br\r\n"
+    "Referer: http://www.webserv.com/gallery/index.html\r\n"
+    "Connection: keep-alive\r\n"
+    "Cache-Control: no-cache\r\n"
+    "\r\n";
+
+const char K_POST_REQUEST[] =
+    "POST /api/submit HTTP/1.1\r\n"
+    "Host: www.webserv.com\r\n"
+    "Content-Type: application/x-www-form-urlencoded\r\n"
+    "Content-Length: 43\r\n"
+    "Connection: keep-alive\r\n"
+    "\r\n"
+    "name=webserv&language=cpp98&benchmark=true";
+
+ServerConfig* g_server = NULL;
+HttpResponse* g_response = NULL;
+
+void parseRequest(const char* data, std::size_t length,
+                  std::size_t iterations) {
+  RequestParser parser;
+  for (std::size_t i = 0; i < iterations; ++i) {
+    parser.reset();
+    parser.parse(data, length);
+    bench::MicroBenchmark::keep(parser.getConsumedBytes());
+  }
+}
+
+void benchParseGet(std::size_t iterations) {
+  parseRequest(K_GET_REQUEST, sizeof(K_GET_REQUEST) - 1, iterations);
+}
+
+void benchParsePost(std::size_t iterations) {
+  parseRequest(K_POST_REQUEST, sizeof(K_POST_REQUEST) - 1, iterations);
+}
+
+void benchUriAbsolute(std::size_t iterations) {
+  const std::string text =
+      "http://www.webserv.com:8080/images/gallery/cat.png?size=large#top";
+  for (std::size_t i = 0; i < iterations; ++i) {
+    const Uri uri(text);
+    bench::MicroBenchmark::keep(uri.getPath().size());
+  }
+}
+
+void benchUriOriginForm(std::size_t iterations) {
+  const std::string text = "/images/gallery/cat.png?size=large&format=webp";
+  for (std::size_t i = 0; i < iterations; ++i) {
+    const Uri uri(text);
+    bench::MicroBenchmark::keep(uri.getPath().size());
+  }
+}
+
+void benchPathNormalize(std::size_t iterations) {
+  const Path path("/var/www/html/./images/gallery/../thumbnails//cat.png");
+  for (std::size_t i = 0; i < iterations; ++i) {
+    bench::MicroBenchmark::keep(path.normalize().toString().size());
+  }
+}
+
+void benchResponseSerialize(std::size_t iterations) {
+  for (std::size_t i = 0; i < iterations; ++i) {
+    bench::MicroBenchmark::keep(g_response->serialize().size());
+  }
+}
+
+void matchLocations(const char* const* paths, std::size_t count,
+                    std::size_t iterations) {
+  for (std::size_t i = 0; i < iterations; ++i) {
+    bench::MicroBenchmark::keep(ConnectionHandler::findMatchingLocation(
+        g_server, paths[i % count]));
+  }
+}
+
+void benchMatchPrefix(std::size_t iterations) {
+  static const char* const paths[] = {"/uploads/report.pdf", "/static/app.js",
+                                      "/images/gallery/cat.png", "/about"};
+  matchLocations(paths, sizeof(paths) / sizeof(paths[0]), iterations);
+}
+
+void benchMatchRegex(std::size_t iterations) {
+  static const char* const paths[] = {"/api/env_dump.py", "/cgi/info.php"};
+  matchLocations(paths, sizeof(paths) / sizeof(paths[0]), iterations);
+}
+
+// Runs at INFO like a production server, so debug lines are dropped; the
+// two benchmarks below show what building such a line costs anyway.
+class QuietLogger : public application::ports::ILogger {
+ public:
+  QuietLogger() : m_level(INFO), m_kept(0) {}
+
+  virtual void debug(const std::string& msg) { log(DEBUG, msg); }
+  virtual void info(const std::string& msg) { log(INFO, msg); }
+  virtual void warn(const std::string& msg) { log(WARN, msg); }
+  virtual void error(const std::string& msg) { log(ERROR, msg); }
+
+  virtual bool isEnabled(LogLevel level) const { return level >= m_level; }
+  virtual void setLevel(LogLevel level) { m_level = level; }
+
+  std::size_t getKept() const { return m_kept; }
+
+ private:
+  virtual void log(LogLevel level, const std::string& msg) {
+    if (isEnabled(level)) {
+      m_kept += msg.size();
+    }
+  }
+
+  LogLevel m_level;
+  std::size_t m_kept;
+};
+
+QuietLogger* g_logger = NULL;
+
+void benchDebugLogEager(std::size_t iterations) {
+  for (std::size_t i = 0; i < iterations; ++i) {
+    std::ostringstream oss;
+    oss << "Read " << i << " bytes from fd=" << 42 << " (state=" << 3 << ")";
+    g_logger->debug(oss.str());
+    bench::MicroBenchmark::keep(i);
+  }
+  bench::MicroBenchmark::keep(g_logger->getKept());
+}
+
+void benchDebugLogGated(std::size_t iterations) {
+  for (std::size_t i = 0; i < iterations; ++i) {
+    WEBSERV_LOG_DEBUG(*g_logger, "Read " << i << " bytes from fd=" << 42
+                                         << " (state=" << 3 << ")");
+    bench::MicroBenchmark::keep(i);
+  }
+  bench::MicroBenchmark::keep(g_logger->getKept());
+}
+
+void benchDirectoryListing(std::size_t iterations) {
+  const Path directory(K_LISTING_DIRECTORY);
+  const Path request("/files/");
+  for (std::size_t i = 0; i < iterations; ++i) {
+    bench::MicroBenchmark::keep(
+        DirectoryLister::generateHtmlListing(directory, request).size());
+  }
+}
+
+ServerConfig* buildServer() {
+  ServerConfig* server = new ServerConfig();
+  server->addListenDirective("127.0.0.1:8080");
+  server->addLocation(new LocationConfig("/"));
+  server->addLocation(new LocationConfig("/uploads"));
+  server->addLocation(new LocationConfig("/api"));
+  server->addLocation(new LocationConfig("/static"));
+  server->addLocation(new LocationConfig("/images"));
+  server->addLocation(new LocationConfig("/images/gallery"));
+  server->addLocation(
+      new LocationConfig("/favicon.ico", LocationConfig::MATCH_EXACT));
+  server->addLocation(new LocationConfig(
+      "\\.php$", LocationConfig::MATCH_REGEX_CASE_SENSITIVE));
+  server->addLocation(new LocationConfig(
+      "\\.py$", LocationConfig::MATCH_REGEX_CASE_SENSITIVE));
+  return server;
+}
+
+HttpResponse* buildResponse() {
+  HttpResponse* response = new HttpResponse(
+      ErrorCode::ok(), std::string(K_RESPONSE_BODY_BYTES, 'x'));
+  response->setContentType("text/html");
+  response->setContentLength(K_RESPONSE_BODY_BYTES);
+  response->setConnection("keep-alive");
+  response->setServer(HttpResponse::SERVER_NAME);
+  response->setDate();
+  response->setHeader("Last-Modified", "Tue, 13 Jan 2026 12:59:42 GMT");
+  response->setHeader("Cache-Control", "no-store");
+  return response;
+}
+
+bool createListingFixture() {
+  if (::mkdir(K_LISTING_DIRECTORY, 0755) != 0 && errno != EEXIST) {
+    return false;
+  }
+  for (std::size_t i = 0; i < K_LISTING_FILES; ++i) {
+    std::ostringstream name;
+    name << K_LISTING_DIRECTORY << "/file_" << i << ".txt";
+    std::ofstream file(name.str().c_str());
+    file << std::string(i * 16, 'f');
+  }
+  return true;
+}
+
+void removeListingFixture() {
+  for (std::size_t i = 0; i < K_LISTING_FILES; ++i) {
+    std::ostringstream name;
+    name << K_LISTING_DIRECTORY << "/file_" << i << ".txt";
+    std::remove(name.str().c_str());
+  }
+  ::rmdir(K_LISTING_DIRECTORY);
+}
+
+void printUsage(const char* program) {
+  std::cerr << "Usage: " << program << " [options]\n"
+            << "  --filter TEXT       run benchmarks whose name contains TEXT\n"
+            << "  --min-time SECONDS  minimum time per run (default 0.2)\n"
+            << "  --repetitions N     runs per benchmark (default 5)\n"
+            << "  --save FILE         write results as a baseline\n"
+            << "  --baseline FILE     compare against a saved baseline\n"
+            << "  --threshold PCT     allowed slowdown (default 10)\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  bench::MicroBenchmark runner;
+  std::string filter;
+  std::string savePath;
+  std::string baselinePath;
+  double threshold = K_DEFAULT_THRESHOLD_PERCENT;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string flag = argv[i];
+    if (i + 1 >= argc) {
+      printUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+    const std::string value = argv[++i];
+    if (flag == "--filter") {
+      filter = value;
+    } else if (flag == "--min-time") {
+      runner.setMinSeconds(std::strtod(value.c_str(), NULL));
+    } else if (flag == "--repetitions") {
+      runner.setRepetitions(
+          static_cast<std::size_t>(std::strtoul(value.c_str(), NULL, 10)));
+    } else if (flag == "--save") {
+      savePath = value;
+    } else if (flag == "--baseline") {
+      baselinePath = value;
+    } else if (flag == "--threshold") {
+      threshold = std::strtod(value.c_str(), NULL);
+    } else {
+      printUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (!createListingFixture()) {
+    std::cerr << "Cannot create " << K_LISTING_DIRECTORY << "\n";
+    return EXIT_FAILURE;
+  }
+  g_server = buildServer();
+  g_response = buildResponse();
+  g_logger = new QuietLogger();
+
+  runner.add("RequestParser::parse/get", benchParseGet);
+  runner.add("RequestParser::parse/post_body", benchParsePost);
+  runner.add("Uri/absolute", benchUriAbsolute);
+  runner.add("Uri/origin_form", benchUriOriginForm);
+  runner.add("Path::normalize", benchPathNormalize);
+  runner.add("HttpResponse::serialize/4k", benchResponseSerialize);
+  runner.add("findMatchingLocation/prefix", benchMatchPrefix);
+  runner.add("findMatchingLocation/regex", benchMatchRegex);
+  runner.add("DirectoryLister::generateHtmlListing/64",
+             benchDirectoryListing);
+  runner.add("ILogger::debug/eager_format", benchDebugLogEager);
+  runner.add("ILogger::debug/level_gated", benchDebugLogGated);
+
+  const std::vector<bench::MicroResult> results = runner.run(filter);
+
+  delete g_logger;
+  delete g_response;
+  delete g_server;
+  removeListingFixture();
+
+  bench::MicroBenchmark::writeTable(std::cout, results);
+
+  if (!savePath.empty()) {
+    std::ofstream output(savePath.c_str());
+    bench::MicroBenchmark::writeBaseline(output, results);
+    if (!output) {
+      std::cerr << "Cannot write " << savePath << "\n";
+      return EXIT_FAILURE;
+    }
+    std::cout << "\nBaseline written to " << savePath << "\n";
+  }
+
+  if (!baselinePath.empty()) {
+    std::ifstream baseline(baselinePath.c_str());
+    if (!baseline) {
+      std::cerr << "Cannot read " << baselinePath << "\n";
+      return EXIT_FAILURE;
+    }
+    std::cout << "\n";
+    if (!bench::MicroBenchmark::compareBaseline(baseline, std::cout, results,
+                                                threshold)) {
+      std::cout << "\nRegression against " << baselinePath << "\n";
+      return EXIT_FAILURE;
+    }
+    std::cout << "\nNo regression against " << baselinePath << "\n";
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,298 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   MockFastCgiServer.cpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 15:42:03 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 15:42:03 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "mocks/MockFastCgiServer.hpp"
+#include "infrastructure/cgi/primitives/FastCgiRecord.hpp"
+#include "infrastructure/cgi/primitives/FastCgiRecordDecoder.hpp"
+
+#include <csignal>
+#include <cstring>
+#include <map>
+#include <poll.h>
+#include <sstream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+using infrastructure::cgi::primitives::FastCgiRecord;
+using infrastructure::cgi::primitives::FastCgiRecordDecoder;
+
+namespace mocks {
+
+namespace {
+
+const int K_LISTEN_BACKLOG = 16;
+const std::size_t K_READ_CHUNK = 4096;
+
+struct PendingRequest {
+  std::vector<char> params;
+  std::string input;
+  bool keepConnection;
+
+  PendingRequest() : keepConnection(false) {}
+};
+
+struct Client {
+  int fd;
+  unsigned int number;
+  FastCgiRecordDecoder decoder;
+  std::map<unsigned short, PendingRequest> requests;
+  std::vector<unsigned short> held;
+};
+
+void writeAll(int fd, const std::vector<char>& data) {
+  std::size_t sent = 0;
+  while (sent < data.size()) {
+    const ssize_t written = ::write(fd, &data[sent], data.size() - sent);
+    if (written <= 0) {
+      return;
+    }
+    sent += static_cast<std::size_t>(written);
+  }
+}
+
+FastCgiRecord::ParameterMap paramsOf(const PendingRequest& request) {
+  FastCgiRecord::ParameterMap params;
+  if (!request.params.empty()) {
+    FastCgiRecord::parseNameValues(&request.params[0], request.params.size(),
+                                   params);
+  }
+  return params;
+}
+
+void answerValues(Client& client, bool multiplexing) {
+  FastCgiRecord::ParameterMap values;
+  values["FCGI_MPXS_CONNS"] = multiplexing ? "1" : "0";
+  std::vector<char> out;
+  FastCgiRecord::appendValues(out, FastCgiRecord::TYPE_GET_VALUES_RESULT,
+                              values);
+  writeAll(client.fd, out);
+}
+
+void respond(Client& client, unsigned short requestId,
+             const PendingRequest& request) {
+  FastCgiRecord::ParameterMap params = paramsOf(request);
+
+  std::ostringstream body;
+  body << "connection=" << client.number << "\n"
+       << "method=" << params["REQUEST_METHOD"] << "\n"
+       << "script=" << params["SCRIPT_FILENAME"] << "\n"
+       << "body=" << request.input;
+  const std::string output =
+      "Content-Type: text/plain\r\n\r\n" + body.str();
+  const std::string& query = params["QUERY_STRING"];
+
+  std::vector<char> out;
+  if (query != "empty") {
+    FastCgiRecord::appendStream(out, FastCgiRecord::TYPE_STDOUT, requestId,
+                                output.data(), output.size());
+  }
+  FastCgiRecord::appendStreamEnd(out, FastCgiRecord::TYPE_STDOUT, requestId);
+  if (query == "stderr") {
+    const std::string warning = "mock warning";
+    FastCgiRecord::appendStream(out, FastCgiRecord::TYPE_STDERR, requestId,
+                                warning.data(), warning.size());
+  }
+  FastCgiRecord::appendEndRequest(out, requestId, 0,
+                                  FastCgiRecord::STATUS_REQUEST_COMPLETE);
+  writeAll(client.fd, out);
+}
+
+// Returns false once the connection should be closed.
+bool handleRecord(Client& client, const FastCgiRecord& record,
+                  bool honorKeepConnection) {
+  if (record.type == FastCgiRecord::TYPE_GET_VALUES) {
+    answerValues(client, honorKeepConnection);
+    return true;
+  }
+
+  PendingRequest& request = client.requests[record.requestId];
+
+  switch (record.type) {
+    case FastCgiRecord::TYPE_BEGIN_REQUEST:
+      request.keepConnection =
+          record.content.size() > 2 &&
+          (record.content[2] & FastCgiRecord::K_FLAG_KEEP_CONN) != 0;
+      return true;
+    case FastCgiRecord::TYPE_PARAMS:
+      request.params.insert(request.params.end(), record.content.begin(),
+                            record.content.end());
+      return true;
+    case FastCgiRecord::TYPE_STDIN:
+      if (!record.isEndOfStream()) {
+        request.input.append(record.content.begin(), record.content.end());
+        return true;
+      }
+      break;
+    case FastCgiRecord::TYPE_ABORT_REQUEST:
+      client.requests.erase(record.requestId);
+      return true;
+    default:
+      return true;
+  }
+
+  const bool keep = request.keepConnection && honorKeepConnection;
+  if (paramsOf(request)["QUERY_STRING"] == "hold") {
+    client.held.push_back(record.requestId);
+    return true;
+  }
+
+  respond(client, record.requestId, request);
+  client.requests.erase(record.requestId);
+  for (std::size_t i = 0; i < client.held.size(); ++i) {
+    respond(client, client.held[i], client.requests[client.held[i]]);
+    client.requests.erase(client.held[i]);
+  }
+  client.held.clear();
+  return keep;
+}
+
+}  // namespace
+
+// ============================================================================
+// Server Control
+// ============================================================================
+
+MockFastCgiServer::MockFastCgiServer(bool honorKeepConnection)
+    : m_honorKeepConnection(honorKeepConnection), m_childPid(-1) {}
+
+MockFastCgiServer::~MockFastCgiServer() { stop(); }
+
+void MockFastCgiServer::start() {
+  if (isRunning()) {
+    return;
+  }
+
+  static unsigned int instanceCounter = 0;
+  std::ostringstream path;
+  path << "/tmp/webserv_mock_fcgi_" << ::getpid() << "_" << ++instanceCounter
+       << ".sock";
+  m_socketPath = path.str();
+  ::unlink(m_socketPath.c_str());
+
+  const int listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  struct sockaddr_un addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  std::strncpy(addr.sun_path, m_socketPath.c_str(), sizeof(addr.sun_path) - 1);
+
+  if (listenFd < 0 ||
+      ::bind(listenFd, reinterpret_cast<struct sockaddr*>(&addr),
+             sizeof(addr)) != 0 ||
+      ::listen(listenFd, K_LISTEN_BACKLOG) != 0) {
+    if (listenFd >= 0) {
+      ::close(listenFd);
+    }
+    throw std::runtime_error("MockFastCgiServer: cannot listen on " +
+                             m_socketPath);
+  }
+
+  m_childPid = ::fork();
+  if (m_childPid == 0) {
+    try {
+      serve(listenFd);
+    } catch (...) {
+    }
+    ::_exit(0);
+  }
+  ::close(listenFd);
+
+  if (m_childPid < 0) {
+    ::unlink(m_socketPath.c_str());
+    throw std::runtime_error("MockFastCgiServer: fork failed");
+  }
+}
+
+void MockFastCgiServer::stop() {
+  if (!isRunning()) {
+    return;
+  }
+
+  ::kill(m_childPid, SIGKILL);
+  ::waitpid(m_childPid, NULL, 0);
+  ::unlink(m_socketPath.c_str());
+  m_childPid = -1;
+}
+
+bool MockFastCgiServer::isRunning() const { return m_childPid > 0; }
+
+// ============================================================================
+// Address
+// ============================================================================
+
+std::string MockFastCgiServer::getAddress() const {
+  return "unix:" + m_socketPath;
+}
+
+// ============================================================================
+// Responder Loop (child process)
+// ============================================================================
+
+void MockFastCgiServer::serve(int listenFd) const {
+  std::map<int, Client*> clients;
+  unsigned int connectionCount = 0;
+
+  while (true) {
+    std::vector<struct pollfd> descriptors;
+    struct pollfd listener = {listenFd, POLLIN, 0};
+    descriptors.push_back(listener);
+    for (std::map<int, Client*>::const_iterator it = clients.begin();
+         it != clients.end(); ++it) {
+      struct pollfd entry = {it->first, POLLIN, 0};
+      descriptors.push_back(entry);
+    }
+
+    if (::poll(&descriptors[0], descriptors.size(), -1) < 0) {
+      continue;
+    }
+
+    if ((descriptors[0].revents & POLLIN) != 0) {
+      const int clientFd = ::accept(listenFd, NULL, NULL);
+      if (clientFd >= 0) {
+        Client* client = new Client();
+        client->fd = clientFd;
+        client->number = ++connectionCount;
+        clients[clientFd] = client;
+      }
+    }
+
+    for (std::size_t i = 1; i < descriptors.size(); ++i) {
+      if (descriptors[i].revents == 0) {
+        continue;
+      }
+
+      Client* client = clients[descriptors[i].fd];
+      char buffer[K_READ_CHUNK];
+      const ssize_t received = ::read(client->fd, buffer, sizeof(buffer));
+      bool keepOpen = received > 0;
+
+      if (keepOpen) {
+        client->decoder.feed(buffer, static_cast<std::size_t>(received));
+        FastCgiRecord record;
+        while (keepOpen && client->decoder.next(record)) {
+          keepOpen = handleRecord(*client, record, m_honorKeepConnection);
+        }
+      }
+
+      if (!keepOpen) {
+        ::close(client->fd);
+        clients.erase(client->fd);
+        delete client;
+      }
+    }
+  }
+}
+
+}  // namespace mocks
@@ -0,0 +1,53 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   MockFastCgiServer.hpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 15:42:03 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 15:42:03 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef MOCK_FAST_CGI_SERVER_HPP
+#define MOCK_FAST_CGI_SERVER_HPP
+
+#include <string>
+#include <sys/types.h>
+
+namespace mocks {
+
+// Local FastCGI responder used as a stand-in for php-fpm. It runs in a forked
+// child on a private unix socket and answers every request with a plain-text
+// echo of the connection number, REQUEST_METHOD, SCRIPT_FILENAME and stdin.
+// QUERY_STRING "stderr" adds a stderr record, "empty" suppresses stdout and
+// "hold" answers only after the next request on the connection, so replies
+// interleave. A server that keeps connections reports FCGI_MPXS_CONNS=1.
+class MockFastCgiServer {
+ public:
+  explicit MockFastCgiServer(bool honorKeepConnection = true);
+  ~MockFastCgiServer();
+
+  // Server Control - Fork the responder and tear it down
+  void start();
+  void stop();
+  bool isRunning() const;
+
+  // Address - Value suitable for fastcgi_pass
+  std::string getAddress() const;
+
+ private:
+  MockFastCgiServer(const MockFastCgiServer&);
+  MockFastCgiServer& operator=(const MockFastCgiServer&);
+
+  bool m_honorKeepConnection;
+  std::string m_socketPath;
+  pid_t m_childPid;
+
+  void serve(int listenFd) const;
+};
+
+}  // namespace mocks
+
+#endif  // MOCK_FAST_CGI_SERVER_HPP
@@ -0,0 +1,271 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   MockHttpUpstream.cpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 10:38:22 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 10:38:22 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "mocks/MockHttpUpstream.hpp"
+
+#include <arpa/inet.h>
+#include <cctype>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sstream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+namespace mocks {
+
+namespace {
+
+const int K_LISTEN_BACKLOG = 16;
+const std::size_t K_READ_CHUNK = 4096;
+
+struct Client {
+  int fd;
+  unsigned int number;
+  std::string buffer;
+  bool silent;
+};
+
+void writeAll(int fd, const std::string& data) {
+  std::size_t sent = 0;
+  while (sent < data.size()) {
+    const ssize_t written = ::write(fd, data.data() + sent, data.size() - sent);
+    if (written <= 0) {
+      return;
+    }
+    sent += static_cast<std::size_t>(written);
+  }
+}
+
+std::string headerValue(const std::string& head, const std::string& name) {
+  std::string lowered = head;
+  for (std::size_t i = 0; i < lowered.size(); ++i) {
+    lowered[i] = static_cast<char>(std::tolower(
+        static_cast<unsigned char>(lowered[i])));
+  }
+  const std::string needle = "\r\n" + name + ":";
+  const std::size_t pos = lowered.find(needle);
+  if (pos == std::string::npos) {
+    return "";
+  }
+  std::size_t start = pos + needle.size();
+  while (start < head.size() && head[start] == ' ') {
+    ++start;
+  }
+  const std::size_t end = head.find("\r\n", start);
+  return head.substr(start, end - start);
+}
+
+// Returns false once the connection should be closed.
+bool respond(Client& client, const std::string& head, const std::string& body,
+             bool honorKeepAlive) {
+  const std::string requestLine = head.substr(0, head.find("\r\n"));
+  const std::size_t targetStart = requestLine.find(' ') + 1;
+  const std::string target = requestLine.substr(
+      targetStart, requestLine.find(' ', targetStart) - targetStart);
+
+  if (target == "/silent") {
+    client.silent = true;
+    return true;
+  }
+
+  std::ostringstream echo;
+  echo << "connection=" << client.number << "\n"
+       << "request=" << requestLine << "\n"
+       << "host=" << headerValue(head, "host") << "\n"
+       << "body=" << body;
+  const std::string payload = echo.str();
+  const bool keepAlive = honorKeepAlive && target != "/eof";
+
+  std::ostringstream response;
+  response << "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\n";
+  if (!keepAlive) {
+    response << "Connection: close\r\n";
+  }
+
+  if (target == "/chunked") {
+    response << "Transfer-Encoding: chunked\r\n\r\n";
+    writeAll(client.fd, response.str());
+    const std::size_t half = payload.size() / 2;
+    std::ostringstream chunks;
+    chunks << std::hex << half << "\r\n"
+           << payload.substr(0, half) << "\r\n"
+           << payload.size() - half << "\r\n"
+           << payload.substr(half) << "\r\n0\r\n\r\n";
+    writeAll(client.fd, chunks.str());
+  } else if (target == "/eof") {
+    response << "\r\n" << payload;
+    writeAll(client.fd, response.str());
+  } else {
+    response << "Content-Length: " << payload.size() << "\r\n\r\n"
+             << payload;
+    writeAll(client.fd, response.str());
+  }
+  return keepAlive;
+}
+
+// Returns false once the connection should be closed.
+bool handleBuffered(Client& client, bool honorKeepAlive) {
+  while (!client.silent) {
+    const std::size_t headEnd = client.buffer.find("\r\n\r\n");
+    if (headEnd == std::string::npos) {
+      return true;
+    }
+    const std::string head = client.buffer.substr(0, headEnd + 2);
+    const std::size_t length = static_cast<std::size_t>(
+        std::strtoul(headerValue(head, "content-length").c_str(), NULL, 10));
+    if (client.buffer.size() < headEnd + 4 + length) {
+      return true;
+    }
+    const std::string body = client.buffer.substr(headEnd + 4, length);
+    client.buffer.erase(0, headEnd + 4 + length);
+    if (!respond(client, head, body, honorKeepAlive)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+// ============================================================================
+// Server Control
+// ============================================================================
+
+MockHttpUpstream::MockHttpUpstream(bool honorKeepAlive)
+    : m_honorKeepAlive(honorKeepAlive), m_port(0), m_childPid(-1) {}
+
+MockHttpUpstream::~MockHttpUpstream() { stop(); }
+
+void MockHttpUpstream::start() {
+  if (isRunning()) {
+    return;
+  }
+
+  const int listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+  struct sockaddr_in addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = 0;
+  socklen_t addrLength = sizeof(addr);
+
+  if (listenFd < 0 ||
+      ::bind(listenFd, reinterpret_cast<struct sockaddr*>(&addr),
+             sizeof(addr)) != 0 ||
+      ::listen(listenFd, K_LISTEN_BACKLOG) != 0 ||
+      ::getsockname(listenFd, reinterpret_cast<struct sockaddr*>(&addr),
+                    &addrLength) != 0) {
+    if (listenFd >= 0) {
+      ::close(listenFd);
+    }
+    throw std::runtime_error("MockHttpUpstream: cannot listen on loopback");
+  }
+  m_port = ntohs(addr.sin_port);
+
+  m_childPid = ::fork();
+  if (m_childPid == 0) {
+    try {
+      serve(listenFd);
+    } catch (...) {
+    }
+    ::_exit(0);
+  }
+  ::close(listenFd);
+
+  if (m_childPid < 0) {
+    throw std::runtime_error("MockHttpUpstream: fork failed");
+  }
+}
+
+void MockHttpUpstream::stop() {
+  if (!isRunning()) {
+    return;
+  }
+
+  ::kill(m_childPid, SIGKILL);
+  ::waitpid(m_childPid, NULL, 0);
+  m_childPid = -1;
+}
+
+bool MockHttpUpstream::isRunning() const { return m_childPid > 0; }
+
+// ============================================================================
+// Address
+// ============================================================================
+
+unsigned int MockHttpUpstream::getPort() const { return m_port; }
+
+// ============================================================================
+// Origin Loop (child process)
+// ============================================================================
+
+void MockHttpUpstream::serve(int listenFd) const {
+  std::map<int, Client*> clients;
+  unsigned int connectionCount = 0;
+
+  while (true) {
+    std::vector<struct pollfd> descriptors;
+    struct pollfd listener = {listenFd, POLLIN, 0};
+    descriptors.push_back(listener);
+    for (std::map<int, Client*>::const_iterator it = clients.begin();
+         it != clients.end(); ++it) {
+      struct pollfd entry = {it->first, POLLIN, 0};
+      descriptors.push_back(entry);
+    }
+
+    if (::poll(&descriptors[0], descriptors.size(), -1) < 0) {
+      continue;
+    }
+
+    if ((descriptors[0].revents & POLLIN) != 0) {
+      const int clientFd = ::accept(listenFd, NULL, NULL);
+      if (clientFd >= 0) {
+        Client* client = new Client();
+        client->fd = clientFd;
+        client->number = ++connectionCount;
+        client->silent = false;
+        clients[clientFd] = client;
+      }
+    }
+
+    for (std::size_t i = 1; i < descriptors.size(); ++i) {
+      if (descriptors[i].revents == 0) {
+        continue;
+      }
+
+      Client* client = clients[descriptors[i].fd];
+      char buffer[K_READ_CHUNK];
+      const ssize_t received = ::read(client->fd, buffer, sizeof(buffer));
+      bool keepOpen = received > 0;
+
+      if (keepOpen) {
+        client->buffer.append(buffer, static_cast<std::size_t>(received));
+        keepOpen = handleBuffered(*client, m_honorKeepAlive);
+      }
+
+      if (!keepOpen) {
+        ::close(client->fd);
+        clients.erase(client->fd);
+        delete client;
+      }
+    }
+  }
+}
+
+}  // namespace mocks
@@ -0,0 +1,52 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   MockHttpUpstream.hpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 10:38:22 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 10:38:22 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef MOCK_HTTP_UPSTREAM_HPP
+#define MOCK_HTTP_UPSTREAM_HPP
+
+#include <string>
+#include <sys/types.h>
+
+namespace mocks {
+
+// Local HTTP/1.1 origin used behind the reverse proxy. It runs in a forked
+// child on an ephemeral loopback port and answers each request with a
+// plain-text echo of the connection number, request line, Host header and
+// body. Target "/chunked" answers with a chunked body, "/eof" with a body
+// delimited by close, and "/silent" never answers.
+class MockHttpUpstream {
+ public:
+  explicit MockHttpUpstream(bool honorKeepAlive = true);
+  ~MockHttpUpstream();
+
+  // Server Control - Fork the origin and tear it down
+  void start();
+  void stop();
+  bool isRunning() const;
+
+  // Address - Loopback port the origin listens on
+  unsigned int getPort() const;
+
+ private:
+  MockHttpUpstream(const MockHttpUpstream&);
+  MockHttpUpstream& operator=(const MockHttpUpstream&);
+
+  bool m_honorKeepAlive;
+  unsigned int m_port;
+  pid_t m_childPid;
+
+  void serve(int listenFd) const;
+};
+
+}  // namespace mocks
+
+#endif  // MOCK_HTTP_UPSTREAM_HPP
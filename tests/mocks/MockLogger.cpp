@@ -21,8 +21,8 @@ MockLogger::LogEntry::LogEntry(LogLevel lvl, const std::string& msg)
 }
 
 // MockLogger constructor
-MockLogger::MockLogger() {
-  // Nothing to initialize - vector is empty by default
+MockLogger::MockLogger() : m_level(DEBUG) {
+  // Vector is empty by default; every level is recorded until setLevel()
 }
 
 // MockLogger destructor
@@ -48,6 +48,14 @@ void MockLogger::error(const std::string& msg) {
   log(ERROR, msg);
 }
 
+bool MockLogger::isEnabled(LogLevel level) const {
+  return level >= m_level;
+}
+
+void MockLogger::setLevel(LogLevel level) {
+  m_level = level;
+}
+
 // Getter methods implementations
 
 const std::vector<MockLogger::LogEntry>& MockLogger::getLogs() const {
@@ -94,7 +102,10 @@ void MockLogger::clear() {
 // Private method implementation
 
 void MockLogger::log(LogLevel level, const std::string& msg) {
-  // Create a new log entry and add it to our vector
+  // Drop what a real logger would drop, then record the rest
+  if (!isEnabled(level)) {
+    return;
+  }
   m_logs.push_back(LogEntry(level, msg));
 }
 
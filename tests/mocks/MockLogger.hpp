@@ -43,6 +43,8 @@ class MockLogger : public application::ports::ILogger {
   virtual void info(const std::string& msg);
   virtual void warn(const std::string& msg);
   virtual void error(const std::string& msg);
+  virtual bool isEnabled(LogLevel level) const;
+  virtual void setLevel(LogLevel level);
 
   // Getter methods - declarations only
   const std::vector<LogEntry>& getLogs() const;
@@ -55,6 +57,9 @@ class MockLogger : public application::ports::ILogger {
   // Vector that stores all our fake logs
   std::vector<LogEntry> m_logs;
 
+  // Lowest level that gets recorded (DEBUG records everything)
+  LogLevel m_level;
+
   // Private method - declaration only
   virtual void log(LogLevel level, const std::string& msg);
 };
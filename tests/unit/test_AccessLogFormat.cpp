@@ -0,0 +1,165 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_AccessLogFormat.cpp                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 08:31:44 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 08:31:44 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <gtest/gtest.h>
+#include "domain/configuration/entities/HttpConfig.hpp"
+#include "infrastructure/logging/AccessLog.hpp"
+#include "infrastructure/logging/AccessLogFormat.hpp"
+#include "infrastructure/network/primitives/RequestTiming.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+using domain::configuration::entities::HttpConfig;
+using infrastructure::logging::AccessLog;
+using infrastructure::logging::AccessLogEntry;
+using infrastructure::logging::AccessLogFormat;
+using infrastructure::network::primitives::RequestTiming;
+
+namespace {
+
+const char* const K_LOG_PATH = "/tmp/webserv_access_log_test.log";
+
+std::string readFile(const std::string& path) {
+  std::ifstream file(path.c_str());
+  return std::string(std::istreambuf_iterator<char>(file),
+                     std::istreambuf_iterator<char>());
+}
+
+}  // namespace
+
+class AccessLogFormatTest : public ::testing::Test {
+ protected:
+  void SetUp() {
+    m_entry.remoteAddress = "10.0.0.7";
+    m_entry.method = "GET";
+    m_entry.uri = "/index.html";
+    m_entry.query = "?lang=en";
+    m_entry.protocol = "HTTP/1.1";
+    m_entry.host = "example.test";
+    m_entry.userAgent = "curl/8.0";
+    m_entry.status = 200;
+    m_entry.requestLength = 96;
+    m_entry.bytesSent = 1300;
+    m_entry.bodyBytesSent = 1024;
+
+    m_timing.markAt(RequestTiming::PHASE_FIRST_BYTE, 0);
+    m_timing.markAt(RequestTiming::PHASE_HEADERS_COMPLETE, 2000);
+    m_timing.markAt(RequestTiming::PHASE_UPSTREAM_START, 5000);
+    m_timing.markAt(RequestTiming::PHASE_UPSTREAM_DONE, 125000);
+    m_timing.markAt(RequestTiming::PHASE_FIRST_BYTE_WRITTEN, 126000);
+    m_timing.markAt(RequestTiming::PHASE_LAST_BYTE_WRITTEN, 130000);
+    m_entry.timing = &m_timing;
+  }
+
+  void TearDown() { std::remove(K_LOG_PATH); }
+
+  AccessLogEntry m_entry;
+  RequestTiming m_timing;
+};
+
+// ============================================================================
+// Compile Tests
+// ============================================================================
+
+TEST_F(AccessLogFormatTest, SplitsPatternIntoSegments) {
+  AccessLogFormat format("$remote_addr - $status");
+
+  EXPECT_EQ(3u, format.getSegmentCount());
+  EXPECT_EQ(0u, format.getUnknownVariableCount());
+}
+
+TEST_F(AccessLogFormatTest, UnknownVariablesRenderAsDash) {
+  AccessLogFormat format("[$no_such_variable]");
+
+  EXPECT_EQ(1u, format.getUnknownVariableCount());
+  EXPECT_EQ("[-]", format.format(m_entry));
+}
+
+TEST_F(AccessLogFormatTest, BracedNameMayTouchFollowingText) {
+  AccessLogFormat format("${status}ok $ ${open");
+
+  EXPECT_EQ("200ok $ ${open", format.format(m_entry));
+}
+
+// ============================================================================
+// Variable Tests
+// ============================================================================
+
+TEST_F(AccessLogFormatTest, RendersRequestVariables) {
+  AccessLogFormat format(
+      "$remote_addr \"$request\" $status $body_bytes_sent/$bytes_sent "
+      "$request_length $host $args \"$http_referer\" \"$http_user_agent\"");
+
+  EXPECT_EQ("10.0.0.7 \"GET /index.html?lang=en HTTP/1.1\" 200 1024/1300 "
+            "96 example.test lang=en \"-\" \"curl/8.0\"",
+            format.format(m_entry));
+}
+
+TEST_F(AccessLogFormatTest, RendersPhaseTimings) {
+  AccessLogFormat format(
+      "rt=$request_time urt=$upstream_response_time hdr=$header_time "
+      "ttfb=$ttfb write=$write_time route=$route_time");
+
+  EXPECT_EQ("rt=0.130 urt=0.120 hdr=0.002 ttfb=0.126 write=0.004 route=-",
+            format.format(m_entry));
+}
+
+TEST_F(AccessLogFormatTest, RendersUpstreamCacheStatus) {
+  AccessLogFormat format("cache=$upstream_cache_status");
+  EXPECT_EQ("cache=-", format.format(m_entry));
+
+  m_entry.cacheStatus = "HIT";
+  EXPECT_EQ("cache=HIT", format.format(m_entry));
+}
+
+TEST_F(AccessLogFormatTest, TimingsWithoutRecorderRenderAsDash) {
+  m_entry.timing = NULL;
+  AccessLogFormat format("$request_time");
+
+  EXPECT_EQ("-", format.format(m_entry));
+}
+
+TEST_F(AccessLogFormatTest, CombinedIsTheDefaultFormat) {
+  HttpConfig config;
+  AccessLogFormat format(config.getAccessLogPattern());
+
+  EXPECT_EQ(0u, format.getUnknownVariableCount());
+  EXPECT_EQ(0u, format.format(m_entry).find("10.0.0.7 - - ["));
+}
+
+// ============================================================================
+// Writer Tests
+// ============================================================================
+
+TEST_F(AccessLogFormatTest, WritesBufferedLinesOnFlush) {
+  AccessLog log;
+  ASSERT_TRUE(log.open(K_LOG_PATH, "$request_method $uri $status"));
+
+  log.write(m_entry);
+  log.write(m_entry);
+  EXPECT_EQ("", readFile(K_LOG_PATH));
+
+  log.flush();
+  EXPECT_EQ("GET /index.html 200\nGET /index.html 200\n",
+            readFile(K_LOG_PATH));
+}
+
+TEST_F(AccessLogFormatTest, OpenFailureLeavesLogClosed) {
+  AccessLog log;
+
+  EXPECT_FALSE(log.open("/nonexistent/dir/access.log", "$status"));
+  EXPECT_FALSE(log.isOpen());
+  log.write(m_entry);
+}
@@ -0,0 +1,170 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_ByteScanner.cpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 12:58:10 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 12:58:10 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <gtest/gtest.h>
+#include "domain/shared/utils/ByteScanner.hpp"
+
+#include <string>
+#include <vector>
+
+using domain::shared::utils::ByteScanner;
+
+class ByteScannerTest : public ::testing::Test {
+ protected:
+  static const int K_FUZZ_ROUNDS = 4000;
+  static const std::size_t K_MAX_FUZZ_LENGTH = 200;
+
+  void SetUp() { m_seed = 0x2545F491u; }
+  void TearDown() {}
+
+  unsigned int next() {
+    m_seed = m_seed * 1103515245u + 12345u;
+    return m_seed >> 8;
+  }
+
+  // Biased towards the bytes the scanners care about so matches land on
+  // vector boundaries and in the scalar tail.
+  std::vector<char> randomBuffer() {
+    static const char K_ALPHABET[] = "\r\n:AZaz09-_ \t\"(),/;@[]{}~";
+    const std::size_t length = next() % K_MAX_FUZZ_LENGTH;
+    std::vector<char> buffer(length + 1);
+    for (std::size_t i = 0; i < length; ++i) {
+      const unsigned int roll = next();
+      if (roll % 4 == 0) {
+        buffer[i] = static_cast<char>(roll >> 4);
+      } else {
+        buffer[i] = K_ALPHABET[(roll >> 4) % (sizeof(K_ALPHABET) - 1)];
+      }
+    }
+    buffer.resize(length);
+    return buffer;
+  }
+
+  static const char* dataOf(const std::vector<char>& buffer) {
+    return buffer.empty() ? "" : &buffer[0];
+  }
+
+  unsigned int m_seed;
+};
+
+// ============================================================================
+// Basic Scan Tests
+// ============================================================================
+
+TEST_F(ByteScannerTest, FindCrlf) {
+  const std::string text = "Host: example.com\r\nAccept: */*\r\n";
+  EXPECT_EQ(17u, ByteScanner::findCrlf(text.c_str(), text.size()));
+  EXPECT_EQ(ByteScanner::NPOS, ByteScanner::findCrlf("abc\r", 4));
+  EXPECT_EQ(ByteScanner::NPOS, ByteScanner::findCrlf("", 0));
+}
+
+TEST_F(ByteScannerTest, FindCrlfAcrossVectorBoundary) {
+  for (std::size_t pos = 0; pos < 70; ++pos) {
+    std::string text(72, 'x');
+    text[pos] = '\r';
+    text[pos + 1] = '\n';
+    EXPECT_EQ(pos, ByteScanner::findCrlf(text.c_str(), text.size()));
+  }
+}
+
+TEST_F(ByteScannerTest, FindByte) {
+  const std::string text(40, 'a');
+  EXPECT_EQ(ByteScanner::NPOS,
+            ByteScanner::findByte(text.c_str(), text.size(), ':'));
+  EXPECT_EQ(4u, ByteScanner::findByte("Host: x", 7, ':'));
+}
+
+TEST_F(ByteScannerTest, InvalidTokenChar) {
+  const std::string valid = "X-Forwarded-For!#$%&'*+.^_`|~09azAZ";
+  EXPECT_EQ(ByteScanner::NPOS,
+            ByteScanner::findInvalidTokenChar(valid.c_str(), valid.size()));
+  EXPECT_EQ(3u, ByteScanner::findInvalidTokenChar("Bad Name", 8));
+  EXPECT_EQ(0u, ByteScanner::findInvalidTokenChar("\x80", 1));
+  EXPECT_EQ(1u, ByteScanner::findInvalidTokenChar("a\x7f", 2));
+}
+
+TEST_F(ByteScannerTest, ToLowerAscii) {
+  std::string text = "Content-TYPE: X-Custom-Header-With-Mixed-Case \xC3\x89";
+  ByteScanner::toLowerAscii(&text[0], text.size());
+  EXPECT_EQ("content-type: x-custom-header-with-mixed-case \xC3\x89", text);
+}
+
+// ============================================================================
+// Vector And Scalar Equivalence Tests
+// ============================================================================
+
+TEST_F(ByteScannerTest, FuzzFindCrlfMatchesScalar) {
+  for (int round = 0; round < K_FUZZ_ROUNDS; ++round) {
+    const std::vector<char> buffer = randomBuffer();
+    ASSERT_EQ(ByteScanner::findCrlfScalar(dataOf(buffer), buffer.size()),
+              ByteScanner::findCrlf(dataOf(buffer), buffer.size()))
+        << "round " << round;
+  }
+}
+
+TEST_F(ByteScannerTest, FuzzFindByteMatchesScalar) {
+  for (int round = 0; round < K_FUZZ_ROUNDS; ++round) {
+    const std::vector<char> buffer = randomBuffer();
+    const char needle = static_cast<char>(next());
+    ASSERT_EQ(ByteScanner::findByteScalar(dataOf(buffer), buffer.size(), ':'),
+              ByteScanner::findByte(dataOf(buffer), buffer.size(), ':'))
+        << "round " << round;
+    ASSERT_EQ(
+        ByteScanner::findByteScalar(dataOf(buffer), buffer.size(), needle),
+        ByteScanner::findByte(dataOf(buffer), buffer.size(), needle))
+        << "round " << round;
+  }
+}
+
+TEST_F(ByteScannerTest, FuzzFindInvalidTokenCharMatchesScalar) {
+  for (int round = 0; round < K_FUZZ_ROUNDS; ++round) {
+    std::vector<char> buffer = randomBuffer();
+    const std::size_t skip = buffer.empty() ? 0 : next() % buffer.size();
+    for (std::size_t i = 0; i < skip; ++i) {
+      buffer[i] = 'a' + static_cast<char>(i % 26);
+    }
+    ASSERT_EQ(
+        ByteScanner::findInvalidTokenCharScalar(dataOf(buffer), buffer.size()),
+        ByteScanner::findInvalidTokenChar(dataOf(buffer), buffer.size()))
+        << "round " << round;
+  }
+}
+
+TEST_F(ByteScannerTest, EveryByteClassifiedLikeScalar) {
+  for (int value = 0; value < 256; ++value) {
+    const std::string text(48, static_cast<char>(value));
+    const bool expected = ByteScanner::isTokenChar(
+        static_cast<unsigned char>(value));
+    EXPECT_EQ(expected ? ByteScanner::NPOS : 0u,
+              ByteScanner::findInvalidTokenChar(text.c_str(), text.size()))
+        << "byte " << value;
+
+    std::string folded = text;
+    std::string expectedFold = text;
+    ByteScanner::toLowerAscii(&folded[0], folded.size());
+    ByteScanner::toLowerAsciiScalar(&expectedFold[0], expectedFold.size());
+    EXPECT_EQ(expectedFold, folded) << "byte " << value;
+  }
+}
+
+TEST_F(ByteScannerTest, FuzzToLowerAsciiMatchesScalar) {
+  for (int round = 0; round < K_FUZZ_ROUNDS; ++round) {
+    std::vector<char> vectorPath = randomBuffer();
+    std::vector<char> scalarPath = vectorPath;
+    if (vectorPath.empty()) {
+      continue;
+    }
+    ByteScanner::toLowerAscii(&vectorPath[0], vectorPath.size());
+    ByteScanner::toLowerAsciiScalar(&scalarPath[0], scalarPath.size());
+    ASSERT_TRUE(vectorPath == scalarPath) << "round " << round;
+  }
+}
@@ -281,6 +281,90 @@ TEST_F(CgiConfigTest, SetParametersInvalidName) {
   EXPECT_THROW(config.setParameters(params), CgiConfigException);
 }
 
+// ============================================================================
+// Setter Tests - FastCGI Pass
+// ============================================================================
+
+TEST_F(CgiConfigTest, SetFastcgiPassAcceptsUnixAndTcp) {
+  CgiConfig config;
+  EXPECT_FALSE(config.hasFastcgiPass());
+
+  EXPECT_NO_THROW(config.setFastcgiPass("unix:/run/php/php-fpm.sock"));
+  EXPECT_EQ("unix:/run/php/php-fpm.sock", config.getFastcgiPass());
+  EXPECT_NO_THROW(config.setFastcgiPass("127.0.0.1:9000"));
+  EXPECT_NO_THROW(config.setFastcgiPass("localhost:9000"));
+  EXPECT_TRUE(config.hasFastcgiPass());
+  EXPECT_TRUE(config.isValid());
+}
+
+TEST_F(CgiConfigTest, SetFastcgiPassRejectsMalformedAddress) {
+  CgiConfig config;
+  EXPECT_THROW(config.setFastcgiPass(""), CgiConfigException);
+  EXPECT_THROW(config.setFastcgiPass("unix:relative.sock"), CgiConfigException);
+  EXPECT_THROW(config.setFastcgiPass("127.0.0.1"), CgiConfigException);
+  EXPECT_THROW(config.setFastcgiPass("127.0.0.1:0"), CgiConfigException);
+  EXPECT_THROW(config.setFastcgiPass("127.0.0.1:70000"), CgiConfigException);
+  EXPECT_THROW(config.setFastcgiPass(":9000"), CgiConfigException);
+  EXPECT_FALSE(config.hasFastcgiPass());
+}
+
+TEST_F(CgiConfigTest, FastcgiPassIsCopiedAndCompared) {
+  CgiConfig config;
+  config.setFastcgiPass("127.0.0.1:9000");
+
+  CgiConfig copy(config);
+  EXPECT_EQ("127.0.0.1:9000", copy.getFastcgiPass());
+  EXPECT_TRUE(copy == config);
+
+  copy.clear();
+  EXPECT_FALSE(copy.hasFastcgiPass());
+  EXPECT_TRUE(copy != config);
+}
+
+// ============================================================================
+// Setter Tests - Worker Pool
+// ============================================================================
+
+TEST_F(CgiConfigTest, WorkerPoolNeedsCountAndBootstrap) {
+  CgiConfig config = CgiConfig::createPythonCgi();
+  EXPECT_FALSE(config.hasWorkerPool());
+  EXPECT_EQ(CgiConfig::DEFAULT_WORKER_MAX_REQUESTS,
+            config.getWorkerMaxRequests());
+
+  config.setWorkerPool(4, 500);
+  EXPECT_FALSE(config.hasWorkerPool());
+
+  config.setWorkerBootstrap("/etc/webserv/python_worker.py");
+  EXPECT_TRUE(config.hasWorkerPool());
+  EXPECT_EQ(4u, config.getWorkerCount());
+  EXPECT_EQ(500u, config.getWorkerMaxRequests());
+  EXPECT_EQ("/etc/webserv/python_worker.py", config.getWorkerBootstrap());
+  EXPECT_NO_THROW(config.validate());
+}
+
+TEST_F(CgiConfigTest, WorkerPoolRejectsInvalidSettings) {
+  CgiConfig config;
+  EXPECT_THROW(config.setWorkerPool(CgiConfig::MAX_WORKER_COUNT + 1, 10),
+               CgiConfigException);
+  EXPECT_THROW(config.setWorkerPool(2, 0), CgiConfigException);
+  EXPECT_THROW(config.setWorkerBootstrap(""), CgiConfigException);
+  EXPECT_EQ(0u, config.getWorkerCount());
+}
+
+TEST_F(CgiConfigTest, WorkerPoolIsCopiedAndCleared) {
+  CgiConfig config = CgiConfig::createPythonCgi();
+  config.setWorkerPool(2, 50);
+  config.setWorkerBootstrap("/etc/webserv/python_worker.py");
+
+  CgiConfig copy(config);
+  EXPECT_TRUE(copy == config);
+  EXPECT_TRUE(copy.hasWorkerPool());
+
+  copy.clear();
+  EXPECT_FALSE(copy.hasWorkerPool());
+  EXPECT_TRUE(copy != config);
+}
+
 // ============================================================================
 // Validation Tests
 // ============================================================================
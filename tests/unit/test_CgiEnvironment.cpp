@@ -0,0 +1,274 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_CgiEnvironment.cpp                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 21:34:02 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 21:34:02 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <gtest/gtest.h>
+#include "domain/configuration/value_objects/CgiConfig.hpp"
+#include "domain/filesystem/value_objects/Path.hpp"
+#include "domain/http/entities/HttpRequest.hpp"
+#include "domain/http/value_objects/HttpMethod.hpp"
+#include "domain/http/value_objects/RouteMatchInfo.hpp"
+#include "domain/shared/value_objects/RegexPattern.hpp"
+#include "infrastructure/cgi/adapters/CgiExecutor.hpp"
+#include "infrastructure/cgi/adapters/CgiStream.hpp"
+#include "infrastructure/cgi/exceptions/CgiExecutionException.hpp"
+#include "infrastructure/cgi/primitives/CgiEnvironment.hpp"
+#include "infrastructure/cgi/primitives/CgiRequest.hpp"
+#include "mocks/MockLogger.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <poll.h>
+#include <string>
+#include <vector>
+
+using domain::configuration::value_objects::CgiConfig;
+using infrastructure::cgi::adapters::CgiExecutor;
+using infrastructure::cgi::adapters::CgiStream;
+using infrastructure::cgi::exceptions::CgiExecutionException;
+using infrastructure::cgi::primitives::CgiEnvironment;
+using infrastructure::cgi::primitives::CgiRequest;
+
+class CgiEnvironmentTest : public ::testing::Test {
+ protected:
+  CgiEnvironmentTest()
+      : m_scriptDir("/tmp/webserv_cgi_env_test"),
+        m_config("/usr/bin/python3",
+                 domain::filesystem::value_objects::Path(m_scriptDir),
+                 domain::shared::value_objects::RegexPattern("\\.py$")) {}
+
+  void SetUp() {
+    system(("mkdir -p " + m_scriptDir).c_str());
+    m_config.addParameter("APP_MODE", "production");
+
+    writeScript("env.py",
+                "import os, sys\n"
+                "sys.stdout.write('Content-Type: text/plain\\n\\n')\n"
+                "for k in sorted(os.environ):\n"
+                "    sys.stdout.write(k + '=' + os.environ[k] + '\\n')\n");
+  }
+
+  void TearDown() { system(("rm -rf " + m_scriptDir).c_str()); }
+
+  void writeScript(const std::string& name, const std::string& source) const {
+    const std::string path = m_scriptDir + "/" + name;
+    std::ofstream file(path.c_str());
+    file << source;
+    file.close();
+    system(("chmod 755 " + path).c_str());
+  }
+
+  domain::http::entities::HttpRequest makeHttpRequest(
+      const std::string& target) const {
+    domain::http::entities::HttpRequest httpRequest;
+    httpRequest.setMethod(domain::http::value_objects::HttpMethod("GET"));
+    httpRequest.setPath(domain::filesystem::value_objects::Path(target));
+    return httpRequest;
+  }
+
+  domain::http::value_objects::RouteMatchInfo makeMatch(
+      const std::string& script) const {
+    const domain::filesystem::value_objects::Path scriptPath(m_scriptDir + "/" +
+                                                             script);
+    return domain::http::value_objects::RouteMatchInfo::createForFile(
+        scriptPath, scriptPath.toString());
+  }
+
+  static std::vector<std::string> toStrings(const std::vector<char*>& envp) {
+    std::vector<std::string> entries;
+    for (std::size_t i = 0; i < envp.size() && envp[i] != NULL; ++i) {
+      entries.push_back(envp[i]);
+    }
+    return entries;
+  }
+
+  static std::size_t countPrefix(const std::vector<std::string>& entries,
+                                 const std::string& prefix) {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+      if (entries[i].compare(0, prefix.size(), prefix) == 0) {
+        ++count;
+      }
+    }
+    return count;
+  }
+
+  static void awaitHeaders(CgiStream& stream) {
+    while (!stream.advance()) {
+      struct pollfd descriptor;
+      descriptor.fd = stream.getFd();
+      descriptor.events = POLLIN;
+      descriptor.revents = 0;
+      poll(&descriptor, 1, 100);
+      stream.checkTimeout(std::time(NULL));
+    }
+  }
+
+  static std::string readAll(CgiStream& stream) {
+    std::string body;
+    char chunk[1024];
+    while (true) {
+      const ssize_t bytesRead = stream.read(chunk, sizeof(chunk));
+      if (bytesRead == 0) {
+        return body;
+      }
+      if (bytesRead == CgiStream::K_WOULD_BLOCK) {
+        struct pollfd descriptor;
+        descriptor.fd = stream.getFd();
+        descriptor.events = POLLIN;
+        descriptor.revents = 0;
+        poll(&descriptor, 1, 1000);
+        continue;
+      }
+      body.append(chunk, static_cast<std::size_t>(bytesRead));
+    }
+  }
+
+  std::string m_scriptDir;
+  CgiConfig m_config;
+  tests::mocks::MockLogger m_logger;
+};
+
+// ============================================================================
+// Location Environment Tests
+// ============================================================================
+
+TEST_F(CgiEnvironmentTest, RendersLocationVariablesOnce) {
+  const CgiEnvironment environment(m_config);
+  const std::vector<std::string>& entries = environment.getEntries();
+
+  EXPECT_EQ(1u, countPrefix(entries, "APP_MODE=production"));
+  EXPECT_EQ(1u, countPrefix(entries, "GATEWAY_INTERFACE=CGI/1.1"));
+  EXPECT_EQ(1u, countPrefix(entries, "SERVER_PROTOCOL=HTTP/1.1"));
+  EXPECT_EQ(1u, countPrefix(entries, "REDIRECT_STATUS=200"));
+  EXPECT_EQ(0u, countPrefix(entries, "REQUEST_METHOD=GET"));
+  EXPECT_EQ(m_scriptDir, environment.getDocumentRoot());
+}
+
+TEST_F(CgiEnvironmentTest, RelativeDocumentRootIsResolved) {
+  const std::string resolved = CgiEnvironment::resolveDocumentRoot("cgi-bin");
+
+  ASSERT_FALSE(resolved.empty());
+  EXPECT_EQ('/', resolved[0]);
+  EXPECT_EQ("/cgi-bin", resolved.substr(resolved.size() - 8));
+}
+
+TEST_F(CgiEnvironmentTest, ExecutorCachesEnvironmentPerLocation) {
+  CgiExecutor executor(m_logger);
+
+  const CgiEnvironment& first = executor.getSharedEnvironment(m_config);
+  const CgiEnvironment& second = executor.getSharedEnvironment(m_config);
+  EXPECT_EQ(&first, &second);
+  EXPECT_EQ(1u, executor.getEnvironmentCacheHits());
+  EXPECT_EQ(1u, executor.getEnvironmentCacheMisses());
+
+  executor.clearEnvironmentCache();
+  EXPECT_EQ(first.size(), executor.getSharedEnvironment(m_config).size());
+  EXPECT_EQ(2u, executor.getEnvironmentCacheMisses());
+}
+
+// ============================================================================
+// Request Environment Tests
+// ============================================================================
+
+TEST_F(CgiEnvironmentTest, SharedBlockPrecedesRequestVariables) {
+  const CgiEnvironment environment(m_config);
+  const CgiRequest request(makeHttpRequest("/env.py"), m_config,
+                           makeMatch("env.py"), "localhost", 8080,
+                           environment);
+
+  EXPECT_EQ(request.getEnvironment().end(),
+            request.getEnvironment().find("GATEWAY_INTERFACE"));
+
+  const std::vector<std::string> entries = toStrings(request.buildEnvp());
+  std::size_t position = 0;
+  for (std::size_t i = 0; i < environment.size(); ++i) {
+    const std::string& entry = environment.getEntries()[i];
+    if (request.getEnvironment().count(entry.substr(0, entry.find('='))) ==
+        0) {
+      ASSERT_LT(position, entries.size());
+      EXPECT_EQ(entry, entries[position++]);
+    }
+  }
+  EXPECT_EQ(1u, countPrefix(entries, "REQUEST_METHOD="));
+  EXPECT_EQ(1u, countPrefix(entries, "REQUEST_METHOD=GET"));
+  EXPECT_EQ(1u, countPrefix(entries, "SERVER_PORT=8080"));
+}
+
+TEST_F(CgiEnvironmentTest, RequestVariableOverridesSharedEntry) {
+  const CgiEnvironment environment(m_config);
+  CgiRequest request(makeHttpRequest("/env.py"), m_config, makeMatch("env.py"),
+                     "localhost", 8080, environment);
+  request.setEnvironmentVariable("APP_MODE", "debug");
+
+  const std::vector<std::string> entries = toStrings(request.buildEnvp());
+  EXPECT_EQ(1u, countPrefix(entries, "APP_MODE="));
+  EXPECT_EQ(1u, countPrefix(entries, "APP_MODE=debug"));
+}
+
+TEST_F(CgiEnvironmentTest, MatchesFullyBuiltEnvironment) {
+  const CgiEnvironment environment(m_config);
+  const CgiRequest shared(makeHttpRequest("/env.py"), m_config,
+                          makeMatch("env.py"), "localhost", 8080, environment);
+  const CgiRequest full(makeHttpRequest("/env.py"), m_config,
+                        makeMatch("env.py"), "localhost", 8080);
+
+  std::vector<std::string> sharedEntries = toStrings(shared.buildEnvp());
+  std::vector<std::string> fullEntries = toStrings(full.buildEnvp());
+  std::sort(sharedEntries.begin(), sharedEntries.end());
+  std::sort(fullEntries.begin(), fullEntries.end());
+  EXPECT_EQ(fullEntries, sharedEntries);
+}
+
+// ============================================================================
+// Spawn Tests
+// ============================================================================
+
+TEST_F(CgiEnvironmentTest, SpawnedScriptSeesCombinedEnvironment) {
+  CgiExecutor executor(m_logger);
+  const CgiRequest request(makeHttpRequest("/env.py"), m_config,
+                           makeMatch("env.py"), "localhost", 8080,
+                           executor.getSharedEnvironment(m_config));
+
+  CgiStream* stream = executor.start(request);
+  awaitHeaders(*stream);
+  const std::string output = readAll(*stream);
+  stream->finish();
+  executor.release(stream);
+
+  EXPECT_NE(std::string::npos, output.find("APP_MODE=production\n"));
+  EXPECT_NE(std::string::npos, output.find("REQUEST_METHOD=GET\n"));
+  EXPECT_NE(std::string::npos,
+            output.find("SCRIPT_FILENAME=" + m_scriptDir + "/env.py\n"));
+}
+
+TEST_F(CgiEnvironmentTest, MissingInterpreterFailsToSpawn) {
+  const CgiConfig broken(
+      m_scriptDir + "/env.py",
+      domain::filesystem::value_objects::Path(m_scriptDir),
+      domain::shared::value_objects::RegexPattern("\\.py$"));
+  writeScript("env.py", "#!/nonexistent/interpreter\n");
+
+  CgiExecutor executor(m_logger);
+  const CgiRequest request(makeHttpRequest("/env.py"), broken,
+                           makeMatch("env.py"), "localhost", 8080,
+                           executor.getSharedEnvironment(broken));
+
+  try {
+    delete executor.start(request);
+    FAIL() << "expected CgiExecutionException";
+  } catch (const CgiExecutionException& ex) {
+    EXPECT_NE(std::string::npos,
+              std::string(ex.what()).find("Failed to execute CGI script"));
+  }
+}
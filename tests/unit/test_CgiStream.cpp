@@ -0,0 +1,279 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_CgiStream.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 20:21:09 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 20:21:09 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <gtest/gtest.h>
+#include "domain/configuration/value_objects/CgiConfig.hpp"
+#include "domain/filesystem/value_objects/Path.hpp"
+#include "domain/http/entities/HttpRequest.hpp"
+#include "domain/http/value_objects/HttpMethod.hpp"
+#include "domain/http/value_objects/RouteMatchInfo.hpp"
+#include "domain/shared/value_objects/RegexPattern.hpp"
+#include "infrastructure/cgi/adapters/CgiExecutor.hpp"
+#include "infrastructure/cgi/adapters/CgiStream.hpp"
+#include "infrastructure/cgi/exceptions/CgiExecutionException.hpp"
+#include "infrastructure/cgi/primitives/CgiRequest.hpp"
+#include "mocks/MockLogger.hpp"
+
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <poll.h>
+#include <signal.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using domain::configuration::value_objects::CgiConfig;
+using infrastructure::cgi::adapters::CgiExecutor;
+using infrastructure::cgi::adapters::CgiStream;
+using infrastructure::cgi::exceptions::CgiExecutionException;
+using infrastructure::cgi::primitives::CgiRequest;
+using infrastructure::cgi::primitives::CgiResponse;
+
+class CgiStreamTest : public ::testing::Test {
+ protected:
+  void SetUp() {
+    m_scriptDir = "/tmp/webserv_cgi_stream_test";
+    system(("mkdir -p " + m_scriptDir).c_str());
+
+    writeScript("report.py",
+                "import sys\n"
+                "sys.stdout.write('Content-Type: text/plain\\r\\n\\r\\n')\n"
+                "for i in range(5000):\n"
+                "    sys.stdout.write('%039d\\n' % i)\n");
+    writeScript("lf.py",
+                "import sys\n"
+                "sys.stdout.write('Status: 201\\n')\n"
+                "sys.stdout.write('Content-Type: text/csv\\n\\n')\n"
+                "sys.stdout.write('a,b\\n')\n");
+    writeScript("fail.py",
+                "import sys\nsys.stderr.write('boom')\nsys.exit(2)\n");
+    writeScript("noblank.py",
+                "import sys\nsys.stdout.write('Content-Type: text/plain')\n");
+    writeScript("silent.py", "import time\ntime.sleep(5)\n");
+    writeScript("trailing.py",
+                "import sys\n"
+                "sys.stdout.write('Content-Type: text/plain\\n\\nok')\n"
+                "sys.stdout.flush()\n"
+                "sys.stderr.write('late')\n"
+                "sys.exit(3)\n");
+    writeScript("lingering.py",
+                "import sys, time\n"
+                "sys.stdout.write('Content-Type: text/plain\\n\\n')\n"
+                "sys.stdout.flush()\n"
+                "time.sleep(30)\n");
+  }
+
+  void TearDown() { system(("rm -rf " + m_scriptDir).c_str()); }
+
+  void writeScript(const std::string& name, const std::string& source) const {
+    const std::string path = m_scriptDir + "/" + name;
+    std::ofstream file(path.c_str());
+    file << source;
+    file.close();
+    system(("chmod 755 " + path).c_str());
+  }
+
+  CgiRequest makeRequest(const std::string& script) const {
+    const CgiConfig config(
+        "/usr/bin/python3",
+        domain::filesystem::value_objects::Path(m_scriptDir),
+        domain::shared::value_objects::RegexPattern("\\.py$"));
+
+    domain::http::entities::HttpRequest httpRequest;
+    httpRequest.setMethod(domain::http::value_objects::HttpMethod("GET"));
+    httpRequest.setPath(domain::filesystem::value_objects::Path("/" + script));
+
+    const domain::filesystem::value_objects::Path scriptPath(m_scriptDir + "/" +
+                                                             script);
+    return CgiRequest(
+        httpRequest, config,
+        domain::http::value_objects::RouteMatchInfo::createForFile(
+            scriptPath, scriptPath.toString()),
+        "localhost", 8080);
+  }
+
+  static CgiResponse readHead(CgiStream& stream) {
+    while (!stream.advance()) {
+      struct pollfd descriptor;
+      descriptor.fd = stream.getFd();
+      descriptor.events = POLLIN;
+      descriptor.revents = 0;
+      poll(&descriptor, 1, 100);
+      stream.checkTimeout(std::time(NULL));
+    }
+    return stream.getResponse();
+  }
+
+  static std::string readBody(CgiStream& stream, std::size_t chunkSize,
+                              std::size_t& largestRead) {
+    std::string body;
+    std::vector<char> chunk(chunkSize);
+    largestRead = 0;
+
+    while (true) {
+      const ssize_t bytesRead = stream.read(&chunk[0], chunk.size());
+      if (bytesRead == 0) {
+        return body;
+      }
+      if (bytesRead == CgiStream::K_WOULD_BLOCK) {
+        struct pollfd descriptor;
+        descriptor.fd = stream.getFd();
+        descriptor.events = POLLIN;
+        descriptor.revents = 0;
+        poll(&descriptor, 1, 1000);
+        continue;
+      }
+      body.append(&chunk[0], static_cast<std::size_t>(bytesRead));
+      if (static_cast<std::size_t>(bytesRead) > largestRead) {
+        largestRead = static_cast<std::size_t>(bytesRead);
+      }
+    }
+  }
+
+  std::string m_scriptDir;
+  tests::mocks::MockLogger m_logger;
+};
+
+// ============================================================================
+// Header Block Tests
+// ============================================================================
+
+TEST_F(CgiStreamTest, ReadHeadersStopsAtBlankLine) {
+  CgiExecutor executor(m_logger);
+  CgiStream* stream = executor.start(makeRequest("report.py"));
+
+  const CgiResponse head = readHead(*stream);
+  EXPECT_EQ("text/plain", head.getContentType());
+  EXPECT_TRUE(head.getBody().empty());
+
+  std::size_t largestRead = 0;
+  const std::string body = readBody(*stream, 1024, largestRead);
+  EXPECT_EQ(5000u * 40u, body.size());
+  EXPECT_EQ(0u, body.find("000000000000000000000000000000000000000\n"));
+  EXPECT_LE(largestRead, 1024u);
+
+  stream->finish();
+  EXPECT_TRUE(stream->isFinished());
+  delete stream;
+}
+
+TEST_F(CgiStreamTest, LfOnlyHeaderBlockIsAccepted) {
+  CgiExecutor executor(m_logger);
+  CgiStream* stream = executor.start(makeRequest("lf.py"));
+
+  const CgiResponse head = readHead(*stream);
+  EXPECT_TRUE(head.hasStatus());
+  EXPECT_EQ(201u, head.getStatus().getValue());
+  EXPECT_EQ("text/csv", head.getContentType());
+
+  std::size_t largestRead = 0;
+  EXPECT_EQ("a,b\n", readBody(*stream, 64, largestRead));
+  delete stream;
+}
+
+// ============================================================================
+// Failure Tests
+// ============================================================================
+
+TEST_F(CgiStreamTest, ScriptFailingBeforeHeadersThrows) {
+  CgiExecutor executor(m_logger);
+  CgiStream* stream = executor.start(makeRequest("fail.py"));
+
+  try {
+    readHead(*stream);
+    FAIL() << "expected CgiExecutionException";
+  } catch (const CgiExecutionException& ex) {
+    EXPECT_NE(std::string::npos,
+              std::string(ex.what()).find("exit code 2: boom"));
+  }
+  EXPECT_TRUE(stream->isFinished());
+  delete stream;
+}
+
+TEST_F(CgiStreamTest, MissingHeaderSeparatorThrows) {
+  CgiExecutor executor(m_logger);
+  CgiStream* stream = executor.start(makeRequest("noblank.py"));
+
+  EXPECT_THROW(readHead(*stream), CgiExecutionException);
+  delete stream;
+}
+
+TEST_F(CgiStreamTest, HeaderTimeoutKillsScript) {
+  CgiExecutor executor(m_logger);
+  executor.setTimeout(1);
+  CgiStream* stream = executor.start(makeRequest("silent.py"));
+
+  EXPECT_THROW(readHead(*stream), CgiExecutionException);
+  EXPECT_TRUE(stream->isFinished());
+  EXPECT_TRUE(m_logger.hasLog(ERROR, "CGI script execution timeout"));
+  delete stream;
+}
+
+// ============================================================================
+// Lifecycle Tests
+// ============================================================================
+
+TEST_F(CgiStreamTest, ExitStatusIsLoggedAfterBody) {
+  CgiExecutor executor(m_logger);
+  CgiStream* stream = executor.start(makeRequest("trailing.py"));
+
+  readHead(*stream);
+  std::size_t largestRead = 0;
+  EXPECT_EQ("ok", readBody(*stream, 64, largestRead));
+
+  stream->finish();
+  executor.release(stream);
+  while (executor.getExitingCount() > 0) {
+    usleep(10000);
+    executor.reapStreams(std::time(NULL));
+  }
+  EXPECT_TRUE(m_logger.hasLog(WARN, "CGI script exited with code 3: late"));
+}
+
+TEST_F(CgiStreamTest, DestroyingUnfinishedStreamKillsScript) {
+  CgiExecutor executor(m_logger);
+  CgiStream* stream = executor.start(makeRequest("lingering.py"));
+
+  readHead(*stream);
+  const pid_t pid = stream->getPid();
+  ASSERT_GT(pid, 0);
+
+  delete stream;
+  EXPECT_NE(0, kill(pid, 0));
+}
+
+TEST_F(CgiStreamTest, ReleasedScriptIsKilledAfterGracePeriod) {
+  CgiExecutor executor(m_logger);
+  CgiStream* stream = executor.start(makeRequest("lingering.py"));
+
+  readHead(*stream);
+  const pid_t pid = stream->getPid();
+  ASSERT_GT(pid, 0);
+
+  stream->finish();
+  executor.release(stream);
+  const std::time_t released = std::time(NULL);
+  EXPECT_EQ(1u, executor.getExitingCount());
+  executor.reapStreams(released);
+  EXPECT_EQ(1u, executor.getExitingCount());
+  EXPECT_EQ(0, kill(pid, 0));
+
+  for (int attempt = 0; attempt < 100 && executor.getExitingCount() > 0;
+       ++attempt) {
+    executor.reapStreams(released + 1);
+    usleep(10000);
+  }
+  EXPECT_EQ(0u, executor.getExitingCount());
+  EXPECT_NE(0, kill(pid, 0));
+  EXPECT_TRUE(m_logger.hasLog(WARN, "CGI script terminated by signal 9"));
+}
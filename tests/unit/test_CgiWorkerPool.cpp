@@ -0,0 +1,305 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_CgiWorkerPool.cpp                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 19:05:33 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 19:05:33 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <gtest/gtest.h>
+#include "domain/configuration/value_objects/CgiConfig.hpp"
+#include "domain/filesystem/value_objects/Path.hpp"
+#include "domain/http/entities/HttpRequest.hpp"
+#include "domain/http/value_objects/HttpMethod.hpp"
+#include "domain/http/value_objects/RouteMatchInfo.hpp"
+#include "domain/shared/value_objects/RegexPattern.hpp"
+#include "infrastructure/cgi/adapters/CgiWorkerPool.hpp"
+#include "infrastructure/cgi/adapters/CgiWorkerSession.hpp"
+#include "infrastructure/cgi/exceptions/CgiExecutionException.hpp"
+#include "infrastructure/cgi/primitives/CgiRequest.hpp"
+#include "mocks/MockLogger.hpp"
+
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <poll.h>
+#include <string>
+#include <vector>
+
+using domain::configuration::value_objects::CgiConfig;
+using infrastructure::cgi::adapters::CgiWorkerPool;
+using infrastructure::cgi::adapters::CgiWorkerSession;
+using infrastructure::cgi::exceptions::CgiExecutionException;
+using infrastructure::cgi::primitives::CgiRequest;
+using infrastructure::cgi::primitives::CgiResponse;
+
+class CgiWorkerPoolTest : public ::testing::Test {
+ protected:
+  void SetUp() {
+    m_scriptDir = "/tmp/webserv_cgi_worker_test";
+    system(("mkdir -p " + m_scriptDir).c_str());
+
+    writeScript("echo.py",
+                "import builtins, os, sys\n"
+                "builtins.hits = getattr(builtins, 'hits', 0) + 1\n"
+                "out = 'Content-Type: text/plain\\r\\n\\r\\n'\n"
+                "out += 'pid=%d\\nhits=%d\\n' % (os.getpid(), builtins.hits)\n"
+                "out += 'method=' + os.environ.get('REQUEST_METHOD', '')\n"
+                "sys.stdout.write(out + '\\nbody=' + sys.stdin.read())\n");
+    writeScript("sleep.py", "import time\ntime.sleep(5)\n");
+    writeScript("fail.py",
+                "import sys\nsys.stderr.write('boom')\nsys.exit(3)\n");
+  }
+
+  void TearDown() { system(("rm -rf " + m_scriptDir).c_str()); }
+
+  void writeScript(const std::string& name, const std::string& source) const {
+    std::ofstream file((m_scriptDir + "/" + name).c_str());
+    file << source;
+  }
+
+  CgiConfig makeConfig(std::size_t workers, std::size_t maxRequests) const {
+    CgiConfig config("/usr/bin/python3",
+                     domain::filesystem::value_objects::Path(m_scriptDir),
+                     domain::shared::value_objects::RegexPattern("\\.py$"));
+    config.setWorkerPool(workers, maxRequests);
+    config.setWorkerBootstrap("../conf/cgi/python_worker.py");
+    return config;
+  }
+
+  CgiRequest makeRequest(const CgiConfig& config, const std::string& script,
+                         const std::string& method,
+                         const std::string& body) const {
+    domain::http::entities::HttpRequest httpRequest;
+    httpRequest.setMethod(domain::http::value_objects::HttpMethod(method));
+    httpRequest.setPath(domain::filesystem::value_objects::Path("/" + script));
+    if (!body.empty()) {
+      httpRequest.setBody(std::vector<char>(body.begin(), body.end()));
+    }
+
+    const domain::filesystem::value_objects::Path scriptPath(m_scriptDir + "/" +
+                                                             script);
+    return CgiRequest(
+        httpRequest, config,
+        domain::http::value_objects::RouteMatchInfo::createForFile(
+            scriptPath, scriptPath.toString()),
+        "localhost", 8080);
+  }
+
+  static void waitFor(const CgiWorkerSession& session) {
+    struct pollfd descriptor;
+    descriptor.fd = session.getFd();
+    descriptor.events = session.wantsWrite() ? POLLIN | POLLOUT : POLLIN;
+    descriptor.revents = 0;
+    poll(&descriptor, 1, 100);
+  }
+
+  static void await(CgiWorkerSession& session) {
+    while (!session.advance()) {
+      waitFor(session);
+      session.checkTimeout(std::time(NULL));
+    }
+  }
+
+  CgiResponse execute(CgiWorkerPool& pool, const CgiConfig& config,
+                      const CgiRequest& request) {
+    CgiWorkerSession session(m_logger, pool, config, request);
+    session.start();
+    await(session);
+    return session.buildResponse();
+  }
+
+  static std::string bodyOf(const CgiResponse& response) {
+    return std::string(response.getBody().begin(), response.getBody().end());
+  }
+
+  static std::string fieldOf(const std::string& body, const std::string& key) {
+    const std::size_t start = body.find(key + "=");
+    if (start == std::string::npos) {
+      return "";
+    }
+    const std::size_t valueStart = start + key.size() + 1;
+    return body.substr(valueStart, body.find('\n', valueStart) - valueStart);
+  }
+
+  std::string m_scriptDir;
+  tests::mocks::MockLogger m_logger;
+};
+
+// ============================================================================
+// Execution Tests
+// ============================================================================
+
+TEST_F(CgiWorkerPoolTest, ExecuteRunsScriptInsideWorker) {
+  CgiWorkerPool pool(m_logger);
+  const CgiConfig config = makeConfig(1, 100);
+
+  const CgiResponse response =
+      execute(pool, config, makeRequest(config, "echo.py", "POST", "a=1"));
+
+  EXPECT_EQ("text/plain", response.getContentType());
+  const std::string body = bodyOf(response);
+  EXPECT_EQ("POST", fieldOf(body, "method"));
+  EXPECT_NE(std::string::npos, body.find("body=a=1"));
+}
+
+TEST_F(CgiWorkerPoolTest, FailingScriptReportsExitCodeAndKeepsWorker) {
+  CgiWorkerPool pool(m_logger);
+  const CgiConfig config = makeConfig(1, 100);
+
+  EXPECT_THROW(execute(pool, config, makeRequest(config, "fail.py", "GET", "")),
+               CgiExecutionException);
+  EXPECT_TRUE(m_logger.hasLog(WARN, "CGI worker stderr: boom"));
+
+  execute(pool, config, makeRequest(config, "echo.py", "GET", ""));
+  EXPECT_EQ(1u, pool.getSpawnCount());
+}
+
+TEST_F(CgiWorkerPoolTest, MissingBootstrapThrows) {
+  CgiWorkerPool pool(m_logger);
+  CgiConfig config = makeConfig(1, 100);
+  config.setWorkerBootstrap("/nonexistent/webserv_worker.py");
+
+  EXPECT_THROW(execute(pool, config, makeRequest(config, "echo.py", "GET", "")),
+               CgiExecutionException);
+  EXPECT_EQ(0u, pool.getWorkerCount(config));
+}
+
+// ============================================================================
+// Lifecycle Tests
+// ============================================================================
+
+TEST_F(CgiWorkerPoolTest, PrespawnStartsConfiguredWorkers) {
+  CgiWorkerPool pool(m_logger);
+  const CgiConfig config = makeConfig(3, 100);
+
+  pool.prespawn(config);
+
+  EXPECT_EQ(3u, pool.getWorkerCount(config));
+  EXPECT_EQ(3u, pool.getSpawnCount());
+}
+
+TEST_F(CgiWorkerPoolTest, WorkerIsReusedAcrossRequests) {
+  CgiWorkerPool pool(m_logger);
+  const CgiConfig config = makeConfig(1, 100);
+
+  const std::string first = bodyOf(
+      execute(pool, config, makeRequest(config, "echo.py", "GET", "")));
+  const std::string second = bodyOf(
+      execute(pool, config, makeRequest(config, "echo.py", "GET", "")));
+
+  EXPECT_EQ(fieldOf(first, "pid"), fieldOf(second, "pid"));
+  EXPECT_EQ("1", fieldOf(first, "hits"));
+  EXPECT_EQ("2", fieldOf(second, "hits"));
+  EXPECT_EQ(1u, pool.getSpawnCount());
+}
+
+TEST_F(CgiWorkerPoolTest, WorkerIsRecycledAfterMaxRequests) {
+  CgiWorkerPool pool(m_logger);
+  const CgiConfig config = makeConfig(1, 2);
+
+  std::vector<std::string> bodies;
+  for (int i = 0; i < 3; ++i) {
+    bodies.push_back(bodyOf(
+        execute(pool, config, makeRequest(config, "echo.py", "GET", ""))));
+  }
+
+  EXPECT_EQ(fieldOf(bodies[0], "pid"), fieldOf(bodies[1], "pid"));
+  EXPECT_NE(fieldOf(bodies[1], "pid"), fieldOf(bodies[2], "pid"));
+  EXPECT_EQ("1", fieldOf(bodies[2], "hits"));
+  EXPECT_EQ(2u, pool.getSpawnCount());
+}
+
+TEST_F(CgiWorkerPoolTest, TimeoutKillsWorkerAndRespawns) {
+  CgiWorkerPool pool(m_logger);
+  const CgiConfig config = makeConfig(1, 100);
+  pool.setTimeout(1);
+
+  EXPECT_THROW(
+      execute(pool, config, makeRequest(config, "sleep.py", "GET", "")),
+      CgiExecutionException);
+  EXPECT_EQ(1u, pool.getWorkerCount(config));
+  EXPECT_EQ(2u, pool.getSpawnCount());
+
+  pool.setTimeout(CgiWorkerPool::DEFAULT_TIMEOUT_SECONDS);
+  const std::string body = bodyOf(
+      execute(pool, config, makeRequest(config, "echo.py", "GET", "")));
+  EXPECT_EQ("1", fieldOf(body, "hits"));
+}
+
+// ============================================================================
+// Queueing Tests
+// ============================================================================
+
+TEST_F(CgiWorkerPoolTest, BusyPoolQueuesUntilWorkerIsReleased) {
+  CgiWorkerPool pool(m_logger);
+  const CgiConfig config = makeConfig(1, 100);
+
+  CgiWorkerSession first(m_logger, pool, config,
+                         makeRequest(config, "echo.py", "GET", ""));
+  CgiWorkerSession second(m_logger, pool, config,
+                          makeRequest(config, "echo.py", "GET", ""));
+  first.setOwner(7);
+  second.setOwner(9);
+  first.start();
+  second.start();
+
+  EXPECT_EQ(-1, second.getFd());
+  EXPECT_FALSE(second.advance());
+
+  await(first);
+  const std::string firstBody = bodyOf(first.buildResponse());
+  std::vector<int> owners;
+  pool.collectReady(owners);
+  EXPECT_TRUE(owners.empty());
+
+  first.finish();
+  pool.collectReady(owners);
+  ASSERT_EQ(1u, owners.size());
+  EXPECT_EQ(9, owners[0]);
+
+  await(second);
+  const std::string secondBody = bodyOf(second.buildResponse());
+  EXPECT_EQ(fieldOf(firstBody, "pid"), fieldOf(secondBody, "pid"));
+  EXPECT_EQ("2", fieldOf(secondBody, "hits"));
+}
+
+TEST_F(CgiWorkerPoolTest, CancelledWaitIsNotWoken) {
+  CgiWorkerPool pool(m_logger);
+  const CgiConfig config = makeConfig(1, 100);
+
+  CgiWorkerSession first(m_logger, pool, config,
+                         makeRequest(config, "echo.py", "GET", ""));
+  CgiWorkerSession second(m_logger, pool, config,
+                          makeRequest(config, "echo.py", "GET", ""));
+  first.setOwner(7);
+  second.setOwner(9);
+  first.start();
+  second.start();
+  second.finish();
+
+  await(first);
+  first.finish();
+
+  std::vector<int> owners;
+  pool.collectReady(owners);
+  EXPECT_TRUE(owners.empty());
+}
+
+TEST_F(CgiWorkerPoolTest, ScriptRunsInItsOwnDirectory) {
+  CgiWorkerPool pool(m_logger);
+  const CgiConfig config = makeConfig(1, 100);
+  writeScript("cwd.py",
+              "import os, sys\n"
+              "sys.stdout.write('Content-Type: text/plain\\r\\n\\r\\n'"
+              " + 'cwd=' + os.getcwd() + '\\n')\n");
+
+  const std::string body =
+      bodyOf(execute(pool, config, makeRequest(config, "cwd.py", "GET", "")));
+
+  EXPECT_EQ(m_scriptDir, fieldOf(body, "cwd"));
+}
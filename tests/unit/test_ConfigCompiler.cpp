@@ -0,0 +1,426 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_ConfigCompiler.cpp                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 00:41:09 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 00:41:09 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <gtest/gtest.h>
+#include "domain/configuration/entities/HttpConfig.hpp"
+#include "domain/configuration/value_objects/CacheZoneConfig.hpp"
+#include "domain/configuration/value_objects/LimitZoneConfig.hpp"
+#include "domain/configuration/value_objects/RequestLimitConfig.hpp"
+#include "domain/configuration/value_objects/UpstreamConfig.hpp"
+#include "domain/shared/exceptions/BinaryFormatException.hpp"
+#include "domain/shared/utils/BinaryReader.hpp"
+#include "domain/shared/utils/BinaryWriter.hpp"
+#include "infrastructure/config/adapters/ConfigProvider.hpp"
+#include "infrastructure/config/parsers/ConfigCompiler.hpp"
+#include "infrastructure/config/parsers/ConfigParser.hpp"
+#include "mocks/MockLogger.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+
+using domain::configuration::entities::HttpConfig;
+using domain::configuration::entities::LocationConfig;
+using domain::configuration::entities::ServerConfig;
+using domain::configuration::value_objects::CacheZoneConfig;
+using domain::configuration::value_objects::LimitZoneConfig;
+using domain::configuration::value_objects::RequestLimitConfig;
+using domain::configuration::value_objects::UpstreamConfig;
+using domain::shared::exceptions::BinaryFormatException;
+using domain::shared::utils::BinaryReader;
+using domain::shared::utils::BinaryWriter;
+using infrastructure::config::adapters::ConfigProvider;
+using infrastructure::config::parsers::ConfigCompiler;
+using infrastructure::config::parsers::ConfigParser;
+
+class ConfigCompilerTest : public ::testing::Test {
+ protected:
+  void SetUp() { mkdir(K_INCLUDE_DIR, 0755); }
+
+  void TearDown() {
+    std::remove(K_CONFIG_PATH);
+    std::remove(ConfigCompiler::compiledPathFor(K_CONFIG_PATH).c_str());
+    std::remove(K_SERVER_PATH);
+    std::remove(K_EXTRA_PATH);
+    rmdir(K_INCLUDE_DIR);
+  }
+
+  static void writeFile(const std::string& path, const std::string& content) {
+    std::ofstream file(path.c_str(), std::ios::out | std::ios::binary);
+    file << content;
+  }
+
+  static std::string readFile(const std::string& path) {
+    std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file),
+                       std::istreambuf_iterator<char>());
+  }
+
+  static std::string configText(const std::string& keepalive) {
+    return "http {\n"
+           "    keepalive_timeout " +
+           keepalive +
+           ";\n"
+           "    types {\n"
+           "        text/html html htm;\n"
+           "        image/webp webp;\n"
+           "    }\n"
+           "    default_type text/plain;\n"
+           "    log_format timed '$remote_addr \"$request\" ' "
+           "'$status rt=$request_time';\n"
+           "    access_log /tmp/compiled_access.log timed;\n"
+           "    slow_request_threshold 250ms;\n"
+           "    upstream app {\n"
+           "        least_conn;\n"
+           "        server 127.0.0.1:9001 weight=3;\n"
+           "        server 127.0.0.1:9002 max_fails=2 fail_timeout=5s;\n"
+           "        keepalive 16;\n"
+           "    }\n"
+           "    proxy_cache_path /tmp/webserv_compiled_cache levels=1:2 "
+           "keys_zone=pages:10m max_size=1m inactive=30m;\n"
+           "    limit_req_zone $binary_remote_addr zone=perip:1m rate=30r/m;\n"
+           "    limit_conn_zone $host zone=perhost:64k;\n"
+           "    server {\n"
+           "        listen 127.0.0.1:8097 backlog=128 reuseport;\n"
+           "        server_name compiled.localhost www.compiled.localhost;\n"
+           "        root /tmp;\n"
+           "        index index.html;\n"
+           "        error_page 404 /tmp/404.html;\n"
+           "        location / {\n"
+           "            limit_except GET POST { deny all; }\n"
+           "            autoindex on;\n"
+           "            try_files $uri $uri/ =404;\n"
+           "            add_header X-Compiled yes;\n"
+           "        }\n"
+           "        location ~ \\.py$ {\n"
+           "            limit_except GET POST { deny all; }\n"
+           "            script /usr/bin/python3;\n"
+           "            cgi_root /tmp;\n"
+           "        }\n"
+           "        location /old { return 301 /new; }\n"
+           "        location /status { stub_status prometheus; }\n"
+           "        location /api/ {\n"
+           "            proxy_pass http://app/v1/;\n"
+           "            proxy_read_timeout 30s;\n"
+           "            proxy_cache pages;\n"
+           "            proxy_cache_key $host$request_uri;\n"
+           "            proxy_cache_valid 200 302 10m;\n"
+           "            proxy_cache_valid 404 1m;\n"
+           "            proxy_cache_lock on;\n"
+           "            limit_req zone=perip burst=5 nodelay;\n"
+           "            limit_conn perhost 10;\n"
+           "            limit_req_status 429;\n"
+           "        }\n"
+           "    }\n"
+           "    include " +
+           std::string(K_INCLUDE_DIR) +
+           "/*.conf;\n"
+           "}\n";
+  }
+
+  void writeSources(const std::string& keepalive) {
+    writeFile(K_SERVER_PATH,
+              "server {\n"
+              "    listen 8096;\n"
+              "    server_name included.localhost;\n"
+              "    root /tmp;\n"
+              "    location / { limit_except GET { deny all; } }\n"
+              "}\n");
+    writeFile(K_CONFIG_PATH, configText(keepalive));
+  }
+
+  HttpConfig* parse() {
+    ConfigParser parser(m_logger);
+    return parser.parseFile(K_CONFIG_PATH);
+  }
+
+  void compileSources() {
+    HttpConfig* config = parse();
+    ConfigCompiler compiler(m_logger);
+    compiler.compile(*config, ConfigCompiler::compiledPathFor(K_CONFIG_PATH));
+    delete config;
+  }
+
+  HttpConfig* loadCompiled() {
+    ConfigCompiler compiler(m_logger);
+    return compiler.load(ConfigCompiler::compiledPathFor(K_CONFIG_PATH));
+  }
+
+  static std::string tree(const HttpConfig& config) {
+    BinaryWriter writer;
+    config.serialize(writer);
+    return writer.getBuffer();
+  }
+
+  static const char* const K_CONFIG_PATH;
+  static const char* const K_INCLUDE_DIR;
+  static const char* const K_SERVER_PATH;
+  static const char* const K_EXTRA_PATH;
+
+  tests::mocks::MockLogger m_logger;
+};
+
+const char* const ConfigCompilerTest::K_CONFIG_PATH =
+    "/tmp/webserv_compiler_test.conf";
+const char* const ConfigCompilerTest::K_INCLUDE_DIR =
+    "/tmp/webserv_compiler_test.d";
+const char* const ConfigCompilerTest::K_SERVER_PATH =
+    "/tmp/webserv_compiler_test.d/server.conf";
+const char* const ConfigCompilerTest::K_EXTRA_PATH =
+    "/tmp/webserv_compiler_test.d/extra.conf";
+
+// ============================================================================
+// Binary Codec Tests
+// ============================================================================
+
+TEST_F(ConfigCompilerTest, BinaryCodecRoundTripsPrimitives) {
+  BinaryWriter writer;
+  writer.writeU8(0xAB);
+  writer.writeU32(0xDEADBEEFUL);
+  writer.writeSize(123456789u);
+  writer.writeBool(true);
+  writer.writeString(std::string("a\0b", 3));
+
+  BinaryReader reader(writer.getBuffer().data(), writer.size());
+  EXPECT_EQ(0xAB, reader.readU8());
+  EXPECT_EQ(0xDEADBEEFUL, reader.readU32());
+  EXPECT_EQ(123456789u, reader.readSize());
+  EXPECT_TRUE(reader.readBool());
+  EXPECT_EQ(std::string("a\0b", 3), reader.readString());
+  EXPECT_TRUE(reader.isAtEnd());
+}
+
+TEST_F(ConfigCompilerTest, BinaryReaderRejectsTruncatedString) {
+  BinaryWriter writer;
+  writer.writeString("truncated");
+
+  BinaryReader reader(writer.getBuffer().data(), writer.size() - 1);
+  EXPECT_THROW(reader.readString(), BinaryFormatException);
+}
+
+// ============================================================================
+// Round Trip Tests
+// ============================================================================
+
+TEST_F(ConfigCompilerTest, CompiledImageLoadsToSameTree) {
+  writeSources("30");
+  HttpConfig* parsed = parse();
+  compileSources();
+
+  HttpConfig* loaded = loadCompiled();
+  ASSERT_TRUE(loaded != NULL);
+  EXPECT_EQ(tree(*parsed), tree(*loaded));
+  EXPECT_EQ(parsed->getSourceFiles(), loaded->getSourceFiles());
+  EXPECT_TRUE(loaded->isAccessLogEnabled());
+  EXPECT_EQ("$remote_addr \"$request\" $status rt=$request_time",
+            loaded->getAccessLogPattern());
+  EXPECT_EQ(250u, loaded->getSlowRequestThreshold());
+  EXPECT_TRUE(m_logger.hasLog(INFO, "Loaded compiled configuration"));
+
+  delete parsed;
+  delete loaded;
+}
+
+TEST_F(ConfigCompilerTest, LoadedTreeKeepsLookupIndexes) {
+  writeSources("30");
+  compileSources();
+
+  HttpConfig* loaded = loadCompiled();
+  ASSERT_TRUE(loaded != NULL);
+  ASSERT_EQ(2u, loaded->getServerConfigs().size());
+  EXPECT_EQ(30u, loaded->getKeepaliveTimeout());
+  EXPECT_EQ("image/webp", loaded->getMimeTypes().lookupFilename("a.WEBP"));
+  EXPECT_EQ("text/plain", loaded->getMimeTypes().lookupFilename("a.css"));
+
+  const ServerConfig* server = loaded->selectServer("compiled.localhost", 8097);
+  ASSERT_TRUE(server != NULL);
+  EXPECT_TRUE(server->getListenDirectives()[0].isReusePort());
+  EXPECT_EQ(128, server->getListenDirectives()[0].getBacklog());
+
+  const LocationConfig* script = server->findLocation("/cgi/run.py");
+  ASSERT_TRUE(script != NULL);
+  EXPECT_EQ("/usr/bin/python3", script->getCgiConfig().getScriptPath());
+
+  const LocationConfig* proxied = server->findLocation("/api/users");
+  ASSERT_TRUE(proxied != NULL);
+  EXPECT_TRUE(proxied->hasProxyPass());
+  EXPECT_EQ("app", proxied->getProxyPass().getHost());
+  EXPECT_EQ(30u, proxied->getProxyReadTimeout());
+  EXPECT_EQ("pages", proxied->getProxyCache().getZone());
+  EXPECT_EQ("$host$request_uri", proxied->getProxyCache().getKey());
+  EXPECT_EQ(600u, proxied->getProxyCache().getValidity(302));
+  EXPECT_EQ(60u, proxied->getProxyCache().getValidity(404));
+  EXPECT_EQ(0u, proxied->getProxyCache().getValidity(500));
+  EXPECT_TRUE(proxied->getProxyCache().isLockEnabled());
+
+  const RequestLimitConfig& limits = proxied->getRequestLimits();
+  ASSERT_EQ(1u, limits.getRequestRules().size());
+  EXPECT_EQ("perip", limits.getRequestRules()[0].zone);
+  EXPECT_EQ(5u, limits.getRequestRules()[0].burst);
+  EXPECT_TRUE(limits.getRequestRules()[0].nodelay);
+  ASSERT_EQ(1u, limits.getConnectionRules().size());
+  EXPECT_EQ(10u, limits.getConnectionRules()[0].limit);
+  EXPECT_EQ(429u, limits.getRequestStatus());
+  EXPECT_EQ(RequestLimitConfig::DEFAULT_STATUS, limits.getConnectionStatus());
+
+  ASSERT_EQ(2u, loaded->getLimitZones().size());
+  const LimitZoneConfig* perIp = loaded->findLimitZone("perip");
+  ASSERT_TRUE(perIp != NULL);
+  EXPECT_EQ(LimitZoneConfig::TYPE_REQUEST, perIp->getType());
+  EXPECT_EQ("$binary_remote_addr", perIp->getKey());
+  EXPECT_EQ(1024u * 1024u, perIp->getSize());
+  EXPECT_EQ(500u, perIp->getRate());
+  const LimitZoneConfig* perHost = loaded->findLimitZone("perhost");
+  ASSERT_TRUE(perHost != NULL);
+  EXPECT_EQ(LimitZoneConfig::TYPE_CONNECTION, perHost->getType());
+
+  const HttpConfig::CacheZones& zones = loaded->getCacheZones();
+  ASSERT_EQ(1u, zones.size());
+  const CacheZoneConfig* zone = loaded->findCacheZone("pages");
+  ASSERT_TRUE(zone != NULL);
+  EXPECT_EQ("/tmp/webserv_compiled_cache", zone->getPath());
+  EXPECT_EQ("1:2", zone->formatLevels());
+  EXPECT_EQ(1024u * 1024u, zone->getMaxSize());
+  EXPECT_EQ(1800u, zone->getInactive());
+
+  const UpstreamConfig* upstream = loaded->findUpstream("app");
+  ASSERT_TRUE(upstream != NULL);
+  EXPECT_EQ(UpstreamConfig::BALANCE_LEAST_CONN, upstream->getBalance());
+  EXPECT_EQ(16u, upstream->getKeepalive());
+  ASSERT_EQ(2u, upstream->getServers().size());
+  EXPECT_EQ(3u, upstream->getServers()[0].weight);
+  EXPECT_EQ(2u, upstream->getServers()[1].maxFails);
+  EXPECT_EQ(5u, upstream->getServers()[1].failTimeout);
+
+  delete loaded;
+}
+
+// ============================================================================
+// Staleness Tests
+// ============================================================================
+
+TEST_F(ConfigCompilerTest, MissingImageLoadsNothing) {
+  EXPECT_TRUE(loadCompiled() == NULL);
+  EXPECT_EQ(0u, m_logger.getLogCountByLevel(WARN));
+}
+
+TEST_F(ConfigCompilerTest, ModifiedSourceMakesImageStale) {
+  writeSources("30");
+  compileSources();
+  writeSources("45");
+
+  EXPECT_TRUE(loadCompiled() == NULL);
+  EXPECT_TRUE(m_logger.hasLog(INFO, "is stale"));
+}
+
+TEST_F(ConfigCompilerTest, ContentHashCatchesEditWithRestoredMtime) {
+  writeSources("30");
+  struct stat original;
+  ASSERT_EQ(0, stat(K_CONFIG_PATH, &original));
+  compileSources();
+
+  writeSources("31");
+  struct utimbuf times;
+  times.actime = original.st_atime;
+  times.modtime = original.st_mtime;
+  ASSERT_EQ(0, utime(K_CONFIG_PATH, &times));
+
+  EXPECT_TRUE(loadCompiled() == NULL);
+  EXPECT_TRUE(m_logger.hasLog(INFO, K_CONFIG_PATH));
+}
+
+TEST_F(ConfigCompilerTest, NewFileInGlobbedDirectoryMakesImageStale) {
+  writeSources("30");
+  compileSources();
+  writeFile(K_EXTRA_PATH, "# empty\n");
+
+  EXPECT_TRUE(loadCompiled() == NULL);
+  EXPECT_TRUE(m_logger.hasLog(INFO, K_INCLUDE_DIR));
+}
+
+// ============================================================================
+// Corruption Tests
+// ============================================================================
+
+TEST_F(ConfigCompilerTest, CorruptedPayloadIsRejected) {
+  writeSources("30");
+  compileSources();
+  const std::string path = ConfigCompiler::compiledPathFor(K_CONFIG_PATH);
+  std::string image = readFile(path);
+  image[image.size() - 1] ^= 0x5A;
+  writeFile(path, image);
+
+  EXPECT_TRUE(loadCompiled() == NULL);
+  EXPECT_TRUE(m_logger.hasLog(WARN, "checksum mismatch"));
+}
+
+TEST_F(ConfigCompilerTest, TruncatedImageIsRejected) {
+  writeSources("30");
+  compileSources();
+  const std::string path = ConfigCompiler::compiledPathFor(K_CONFIG_PATH);
+  const std::string image = readFile(path);
+  writeFile(path, image.substr(0, image.size() / 2));
+
+  EXPECT_TRUE(loadCompiled() == NULL);
+  EXPECT_TRUE(m_logger.hasLog(WARN, "Ignoring compiled configuration"));
+}
+
+TEST_F(ConfigCompilerTest, OtherFormatVersionIsRejected) {
+  writeSources("30");
+  compileSources();
+  const std::string path = ConfigCompiler::compiledPathFor(K_CONFIG_PATH);
+  std::string image = readFile(path);
+  image[ConfigCompiler::K_MAGIC_LENGTH] =
+      static_cast<char>(ConfigCompiler::FORMAT_VERSION + 1);
+  writeFile(path, image);
+
+  std::ostringstream expected;
+  expected << "format version " << ConfigCompiler::FORMAT_VERSION + 1
+           << ", expected " << ConfigCompiler::FORMAT_VERSION;
+  EXPECT_TRUE(loadCompiled() == NULL);
+  EXPECT_TRUE(m_logger.hasLog(WARN, expected.str()));
+}
+
+// ============================================================================
+// Provider Tests
+// ============================================================================
+
+TEST_F(ConfigCompilerTest, ProviderPrefersFreshImage) {
+  writeSources("30");
+  compileSources();
+  m_logger.clear();
+
+  ConfigProvider provider(m_logger);
+  provider.load(K_CONFIG_PATH);
+
+  EXPECT_TRUE(m_logger.hasLog(INFO, "Loaded compiled configuration"));
+  EXPECT_FALSE(m_logger.hasLog(INFO, "Successfully parsed configuration"));
+  EXPECT_EQ(2u, provider.getAllServers().size());
+}
+
+TEST_F(ConfigCompilerTest, ProviderParsesWhenImageIsStale) {
+  writeSources("30");
+  compileSources();
+  writeSources("45");
+  m_logger.clear();
+
+  ConfigProvider provider(m_logger);
+  provider.load(K_CONFIG_PATH);
+
+  EXPECT_TRUE(m_logger.hasLog(INFO, "Successfully parsed configuration"));
+  EXPECT_EQ(45u, provider.getConfiguration().getKeepaliveTimeout());
+}
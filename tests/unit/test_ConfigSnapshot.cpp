@@ -0,0 +1,183 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_ConfigSnapshot.cpp                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 23:41:27 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 23:41:27 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <gtest/gtest.h>
+#include "domain/configuration/entities/ConfigSnapshot.hpp"
+#include "domain/configuration/entities/HttpConfig.hpp"
+#include "infrastructure/config/adapters/ConfigProvider.hpp"
+#include "infrastructure/config/exceptions/ConfigException.hpp"
+#include "mocks/MockLogger.hpp"
+#include "shared/utils/SignalHandler.hpp"
+
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using domain::configuration::entities::ConfigSnapshot;
+using domain::configuration::entities::HttpConfig;
+using infrastructure::config::adapters::ConfigProvider;
+using infrastructure::config::exceptions::ConfigException;
+using shared::utils::SignalHandler;
+
+class ConfigSnapshotTest : public ::testing::Test {
+ protected:
+  void TearDown() { std::remove(K_CONFIG_PATH); }
+
+  static void writeConfig(unsigned int port, const std::string& defaultType) {
+    std::ofstream file(K_CONFIG_PATH);
+    file << "http {\n"
+         << "    default_type " << defaultType << ";\n"
+         << "    server {\n"
+         << "        listen " << port << ";\n"
+         << "        server_name localhost;\n"
+         << "        root /tmp;\n"
+         << "        location / { limit_except GET { deny all; } }\n"
+         << "    }\n"
+         << "}\n";
+  }
+
+  static const char* const K_CONFIG_PATH;
+
+  tests::mocks::MockLogger m_logger;
+};
+
+const char* const ConfigSnapshotTest::K_CONFIG_PATH =
+    "/tmp/webserv_snapshot_test.conf";
+
+// ============================================================================
+// Reference Counting Tests
+// ============================================================================
+
+TEST_F(ConfigSnapshotTest, CreateStartsWithOneReference) {
+  ConfigSnapshot* snapshot = ConfigSnapshot::create(new HttpConfig(), 7);
+
+  EXPECT_EQ(1u, snapshot->getReferenceCount());
+  EXPECT_EQ(7ul, snapshot->getGeneration());
+  EXPECT_TRUE(snapshot->getServers().empty());
+  EXPECT_TRUE(snapshot->release());
+}
+
+TEST_F(ConfigSnapshotTest, LastReleaseDestroysSnapshot) {
+  ConfigSnapshot* snapshot = ConfigSnapshot::create(new HttpConfig(), 1);
+  snapshot->acquire();
+  snapshot->acquire();
+
+  EXPECT_FALSE(snapshot->release());
+  EXPECT_FALSE(snapshot->release());
+  EXPECT_EQ(1u, snapshot->getReferenceCount());
+  EXPECT_TRUE(snapshot->release());
+}
+
+TEST_F(ConfigSnapshotTest, NullConfigurationIsRejected) {
+  EXPECT_ANY_THROW(ConfigSnapshot::create(NULL, 1));
+}
+
+// ============================================================================
+// Reload Tests
+// ============================================================================
+
+TEST_F(ConfigSnapshotTest, ReloadPublishesNewGeneration) {
+  writeConfig(8101, "text/plain");
+  ConfigProvider provider(m_logger);
+  provider.load(K_CONFIG_PATH);
+
+  ConfigSnapshot& first = provider.getSnapshot();
+  EXPECT_EQ(1ul, first.getGeneration());
+
+  writeConfig(8102, "application/x-reloaded");
+  provider.reload();
+
+  ConfigSnapshot& second = provider.getSnapshot();
+  EXPECT_EQ(2ul, second.getGeneration());
+  EXPECT_EQ("application/x-reloaded",
+            provider.getConfiguration().getMimeTypes().getDefaultType());
+  ASSERT_EQ(1u, provider.getAllServers().size());
+  EXPECT_EQ(8102u, provider.getAllServers()[0]
+                       ->getListenDirectives()[0]
+                       .getPort()
+                       .getValue());
+}
+
+TEST_F(ConfigSnapshotTest, HeldGenerationSurvivesReload) {
+  writeConfig(8101, "text/plain");
+  ConfigProvider provider(m_logger);
+  provider.load(K_CONFIG_PATH);
+
+  ConfigSnapshot& held = provider.getSnapshot();
+  held.acquire();
+
+  writeConfig(8102, "application/x-reloaded");
+  provider.reload();
+
+  EXPECT_NE(&held, &provider.getSnapshot());
+  EXPECT_EQ(1u, held.getReferenceCount());
+  EXPECT_EQ("text/plain",
+            held.getConfiguration().getMimeTypes().getDefaultType());
+  EXPECT_EQ(
+      8101u,
+      held.getServers()[0]->getListenDirectives()[0].getPort().getValue());
+  EXPECT_TRUE(held.release());
+}
+
+TEST_F(ConfigSnapshotTest, FailedReloadKeepsCurrentGeneration) {
+  writeConfig(8101, "text/plain");
+  ConfigProvider provider(m_logger);
+  provider.load(K_CONFIG_PATH);
+  ConfigSnapshot* current = &provider.getSnapshot();
+
+  std::ofstream(K_CONFIG_PATH) << "http {\n    server {\n";
+  EXPECT_THROW(provider.reload(), ConfigException);
+
+  EXPECT_TRUE(provider.isValid());
+  EXPECT_EQ(current, &provider.getSnapshot());
+  EXPECT_EQ(1ul, provider.getSnapshot().getGeneration());
+}
+
+TEST_F(ConfigSnapshotTest, PreparedReloadWaitsForPublish) {
+  writeConfig(8101, "text/plain");
+  ConfigProvider provider(m_logger);
+  provider.load(K_CONFIG_PATH);
+  ConfigSnapshot* current = &provider.getSnapshot();
+
+  writeConfig(8102, "application/x-reloaded");
+  ConfigSnapshot* rejected = provider.prepareReload();
+  EXPECT_EQ(2ul, rejected->getGeneration());
+  EXPECT_EQ(current, &provider.getSnapshot());
+  EXPECT_TRUE(rejected->release());
+
+  ConfigSnapshot* prepared = provider.prepareReload();
+  EXPECT_EQ(2ul, prepared->getGeneration());
+  EXPECT_EQ(current, &provider.getSnapshot());
+
+  provider.publish(prepared);
+  EXPECT_EQ(prepared, &provider.getSnapshot());
+  EXPECT_EQ(1u, prepared->getReferenceCount());
+  EXPECT_EQ("application/x-reloaded",
+            provider.getConfiguration().getMimeTypes().getDefaultType());
+}
+
+// ============================================================================
+// Signal Tests
+// ============================================================================
+
+TEST_F(ConfigSnapshotTest, SighupRequestsReloadWithoutShutdown) {
+  SignalHandler::initialize();
+  std::raise(SIGHUP);
+
+  EXPECT_TRUE(SignalHandler::isReloadRequested());
+  EXPECT_FALSE(SignalHandler::isShutdownRequested());
+
+  SignalHandler::resetReloadFlag();
+  EXPECT_FALSE(SignalHandler::isReloadRequested());
+  SignalHandler::cleanup();
+}
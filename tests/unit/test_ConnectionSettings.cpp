@@ -0,0 +1,228 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_ConnectionSettings.cpp                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 12:42:07 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 12:42:07 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <gtest/gtest.h>
+#include "domain/configuration/entities/HttpConfig.hpp"
+#include "domain/configuration/entities/ServerConfig.hpp"
+#include "domain/configuration/exceptions/HttpConfigException.hpp"
+#include "domain/configuration/exceptions/ServerConfigException.hpp"
+#include "infrastructure/config/exceptions/SyntaxException.hpp"
+#include "infrastructure/config/handlers/GlobalDirectiveHandler.hpp"
+#include "infrastructure/config/handlers/ServerDirectiveHandler.hpp"
+#include "infrastructure/config/parsers/ConfigParser.hpp"
+#include "mocks/MockLogger.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using domain::configuration::entities::HttpConfig;
+using domain::configuration::entities::ServerConfig;
+using domain::configuration::exceptions::HttpConfigException;
+using domain::configuration::exceptions::ServerConfigException;
+using infrastructure::config::exceptions::SyntaxException;
+using infrastructure::config::handlers::GlobalDirectiveHandler;
+using infrastructure::config::handlers::ServerDirectiveHandler;
+using infrastructure::config::parsers::ConfigParser;
+
+class ConnectionSettingsTest : public ::testing::Test {
+ protected:
+  void TearDown() { std::remove(K_CONFIG_PATH); }
+
+  static std::vector<std::string> args(const std::string& value) {
+    return std::vector<std::string>(1, value);
+  }
+
+  void setGlobal(const std::string& directive, const std::string& value) {
+    GlobalDirectiveHandler handler(m_logger, m_httpConfig);
+    handler.handle(directive, args(value), 1);
+  }
+
+  void setServer(const std::string& directive, const std::string& value) {
+    ServerDirectiveHandler handler(m_logger, m_server);
+    handler.handle(directive, args(value), 1);
+  }
+
+  HttpConfig* parse(const std::string& httpDirectives,
+                    const std::string& serverDirectives) {
+    std::ofstream file(K_CONFIG_PATH);
+    file << "http {\n"
+         << httpDirectives << "    server {\n"
+         << "        listen 8097;\n"
+         << "        server_name localhost;\n"
+         << "        root /tmp;\n"
+         << serverDirectives
+         << "        location / { limit_except GET { deny all; } }\n"
+         << "    }\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser(m_logger);
+    return parser.parseFile(K_CONFIG_PATH);
+  }
+
+  static const char* const K_CONFIG_PATH;
+
+  tests::mocks::MockLogger m_logger;
+  HttpConfig m_httpConfig;
+  ServerConfig m_server;
+};
+
+const char* const ConnectionSettingsTest::K_CONFIG_PATH =
+    "/tmp/webserv_connection_settings_test.conf";
+
+// ============================================================================
+// Time Parsing Tests
+// ============================================================================
+
+TEST_F(ConnectionSettingsTest, TimeUnitsAreConvertedToSeconds) {
+  setGlobal("keepalive_timeout", "30");
+  EXPECT_EQ(30u, m_httpConfig.getKeepaliveTimeout());
+
+  setGlobal("keepalive_timeout", "45s");
+  EXPECT_EQ(45u, m_httpConfig.getKeepaliveTimeout());
+
+  setGlobal("keepalive_timeout", "2m");
+  EXPECT_EQ(120u, m_httpConfig.getKeepaliveTimeout());
+
+  setServer("send_timeout", "5m");
+  EXPECT_EQ(300u, m_server.getSendTimeout());
+}
+
+TEST_F(ConnectionSettingsTest, OverflowingTimeIsRejected) {
+  EXPECT_THROW(setGlobal("send_timeout", "99999999h"), SyntaxException);
+  EXPECT_THROW(setGlobal("send_timeout", "4294967296s"), SyntaxException);
+  EXPECT_THROW(setServer("keepalive_timeout", "71582789m"), SyntaxException);
+  EXPECT_EQ(60u, m_httpConfig.getSendTimeout());
+}
+
+TEST_F(ConnectionSettingsTest, MalformedTimeIsRejected) {
+  EXPECT_THROW(setGlobal("client_header_timeout", "10x"), SyntaxException);
+  EXPECT_THROW(setGlobal("client_header_timeout", "m"), SyntaxException);
+  EXPECT_THROW(setGlobal("client_header_timeout", ""), SyntaxException);
+  EXPECT_THROW(setGlobal("client_header_timeout", "-5"), SyntaxException);
+  EXPECT_THROW(setServer("client_body_timeout", "1.5s"), SyntaxException);
+  EXPECT_THROW(setServer("client_body_timeout", "10ms"), SyntaxException);
+}
+
+TEST_F(ConnectionSettingsTest, TimeAboveSetterLimitIsRejected) {
+  EXPECT_THROW(setGlobal("keepalive_timeout", "1h"), SyntaxException);
+  EXPECT_THROW(setServer("client_header_timeout", "301"), SyntaxException);
+  EXPECT_EQ(60u, m_server.getClientHeaderTimeout());
+}
+
+TEST_F(ConnectionSettingsTest, KeepaliveRequestsTakesPlainCount) {
+  setGlobal("keepalive_requests", "500");
+  EXPECT_EQ(500u, m_httpConfig.getKeepaliveRequests());
+
+  EXPECT_THROW(setGlobal("keepalive_requests", "10s"), SyntaxException);
+  EXPECT_THROW(setGlobal("keepalive_requests", "0"), SyntaxException);
+  EXPECT_THROW(setServer("keepalive_requests", "100001"), SyntaxException);
+}
+
+TEST_F(ConnectionSettingsTest, DirectiveTakesExactlyOneArgument) {
+  GlobalDirectiveHandler handler(m_logger, m_httpConfig);
+  std::vector<std::string> two(2, "10");
+
+  EXPECT_THROW(handler.handle("keepalive_timeout", two, 1), SyntaxException);
+  EXPECT_THROW(handler.handle("send_timeout", std::vector<std::string>(), 1),
+               SyntaxException);
+}
+
+// ============================================================================
+// Setter Tests
+// ============================================================================
+
+TEST_F(ConnectionSettingsTest, HttpConfigSettersEnforceRanges) {
+  m_httpConfig.setClientBodyTimeout(0);
+  EXPECT_EQ(0u, m_httpConfig.getClientBodyTimeout());
+  m_httpConfig.setKeepaliveRequests(100000);
+  EXPECT_EQ(100000u, m_httpConfig.getKeepaliveRequests());
+
+  EXPECT_THROW(m_httpConfig.setClientBodyTimeout(
+                   HttpConfig::MAX_CLIENT_TIMEOUT + 1),
+               HttpConfigException);
+  EXPECT_THROW(m_httpConfig.setKeepaliveRequests(0), HttpConfigException);
+}
+
+TEST_F(ConnectionSettingsTest, ServerConfigSettersEnforceRanges) {
+  m_server.setKeepaliveTimeout(300);
+  EXPECT_EQ(300u, m_server.getKeepaliveTimeout());
+
+  EXPECT_THROW(m_server.setSendTimeout(ServerConfig::MAX_TIMEOUT + 1),
+               ServerConfigException);
+  EXPECT_THROW(m_server.setKeepaliveRequests(
+                   ServerConfig::MAX_KEEPALIVE_REQUESTS + 1),
+               ServerConfigException);
+}
+
+TEST_F(ConnectionSettingsTest, ServerCopyKeepsSettings) {
+  m_server.setKeepaliveRequests(7);
+  m_server.setClientBodyTimeout(12);
+
+  ServerConfig copy(m_server);
+  EXPECT_EQ(7u, copy.getKeepaliveRequests());
+  EXPECT_EQ(12u, copy.getClientBodyTimeout());
+
+  copy.clear();
+  EXPECT_EQ(1000u, copy.getKeepaliveRequests());
+}
+
+// ============================================================================
+// Inheritance Tests
+// ============================================================================
+
+TEST_F(ConnectionSettingsTest, ServersInheritHttpValues) {
+  HttpConfig* config = parse(
+      "    keepalive_timeout 15s;\n"
+      "    keepalive_requests 20;\n"
+      "    client_header_timeout 5;\n"
+      "    client_body_timeout 1m;\n"
+      "    send_timeout 30;\n",
+      "");
+  ASSERT_TRUE(config != NULL);
+  ASSERT_EQ(1u, config->getServerConfigs().size());
+
+  const ServerConfig& server = *config->getServerConfigs()[0];
+  EXPECT_EQ(15u, server.getKeepaliveTimeout());
+  EXPECT_EQ(20u, server.getKeepaliveRequests());
+  EXPECT_EQ(5u, server.getClientHeaderTimeout());
+  EXPECT_EQ(60u, server.getClientBodyTimeout());
+  EXPECT_EQ(30u, server.getSendTimeout());
+  delete config;
+}
+
+TEST_F(ConnectionSettingsTest, ServerValuesOverrideHttpValues) {
+  HttpConfig* config = parse(
+      "    keepalive_timeout 15s;\n"
+      "    keepalive_requests 20;\n",
+      "        keepalive_timeout 2m;\n");
+  ASSERT_TRUE(config != NULL);
+
+  const ServerConfig& server = *config->getServerConfigs()[0];
+  EXPECT_EQ(120u, server.getKeepaliveTimeout());
+  EXPECT_EQ(20u, server.getKeepaliveRequests());
+  EXPECT_EQ(15u, config->getKeepaliveTimeout());
+  delete config;
+}
+
+TEST_F(ConnectionSettingsTest, UnsetValuesKeepDefaults) {
+  HttpConfig* config = parse("", "");
+  ASSERT_TRUE(config != NULL);
+
+  const ServerConfig& server = *config->getServerConfigs()[0];
+  EXPECT_EQ(75u, server.getKeepaliveTimeout());
+  EXPECT_EQ(1000u, server.getKeepaliveRequests());
+  EXPECT_EQ(60u, server.getClientBodyTimeout());
+  delete config;
+}
@@ -0,0 +1,366 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_FastCgiClient.cpp                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 16:05:51 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 16:05:51 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <gtest/gtest.h>
+#include "domain/configuration/value_objects/CgiConfig.hpp"
+#include "domain/filesystem/value_objects/Path.hpp"
+#include "domain/http/entities/HttpRequest.hpp"
+#include "domain/http/value_objects/HttpMethod.hpp"
+#include "domain/http/value_objects/RouteMatchInfo.hpp"
+#include "infrastructure/cgi/adapters/FastCgiClient.hpp"
+#include "infrastructure/cgi/adapters/FastCgiConnection.hpp"
+#include "infrastructure/cgi/adapters/FastCgiSession.hpp"
+#include "infrastructure/cgi/exceptions/CgiExecutionException.hpp"
+#include "infrastructure/cgi/primitives/CgiRequest.hpp"
+#include "infrastructure/cgi/primitives/FastCgiRecord.hpp"
+#include "infrastructure/cgi/primitives/FastCgiRecordDecoder.hpp"
+#include "mocks/MockFastCgiServer.hpp"
+#include "mocks/MockLogger.hpp"
+
+#include <ctime>
+#include <poll.h>
+#include <string>
+#include <vector>
+
+using infrastructure::cgi::adapters::FastCgiClient;
+using infrastructure::cgi::adapters::FastCgiConnection;
+using infrastructure::cgi::adapters::FastCgiSession;
+using infrastructure::cgi::exceptions::CgiExecutionException;
+using infrastructure::cgi::primitives::CgiRequest;
+using infrastructure::cgi::primitives::CgiResponse;
+using infrastructure::cgi::primitives::FastCgiRecord;
+using infrastructure::cgi::primitives::FastCgiRecordDecoder;
+
+class FastCgiClientTest : public ::testing::Test {
+ protected:
+  static const int K_POLL_TIMEOUT_MS = 2000;
+
+  void SetUp() {}
+  void TearDown() {}
+
+  static CgiRequest makeRequest(const std::string& method,
+                                const std::string& body) {
+    domain::http::entities::HttpRequest httpRequest;
+    httpRequest.setMethod(domain::http::value_objects::HttpMethod(method));
+    httpRequest.setPath(domain::filesystem::value_objects::Path("/app.php"));
+    if (!body.empty()) {
+      httpRequest.setBody(std::vector<char>(body.begin(), body.end()));
+    }
+
+    const domain::filesystem::value_objects::Path script("/srv/www/app.php");
+    return CgiRequest(
+        httpRequest, domain::configuration::value_objects::CgiConfig(),
+        domain::http::value_objects::RouteMatchInfo::createForFile(
+            script, script.toString()),
+        "localhost", 8080);
+  }
+
+  static std::string bodyOf(const CgiResponse& response) {
+    return std::string(response.getBody().begin(), response.getBody().end());
+  }
+
+  static CgiRequest withQuery(const std::string& query) {
+    CgiRequest request = makeRequest("GET", "");
+    request.setEnvironmentVariable("QUERY_STRING", query);
+    return request;
+  }
+
+  static bool waitFor(const FastCgiSession& session) {
+    struct pollfd entry = {
+        session.getFd(),
+        static_cast<short>(session.wantsWrite() ? POLLIN | POLLOUT : POLLIN),
+        0};
+    return ::poll(&entry, 1, K_POLL_TIMEOUT_MS) > 0;
+  }
+
+  static void await(FastCgiSession& session) {
+    while (!session.advance()) {
+      ASSERT_TRUE(waitFor(session));
+    }
+  }
+
+  CgiResponse execute(FastCgiClient& client, const std::string& address,
+                      const CgiRequest& request) {
+    FastCgiSession session(m_logger, client, address, request);
+    session.start();
+    await(session);
+    const CgiResponse response = session.buildResponse();
+    session.finish();
+    return response;
+  }
+
+  tests::mocks::MockLogger m_logger;
+};
+
+// ============================================================================
+// Record Codec Tests
+// ============================================================================
+
+TEST_F(FastCgiClientTest, BeginRequestRecordLayout) {
+  std::vector<char> out;
+  FastCgiRecord::appendBeginRequest(out, 0x0102,
+                                    FastCgiRecord::ROLE_RESPONDER, true);
+
+  ASSERT_EQ(16u, out.size());
+  EXPECT_EQ(1, out[0]);
+  EXPECT_EQ(FastCgiRecord::TYPE_BEGIN_REQUEST, out[1]);
+  EXPECT_EQ(0x01, out[2]);
+  EXPECT_EQ(0x02, out[3]);
+  EXPECT_EQ(0, out[4]);
+  EXPECT_EQ(8, out[5]);
+  EXPECT_EQ(0, out[6]);
+  EXPECT_EQ(FastCgiRecord::ROLE_RESPONDER, out[9]);
+  EXPECT_EQ(FastCgiRecord::K_FLAG_KEEP_CONN, out[10]);
+}
+
+TEST_F(FastCgiClientTest, NameValuePairsRoundTripShortAndLongLengths) {
+  FastCgiRecord::ParameterMap params;
+  params["SCRIPT_FILENAME"] = "/srv/www/app.php";
+  params["HTTP_COOKIE"] = std::string(300, 'c');
+  params["EMPTY"] = "";
+
+  std::vector<char> encoded;
+  for (FastCgiRecord::ParameterMap::const_iterator it = params.begin();
+       it != params.end(); ++it) {
+    FastCgiRecord::appendNameValue(encoded, it->first, it->second);
+  }
+
+  FastCgiRecord::ParameterMap decoded;
+  ASSERT_TRUE(
+      FastCgiRecord::parseNameValues(&encoded[0], encoded.size(), decoded));
+  EXPECT_TRUE(params == decoded);
+
+  EXPECT_FALSE(FastCgiRecord::parseNameValues(&encoded[0], encoded.size() - 1,
+                                              decoded));
+}
+
+TEST_F(FastCgiClientTest, StreamIsSplitAndPadded) {
+  const std::string payload(70000, 'x');
+  std::vector<char> out;
+  FastCgiRecord::appendStream(out, FastCgiRecord::TYPE_STDIN, 7,
+                              payload.data(), payload.size());
+  EXPECT_EQ(0u, out.size() % FastCgiRecord::K_ALIGNMENT);
+
+  FastCgiRecordDecoder decoder;
+  decoder.feed(&out[0], out.size());
+
+  FastCgiRecord record;
+  std::string reassembled;
+  std::size_t records = 0;
+  while (decoder.next(record)) {
+    EXPECT_EQ(FastCgiRecord::TYPE_STDIN, record.type);
+    EXPECT_EQ(7, record.requestId);
+    reassembled.append(record.content.begin(), record.content.end());
+    ++records;
+  }
+  EXPECT_EQ(2u, records);
+  EXPECT_EQ(payload, reassembled);
+  EXPECT_EQ(0u, decoder.bufferedBytes());
+}
+
+TEST_F(FastCgiClientTest, DecoderWaitsForCompleteRecords) {
+  std::vector<char> out;
+  FastCgiRecord::appendEndRequest(out, 3, 42,
+                                  FastCgiRecord::STATUS_OVERLOADED);
+
+  FastCgiRecordDecoder decoder;
+  FastCgiRecord record;
+  for (std::size_t i = 0; i + 1 < out.size(); ++i) {
+    decoder.feed(&out[i], 1);
+    EXPECT_FALSE(decoder.next(record));
+  }
+  decoder.feed(&out[out.size() - 1], 1);
+
+  ASSERT_TRUE(decoder.next(record));
+  EXPECT_EQ(FastCgiRecord::TYPE_END_REQUEST, record.type);
+  EXPECT_EQ(42u, record.getAppStatus());
+  EXPECT_EQ(FastCgiRecord::STATUS_OVERLOADED, record.getProtocolStatus());
+}
+
+TEST_F(FastCgiClientTest, ValuesRecordTravelsOnRequestZero) {
+  FastCgiRecord::ParameterMap names;
+  names["FCGI_MPXS_CONNS"] = "";
+  std::vector<char> out;
+  FastCgiRecord::appendValues(out, FastCgiRecord::TYPE_GET_VALUES, names);
+
+  FastCgiRecordDecoder decoder;
+  decoder.feed(&out[0], out.size());
+  FastCgiRecord record;
+  ASSERT_TRUE(decoder.next(record));
+  EXPECT_EQ(FastCgiRecord::TYPE_GET_VALUES, record.type);
+  EXPECT_EQ(0, record.requestId);
+
+  FastCgiRecord::ParameterMap decoded;
+  ASSERT_TRUE(FastCgiRecord::parseNameValues(
+      &record.content[0], record.content.size(), decoded));
+  EXPECT_TRUE(names == decoded);
+}
+
+TEST_F(FastCgiClientTest, DecoderRejectsUnknownVersion) {
+  const char bogus[8] = {2, 6, 0, 1, 0, 0, 0, 0};
+  FastCgiRecordDecoder decoder;
+  decoder.feed(bogus, sizeof(bogus));
+
+  FastCgiRecord record;
+  EXPECT_THROW(decoder.next(record), CgiExecutionException);
+}
+
+// ============================================================================
+// Client Tests
+// ============================================================================
+
+TEST_F(FastCgiClientTest, ExecuteRoundTripsThroughResponder) {
+  mocks::MockFastCgiServer server;
+  server.start();
+  FastCgiClient client(m_logger);
+
+  const CgiResponse response =
+      execute(client, server.getAddress(), makeRequest("POST", "name=value"));
+
+  EXPECT_EQ("text/plain", response.getContentType());
+  const std::string body = bodyOf(response);
+  EXPECT_NE(std::string::npos, body.find("method=POST\n"));
+  EXPECT_NE(std::string::npos, body.find("script=/srv/www/app.php\n"));
+  EXPECT_NE(std::string::npos, body.find("body=name=value"));
+}
+
+TEST_F(FastCgiClientTest, KeepAliveReusesPooledConnection) {
+  mocks::MockFastCgiServer server;
+  server.start();
+  FastCgiClient client(m_logger);
+
+  for (int i = 0; i < 3; ++i) {
+    const CgiResponse response =
+        execute(client, server.getAddress(), makeRequest("GET", ""));
+    EXPECT_NE(std::string::npos, bodyOf(response).find("connection=1\n"));
+  }
+  EXPECT_EQ(1u, client.getConnectCount());
+  EXPECT_EQ(2u, client.getReuseCount());
+  EXPECT_EQ(1u, client.getIdleCount(server.getAddress()));
+  EXPECT_EQ(0u, client.getActiveCount(server.getAddress()));
+}
+
+TEST_F(FastCgiClientTest, ReconnectsWhenServerDropsConnection) {
+  mocks::MockFastCgiServer server(false);
+  server.start();
+  FastCgiClient client(m_logger);
+
+  execute(client, server.getAddress(), makeRequest("GET", ""));
+  const CgiResponse response =
+      execute(client, server.getAddress(), makeRequest("GET", ""));
+
+  EXPECT_NE(std::string::npos, bodyOf(response).find("connection=2\n"));
+  EXPECT_EQ(2u, client.getConnectCount());
+}
+
+TEST_F(FastCgiClientTest, ConnectionIsSharedOnlyOnceServerMultiplexes) {
+  mocks::MockFastCgiServer server;
+  server.start();
+  FastCgiClient client(m_logger);
+
+  FastCgiSession first(m_logger, client, server.getAddress(),
+                       makeRequest("GET", ""));
+  FastCgiSession second(m_logger, client, server.getAddress(),
+                        makeRequest("GET", ""));
+  first.start();
+  second.start();
+
+  EXPECT_NE(first.getFd(), second.getFd());
+  EXPECT_EQ(2u, client.getConnectCount());
+  EXPECT_EQ(2u, client.getActiveCount(server.getAddress()));
+  await(first);
+  await(second);
+}
+
+TEST_F(FastCgiClientTest, MultiplexedResponsesReachTheirOwners) {
+  mocks::MockFastCgiServer server;
+  server.start();
+  FastCgiClient client(m_logger);
+
+  FastCgiSession held(m_logger, client, server.getAddress(),
+                      withQuery("hold"));
+  held.setOwner(7);
+  held.start();
+  ASSERT_TRUE(waitFor(held));
+  EXPECT_FALSE(held.advance());
+
+  FastCgiSession posted(m_logger, client, server.getAddress(),
+                        makeRequest("POST", "payload"));
+  posted.setOwner(9);
+  posted.start();
+  EXPECT_EQ(held.getFd(), posted.getFd());
+  EXPECT_TRUE(posted.isReused());
+  EXPECT_EQ(1u, client.getConnectCount());
+
+  await(posted);
+  std::vector<int> owners;
+  client.collectUpdated(owners);
+  ASSERT_EQ(1u, owners.size());
+  EXPECT_EQ(7, owners[0]);
+
+  ASSERT_TRUE(held.advance());
+  EXPECT_NE(std::string::npos,
+            bodyOf(posted.buildResponse()).find("body=payload"));
+  EXPECT_NE(std::string::npos,
+            bodyOf(held.buildResponse()).find("method=GET\n"));
+
+  held.finish();
+  posted.finish();
+  EXPECT_EQ(1u, client.getIdleCount(server.getAddress()));
+}
+
+TEST_F(FastCgiClientTest, SilentServerTimesOut) {
+  mocks::MockFastCgiServer server;
+  server.start();
+  FastCgiClient client(m_logger);
+  client.setTimeout(5);
+
+  FastCgiSession session(m_logger, client, server.getAddress(),
+                         withQuery("hold"));
+  session.start();
+  EXPECT_FALSE(session.advance());
+  EXPECT_NO_THROW(session.checkTimeout(std::time(NULL) + 1));
+  try {
+    session.checkTimeout(std::time(NULL) + 5);
+    ADD_FAILURE() << "expected a timeout";
+  } catch (const CgiExecutionException& ex) {
+    EXPECT_EQ(CgiExecutionException::TIMEOUT, ex.getCode());
+  }
+
+  session.finish();
+  EXPECT_EQ(0u, client.getIdleCount(server.getAddress()));
+}
+
+TEST_F(FastCgiClientTest, StderrIsLoggedAndEmptyOutputFails) {
+  mocks::MockFastCgiServer server;
+  server.start();
+  FastCgiClient client(m_logger);
+
+  execute(client, server.getAddress(), withQuery("stderr"));
+  EXPECT_TRUE(m_logger.hasLog(WARN, "FastCGI stderr: mock warning"));
+
+  FastCgiSession silent(m_logger, client, server.getAddress(),
+                        withQuery("empty"));
+  silent.start();
+  await(silent);
+  EXPECT_THROW(silent.buildResponse(), CgiExecutionException);
+}
+
+TEST_F(FastCgiClientTest, UnreachableServerThrows) {
+  FastCgiClient client(m_logger);
+  FastCgiSession session(m_logger, client,
+                         "unix:/nonexistent/webserv-fcgi.sock",
+                         makeRequest("GET", ""));
+  EXPECT_THROW(session.start(), CgiExecutionException);
+  EXPECT_EQ(-1, session.getFd());
+  EXPECT_EQ(0u, client.getIdleCount("unix:/nonexistent/webserv-fcgi.sock"));
+}
@@ -0,0 +1,327 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_Hpack.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 12:26:18 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 12:26:18 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <gtest/gtest.h>
+#include "infrastructure/http2/exceptions/Http2Exception.hpp"
+#include "infrastructure/http2/primitives/HpackDecoder.hpp"
+#include "infrastructure/http2/primitives/HpackEncoder.hpp"
+#include "infrastructure/http2/primitives/HpackHuffman.hpp"
+#include "infrastructure/http2/primitives/HpackTable.hpp"
+
+#include <cstdlib>
+#include <string>
+
+using infrastructure::http2::exceptions::Http2Exception;
+using infrastructure::http2::primitives::HpackDecoder;
+using infrastructure::http2::primitives::HpackEncoder;
+using infrastructure::http2::primitives::HpackHuffman;
+using infrastructure::http2::primitives::HpackTable;
+
+namespace {
+
+std::string fromHex(const std::string& hex) {
+  std::string out;
+  std::string digits;
+  for (std::size_t i = 0; i < hex.size(); ++i) {
+    if (hex[i] == ' ') {
+      continue;
+    }
+    digits += hex[i];
+    if (digits.size() == 2) {
+      out += static_cast<char>(std::strtol(digits.c_str(), NULL, 16));
+      digits.clear();
+    }
+  }
+  return out;
+}
+
+HpackDecoder::HeaderList requestOne() {
+  HpackDecoder::HeaderList headers;
+  headers.push_back(HpackDecoder::Field(":method", "GET"));
+  headers.push_back(HpackDecoder::Field(":scheme", "http"));
+  headers.push_back(HpackDecoder::Field(":path", "/"));
+  headers.push_back(HpackDecoder::Field(":authority", "www.example.com"));
+  return headers;
+}
+
+HpackDecoder::HeaderList requestTwo() {
+  HpackDecoder::HeaderList headers = requestOne();
+  headers.push_back(HpackDecoder::Field("cache-control", "no-cache"));
+  return headers;
+}
+
+HpackDecoder::HeaderList requestThree() {
+  HpackDecoder::HeaderList headers;
+  headers.push_back(HpackDecoder::Field(":method", "GET"));
+  headers.push_back(HpackDecoder::Field(":scheme", "https"));
+  headers.push_back(HpackDecoder::Field(":path", "/index.html"));
+  headers.push_back(HpackDecoder::Field(":authority", "www.example.com"));
+  headers.push_back(HpackDecoder::Field("custom-key", "custom-value"));
+  return headers;
+}
+
+// RFC 7541 Appendix C.4: the same three requests, Huffman-coded.
+const char* const K_REQUEST_ONE = "8286 8441 8cf1 e3c2 e5f2 3a6b a0ab 90f4 ff";
+const char* const K_REQUEST_TWO = "8286 84be 5886 a8eb 1064 9cbf";
+const char* const K_REQUEST_THREE =
+    "8287 85bf 4088 25a8 49e9 5ba9 7d7f 8925 a849 e95b b8e8 b4bf";
+
+}  // namespace
+
+class HpackTest : public ::testing::Test {
+ protected:
+  HpackDecoder::HeaderList decode(const std::string& block) {
+    HpackDecoder::HeaderList headers;
+    m_decoder.decode(block.data(), block.size(), headers);
+    return headers;
+  }
+
+  void expectCompressionError(const std::string& block) {
+    try {
+      decode(block);
+      FAIL() << "block was accepted";
+    } catch (const Http2Exception& ex) {
+      EXPECT_EQ(Http2Exception::COMPRESSION_ERROR, ex.getCode());
+      EXPECT_FALSE(ex.isStreamError());
+    }
+  }
+
+  HpackDecoder m_decoder;
+  HpackEncoder m_encoder;
+};
+
+// ============================================================================
+// Primitive Tests
+// ============================================================================
+
+TEST_F(HpackTest, IntegersFollowRfcExamples) {
+  std::string out;
+  HpackEncoder::appendInteger(out, 0, 5, 10);
+  HpackEncoder::appendInteger(out, 0, 5, 1337);
+  HpackEncoder::appendInteger(out, 0, 8, 42);
+  EXPECT_EQ(fromHex("0a 1f9a0a 2a"), out);
+
+  std::size_t offset = 0;
+  std::size_t value = 0;
+  ASSERT_TRUE(HpackDecoder::decodeInteger(out.data(), out.size(), offset, 5,
+                                          value));
+  EXPECT_EQ(10u, value);
+  ASSERT_TRUE(HpackDecoder::decodeInteger(out.data(), out.size(), offset, 5,
+                                          value));
+  EXPECT_EQ(1337u, value);
+  ASSERT_TRUE(HpackDecoder::decodeInteger(out.data(), out.size(), offset, 8,
+                                          value));
+  EXPECT_EQ(42u, value);
+  EXPECT_EQ(out.size(), offset);
+}
+
+TEST_F(HpackTest, TruncatedIntegerIsRejected) {
+  const std::string data = fromHex("1f9a");
+  std::size_t offset = 0;
+  std::size_t value = 0;
+  EXPECT_FALSE(HpackDecoder::decodeInteger(data.data(), data.size(), offset, 5,
+                                           value));
+}
+
+TEST_F(HpackTest, HuffmanRoundTripsEveryOctet) {
+  std::string text;
+  for (int c = 0; c < 256; ++c) {
+    text += static_cast<char>(c);
+  }
+  std::string encoded;
+  HpackHuffman::encode(text, encoded);
+  EXPECT_EQ(HpackHuffman::encodedLength(text), encoded.size());
+
+  std::string decoded;
+  ASSERT_TRUE(HpackHuffman::decode(encoded.data(), encoded.size(), decoded));
+  EXPECT_EQ(text, decoded);
+}
+
+TEST_F(HpackTest, HuffmanMatchesRfcExample) {
+  std::string encoded;
+  HpackHuffman::encode("www.example.com", encoded);
+  EXPECT_EQ(fromHex("f1e3 c2e5 f23a 6ba0 ab90 f4ff"), encoded);
+}
+
+TEST_F(HpackTest, HuffmanRejectsEosAndBadPadding) {
+  std::string out;
+  const std::string eos = fromHex("ffff ffff");
+  EXPECT_FALSE(HpackHuffman::decode(eos.data(), eos.size(), out));
+
+  // "a" is 00011; the remaining bits must be ones, and fewer than eight.
+  const std::string zeroPadding = fromHex("18");
+  EXPECT_FALSE(HpackHuffman::decode(zeroPadding.data(), zeroPadding.size(),
+                                    out));
+  const std::string longPadding = fromHex("1fff");
+  EXPECT_FALSE(HpackHuffman::decode(longPadding.data(), longPadding.size(),
+                                    out));
+  const std::string valid = fromHex("1f");
+  out.clear();
+  EXPECT_TRUE(HpackHuffman::decode(valid.data(), valid.size(), out));
+  EXPECT_EQ("a", out);
+}
+
+// ============================================================================
+// Table Tests
+// ============================================================================
+
+TEST_F(HpackTest, StaticTableIsIndexedFromOne) {
+  HpackTable table;
+  HpackTable::Field field;
+  EXPECT_FALSE(table.get(0, field));
+  ASSERT_TRUE(table.get(2, field));
+  EXPECT_EQ(":method", field.first);
+  EXPECT_EQ("GET", field.second);
+  ASSERT_TRUE(table.get(61, field));
+  EXPECT_EQ("www-authenticate", field.first);
+  EXPECT_FALSE(table.get(62, field));
+}
+
+TEST_F(HpackTest, DynamicTableEvictsOldestEntries) {
+  HpackTable table;
+  table.setMaxSize(100);
+  table.insert("a", "1");
+  table.insert("b", "2");
+  table.insert("c", "3");
+
+  EXPECT_EQ(2u, table.getEntryCount());
+  EXPECT_EQ(68u, table.getSize());
+  HpackTable::Field field;
+  ASSERT_TRUE(table.get(62, field));
+  EXPECT_EQ("c", field.first);
+  ASSERT_TRUE(table.get(63, field));
+  EXPECT_EQ("b", field.first);
+
+  table.insert(std::string(100, 'x'), "");
+  EXPECT_EQ(0u, table.getEntryCount());
+  EXPECT_EQ(0u, table.getSize());
+}
+
+TEST_F(HpackTest, FindPrefersFullMatch) {
+  HpackTable table;
+  bool valueMatched = false;
+  EXPECT_EQ(3u, table.find(":method", "POST", valueMatched));
+  EXPECT_TRUE(valueMatched);
+  EXPECT_EQ(2u, table.find(":method", "PUT", valueMatched));
+  EXPECT_FALSE(valueMatched);
+  EXPECT_EQ(0u, table.find("x-custom", "1", valueMatched));
+
+  table.insert("x-custom", "1");
+  EXPECT_EQ(62u, table.find("x-custom", "1", valueMatched));
+  EXPECT_TRUE(valueMatched);
+}
+
+// ============================================================================
+// Decoder Tests
+// ============================================================================
+
+TEST_F(HpackTest, DecodesRfcLiteralWithIndexing) {
+  const HpackDecoder::HeaderList headers = decode(fromHex(
+      "400a 6375 7374 6f6d 2d6b 6579 0d63 7573 746f 6d2d 6865 6164 6572"));
+  ASSERT_EQ(1u, headers.size());
+  EXPECT_EQ("custom-key", headers[0].first);
+  EXPECT_EQ("custom-header", headers[0].second);
+  EXPECT_EQ(55u, m_decoder.getTable().getSize());
+}
+
+TEST_F(HpackTest, DecodesRfcRequestSequence) {
+  EXPECT_EQ(requestOne(), decode(fromHex(K_REQUEST_ONE)));
+  EXPECT_EQ(57u, m_decoder.getTable().getSize());
+  EXPECT_EQ(requestTwo(), decode(fromHex(K_REQUEST_TWO)));
+  EXPECT_EQ(110u, m_decoder.getTable().getSize());
+  EXPECT_EQ(requestThree(), decode(fromHex(K_REQUEST_THREE)));
+  EXPECT_EQ(164u, m_decoder.getTable().getSize());
+}
+
+TEST_F(HpackTest, InvalidIndexIsCompressionError) {
+  expectCompressionError(fromHex("80"));
+  expectCompressionError(fromHex("be"));
+  expectCompressionError(fromHex("41"));
+}
+
+TEST_F(HpackTest, SizeUpdateOnlyAtBlockStartAndWithinLimit) {
+  decode(fromHex("3fe11f 82"));
+  EXPECT_EQ(4096u, m_decoder.getTable().getMaxSize());
+
+  expectCompressionError(fromHex("82 3fe11f"));
+  expectCompressionError(fromHex("3fe21f"));
+}
+
+TEST_F(HpackTest, HeaderListLimitDropsFieldsButKeepsTable) {
+  m_decoder.setMaxHeaderListSize(60);
+  HpackDecoder::HeaderList headers;
+  const std::string block = fromHex(K_REQUEST_ONE);
+  EXPECT_FALSE(m_decoder.decode(block.data(), block.size(), headers));
+  EXPECT_EQ(1u, headers.size());
+  EXPECT_EQ(57u, m_decoder.getTable().getSize());
+}
+
+// ============================================================================
+// Encoder Tests
+// ============================================================================
+
+TEST_F(HpackTest, EncoderReproducesRfcRequestSequence) {
+  std::string block;
+  m_encoder.encode(requestOne(), block);
+  EXPECT_EQ(fromHex(K_REQUEST_ONE), block);
+
+  block.clear();
+  m_encoder.encode(requestTwo(), block);
+  EXPECT_EQ(fromHex(K_REQUEST_TWO), block);
+
+  block.clear();
+  m_encoder.encode(requestThree(), block);
+  EXPECT_EQ(fromHex(K_REQUEST_THREE), block);
+  EXPECT_EQ(164u, m_encoder.getTable().getSize());
+}
+
+TEST_F(HpackTest, EncoderOutputDecodesBack) {
+  HpackEncoder::HeaderList headers;
+  headers.push_back(HpackEncoder::Field(":status", "200"));
+  headers.push_back(HpackEncoder::Field("server", "webserv/1.0"));
+  headers.push_back(HpackEncoder::Field("content-length", "1234"));
+  headers.push_back(HpackEncoder::Field("set-cookie", "id=42"));
+  headers.push_back(HpackEncoder::Field("x-long", std::string(300, 'z')));
+
+  for (int round = 0; round < 3; ++round) {
+    std::string block;
+    m_encoder.encode(headers, block);
+    EXPECT_EQ(headers, decode(block));
+  }
+  EXPECT_EQ(m_encoder.getTable().getSize(), m_decoder.getTable().getSize());
+}
+
+TEST_F(HpackTest, EncoderKeepsVolatileFieldsOutOfTable) {
+  HpackEncoder::HeaderList headers;
+  headers.push_back(HpackEncoder::Field("content-length", "1234"));
+  headers.push_back(HpackEncoder::Field("set-cookie", "id=42"));
+  std::string block;
+  m_encoder.encode(headers, block);
+
+  EXPECT_EQ(0u, m_encoder.getTable().getEntryCount());
+  // content-length (28) without indexing, set-cookie (55) never indexed.
+  EXPECT_EQ('\x0f', block[0]);
+  EXPECT_EQ('\x0d', block[1]);
+  EXPECT_NE(std::string::npos, block.find(fromHex("1f28")));
+}
+
+TEST_F(HpackTest, EncoderSignalsTableSizeChanges) {
+  m_encoder.setMaxTableSize(0);
+  m_encoder.setMaxTableSize(1 << 20);
+  std::string block;
+  m_encoder.encode(HpackEncoder::HeaderList(), block);
+  EXPECT_EQ(fromHex("20 3fe11f"), block);
+
+  block.clear();
+  m_encoder.encode(HpackEncoder::HeaderList(), block);
+  EXPECT_TRUE(block.empty());
+}
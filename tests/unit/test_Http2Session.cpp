@@ -0,0 +1,700 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_Http2Session.cpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 12:31:44 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 12:31:44 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <gtest/gtest.h>
+#include "infrastructure/http2/adapters/Http2Session.hpp"
+#include "infrastructure/http2/exceptions/Http2Exception.hpp"
+#include "infrastructure/http2/primitives/HpackDecoder.hpp"
+#include "infrastructure/http2/primitives/HpackEncoder.hpp"
+#include "infrastructure/http2/primitives/Http2Frame.hpp"
+#include "infrastructure/http2/primitives/Http2FrameDecoder.hpp"
+
+#include <string>
+#include <vector>
+
+using infrastructure::http2::adapters::Http2Session;
+using infrastructure::http2::exceptions::Http2Exception;
+using infrastructure::http2::primitives::HpackDecoder;
+using infrastructure::http2::primitives::HpackEncoder;
+using infrastructure::http2::primitives::Http2Frame;
+using infrastructure::http2::primitives::Http2FrameDecoder;
+
+namespace {
+
+const std::size_t K_MAX_REQUEST_SIZE = 8 * 1024 * 1024;
+
+typedef std::vector<Http2Frame> FrameList;
+
+Http2Session::HeaderList requestHeaders(const std::string& method,
+                                        const std::string& path) {
+  Http2Session::HeaderList headers;
+  headers.push_back(Http2Session::Field(":method", method));
+  headers.push_back(Http2Session::Field(":scheme", "https"));
+  headers.push_back(Http2Session::Field(":path", path));
+  headers.push_back(Http2Session::Field(":authority", "localhost"));
+  return headers;
+}
+
+Http2Session::HeaderList statusHeaders(const std::string& status) {
+  Http2Session::HeaderList headers;
+  headers.push_back(Http2Session::Field(":status", status));
+  return headers;
+}
+
+std::string settingsFrame(unsigned int id, unsigned long value) {
+  Http2Frame::SettingList settings;
+  settings.push_back(Http2Frame::Setting(id, value));
+  std::string out;
+  Http2Frame::appendSettings(out, settings);
+  return out;
+}
+
+std::string priorityFrame(unsigned int streamId, unsigned int dependency,
+                          unsigned int weight, bool exclusive) {
+  std::string out;
+  Http2Frame::appendHeader(out, Http2Frame::TYPE_PRIORITY, 0, streamId,
+                           Http2Frame::K_PRIORITY_SIZE);
+  Http2Frame::appendUint32(out, dependency | (exclusive ? 0x80000000ul : 0));
+  out += static_cast<char>(weight - 1);
+  return out;
+}
+
+std::string windowUpdateFrame(unsigned int streamId, unsigned long increment) {
+  std::string out;
+  Http2Frame::appendWindowUpdate(out, streamId, increment);
+  return out;
+}
+
+std::string dataFrame(unsigned int streamId, const std::string& data,
+                      bool endStream) {
+  std::string out;
+  Http2Frame::appendData(out, streamId, data.data(), data.size(), endStream);
+  return out;
+}
+
+}  // namespace
+
+class Http2SessionTest : public ::testing::Test {
+ protected:
+  Http2SessionTest() : m_session(K_MAX_REQUEST_SIZE) {}
+
+  void SetUp() {
+    m_session.start();
+    drain();
+  }
+
+  void send(Http2Session& session, const std::string& bytes) {
+    session.receive(bytes.data(), bytes.size());
+  }
+
+  void send(const std::string& bytes) { send(m_session, bytes); }
+
+  void sendPreface(const std::string& settings = settingsFrame(
+                       Http2Frame::SETTINGS_ENABLE_PUSH, 0)) {
+    send(std::string(Http2Frame::K_CLIENT_PREFACE,
+                     Http2Frame::K_CLIENT_PREFACE_SIZE) +
+         settings);
+    drain();
+  }
+
+  std::string headersFrame(unsigned int streamId,
+                           const Http2Session::HeaderList& headers,
+                           bool endStream) {
+    std::string block;
+    m_clientEncoder.encode(headers, block);
+    std::string out;
+    Http2Frame::appendHeaders(out, streamId, block, endStream,
+                              Http2Frame::K_DEFAULT_MAX_FRAME_SIZE);
+    return out;
+  }
+
+  void sendGet(unsigned int streamId, const std::string& path = "/") {
+    send(headersFrame(streamId, requestHeaders("GET", path), true));
+  }
+
+  FrameList drain(Http2Session& session) {
+    Http2FrameDecoder decoder;
+    decoder.setMaxFrameSize(Http2Frame::K_MAX_FRAME_SIZE_LIMIT);
+    while (session.hasOutput()) {
+      decoder.feed(session.outputData(), session.outputSize());
+      session.consumeOutput(session.outputSize());
+    }
+    FrameList frames;
+    Http2Frame frame;
+    while (decoder.next(frame)) {
+      frames.push_back(frame);
+    }
+    return frames;
+  }
+
+  FrameList drain() { return drain(m_session); }
+
+  static FrameList framesOfType(const FrameList& frames,
+                                Http2Frame::Type type) {
+    FrameList matching;
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+      if (frames[i].type == type) {
+        matching.push_back(frames[i]);
+      }
+    }
+    return matching;
+  }
+
+  static std::size_t dataBytes(const FrameList& frames,
+                               unsigned int streamId) {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+      if (frames[i].type == Http2Frame::TYPE_DATA &&
+          frames[i].streamId == streamId) {
+        total += frames[i].payload.size();
+      }
+    }
+    return total;
+  }
+
+  static unsigned long errorCodeOf(const Http2Frame& frame) {
+    const std::size_t offset =
+        frame.type == Http2Frame::TYPE_GOAWAY ? 4 : 0;
+    return Http2Frame::readUint32(frame.payload.data() + offset);
+  }
+
+  void respond(unsigned int streamId, const std::string& body) {
+    m_session.submitHeaders(streamId, statusHeaders("200"), false);
+    m_session.submitData(streamId, body.data(), body.size(), true);
+  }
+
+  Http2Session m_session;
+  HpackEncoder m_clientEncoder;
+  HpackDecoder m_clientDecoder;
+};
+
+// ============================================================================
+// Connection Setup Tests
+// ============================================================================
+
+TEST_F(Http2SessionTest, StartSendsSettingsAndConnectionWindow) {
+  Http2Session session(K_MAX_REQUEST_SIZE);
+  session.start();
+  const FrameList frames = drain(session);
+
+  ASSERT_EQ(2u, frames.size());
+  EXPECT_EQ(Http2Frame::TYPE_SETTINGS, frames[0].type);
+  EXPECT_EQ(3 * Http2Frame::K_SETTING_SIZE, frames[0].payload.size());
+  EXPECT_EQ(Http2Frame::TYPE_WINDOW_UPDATE, frames[1].type);
+  EXPECT_EQ(0u, frames[1].streamId);
+  EXPECT_EQ(Http2Session::K_RECEIVE_WINDOW - Http2Frame::K_DEFAULT_WINDOW_SIZE,
+            Http2Frame::readUint32(frames[1].payload.data()));
+}
+
+TEST_F(Http2SessionTest, ClientSettingsAreAcknowledged) {
+  send(std::string(Http2Frame::K_CLIENT_PREFACE,
+                   Http2Frame::K_CLIENT_PREFACE_SIZE) +
+       settingsFrame(Http2Frame::SETTINGS_MAX_FRAME_SIZE, 32768));
+  const FrameList frames = drain();
+
+  ASSERT_EQ(1u, frames.size());
+  EXPECT_EQ(Http2Frame::TYPE_SETTINGS, frames[0].type);
+  EXPECT_TRUE(frames[0].hasFlag(Http2Frame::K_FLAG_ACK));
+  EXPECT_FALSE(m_session.hasFailed());
+}
+
+TEST_F(Http2SessionTest, PrefaceArrivingInPiecesIsAccepted) {
+  const std::string preface(Http2Frame::K_CLIENT_PREFACE,
+                            Http2Frame::K_CLIENT_PREFACE_SIZE);
+  send(preface.substr(0, 5));
+  send(preface.substr(5) +
+       settingsFrame(Http2Frame::SETTINGS_ENABLE_PUSH, 0));
+  EXPECT_FALSE(m_session.hasFailed());
+}
+
+TEST_F(Http2SessionTest, WrongPrefaceFailsConnection) {
+  send("GET / HTTP/1.1\r\nHost: x\r\n\r\n");
+  const FrameList frames = drain();
+
+  EXPECT_TRUE(m_session.hasFailed());
+  EXPECT_TRUE(m_session.isFinished());
+  ASSERT_EQ(1u, frames.size());
+  EXPECT_EQ(Http2Frame::TYPE_GOAWAY, frames[0].type);
+  EXPECT_EQ(static_cast<unsigned long>(Http2Exception::PROTOCOL_ERROR),
+            errorCodeOf(frames[0]));
+}
+
+TEST_F(Http2SessionTest, PrefaceMustBeFollowedBySettings) {
+  std::string ping;
+  Http2Frame::appendPing(ping, "12345678", false);
+  send(std::string(Http2Frame::K_CLIENT_PREFACE,
+                   Http2Frame::K_CLIENT_PREFACE_SIZE) +
+       ping);
+  EXPECT_TRUE(m_session.hasFailed());
+}
+
+TEST_F(Http2SessionTest, PingIsEchoed) {
+  sendPreface();
+  std::string ping;
+  Http2Frame::appendPing(ping, "abcdefgh", false);
+  send(ping);
+  const FrameList frames = drain();
+
+  ASSERT_EQ(1u, frames.size());
+  EXPECT_EQ(Http2Frame::TYPE_PING, frames[0].type);
+  EXPECT_TRUE(frames[0].hasFlag(Http2Frame::K_FLAG_ACK));
+  EXPECT_EQ("abcdefgh", frames[0].payload);
+}
+
+// ============================================================================
+// Request Tests
+// ============================================================================
+
+TEST_F(Http2SessionTest, CompleteRequestsAreHandedOutInOrder) {
+  sendPreface();
+  sendGet(1, "/first");
+  sendGet(3, "/second");
+
+  Http2Session::Request request;
+  ASSERT_TRUE(m_session.nextRequest(request));
+  EXPECT_EQ(1u, request.streamId);
+  EXPECT_EQ(requestHeaders("GET", "/first"), request.headers);
+  ASSERT_TRUE(m_session.nextRequest(request));
+  EXPECT_EQ(3u, request.streamId);
+  EXPECT_FALSE(m_session.nextRequest(request));
+  EXPECT_EQ(2u, m_session.getActiveStreamCount());
+}
+
+TEST_F(Http2SessionTest, RequestBodyIsCollectedUntilEndStream) {
+  sendPreface();
+  Http2Session::HeaderList headers = requestHeaders("POST", "/upload");
+  headers.push_back(Http2Session::Field("content-length", "11"));
+  send(headersFrame(1, headers, false));
+  send(dataFrame(1, "hello ", false));
+
+  Http2Session::Request request;
+  EXPECT_FALSE(m_session.nextRequest(request));
+  send(dataFrame(1, "world", true));
+  ASSERT_TRUE(m_session.nextRequest(request));
+  EXPECT_EQ("hello world", request.body);
+  EXPECT_FALSE(request.oversized);
+}
+
+TEST_F(Http2SessionTest, HeaderBlockContinues) {
+  sendPreface();
+  std::string block;
+  m_clientEncoder.encode(requestHeaders("GET", "/split"), block);
+  std::string frames;
+  Http2Frame::appendHeaders(frames, 1, block, true, 4);
+  send(frames);
+
+  Http2Session::Request request;
+  ASSERT_TRUE(m_session.nextRequest(request));
+  EXPECT_EQ(requestHeaders("GET", "/split"), request.headers);
+}
+
+TEST_F(Http2SessionTest, InterruptedHeaderBlockFailsConnection) {
+  sendPreface();
+  std::string block;
+  m_clientEncoder.encode(requestHeaders("GET", "/"), block);
+  std::string frames;
+  Http2Frame::appendHeader(frames, Http2Frame::TYPE_HEADERS,
+                           Http2Frame::K_FLAG_END_STREAM, 1, 2);
+  frames.append(block, 0, 2);
+  Http2Frame::appendPing(frames, "abcdefgh", false);
+  send(frames);
+
+  EXPECT_TRUE(m_session.hasFailed());
+}
+
+TEST_F(Http2SessionTest, CookieCrumbsAreJoined) {
+  sendPreface();
+  Http2Session::HeaderList headers = requestHeaders("GET", "/");
+  headers.push_back(Http2Session::Field("cookie", "a=1"));
+  headers.push_back(Http2Session::Field("accept", "*/*"));
+  headers.push_back(Http2Session::Field("cookie", "b=2"));
+  send(headersFrame(1, headers, true));
+
+  Http2Session::Request request;
+  ASSERT_TRUE(m_session.nextRequest(request));
+  ASSERT_EQ(6u, request.headers.size());
+  EXPECT_EQ("accept", request.headers[4].first);
+  EXPECT_EQ(Http2Session::Field("cookie", "a=1; b=2"), request.headers[5]);
+}
+
+TEST_F(Http2SessionTest, MalformedRequestsAreReset) {
+  sendPreface();
+  Http2Session::HeaderList uppercase = requestHeaders("GET", "/");
+  uppercase.push_back(Http2Session::Field("Accept", "*/*"));
+  Http2Session::HeaderList connection = requestHeaders("GET", "/");
+  connection.push_back(Http2Session::Field("connection", "keep-alive"));
+  Http2Session::HeaderList noPath = requestHeaders("GET", "/");
+  noPath.erase(noPath.begin() + 2);
+  Http2Session::HeaderList lateMethod = requestHeaders("GET", "/");
+  lateMethod.insert(lateMethod.begin(), Http2Session::Field("accept", "*/*"));
+
+  send(headersFrame(1, uppercase, true));
+  send(headersFrame(3, connection, true));
+  send(headersFrame(5, noPath, true));
+  send(headersFrame(7, lateMethod, true));
+  const FrameList resets = framesOfType(drain(), Http2Frame::TYPE_RST_STREAM);
+
+  ASSERT_EQ(4u, resets.size());
+  for (std::size_t i = 0; i < resets.size(); ++i) {
+    EXPECT_EQ(static_cast<unsigned long>(Http2Exception::PROTOCOL_ERROR),
+              errorCodeOf(resets[i]));
+  }
+  Http2Session::Request request;
+  EXPECT_FALSE(m_session.nextRequest(request));
+  EXPECT_FALSE(m_session.hasFailed());
+}
+
+TEST_F(Http2SessionTest, ContentLengthMismatchResetsStream) {
+  sendPreface();
+  Http2Session::HeaderList headers = requestHeaders("POST", "/");
+  headers.push_back(Http2Session::Field("content-length", "10"));
+  send(headersFrame(1, headers, false));
+  send(dataFrame(1, "short", true));
+
+  const FrameList resets = framesOfType(drain(), Http2Frame::TYPE_RST_STREAM);
+  ASSERT_EQ(1u, resets.size());
+  EXPECT_EQ(1u, resets[0].streamId);
+  Http2Session::Request request;
+  EXPECT_FALSE(m_session.nextRequest(request));
+}
+
+TEST_F(Http2SessionTest, OversizedRequestIsFlagged) {
+  Http2Session session(256);
+  session.start();
+  send(session, std::string(Http2Frame::K_CLIENT_PREFACE,
+                            Http2Frame::K_CLIENT_PREFACE_SIZE) +
+                    settingsFrame(Http2Frame::SETTINGS_ENABLE_PUSH, 0));
+  send(session, headersFrame(1, requestHeaders("POST", "/"), false));
+  send(session, dataFrame(1, std::string(300, 'x'), true));
+
+  Http2Session::Request request;
+  ASSERT_TRUE(session.nextRequest(request));
+  EXPECT_TRUE(request.oversized);
+  EXPECT_TRUE(request.body.empty());
+}
+
+TEST_F(Http2SessionTest, ResetStreamIsNotHandedOut) {
+  sendPreface();
+  sendGet(1);
+  std::string reset;
+  Http2Frame::appendRstStream(reset, 1, Http2Exception::CANCEL);
+  send(reset);
+
+  Http2Session::Request request;
+  EXPECT_FALSE(m_session.nextRequest(request));
+  EXPECT_FALSE(m_session.isStreamOpen(1));
+  EXPECT_EQ(0u, m_session.getActiveStreamCount());
+}
+
+TEST_F(Http2SessionTest, StreamsBeyondLimitAreRefused) {
+  sendPreface();
+  for (unsigned int i = 0; i <= Http2Session::K_MAX_CONCURRENT_STREAMS; ++i) {
+    send(headersFrame(i * 2 + 1, requestHeaders("POST", "/"), false));
+  }
+  const FrameList resets = framesOfType(drain(), Http2Frame::TYPE_RST_STREAM);
+
+  ASSERT_EQ(1u, resets.size());
+  EXPECT_EQ(Http2Session::K_MAX_CONCURRENT_STREAMS * 2 + 1,
+            resets[0].streamId);
+  EXPECT_EQ(static_cast<unsigned long>(Http2Exception::REFUSED_STREAM),
+            errorCodeOf(resets[0]));
+  EXPECT_EQ(Http2Session::K_MAX_CONCURRENT_STREAMS,
+            m_session.getActiveStreamCount());
+}
+
+TEST_F(Http2SessionTest, ReusedStreamIdFailsConnection) {
+  sendPreface();
+  sendGet(3);
+  sendGet(1);
+  EXPECT_TRUE(m_session.hasFailed());
+}
+
+// ============================================================================
+// Response Tests
+// ============================================================================
+
+TEST_F(Http2SessionTest, ResponseIsFramedAndClosesStream) {
+  sendPreface();
+  sendGet(1);
+  Http2Session::Request request;
+  ASSERT_TRUE(m_session.nextRequest(request));
+  respond(1, "hello");
+  const FrameList frames = drain();
+
+  ASSERT_EQ(2u, frames.size());
+  EXPECT_EQ(Http2Frame::TYPE_HEADERS, frames[0].type);
+  EXPECT_TRUE(frames[0].hasFlag(Http2Frame::K_FLAG_END_HEADERS));
+  HpackDecoder::HeaderList headers;
+  m_clientDecoder.decode(frames[0].payload.data(), frames[0].payload.size(),
+                         headers);
+  EXPECT_EQ(statusHeaders("200"), headers);
+  EXPECT_EQ(Http2Frame::TYPE_DATA, frames[1].type);
+  EXPECT_EQ("hello", frames[1].payload);
+  EXPECT_TRUE(frames[1].hasFlag(Http2Frame::K_FLAG_END_STREAM));
+  EXPECT_EQ(0u, m_session.getActiveStreamCount());
+}
+
+TEST_F(Http2SessionTest, HeadersOnlyResponseEndsStream) {
+  sendPreface();
+  sendGet(1);
+  m_session.submitHeaders(1, statusHeaders("204"), true);
+  const FrameList frames = drain();
+
+  ASSERT_EQ(1u, frames.size());
+  EXPECT_TRUE(frames[0].hasFlag(Http2Frame::K_FLAG_END_STREAM));
+  EXPECT_FALSE(m_session.isStreamOpen(1));
+}
+
+TEST_F(Http2SessionTest, DataIsSplitAtMaxFrameSize) {
+  sendPreface();
+  sendGet(1);
+  respond(1, std::string(40000, 'x'));
+  const FrameList data = framesOfType(drain(), Http2Frame::TYPE_DATA);
+
+  ASSERT_EQ(3u, data.size());
+  EXPECT_EQ(Http2Frame::K_DEFAULT_MAX_FRAME_SIZE, data[0].payload.size());
+  EXPECT_EQ(40000u, dataBytes(data, 1));
+  EXPECT_TRUE(data[2].hasFlag(Http2Frame::K_FLAG_END_STREAM));
+}
+
+TEST_F(Http2SessionTest, StreamWindowHoldsDataUntilUpdate) {
+  sendPreface(settingsFrame(Http2Frame::SETTINGS_INITIAL_WINDOW_SIZE, 10));
+  sendGet(1);
+  respond(1, std::string(25, 'x'));
+
+  EXPECT_EQ(10u, dataBytes(drain(), 1));
+  EXPECT_EQ(15u, m_session.getQueuedBytes(1));
+  EXPECT_TRUE(m_session.isStreamOpen(1));
+
+  send(windowUpdateFrame(1, 100));
+  const FrameList data = framesOfType(drain(), Http2Frame::TYPE_DATA);
+  ASSERT_EQ(1u, data.size());
+  EXPECT_EQ(15u, data[0].payload.size());
+  EXPECT_TRUE(data[0].hasFlag(Http2Frame::K_FLAG_END_STREAM));
+}
+
+TEST_F(Http2SessionTest, ConnectionWindowIsSharedByStreams) {
+  sendPreface(settingsFrame(Http2Frame::SETTINGS_INITIAL_WINDOW_SIZE,
+                            1000000));
+  sendGet(1);
+  sendGet(3);
+  respond(1, std::string(40000, 'a'));
+  respond(3, std::string(40000, 'b'));
+
+  FrameList frames = drain();
+  EXPECT_EQ(Http2Frame::K_DEFAULT_WINDOW_SIZE,
+            dataBytes(frames, 1) + dataBytes(frames, 3));
+
+  send(windowUpdateFrame(0, 100000));
+  frames = drain();
+  EXPECT_EQ(80000u - Http2Frame::K_DEFAULT_WINDOW_SIZE,
+            dataBytes(frames, 1) + dataBytes(frames, 3));
+}
+
+TEST_F(Http2SessionTest, WindowOverflowResetsStream) {
+  sendPreface(settingsFrame(Http2Frame::SETTINGS_INITIAL_WINDOW_SIZE, 0));
+  sendGet(1);
+  m_session.submitHeaders(1, statusHeaders("200"), false);
+  drain();
+  send(windowUpdateFrame(1, Http2Frame::K_MAX_WINDOW_SIZE));
+  send(windowUpdateFrame(1, 1));
+  const FrameList resets = framesOfType(drain(), Http2Frame::TYPE_RST_STREAM);
+
+  ASSERT_EQ(1u, resets.size());
+  EXPECT_EQ(static_cast<unsigned long>(Http2Exception::FLOW_CONTROL_ERROR),
+            errorCodeOf(resets[0]));
+  EXPECT_FALSE(m_session.hasFailed());
+}
+
+TEST_F(Http2SessionTest, ReceiveWindowIsReplenished) {
+  sendPreface();
+  send(headersFrame(1, requestHeaders("POST", "/"), false));
+  const std::string chunk(Http2Frame::K_DEFAULT_MAX_FRAME_SIZE, 'x');
+  std::size_t sent = 0;
+  while (sent < Http2Session::K_RECEIVE_WINDOW / 2) {
+    send(dataFrame(1, chunk, false));
+    sent += chunk.size();
+  }
+  const FrameList updates =
+      framesOfType(drain(), Http2Frame::TYPE_WINDOW_UPDATE);
+
+  ASSERT_EQ(2u, updates.size());
+  EXPECT_EQ(0u, updates[0].streamId);
+  EXPECT_EQ(1u, updates[1].streamId);
+  EXPECT_EQ(sent, Http2Frame::readUint32(updates[0].payload.data()));
+}
+
+// ============================================================================
+// Priority Tests
+// ============================================================================
+
+class Http2PriorityTest : public Http2SessionTest {
+ protected:
+  // Both responses are queued while the peer's windows are shut, then
+  // released at once so the scheduler alone decides the order.
+  void openTwoStreams() {
+    sendPreface(settingsFrame(Http2Frame::SETTINGS_INITIAL_WINDOW_SIZE, 0));
+    sendGet(1);
+    sendGet(3);
+    send(windowUpdateFrame(0, 1000000));
+  }
+
+  FrameList release() {
+    respond(1, std::string(100000, 'a'));
+    respond(3, std::string(100000, 'b'));
+    drain();
+    send(settingsFrame(Http2Frame::SETTINGS_INITIAL_WINDOW_SIZE, 1000000));
+    return framesOfType(drain(), Http2Frame::TYPE_DATA);
+  }
+
+  static std::size_t lastFrameOf(const FrameList& frames,
+                                 unsigned int streamId) {
+    std::size_t last = 0;
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+      if (frames[i].streamId == streamId) {
+        last = i;
+      }
+    }
+    return last;
+  }
+};
+
+TEST_F(Http2PriorityTest, HeavierStreamFinishesFirst) {
+  openTwoStreams();
+  send(priorityFrame(3, 0, 256, false));
+  const FrameList data = release();
+
+  EXPECT_EQ(100000u, dataBytes(data, 1));
+  EXPECT_EQ(100000u, dataBytes(data, 3));
+  EXPECT_LT(lastFrameOf(data, 3), lastFrameOf(data, 1));
+}
+
+TEST_F(Http2PriorityTest, EqualWeightsInterleave) {
+  openTwoStreams();
+  const FrameList data = release();
+
+  ASSERT_GE(data.size(), 4u);
+  EXPECT_NE(data[0].streamId, data[1].streamId);
+  EXPECT_NE(data[2].streamId, data[3].streamId);
+}
+
+TEST_F(Http2PriorityTest, DependentStreamWaitsForParent) {
+  openTwoStreams();
+  send(priorityFrame(1, 3, 16, true));
+  const FrameList data = release();
+
+  ASSERT_FALSE(data.empty());
+  std::size_t firstOfChild = 0;
+  while (firstOfChild < data.size() && data[firstOfChild].streamId != 1) {
+    ++firstOfChild;
+  }
+  EXPECT_GT(firstOfChild, lastFrameOf(data, 3));
+  EXPECT_EQ(100000u, dataBytes(data, 1));
+}
+
+TEST_F(Http2PriorityTest, PlaceholderStreamsAreCapped) {
+  sendPreface();
+  for (unsigned int i = 0; i < Http2Session::K_MAX_IDLE_STREAMS + 8; ++i) {
+    send(priorityFrame(1001 + i * 2, 0, 16, false));
+  }
+  EXPECT_FALSE(m_session.hasFailed());
+  EXPECT_EQ(0u, m_session.getActiveStreamCount());
+
+  sendGet(1001);
+  Http2Session::Request request;
+  EXPECT_TRUE(m_session.nextRequest(request));
+}
+
+// ============================================================================
+// Shutdown Tests
+// ============================================================================
+
+TEST_F(Http2SessionTest, ShutdownLetsOpenStreamsFinish) {
+  sendPreface();
+  sendGet(1);
+  m_session.shutdown();
+  sendGet(3);
+
+  const FrameList goaways = framesOfType(drain(), Http2Frame::TYPE_GOAWAY);
+  ASSERT_EQ(1u, goaways.size());
+  EXPECT_EQ(1u, Http2Frame::readUint32(goaways[0].payload.data()));
+  EXPECT_EQ(static_cast<unsigned long>(Http2Exception::NO_ERROR),
+            errorCodeOf(goaways[0]));
+
+  Http2Session::Request request;
+  ASSERT_TRUE(m_session.nextRequest(request));
+  EXPECT_FALSE(m_session.nextRequest(request));
+  EXPECT_FALSE(m_session.isFinished());
+  respond(1, "bye");
+  EXPECT_TRUE(m_session.isFinished());
+}
+
+TEST_F(Http2SessionTest, FrameOnStreamZeroFailsConnection) {
+  sendPreface();
+  send(dataFrame(0, "x", false));
+  const FrameList frames = drain();
+
+  EXPECT_TRUE(m_session.hasFailed());
+  ASSERT_EQ(1u, frames.size());
+  EXPECT_EQ(Http2Frame::TYPE_GOAWAY, frames[0].type);
+  EXPECT_FALSE(m_session.getLastError().empty());
+}
+
+TEST_F(Http2SessionTest, PushPromiseFromClientFailsConnection) {
+  sendPreface();
+  std::string frame;
+  Http2Frame::appendHeader(frame, Http2Frame::TYPE_PUSH_PROMISE, 0, 1, 0);
+  send(frame);
+  EXPECT_TRUE(m_session.hasFailed());
+}
+
+// ============================================================================
+// Upgrade Tests
+// ============================================================================
+
+TEST_F(Http2SessionTest, UpgradeServesRequestOnStreamOne) {
+  Http2Session session(K_MAX_REQUEST_SIZE);
+  // SETTINGS_INITIAL_WINDOW_SIZE = 100, base64url without padding.
+  ASSERT_TRUE(session.startUpgrade("AAQAAABk"));
+  const std::string switching =
+      "HTTP/1.1 101 Switching Protocols\r\n"
+      "Connection: Upgrade\r\nUpgrade: h2c\r\n\r\n";
+  ASSERT_LE(switching.size(), session.outputSize());
+  EXPECT_EQ(switching, std::string(session.outputData(), switching.size()));
+  session.consumeOutput(switching.size());
+  const FrameList setup = drain(session);
+  ASSERT_EQ(2u, setup.size());
+  EXPECT_EQ(Http2Frame::TYPE_SETTINGS, setup[0].type);
+  EXPECT_FALSE(setup[0].hasFlag(Http2Frame::K_FLAG_ACK));
+
+  EXPECT_TRUE(session.isStreamOpen(1));
+  Http2Session::Request request;
+  EXPECT_FALSE(session.nextRequest(request));
+
+  session.submitHeaders(1, statusHeaders("200"), false);
+  const std::string body(150, 'x');
+  session.submitData(1, body.data(), body.size(), true);
+  EXPECT_EQ(100u, dataBytes(drain(session), 1));
+
+  send(session, std::string(Http2Frame::K_CLIENT_PREFACE,
+                            Http2Frame::K_CLIENT_PREFACE_SIZE) +
+                    settingsFrame(Http2Frame::SETTINGS_ENABLE_PUSH, 0));
+  send(session, windowUpdateFrame(1, 100));
+  EXPECT_EQ(50u, dataBytes(drain(session), 1));
+  EXPECT_FALSE(session.hasFailed());
+}
+
+TEST_F(Http2SessionTest, MalformedUpgradeSettingsAreRefused) {
+  Http2Session session(K_MAX_REQUEST_SIZE);
+  EXPECT_FALSE(session.startUpgrade("not base64!"));
+  EXPECT_FALSE(session.startUpgrade("AAQAAA"));
+}
@@ -411,3 +411,60 @@ TEST_F(HttpMethodTest, AllMethodsCovered) {
   EXPECT_NO_THROW(connect.toString());
   EXPECT_NO_THROW(patch.toString());
 }
+
+// ============================================================================
+// Token Lookup Tests
+// ============================================================================
+
+TEST_F(HttpMethodTest, LookupMethodMapsEveryKnownMethod) {
+  for (int method = HttpMethod::METHOD_GET; method < HttpMethod::METHOD_UNKNOWN;
+       ++method) {
+    const std::string token = HttpMethod::METHOD_STRINGS[method];
+    EXPECT_EQ(method, HttpMethod::lookupMethod(token.data(), token.size()))
+        << token;
+  }
+}
+
+TEST_F(HttpMethodTest, LookupMethodRejectsNearMisses) {
+  EXPECT_EQ(HttpMethod::METHOD_GET, HttpMethod::lookupMethod("get", 3));
+  EXPECT_EQ(HttpMethod::METHOD_UNKNOWN, HttpMethod::lookupMethod("GE", 2));
+  EXPECT_EQ(HttpMethod::METHOD_UNKNOWN, HttpMethod::lookupMethod("GETS", 4));
+  EXPECT_EQ(HttpMethod::METHOD_UNKNOWN, HttpMethod::lookupMethod("PUST", 4));
+  EXPECT_EQ(HttpMethod::METHOD_UNKNOWN, HttpMethod::lookupMethod("", 0));
+  EXPECT_THROW(HttpMethod("GETS"), HttpMethodException);
+}
+
+// ============================================================================
+// Method Mask Tests
+// ============================================================================
+
+TEST_F(HttpMethodTest, EveryKnownMethodHasItsOwnBit) {
+  HttpMethod::MethodMask seen = HttpMethod::NO_METHODS;
+  for (int method = HttpMethod::METHOD_GET; method < HttpMethod::METHOD_UNKNOWN;
+       ++method) {
+    const HttpMethod::MethodMask bit =
+        HttpMethod::maskOf(static_cast<HttpMethod::Method>(method));
+    EXPECT_NE(HttpMethod::NO_METHODS, bit);
+    EXPECT_EQ(HttpMethod::NO_METHODS, seen & bit);
+    seen |= bit;
+  }
+  EXPECT_EQ(HttpMethod::ALL_METHODS, seen);
+  EXPECT_EQ(HttpMethod::NO_METHODS,
+            HttpMethod::maskOf(HttpMethod::METHOD_UNKNOWN));
+  EXPECT_EQ(HttpMethod::maskOf(HttpMethod::METHOD_POST),
+            HttpMethod::post().toMask());
+}
+
+TEST_F(HttpMethodTest, PropertyTableMatchesPredicates) {
+  EXPECT_TRUE(HttpMethod::hasProperty(HttpMethod::METHOD_GET,
+                                      HttpMethod::PROPERTY_SAFE));
+  EXPECT_FALSE(HttpMethod::hasProperty(HttpMethod::METHOD_POST,
+                                       HttpMethod::PROPERTY_IDEMPOTENT));
+  EXPECT_TRUE(HttpMethod::hasProperty(HttpMethod::METHOD_PATCH,
+                                      HttpMethod::PROPERTY_REQUEST_BODY));
+  EXPECT_FALSE(HttpMethod::hasProperty(HttpMethod::METHOD_HEAD,
+                                       HttpMethod::PROPERTY_RESPONSE_BODY));
+  EXPECT_FALSE(HttpMethod::hasProperty(HttpMethod::METHOD_UNKNOWN,
+                                       HttpMethod::PROPERTY_SAFE));
+  EXPECT_TRUE(HttpMethod(HttpMethod::METHOD_UNKNOWN).hasResponseBody());
+}
@@ -0,0 +1,136 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_LatencyHistogram.cpp                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 04:41:57 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 04:41:57 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <gtest/gtest.h>
+#include "domain/shared/utils/LatencyHistogram.hpp"
+
+using domain::shared::utils::LatencyHistogram;
+
+class LatencyHistogramTest : public ::testing::Test {
+ protected:
+  LatencyHistogram m_histogram;
+};
+
+// ============================================================================
+// Bucket Tests
+// ============================================================================
+
+TEST_F(LatencyHistogramTest, SmallValuesAreExact) {
+  for (unsigned long value = 0; value < LatencyHistogram::K_SUB_BUCKETS * 2;
+       ++value) {
+    EXPECT_EQ(value, LatencyHistogram::bucketUpperBound(
+                         LatencyHistogram::bucketIndexFor(value)));
+  }
+}
+
+TEST_F(LatencyHistogramTest, LargeValuesStayWithinRelativeError) {
+  for (unsigned long value = 100; value < 100000000ul; value = value * 3 + 7) {
+    const unsigned long upper = LatencyHistogram::bucketUpperBound(
+        LatencyHistogram::bucketIndexFor(value));
+    EXPECT_GE(upper, value);
+    EXPECT_LE(upper - value, value / LatencyHistogram::K_SUB_BUCKETS + 1)
+        << value;
+  }
+}
+
+TEST_F(LatencyHistogramTest, BucketIndexIsMonotonic) {
+  std::size_t previous = 0;
+  for (unsigned long value = 0; value < 1000000ul; value += 17) {
+    const std::size_t index = LatencyHistogram::bucketIndexFor(value);
+    EXPECT_GE(index, previous);
+    EXPECT_LT(index, m_histogram.getBucketCount());
+    previous = index;
+  }
+}
+
+TEST_F(LatencyHistogramTest, HugeValuesAreClamped) {
+  m_histogram.record(static_cast<unsigned long>(-1));
+
+  EXPECT_EQ(1u, m_histogram.getBucketCountAt(m_histogram.getBucketCount() - 1));
+  EXPECT_EQ(static_cast<unsigned long>(-1), m_histogram.getMax());
+}
+
+// ============================================================================
+// Percentile Tests
+// ============================================================================
+
+TEST_F(LatencyHistogramTest, EmptyHistogramReportsZero) {
+  EXPECT_EQ(0u, m_histogram.getCount());
+  EXPECT_EQ(0u, m_histogram.valueAtPercentile(50));
+  EXPECT_DOUBLE_EQ(0, m_histogram.getMean());
+}
+
+TEST_F(LatencyHistogramTest, PercentilesOfUniformRange) {
+  for (unsigned long value = 1; value <= 100; ++value) {
+    m_histogram.record(value);
+  }
+
+  EXPECT_EQ(100u, m_histogram.getCount());
+  EXPECT_EQ(1u, m_histogram.getMin());
+  EXPECT_EQ(100u, m_histogram.getMax());
+  EXPECT_DOUBLE_EQ(50.5, m_histogram.getMean());
+  EXPECT_EQ(50u, m_histogram.valueAtPercentile(50));
+  EXPECT_EQ(99u, m_histogram.valueAtPercentile(99));
+  EXPECT_EQ(100u, m_histogram.valueAtPercentile(100));
+}
+
+TEST_F(LatencyHistogramTest, TailIsNotHiddenByBulk) {
+  m_histogram.recordMany(1000, 9990);
+  m_histogram.recordMany(250000, 10);
+  const unsigned long bulk = LatencyHistogram::bucketUpperBound(
+      LatencyHistogram::bucketIndexFor(1000));
+
+  EXPECT_EQ(bulk, m_histogram.valueAtPercentile(50));
+  EXPECT_EQ(bulk, m_histogram.valueAtPercentile(99.9));
+  EXPECT_GE(m_histogram.valueAtPercentile(99.95), 250000u);
+  EXPECT_EQ(250000u, m_histogram.valueAtPercentile(99.99));
+}
+
+TEST_F(LatencyHistogramTest, CumulativeCountsFollowBuckets) {
+  m_histogram.recordMany(50, 3);
+  m_histogram.recordMany(5000, 2);
+  m_histogram.record(800000);
+
+  EXPECT_EQ(0u, m_histogram.countAtOrBelow(49));
+  EXPECT_EQ(3u, m_histogram.countAtOrBelow(50));
+  EXPECT_EQ(3u, m_histogram.countAtOrBelow(4000));
+  EXPECT_EQ(5u, m_histogram.countAtOrBelow(5000));
+  EXPECT_EQ(5u, m_histogram.countAtOrBelow(700000));
+  EXPECT_EQ(6u, m_histogram.countAtOrBelow(800000));
+  EXPECT_EQ(6u, m_histogram.countAtOrBelow(static_cast<unsigned long>(-1)));
+}
+
+// ============================================================================
+// Merge Tests
+// ============================================================================
+
+TEST_F(LatencyHistogramTest, MergeCombinesCountsAndExtremes) {
+  LatencyHistogram other;
+  m_histogram.record(500);
+  other.record(20);
+  other.record(90000);
+
+  m_histogram.merge(other);
+
+  EXPECT_EQ(3u, m_histogram.getCount());
+  EXPECT_EQ(20u, m_histogram.getMin());
+  EXPECT_EQ(90000u, m_histogram.getMax());
+}
+
+TEST_F(LatencyHistogramTest, ResetClearsEverything) {
+  m_histogram.record(42);
+  m_histogram.reset();
+
+  EXPECT_EQ(0u, m_histogram.getCount());
+  EXPECT_EQ(0u, m_histogram.getMax());
+  EXPECT_EQ(0u, m_histogram.getBucketCountAt(42));
+}
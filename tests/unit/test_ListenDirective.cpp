@@ -472,3 +472,85 @@ TEST_F(ListenDirectiveTest, ValidateConsistency) {
   EXPECT_TRUE(dir1 == dir2);
 }
 
+
+// ============================================================================
+// Socket Parameter Tests
+// ============================================================================
+
+TEST_F(ListenDirectiveTest, DefaultHasNoSocketOptions) {
+  ListenDirective directive("localhost:8080");
+  EXPECT_FALSE(directive.hasSocketOptions());
+  EXPECT_EQ(0, directive.getBacklog());
+  EXPECT_FALSE(directive.isReusePort());
+  EXPECT_FALSE(directive.isDeferred());
+}
+
+TEST_F(ListenDirectiveTest, ApplyFlagParameters) {
+  ListenDirective directive("localhost:8080");
+  directive.applyParameter("reuseport");
+  directive.applyParameter("deferred");
+  EXPECT_TRUE(directive.isReusePort());
+  EXPECT_TRUE(directive.isDeferred());
+  EXPECT_TRUE(directive.hasSocketOptions());
+}
+
+TEST_F(ListenDirectiveTest, ApplyHttp2Parameter) {
+  ListenDirective directive("localhost:8080");
+  EXPECT_FALSE(directive.isHttp2());
+  directive.applyParameter("http2");
+  EXPECT_TRUE(directive.isHttp2());
+  EXPECT_FALSE(directive.hasSocketOptions());
+  EXPECT_TRUE(ListenDirective(directive).isHttp2());
+  EXPECT_THROW(directive.applyParameter("http2=on"), ListenDirectiveException);
+}
+
+TEST_F(ListenDirectiveTest, ApplyValueParameters) {
+  ListenDirective directive("localhost:8080");
+  directive.applyParameter("backlog=512");
+  directive.applyParameter("fastopen=16");
+  directive.applyParameter("rcvbuf=64k");
+  directive.applyParameter("sndbuf=1024");
+  EXPECT_EQ(512, directive.getBacklog());
+  EXPECT_EQ(16u, directive.getFastOpenQueueLength());
+  EXPECT_EQ(65536u, directive.getReceiveBufferSize());
+  EXPECT_EQ(1024u, directive.getSendBufferSize());
+}
+
+TEST_F(ListenDirectiveTest, ApplyInvalidParameters) {
+  ListenDirective directive("localhost:8080");
+  EXPECT_THROW(directive.applyParameter("unknown"), ListenDirectiveException);
+  EXPECT_THROW(directive.applyParameter("backlog="), ListenDirectiveException);
+  EXPECT_THROW(directive.applyParameter("backlog=abc"),
+               ListenDirectiveException);
+  EXPECT_THROW(directive.applyParameter("backlog=0"), ListenDirectiveException);
+  EXPECT_THROW(directive.applyParameter("backlog=70000"),
+               ListenDirectiveException);
+  EXPECT_THROW(directive.applyParameter("rcvbuf=huge"),
+               ListenDirectiveException);
+}
+
+TEST_F(ListenDirectiveTest, IsParameterRecognizesKeywords) {
+  EXPECT_TRUE(ListenDirective::isParameter("reuseport"));
+  EXPECT_TRUE(ListenDirective::isParameter("deferred"));
+  EXPECT_TRUE(ListenDirective::isParameter("backlog=128"));
+  EXPECT_TRUE(ListenDirective::isParameter("sndbuf=8k"));
+  EXPECT_TRUE(ListenDirective::isParameter("ssl"));
+  EXPECT_TRUE(ListenDirective::isParameter("http2"));
+  EXPECT_FALSE(ListenDirective::isParameter("localhost:8080"));
+  EXPECT_FALSE(ListenDirective::isParameter("8080"));
+}
+
+TEST_F(ListenDirectiveTest, CopyPreservesSocketOptions) {
+  ListenDirective original("localhost:8080");
+  original.applyParameter("backlog=256");
+  original.applyParameter("reuseport");
+
+  ListenDirective copy(original);
+  EXPECT_EQ(256, copy.getBacklog());
+  EXPECT_TRUE(copy.isReusePort());
+
+  ListenDirective assigned;
+  assigned = original;
+  EXPECT_EQ(256, assigned.getBacklog());
+  EXPECT_TRUE(assigned.isReusePort());
+}
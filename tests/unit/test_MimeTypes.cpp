@@ -0,0 +1,201 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_MimeTypes.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 22:48:15 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 22:48:15 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <gtest/gtest.h>
+#include "domain/configuration/entities/HttpConfig.hpp"
+#include "domain/configuration/value_objects/MimeTypes.hpp"
+#include "infrastructure/config/parsers/ConfigParser.hpp"
+#include "mocks/MockLogger.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using domain::configuration::entities::HttpConfig;
+using domain::configuration::value_objects::MimeTypes;
+using infrastructure::config::parsers::ConfigParser;
+
+class MimeTypesTest : public ::testing::Test {
+ protected:
+  void TearDown() {
+    std::remove(K_CONFIG_PATH);
+    std::remove(K_TYPES_PATH);
+  }
+
+  static void writeFile(const char* path, const std::string& content) {
+    std::ofstream file(path);
+    file << content;
+  }
+
+  static std::string serverBlock() {
+    return "    server {\n"
+           "        listen 8099;\n"
+           "        server_name localhost;\n"
+           "        root /tmp;\n"
+           "        location / { limit_except GET { deny all; } }\n"
+           "    }\n";
+  }
+
+  static const char* const K_CONFIG_PATH;
+  static const char* const K_TYPES_PATH;
+
+  tests::mocks::MockLogger m_logger;
+};
+
+const char* const MimeTypesTest::K_CONFIG_PATH = "/tmp/webserv_mime_test.conf";
+const char* const MimeTypesTest::K_TYPES_PATH = "/tmp/webserv_mime_test.types";
+
+// ============================================================================
+// Lookup Tests
+// ============================================================================
+
+TEST_F(MimeTypesTest, LookupFoldsCaseAndLeadingDot) {
+  MimeTypes types;
+  types.add("text/html", "HTML");
+
+  EXPECT_EQ("text/html", types.lookup("html"));
+  EXPECT_EQ("text/html", types.lookup(".Html"));
+  EXPECT_TRUE(types.contains("hTmL"));
+  EXPECT_EQ(1u, types.size());
+}
+
+TEST_F(MimeTypesTest, UnknownExtensionUsesDefaultType) {
+  MimeTypes types;
+  types.add("image/png", "png");
+
+  EXPECT_EQ(MimeTypes::DEFAULT_TYPE, types.lookup("exe"));
+  types.setDefaultType("text/plain");
+  EXPECT_EQ("text/plain", types.lookup("exe"));
+  EXPECT_EQ("text/plain", types.lookup(""));
+}
+
+TEST_F(MimeTypesTest, LookupFilenameUsesLastExtension) {
+  const MimeTypes& types = MimeTypes::builtin();
+
+  EXPECT_EQ("application/gzip", types.lookupFilename("archive.tar.gz"));
+  EXPECT_EQ("image/jpeg", types.lookupFilename("PHOTO.JPG"));
+  EXPECT_EQ(MimeTypes::DEFAULT_TYPE, types.lookupFilename("README"));
+  EXPECT_EQ(MimeTypes::DEFAULT_TYPE, types.lookupFilename("trailing."));
+  EXPECT_EQ(MimeTypes::DEFAULT_TYPE, types.lookupFilename("v1.2/README"));
+}
+
+TEST_F(MimeTypesTest, LaterDeclarationOverridesEarlierOne) {
+  MimeTypes types;
+  types.add("application/javascript", "js");
+  types.add("text/javascript", "JS");
+
+  EXPECT_EQ("text/javascript", types.lookup("js"));
+  EXPECT_EQ(1u, types.size());
+}
+
+TEST_F(MimeTypesTest, TableGrowsWithoutLosingEntries) {
+  MimeTypes types;
+  for (int i = 0; i < 500; ++i) {
+    std::ostringstream extension;
+    std::ostringstream type;
+    extension << "ext" << i;
+    type << "application/x-" << i;
+    types.add(type.str(), extension.str());
+  }
+
+  EXPECT_EQ(500u, types.size());
+  for (int i = 0; i < 500; ++i) {
+    std::ostringstream extension;
+    std::ostringstream type;
+    extension << "EXT" << i;
+    type << "application/x-" << i;
+    EXPECT_EQ(type.str(), types.lookup(extension.str()));
+  }
+}
+
+TEST_F(MimeTypesTest, MergeKeepsDefaultType) {
+  MimeTypes types;
+  types.setDefaultType("text/plain");
+  types.merge(MimeTypes::builtin());
+
+  EXPECT_EQ(MimeTypes::builtin().size(), types.size());
+  EXPECT_EQ("text/css", types.lookup("css"));
+  EXPECT_EQ("text/plain", types.getDefaultType());
+}
+
+TEST_F(MimeTypesTest, ValidatesTypeShape) {
+  EXPECT_TRUE(MimeTypes::isValidType("image/svg+xml"));
+  EXPECT_FALSE(MimeTypes::isValidType("html"));
+  EXPECT_FALSE(MimeTypes::isValidType("/html"));
+  EXPECT_FALSE(MimeTypes::isValidType("text/"));
+  EXPECT_FALSE(MimeTypes::isValidType("text/html/extra"));
+}
+
+// ============================================================================
+// Configuration Tests
+// ============================================================================
+
+TEST_F(MimeTypesTest, ConfigWithoutTypesUsesBuiltinTable) {
+  writeFile(K_CONFIG_PATH, "http {\n" + serverBlock() + "}\n");
+
+  ConfigParser parser(m_logger);
+  HttpConfig* config = parser.parseFile(K_CONFIG_PATH);
+
+  EXPECT_EQ(MimeTypes::builtin().size(), config->getMimeTypes().size());
+  EXPECT_EQ("text/html", config->getMimeType(".html"));
+  delete config;
+}
+
+TEST_F(MimeTypesTest, TypesBlockAndDefaultTypeAreParsed) {
+  writeFile(K_CONFIG_PATH,
+            "http {\n"
+            "    types {\n"
+            "        text/html html htm;\n"
+            "        image/webp webp;\n"
+            "    }\n"
+            "    default_type text/plain;\n" +
+                serverBlock() + "}\n");
+
+  ConfigParser parser(m_logger);
+  HttpConfig* config = parser.parseFile(K_CONFIG_PATH);
+
+  EXPECT_EQ(3u, config->getMimeTypes().size());
+  EXPECT_EQ("image/webp", config->getMimeTypes().lookupFilename("a.WEBP"));
+  EXPECT_EQ("text/plain", config->getMimeTypes().lookupFilename("a.css"));
+  delete config;
+}
+
+TEST_F(MimeTypesTest, IncludedTypesFileIsMerged) {
+  writeFile(K_TYPES_PATH,
+            "types {\n"
+            "    application/wasm wasm;\n"
+            "    font/woff2 woff2;\n"
+            "}\n");
+  writeFile(K_CONFIG_PATH, std::string("http {\n    include ") +
+                               K_TYPES_PATH + ";\n" + serverBlock() + "}\n");
+
+  ConfigParser parser(m_logger);
+  HttpConfig* config = parser.parseFile(K_CONFIG_PATH);
+
+  EXPECT_EQ(2u, config->getMimeTypes().size());
+  EXPECT_EQ("application/wasm", config->getMimeType("wasm"));
+  EXPECT_EQ("font/woff2", config->getMimeType("WOFF2"));
+  delete config;
+}
+
+TEST_F(MimeTypesTest, MalformedTypesEntryIsRejected) {
+  writeFile(K_CONFIG_PATH,
+            "http {\n"
+            "    types {\n"
+            "        texthtml html;\n"
+            "    }\n" +
+                serverBlock() + "}\n");
+
+  ConfigParser parser(m_logger);
+  EXPECT_ANY_THROW(delete parser.parseFile(K_CONFIG_PATH));
+}
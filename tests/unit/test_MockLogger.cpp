@@ -179,3 +179,51 @@ TEST_F(MockLoggerTest, HasLogShouldFindSpecificLogEntry) {
   EXPECT_TRUE(logger.hasLog(INFO, "Specific message"));
   EXPECT_FALSE(logger.hasLog(ERROR, "Specific message"));
 }
+
+// ============================================================================
+// Level Threshold Tests
+// ============================================================================
+
+namespace {
+
+int g_formatCalls = 0;
+
+int countFormat(int value) {
+  ++g_formatCalls;
+  return value;
+}
+
+}  // namespace
+
+TEST_F(MockLoggerTest, SetLevelShouldDropLogsBelowThreshold) {
+  MockLogger logger;
+  logger.setLevel(WARN);
+  logger.debug("Debug");
+  logger.info("Info");
+  logger.warn("Warn");
+  logger.error("Error");
+
+  EXPECT_FALSE(logger.isEnabled(INFO));
+  EXPECT_TRUE(logger.isEnabled(ERROR));
+  EXPECT_EQ(2u, logger.getLogCount());
+  EXPECT_TRUE(logger.hasLog(WARN, "Warn"));
+}
+
+TEST_F(MockLoggerTest, LogMacroShouldFormatEnabledMessage) {
+  MockLogger logger;
+  g_formatCalls = 0;
+  WEBSERV_LOG_INFO(logger, "Read " << countFormat(42) << " bytes");
+
+  EXPECT_EQ(1, g_formatCalls);
+  EXPECT_TRUE(logger.hasLog(INFO, "Read 42 bytes"));
+}
+
+TEST_F(MockLoggerTest, LogMacroShouldSkipFormattingWhenDisabled) {
+  MockLogger logger;
+  logger.setLevel(INFO);
+  g_formatCalls = 0;
+  WEBSERV_LOG_DEBUG(logger, "Read " << countFormat(42) << " bytes");
+
+  EXPECT_EQ(0, g_formatCalls);
+  EXPECT_EQ(0u, logger.getLogCount());
+}
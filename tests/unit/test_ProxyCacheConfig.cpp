@@ -0,0 +1,163 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_ProxyCacheConfig.cpp                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:04:52 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:04:52 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "domain/configuration/exceptions/CacheConfigException.hpp"
+#include "domain/configuration/value_objects/CacheZoneConfig.hpp"
+#include "domain/configuration/value_objects/ProxyCacheConfig.hpp"
+#include "domain/shared/utils/BinaryReader.hpp"
+#include "domain/shared/utils/BinaryWriter.hpp"
+
+#include <gtest/gtest.h>
+
+using domain::configuration::exceptions::CacheConfigException;
+using domain::configuration::value_objects::CacheZoneConfig;
+using domain::configuration::value_objects::ProxyCacheConfig;
+using domain::shared::utils::BinaryReader;
+using domain::shared::utils::BinaryWriter;
+
+class ProxyCacheConfigTest : public ::testing::Test {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+
+  static ProxyCacheConfig::StatusList statuses(unsigned int first,
+                                               unsigned int second = 0) {
+    ProxyCacheConfig::StatusList list;
+    list.push_back(first);
+    if (second != 0) {
+      list.push_back(second);
+    }
+    return list;
+  }
+};
+
+// ============================================================================
+// Cache Zone Tests
+// ============================================================================
+
+TEST_F(ProxyCacheConfigTest, ZoneDefaults) {
+  const CacheZoneConfig zone("pages", "/var/cache/webserv/");
+  EXPECT_EQ("pages", zone.getName());
+  EXPECT_EQ("/var/cache/webserv", zone.getPath());
+  EXPECT_EQ("1:2", zone.formatLevels());
+  EXPECT_EQ(0u, zone.getMaxSize());
+  EXPECT_EQ(CacheZoneConfig::DEFAULT_INACTIVE, zone.getInactive());
+}
+
+TEST_F(ProxyCacheConfigTest, ZoneRejectsBadNameAndRelativePath) {
+  EXPECT_THROW(CacheZoneConfig("", "/tmp/cache"), CacheConfigException);
+  EXPECT_THROW(CacheZoneConfig("bad zone", "/tmp/cache"),
+               CacheConfigException);
+  EXPECT_THROW(CacheZoneConfig("pages", "cache"), CacheConfigException);
+}
+
+TEST_F(ProxyCacheConfigTest, LevelsAreParsedAndBounded) {
+  CacheZoneConfig zone("pages", "/tmp/cache");
+  zone.setLevels("2");
+  EXPECT_EQ("2", zone.formatLevels());
+  zone.setLevels("1:1:2");
+  ASSERT_EQ(3u, zone.getLevels().size());
+  EXPECT_EQ(2u, zone.getLevels()[2]);
+
+  EXPECT_THROW(zone.setLevels("3"), CacheConfigException);
+  EXPECT_THROW(zone.setLevels("1:2:2:1"), CacheConfigException);
+  EXPECT_THROW(zone.setLevels("1:"), CacheConfigException);
+  EXPECT_THROW(zone.setLevels("a"), CacheConfigException);
+  EXPECT_THROW(zone.setInactive(0), CacheConfigException);
+}
+
+// ============================================================================
+// Location Settings Tests
+// ============================================================================
+
+TEST_F(ProxyCacheConfigTest, DisabledByDefault) {
+  ProxyCacheConfig config;
+  EXPECT_FALSE(config.isEnabled());
+  EXPECT_EQ(ProxyCacheConfig::DEFAULT_KEY, config.getKey());
+  EXPECT_FALSE(config.isLockEnabled());
+  EXPECT_EQ(ProxyCacheConfig::DEFAULT_LOCK_TIMEOUT, config.getLockTimeout());
+
+  config.setZone("pages");
+  EXPECT_TRUE(config.isEnabled());
+  config.disable();
+  EXPECT_FALSE(config.isEnabled());
+}
+
+TEST_F(ProxyCacheConfigTest, KeyMustUseSupportedVariables) {
+  EXPECT_TRUE(ProxyCacheConfig::isValidKey("$scheme$host$request_uri"));
+  EXPECT_TRUE(ProxyCacheConfig::isValidKey("v1:${uri}|$http_accept_language"));
+  EXPECT_FALSE(ProxyCacheConfig::isValidKey("static"));
+  EXPECT_FALSE(ProxyCacheConfig::isValidKey("$cookie_session"));
+  EXPECT_FALSE(ProxyCacheConfig::isValidKey("${uri"));
+
+  ProxyCacheConfig config;
+  EXPECT_THROW(config.setKey("$nope"), CacheConfigException);
+  config.setKey("$host$uri");
+  EXPECT_EQ("$host$uri", config.getKey());
+}
+
+TEST_F(ProxyCacheConfigTest, ExactStatusWinsOverAny) {
+  ProxyCacheConfig config;
+  config.addValidity(ProxyCacheConfig::StatusList(), 600);
+  config.addValidity(statuses(404), 60);
+  config.addValidity(statuses(ProxyCacheConfig::ANY_STATUS), 5);
+
+  EXPECT_EQ(600u, config.getValidity(200));
+  EXPECT_EQ(600u, config.getValidity(301));
+  EXPECT_EQ(600u, config.getValidity(302));
+  EXPECT_EQ(60u, config.getValidity(404));
+  EXPECT_EQ(5u, config.getValidity(500));
+}
+
+TEST_F(ProxyCacheConfigTest, RepeatedStatusReplacesEarlierRule) {
+  ProxyCacheConfig config;
+  config.addValidity(statuses(200, 404), 60);
+  config.addValidity(statuses(404), 10);
+  EXPECT_EQ(60u, config.getValidity(200));
+  EXPECT_EQ(10u, config.getValidity(404));
+  EXPECT_EQ(0u, config.getValidity(500));
+
+  EXPECT_THROW(config.addValidity(statuses(99), 60), CacheConfigException);
+  EXPECT_THROW(config.addValidity(statuses(200), 0), CacheConfigException);
+}
+
+// ============================================================================
+// Serialization Tests
+// ============================================================================
+
+TEST_F(ProxyCacheConfigTest, SerializeRoundTrips) {
+  CacheZoneConfig zone("pages", "/tmp/cache");
+  zone.setLevels("2:2");
+  zone.setMaxSize(1024);
+  zone.setInactive(30);
+
+  ProxyCacheConfig config;
+  config.setZone("pages");
+  config.setKey("$host$request_uri");
+  config.addValidity(statuses(200, 404), 60);
+  config.setLockEnabled(true);
+  config.setLockTimeout(2);
+
+  BinaryWriter writer;
+  zone.serialize(writer);
+  config.serialize(writer);
+
+  BinaryReader reader(writer.getBuffer().data(), writer.size());
+  CacheZoneConfig loadedZone;
+  loadedZone.deserialize(reader);
+  ProxyCacheConfig loadedConfig;
+  loadedConfig.deserialize(reader);
+
+  EXPECT_TRUE(reader.isAtEnd());
+  EXPECT_EQ(zone, loadedZone);
+  EXPECT_EQ(config, loadedConfig);
+}
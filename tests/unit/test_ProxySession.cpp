@@ -0,0 +1,475 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_ProxySession.cpp                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 10:44:39 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 10:44:39 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <gtest/gtest.h>
+#include "domain/configuration/entities/HttpConfig.hpp"
+#include "domain/configuration/value_objects/UpstreamConfig.hpp"
+#include "infrastructure/proxy/adapters/ProxySession.hpp"
+#include "infrastructure/proxy/adapters/UpstreamPool.hpp"
+#include "infrastructure/proxy/exceptions/ProxyException.hpp"
+#include "infrastructure/proxy/primitives/UpstreamRequest.hpp"
+#include "infrastructure/proxy/primitives/UpstreamResponseParser.hpp"
+#include "mocks/MockHttpUpstream.hpp"
+#include "mocks/MockLogger.hpp"
+
+#include <arpa/inet.h>
+#include <cstring>
+#include <ctime>
+#include <netinet/in.h>
+#include <poll.h>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+using domain::configuration::entities::HttpConfig;
+using domain::configuration::value_objects::UpstreamConfig;
+using infrastructure::proxy::adapters::ProxySession;
+using infrastructure::proxy::adapters::UpstreamPool;
+using infrastructure::proxy::exceptions::ProxyException;
+using infrastructure::proxy::primitives::UpstreamRequest;
+using infrastructure::proxy::primitives::UpstreamResponseParser;
+
+class ProxySessionTest : public ::testing::Test {
+ protected:
+  static const int K_POLL_TIMEOUT_MS = 2000;
+
+  static UpstreamConfig makeUpstream(const std::string& name,
+                                     const std::vector<unsigned int>& ports) {
+    UpstreamConfig upstream(name);
+    for (std::size_t i = 0; i < ports.size(); ++i) {
+      UpstreamConfig::Server server("127.0.0.1", ports[i]);
+      upstream.addServer(server);
+    }
+    return upstream;
+  }
+
+  // A loopback port nothing listens on.
+  static unsigned int closedPort() {
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(addr);
+    ::bind(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr));
+    ::getsockname(fd, reinterpret_cast<struct sockaddr*>(&addr), &length);
+    ::close(fd);
+    return ntohs(addr.sin_port);
+  }
+
+  static std::string head(const std::string& method,
+                          const std::string& target, std::size_t bodySize) {
+    return UpstreamRequest::buildHead(method, target, "origin",
+                                      UpstreamRequest::HeaderMap(),
+                                      "127.0.0.1", bodySize);
+  }
+
+  static bool waitFor(const ProxySession& session) {
+    struct pollfd entry = {session.getFd(),
+                           static_cast<short>(session.wantsWrite() ? POLLOUT
+                                                                   : POLLIN),
+                           0};
+    return ::poll(&entry, 1, K_POLL_TIMEOUT_MS) > 0;
+  }
+
+  static void awaitHeaders(ProxySession& session) {
+    session.start();
+    while (!session.advance()) {
+      ASSERT_TRUE(waitFor(session));
+    }
+  }
+
+  static std::string readBody(ProxySession& session) {
+    std::string body;
+    char buffer[64];
+    for (;;) {
+      const ssize_t received = session.read(buffer, sizeof(buffer));
+      if (received == 0) {
+        return body;
+      }
+      if (received == ProxySession::K_WOULD_BLOCK) {
+        if (!waitFor(session)) {
+          return body;
+        }
+        continue;
+      }
+      body.append(buffer, static_cast<std::size_t>(received));
+    }
+  }
+
+  std::string exchange(UpstreamPool& pool, const std::string& groupKey,
+                       const std::string& target) {
+    ProxySession session(m_logger, pool, groupKey, head("GET", target, 0),
+                         std::vector<char>(), "");
+    awaitHeaders(session);
+    const std::string body = readBody(session);
+    session.finish();
+    return body;
+  }
+
+  tests::mocks::MockLogger m_logger;
+};
+
+// ============================================================================
+// Request Head Tests
+// ============================================================================
+
+TEST_F(ProxySessionTest, HeadDropsHopByHopHeadersAndForwardsClient) {
+  UpstreamRequest::HeaderMap headers;
+  headers["Host"] = "client.example";
+  headers["Connection"] = "Upgrade";
+  headers["Keep-Alive"] = "timeout=5";
+  headers["X-Forwarded-For"] = "10.0.0.9";
+  headers["Accept"] = "*/*";
+
+  const std::string built = UpstreamRequest::buildHead(
+      "GET", "/v1/users?id=7", "backend", headers, "192.0.2.1", 0);
+
+  EXPECT_EQ(0u, built.find("GET /v1/users?id=7 HTTP/1.1\r\nHost: backend\r\n"));
+  EXPECT_NE(std::string::npos, built.find("Accept: */*\r\n"));
+  EXPECT_NE(std::string::npos,
+            built.find("X-Forwarded-For: 10.0.0.9, 192.0.2.1\r\n"));
+  EXPECT_EQ(std::string::npos, built.find("client.example"));
+  EXPECT_EQ(std::string::npos, built.find("Keep-Alive"));
+  EXPECT_EQ(std::string::npos, built.find("Content-Length"));
+  EXPECT_NE(std::string::npos,
+            built.find("Connection: keep-alive\r\n\r\n"));
+}
+
+TEST_F(ProxySessionTest, HeadAnnouncesBodyLength) {
+  EXPECT_NE(std::string::npos,
+            head("POST", "/", 0).find("Content-Length: 0\r\n"));
+  EXPECT_NE(std::string::npos,
+            head("DELETE", "/", 12).find("Content-Length: 12\r\n"));
+}
+
+TEST_F(ProxySessionTest, TargetRewriteFollowsProxyPassPath) {
+  EXPECT_EQ("/api/users?x=1",
+            UpstreamRequest::rewriteTarget("/api/users", "?x=1", "/api/", ""));
+  EXPECT_EQ("/users",
+            UpstreamRequest::rewriteTarget("/api/users", "", "/api/", "/"));
+  EXPECT_EQ("/v2/users",
+            UpstreamRequest::rewriteTarget("/api/users", "", "/api", "/v2"));
+  EXPECT_EQ("/v2/users",
+            UpstreamRequest::rewriteTarget("/api/users", "", "/api/", "/v2/"));
+}
+
+// ============================================================================
+// Response Parser Tests
+// ============================================================================
+
+TEST_F(ProxySessionTest, ParserDecodesLengthFramedResponseInPieces) {
+  const std::string response =
+      "HTTP/1.1 201 Created\r\nContent-Length: 5\r\nX-A: 1\r\nX-A: 2\r\n"
+      "\r\nhello";
+  UpstreamResponseParser parser;
+  std::string body;
+  for (std::size_t i = 0; i < response.size(); ++i) {
+    parser.feed(&response[i], 1, body);
+  }
+
+  ASSERT_TRUE(parser.isComplete());
+  EXPECT_EQ(201u, parser.getStatusCode());
+  EXPECT_EQ(UpstreamResponseParser::FRAMING_LENGTH, parser.getFraming());
+  EXPECT_EQ(3u, parser.getHeaders().size());
+  EXPECT_EQ("1", parser.getHeader("x-a"));
+  EXPECT_TRUE(parser.isKeepAlive());
+  EXPECT_EQ("hello", body);
+}
+
+TEST_F(ProxySessionTest, ParserRemovesChunkedFramingAndSkipsInterim) {
+  const std::string response =
+      "HTTP/1.1 100 Continue\r\n\r\n"
+      "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n"
+      "3;ext=1\r\nabc\r\n2\r\nde\r\n0\r\nX-Trailer: t\r\n\r\n";
+  UpstreamResponseParser parser;
+  std::string body;
+  parser.feed(response.data(), response.size(), body);
+
+  ASSERT_TRUE(parser.isComplete());
+  EXPECT_EQ(200u, parser.getStatusCode());
+  EXPECT_EQ(UpstreamResponseParser::FRAMING_CHUNKED, parser.getFraming());
+  EXPECT_EQ("abcde", body);
+}
+
+TEST_F(ProxySessionTest, ParserReadsUntilCloseWithoutFraming) {
+  const std::string response = "HTTP/1.0 200 OK\r\n\r\npartial";
+  UpstreamResponseParser parser;
+  std::string body;
+  parser.feed(response.data(), response.size(), body);
+
+  EXPECT_FALSE(parser.isComplete());
+  EXPECT_FALSE(parser.isKeepAlive());
+  parser.finishOnClose();
+  EXPECT_TRUE(parser.isComplete());
+  EXPECT_EQ("partial", body);
+}
+
+TEST_F(ProxySessionTest, ParserHeadResponseHasNoBody) {
+  const std::string response = "HTTP/1.1 200 OK\r\nContent-Length: 99\r\n\r\n";
+  UpstreamResponseParser parser;
+  parser.setHeadRequest(true);
+  std::string body;
+  parser.feed(response.data(), response.size(), body);
+
+  EXPECT_TRUE(parser.isComplete());
+  EXPECT_EQ(99u, parser.getContentLength());
+  EXPECT_TRUE(body.empty());
+}
+
+TEST_F(ProxySessionTest, ParserRejectsMalformedStatusLine) {
+  const std::string response = "HTTP/1.1 abc OK\r\n\r\n";
+  UpstreamResponseParser parser;
+  std::string body;
+  EXPECT_THROW(parser.feed(response.data(), response.size(), body),
+               ProxyException);
+}
+
+// ============================================================================
+// Balancing Tests
+// ============================================================================
+
+TEST_F(ProxySessionTest, WeightedRoundRobinIsSmooth) {
+  UpstreamConfig upstream("app");
+  UpstreamConfig::Server heavy("127.0.0.1", 9001);
+  heavy.weight = 2;
+  upstream.addServer(heavy);
+  upstream.addServer(UpstreamConfig::Server("127.0.0.1", 9002));
+  HttpConfig::Upstreams upstreams;
+  upstreams["app"] = upstream;
+
+  UpstreamPool pool(m_logger);
+  pool.configure(upstreams);
+  const UpstreamPool::Group* group = pool.findGroup(pool.resolve("app", 0));
+  ASSERT_TRUE(group != NULL);
+
+  std::string order;
+  for (int i = 0; i < 6; ++i) {
+    const UpstreamPool::Peer* peer =
+        pool.select(*group, "", UpstreamPool::PeerList(), std::time(NULL));
+    ASSERT_TRUE(peer != NULL);
+    order += peer->server.port == 9001 ? "a" : "b";
+  }
+  EXPECT_EQ("abaaba", order);
+}
+
+TEST_F(ProxySessionTest, HashPinsKeyToOneServer) {
+  std::vector<unsigned int> ports;
+  ports.push_back(9001);
+  ports.push_back(9002);
+  ports.push_back(9003);
+  UpstreamConfig upstream = makeUpstream("app", ports);
+  upstream.setHashKey("$remote_addr");
+  HttpConfig::Upstreams upstreams;
+  upstreams["app"] = upstream;
+
+  UpstreamPool pool(m_logger);
+  pool.configure(upstreams);
+  const UpstreamPool::Group* group = pool.findGroup("app");
+  ASSERT_TRUE(group != NULL);
+
+  const std::time_t now = std::time(NULL);
+  const UpstreamPool::Peer* first =
+      pool.select(*group, "192.0.2.7", UpstreamPool::PeerList(), now);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(first,
+              pool.select(*group, "192.0.2.7", UpstreamPool::PeerList(), now));
+  }
+
+  UpstreamPool::PeerList exclude;
+  exclude.push_back(group->peers[0]);
+  exclude.push_back(group->peers[1]);
+  exclude.push_back(group->peers[2]);
+  EXPECT_TRUE(pool.select(*group, "192.0.2.7", exclude, now) == NULL);
+}
+
+TEST_F(ProxySessionTest, FailedServerIsSkippedUntilFailTimeout) {
+  std::vector<unsigned int> ports;
+  ports.push_back(9001);
+  ports.push_back(9002);
+  HttpConfig::Upstreams upstreams;
+  upstreams["app"] = makeUpstream("app", ports);
+
+  UpstreamPool pool(m_logger);
+  pool.configure(upstreams);
+  const UpstreamPool::Group* group = pool.findGroup("app");
+  ASSERT_TRUE(group != NULL);
+  UpstreamPool::Peer* failing = group->peers[0];
+
+  const std::time_t now = std::time(NULL);
+  pool.reportFailure(*failing, now);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_NE(failing, pool.select(*group, "", UpstreamPool::PeerList(), now));
+  }
+
+  const std::time_t later =
+      now + static_cast<std::time_t>(UpstreamConfig::DEFAULT_FAIL_TIMEOUT) + 1;
+  bool selectedAgain = false;
+  for (int i = 0; i < 4; ++i) {
+    selectedAgain = selectedAgain || pool.select(*group, "",
+                                                 UpstreamPool::PeerList(),
+                                                 later) == failing;
+  }
+  EXPECT_TRUE(selectedAgain);
+}
+
+// ============================================================================
+// Session Tests
+// ============================================================================
+
+TEST_F(ProxySessionTest, RelaysRequestBodyAndResponse) {
+  mocks::MockHttpUpstream origin;
+  origin.start();
+  UpstreamPool pool(m_logger);
+  const std::string key = pool.resolve("127.0.0.1", origin.getPort());
+
+  const std::string payload = "name=value";
+  ProxySession session(m_logger, pool, key,
+                       head("POST", "/submit", payload.size()),
+                       std::vector<char>(payload.begin(), payload.end()), "");
+  awaitHeaders(session);
+
+  EXPECT_EQ(200u, session.getResponse().getStatusCode());
+  const std::string body = readBody(session);
+  EXPECT_NE(std::string::npos,
+            body.find("request=POST /submit HTTP/1.1\n"));
+  EXPECT_NE(std::string::npos, body.find("host=origin\n"));
+  EXPECT_NE(std::string::npos, body.find("body=name=value"));
+}
+
+TEST_F(ProxySessionTest, KeepAliveReusesPooledConnection) {
+  mocks::MockHttpUpstream origin;
+  origin.start();
+  UpstreamPool pool(m_logger);
+  const std::string key = pool.resolve("127.0.0.1", origin.getPort());
+
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_NE(std::string::npos,
+              exchange(pool, key, "/").find("connection=1\n"));
+  }
+  EXPECT_EQ(1u, pool.getConnectCount());
+  EXPECT_EQ(2u, pool.getReuseCount());
+  EXPECT_EQ(1u, pool.getIdleCount());
+}
+
+TEST_F(ProxySessionTest, ChunkedAndCloseDelimitedBodiesAreDecoded) {
+  mocks::MockHttpUpstream origin;
+  origin.start();
+  UpstreamPool pool(m_logger);
+  const std::string key = pool.resolve("127.0.0.1", origin.getPort());
+
+  EXPECT_NE(std::string::npos,
+            exchange(pool, key, "/chunked").find("request=GET /chunked"));
+  EXPECT_EQ(1u, pool.getIdleCount());
+
+  EXPECT_NE(std::string::npos,
+            exchange(pool, key, "/eof").find("request=GET /eof"));
+  EXPECT_EQ(0u, pool.getIdleCount());
+}
+
+TEST_F(ProxySessionTest, ConnectionClosedByUpstreamIsNotPooled) {
+  mocks::MockHttpUpstream origin(false);
+  origin.start();
+  UpstreamPool pool(m_logger);
+  const std::string key = pool.resolve("127.0.0.1", origin.getPort());
+
+  EXPECT_NE(std::string::npos, exchange(pool, key, "/").find("connection=1\n"));
+  EXPECT_NE(std::string::npos, exchange(pool, key, "/").find("connection=2\n"));
+  EXPECT_EQ(2u, pool.getConnectCount());
+  EXPECT_EQ(0u, pool.getReuseCount());
+  EXPECT_EQ(0u, pool.getIdleCount());
+}
+
+TEST_F(ProxySessionTest, RefusedServerFailsOverToNextOne) {
+  mocks::MockHttpUpstream origin;
+  origin.start();
+  std::vector<unsigned int> ports;
+  ports.push_back(closedPort());
+  ports.push_back(origin.getPort());
+  HttpConfig::Upstreams upstreams;
+  upstreams["app"] = makeUpstream("app", ports);
+  UpstreamPool pool(m_logger);
+  pool.configure(upstreams);
+
+  std::size_t attempts = 0;
+  for (int i = 0; i < 3; ++i) {
+    ProxySession session(m_logger, pool, "app", head("GET", "/", 0),
+                         std::vector<char>(), "");
+    awaitHeaders(session);
+    EXPECT_EQ(200u, session.getResponse().getStatusCode());
+    EXPECT_NE(std::string::npos, readBody(session).find("connection="));
+    attempts += session.getAttempts();
+  }
+  EXPECT_EQ(4u, attempts);
+  EXPECT_TRUE(m_logger.hasLog(WARN, "marked down"));
+}
+
+TEST_F(ProxySessionTest, UnresolvableServerIsSkipped) {
+  mocks::MockHttpUpstream origin;
+  origin.start();
+  UpstreamConfig upstream("app");
+  upstream.addServer(UpstreamConfig::Server("upstream.invalid", 9000));
+  upstream.addServer(UpstreamConfig::Server("127.0.0.1", origin.getPort()));
+  HttpConfig::Upstreams upstreams;
+  upstreams["app"] = upstream;
+  UpstreamPool pool(m_logger);
+  pool.configure(upstreams);
+  EXPECT_TRUE(m_logger.hasLog(WARN, "Cannot resolve upstream server"));
+
+  for (int i = 0; i < 2; ++i) {
+    ProxySession session(m_logger, pool, "app", head("GET", "/", 0),
+                         std::vector<char>(), "");
+    awaitHeaders(session);
+    EXPECT_EQ(200u, session.getResponse().getStatusCode());
+    readBody(session);
+    session.finish();
+  }
+  EXPECT_EQ(1u, pool.getConnectCount());
+}
+
+TEST_F(ProxySessionTest, NoLiveServerThrows) {
+  UpstreamPool pool(m_logger);
+  const std::string key = pool.resolve("127.0.0.1", closedPort());
+
+  ProxySession session(m_logger, pool, key, head("GET", "/", 0),
+                       std::vector<char>(), "");
+  bool failed = false;
+  try {
+    session.start();
+    while (!session.advance()) {
+      ASSERT_TRUE(waitFor(session));
+    }
+  } catch (const ProxyException&) {
+    failed = true;
+  }
+  EXPECT_TRUE(failed);
+}
+
+TEST_F(ProxySessionTest, SilentUpstreamTimesOut) {
+  mocks::MockHttpUpstream origin;
+  origin.start();
+  UpstreamPool pool(m_logger);
+  const std::string key = pool.resolve("127.0.0.1", origin.getPort());
+
+  ProxySession session(m_logger, pool, key, head("GET", "/silent", 0),
+                       std::vector<char>(), "");
+  session.setTimeouts(1, 1);
+  session.start();
+  while (session.wantsWrite()) {
+    ASSERT_FALSE(session.advance());
+  }
+  EXPECT_FALSE(session.advance());
+
+  EXPECT_NO_THROW(session.checkTimeout(std::time(NULL)));
+  EXPECT_THROW(session.checkTimeout(std::time(NULL) + 5), ProxyException);
+}
@@ -0,0 +1,188 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_RequestLimitConfig.cpp                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:19:10 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:19:10 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "domain/configuration/entities/HttpConfig.hpp"
+#include "domain/configuration/entities/LocationConfig.hpp"
+#include "domain/configuration/entities/ServerConfig.hpp"
+#include "domain/configuration/exceptions/LimitConfigException.hpp"
+#include "domain/configuration/value_objects/LimitZoneConfig.hpp"
+#include "domain/configuration/value_objects/RequestLimitConfig.hpp"
+#include "domain/shared/utils/BinaryReader.hpp"
+#include "domain/shared/utils/BinaryWriter.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+
+using domain::configuration::entities::HttpConfig;
+using domain::configuration::entities::LocationConfig;
+using domain::configuration::entities::ServerConfig;
+using domain::configuration::exceptions::LimitConfigException;
+using domain::configuration::value_objects::LimitZoneConfig;
+using domain::configuration::value_objects::RequestLimitConfig;
+using domain::shared::utils::BinaryReader;
+using domain::shared::utils::BinaryWriter;
+
+class RequestLimitConfigTest : public ::testing::Test {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+
+  static LimitZoneConfig requestZone(const std::string& name) {
+    LimitZoneConfig zone(name, LimitZoneConfig::TYPE_REQUEST,
+                         "$binary_remote_addr", 1024 * 1024);
+    zone.setRate("10r/s");
+    return zone;
+  }
+
+  static HttpConfig* configWithRules(const RequestLimitConfig& limits) {
+    HttpConfig* config = new HttpConfig();
+    ServerConfig* server = new ServerConfig();
+    server->addListenDirective("127.0.0.1:8098");
+    LocationConfig* location = new LocationConfig("/");
+    location->setRequestLimits(limits);
+    server->addLocation(location);
+    config->addServerConfig(server);
+    return config;
+  }
+
+  static std::string validationError(const HttpConfig& config) {
+    try {
+      config.validate();
+    } catch (const LimitConfigException& e) {
+      return e.what();
+    }
+    return "";
+  }
+};
+
+// ============================================================================
+// Limit Zone Tests
+// ============================================================================
+
+TEST_F(RequestLimitConfigTest, RateIsKeptInThousandthsPerSecond) {
+  LimitZoneConfig zone = requestZone("perip");
+  EXPECT_EQ(10000u, zone.getRate());
+
+  zone.setRate("30r/m");
+  EXPECT_EQ(500u, zone.getRate());
+
+  zone.setRate("1r/s");
+  EXPECT_EQ(1000u, zone.getRate());
+}
+
+TEST_F(RequestLimitConfigTest, MalformedRatesAreRejected) {
+  LimitZoneConfig zone = requestZone("perip");
+  EXPECT_THROW(zone.setRate("10"), LimitConfigException);
+  EXPECT_THROW(zone.setRate("10r/h"), LimitConfigException);
+  EXPECT_THROW(zone.setRate("0r/s"), LimitConfigException);
+  EXPECT_THROW(zone.setRate("r/s"), LimitConfigException);
+  EXPECT_THROW(zone.setRate("-5r/s"), LimitConfigException);
+
+  LimitZoneConfig connections("perhost", LimitZoneConfig::TYPE_CONNECTION,
+                              "$host", LimitZoneConfig::MIN_SIZE);
+  EXPECT_THROW(connections.setRate("10r/s"), LimitConfigException);
+}
+
+TEST_F(RequestLimitConfigTest, ZoneRejectsBadNameKeyAndSize) {
+  EXPECT_THROW(LimitZoneConfig("bad zone", LimitZoneConfig::TYPE_REQUEST,
+                               "$remote_addr", LimitZoneConfig::MIN_SIZE),
+               LimitConfigException);
+  EXPECT_THROW(LimitZoneConfig("perip", LimitZoneConfig::TYPE_REQUEST,
+                               "$nope", LimitZoneConfig::MIN_SIZE),
+               LimitConfigException);
+  EXPECT_THROW(LimitZoneConfig("perip", LimitZoneConfig::TYPE_REQUEST,
+                               "$remote_addr", LimitZoneConfig::MIN_SIZE - 1),
+               LimitConfigException);
+}
+
+TEST_F(RequestLimitConfigTest, HttpConfigRejectsDuplicateZone) {
+  HttpConfig config;
+  config.addLimitZone(requestZone("perip"));
+  EXPECT_THROW(config.addLimitZone(requestZone("perip")),
+               LimitConfigException);
+  ASSERT_TRUE(config.findLimitZone("perip") != NULL);
+  EXPECT_TRUE(config.findLimitZone("other") == NULL);
+}
+
+// ============================================================================
+// Location Rule Tests
+// ============================================================================
+
+TEST_F(RequestLimitConfigTest, DisabledByDefault) {
+  const RequestLimitConfig limits;
+  EXPECT_FALSE(limits.isEnabled());
+  EXPECT_EQ(RequestLimitConfig::DEFAULT_STATUS, limits.getRequestStatus());
+  EXPECT_EQ(RequestLimitConfig::DEFAULT_STATUS, limits.getConnectionStatus());
+}
+
+TEST_F(RequestLimitConfigTest, RepeatedZoneAndBadValuesAreRejected) {
+  RequestLimitConfig limits;
+  limits.addRequestRule(RequestLimitConfig::RequestRule("perip", 5, false));
+  EXPECT_TRUE(limits.isEnabled());
+  EXPECT_THROW(
+      limits.addRequestRule(RequestLimitConfig::RequestRule("perip", 1, true)),
+      LimitConfigException);
+
+  EXPECT_THROW(
+      limits.addConnectionRule(RequestLimitConfig::ConnectionRule("perip", 0)),
+      LimitConfigException);
+  EXPECT_THROW(limits.setRequestStatus(200), LimitConfigException);
+  EXPECT_THROW(limits.setConnectionStatus(600), LimitConfigException);
+
+  limits.setRequestStatus(429);
+  EXPECT_EQ(429u, limits.getRequestStatus());
+}
+
+TEST_F(RequestLimitConfigTest, ReferencesMustNameZoneOfMatchingType) {
+  RequestLimitConfig limits;
+  limits.addRequestRule(RequestLimitConfig::RequestRule("perip", 0, false));
+
+  HttpConfig* config = configWithRules(limits);
+  EXPECT_NE(std::string::npos,
+            validationError(*config).find("Unknown limit zone"));
+
+  config->addLimitZone(LimitZoneConfig("perip",
+                                       LimitZoneConfig::TYPE_CONNECTION,
+                                       "$remote_addr",
+                                       LimitZoneConfig::MIN_SIZE));
+  EXPECT_NE(std::string::npos,
+            validationError(*config).find("Limit zone type mismatch"));
+  delete config;
+
+  config = configWithRules(limits);
+  config->addLimitZone(requestZone("perip"));
+  EXPECT_EQ("", validationError(*config));
+  delete config;
+}
+
+TEST_F(RequestLimitConfigTest, SerializeRoundTrips) {
+  const LimitZoneConfig zone = requestZone("perip");
+
+  RequestLimitConfig limits;
+  limits.addRequestRule(RequestLimitConfig::RequestRule("perip", 20, true));
+  limits.addConnectionRule(RequestLimitConfig::ConnectionRule("perhost", 4));
+  limits.setRequestStatus(429);
+
+  BinaryWriter writer;
+  zone.serialize(writer);
+  limits.serialize(writer);
+
+  BinaryReader reader(writer.getBuffer().data(), writer.size());
+  LimitZoneConfig loadedZone;
+  loadedZone.deserialize(reader);
+  RequestLimitConfig loadedLimits;
+  loadedLimits.deserialize(reader);
+
+  EXPECT_TRUE(reader.isAtEnd());
+  EXPECT_EQ(zone, loadedZone);
+  EXPECT_EQ(limits, loadedLimits);
+}
@@ -0,0 +1,255 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_RequestLimiter.cpp                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:19:40 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:19:40 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <gtest/gtest.h>
+#include "domain/configuration/entities/HttpConfig.hpp"
+#include "domain/configuration/value_objects/LimitZoneConfig.hpp"
+#include "domain/configuration/value_objects/RequestLimitConfig.hpp"
+#include "domain/filesystem/value_objects/Path.hpp"
+#include "domain/http/entities/HttpRequest.hpp"
+#include "domain/http/value_objects/HttpMethod.hpp"
+#include "infrastructure/limits/adapters/RequestLimiter.hpp"
+#include "infrastructure/limits/primitives/LimitTable.hpp"
+#include "mocks/MockLogger.hpp"
+
+#include <string>
+
+using domain::configuration::entities::HttpConfig;
+using domain::configuration::value_objects::LimitZoneConfig;
+using domain::configuration::value_objects::RequestLimitConfig;
+using domain::http::entities::HttpRequest;
+using infrastructure::limits::adapters::RequestLimiter;
+using infrastructure::limits::primitives::LimitTable;
+
+class RequestLimiterTest : public ::testing::Test {
+ protected:
+  static const unsigned long K_NOW = 5000000;
+
+  static HttpConfig::LimitZones zones(const std::string& rate = "1r/s",
+                                      const std::string& key =
+                                          "$binary_remote_addr") {
+    LimitZoneConfig requests("perip", LimitZoneConfig::TYPE_REQUEST, key,
+                             LimitZoneConfig::MIN_SIZE);
+    requests.setRate(rate);
+    const LimitZoneConfig connections(
+        "perhost", LimitZoneConfig::TYPE_CONNECTION, "$host",
+        LimitZoneConfig::MIN_SIZE);
+    HttpConfig::LimitZones result;
+    result.insert(std::make_pair(requests.getName(), requests));
+    result.insert(std::make_pair(connections.getName(), connections));
+    return result;
+  }
+
+  static RequestLimitConfig requestRule(unsigned int burst, bool nodelay) {
+    RequestLimitConfig limits;
+    limits.addRequestRule(
+        RequestLimitConfig::RequestRule("perip", burst, nodelay));
+    return limits;
+  }
+
+  static RequestLimitConfig connectionRule(unsigned int limit) {
+    RequestLimitConfig limits;
+    limits.addConnectionRule(
+        RequestLimitConfig::ConnectionRule("perhost", limit));
+    return limits;
+  }
+
+  static HttpRequest request() {
+    HttpRequest result;
+    result.setMethod(domain::http::value_objects::HttpMethod::get());
+    result.setPath(domain::filesystem::value_objects::Path("/items"));
+    result.addHeader("Host", "example.com");
+    return result;
+  }
+
+  RequestLimiter::Outcome send(RequestLimiter& limiter,
+                               const RequestLimitConfig& limits,
+                               unsigned long now, unsigned long& delay,
+                               const std::string& client = "10.0.0.1") {
+    return limiter.limitRequest(limits, request(), client, now, delay);
+  }
+
+  tests::mocks::MockLogger m_logger;
+};
+
+const unsigned long RequestLimiterTest::K_NOW;
+
+// ============================================================================
+// Limit Table Tests
+// ============================================================================
+
+TEST_F(RequestLimiterTest, TableCapacityIsPowerOfTwoWithinBudget) {
+  const LimitTable table(LimitZoneConfig::MIN_SIZE);
+  const std::size_t capacity = table.getCapacity();
+  EXPECT_EQ(0u, capacity & (capacity - 1));
+  EXPECT_LE(capacity * 4 * sizeof(unsigned long), LimitZoneConfig::MIN_SIZE);
+  EXPECT_GT(capacity * 8 * sizeof(unsigned long), LimitZoneConfig::MIN_SIZE);
+  EXPECT_EQ(0u, table.getUsed());
+
+  EXPECT_EQ(LimitTable::K_PROBE_LIMIT, LimitTable(0).getCapacity());
+}
+
+TEST_F(RequestLimiterTest, BucketDrainsAtZoneRate) {
+  LimitTable table(LimitZoneConfig::MIN_SIZE);
+  const unsigned long hash = LimitTable::hashKey("10.0.0.1");
+  unsigned long excess = 0;
+
+  EXPECT_EQ(LimitTable::VERDICT_PASS,
+            table.checkRequest(hash, 1000, 0, K_NOW, excess));
+  EXPECT_EQ(0u, excess);
+  EXPECT_EQ(1u, table.getUsed());
+
+  EXPECT_EQ(LimitTable::VERDICT_BUSY,
+            table.checkRequest(hash, 1000, 0, K_NOW + 10, excess));
+  EXPECT_EQ(LimitTable::VERDICT_BUSY,
+            table.checkRequest(hash, 1000, 0, K_NOW + 500, excess));
+  EXPECT_EQ(LimitTable::VERDICT_PASS,
+            table.checkRequest(hash, 1000, 0, K_NOW + 1000, excess));
+  EXPECT_EQ(0u, excess);
+}
+
+TEST_F(RequestLimiterTest, ConnectionsAreCountedAgainstLimit) {
+  LimitTable table(LimitZoneConfig::MIN_SIZE);
+  const unsigned long hash = LimitTable::hashKey("example.com");
+
+  EXPECT_EQ(LimitTable::VERDICT_PASS, table.acquireConnection(hash, 2, K_NOW));
+  EXPECT_EQ(LimitTable::VERDICT_PASS, table.acquireConnection(hash, 2, K_NOW));
+  EXPECT_EQ(LimitTable::VERDICT_BUSY, table.acquireConnection(hash, 2, K_NOW));
+  EXPECT_EQ(2u, table.getConnections(hash));
+
+  table.releaseConnection(hash);
+  EXPECT_EQ(1u, table.getConnections(hash));
+  EXPECT_EQ(LimitTable::VERDICT_PASS, table.acquireConnection(hash, 2, K_NOW));
+}
+
+TEST_F(RequestLimiterTest, FullProbeWindowRefusesNewKeys) {
+  LimitTable table(0);
+  for (unsigned long hash = 1; hash <= LimitTable::K_PROBE_LIMIT; ++hash) {
+    ASSERT_EQ(LimitTable::VERDICT_PASS,
+              table.acquireConnection(hash, 1, K_NOW));
+  }
+  EXPECT_EQ(LimitTable::VERDICT_FULL,
+            table.acquireConnection(LimitTable::K_PROBE_LIMIT + 1, 1, K_NOW));
+
+  table.releaseConnection(1);
+  EXPECT_EQ(LimitTable::VERDICT_PASS,
+            table.acquireConnection(LimitTable::K_PROBE_LIMIT + 1, 1, K_NOW));
+}
+
+// ============================================================================
+// Request Limit Tests
+// ============================================================================
+
+TEST_F(RequestLimiterTest, RequestBeyondBurstIsRejectedAndLogged) {
+  RequestLimiter limiter(m_logger);
+  limiter.configure(zones());
+  const RequestLimitConfig limits = requestRule(0, false);
+  unsigned long delay = 0;
+
+  EXPECT_EQ(RequestLimiter::OUTCOME_PASS, send(limiter, limits, K_NOW, delay));
+  EXPECT_EQ(RequestLimiter::OUTCOME_REJECT,
+            send(limiter, limits, K_NOW, delay));
+  EXPECT_EQ(1u, limiter.getRejectedCount());
+  EXPECT_TRUE(m_logger.hasLog(WARN, "limiting requests, excess: 1.000"));
+  EXPECT_TRUE(m_logger.hasLog(WARN, "client: 10.0.0.1"));
+
+  EXPECT_EQ(RequestLimiter::OUTCOME_PASS,
+            send(limiter, limits, K_NOW, delay, "10.0.0.2"));
+}
+
+TEST_F(RequestLimiterTest, BurstIsDelayedUnlessNodelay) {
+  RequestLimiter limiter(m_logger);
+  limiter.configure(zones());
+  unsigned long delay = 0;
+
+  const RequestLimitConfig queued = requestRule(2, false);
+  EXPECT_EQ(RequestLimiter::OUTCOME_PASS, send(limiter, queued, K_NOW, delay));
+  EXPECT_EQ(RequestLimiter::OUTCOME_DELAY,
+            send(limiter, queued, K_NOW, delay));
+  EXPECT_EQ(1000u, delay);
+  EXPECT_EQ(RequestLimiter::OUTCOME_DELAY,
+            send(limiter, queued, K_NOW, delay));
+  EXPECT_EQ(2000u, delay);
+  EXPECT_EQ(RequestLimiter::OUTCOME_REJECT,
+            send(limiter, queued, K_NOW, delay));
+  EXPECT_EQ(2u, limiter.getDelayedCount());
+
+  const RequestLimitConfig immediate = requestRule(2, true);
+  EXPECT_EQ(RequestLimiter::OUTCOME_PASS,
+            send(limiter, immediate, K_NOW, delay, "10.0.0.2"));
+  EXPECT_EQ(RequestLimiter::OUTCOME_PASS,
+            send(limiter, immediate, K_NOW, delay, "10.0.0.2"));
+  EXPECT_EQ(0u, delay);
+}
+
+TEST_F(RequestLimiterTest, EmptyKeyIsNotLimited) {
+  RequestLimiter limiter(m_logger);
+  limiter.configure(zones("1r/s", "$http_x_api_key"));
+  const RequestLimitConfig limits = requestRule(0, false);
+  unsigned long delay = 0;
+
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(RequestLimiter::OUTCOME_PASS,
+              send(limiter, limits, K_NOW, delay));
+  }
+  EXPECT_EQ(0u, limiter.getRejectedCount());
+}
+
+TEST_F(RequestLimiterTest, ReloadKeepsUnchangedZoneState) {
+  RequestLimiter limiter(m_logger);
+  limiter.configure(zones());
+  const RequestLimitConfig limits = requestRule(0, false);
+  unsigned long delay = 0;
+  EXPECT_EQ(RequestLimiter::OUTCOME_PASS, send(limiter, limits, K_NOW, delay));
+
+  limiter.configure(zones());
+  EXPECT_EQ(RequestLimiter::OUTCOME_REJECT,
+            send(limiter, limits, K_NOW, delay));
+
+  limiter.configure(zones("5r/s", "$remote_addr"));
+  EXPECT_EQ(RequestLimiter::OUTCOME_PASS, send(limiter, limits, K_NOW, delay));
+  EXPECT_TRUE(limiter.hasZone("perip"));
+
+  limiter.configure(HttpConfig::LimitZones());
+  EXPECT_FALSE(limiter.hasZone("perip"));
+}
+
+// ============================================================================
+// Connection Limit Tests
+// ============================================================================
+
+TEST_F(RequestLimiterTest, LeaseHoldsConnectionUntilReleased) {
+  RequestLimiter limiter(m_logger);
+  limiter.configure(zones());
+  const RequestLimitConfig limits = connectionRule(1);
+
+  RequestLimiter::Lease first;
+  EXPECT_EQ(RequestLimiter::OUTCOME_PASS,
+            limiter.limitConnection(limits, request(), "10.0.0.1", K_NOW,
+                                    first));
+  EXPECT_FALSE(first.isEmpty());
+
+  RequestLimiter::Lease second;
+  EXPECT_EQ(RequestLimiter::OUTCOME_REJECT,
+            limiter.limitConnection(limits, request(), "10.0.0.2", K_NOW,
+                                    second));
+  EXPECT_TRUE(second.isEmpty());
+  EXPECT_EQ(1u, limiter.getConnectionRejectedCount());
+  EXPECT_TRUE(m_logger.hasLog(WARN, "limiting connections, limit: 1"));
+
+  limiter.release(first);
+  EXPECT_TRUE(first.isEmpty());
+  EXPECT_EQ(RequestLimiter::OUTCOME_PASS,
+            limiter.limitConnection(limits, request(), "10.0.0.2", K_NOW,
+                                    second));
+  limiter.release(second);
+}
@@ -0,0 +1,230 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_RequestParser.cpp                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 11:04:27 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/19 11:04:27 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <gtest/gtest.h>
+#include "domain/http/value_objects/HttpHeader.hpp"
+#include "infrastructure/http/RequestParser.hpp"
+#include "infrastructure/network/primitives/ReadArena.hpp"
+
+#include <cstring>
+#include <string>
+
+using domain::http::value_objects::HttpHeader;
+using infrastructure::http::ParsedRequest;
+using infrastructure::http::RequestParser;
+using infrastructure::network::primitives::ReadArena;
+
+class RequestParserTest : public ::testing::Test {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+
+  bool feed(RequestParser& parser, const std::string& raw) {
+    return parser.parse(raw.c_str(), raw.size());
+  }
+};
+
+// ============================================================================
+// Request Line And Header Tests
+// ============================================================================
+
+TEST_F(RequestParserTest, ParsesSimpleGet) {
+  RequestParser parser;
+  const std::string raw = "GET /index.html?a=1 HTTP/1.1\r\nHost: x\r\n\r\n";
+
+  EXPECT_TRUE(feed(parser, raw));
+  EXPECT_TRUE(parser.isComplete());
+
+  const ParsedRequest& request = parser.getRequest();
+  EXPECT_EQ("GET", request.method.toString());
+  EXPECT_EQ("/index.html", request.path.toString());
+  EXPECT_TRUE(request.version.isHttp11());
+  EXPECT_EQ(raw.size(), parser.getConsumedBytes());
+}
+
+TEST_F(RequestParserTest, HeaderViewsPointIntoBuffer) {
+  RequestParser parser;
+  const std::string raw =
+      "GET / HTTP/1.1\r\nHost:  example.com \r\nX-Custom:\tvalue\r\n\r\n";
+
+  ASSERT_TRUE(feed(parser, raw));
+
+  const ParsedRequest& request = parser.getRequest();
+  ASSERT_EQ(2u, request.headers.size());
+  EXPECT_EQ(raw.c_str(), request.data);
+  EXPECT_EQ(0, std::strncmp(raw.c_str() + request.headers[0].nameOffset,
+                            "Host", request.headers[0].nameLength));
+  EXPECT_EQ("host", request.headerName(request.headers[0]));
+  EXPECT_EQ("example.com", request.headerValue(request.headers[0]));
+  EXPECT_EQ("value", request.getHeader("x-custom"));
+}
+
+TEST_F(RequestParserTest, HeaderLookupIsCaseInsensitive) {
+  RequestParser parser;
+  ASSERT_TRUE(
+      feed(parser, "GET / HTTP/1.1\r\nContent-Type: text/plain\r\n\r\n"));
+
+  EXPECT_TRUE(parser.getRequest().hasHeader("CONTENT-TYPE"));
+  EXPECT_EQ("text/plain", parser.getRequest().getHeader("content-type"));
+  EXPECT_FALSE(parser.getRequest().hasHeader("content-length"));
+}
+
+TEST_F(RequestParserTest, DuplicateHeaderKeepsLastValue) {
+  RequestParser parser;
+  ASSERT_TRUE(feed(parser, "GET / HTTP/1.1\r\nX-A: 1\r\nx-a: 2\r\n\r\n"));
+
+  EXPECT_EQ("2", parser.getRequest().getHeader("X-A"));
+}
+
+TEST_F(RequestParserTest, RejectsMalformedInput) {
+  RequestParser missingColon;
+  EXPECT_FALSE(feed(missingColon, "GET / HTTP/1.1\r\nBroken\r\n\r\n"));
+  EXPECT_TRUE(missingColon.hasError());
+
+  RequestParser badVersion;
+  EXPECT_FALSE(feed(badVersion, "GET / HTTP/2.0\r\n\r\n"));
+  EXPECT_TRUE(badVersion.hasError());
+
+  RequestParser badName;
+  EXPECT_FALSE(feed(badName, "GET / HTTP/1.1\r\nBad Name: x\r\n\r\n"));
+  EXPECT_TRUE(badName.hasError());
+
+  RequestParser shortLine;
+  EXPECT_FALSE(feed(shortLine, "GET /\r\n\r\n"));
+  EXPECT_TRUE(shortLine.hasError());
+}
+
+// ============================================================================
+// Incremental And Body Tests
+// ============================================================================
+
+TEST_F(RequestParserTest, ResumesOnGrowingBuffer) {
+  RequestParser parser;
+  const std::string raw = "GET / HTTP/1.1\r\nHost: x\r\n\r\n";
+
+  for (std::size_t length = 1; length < raw.size(); ++length) {
+    EXPECT_FALSE(parser.parse(raw.c_str(), length));
+    EXPECT_FALSE(parser.hasError());
+  }
+  EXPECT_TRUE(feed(parser, raw));
+  EXPECT_EQ("x", parser.getRequest().getHeader("host"));
+}
+
+TEST_F(RequestParserTest, BodyIsViewIntoBuffer) {
+  RequestParser parser;
+  const std::string head = "POST /u HTTP/1.1\r\nContent-Length: 5\r\n\r\n";
+
+  EXPECT_FALSE(feed(parser, head + "he"));
+  EXPECT_TRUE(parser.headersComplete());
+  ASSERT_TRUE(feed(parser, head + "hello"));
+
+  const ParsedRequest& request = parser.getRequest();
+  EXPECT_EQ(head.size(), request.bodyOffset);
+  EXPECT_EQ(5u, request.bodyLength);
+  EXPECT_EQ("hello", std::string(request.bodyData(), request.bodyLength));
+}
+
+TEST_F(RequestParserTest, BodyLargerThanLimitFails) {
+  RequestParser parser(8192, 4);
+  EXPECT_FALSE(
+      feed(parser, "POST / HTTP/1.1\r\nContent-Length: 10\r\n\r\n0123456789"));
+  EXPECT_TRUE(parser.hasError());
+}
+
+TEST_F(RequestParserTest, ConsumedBytesStopAtPipelinedRequest) {
+  RequestParser parser;
+  const std::string first = "GET /a HTTP/1.1\r\nHost: x\r\n\r\n";
+  const std::string second = "GET /b HTTP/1.1\r\nHost: x\r\n\r\n";
+
+  ASSERT_TRUE(feed(parser, first + second));
+  EXPECT_EQ(first.size(), parser.getConsumedBytes());
+
+  parser.reset();
+  ASSERT_TRUE(feed(parser, second));
+  EXPECT_EQ("/b", parser.getRequest().path.toString());
+}
+
+// ============================================================================
+// Header Interning Tests
+// ============================================================================
+
+TEST_F(RequestParserTest, KnownHeaderTableIsPerfect) {
+  for (std::size_t i = 0; i < HttpHeader::KNOWN_HEADER_COUNT; ++i) {
+    const HttpHeader::KnownHeader header =
+        static_cast<HttpHeader::KnownHeader>(i);
+    const std::string name = HttpHeader::knownHeaderName(header);
+    EXPECT_EQ(header, HttpHeader::lookupKnown(name)) << name;
+  }
+  EXPECT_EQ(HttpHeader::HEADER_CONTENT_TYPE,
+            HttpHeader::lookupKnown("Content-Type"));
+  EXPECT_EQ(HttpHeader::HEADER_UNKNOWN, HttpHeader::lookupKnown("X-Custom"));
+  EXPECT_EQ(HttpHeader::HEADER_UNKNOWN, HttpHeader::lookupKnown("hosts"));
+  EXPECT_EQ(HttpHeader::HEADER_UNKNOWN, HttpHeader::lookupKnown(""));
+}
+
+TEST_F(RequestParserTest, KnownHeadersResolvedAtParseTime) {
+  RequestParser parser;
+  ASSERT_TRUE(feed(parser,
+                   "GET / HTTP/1.1\r\nHOST: a\r\nX-Trace: t\r\n"
+                   "Content-Length: 0\r\nhost: b\r\n\r\n"));
+
+  const ParsedRequest& request = parser.getRequest();
+  EXPECT_EQ(HttpHeader::HEADER_HOST, request.headers[0].id);
+  EXPECT_EQ(HttpHeader::HEADER_UNKNOWN, request.headers[1].id);
+  EXPECT_EQ("b", request.getHeader(HttpHeader::HEADER_HOST));
+  EXPECT_EQ("t", request.getHeader("x-trace"));
+  EXPECT_TRUE(request.hasHeader(HttpHeader::HEADER_CONTENT_LENGTH));
+  EXPECT_FALSE(request.hasHeader(HttpHeader::HEADER_COOKIE));
+}
+
+// ============================================================================
+// Read Arena Tests
+// ============================================================================
+
+TEST_F(RequestParserTest, ArenaCommitAndConsume) {
+  ReadArena arena(16);
+  std::memcpy(arena.writePointer(), "abcdef", 6);
+  arena.commit(6);
+
+  EXPECT_EQ(6u, arena.size());
+  arena.consume(2);
+  EXPECT_EQ("cdef", std::string(arena.data(), arena.size()));
+  arena.consume(4);
+  EXPECT_TRUE(arena.empty());
+  EXPECT_EQ(16u, arena.writableSize());
+}
+
+TEST_F(RequestParserTest, ArenaReserveCompactsBeforeGrowing) {
+  ReadArena arena(16);
+  std::memcpy(arena.writePointer(), "0123456789abcdef", 16);
+  arena.commit(16);
+  arena.consume(12);
+
+  arena.reserve(8);
+  EXPECT_EQ(16u, arena.capacity());
+  EXPECT_EQ("cdef", std::string(arena.data(), arena.size()));
+
+  arena.reserve(32);
+  EXPECT_GE(arena.writableSize(), 32u);
+  EXPECT_EQ("cdef", std::string(arena.data(), arena.size()));
+}
+
+TEST_F(RequestParserTest, ArenaResetReleasesOversizedStorage) {
+  const std::size_t initialCapacity = ReadArena::K_DEFAULT_CAPACITY;
+  ReadArena arena(initialCapacity);
+  arena.reserve(ReadArena::K_RETAIN_CAPACITY * 2);
+  arena.commit(ReadArena::K_RETAIN_CAPACITY * 2);
+
+  arena.reset();
+  EXPECT_TRUE(arena.empty());
+  EXPECT_EQ(initialCapacity, arena.capacity());
+}
@@ -0,0 +1,211 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_RequestPlan.cpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 02:58:14 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 02:58:14 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <gtest/gtest.h>
+#include "domain/configuration/entities/ConfigSnapshot.hpp"
+#include "domain/configuration/entities/HttpConfig.hpp"
+#include "domain/configuration/entities/LocationConfig.hpp"
+#include "domain/configuration/entities/RequestPlan.hpp"
+#include "domain/configuration/entities/ServerConfig.hpp"
+#include "domain/configuration/value_objects/CgiConfig.hpp"
+#include "domain/filesystem/value_objects/Path.hpp"
+#include "domain/http/value_objects/HttpMethod.hpp"
+#include "domain/shared/value_objects/ErrorCode.hpp"
+
+#include <string>
+
+using domain::configuration::entities::ConfigSnapshot;
+using domain::configuration::entities::HttpConfig;
+using domain::configuration::entities::LocationConfig;
+using domain::configuration::entities::RequestPlan;
+using domain::configuration::entities::ServerConfig;
+using domain::configuration::value_objects::CgiConfig;
+using domain::filesystem::value_objects::Path;
+using domain::http::value_objects::HttpMethod;
+using domain::shared::value_objects::ErrorCode;
+
+class RequestPlanTest : public ::testing::Test {
+ protected:
+  RequestPlan plan(const LocationConfig& location) const {
+    return RequestPlan(location, m_serverRoot, m_serverErrorPages);
+  }
+
+  Path m_serverRoot;
+  RequestPlan::ErrorPageMap m_serverErrorPages;
+};
+
+// ============================================================================
+// Dispatch Tests
+// ============================================================================
+
+TEST_F(RequestPlanTest, HandlerKindFollowsDispatchOrder) {
+  LocationConfig location("/app");
+  location.setCgiConfig(CgiConfig::createPythonCgi());
+  EXPECT_EQ(RequestPlan::HANDLER_CGI, plan(location).getHandlerKind());
+
+  location.enableUpload(Path("/tmp/uploads"));
+  EXPECT_EQ(RequestPlan::HANDLER_UPLOAD, plan(location).getHandlerKind());
+
+  location.setStatusFormat(LocationConfig::STATUS_PROMETHEUS);
+  EXPECT_EQ(RequestPlan::HANDLER_STATUS, plan(location).getHandlerKind());
+
+  location.setReturnContent("hello", 200);
+  EXPECT_EQ(RequestPlan::HANDLER_RETURN_CONTENT,
+            plan(location).getHandlerKind());
+
+  location.setReturnRedirect("/elsewhere", 301);
+  EXPECT_EQ(RequestPlan::HANDLER_REDIRECT, plan(location).getHandlerKind());
+}
+
+TEST_F(RequestPlanTest, ProxyPassSelectsProxyHandler) {
+  LocationConfig location("/api");
+  EXPECT_NE(RequestPlan::HANDLER_PROXY, plan(location).getHandlerKind());
+
+  location.setProxyPass("http://127.0.0.1:9000");
+  EXPECT_EQ(RequestPlan::HANDLER_PROXY, plan(location).getHandlerKind());
+}
+
+TEST_F(RequestPlanTest, AllowedMethodsBecomeBitmask) {
+  LocationConfig location("/api");
+  location.clearAllowedMethods();
+  location.addAllowedMethod(HttpMethod::get());
+  location.addAllowedMethod(HttpMethod::deleteMethod());
+
+  const RequestPlan compiled = plan(location);
+  EXPECT_EQ(HttpMethod::get().toMask() | HttpMethod::deleteMethod().toMask(),
+            compiled.getAllowedMethodMask());
+  EXPECT_TRUE(compiled.allowsMethod(HttpMethod::get()));
+  EXPECT_TRUE(compiled.allowsMethod(HttpMethod::deleteMethod()));
+  EXPECT_FALSE(compiled.allowsMethod(HttpMethod::post()));
+  EXPECT_FALSE(compiled.allowsMethod(HttpMethod::head()));
+}
+
+TEST_F(RequestPlanTest, LimitsAndListsAreCopied) {
+  LocationConfig location("/files");
+  location.setClientMaxBodySize("2M");
+  location.clearIndexFiles();
+  location.addIndexFile("home.html");
+  location.addTryFile("$uri");
+  location.addTryFile("=404");
+
+  const RequestPlan compiled = plan(location);
+  EXPECT_EQ(location.getClientMaxBodySize().getBytes(),
+            compiled.getMaxBodyBytes());
+  ASSERT_EQ(1u, compiled.getIndexFiles().size());
+  EXPECT_EQ("home.html", compiled.getIndexFiles()[0]);
+  EXPECT_EQ(location.getTryFiles(), compiled.getTryFiles());
+}
+
+// ============================================================================
+// Response Data Tests
+// ============================================================================
+
+TEST_F(RequestPlanTest, LocationErrorPagesOverrideServerOnes) {
+  m_serverErrorPages[ErrorCode::notFound()] = "/server404.html";
+  m_serverErrorPages[ErrorCode::payloadTooLarge()] = "/server413.html";
+
+  LocationConfig location("/docs");
+  location.addErrorPage(ErrorCode::notFound(), "/docs404.html");
+
+  const RequestPlan compiled = plan(location);
+  ASSERT_TRUE(compiled.findErrorPage(ErrorCode::notFound()) != NULL);
+  EXPECT_EQ("/docs404.html", *compiled.findErrorPage(ErrorCode::notFound()));
+  ASSERT_TRUE(compiled.findErrorPage(ErrorCode::payloadTooLarge()) != NULL);
+  EXPECT_EQ("/server413.html",
+            *compiled.findErrorPage(ErrorCode::payloadTooLarge()));
+  EXPECT_TRUE(compiled.findErrorPage(ErrorCode::forbidden()) == NULL);
+}
+
+TEST_F(RequestPlanTest, CustomHeadersArePrepared) {
+  LocationConfig location("/");
+  location.addCustomHeader("X-Frame-Options", "DENY");
+  location.addCustomHeader("Cache-Control", "no-store");
+
+  const RequestPlan compiled = plan(location);
+  const RequestPlan::HeaderBlock& headers = compiled.getHeaders();
+  ASSERT_EQ(2u, headers.size());
+  EXPECT_EQ("Cache-Control", headers[0].first);
+  EXPECT_EQ("no-store", headers[0].second);
+  EXPECT_EQ("X-Frame-Options", headers[1].first);
+}
+
+// ============================================================================
+// Path Resolution Tests
+// ============================================================================
+
+TEST_F(RequestPlanTest, ResolvesAgainstLocationRoot) {
+  LocationConfig location("/static");
+  location.setRoot("/srv/www");
+
+  EXPECT_EQ(location.resolvePath("/static/app.js").toString(),
+            plan(location).resolvePath("/static/app.js").toString());
+}
+
+TEST_F(RequestPlanTest, ResolvesAgainstAlias) {
+  LocationConfig location("/images");
+  location.setRoot("/srv/www");
+  location.setAlias("/srv/media");
+
+  EXPECT_EQ(location.resolvePath("/images/cat.png").toString(),
+            plan(location).resolvePath("/images/cat.png").toString());
+}
+
+TEST_F(RequestPlanTest, SlashRootFallsBackToServerRoot) {
+  m_serverRoot = Path("/srv/site");
+  LocationConfig location("/");
+
+  EXPECT_EQ(Path("/srv/site").join("index.html").toString(),
+            plan(location).resolvePath("/index.html").toString());
+}
+
+TEST_F(RequestPlanTest, MissingServerRootFallsBackToWorkingDirectory) {
+  LocationConfig location("/");
+
+  EXPECT_EQ(Path::fromString("./index.html", false).toString(),
+            plan(location).resolveFallbackPath("/index.html").toString());
+}
+
+// ============================================================================
+// Lifecycle Tests
+// ============================================================================
+
+TEST_F(RequestPlanTest, LocationHasNoPlanUntilCompiled) {
+  LocationConfig location("/");
+  EXPECT_TRUE(location.getRequestPlan() == NULL);
+
+  location.compileRequestPlan(m_serverRoot, m_serverErrorPages);
+  EXPECT_TRUE(location.getRequestPlan() != NULL);
+
+  LocationConfig copy(location);
+  EXPECT_TRUE(copy.getRequestPlan() == NULL);
+
+  location.clear();
+  EXPECT_TRUE(location.getRequestPlan() == NULL);
+}
+
+TEST_F(RequestPlanTest, SnapshotCompilesEveryLocation) {
+  HttpConfig* httpConfig = new HttpConfig();
+  ServerConfig* server = new ServerConfig();
+  server->addListenDirective("127.0.0.1:8095");
+  server->addLocation(new LocationConfig("/"));
+  server->addLocation(new LocationConfig("/api"));
+  httpConfig->addServerConfig(server);
+
+  ConfigSnapshot* snapshot = ConfigSnapshot::create(httpConfig, 1);
+
+  const ServerConfig::Locations& locations = server->getLocations();
+  ASSERT_EQ(2u, locations.size());
+  for (std::size_t i = 0; i < locations.size(); ++i) {
+    EXPECT_TRUE(locations[i]->getRequestPlan() != NULL);
+  }
+  snapshot->release();
+}
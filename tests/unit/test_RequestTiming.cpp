@@ -0,0 +1,114 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_RequestTiming.cpp                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 08:31:44 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 08:31:44 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <gtest/gtest.h>
+#include "infrastructure/network/primitives/RequestTiming.hpp"
+
+#include <string>
+
+using infrastructure::network::primitives::RequestTiming;
+
+class RequestTimingTest : public ::testing::Test {
+ protected:
+  RequestTiming m_timing;
+};
+
+// ============================================================================
+// Mark Tests
+// ============================================================================
+
+TEST_F(RequestTimingTest, StartsWithNoPhases) {
+  for (int i = 0; i < RequestTiming::PHASE_COUNT; ++i) {
+    EXPECT_FALSE(m_timing.has(static_cast<RequestTiming::Phase>(i)));
+  }
+  EXPECT_EQ(RequestTiming::K_UNSET, m_timing.total());
+}
+
+TEST_F(RequestTimingTest, FirstMarkWins) {
+  m_timing.markAt(RequestTiming::PHASE_FIRST_BYTE, 1000);
+  m_timing.mark(RequestTiming::PHASE_FIRST_BYTE);
+
+  EXPECT_EQ(1000u, m_timing.at(RequestTiming::PHASE_FIRST_BYTE));
+}
+
+TEST_F(RequestTimingTest, MarkUsesMonotonicClock) {
+  const unsigned long before = RequestTiming::nowMicros();
+  m_timing.mark(RequestTiming::PHASE_HEADERS_COMPLETE);
+
+  EXPECT_TRUE(m_timing.has(RequestTiming::PHASE_HEADERS_COMPLETE));
+  EXPECT_GE(m_timing.at(RequestTiming::PHASE_HEADERS_COMPLETE), before);
+}
+
+TEST_F(RequestTimingTest, ResetForgetsPhases) {
+  m_timing.markAt(RequestTiming::PHASE_FIRST_BYTE, 10);
+  m_timing.markAt(RequestTiming::PHASE_LAST_BYTE_WRITTEN, 20);
+  m_timing.reset();
+
+  EXPECT_FALSE(m_timing.has(RequestTiming::PHASE_FIRST_BYTE));
+  m_timing.mark(RequestTiming::PHASE_FIRST_BYTE);
+  EXPECT_NE(10u, m_timing.at(RequestTiming::PHASE_FIRST_BYTE));
+}
+
+// ============================================================================
+// Interval Tests
+// ============================================================================
+
+TEST_F(RequestTimingTest, ElapsedNeedsBothPhases) {
+  m_timing.markAt(RequestTiming::PHASE_FIRST_BYTE, 100);
+  EXPECT_EQ(RequestTiming::K_UNSET,
+            m_timing.elapsed(RequestTiming::PHASE_FIRST_BYTE,
+                             RequestTiming::PHASE_BODY_COMPLETE));
+
+  m_timing.markAt(RequestTiming::PHASE_BODY_COMPLETE, 350);
+  EXPECT_EQ(250, m_timing.elapsed(RequestTiming::PHASE_FIRST_BYTE,
+                                  RequestTiming::PHASE_BODY_COMPLETE));
+  EXPECT_EQ(0, m_timing.elapsed(RequestTiming::PHASE_BODY_COMPLETE,
+                                RequestTiming::PHASE_FIRST_BYTE));
+}
+
+TEST_F(RequestTimingTest, TotalSpansFirstByteToLastWrite) {
+  m_timing.markAt(RequestTiming::PHASE_FIRST_BYTE, 1000);
+  m_timing.markAt(RequestTiming::PHASE_HANDLER_DONE, 1500);
+  m_timing.markAt(RequestTiming::PHASE_LAST_BYTE_WRITTEN, 4000);
+
+  EXPECT_EQ(3000, m_timing.total());
+}
+
+// ============================================================================
+// Formatting Tests
+// ============================================================================
+
+TEST_F(RequestTimingTest, FormatSecondsUsesMillisecondResolution) {
+  EXPECT_EQ("0.000", RequestTiming::formatSeconds(0));
+  EXPECT_EQ("0.250", RequestTiming::formatSeconds(250000));
+  EXPECT_EQ("1.500", RequestTiming::formatSeconds(1500000));
+  EXPECT_EQ("-", RequestTiming::formatSeconds(RequestTiming::K_UNSET));
+}
+
+TEST_F(RequestTimingTest, BreakdownSkipsPhasesNotReached) {
+  m_timing.markAt(RequestTiming::PHASE_FIRST_BYTE, 0);
+  m_timing.markAt(RequestTiming::PHASE_HEADERS_COMPLETE, 1000);
+  m_timing.markAt(RequestTiming::PHASE_ROUTE_MATCHED, 3000);
+  m_timing.markAt(RequestTiming::PHASE_LAST_BYTE_WRITTEN, 503000);
+
+  EXPECT_EQ("headers=0.001 route=0.002 last_write=0.500",
+            m_timing.formatBreakdown());
+}
+
+TEST_F(RequestTimingTest, BreakdownMeasuresUpstreamFromItsStart) {
+  m_timing.markAt(RequestTiming::PHASE_FIRST_BYTE, 0);
+  m_timing.markAt(RequestTiming::PHASE_ROUTE_MATCHED, 1000);
+  m_timing.markAt(RequestTiming::PHASE_UPSTREAM_START, 2000);
+  m_timing.markAt(RequestTiming::PHASE_UPSTREAM_DONE, 42000);
+
+  EXPECT_EQ("route=0.001 upstream=0.040", m_timing.formatBreakdown());
+}
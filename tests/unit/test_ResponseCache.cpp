@@ -0,0 +1,377 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_ResponseCache.cpp                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:06:37 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:06:37 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <gtest/gtest.h>
+#include "domain/configuration/entities/HttpConfig.hpp"
+#include "domain/configuration/value_objects/CacheZoneConfig.hpp"
+#include "domain/configuration/value_objects/ProxyCacheConfig.hpp"
+#include "domain/filesystem/value_objects/Path.hpp"
+#include "domain/http/entities/HttpRequest.hpp"
+#include "domain/http/value_objects/HttpMethod.hpp"
+#include "domain/http/value_objects/QueryStringBuilder.hpp"
+#include "infrastructure/cache/adapters/ResponseCache.hpp"
+#include "infrastructure/cache/primitives/CacheKey.hpp"
+#include "infrastructure/cache/primitives/CachePolicy.hpp"
+#include "mocks/MockLogger.hpp"
+
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <string>
+#include <sys/stat.h>
+
+using domain::configuration::entities::HttpConfig;
+using domain::configuration::value_objects::CacheZoneConfig;
+using domain::configuration::value_objects::ProxyCacheConfig;
+using domain::http::entities::HttpRequest;
+using infrastructure::cache::adapters::ResponseCache;
+using infrastructure::cache::primitives::CacheKey;
+using infrastructure::cache::primitives::CachePolicy;
+
+class ResponseCacheTest : public ::testing::Test {
+ protected:
+  static const std::time_t K_NOW = 1700000000;
+
+  void SetUp() {
+    m_dir = "/tmp/webserv_response_cache_test";
+    system(("rm -rf " + m_dir).c_str());
+  }
+
+  void TearDown() { system(("rm -rf " + m_dir).c_str()); }
+
+  HttpConfig::CacheZones zones(std::size_t maxSize = 0,
+                               unsigned int inactive = 600) const {
+    CacheZoneConfig zone("pages", m_dir);
+    zone.setMaxSize(maxSize);
+    zone.setInactive(inactive);
+    HttpConfig::CacheZones result;
+    result.insert(std::make_pair(zone.getName(), zone));
+    return result;
+  }
+
+  static bool store(ResponseCache& cache, const std::string& key,
+                    const std::string& body, std::time_t expires) {
+    ResponseCache::HeaderMap headers;
+    headers["content-type"] = "text/plain";
+    ResponseCache::Fill* fill =
+        cache.startFill("pages", key, 200, headers, expires);
+    if (fill == NULL) {
+      return false;
+    }
+    fill->append(body.data(), body.size());
+    const bool stored = fill->commit();
+    delete fill;
+    return stored;
+  }
+
+  static bool exists(const std::string& path) {
+    struct stat info;
+    return stat(path.c_str(), &info) == 0;
+  }
+
+  static HttpRequest request() {
+    HttpRequest result;
+    result.setMethod(domain::http::value_objects::HttpMethod::get());
+    result.setPath(domain::filesystem::value_objects::Path("/items"));
+    result.setQuery(
+        domain::http::value_objects::QueryStringBuilder::parseQueryString(
+            "b=2&a=1"));
+    result.addHeader("Host", "example.com");
+    result.addHeader("X-Lang", "pt");
+    return result;
+  }
+
+  tests::mocks::MockLogger m_logger;
+  std::string m_dir;
+};
+
+const std::time_t ResponseCacheTest::K_NOW;
+
+// ============================================================================
+// Key Tests
+// ============================================================================
+
+TEST_F(ResponseCacheTest, KeyRendersRequestFields) {
+  EXPECT_EQ("httpGETexample.com/items?a=1&b=2",
+            CacheKey::render("$scheme$request_method$host$request_uri",
+                             request(), "http", "10.0.0.1"));
+  EXPECT_EQ("/items|a=1&b=2|pt|10.0.0.1|",
+            CacheKey::render("$uri|$args|${http_x_lang}|$remote_addr|$nope",
+                             request(), "http", "10.0.0.1"));
+}
+
+TEST_F(ResponseCacheTest, KeyHashIsStableHex) {
+  const std::string hash = CacheKey::hash("example.com/items");
+  ASSERT_EQ(CacheKey::K_HASH_LENGTH, hash.size());
+  EXPECT_EQ(std::string::npos, hash.find_first_not_of("0123456789abcdef"));
+  EXPECT_EQ(hash, CacheKey::hash("example.com/items"));
+  EXPECT_NE(hash, CacheKey::hash("example.com/items2"));
+  EXPECT_NE(CacheKey::hash("ab"), CacheKey::hash("ba"));
+}
+
+// ============================================================================
+// Freshness Tests
+// ============================================================================
+
+TEST_F(ResponseCacheTest, CacheControlSetsFreshness) {
+  ProxyCacheConfig config;
+  ResponseCache::HeaderMap headers;
+  headers["cache-control"] = "public, max-age=60";
+  EXPECT_EQ(K_NOW + 60, CachePolicy::freshUntil(200, headers, config, K_NOW));
+
+  headers["cache-control"] = "max-age=60, s-maxage=300";
+  EXPECT_EQ(K_NOW + 300, CachePolicy::freshUntil(200, headers, config, K_NOW));
+
+  headers["cache-control"] = "max-age=0";
+  EXPECT_EQ(0, CachePolicy::freshUntil(200, headers, config, K_NOW));
+}
+
+TEST_F(ResponseCacheTest, PrivateResponsesAreNotStored) {
+  ProxyCacheConfig config;
+  config.addValidity(ProxyCacheConfig::StatusList(), 600);
+  const char* const values[] = {"no-store", "no-cache", "private, max-age=60"};
+  for (std::size_t i = 0; i < 3; ++i) {
+    ResponseCache::HeaderMap headers;
+    headers["cache-control"] = values[i];
+    EXPECT_EQ(0, CachePolicy::freshUntil(200, headers, config, K_NOW))
+        << values[i];
+  }
+
+  ResponseCache::HeaderMap cookie;
+  cookie["set-cookie"] = "session=1";
+  EXPECT_EQ(0, CachePolicy::freshUntil(200, cookie, config, K_NOW));
+
+  ResponseCache::HeaderMap vary;
+  vary["vary"] = "*";
+  EXPECT_EQ(0, CachePolicy::freshUntil(200, vary, config, K_NOW));
+}
+
+TEST_F(ResponseCacheTest, ExpiresIsUsedWithoutMaxAge) {
+  ProxyCacheConfig config;
+  ResponseCache::HeaderMap headers;
+  headers["expires"] = "Tue, 14 Nov 2023 22:14:20 GMT";
+  EXPECT_EQ(K_NOW + 60, CachePolicy::freshUntil(200, headers, config, K_NOW));
+
+  headers["expires"] = "Sun, 06 Nov 1994 08:49:37 GMT";
+  EXPECT_EQ(0, CachePolicy::freshUntil(200, headers, config, K_NOW));
+}
+
+TEST_F(ResponseCacheTest, ValidTimeAppliesWithoutHeaders) {
+  ProxyCacheConfig config;
+  ResponseCache::HeaderMap headers;
+  EXPECT_EQ(0, CachePolicy::freshUntil(200, headers, config, K_NOW));
+
+  config.addValidity(ProxyCacheConfig::StatusList(), 600);
+  EXPECT_EQ(K_NOW + 600, CachePolicy::freshUntil(200, headers, config, K_NOW));
+  EXPECT_EQ(0, CachePolicy::freshUntil(404, headers, config, K_NOW));
+
+  headers["expires"] = "soon";
+  EXPECT_EQ(K_NOW + 600, CachePolicy::freshUntil(200, headers, config, K_NOW));
+}
+
+TEST_F(ResponseCacheTest, ParsesImfFixdate) {
+  std::time_t when = 0;
+  ASSERT_TRUE(CachePolicy::parseHttpDate("Sun, 06 Nov 1994 08:49:37 GMT",
+                                         when));
+  EXPECT_EQ(784111777, when);
+  EXPECT_FALSE(CachePolicy::parseHttpDate("Sunday, 06-Nov-94 08:49:37 GMT",
+                                          when));
+  EXPECT_FALSE(CachePolicy::parseHttpDate("Sun, 06 Foo 1994 08:49:37 GMT",
+                                          when));
+}
+
+// ============================================================================
+// Storage Tests
+// ============================================================================
+
+TEST_F(ResponseCacheTest, StoredResponseIsServed) {
+  ResponseCache cache(m_logger);
+  cache.configure(zones(), K_NOW);
+
+  ResponseCache::Response response;
+  EXPECT_EQ(ResponseCache::STATUS_MISS,
+            cache.lookup("pages", "k1", K_NOW, response));
+  ASSERT_TRUE(store(cache, "k1", "hello world", K_NOW + 60));
+
+  EXPECT_EQ(ResponseCache::STATUS_HIT,
+            cache.lookup("pages", "k1", K_NOW, response));
+  EXPECT_EQ(200u, response.status);
+  EXPECT_EQ("hello world", response.body);
+  EXPECT_EQ("text/plain", response.headers["content-type"]);
+  EXPECT_EQ(1u, cache.getHitCount());
+  EXPECT_EQ(1u, cache.getMissCount());
+  EXPECT_EQ(1u, cache.getStoreCount());
+  EXPECT_EQ(1u, cache.getEntryCount());
+  EXPECT_TRUE(exists(ResponseCache::entryPath(zones()["pages"], "k1")));
+}
+
+TEST_F(ResponseCacheTest, StaleEntryReportsExpired) {
+  ResponseCache cache(m_logger);
+  cache.configure(zones(), K_NOW);
+  ASSERT_TRUE(store(cache, "k1", "body", K_NOW + 10));
+
+  ResponseCache::Response response;
+  EXPECT_EQ(ResponseCache::STATUS_HIT,
+            cache.lookup("pages", "k1", K_NOW + 9, response));
+  EXPECT_EQ(ResponseCache::STATUS_EXPIRED,
+            cache.lookup("pages", "k1", K_NOW + 10, response));
+}
+
+TEST_F(ResponseCacheTest, AbortedFillStoresNothing) {
+  ResponseCache cache(m_logger);
+  cache.configure(zones(), K_NOW);
+
+  ResponseCache::Fill* fill = cache.startFill(
+      "pages", "k1", 200, ResponseCache::HeaderMap(), K_NOW + 60);
+  ASSERT_TRUE(fill != NULL);
+  EXPECT_TRUE(fill->append("partial", 7));
+  fill->abort();
+  EXPECT_FALSE(fill->append("more", 4));
+  delete fill;
+
+  ResponseCache::Response response;
+  EXPECT_EQ(ResponseCache::STATUS_MISS,
+            cache.lookup("pages", "k1", K_NOW, response));
+  EXPECT_EQ(0u, cache.getStoreCount());
+  EXPECT_FALSE(exists(ResponseCache::entryPath(zones()["pages"], "k1")));
+}
+
+TEST_F(ResponseCacheTest, UnknownZoneIsNotCached) {
+  ResponseCache cache(m_logger);
+  cache.configure(zones(), K_NOW);
+
+  EXPECT_FALSE(cache.hasZone("other"));
+  EXPECT_TRUE(cache.startFill("other", "k1", 200, ResponseCache::HeaderMap(),
+                              K_NOW + 60) == NULL);
+  EXPECT_FALSE(cache.lock("other", "k1"));
+}
+
+TEST_F(ResponseCacheTest, EntryPathFollowsLevels) {
+  const HttpConfig::CacheZones configured = zones();
+  const CacheZoneConfig& zone = configured.find("pages")->second;
+  const std::string hash = CacheKey::hash("k1");
+
+  EXPECT_EQ(m_dir + "/" + hash.substr(31, 1) + "/" + hash.substr(29, 2) +
+                "/" + hash,
+            ResponseCache::entryPath(zone, "k1"));
+}
+
+// ============================================================================
+// Lock Tests
+// ============================================================================
+
+TEST_F(ResponseCacheTest, LockAdmitsOneFiller) {
+  ResponseCache cache(m_logger);
+  cache.configure(zones(), K_NOW);
+
+  EXPECT_TRUE(cache.lock("pages", "k1"));
+  EXPECT_FALSE(cache.lock("pages", "k1"));
+  EXPECT_TRUE(cache.isLocked("pages", "k1"));
+  EXPECT_TRUE(cache.lock("pages", "k2"));
+
+  const unsigned long generation = cache.getGeneration();
+  cache.unlock("pages", "k1");
+  EXPECT_FALSE(cache.isLocked("pages", "k1"));
+  EXPECT_EQ(generation + 1, cache.getGeneration());
+  cache.unlock("pages", "k1");
+  EXPECT_EQ(generation + 1, cache.getGeneration());
+}
+
+TEST_F(ResponseCacheTest, FinishedFillBumpsGeneration) {
+  ResponseCache cache(m_logger);
+  cache.configure(zones(), K_NOW);
+
+  const unsigned long generation = cache.getGeneration();
+  ASSERT_TRUE(store(cache, "k1", "body", K_NOW + 60));
+  EXPECT_EQ(generation + 1, cache.getGeneration());
+}
+
+// ============================================================================
+// Eviction Tests
+// ============================================================================
+
+// A committed entry counts as used at the moment it was stored.
+TEST_F(ResponseCacheTest, InactiveEntriesAreEvicted) {
+  const std::time_t now = std::time(NULL);
+  ResponseCache cache(m_logger);
+  cache.configure(zones(0, 30), now);
+  ASSERT_TRUE(store(cache, "k1", "body", now + 3600));
+  const std::string path = ResponseCache::entryPath(zones()["pages"], "k1");
+
+  cache.evict(now + 28);
+  EXPECT_EQ(1u, cache.getEntryCount());
+  cache.evict(now + 31);
+  EXPECT_EQ(0u, cache.getEntryCount());
+  EXPECT_EQ(0u, cache.getStoredBytes());
+  EXPECT_FALSE(exists(path));
+}
+
+TEST_F(ResponseCacheTest, MaxSizeEvictsLeastRecentlyUsed) {
+  ResponseCache cache(m_logger);
+  cache.configure(zones(), K_NOW);
+  ASSERT_TRUE(store(cache, "k1", std::string(100, 'a'), K_NOW + 60));
+  ASSERT_TRUE(store(cache, "k2", std::string(100, 'b'), K_NOW + 60));
+  ASSERT_TRUE(store(cache, "k3", std::string(100, 'c'), K_NOW + 60));
+  const std::size_t total = cache.getStoredBytes();
+
+  ResponseCache::Response response;
+  ASSERT_EQ(ResponseCache::STATUS_HIT,
+            cache.lookup("pages", "k1", K_NOW, response));
+
+  cache.configure(zones(total - 1), K_NOW);
+  EXPECT_EQ(2u, cache.getEntryCount());
+  EXPECT_EQ(ResponseCache::STATUS_MISS,
+            cache.lookup("pages", "k2", K_NOW, response));
+  EXPECT_EQ(ResponseCache::STATUS_HIT,
+            cache.lookup("pages", "k1", K_NOW, response));
+  EXPECT_EQ(ResponseCache::STATUS_HIT,
+            cache.lookup("pages", "k3", K_NOW, response));
+}
+
+// ============================================================================
+// Persistence Tests
+// ============================================================================
+
+TEST_F(ResponseCacheTest, EntriesOnDiskAreIndexedAgain) {
+  {
+    ResponseCache cache(m_logger);
+    cache.configure(zones(), K_NOW);
+    ASSERT_TRUE(store(cache, "k1", "persisted", K_NOW + 60));
+  }
+  const std::string stray = m_dir + "/left.1.tmp";
+  std::ofstream(stray.c_str()) << "partial";
+
+  ResponseCache cache(m_logger);
+  cache.configure(zones(), K_NOW);
+  EXPECT_EQ(1u, cache.getEntryCount());
+  EXPECT_FALSE(exists(stray));
+
+  ResponseCache::Response response;
+  ASSERT_EQ(ResponseCache::STATUS_HIT,
+            cache.lookup("pages", "k1", K_NOW, response));
+  EXPECT_EQ("persisted", response.body);
+}
+
+TEST_F(ResponseCacheTest, CorruptEntryIsDropped) {
+  ResponseCache cache(m_logger);
+  cache.configure(zones(), K_NOW);
+  ASSERT_TRUE(store(cache, "k1", "body", K_NOW + 60));
+  const std::string path = ResponseCache::entryPath(zones()["pages"], "k1");
+  std::ofstream(path.c_str(), std::ios::trunc) << "garbage";
+
+  ResponseCache::Response response;
+  EXPECT_EQ(ResponseCache::STATUS_MISS,
+            cache.lookup("pages", "k1", K_NOW, response));
+  EXPECT_EQ(0u, cache.getEntryCount());
+  EXPECT_FALSE(exists(path));
+  EXPECT_TRUE(m_logger.hasLog(WARN, "Dropping unreadable cache entry"));
+}
@@ -0,0 +1,192 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_ServerMetrics.cpp                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 06:41:05 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 06:41:05 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <gtest/gtest.h>
+#include "domain/configuration/entities/ServerConfig.hpp"
+#include "domain/shared/utils/LatencyHistogram.hpp"
+#include "infrastructure/network/primitives/ServerMetrics.hpp"
+
+#include <string>
+
+using domain::configuration::entities::ServerConfig;
+using domain::shared::utils::LatencyHistogram;
+using infrastructure::network::primitives::ServerMetrics;
+
+namespace {
+
+class FixedSource : public ServerMetrics::Source {
+ public:
+  virtual void collect(ServerMetrics::Sample& sample) const {
+    sample.activeConnections = 4;
+    sample.readingConnections = 1;
+    sample.writingConnections = 2;
+    sample.waitingConnections = 1;
+    sample.cgiProcessSpawns = 7;
+    sample.cgiEnvironmentHits = 3;
+    sample.cgiEnvironmentMisses = 1;
+  }
+};
+
+bool contains(const std::string& text, const std::string& needle) {
+  return text.find(needle) != std::string::npos;
+}
+
+}  // namespace
+
+class ServerMetricsTest : public ::testing::Test {
+ protected:
+  void SetUp() {
+    m_alpha.addListenDirective("127.0.0.1:8101");
+    m_alpha.addServerName("alpha.test");
+    m_beta.addListenDirective("127.0.0.1:8102");
+  }
+
+  ServerConfig m_alpha;
+  ServerConfig m_beta;
+  ServerMetrics m_metrics;
+};
+
+// ============================================================================
+// Counter Tests
+// ============================================================================
+
+TEST_F(ServerMetricsTest, RequestsAreCountedByStatusClass) {
+  m_metrics.recordRequest(&m_alpha, 200, 100);
+  m_metrics.recordRequest(&m_alpha, 204, 100);
+  m_metrics.recordRequest(&m_alpha, 404, 100);
+  m_metrics.recordRequest(&m_alpha, 502, 100);
+  m_metrics.recordRequest(NULL, 999, 0);
+
+  EXPECT_EQ(5u, m_metrics.getRequests());
+  EXPECT_EQ(2u, m_metrics.getRequestsInClass(2));
+  EXPECT_EQ(1u, m_metrics.getRequestsInClass(4));
+  EXPECT_EQ(1u, m_metrics.getRequestsInClass(5));
+  EXPECT_EQ(0u, m_metrics.getRequestsInClass(9));
+}
+
+TEST_F(ServerMetricsTest, TrafficAndCgiCountersAccumulate) {
+  m_metrics.recordAccepted();
+  m_metrics.recordAccepted();
+  m_metrics.recordHandled();
+  m_metrics.recordBytesIn(120);
+  m_metrics.recordBytesIn(30);
+  m_metrics.recordBytesOut(4096);
+  m_metrics.recordCgiRequest(ServerMetrics::CGI_FASTCGI);
+  m_metrics.recordCgiRequest(ServerMetrics::CGI_FASTCGI);
+  m_metrics.recordCgiRequest(ServerMetrics::CGI_SPAWN);
+  m_metrics.recordCgiTimeout();
+  m_metrics.recordTlsHandshake(false, false);
+  m_metrics.recordTlsHandshake(true, true);
+  m_metrics.recordTlsHandshakeFailure();
+  m_metrics.recordHttp2Connection();
+
+  EXPECT_EQ(2u, m_metrics.getAccepted());
+  EXPECT_EQ(1u, m_metrics.getHandled());
+  EXPECT_EQ(150u, m_metrics.getBytesIn());
+  EXPECT_EQ(4096u, m_metrics.getBytesOut());
+  EXPECT_EQ(2u, m_metrics.getCgiRequests(ServerMetrics::CGI_FASTCGI));
+  EXPECT_EQ(1u, m_metrics.getCgiRequests(ServerMetrics::CGI_SPAWN));
+  EXPECT_EQ(0u, m_metrics.getCgiRequests(ServerMetrics::CGI_WORKER_POOL));
+  EXPECT_EQ(1u, m_metrics.getCgiTimeouts());
+  EXPECT_EQ(2u, m_metrics.getTlsHandshakes());
+  EXPECT_EQ(1u, m_metrics.getTlsResumed());
+  EXPECT_EQ(1u, m_metrics.getTlsFailures());
+  EXPECT_EQ(1u, m_metrics.getTlsKernelSend());
+  EXPECT_EQ(1u, m_metrics.getHttp2Connections());
+}
+
+// ============================================================================
+// Server Series Tests
+// ============================================================================
+
+TEST_F(ServerMetricsTest, LatencyIsKeptPerServer) {
+  m_metrics.recordRequest(&m_alpha, 200, 1500);
+  m_metrics.recordRequest(&m_alpha, 200, 2500);
+  m_metrics.recordRequest(&m_beta, 200, 90);
+
+  ASSERT_EQ(2u, m_metrics.getServerCount());
+  const LatencyHistogram* alpha = m_metrics.findLatency("alpha.test:8101");
+  const LatencyHistogram* beta = m_metrics.findLatency("_:8102");
+  ASSERT_TRUE(alpha != NULL);
+  ASSERT_TRUE(beta != NULL);
+  EXPECT_EQ(2u, alpha->getCount());
+  EXPECT_EQ(1u, beta->getCount());
+  EXPECT_EQ(90u, beta->getMax());
+}
+
+TEST_F(ServerMetricsTest, SeriesSurviveReloadOfSameServer) {
+  m_metrics.recordRequest(&m_alpha, 200, 100);
+  m_metrics.forgetServers();
+
+  ServerConfig reloaded;
+  reloaded.addListenDirective("127.0.0.1:8101");
+  reloaded.addServerName("alpha.test");
+  m_metrics.recordRequest(&reloaded, 200, 100);
+
+  EXPECT_EQ(1u, m_metrics.getServerCount());
+  EXPECT_EQ(2u, m_metrics.findLatency("alpha.test:8101")->getCount());
+}
+
+// ============================================================================
+// Rendering Tests
+// ============================================================================
+
+TEST_F(ServerMetricsTest, TextKeepsStubStatusLayout) {
+  FixedSource source;
+  m_metrics.setSource(&source);
+  m_metrics.recordAccepted();
+  m_metrics.recordHandled();
+  m_metrics.recordRequest(&m_alpha, 200, 100);
+
+  const std::string text = m_metrics.renderText();
+  EXPECT_EQ(0u, text.find("Active connections: 4 \n"
+                          "server accepts handled requests\n"
+                          " 1 1 1 \n"
+                          "Reading: 1 Writing: 2 Waiting: 1 \n"));
+  EXPECT_TRUE(contains(text, "CGI: spawns 7 timeouts 0\n"));
+  EXPECT_TRUE(contains(text, "TLS: handshakes 0 resumed 0 failed 0 ktls 0\n"));
+  EXPECT_TRUE(contains(text, "HTTP/2: connections 0\n"));
+  EXPECT_TRUE(contains(text, "Server alpha.test:8101: requests 1"));
+}
+
+TEST_F(ServerMetricsTest, PrometheusExposesSampleAndHistogram) {
+  FixedSource source;
+  m_metrics.setSource(&source);
+  m_metrics.recordRequest(&m_alpha, 200, 800);
+  m_metrics.recordRequest(&m_alpha, 500, 30000);
+  m_metrics.recordTlsHandshake(true, false);
+
+  const std::string text = m_metrics.renderPrometheus();
+  EXPECT_TRUE(contains(text, "webserv_connections{state=\"waiting\"} 1\n"));
+  EXPECT_TRUE(contains(text, "webserv_requests_total{class=\"5xx\"} 1\n"));
+  EXPECT_TRUE(contains(text, "webserv_cgi_spawns_total 7\n"));
+  EXPECT_TRUE(contains(
+      text, "webserv_tls_handshakes_total{result=\"resumed\"} 1\n"));
+  EXPECT_TRUE(
+      contains(text, "webserv_tls_handshakes_total{result=\"full\"} 0\n"));
+  EXPECT_TRUE(contains(text, "webserv_cache_hit_ratio{cache=\"cgi_environment\"}"
+                             " 0.75\n"));
+  EXPECT_TRUE(contains(text,
+                       "webserv_request_duration_seconds_bucket{server=\"alpha"
+                       ".test:8101\",le=\"0.001\"} 1\n"));
+  EXPECT_TRUE(contains(text,
+                       "webserv_request_duration_seconds_bucket{server=\"alpha"
+                       ".test:8101\",le=\"0.05\"} 2\n"));
+  EXPECT_TRUE(contains(text,
+                       "webserv_request_duration_seconds_count{server=\"alpha"
+                       ".test:8101\"} 2\n"));
+}
+
+TEST_F(ServerMetricsTest, RendersWithoutSource) {
+  const std::string text = m_metrics.renderText();
+  EXPECT_EQ(0u, text.find("Active connections: 0 \n"));
+}
@@ -0,0 +1,253 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_ServerSelector.cpp                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 01:47:26 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 01:47:26 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <gtest/gtest.h>
+#include "domain/configuration/entities/ConfigSnapshot.hpp"
+#include "domain/configuration/entities/HttpConfig.hpp"
+#include "domain/configuration/entities/ServerSelector.hpp"
+#include "domain/configuration/exceptions/HttpConfigException.hpp"
+#include "domain/configuration/value_objects/SslConfig.hpp"
+#include "infrastructure/config/parsers/ConfigParser.hpp"
+#include "mocks/MockLogger.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using domain::configuration::entities::ConfigSnapshot;
+using domain::configuration::entities::HttpConfig;
+using domain::configuration::entities::ServerConfig;
+using domain::configuration::entities::ServerSelector;
+using domain::configuration::value_objects::SslConfig;
+using domain::configuration::exceptions::HttpConfigException;
+using infrastructure::config::parsers::ConfigParser;
+
+class ServerSelectorTest : public ::testing::Test {
+ protected:
+  void SetUp() {
+    std::ofstream file(K_CONFIG_PATH);
+    file << "http {\n"
+         << server("127.0.0.1:8091", "alpha.test")
+         << server("10.0.0.1:8091", "*.wild.test")
+         << server("10.0.0.2:8091", "beta.test beta-two.test")
+         << server("10.0.0.2:8091", "zeta.test")
+         << server("10.0.0.3:8092", "gamma.test")
+         << server("127.0.0.1:8092", "delta.test")
+         << server("127.0.0.1:8093", "_") << "}\n";
+    file.close();
+
+    ConfigParser parser(m_logger);
+    m_config = parser.parseFile(K_CONFIG_PATH);
+  }
+
+  void TearDown() {
+    delete m_config;
+    std::remove(K_CONFIG_PATH);
+  }
+
+  static std::string server(const std::string& listen,
+                            const std::string& names) {
+    return "    server {\n"
+           "        listen " +
+           listen +
+           ";\n"
+           "        server_name " +
+           names +
+           ";\n"
+           "        root /tmp;\n"
+           "        location / { limit_except GET { deny all; } }\n"
+           "    }\n";
+  }
+
+  const ServerConfig* selectOrNull(const std::string& host,
+                                   unsigned int port) const {
+    try {
+      return m_config->selectServer(host, port);
+    } catch (const HttpConfigException&) {
+      return NULL;
+    }
+  }
+
+  static const char* const K_CONFIG_PATH;
+
+  tests::mocks::MockLogger m_logger;
+  HttpConfig* m_config;
+};
+
+const char* const ServerSelectorTest::K_CONFIG_PATH =
+    "/tmp/webserv_server_selector_test.conf";
+
+// ============================================================================
+// Selection Tests
+// ============================================================================
+
+TEST_F(ServerSelectorTest, IndexAgreesWithScanForEveryHost) {
+  const char* hosts[] = {"alpha.test",  "beta.test",      "beta-two.test",
+                         "x.wild.test", "a.b.wild.test",  "wild.test",
+                         "gamma.test",  "delta.test",     "unknown.test",
+                         "localhost",   "127.0.0.1"};
+  const unsigned int ports[] = {8091, 8092, 8093, 9999};
+  const std::size_t hostCount = sizeof(hosts) / sizeof(hosts[0]);
+  const std::size_t portCount = sizeof(ports) / sizeof(ports[0]);
+
+  std::vector<const ServerConfig*> scanned;
+  for (std::size_t p = 0; p < portCount; ++p) {
+    for (std::size_t h = 0; h < hostCount; ++h) {
+      scanned.push_back(selectOrNull(hosts[h], ports[p]));
+    }
+  }
+
+  ASSERT_FALSE(m_config->isServerIndexBuilt());
+  m_config->indexServers();
+  ASSERT_TRUE(m_config->isServerIndexBuilt());
+
+  for (std::size_t p = 0; p < portCount; ++p) {
+    for (std::size_t h = 0; h < hostCount; ++h) {
+      EXPECT_EQ(scanned[p * hostCount + h], selectOrNull(hosts[h], ports[p]))
+          << hosts[h] << ":" << ports[p];
+    }
+  }
+}
+
+TEST_F(ServerSelectorTest, HostLookupFoldsCase) {
+  m_config->indexServers();
+
+  const ServerConfig* server = m_config->selectServer("alpha.test", 8091);
+  EXPECT_EQ(server, m_config->selectServer("ALPHA.Test", 8091));
+  EXPECT_EQ(m_config->selectServer("x.wild.test", 8091),
+            m_config->selectServer("X.WILD.TEST", 8091));
+}
+
+TEST_F(ServerSelectorTest, NamesOnOneListenerRouteToTheirServers) {
+  const std::string listener = "10.0.0.2";
+  const ServerConfig* beta = m_config->findServer("beta.test", listener, 8091);
+  const ServerConfig* zeta = m_config->findServer("zeta.test", listener, 8091);
+  ASSERT_TRUE(beta != NULL);
+  ASSERT_TRUE(zeta != NULL);
+  EXPECT_NE(beta, zeta);
+
+  m_config->indexServers();
+
+  EXPECT_EQ(beta, m_config->findServer("beta.test", listener, 8091));
+  EXPECT_EQ(beta, m_config->findServer("BETA-two.test", listener, 8091));
+  EXPECT_EQ(zeta, m_config->findServer("zeta.test", listener, 8091));
+}
+
+TEST_F(ServerSelectorTest, ListenAddressLimitsCandidates) {
+  m_config->indexServers();
+
+  const ServerConfig* alpha = m_config->selectServer("alpha.test", 8091);
+  EXPECT_EQ(alpha, m_config->findServer("alpha.test", "127.0.0.1", 8091));
+  EXPECT_TRUE(m_config->findServer("alpha.test", "10.0.0.2", 8091) == NULL);
+  EXPECT_TRUE(m_config->findServer("alpha.test", "10.0.0.9", 8091) == NULL);
+  EXPECT_TRUE(m_config->findServer("gamma.test", "127.0.0.1", 8092) == NULL);
+  EXPECT_EQ(m_config->selectServer("x.wild.test", 8091),
+            m_config->findServer("x.wild.test", "10.0.0.1", 8091));
+}
+
+TEST_F(ServerSelectorTest, UnknownPortThrows) {
+  m_config->indexServers();
+
+  EXPECT_THROW(m_config->selectServer("alpha.test", 9999), HttpConfigException);
+}
+
+// ============================================================================
+// Table Tests
+// ============================================================================
+
+TEST_F(ServerSelectorTest, ExactNamesAreResolvedAhead) {
+  ServerSelector selector;
+  selector.build(m_config->getServerConfigs());
+
+  EXPECT_EQ(12u, selector.getExactRouteCount());
+  EXPECT_TRUE(selector.select("beta-two.test", 8091) != NULL);
+  EXPECT_TRUE(selector.select("delta.test", 8092) != NULL);
+  EXPECT_EQ(0u, selector.getCachedHostCount());
+}
+
+TEST_F(ServerSelectorTest, WildcardCacheStaysBounded) {
+  ServerSelector selector;
+  selector.build(m_config->getServerConfigs());
+  const ServerConfig* wildcard = selector.select("x.wild.test", 8091);
+
+  for (std::size_t i = 0; i < ServerSelector::MAX_CACHED_HOSTS * 3; ++i) {
+    std::ostringstream host;
+    host << "h" << i << ".wild.test";
+    EXPECT_EQ(wildcard, selector.select(host.str(), 8091));
+  }
+  EXPECT_LE(selector.getCachedHostCount(), ServerSelector::MAX_CACHED_HOSTS);
+}
+
+TEST_F(ServerSelectorTest, PortWithoutWildcardsNeverCaches) {
+  ServerSelector selector;
+  selector.build(m_config->getServerConfigs());
+
+  selector.select("unknown.test", 8092);
+  selector.select("other.test", 8092);
+  EXPECT_EQ(0u, selector.getCachedHostCount());
+}
+
+// ============================================================================
+// Lifecycle Tests
+// ============================================================================
+
+TEST_F(ServerSelectorTest, AddingServerDropsIndex) {
+  m_config->indexServers();
+
+  ServerConfig* extra = new ServerConfig();
+  extra->addListenDirective("127.0.0.1:8094");
+  extra->addServerName("extra.test");
+  m_config->addServerConfig(extra);
+
+  EXPECT_FALSE(m_config->isServerIndexBuilt());
+  EXPECT_EQ(extra, m_config->selectServer("extra.test", 8094));
+}
+
+TEST_F(ServerSelectorTest, SharedListenerRejectsOverlappingNames) {
+  ServerConfig* clash = new ServerConfig();
+  clash->addListenDirective("10.0.0.2:8091");
+  clash->addServerName("beta.test");
+
+  EXPECT_THROW(m_config->addServerConfig(clash), HttpConfigException);
+  delete clash;
+}
+
+TEST_F(ServerSelectorTest, SharedListenerRejectsMixedSsl) {
+  ServerConfig* secure = new ServerConfig();
+  secure->addListenDirective("10.0.0.2:8091",
+                             std::vector<std::string>(1, "ssl"));
+  secure->addServerName("secure.test");
+  secure->setRoot("/tmp");
+  SslConfig ssl;
+  ssl.setCertificate("/tmp/cert.pem");
+  ssl.setCertificateKey("/tmp/key.pem");
+  secure->setSslConfig(ssl);
+
+  try {
+    m_config->addServerConfig(secure);
+    FAIL() << "ssl server joined a plain listener";
+  } catch (const HttpConfigException& e) {
+    EXPECT_NE(std::string::npos,
+              std::string(e.what()).find("ssl and plain servers"));
+  }
+  delete secure;
+}
+
+TEST_F(ServerSelectorTest, SnapshotIndexesConfiguration) {
+  ConfigSnapshot* snapshot = ConfigSnapshot::create(m_config, 1);
+  m_config = NULL;
+
+  EXPECT_TRUE(snapshot->getConfiguration().isServerIndexBuilt());
+  snapshot->release();
+}
@@ -0,0 +1,179 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_SslConfig.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:31:14 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:31:14 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "domain/configuration/entities/ServerConfig.hpp"
+#include "domain/configuration/exceptions/SslConfigException.hpp"
+#include "domain/configuration/value_objects/ListenDirective.hpp"
+#include "domain/configuration/value_objects/SslConfig.hpp"
+#include "domain/shared/utils/BinaryReader.hpp"
+#include "domain/shared/utils/BinaryWriter.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+
+using domain::configuration::entities::ListenDirective;
+using domain::configuration::entities::ServerConfig;
+using domain::configuration::exceptions::SslConfigException;
+using domain::configuration::value_objects::SslConfig;
+using domain::shared::utils::BinaryReader;
+using domain::shared::utils::BinaryWriter;
+
+class SslConfigTest : public ::testing::Test {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+
+  static SslConfig certified() {
+    SslConfig ssl;
+    ssl.setCertificate("/etc/ssl/site.pem");
+    ssl.setCertificateKey("/etc/ssl/site.key");
+    return ssl;
+  }
+
+  static std::string validationError(const ServerConfig& server) {
+    try {
+      server.validate();
+    } catch (const std::exception& e) {
+      return e.what();
+    }
+    return "";
+  }
+};
+
+// ============================================================================
+// Directive Value Tests
+// ============================================================================
+
+TEST_F(SslConfigTest, DefaultsFollowNginx) {
+  const SslConfig ssl;
+  EXPECT_FALSE(ssl.isConfigured());
+  EXPECT_EQ(SslConfig::CACHE_NONE, ssl.getSessionCache());
+  EXPECT_EQ(SslConfig::DEFAULT_SESSION_TIMEOUT, ssl.getSessionTimeout());
+  EXPECT_TRUE(ssl.isSessionTicketsEnabled());
+  EXPECT_NO_THROW(ssl.validate());
+}
+
+TEST_F(SslConfigTest, SessionCacheSpecsAreParsed) {
+  SslConfig ssl;
+  ssl.setSessionCache("shared:SSL:1m");
+  EXPECT_EQ(SslConfig::CACHE_SHARED, ssl.getSessionCache());
+  EXPECT_EQ("SSL", ssl.getSessionCacheName());
+  EXPECT_EQ(1024u * 1024u / SslConfig::BYTES_PER_SESSION,
+            ssl.getSessionCacheSessions());
+
+  ssl.setSessionCache("builtin");
+  EXPECT_EQ(SslConfig::CACHE_BUILTIN, ssl.getSessionCache());
+  EXPECT_EQ(SslConfig::DEFAULT_BUILTIN_SESSIONS,
+            ssl.getSessionCacheSessions());
+
+  ssl.setSessionCache("builtin:1000");
+  EXPECT_EQ(1000u, ssl.getSessionCacheSessions());
+
+  ssl.setSessionCache("off");
+  EXPECT_EQ(SslConfig::CACHE_OFF, ssl.getSessionCache());
+  EXPECT_EQ("", ssl.getSessionCacheName());
+  EXPECT_EQ(0u, ssl.getSessionCacheSessions());
+}
+
+TEST_F(SslConfigTest, MalformedValuesAreRejected) {
+  SslConfig ssl;
+  EXPECT_THROW(ssl.setSessionCache("shared"), SslConfigException);
+  EXPECT_THROW(ssl.setSessionCache("shared:SSL"), SslConfigException);
+  EXPECT_THROW(ssl.setSessionCache("shared:bad name:1m"), SslConfigException);
+  EXPECT_THROW(ssl.setSessionCache("shared:SSL:lots"), SslConfigException);
+  EXPECT_THROW(ssl.setSessionCache("shared:SSL:100"), SslConfigException);
+  EXPECT_THROW(ssl.setSessionCache("builtinx"), SslConfigException);
+  EXPECT_THROW(ssl.setSessionCache("builtin:0"), SslConfigException);
+  EXPECT_THROW(ssl.setSessionCache("disk"), SslConfigException);
+  EXPECT_THROW(ssl.setSessionTimeout(0), SslConfigException);
+  EXPECT_THROW(ssl.setSessionTimeout(SslConfig::MAX_SESSION_TIMEOUT + 1),
+               SslConfigException);
+  EXPECT_THROW(ssl.setCertificate(""), SslConfigException);
+  EXPECT_THROW(ssl.setCertificateKey(""), SslConfigException);
+}
+
+TEST_F(SslConfigTest, CertificateAndKeyMustBePaired) {
+  SslConfig ssl;
+  ssl.setCertificate("/etc/ssl/site.pem");
+  EXPECT_THROW(ssl.validate(), SslConfigException);
+
+  SslConfig keyOnly;
+  keyOnly.setCertificateKey("/etc/ssl/site.key");
+  EXPECT_THROW(keyOnly.validate(), SslConfigException);
+
+  EXPECT_NO_THROW(certified().validate());
+}
+
+TEST_F(SslConfigTest, SerializeRoundTrips) {
+  SslConfig ssl = certified();
+  ssl.setSessionCache("shared:SSL:10m");
+  ssl.setSessionTimeout(600);
+  ssl.setSessionTicketsEnabled(false);
+
+  BinaryWriter writer;
+  ssl.serialize(writer);
+
+  BinaryReader reader(writer.getBuffer().data(), writer.size());
+  SslConfig loaded;
+  loaded.deserialize(reader);
+
+  EXPECT_TRUE(reader.isAtEnd());
+  EXPECT_EQ(ssl, loaded);
+  loaded.setSessionTimeout(601);
+  EXPECT_NE(ssl, loaded);
+}
+
+// ============================================================================
+// Listen and Server Tests
+// ============================================================================
+
+TEST_F(SslConfigTest, ListenAcceptsSslParameter) {
+  ListenDirective directive("127.0.0.1:8443");
+  EXPECT_FALSE(directive.isSsl());
+  EXPECT_TRUE(ListenDirective::isParameter("ssl"));
+
+  directive.applyParameter("ssl");
+  EXPECT_TRUE(directive.isSsl());
+
+  ListenDirective copy(directive);
+  EXPECT_TRUE(copy.isSsl());
+}
+
+TEST_F(SslConfigTest, SslListenRequiresCertificate) {
+  ServerConfig server;
+  server.addListenDirective("127.0.0.1:8443");
+  ListenDirective directive("127.0.0.1:8444");
+  directive.applyParameter("ssl");
+  server.addListenDirective(directive);
+  EXPECT_TRUE(server.hasSslListen());
+  EXPECT_NE(std::string::npos,
+            validationError(server).find("no ssl_certificate is defined"));
+
+  server.setSslConfig(certified());
+  EXPECT_EQ("", validationError(server));
+}
+
+TEST_F(SslConfigTest, ServerCopyKeepsSslConfig) {
+  ServerConfig server;
+  server.addListenDirective("127.0.0.1:8443");
+  server.setSslConfig(certified());
+
+  ServerConfig copy(server);
+  EXPECT_EQ(server.getSslConfig(), copy.getSslConfig());
+
+  BinaryWriter writer;
+  server.serialize(writer);
+  BinaryReader reader(writer.getBuffer().data(), writer.size());
+  ServerConfig loaded;
+  loaded.deserialize(reader);
+  EXPECT_EQ(server.getSslConfig(), loaded.getSslConfig());
+}
@@ -0,0 +1,414 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_TlsChannel.cpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 11:33:47 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 11:33:47 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <gtest/gtest.h>
+#include "domain/configuration/entities/ServerConfig.hpp"
+#include "domain/configuration/value_objects/SslConfig.hpp"
+#include "infrastructure/tls/adapters/TlsChannel.hpp"
+#include "infrastructure/tls/adapters/TlsContext.hpp"
+#include "infrastructure/tls/adapters/TlsContextRegistry.hpp"
+#include "infrastructure/tls/exceptions/TlsException.hpp"
+
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+using domain::configuration::entities::ServerConfig;
+using domain::configuration::value_objects::SslConfig;
+using infrastructure::tls::adapters::TlsChannel;
+using infrastructure::tls::adapters::TlsContext;
+using infrastructure::tls::adapters::TlsContextRegistry;
+using infrastructure::tls::exceptions::TlsException;
+
+class TlsChannelTest : public ::testing::Test {
+ protected:
+  static const int K_HANDSHAKE_ROUNDS = 64;
+
+  void SetUp() {
+    m_dir = "/tmp/webserv_tls_test";
+    system(("mkdir -p " + m_dir).c_str());
+    writeSelfSigned("cert.pem", "key.pem");
+    writeSelfSigned("other.pem", "other.key");
+    m_fds[0] = -1;
+    m_fds[1] = -1;
+    m_client = NULL;
+    m_clientContext = SSL_CTX_new(TLS_client_method());
+  }
+
+  void TearDown() {
+    closeClient();
+    SSL_CTX_free(m_clientContext);
+    system(("rm -rf " + m_dir).c_str());
+  }
+
+  std::string path(const std::string& name) const {
+    return m_dir + "/" + name;
+  }
+
+  SslConfig sslConfig() const {
+    SslConfig ssl;
+    ssl.setCertificate(path("cert.pem"));
+    ssl.setCertificateKey(path("key.pem"));
+    return ssl;
+  }
+
+  // A P-256 key and a one-day certificate for CN=localhost.
+  void writeSelfSigned(const std::string& certName,
+                       const std::string& keyName) const {
+    EVP_PKEY* key = NULL;
+    EVP_PKEY_CTX* keyContext = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, NULL);
+    EVP_PKEY_keygen_init(keyContext);
+    EVP_PKEY_CTX_set_ec_paramgen_curve_nid(keyContext, NID_X9_62_prime256v1);
+    EVP_PKEY_keygen(keyContext, &key);
+    EVP_PKEY_CTX_free(keyContext);
+
+    X509* cert = X509_new();
+    X509_set_version(cert, 2);
+    ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+    X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+    X509_gmtime_adj(X509_getm_notAfter(cert), 86400);
+    X509_set_pubkey(cert, key);
+    X509_NAME* name = X509_get_subject_name(cert);
+    X509_NAME_add_entry_by_txt(
+        name, "CN", MBSTRING_ASC,
+        reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+    X509_set_issuer_name(cert, name);
+    X509_sign(cert, key, EVP_sha256());
+
+    FILE* certFile = std::fopen(path(certName).c_str(), "w");
+    PEM_write_X509(certFile, cert);
+    std::fclose(certFile);
+    FILE* keyFile = std::fopen(path(keyName).c_str(), "w");
+    PEM_write_PrivateKey(keyFile, key, NULL, NULL, 0, NULL, NULL);
+    std::fclose(keyFile);
+
+    X509_free(cert);
+    EVP_PKEY_free(key);
+  }
+
+  // Both ends non-blocking, as the event loop drives them.
+  TlsChannel* connect(const TlsContext& context, SSL_SESSION* session) {
+    openClient(session);
+    return new TlsChannel(m_fds[0], context.getHandle());
+  }
+
+  void openClient(SSL_SESSION* session) {
+    closeClient();
+    socketpair(AF_UNIX, SOCK_STREAM, 0, m_fds);
+    fcntl(m_fds[0], F_SETFL, O_NONBLOCK);
+    fcntl(m_fds[1], F_SETFL, O_NONBLOCK);
+    m_client = SSL_new(m_clientContext);
+    SSL_set_fd(m_client, m_fds[1]);
+    SSL_set_connect_state(m_client);
+    if (session != NULL) {
+      SSL_set_session(m_client, session);
+    }
+  }
+
+  X509* readCertificate(const std::string& name) const {
+    FILE* file = std::fopen(path(name).c_str(), "r");
+    X509* cert = PEM_read_X509(file, NULL, NULL, NULL);
+    std::fclose(file);
+    return cert;
+  }
+
+  // Whether the certificate the client was shown is the one in `name`.
+  bool presented(const std::string& name) const {
+    X509* expected = readCertificate(name);
+    X509* peer = SSL_get1_peer_certificate(m_client);
+    const bool same = peer != NULL && X509_cmp(expected, peer) == 0;
+    X509_free(peer);
+    X509_free(expected);
+    return same;
+  }
+
+  static ServerConfig* sslServer(const std::string& name,
+                                 const SslConfig& ssl) {
+    ServerConfig* server = new ServerConfig();
+    server->addListenDirective("127.0.0.1:8443",
+                               std::vector<std::string>(1, "ssl"));
+    server->addServerName(name);
+    server->setSslConfig(ssl);
+    return server;
+  }
+
+  bool handshake(TlsChannel& server) {
+    bool clientDone = false;
+    TlsChannel::HandshakeResult result = TlsChannel::HANDSHAKE_WANT_READ;
+    for (int i = 0; i < K_HANDSHAKE_ROUNDS; ++i) {
+      if (!clientDone) {
+        clientDone = SSL_do_handshake(m_client) == 1;
+      }
+      result = server.handshake();
+      if (result == TlsChannel::HANDSHAKE_FAILED) {
+        return false;
+      }
+      if (clientDone && result == TlsChannel::HANDSHAKE_DONE) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Reads what the server wrote; TLS 1.3 session tickets arrive with it.
+  std::string clientRead() {
+    char buffer[256];
+    const int bytes = SSL_read(m_client, buffer, sizeof(buffer));
+    return bytes > 0 ? std::string(buffer, static_cast<std::size_t>(bytes))
+                     : "";
+  }
+
+  SSL_SESSION* exchangeAndKeepSession(TlsChannel& server) {
+    EXPECT_EQ(2, server.write("ok", 2));
+    EXPECT_EQ("ok", clientRead());
+    return SSL_get1_session(m_client);
+  }
+
+  // A session is only kept for resumption when both ends said goodbye.
+  void finish(TlsChannel* server) {
+    SSL_shutdown(m_client);
+    server->shutdown();
+    delete server;
+  }
+
+  void closeClient() {
+    SSL_free(m_client);
+    m_client = NULL;
+    for (int i = 0; i < 2; ++i) {
+      if (m_fds[i] >= 0) {
+        close(m_fds[i]);
+        m_fds[i] = -1;
+      }
+    }
+  }
+
+  std::string m_dir;
+  int m_fds[2];
+  SSL* m_client;
+  SSL_CTX* m_clientContext;
+};
+
+// ============================================================================
+// Context Tests
+// ============================================================================
+
+TEST_F(TlsChannelTest, ContextRejectsUnusableCertificates) {
+  SslConfig missing = sslConfig();
+  missing.setCertificate(path("absent.pem"));
+  try {
+    TlsContext context(missing);
+    FAIL() << "missing certificate was accepted";
+  } catch (const TlsException& e) {
+    EXPECT_EQ(TlsException::CERTIFICATE_FAILED, e.getCode());
+  }
+
+  SslConfig mismatched = sslConfig();
+  mismatched.setCertificateKey(path("other.key"));
+  try {
+    TlsContext context(mismatched);
+    FAIL() << "mismatched key was accepted";
+  } catch (const TlsException& e) {
+    EXPECT_EQ(TlsException::KEY_MISMATCH, e.getCode());
+  }
+}
+
+TEST_F(TlsChannelTest, RegistrySharesAndKeepsEqualContexts) {
+  ServerConfig first;
+  ServerConfig second;
+  ServerConfig plain;
+  first.setSslConfig(sslConfig());
+  second.setSslConfig(sslConfig());
+
+  TlsContextRegistry::ServerList servers;
+  servers.push_back(&first);
+  servers.push_back(&second);
+  servers.push_back(&plain);
+
+  TlsContextRegistry registry;
+  registry.configure(servers);
+  EXPECT_EQ(1u, registry.getContextCount());
+  const TlsContext* shared = registry.find(&first);
+  ASSERT_TRUE(shared != NULL);
+  EXPECT_EQ(shared, registry.find(&second));
+  EXPECT_TRUE(registry.find(&plain) == NULL);
+
+  SslConfig changed = sslConfig();
+  changed.setSessionTimeout(60);
+  second.setSslConfig(changed);
+  registry.configure(servers);
+  EXPECT_EQ(2u, registry.getContextCount());
+  EXPECT_EQ(shared, registry.find(&first));
+  EXPECT_NE(shared, registry.find(&second));
+
+  SslConfig broken = sslConfig();
+  broken.setCertificateKey(path("other.key"));
+  plain.setSslConfig(broken);
+  EXPECT_THROW(registry.configure(servers), TlsException);
+  EXPECT_EQ(2u, registry.getContextCount());
+  EXPECT_EQ(shared, registry.find(&first));
+  EXPECT_TRUE(registry.find(&plain) == NULL);
+}
+
+TEST_F(TlsChannelTest, ServerNamePicksCertificateOnSharedListener) {
+  SslConfig otherSsl = sslConfig();
+  otherSsl.setCertificate(path("other.pem"));
+  otherSsl.setCertificateKey(path("other.key"));
+  ServerConfig* first = sslServer("first.test", sslConfig());
+  ServerConfig* second = sslServer("second.test", otherSsl);
+
+  TlsContextRegistry::ServerList servers;
+  servers.push_back(first);
+  servers.push_back(second);
+  TlsContextRegistry registry;
+  registry.configure(servers);
+
+  const char* const names[] = {"second.test", "unknown.test", NULL};
+  const char* const expected[] = {"other.pem", "cert.pem", "cert.pem"};
+  for (int i = 0; i < 3; ++i) {
+    openClient(NULL);
+    if (names[i] != NULL) {
+      SSL_set_tlsext_host_name(m_client, names[i]);
+    }
+    TlsChannel* server = registry.createChannel(m_fds[0], first);
+    server->setListenBinding("127.0.0.1", 8443);
+    ASSERT_TRUE(handshake(*server));
+    EXPECT_TRUE(presented(expected[i])) << (names[i] ? names[i] : "no SNI");
+    delete server;
+  }
+
+  delete first;
+  delete second;
+}
+
+// ============================================================================
+// Handshake Tests
+// ============================================================================
+
+TEST_F(TlsChannelTest, HandshakeThenExchangesData) {
+  TlsContext context(sslConfig());
+  TlsChannel* server = connect(context, NULL);
+
+  ASSERT_TRUE(handshake(*server));
+  EXPECT_TRUE(server->isEstablished());
+  EXPECT_FALSE(server->isResumed());
+  EXPECT_EQ("TLSv1.3", server->getVersion());
+  EXPECT_FALSE(server->getCipher().empty());
+
+  char buffer[64];
+  EXPECT_EQ(-1, server->read(buffer, sizeof(buffer)));
+  ASSERT_EQ(5, SSL_write(m_client, "hello", 5));
+  ASSERT_EQ(5, server->read(buffer, sizeof(buffer)));
+  EXPECT_EQ("hello", std::string(buffer, 5));
+  EXPECT_FALSE(server->hasPendingInput());
+
+  EXPECT_EQ(3, server->write("bye", 3));
+  EXPECT_EQ("bye", clientRead());
+  delete server;
+}
+
+TEST_F(TlsChannelTest, PlainHttpFailsHandshake) {
+  TlsContext context(sslConfig());
+  TlsChannel* server = connect(context, NULL);
+
+  const std::string request = "GET / HTTP/1.1\r\nHost: localhost\r\n\r\n";
+  ASSERT_EQ(static_cast<ssize_t>(request.size()),
+            write(m_fds[1], request.data(), request.size()));
+  EXPECT_EQ(TlsChannel::HANDSHAKE_FAILED, server->handshake());
+  EXPECT_FALSE(server->getLastError().empty());
+  delete server;
+}
+
+TEST_F(TlsChannelTest, PeerCloseReadsAsEndOfStream) {
+  TlsContext context(sslConfig());
+  TlsChannel* server = connect(context, NULL);
+  ASSERT_TRUE(handshake(*server));
+
+  SSL_shutdown(m_client);
+  char buffer[16];
+  EXPECT_EQ(0, server->read(buffer, sizeof(buffer)));
+  delete server;
+
+  server = connect(context, NULL);
+  ASSERT_TRUE(handshake(*server));
+  SSL_SESSION_free(exchangeAndKeepSession(*server));
+  close(m_fds[1]);
+  m_fds[1] = -1;
+  EXPECT_EQ(0, server->read(buffer, sizeof(buffer)));
+  delete server;
+}
+
+// ============================================================================
+// Resumption Tests
+// ============================================================================
+
+TEST_F(TlsChannelTest, SessionTicketResumes) {
+  TlsContext context(sslConfig());
+  TlsChannel* server = connect(context, NULL);
+  ASSERT_TRUE(handshake(*server));
+  SSL_SESSION* session = exchangeAndKeepSession(*server);
+  ASSERT_TRUE(session != NULL);
+  finish(server);
+
+  server = connect(context, session);
+  ASSERT_TRUE(handshake(*server));
+  EXPECT_TRUE(server->isResumed());
+  delete server;
+  SSL_SESSION_free(session);
+}
+
+TEST_F(TlsChannelTest, SessionCacheResumesWithoutTickets) {
+  SslConfig ssl = sslConfig();
+  ssl.setSessionTicketsEnabled(false);
+  ssl.setSessionCache("shared:SSL:1m");
+  TlsContext context(ssl);
+  SSL_CTX_set_max_proto_version(m_clientContext, TLS1_2_VERSION);
+
+  TlsChannel* server = connect(context, NULL);
+  ASSERT_TRUE(handshake(*server));
+  EXPECT_EQ("TLSv1.2", server->getVersion());
+  SSL_SESSION* session = exchangeAndKeepSession(*server);
+  ASSERT_TRUE(session != NULL);
+  finish(server);
+
+  server = connect(context, session);
+  ASSERT_TRUE(handshake(*server));
+  EXPECT_TRUE(server->isResumed());
+  EXPECT_EQ(1, SSL_CTX_sess_hits(context.getHandle()));
+  delete server;
+  SSL_SESSION_free(session);
+}
+
+TEST_F(TlsChannelTest, DisabledCacheAndTicketsDoNotResume) {
+  SslConfig ssl = sslConfig();
+  ssl.setSessionTicketsEnabled(false);
+  ssl.setSessionCache("off");
+  TlsContext context(ssl);
+
+  TlsChannel* server = connect(context, NULL);
+  ASSERT_TRUE(handshake(*server));
+  SSL_SESSION* session = exchangeAndKeepSession(*server);
+  finish(server);
+
+  server = connect(context, session);
+  ASSERT_TRUE(handshake(*server));
+  EXPECT_FALSE(server->isResumed());
+  delete server;
+  SSL_SESSION_free(session);
+}
@@ -0,0 +1,135 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_UpstreamConfig.cpp                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: dande-je <dande-je@student.42sp.org.br>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/20 10:31:05 by dande-je          #+#    #+#             */
+/*   Updated: 2026/10/20 10:31:05 by dande-je         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "domain/configuration/exceptions/UpstreamConfigException.hpp"
+#include "domain/configuration/value_objects/UpstreamConfig.hpp"
+#include "domain/shared/utils/BinaryReader.hpp"
+#include "domain/shared/utils/BinaryWriter.hpp"
+
+#include <gtest/gtest.h>
+
+using domain::configuration::exceptions::UpstreamConfigException;
+using domain::configuration::value_objects::UpstreamConfig;
+using domain::shared::utils::BinaryReader;
+using domain::shared::utils::BinaryWriter;
+
+class UpstreamConfigTest : public ::testing::Test {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+};
+
+// ============================================================================
+// Server Address Tests
+// ============================================================================
+
+TEST_F(UpstreamConfigTest, ParseServerWithPort) {
+  const UpstreamConfig::Server server =
+      UpstreamConfig::parseServer("127.0.0.1:9000");
+  EXPECT_EQ("127.0.0.1", server.host);
+  EXPECT_EQ(9000u, server.port);
+  EXPECT_EQ(UpstreamConfig::DEFAULT_WEIGHT, server.weight);
+  EXPECT_EQ(UpstreamConfig::DEFAULT_MAX_FAILS, server.maxFails);
+  EXPECT_EQ(UpstreamConfig::DEFAULT_FAIL_TIMEOUT, server.failTimeout);
+  EXPECT_EQ("127.0.0.1:9000", server.getAddress());
+}
+
+TEST_F(UpstreamConfigTest, ParseServerDefaultsToPort80) {
+  const UpstreamConfig::Server server =
+      UpstreamConfig::parseServer("backend.internal");
+  EXPECT_EQ("backend.internal", server.host);
+  EXPECT_EQ(UpstreamConfig::DEFAULT_PORT, server.port);
+}
+
+TEST_F(UpstreamConfigTest, ParseServerBracketedIpv6) {
+  const UpstreamConfig::Server server = UpstreamConfig::parseServer("[::1]:8080");
+  EXPECT_EQ("::1", server.host);
+  EXPECT_EQ(8080u, server.port);
+}
+
+TEST_F(UpstreamConfigTest, ParseServerRejectsMalformedAddresses) {
+  EXPECT_THROW(UpstreamConfig::parseServer(""), UpstreamConfigException);
+  EXPECT_THROW(UpstreamConfig::parseServer("host:"), UpstreamConfigException);
+  EXPECT_THROW(UpstreamConfig::parseServer("host:0"), UpstreamConfigException);
+  EXPECT_THROW(UpstreamConfig::parseServer("host:65536"),
+               UpstreamConfigException);
+  EXPECT_THROW(UpstreamConfig::parseServer("host:80a"),
+               UpstreamConfigException);
+  EXPECT_THROW(UpstreamConfig::parseServer("::1:80"), UpstreamConfigException);
+  EXPECT_THROW(UpstreamConfig::parseServer("[::1"), UpstreamConfigException);
+}
+
+// ============================================================================
+// Block Tests
+// ============================================================================
+
+TEST_F(UpstreamConfigTest, NameMustBeValid) {
+  EXPECT_NO_THROW(UpstreamConfig("app_backend-1"));
+  EXPECT_THROW(UpstreamConfig(""), UpstreamConfigException);
+  EXPECT_THROW(UpstreamConfig("bad name"), UpstreamConfigException);
+}
+
+TEST_F(UpstreamConfigTest, ValidateRequiresServers) {
+  UpstreamConfig upstream("app");
+  EXPECT_THROW(upstream.validate(), UpstreamConfigException);
+
+  upstream.addServer(UpstreamConfig::parseServer("127.0.0.1:9000"));
+  EXPECT_NO_THROW(upstream.validate());
+}
+
+TEST_F(UpstreamConfigTest, ZeroWeightIsRejected) {
+  UpstreamConfig upstream("app");
+  UpstreamConfig::Server server = UpstreamConfig::parseServer("127.0.0.1:9000");
+  server.weight = 0;
+  EXPECT_THROW(upstream.addServer(server), UpstreamConfigException);
+  EXPECT_TRUE(upstream.getServers().empty());
+}
+
+TEST_F(UpstreamConfigTest, HashKeySelectsHashBalancing) {
+  UpstreamConfig upstream("app");
+  EXPECT_EQ(UpstreamConfig::BALANCE_ROUND_ROBIN, upstream.getBalance());
+
+  upstream.setHashKey("$remote_addr");
+  EXPECT_EQ(UpstreamConfig::BALANCE_HASH, upstream.getBalance());
+  EXPECT_EQ("$remote_addr", upstream.getHashKey());
+
+  upstream.setBalance(UpstreamConfig::BALANCE_LEAST_CONN);
+  EXPECT_TRUE(upstream.getHashKey().empty());
+
+  EXPECT_THROW(upstream.setHashKey("$cookie_session"), UpstreamConfigException);
+}
+
+// ============================================================================
+// Serialization Tests
+// ============================================================================
+
+TEST_F(UpstreamConfigTest, SerializeRoundTrips) {
+  UpstreamConfig upstream("app");
+  UpstreamConfig::Server server = UpstreamConfig::parseServer("10.0.0.1:81");
+  server.weight = 3;
+  server.maxFails = 2;
+  server.failTimeout = 30;
+  upstream.addServer(server);
+  upstream.addServer(UpstreamConfig::parseServer("10.0.0.2"));
+  upstream.setHashKey("$request_uri");
+  upstream.setKeepalive(32);
+
+  BinaryWriter writer;
+  upstream.serialize(writer);
+
+  UpstreamConfig loaded;
+  BinaryReader reader(writer.getBuffer().data(), writer.size());
+  loaded.deserialize(reader);
+
+  EXPECT_TRUE(reader.isAtEnd());
+  EXPECT_EQ(upstream, loaded);
+}